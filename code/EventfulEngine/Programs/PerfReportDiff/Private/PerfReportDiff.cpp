@@ -0,0 +1,89 @@
+#pragma once
+
+#include <EFPerfCapture.h>
+#include <EFText.h>
+
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+namespace{
+    using namespace EventfulEngine;
+
+    EFString FormatValue(const std::optional<double> value){
+        return value ? EFText::Format("{:.4f}", *value) : EFString{"-"};
+    }
+}
+
+// Compares two perf reports written by --perf-capture, e.g. of a CI run against the stored baseline, and fails if
+// any metric grew by more than the threshold. Metrics with a baseline of 0 fail once they exceed the zero threshold.
+// Metrics missing from the current report are always listed.
+// Usage: PerfReportDiff <baseline.json|csv> <current.json|csv> [--threshold=<percent>] [--zero-threshold=<value>]
+//        [--regressions-only]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double thresholdPercent = 10.0;
+    double zeroBaselineThreshold = 0.0;
+    bool bIsRegressionsOnly = false;
+    std::vector<std::string_view> paths;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--threshold=")){
+            const std::string_view value = argument.substr(std::string_view{"--threshold="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), thresholdPercent);
+        }
+        else if (argument.starts_with("--zero-threshold=")){
+            const std::string_view value = argument.substr(std::string_view{"--zero-threshold="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), zeroBaselineThreshold);
+        }
+        else if (argument == "--regressions-only"){
+            bIsRegressionsOnly = true;
+        }
+        else{
+            paths.push_back(argument);
+        }
+    }
+    if (paths.size() != 2){
+        std::cerr << "Usage: PerfReportDiff <baseline> <current> [--threshold=<percent>] [--zero-threshold=<value>] "
+            "[--regressions-only]\n";
+        return 2;
+    }
+
+    const std::optional<EFPerfReport> baseline = EFPerfReport::Load(EFString{paths[0]});
+    const std::optional<EFPerfReport> current = EFPerfReport::Load(EFString{paths[1]});
+    if (!baseline || !current){
+        std::cerr << "Could not read " << (baseline ? paths[1] : paths[0]) << "\n";
+        return 2;
+    }
+
+    std::cout << EFText::Format("Baseline {} frames, current {} frames, regression threshold {}%\n",
+                                baseline->FrameCount, current->FrameCount, thresholdPercent);
+    std::cout << EFText::Format("{:<56} {:>14} {:>14} {:>9}\n", "Metric", "Baseline", "Current", "Change");
+    uint32 regressions = 0;
+    uint32 removed = 0;
+    for (const EFPerfMetricDifference& difference : ComparePerfReports(*baseline, *current, thresholdPercent,
+                                                                       zeroBaselineThreshold)){
+        regressions += difference.bIsRegression ? 1 : 0;
+        removed += difference.IsRemoved() ? 1 : 0;
+        if (bIsRegressionsOnly && !difference.bIsRegression && !difference.IsRemoved()){
+            continue;
+        }
+        EFString change{difference.Baseline ? "removed" : "added"};
+        if (difference.Baseline && difference.Current){
+            change = *difference.Baseline != 0.0 ? EFText::Format("{:+.1f}%", difference.ChangePercent) : "from 0";
+        }
+        std::cout << EFText::Format("{:<56} {:>14} {:>14} {:>9}{}\n", difference.Name,
+                                    FormatValue(difference.Baseline), FormatValue(difference.Current), change,
+                                    difference.bIsRegression ? "  REGRESSION" : "");
+    }
+
+    if (removed > 0){
+        std::cerr << removed << " metrics of the baseline are missing from the current report\n";
+    }
+    if (regressions > 0){
+        std::cerr << regressions << " metrics regressed by more than " << thresholdPercent << "%\n";
+        return 1;
+    }
+    return 0;
+}
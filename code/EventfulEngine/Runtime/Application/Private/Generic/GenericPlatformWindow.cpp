@@ -18,4 +18,36 @@ namespace EventfulEngine{
         ::glfwPollEvents();
     }
 
+    void GenericPlatformWindow::WaitEvents(const double timeoutSeconds){
+        ::glfwWaitEventsTimeout(timeoutSeconds);
+    }
+
+    void GenericPlatformWindow::PostEmptyEvent(){
+        ::glfwPostEmptyEvent();
+    }
+
+    bool GenericPlatformWindow::IsFocused(GLFWwindow* window){
+        return ::glfwGetWindowAttrib(window, GLFW_FOCUSED) == GLFW_TRUE;
+    }
+
+    bool GenericPlatformWindow::IsMinimized(GLFWwindow* window){
+        return ::glfwGetWindowAttrib(window, GLFW_ICONIFIED) == GLFW_TRUE;
+    }
+
+    void GenericPlatformWindow::SetUserData(GLFWwindow* window, void* userData){
+        ::glfwSetWindowUserPointer(window, userData);
+    }
+
+    void* GenericPlatformWindow::GetUserData(GLFWwindow* window){
+        return ::glfwGetWindowUserPointer(window);
+    }
+
+    void GenericPlatformWindow::SetFocusCallback(GLFWwindow* window, const GLFWwindowfocusfun callback){
+        ::glfwSetWindowFocusCallback(window, callback);
+    }
+
+    void GenericPlatformWindow::SetMinimizeCallback(GLFWwindow* window, const GLFWwindowiconifyfun callback){
+        ::glfwSetWindowIconifyCallback(window, callback);
+    }
+
 } // namespace EventfulEngine
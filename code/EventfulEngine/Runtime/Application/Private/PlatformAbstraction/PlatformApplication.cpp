@@ -4,6 +4,7 @@
 #include "PlatformWindow.h"
 #include "PlatformAudio.h"
 #include "PlatformInput.h"
+#include "EFIdleMonitor.h"
 
 namespace EventfulEngine{
     EFApplication::~EFApplication(){
@@ -13,6 +14,10 @@ namespace EventfulEngine{
     bool EFApplication::Init(){
         if (EFPlatformApplication::Startup()){
             _dpiScale = EFPlatformApplication::GetDpiScale(::glfwGetPrimaryMonitor());
+            // Idle waits block on the GLFW event queue, so input and window events wake the engine loop
+            EFIdleMonitor::SetPlatformEvents(
+                [](const EFDuration timeout){ EFPlatformWindow::WaitEvents(EFPlatformTime::ToSeconds(timeout)); },
+                []{ EFPlatformWindow::PostEmptyEvent(); });
             return true;
         }
         return false;
@@ -33,6 +38,7 @@ namespace EventfulEngine{
         }
         _audioDevices.clear();
 
+        EFIdleMonitor::SetPlatformEvents({}, {});
         EFPlatformApplication::Shutdown();
     }
 
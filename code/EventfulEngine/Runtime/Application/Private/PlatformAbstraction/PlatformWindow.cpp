@@ -1,17 +1,53 @@
 #pragma once
 
 #include "PlatformWindow.h"
+#include "EFIdleMonitor.h"
 
 namespace EventfulEngine{
     bool EFWindow::Init(const int width, const int height, const char* title){
         _window = EFPlatformWindow::CreateWindow(width, height, title);
-        return _window != nullptr;
+        if (!_window){
+            return false;
+        }
+
+        // The engine loop idles while no window is in use, so track focus and minimizing
+        EFPlatformWindow::SetUserData(_window, this);
+        EFPlatformWindow::SetFocusCallback(_window, [](GLFWwindow* window, const int focused){
+            auto* self = static_cast<EFWindow*>(EFPlatformWindow::GetUserData(window));
+            self->_bIsFocused = focused == GLFW_TRUE;
+            self->UpdateActivity();
+        });
+        EFPlatformWindow::SetMinimizeCallback(_window, [](GLFWwindow* window, const int minimized){
+            auto* self = static_cast<EFWindow*>(EFPlatformWindow::GetUserData(window));
+            self->_bIsMinimized = minimized == GLFW_TRUE;
+            self->UpdateActivity();
+        });
+        _bIsFocused = EFPlatformWindow::IsFocused(_window);
+        _bIsMinimized = EFPlatformWindow::IsMinimized(_window);
+        UpdateActivity();
+        return true;
     }
 
     void EFWindow::Shutdown(){
         if (_window){
+            _bIsFocused = false;
+            UpdateActivity();
             EFPlatformWindow::DestroyWindow(_window);
             _window = nullptr;
         }
     }
+
+    void EFWindow::UpdateActivity(){
+        const bool bIsActive = _window && _bIsFocused && !_bIsMinimized;
+        if (bIsActive == _bIsActive){
+            return;
+        }
+        _bIsActive = bIsActive;
+        if (bIsActive){
+            EFIdleMonitor::AddActiveWindow();
+        }
+        else{
+            EFIdleMonitor::RemoveActiveWindow();
+        }
+    }
 } // EventfulEngine
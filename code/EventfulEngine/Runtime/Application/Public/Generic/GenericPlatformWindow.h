@@ -10,6 +10,24 @@ namespace EventfulEngine{
         static void DestroyWindow(GLFWwindow* window);
 
         static void PollEvents();
+
+        /** Blocks until an event arrives or the timeout passes, then processes the events like PollEvents. */
+        static void WaitEvents(double timeoutSeconds);
+
+        /** Wakes a thread blocked in WaitEvents, callable from any thread. */
+        static void PostEmptyEvent();
+
+        static bool IsFocused(GLFWwindow* window);
+
+        static bool IsMinimized(GLFWwindow* window);
+
+        static void SetUserData(GLFWwindow* window, void* userData);
+
+        static void* GetUserData(GLFWwindow* window);
+
+        static void SetFocusCallback(GLFWwindow* window, GLFWwindowfocusfun callback);
+
+        static void SetMinimizeCallback(GLFWwindow* window, GLFWwindowiconifyfun callback);
     };
 
     using EFPlatformWindow = GenericPlatformWindow;
@@ -19,7 +19,17 @@ namespace EventfulEngine{
         // TODO: Wrap GLFWwindow in a type so we can shared_pointer it
         GLFWwindow* GetNativeHandle() const{ return _window; }
 
+        [[nodiscard]] bool IsFocused() const{ return _bIsFocused; }
+
+        [[nodiscard]] bool IsMinimized() const{ return _bIsMinimized; }
+
     private:
+        /** Reports the window to the idle monitor while it is focused and not minimized. */
+        void UpdateActivity();
+
         GLFWwindow* _window{nullptr};
+        bool _bIsFocused{false};
+        bool _bIsMinimized{false};
+        bool _bIsActive{false};
     };
 }
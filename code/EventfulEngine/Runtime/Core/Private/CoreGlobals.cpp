@@ -2,6 +2,8 @@
 #include "CoreTypes.h"
 #include "../Public/CoreGlobals.h"
 #include "EFCommandLine.h"
+#include "EFStartupTrace.h"
+#include "EFIdleMonitor.h"
 
 namespace EventfulEngine{
 
@@ -20,9 +22,14 @@ namespace EventfulEngine{
 
     void EFCORE_API RequestEngineExit(){
         g_shouldRequestExit = true;
+        // An idle engine loop would only notice on its next idle tick
+        EFIdleMonitor::RequestWake();
     }
 
-    double g_startTime = EFPlatformTime::InitTiming();
+    double g_startTime = []{
+        EF_STARTUP_TRACE_SCOPE("StaticInit", "g_startTime");
+        return EFPlatformTime::InitTiming();
+    }();
 
     EFCommandLine g_commandLine{"EventfulEngine", "General Purpose Voxelizer Engine"};
 }
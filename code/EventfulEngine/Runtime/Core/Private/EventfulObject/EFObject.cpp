@@ -48,7 +48,7 @@ namespace EventfulEngine{
                 // Is there an actual instance?
                 if (EFObject* const obj = any_cast<EFObject*>(property.AutoProperty->Get(this)); obj &&
                     subClass->Hash != _efClass->Hash){
-                    if (auto subIterator = ar.Data().find(property.Name); subIterator != ar.Data().end()){
+                    if (auto subIterator = ar.Data().find(property.Name.GetData()); subIterator != ar.Data().end()){
                         JsonArchive subArchive;
                         subArchive.Data() = *subIterator;
                         obj->Deserialize(subArchive);
@@ -8,6 +8,9 @@
 namespace EventfulEngine{
     EFClassPtr EFReflectionManager::RegisterClass(EFClassPtr& cls){
         const size_t hash = cls->Hash;
+        if (!cls->Name.IsNone()){
+            _classesByName.insert_or_assign(cls->Name, cls);
+        }
         _classes.insert_or_assign(cls->Hash, std::move(cls));
         return _classes[hash];
     }
@@ -35,11 +38,9 @@ namespace EventfulEngine{
         return nullptr;
     }
 
-    EFClassPtr EFReflectionManager::GetClass(const std::string_view name) const{
-        for (auto& efClassPtr : _classes | std::views::values){
-            if (efClassPtr->Name == name){
-                return efClassPtr;
-            }
+    EFClassPtr EFReflectionManager::GetClass(const EFName name) const{
+        if (const auto it = _classesByName.find(name); it != _classesByName.end()){
+            return it->second;
         }
         return nullptr;
     }
@@ -165,16 +165,18 @@ namespace EventfulEngine{
         auto extension = filepath.extension().string(); // “.txt”, “.cpp”, etc.
         int counter = 1;
         EFPath candidate;
+        // Reused for every attempt, formatting only appends into the existing capacity
+        EFString pathName;
 
         // keep bumping “(01)”, “(02)”, … until we find a free name
         do{
-            EFString pathName;
+            pathName.clear();
             // {:02} means “pad to width 2 with leading zeros”
             if (counter <= 10){
-                pathName = EFText::Format("{} ({:2}){}", stem, counter, extension);
+                EFText::FormatTo(pathName, "{} ({:2}){}", stem, counter, extension);
             }
             else{
-                pathName = EFText::Format("{} ({:02}){}", stem, counter, extension);
+                EFText::FormatTo(pathName, "{} ({:02}){}", stem, counter, extension);
             }
             candidate = parent / pathName;
             ++counter;
@@ -2,7 +2,80 @@
 
 #include "../../Public/GenericPlatform/GenericPlatformTime.h"
 
+#include <charconv>
+#include <ctime>
+
+#if defined(EF_CYCLE_COUNTER_X86) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
 namespace EventfulEngine{
+    namespace{
+        /** Whether the cycle counter ticks at a constant rate, independent of frequency scaling and sleep states. */
+        bool HasInvariantCycleCounter(){
+#if defined(EF_CYCLE_COUNTER_X86)
+            // CPUID 0x80000007, EDX bit 8: invariant TSC
+#if defined(_MSC_VER)
+            int registers[4]{};
+            __cpuid(registers, 0x80000000);
+            if (static_cast<uint32>(registers[0]) < 0x80000007){
+                return false;
+            }
+            __cpuid(registers, 0x80000007);
+            return (registers[3] & (1 << 8)) != 0;
+#else
+            uint32 eax, ebx, ecx, edx;
+            if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)){
+                return false;
+            }
+            return (edx & (1u << 8)) != 0;
+#endif
+#elif defined(EF_CYCLE_COUNTER_ARM64)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        uint64 ReadCycleCounter(){
+#if defined(EF_CYCLE_COUNTER_X86)
+            uint32 processor;
+            return __rdtscp(&processor);
+#elif defined(EF_CYCLE_COUNTER_ARM64)
+            uint64 counter;
+            asm volatile("isb; mrs %0, cntvct_el0" : "=r"(counter));
+            return counter;
+#else
+            return 0;
+#endif
+        }
+
+        /** Writes value zero padded to at least width digits, returns the end of the written digits. */
+        char* WriteDigits(char* out, char* const end, const uint64 value, const uint32 width){
+            char digits[20];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            const size_t count = static_cast<size_t>(result.ptr - digits);
+            for (size_t pad = count; pad < width && out != end; ++pad){
+                *out++ = '0';
+            }
+            for (size_t index = 0; index < count && out != end; ++index){
+                *out++ = digits[index];
+            }
+            return out;
+        }
+
+        // Separators are bounds checked like the digits, a field wider than expected truncates the text
+        char* WriteChar(char* out, char* const end, const char character){
+            if (out != end){
+                *out++ = character;
+            }
+            return out;
+        }
+    }
+
     void GenericPlatformTime::Init(){
         appStartTime = EFClock::now();
         lastTime = appStartTime;
@@ -13,6 +86,73 @@ namespace EventfulEngine{
         return ToSeconds(appStartTime - lastTime);
     }
 
+    namespace{
+        GenericPlatformTime::CycleCalibration MeasureCycleCounter(const EFDuration window){
+            GenericPlatformTime::CycleCalibration calibration;
+            if (!HasInvariantCycleCounter()){
+                return calibration;
+            }
+#if defined(EF_CYCLE_COUNTER_ARM64)
+            // The virtual counter reports its own frequency, no need to measure it
+            uint64 frequency;
+            asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+            if (frequency != 0){
+                calibration.SecondsPerCycle = 1.0 / static_cast<double>(frequency);
+                calibration.B_UseCycleCounter = true;
+                return calibration;
+            }
+#endif
+            const auto startTime = std::chrono::steady_clock::now();
+            const uint64 startCycles = ReadCycleCounter();
+            auto endTime = startTime;
+            while (endTime - startTime < window){
+                endTime = std::chrono::steady_clock::now();
+            }
+            const uint64 endCycles = ReadCycleCounter();
+            if (endCycles <= startCycles){
+                return calibration;
+            }
+            calibration.SecondsPerCycle = std::chrono::duration<double>(endTime - startTime).count() /
+                static_cast<double>(endCycles - startCycles);
+            calibration.B_UseCycleCounter = true;
+            return calibration;
+        }
+
+        const GenericPlatformTime::CycleCalibration& GetMeasuredCalibration(const EFDuration window){
+            // The first caller measures, concurrent callers block until the immutable result is published
+            static const GenericPlatformTime::CycleCalibration calibration = MeasureCycleCounter(window);
+            return calibration;
+        }
+    }
+
+    void GenericPlatformTime::CalibrateCycles(const EFDuration window){
+        GetMeasuredCalibration(window);
+    }
+
+    const GenericPlatformTime::CycleCalibration& GenericPlatformTime::GetCycleCalibration(){
+        return GetMeasuredCalibration(std::chrono::milliseconds(5));
+    }
+
+    EFDuration GenericPlatformTime::GetProcessCpuTime(){
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &creation, &exit, &kernel, &user)){
+            return EFDuration::zero();
+        }
+        const auto toTicks = [](const FILETIME& time){
+            return static_cast<uint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+        };
+        // FILETIME counts 100ns intervals
+        return std::chrono::duration_cast<EFDuration>(
+            std::chrono::duration<uint64, std::ratio<1, 10'000'000>>(toTicks(kernel) + toTicks(user)));
+#else
+        timespec time{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return std::chrono::duration_cast<EFDuration>(std::chrono::seconds(time.tv_sec) +
+                                                      std::chrono::nanoseconds(time.tv_nsec));
+#endif
+    }
+
     EFDuration GenericPlatformTime::StepTime(){
         const auto now = EFClock::now();
         const auto delta = now - lastTime;
@@ -54,8 +194,12 @@ namespace EventfulEngine{
         return std::chrono::duration_cast<std::chrono::duration<double, std::ratio<86400>>>(d).count();
     }
 
-    EFString GenericPlatformTime::DurationToString(EFDuration d){
+    std::string_view GenericPlatformTime::FormatDuration(EFDuration d,
+                                                         const std::span<char, DurationBufferSize> buffer){
         using namespace std::chrono;
+        if (d < EFDuration::zero()){
+            d = EFDuration::zero();
+        }
         const auto h = duration_cast<hours>(d);
         d -= h;
         const auto m = duration_cast<minutes>(d);
@@ -64,22 +208,80 @@ namespace EventfulEngine{
         d -= s;
         const auto ms = duration_cast<milliseconds>(d);
 
-        std::ostringstream oss;
-        oss << std::setfill('0')
-            << std::setw(2) << h.count() << ":"
-            << std::setw(2) << m.count() << ":"
-            << std::setw(2) << s.count() << "."
-            << std::setw(3) << ms.count();
-        return oss.str();
+        char* const end = buffer.data() + buffer.size();
+        char* out = WriteDigits(buffer.data(), end, static_cast<uint64>(h.count()), 2);
+        out = WriteChar(out, end, ':');
+        out = WriteDigits(out, end, static_cast<uint64>(m.count()), 2);
+        out = WriteChar(out, end, ':');
+        out = WriteDigits(out, end, static_cast<uint64>(s.count()), 2);
+        out = WriteChar(out, end, '.');
+        out = WriteDigits(out, end, static_cast<uint64>(ms.count()), 3);
+        return {buffer.data(), static_cast<size_t>(out - buffer.data())};
     }
 
-    EFString GenericPlatformTime::DateTimeToString(const SystemClock::time_point timePoint){
+    std::string_view GenericPlatformTime::FormatShortDuration(const EFDuration d,
+                                                              const std::span<char, DurationBufferSize> buffer){
+        const double nanoseconds = std::chrono::duration<double, std::nano>(d).count();
+        const double magnitude = nanoseconds < 0.0 ? -nanoseconds : nanoseconds;
+        double value = nanoseconds / 1e9;
+        std::string_view unit = "s";
+        if (magnitude < 1e3){
+            value = nanoseconds;
+            unit = "ns";
+        }
+        else if (magnitude < 1e6){
+            value = nanoseconds / 1e3;
+            unit = "us";
+        }
+        else if (magnitude < 1e9){
+            value = nanoseconds / 1e6;
+            unit = "ms";
+        }
+
+        char* const end = buffer.data() + buffer.size();
+        const auto result = std::to_chars(buffer.data(), end - unit.size(), value, std::chars_format::fixed, 2);
+        if (result.ec != std::errc{}){
+            return {};
+        }
+        char* out = result.ptr;
+        for (const char character : unit){
+            *out++ = character;
+        }
+        return {buffer.data(), static_cast<size_t>(out - buffer.data())};
+    }
+
+    EFString GenericPlatformTime::DurationToString(const EFDuration d){
+        char buffer[DurationBufferSize];
+        return EFString{FormatDuration(d, buffer)};
+    }
+
+    std::string_view GenericPlatformTime::FormatDateTime(const SystemClock::time_point timePoint,
+                                                         const std::span<char, DateTimeStringLength> buffer){
         const std::time_t time = SystemClock::to_time_t(timePoint);
-        tm* timeStructure = nullptr;
-        localtime_s(timeStructure, &time);
-        std::ostringstream oss;
-        oss << std::put_time(timeStructure, "%Y-%m-%d %H:%M:%S");
-        return oss.str();
+        std::tm local{};
+#if defined(_MSC_VER)
+        localtime_s(&local, &time);
+#else
+        localtime_r(&time, &local);
+#endif
+        char* const end = buffer.data() + buffer.size();
+        char* out = WriteDigits(buffer.data(), end, static_cast<uint64>(local.tm_year + 1900), 4);
+        out = WriteChar(out, end, '-');
+        out = WriteDigits(out, end, static_cast<uint64>(local.tm_mon + 1), 2);
+        out = WriteChar(out, end, '-');
+        out = WriteDigits(out, end, static_cast<uint64>(local.tm_mday), 2);
+        out = WriteChar(out, end, ' ');
+        out = WriteDigits(out, end, static_cast<uint64>(local.tm_hour), 2);
+        out = WriteChar(out, end, ':');
+        out = WriteDigits(out, end, static_cast<uint64>(local.tm_min), 2);
+        out = WriteChar(out, end, ':');
+        out = WriteDigits(out, end, static_cast<uint64>(local.tm_sec), 2);
+        return {buffer.data(), static_cast<size_t>(out - buffer.data())};
+    }
+
+    EFString GenericPlatformTime::DateTimeToString(const SystemClock::time_point timePoint){
+        char buffer[DateTimeStringLength];
+        return EFString{FormatDateTime(timePoint, buffer)};
     }
 
     EFString GenericPlatformTime::NowDateTimeString(){
@@ -0,0 +1,476 @@
+#pragma once
+
+#include "EFLogger.h"
+#include "EFText.h"
+#include "Thread.h"
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace EventfulEngine{
+    namespace LogDetail{
+        /**
+         * Single producer, single consumer byte ring. The owning thread reserves and commits records, the backend
+         * thread reads them. Positions only ever grow, the offset into the buffer is the position masked by the
+         * power of two capacity. Records never wrap, the unused tail of the buffer is skipped instead.
+         */
+        class LogRing{
+        public:
+            explicit LogRing(const uint32 capacity) : _capacity(capacity),
+                                                      _buffer(std::make_unique<std::byte[]>(capacity)){
+            }
+
+            [[nodiscard]] uint32 GetCapacity() const{ return _capacity; }
+
+            std::byte* Reserve(const uint32 size){
+                uint64 head = _head.load(std::memory_order_relaxed);
+                const uint32 contiguous = _capacity - Offset(head);
+                const uint32 padding = size > contiguous ? contiguous : 0u;
+
+                if (head + padding + size - _cachedTail > _capacity){
+                    _cachedTail = _tail.load(std::memory_order_acquire);
+                    if (head + padding + size - _cachedTail > _capacity){
+                        return nullptr;
+                    }
+                }
+
+                if (padding >= sizeof(RecordHeader)){
+                    // Decode stays null, the consumer skips the rest of the buffer
+                    new(_buffer.get() + Offset(head)) RecordHeader{nullptr, nullptr, 0, padding};
+                }
+                head += padding;
+                _reservedHead = head + size;
+                return _buffer.get() + Offset(head);
+            }
+
+            void Commit(){
+                _head.store(_reservedHead, std::memory_order_release);
+            }
+
+            /** Calls the visitor for every committed record, returns the number of records visited. */
+            template <typename Visitor>
+            uint32 Consume(Visitor&& visitor){
+                uint64 tail = _tail.load(std::memory_order_relaxed);
+                const uint64 head = _head.load(std::memory_order_acquire);
+                uint32 count = 0;
+                while (tail != head){
+                    const uint32 contiguous = _capacity - Offset(tail);
+                    if (contiguous < sizeof(RecordHeader)){
+                        tail += contiguous;
+                        continue;
+                    }
+
+                    const auto* header = reinterpret_cast<const RecordHeader*>(_buffer.get() + Offset(tail));
+                    if (header->Decode){
+                        visitor(*header);
+                        ++count;
+                    }
+                    tail += header->Size;
+                }
+                _tail.store(tail, std::memory_order_release);
+                return count;
+            }
+
+            [[nodiscard]] bool IsEmpty() const{
+                return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+            }
+
+            std::atomic<bool> bIsAbandoned{false};
+
+        private:
+            [[nodiscard]] uint32 Offset(const uint64 position) const{
+                return static_cast<uint32>(position & (_capacity - 1));
+            }
+
+            const uint32 _capacity;
+            std::unique_ptr<std::byte[]> _buffer;
+
+            // Producer and consumer positions live on their own cache lines
+            alignas(64) std::atomic<uint64> _head{0};
+            uint64 _reservedHead{0};
+            uint64 _cachedTail{0};
+            alignas(64) std::atomic<uint64> _tail{0};
+        };
+
+        class LogBackend{
+        public:
+            static LogBackend& Get(){
+                static LogBackend backend;
+                return backend;
+            }
+
+            NOMOVEORCOPY(LogBackend)
+
+            ~LogBackend(){
+                Stop();
+            }
+
+            /** Ring of the calling thread, null on the logger thread or once the thread is shutting down. */
+            LogRing* GetThreadRing(){
+                if (t_bIsLoggerThread || t_bIsRingReleased){
+                    return nullptr;
+                }
+
+                // The holder keeps the ring alive for the backend after the thread exited
+                struct ThreadRingHolder{
+                    std::shared_ptr<LogRing> Ring;
+
+                    ~ThreadRingHolder(){
+                        t_ring = nullptr;
+                        t_bIsRingReleased = true;
+                        if (Ring){
+                            Ring->bIsAbandoned.store(true, std::memory_order_release);
+                        }
+                    }
+                };
+
+                thread_local ThreadRingHolder holder;
+                if (!holder.Ring){
+                    holder.Ring = std::make_shared<LogRing>(_ringCapacity.load(std::memory_order_relaxed));
+                    ScopeLock lock(_ringsMutex);
+                    _rings.push_back(holder.Ring);
+                    EnsureStarted();
+                }
+                t_ring = holder.Ring.get();
+                return t_ring;
+            }
+
+            void Wake(){
+                _wake.notify_one();
+            }
+
+            /** Records that can not go through a ring are formatted right away and queued here. */
+            void PushFormatted(const RecordHeader& header, EFString message){
+                {
+                    ScopeLock lock(_formattedMutex);
+                    _formatted.push_back({header.Category, header.Level, header.Timestamp, std::move(message)});
+                }
+                if (!_bIsRunning.load(std::memory_order_acquire)){
+                    DrainAll();
+                }
+            }
+
+            void Flush(){
+                if (t_bIsLoggerThread){
+                    return;
+                }
+                if (!_bIsRunning.load(std::memory_order_acquire)){
+                    DrainAll();
+                    return;
+                }
+
+                UniqueLock lock(_wakeMutex);
+                const uint64 ticket = ++_flushRequested;
+                _wake.notify_one();
+                _flushed.wait(lock, [this, ticket]{
+                    return _flushCompleted >= ticket || !_bIsRunning.load(std::memory_order_acquire);
+                });
+            }
+
+            void Stop(){
+                if (_thread.joinable()){
+                    _thread.request_stop();
+                    _wake.notify_one();
+                    _thread.join();
+                }
+                {
+                    ScopeLock lock(_wakeMutex);
+                    _bIsRunning.store(false, std::memory_order_release);
+                    _flushed.notify_all();
+                }
+                DrainAll();
+            }
+
+            [[nodiscard]] bool IsRunning() const{
+                return _bIsRunning.load(std::memory_order_acquire);
+            }
+
+            std::atomic<uint32> _ringCapacity{256u * 1024u};
+            std::atomic<bool> _bConsoleOutput{true};
+            Mutex _settingsMutex;
+            EFString _logDirectory{"Logs"};
+
+            static thread_local bool t_bIsLoggerThread;
+            // Cached ring pointer, a plain thread local is much cheaper to reach than the holder
+            static thread_local LogRing* t_ring;
+            static thread_local bool t_bIsRingReleased;
+
+        private:
+            struct FormattedRecord{
+                const EFLogCategory* Category;
+                E_EFLogLevel Level;
+                int64 Timestamp;
+                EFString Message;
+            };
+
+            struct CategoryOutput{
+                std::ofstream File;
+                EFString Batch;
+            };
+
+            LogBackend() : _clockOffset(std::chrono::duration_cast<SystemClock::duration>(
+                SystemClock::now().time_since_epoch() - EFClock::now().time_since_epoch())){
+            }
+
+            void EnsureStarted(){
+                if (_bIsStarted.exchange(true)){
+                    return;
+                }
+                _bIsRunning.store(true, std::memory_order_release);
+                _thread = std::jthread([this](const std::stop_token& stopToken){ Run(stopToken); });
+            }
+
+            void Run(const std::stop_token& stopToken){
+                t_bIsLoggerThread = true;
+                while (!stopToken.stop_requested()){
+                    uint64 flushRequested = 0;
+                    {
+                        UniqueLock lock(_wakeMutex);
+                        flushRequested = _flushRequested;
+                    }
+
+                    const bool bWroteAnything = DrainAll();
+
+                    UniqueLock lock(_wakeMutex);
+                    if (flushRequested > _flushCompleted){
+                        _flushCompleted = flushRequested;
+                        _flushed.notify_all();
+                    }
+                    if (!bWroteAnything && _flushRequested == _flushCompleted){
+                        // Producers only wake us for errors and full rings, batching everything else
+                        _wake.wait_for(lock, std::chrono::milliseconds(2));
+                    }
+                }
+                t_bIsLoggerThread = false;
+            }
+
+            bool DrainAll(){
+                ScopeLock drainLock(_drainMutex);
+                uint32 written = 0;
+
+                std::vector<std::shared_ptr<LogRing>> rings;
+                {
+                    ScopeLock lock(_ringsMutex);
+                    rings = _rings;
+                }
+
+                EFString message;
+                for (const auto& ring : rings){
+                    written += ring->Consume([this, &message](const RecordHeader& header){
+                        header.Decode(reinterpret_cast<const std::byte*>(&header) + sizeof(RecordHeader), message);
+                        Append(*header.Category, header.Level, header.Timestamp, message);
+                    });
+                }
+
+                std::vector<FormattedRecord> formatted;
+                {
+                    ScopeLock lock(_formattedMutex);
+                    formatted.swap(_formatted);
+                }
+                for (const FormattedRecord& record : formatted){
+                    Append(*record.Category, record.Level, record.Timestamp, record.Message);
+                    ++written;
+                }
+
+                if (written > 0){
+                    WriteBatches();
+                }
+
+                // Rings of finished threads are dropped once they are empty
+                {
+                    ScopeLock lock(_ringsMutex);
+                    std::erase_if(_rings, [](const std::shared_ptr<LogRing>& ring){
+                        return ring->bIsAbandoned.load(std::memory_order_acquire) && ring->IsEmpty();
+                    });
+                }
+                return written > 0;
+            }
+
+            static EFText::EFTextColor LevelColor(const E_EFLogLevel level){
+                switch (level){
+                    using enum E_EFLogLevel;
+                case trace: return EFText::EFTextColor::BrightBlack;
+                case debug: return EFText::EFTextColor::Cyan;
+                case info: return EFText::EFTextColor::Green;
+                case warn: return EFText::EFTextColor::Yellow;
+                case err: return EFText::EFTextColor::Red;
+                case critical: return EFText::EFTextColor::BrightRed;
+                default: return EFText::EFTextColor::TextColor;
+                }
+            }
+
+            static std::string_view LevelName(const E_EFLogLevel level){
+                switch (level){
+                    using enum E_EFLogLevel;
+                case trace: return "trace";
+                case debug: return "debug";
+                case info: return "info";
+                case warn: return "warning";
+                case err: return "error";
+                case critical: return "critical";
+                default: return "off";
+                }
+            }
+
+            void Append(const EFLogCategory& category, const E_EFLogLevel level, const int64 timestamp,
+                        const std::string_view message){
+                const auto time = std::chrono::floor<std::chrono::milliseconds>(SystemClock::time_point{
+                    std::chrono::duration_cast<SystemClock::duration>(EFDuration{timestamp}) + _clockOffset});
+                const EFString prefix = std::format("[{:%H:%M:%S}] [{}] ", time, category.GetName());
+
+                CategoryOutput& output = _outputs[&category];
+                output.Batch.append(prefix).append("[").append(LevelName(level)).append("] ").append(message).
+                       push_back('\n');
+
+                if (_bConsoleOutput.load(std::memory_order_relaxed)){
+                    _consoleBatch.append(prefix).append(EFText::ColorCode(LevelColor(level))).append("[").
+                                  append(LevelName(level)).append("]").
+                                  append(EFText::ColorCode(EFText::EFTextColor::TextColor)).append(" ").
+                                  append(message).push_back('\n');
+                }
+            }
+
+            void WriteBatches(){
+                for (auto& [category, output] : _outputs){
+                    if (output.Batch.empty()){
+                        continue;
+                    }
+                    if (!output.File.is_open()){
+                        std::filesystem::path directory;
+                        {
+                            ScopeLock lock(_settingsMutex);
+                            directory = _logDirectory;
+                        }
+                        std::error_code error;
+                        std::filesystem::create_directories(directory, error);
+                        output.File.open(directory / category->GetFileName(), std::ios::out | std::ios::trunc);
+                    }
+                    output.File.write(output.Batch.data(), static_cast<std::streamsize>(output.Batch.size()));
+                    output.File.flush();
+                    output.Batch.clear();
+                }
+
+                if (!_consoleBatch.empty()){
+                    std::fwrite(_consoleBatch.data(), 1, _consoleBatch.size(), stdout);
+                    std::fflush(stdout);
+                    _consoleBatch.clear();
+                }
+            }
+
+            const SystemClock::duration _clockOffset;
+
+            Mutex _ringsMutex;
+            std::vector<std::shared_ptr<LogRing>> _rings;
+
+            Mutex _formattedMutex;
+            std::vector<FormattedRecord> _formatted;
+
+            // Only touched while holding the drain mutex
+            Mutex _drainMutex;
+            std::unordered_map<const EFLogCategory*, CategoryOutput> _outputs;
+            EFString _consoleBatch;
+
+            Mutex _wakeMutex;
+            std::condition_variable _wake;
+            std::condition_variable _flushed;
+            uint64 _flushRequested{0};
+            uint64 _flushCompleted{0};
+
+            std::atomic<bool> _bIsStarted{false};
+            std::atomic<bool> _bIsRunning{false};
+            std::jthread _thread;
+        };
+
+        thread_local bool LogBackend::t_bIsLoggerThread = false;
+        thread_local LogRing* LogBackend::t_ring = nullptr;
+        thread_local bool LogBackend::t_bIsRingReleased = false;
+
+        // Records that do not fit into a ring, or come from the logger thread itself, are built here
+        thread_local std::vector<std::byte> t_scratchRecord;
+        thread_local LogRing* t_reservedRing = nullptr;
+
+        std::byte* ReserveRecord(const uint32 size){
+            LogBackend& backend = LogBackend::Get();
+            // After shutdown nobody drains the rings anymore, records are then written synchronously
+            if (LogRing* ring = LogBackend::t_ring ? LogBackend::t_ring : backend.GetThreadRing();
+                ring && size <= ring->GetCapacity() / 2 && backend.IsRunning()){
+                while (true){
+                    if (std::byte* record = ring->Reserve(size)){
+                        t_reservedRing = ring;
+                        return record;
+                    }
+                    // Full, let the backend catch up
+                    backend.Wake();
+                    std::this_thread::yield();
+                }
+            }
+
+            t_scratchRecord.resize(size);
+            t_reservedRing = nullptr;
+            return t_scratchRecord.data();
+        }
+
+        void CommitRecord(std::byte* record){
+            const auto* header = reinterpret_cast<const RecordHeader*>(record);
+            LogBackend& backend = LogBackend::Get();
+
+            if (t_reservedRing){
+                t_reservedRing->Commit();
+            }
+            else{
+                EFString message;
+                header->Decode(record + sizeof(RecordHeader), message);
+                backend.PushFormatted(*header, std::move(message));
+            }
+
+            if (header->Level >= E_EFLogLevel::err){
+                backend.Wake();
+            }
+        }
+
+        void FormatFailed(const std::string_view format, const char* reason, EFString& out){
+            out = EFText::Format("{} [format error: {}]", format, reason);
+        }
+    }
+
+    EFLogCategory::EFLogCategory(const char* name, const char* fileName, const E_EFLogLevel level) :
+        _name(name), _fileName(fileName), _level(level){
+        // Constructing the backend first guarantees it outlives every category during static destruction
+        LogDetail::LogBackend::Get();
+    }
+
+    EFLogCategory::~EFLogCategory(){
+        // Pending records still point to this category
+        LogDetail::LogBackend::Get().Flush();
+    }
+
+    void EFLogger::Flush(){
+        LogDetail::LogBackend::Get().Flush();
+    }
+
+    void EFLogger::Shutdown(){
+        LogDetail::LogBackend::Get().Stop();
+    }
+
+    void EFLogger::SetRingCapacity(const uint32 capacityBytes){
+        // The ring masks positions, so the capacity has to be a power of two
+        LogDetail::LogBackend::Get()._ringCapacity.store(std::bit_ceil(std::max(capacityBytes, 4096u)),
+                                                         std::memory_order_relaxed);
+    }
+
+    void EFLogger::SetLogDirectory(const EFString& directory){
+        LogDetail::LogBackend& backend = LogDetail::LogBackend::Get();
+        ScopeLock lock(backend._settingsMutex);
+        backend._logDirectory = directory;
+    }
+
+    void EFLogger::SetConsoleOutput(const bool bEnabled){
+        LogDetail::LogBackend::Get()._bConsoleOutput.store(bEnabled, std::memory_order_relaxed);
+    }
+} // EventfulEngine
@@ -39,18 +39,22 @@ namespace EventfulEngine{
 		}
 
 		const EFMemoryHandle memory = ::malloc(size);
+		// Sampled once, so the free is only reported if the allocation was
+		const bool bIsProfiled = EF_ENABLE_PROFILING && EFProfiler::IsEnabled();
 
 		{
 			std::scoped_lock lock(_data->Mutex);
 			EFAllocation& alloc = _data->AllocationMap[memory];
 			alloc.Memory = memory;
 			alloc.Size = size;
+			alloc.bIsProfiled = bIsProfiled;
 			g_globalStats.TotalAllocated += size;
+			++g_globalStats.AllocationCount;
 		}
 
-#if EF_ENABLE_PROFILING
-		TracyAlloc(memory, size);
-#endif
+		if (bIsProfiled){
+			EF_PROFILE_ALLOC(memory, size);
+		}
 
 		return memory;
 	}
@@ -61,22 +65,25 @@ namespace EventfulEngine{
 		}
 
 		const EFMemoryHandle memory = ::malloc(size);
+		const bool bIsProfiled = EF_ENABLE_PROFILING && EFProfiler::IsEnabled();
 
 		{
 			std::scoped_lock lock(_data->Mutex);
-			auto& [Memory, Size, Category] = _data->AllocationMap[memory];
+			auto& [Memory, Size, Category, bIsAllocationProfiled] = _data->AllocationMap[memory];
 			Memory = memory;
 			Size = size;
 			Category = desc;
+			bIsAllocationProfiled = bIsProfiled;
 
 			g_globalStats.TotalAllocated += size;
+			++g_globalStats.AllocationCount;
 			if (desc)
 				_data->AllocationStatsMap_[desc].TotalAllocated += size;
 		}
 
-#if EF_ENABLE_PROFILING
-		TracyAlloc(memory, size);
-#endif
+		if (bIsProfiled){
+			EF_PROFILE_ALLOC(memory, size);
+		}
 
 		return memory;
 	}
@@ -87,21 +94,24 @@ namespace EventfulEngine{
 		}
 
 		void* memory = ::malloc(size);
+		const bool bIsProfiled = EF_ENABLE_PROFILING && EFProfiler::IsEnabled();
 
 		{
 			std::scoped_lock lock(_data->Mutex);
-			auto& [Memory, Size, Category] = _data->AllocationMap[memory];
+			auto& [Memory, Size, Category, bIsAllocationProfiled] = _data->AllocationMap[memory];
 			Memory = memory;
 			Size = size;
 			Category = file;
+			bIsAllocationProfiled = bIsProfiled;
 
 			g_globalStats.TotalAllocated += size;
+			++g_globalStats.AllocationCount;
 			_data->AllocationStatsMap_[file].TotalAllocated += size;
 		}
 
-#if EF_ENABLE_PROFILING
-		TracyAlloc(memory, size);
-#endif
+		if (bIsProfiled){
+			EF_PROFILE_ALLOC(memory, size);
+		}
 
 		return memory;
 	}
@@ -117,6 +127,7 @@ namespace EventfulEngine{
 
 		{
 			bool found = false;
+			bool bWasProfiled = false;
 			{
 				std::scoped_lock lock(_data->Mutex);
 				const auto allocMapIt = _data->AllocationMap.find(memory);
@@ -124,6 +135,8 @@ namespace EventfulEngine{
 				if (found){
 					const EFAllocation& alloc = allocMapIt->second;
 					g_globalStats.TotalFreed += alloc.Size;
+					++g_globalStats.FreeCount;
+					bWasProfiled = alloc.bIsProfiled;
 
 					if (alloc.Category){
 						_data->AllocationStatsMap_[alloc.Category].TotalFreed += alloc.Size;
@@ -133,22 +146,21 @@ namespace EventfulEngine{
 				}
 			}
 
-#if EF_ENABLE_PROFILING
-			TracyFree(memory);
-#endif
+			if (bWasProfiled){
+				EF_PROFILE_FREE(memory);
+			}
 
-#ifndef EF_DISTRIBUTED
+			// Discarded at compile time in distribution builds, see EF_LOG_COMPILE_MIN_LEVEL
 			if (!found){
 				EF_WARN_CAT(CoreLog,
 				            "Memory block {} not present in alloc map", memory.ptr);
 			}
-#endif
 		}
 
 		::free(memory);
 	}
 
-	namespace Memory{
+	namespace EFMemory{
 		const EFAllocationStats& GetAllocationStats(){ return g_globalStats; }
 	}}
 
@@ -1,9 +1,31 @@
 #pragma once
 
 #include "EfCommandRegistry.h"
+#include "EFHashMap.h"
 
 namespace EventfulEngine{
-    static std::unordered_map<EFString, EFCommandFunction> g_commands;
+    static EFHashMap<EFString, EFCommandFunction> g_commands;
+
+    namespace{
+        bool IsSeparator(const char character){
+            return character == ' ' || (character >= '\t' && character <= '\r');
+        }
+
+        /** Cuts the next whitespace separated token off the front of text, empty once text is exhausted. */
+        std::string_view NextToken(std::string_view& text){
+            size_t start = 0;
+            while (start < text.size() && IsSeparator(text[start])){
+                ++start;
+            }
+            size_t end = start;
+            while (end < text.size() && !IsSeparator(text[end])){
+                ++end;
+            }
+            const std::string_view token = text.substr(start, end - start);
+            text.remove_prefix(end);
+            return token;
+        }
+    }
 
     void EFCommandRegistry::Register(const EFString& name, EFCommandFunction func){
         g_commands[name] = std::move(func);
@@ -13,10 +35,9 @@ namespace EventfulEngine{
         g_commands.erase(name);
     }
 
-    bool EFCommandRegistry::Execute(const EFString& commandLine){
-        std::istringstream stringStream(commandLine);
-        EFString cmd;
-        if (!(stringStream >> cmd)){
+    bool EFCommandRegistry::Execute(std::string_view commandLine){
+        const std::string_view cmd = NextToken(commandLine);
+        if (cmd.empty()){
             return false;
         }
         const auto iterator = g_commands.find(cmd);
@@ -24,10 +45,9 @@ namespace EventfulEngine{
             return false;
         }
 
-        std::vector<EFString> args;
-        EFString arg;
-        while (stringStream >> arg){
-            args.push_back(arg);
+        EFCommandArgs args;
+        for (std::string_view arg = NextToken(commandLine); !arg.empty(); arg = NextToken(commandLine)){
+            args.emplace_back(arg);
         }
 
         iterator->second(args);
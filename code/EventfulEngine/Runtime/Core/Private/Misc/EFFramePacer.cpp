@@ -0,0 +1,125 @@
+#pragma once
+
+#include "EFFramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace EventfulEngine{
+    EFFramePacer::EFFramePacer(const EFFramePacerSettings& settings){
+        SetSettings(settings);
+    }
+
+    void EFFramePacer::SetSettings(const EFFramePacerSettings& settings){
+        _settings = settings;
+        _timing.FixedStepSeconds = settings.FixedStepHz > 0.0 ? 1.0 / settings.FixedStepHz : 0.0;
+        _accumulator = 0.0;
+        _deadlineCycles = 0;
+    }
+
+    const EFFrameTiming& EFFramePacer::BeginFrame(){
+        const uint64 now = EFPlatformTime::Cycles64();
+        double frameSeconds = 0.0;
+        if (_frameStartCycles != 0){
+            frameSeconds = EFPlatformTime::CyclesToSeconds(now - _frameStartCycles);
+            if (!_bIsResumingFromIdle){
+                _frameHistory[_frameCount % HistorySize] = frameSeconds;
+                ++_frameCount;
+            }
+        }
+        _bIsResumingFromIdle = false;
+        _frameStartCycles = now;
+
+        _timing.FrameIndex++;
+        _timing.DeltaSeconds = std::min(frameSeconds, EFPlatformTime::ToSeconds(_settings.MaxDeltaTime));
+
+        _timing.FixedSteps = 0;
+        _timing.InterpolationAlpha = 0.0;
+        if (const double step = _timing.FixedStepSeconds; step > 0.0){
+            _accumulator += _timing.DeltaSeconds;
+            while (_accumulator >= step && _timing.FixedSteps < _settings.MaxFixedSteps){
+                _accumulator -= step;
+                ++_timing.FixedSteps;
+            }
+            // Time the step cap could not catch up on is dropped, the simulation slows down instead of stalling
+            _accumulator = std::fmod(_accumulator, step);
+            _timing.InterpolationAlpha = _accumulator / step;
+        }
+        return _timing;
+    }
+
+    void EFFramePacer::EndFrame(){
+        if (_settings.TargetFps <= 0.0){
+            return;
+        }
+
+        const uint64 periodCycles = EFPlatformTime::SecondsToCycles(1.0 / _settings.TargetFps);
+        uint64 now = EFPlatformTime::Cycles64();
+        if (_deadlineCycles == 0){
+            _deadlineCycles = _frameStartCycles + periodCycles;
+        }
+
+        if (now >= _deadlineCycles){
+            const double lateness = EFPlatformTime::CyclesToSeconds(now - _deadlineCycles);
+            _maxLatenessSeconds = std::max(_maxLatenessSeconds, lateness);
+            ++_missedDeadlines;
+            // More than a frame behind, pace from now on instead of rushing frames to catch up
+            _deadlineCycles = now - _deadlineCycles > periodCycles ? now + periodCycles : _deadlineCycles + periodCycles;
+            return;
+        }
+
+        const uint64 spinCycles = EFPlatformTime::SecondsToCycles(EFPlatformTime::ToSeconds(_settings.SpinWindow));
+        if (const uint64 remaining = _deadlineCycles - now; remaining > spinCycles){
+            std::this_thread::sleep_for(EFPlatformTime::CyclesToDuration(remaining - spinCycles));
+        }
+        while ((now = EFPlatformTime::Cycles64()) < _deadlineCycles){
+            std::this_thread::yield();
+        }
+
+        _maxLatenessSeconds = std::max(_maxLatenessSeconds, EFPlatformTime::CyclesToSeconds(now - _deadlineCycles));
+        _deadlineCycles += periodCycles;
+    }
+
+    void EFFramePacer::EndIdleFrame(){
+        _deadlineCycles = 0;
+        _bIsResumingFromIdle = true;
+    }
+
+    EFFramePacerStats EFFramePacer::GetStats() const{
+        EFFramePacerStats stats;
+        stats.FrameCount = _frameCount;
+        stats.MaxLatenessSeconds = _maxLatenessSeconds;
+        stats.MissedDeadlines = _missedDeadlines;
+
+        const uint64 count = std::min<uint64>(_frameCount, HistorySize);
+        if (count == 0){
+            return stats;
+        }
+
+        double sum = 0.0;
+        stats.MinFrameSeconds = std::numeric_limits<double>::max();
+        for (uint64 index = 0; index < count; ++index){
+            const double frameSeconds = _frameHistory[index];
+            sum += frameSeconds;
+            stats.MinFrameSeconds = std::min(stats.MinFrameSeconds, frameSeconds);
+            stats.MaxFrameSeconds = std::max(stats.MaxFrameSeconds, frameSeconds);
+        }
+        stats.AverageFrameSeconds = sum / static_cast<double>(count);
+
+        double variance = 0.0;
+        for (uint64 index = 0; index < count; ++index){
+            const double deviation = _frameHistory[index] - stats.AverageFrameSeconds;
+            variance += deviation * deviation;
+        }
+        stats.JitterSeconds = std::sqrt(variance / static_cast<double>(count));
+        return stats;
+    }
+
+    void EFFramePacer::ResetStats(){
+        _frameCount = 0;
+        _maxLatenessSeconds = 0.0;
+        _missedDeadlines = 0;
+    }
+} // EventfulEngine
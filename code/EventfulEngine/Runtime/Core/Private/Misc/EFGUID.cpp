@@ -3,16 +3,15 @@
 #include "EFGUID.h"
 #include "Platform.h"
 
-#if EF_PLATFORM_LINUX
-#include <uuid/uuid.h>
-#endif
-
-#if EF_PLATFORM_APPLE
-#include <CoreFoundation/CFUUID.h>
-#endif
-
-#if EF_PLATFORM_WINDOWS
-#include <objbase.h>
+#include <bit>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#if EF_PLATFORM_SSE2
+#include <emmintrin.h>
+#elif EF_PLATFORM_NEON
+#include <arm_neon.h>
 #endif
 
 namespace EventfulEngine{
@@ -26,29 +25,196 @@ namespace EventfulEngine{
 		return *this != empty;
 	}
 
-	EFString EFGUID::String() const{
-		std::array<char, 10> one{};
-		std::array<char, 6> two{};
-		std::array<char, 6> three{};
-		std::array<char, 6> four{};
-		std::array<char, 14> five{};
-
-		std::format_to_n(one.begin(), one.size(), "{:02x}{:02x}{:02x}{:02x}", _bytes[0], _bytes[1], _bytes[2],
-		                 _bytes[3]);
-		std::format_to_n(two.begin(), 6, "{:02x}{:02x}", _bytes[4], _bytes[5]);
-		std::format_to_n(three.begin(), 6, "{:02x}{:02x}", _bytes[6], _bytes[7]);
-		std::format_to_n(four.begin(), 6, "{:02x}{:02x}", _bytes[8], _bytes[9]);
-		std::format_to_n(five.begin(), 14, "{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}", _bytes[10], _bytes[11], _bytes[12],
-		                 _bytes[13], _bytes[14],
-		                 _bytes[15]);
-		const EFString sep("-");
-		EFString out(one.data());
-
-		out += sep + two.data();
-		out += sep + three.data();
-		out += sep + four.data();
-		out += sep + five.data();
+	namespace{
+		constexpr std::array<int8, 256> HEX_VALUES = []{
+			std::array<int8, 256> values{};
+			values.fill(-1);
+			for (int8 digit = 0; digit < 10; ++digit){
+				values['0' + digit] = digit;
+			}
+			for (int8 letter = 0; letter < 6; ++letter){
+				values['a' + letter] = static_cast<int8>(10 + letter);
+				values['A' + letter] = static_cast<int8>(10 + letter);
+			}
+			return values;
+		}();
+
+#if EF_PLATFORM_SSE2
+		// '0' + nibble, letters additionally skip the gap between '9' and 'a'
+		__m128i NibblesToHex(const __m128i nibbles){
+			const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)),
+			                                      _mm_set1_epi8('a' - '0' - 10));
+			return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+		}
+
+		// Values of 16 hex digits, false if any of them is not a hex digit
+		bool HexToNibbles(const __m128i text, __m128i& nibbles){
+			// Unsigned x <= limit, SSE2 only has signed byte compares
+			const auto lessEqual = [](const __m128i value, const uint8 limit){
+				return _mm_cmpeq_epi8(_mm_min_epu8(value, _mm_set1_epi8(static_cast<char>(limit))), value);
+			};
+
+			const __m128i digits = _mm_sub_epi8(text, _mm_set1_epi8('0'));
+			const __m128i letters = _mm_sub_epi8(_mm_or_si128(text, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+			const __m128i isDigit = lessEqual(digits, 9);
+			const __m128i isLetter = lessEqual(letters, 5);
+			if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF){
+				return false;
+			}
+			nibbles = _mm_or_si128(_mm_and_si128(isDigit, digits),
+			                       _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+			return true;
+		}
+
+		// Joins pairs of nibbles, the first of every pair is the high one, into 8 bytes in the low half
+		__m128i PackNibbles(const __m128i nibbles){
+			const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+			const __m128i low = _mm_srli_epi16(nibbles, 8);
+			return _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+		}
+#endif
+
+		/** Encodes the 16 bytes as 32 lower case hex digits. */
+		void EncodeHex(const std::array<unsigned char, 16>& bytes, char* out){
+#if EF_PLATFORM_SSE2
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes.data()));
+			const __m128i mask = _mm_set1_epi8(0x0F);
+			const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), mask);
+			const __m128i low = _mm_and_si128(input, mask);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), NibblesToHex(_mm_unpacklo_epi8(high, low)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), NibblesToHex(_mm_unpackhi_epi8(high, low)));
+#elif EF_PLATFORM_NEON
+			const uint8x16_t input = vld1q_u8(bytes.data());
+			const uint8x16x2_t nibbles = vzipq_u8(vshrq_n_u8(input, 4), vandq_u8(input, vdupq_n_u8(0x0F)));
+			const uint8x16_t table = vld1q_u8(reinterpret_cast<const uint8*>("0123456789abcdef"));
+			vst1q_u8(reinterpret_cast<uint8*>(out), vqtbl1q_u8(table, nibbles.val[0]));
+			vst1q_u8(reinterpret_cast<uint8*>(out + 16), vqtbl1q_u8(table, nibbles.val[1]));
+#else
+			constexpr std::string_view digits = "0123456789abcdef";
+			for (size_t index = 0; index < bytes.size(); ++index){
+				out[index * 2] = digits[bytes[index] >> 4];
+				out[index * 2 + 1] = digits[bytes[index] & 0x0F];
+			}
+#endif
+		}
+
+		/** Decodes exactly 32 hex digits, false if any of them is invalid. */
+		bool DecodeHex(const char* text, std::array<unsigned char, 16>& bytes){
+#if EF_PLATFORM_SSE2
+			__m128i first;
+			__m128i second;
+			if (!HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), first) ||
+				!HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16)), second)){
+				return false;
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes.data()),
+			                 _mm_unpacklo_epi64(PackNibbles(first), PackNibbles(second)));
+			return true;
+#elif EF_PLATFORM_NEON
+			const uint8x16_t first = vld1q_u8(reinterpret_cast<const uint8*>(text));
+			const uint8x16_t second = vld1q_u8(reinterpret_cast<const uint8*>(text + 16));
+			// Even digits are the high nibbles, odd digits the low ones
+			const uint8x16x2_t split = vuzpq_u8(first, second);
+			uint8x16_t nibbles[2];
+			for (int32 half = 0; half < 2; ++half){
+				const uint8x16_t digits = vsubq_u8(split.val[half], vdupq_n_u8('0'));
+				const uint8x16_t letters = vsubq_u8(vorrq_u8(split.val[half], vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+				const uint8x16_t isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+				const uint8x16_t isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+				if (vminvq_u8(vorrq_u8(isDigit, isLetter)) == 0){
+					return false;
+				}
+				nibbles[half] = vorrq_u8(vandq_u8(isDigit, digits),
+				                         vandq_u8(isLetter, vaddq_u8(letters, vdupq_n_u8(10))));
+			}
+			vst1q_u8(bytes.data(), vorrq_u8(vshlq_n_u8(nibbles[0], 4), nibbles[1]));
+			return true;
+#else
+			for (size_t index = 0; index < bytes.size(); ++index){
+				const int8 high = HEX_VALUES[static_cast<uint8>(text[index * 2])];
+				const int8 low = HEX_VALUES[static_cast<uint8>(text[index * 2 + 1])];
+				if ((high | low) < 0){
+					return false;
+				}
+				bytes[index] = static_cast<unsigned char>(high << 4 | low);
+			}
+			return true;
+#endif
+		}
+
+		/** xoshiro256**, seeded once per thread. Fast and statistically strong, not meant for cryptography. */
+		class GuidRandom{
+		public:
+			GuidRandom(){
+				std::random_device device;
+				uint64 seed = static_cast<uint64>(device()) << 32 ^ device();
+				// Distinct even when random_device is deterministic on the platform
+				seed ^= std::hash<std::thread::id>{}(std::this_thread::get_id());
+				seed ^= static_cast<uint64>(EFClock::now().time_since_epoch().count());
+				for (uint64& state : _state){
+					state = SplitMix(seed);
+				}
+			}
 
+			uint64 Next(){
+				const uint64 result = std::rotl(_state[1] * 5, 7) * 9;
+				const uint64 shifted = _state[1] << 17;
+				_state[2] ^= _state[0];
+				_state[3] ^= _state[1];
+				_state[1] ^= _state[2];
+				_state[0] ^= _state[3];
+				_state[2] ^= shifted;
+				_state[3] = std::rotl(_state[3], 45);
+				return result;
+			}
+
+		private:
+			static uint64 SplitMix(uint64& seed){
+				uint64 value = seed += 0x9E3779B97F4A7C15ull;
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+				return value ^ (value >> 31);
+			}
+
+			std::array<uint64, 4> _state{};
+		};
+
+		EFGUID MakeRandomGuid(GuidRandom& random){
+			std::array<unsigned char, 16> bytes;
+			const std::array words{random.Next(), random.Next()};
+			std::memcpy(bytes.data(), words.data(), bytes.size());
+			// RFC 4122 version 4, variant 1
+			bytes[6] = static_cast<unsigned char>((bytes[6] & 0x0F) | 0x40);
+			bytes[8] = static_cast<unsigned char>((bytes[8] & 0x3F) | 0x80);
+			return EFGUID{bytes};
+		}
+
+		GuidRandom& ThreadRandom(){
+			thread_local GuidRandom random;
+			return random;
+		}
+	}
+
+	void EFGUID::ToChars(const std::span<char, StringLength> out) const{
+		std::array<char, 32> digits;
+		EncodeHex(_bytes, digits.data());
+
+		// Fixed size copies of the 8-4-4-4-12 groups compile down to a few moves
+		char* const text = out.data();
+		std::memcpy(text, digits.data(), 8);
+		text[8] = '-';
+		std::memcpy(text + 9, digits.data() + 8, 4);
+		text[13] = '-';
+		std::memcpy(text + 14, digits.data() + 12, 4);
+		text[18] = '-';
+		std::memcpy(text + 19, digits.data() + 16, 4);
+		text[23] = '-';
+		std::memcpy(text + 24, digits.data() + 20, 12);
+	}
+
+	EFString EFGUID::String() const{
+		EFString out(StringLength, '\0');
+		ToChars(std::span<char, StringLength>{out.data(), StringLength});
 		return out;
 	}
 
@@ -70,83 +236,47 @@ namespace EventfulEngine{
 	EFGUID::EFGUID(std::array<unsigned char, 16>&& bytes) : _bytes(std::move(bytes)){
 	}
 
-	// converts a single hex char to a number (0-15)
-	unsigned char HexDigitToChar(const char ch){
-		// 0-9
-		if (ch > 47 && ch < 58){
-			return ch - 48;
-		}
-
-		// a-f
-		if (ch > 96 && ch < 103){
-			return ch - 87;
-		}
-
-		// A-F
-		if (ch > 64 && ch < 71){
-			return ch - 55;
-		}
-
-		return 0;
-	}
-
-	bool IsValidHexChar(const char ch){
-		// 0-9
-		if (ch > 47 && ch < 58){
-			return true;
-		}
-
-		// a-f
-		if (ch > 96 && ch < 103){
-			return true;
-		}
-
-		// A-F
-		if (ch > 64 && ch < 71){
-			return true;
-		}
-
-		return false;
-	}
-
-	// converts the two hexadecimal characters to an unsigned char (a byte)
-	unsigned char HexPairToChar(char a, char b){
-		return HexDigitToChar(a) * 16 + HexDigitToChar(b);
-	}
-
 	// create a guid from string
 	EFGUID::EFGUID(const std::string_view fromString){
-		char charOne = '\0';
-		char charTwo = '\0';
-		bool lookingForFirstChar = true;
-		unsigned nextByte = 0;
+		// Fast path for the canonical form and for plain 32 digits
+		std::array<char, 32> digits;
+		if (fromString.size() == StringLength && fromString[8] == '-' && fromString[13] == '-' &&
+			fromString[18] == '-' && fromString[23] == '-'){
+			const char* const text = fromString.data();
+			std::memcpy(digits.data(), text, 8);
+			std::memcpy(digits.data() + 8, text + 9, 4);
+			std::memcpy(digits.data() + 12, text + 14, 4);
+			std::memcpy(digits.data() + 16, text + 19, 4);
+			std::memcpy(digits.data() + 20, text + 24, 12);
+			if (!DecodeHex(digits.data(), _bytes)){
+				Invalidate();
+			}
+			return;
+		}
+		if (fromString.size() == digits.size()){
+			if (!DecodeHex(fromString.data(), _bytes)){
+				Invalidate();
+			}
+			return;
+		}
 
-		for (const char& ch : fromString){
-			if (ch == '-')
+		// Dashes in any other place are skipped
+		size_t count = 0;
+		for (const char ch : fromString){
+			if (ch == '-'){
 				continue;
-
-			if (nextByte >= 16 || !IsValidHexChar(ch)){
+			}
+			if (count >= digits.size() || HEX_VALUES[static_cast<uint8>(ch)] < 0){
 				// Invalid string so bail
 				Invalidate();
 				return;
 			}
-
-			if (lookingForFirstChar){
-				charOne = ch;
-				lookingForFirstChar = false;
-			}
-			else{
-				charTwo = ch;
-				const auto byte = HexPairToChar(charOne, charTwo);
-				_bytes[nextByte++] = byte;
-				lookingForFirstChar = true;
-			}
+			digits[count++] = ch;
 		}
 
 		// if there were fewer than 16 bytes in the string, then guid is bad
-		if (nextByte < 16){
+		if (count < digits.size() || !DecodeHex(digits.data(), _bytes)){
 			Invalidate();
-			return;
 		}
 	}
 
@@ -165,77 +295,14 @@ namespace EventfulEngine{
 	}
 
 
-#if EF_PLATFORM_LINUX
-	Guid newGuid()
-	{
-		std::array<unsigned char, 16> data;
-		static_assert(std::is_same<unsigned char[16], uuid_t>::value, "Wrong type!");
-		uuid_generate(data.data());
-		return Guid{std::move(data)};
-	}
-#endif
-
-
-#if EF_PLATFORM_APPLE
-	Guid newGuid()
-	{
-		auto newId = CFUUIDCreate(NULL);
-		auto bytes = CFUUIDGetUUIDBytes(newId);
-		CFRelease(newId);
-
-		std::array<unsigned char, 16> byteArray =
-		{{
-			bytes.byte0,
-			bytes.byte1,
-			bytes.byte2,
-			bytes.byte3,
-			bytes.byte4,
-			bytes.byte5,
-			bytes.byte6,
-			bytes.byte7,
-			bytes.byte8,
-			bytes.byte9,
-			bytes.byte10,
-			bytes.byte11,
-			bytes.byte12,
-			bytes.byte13,
-			bytes.byte14,
-			bytes.byte15
-		}};
-		return Guid{std::move(byteArray)};
-	}
-#endif
-
-
-#if EF_PLATFORM_WINDOWS
 	EFGUID NewGuid(){
-		GUID newId;
-		CoCreateGuid(&newId);
-
-		const std::array bytes =
-			{
-				static_cast<unsigned char>((newId.Data1 >> 24) & 0xFF),
-				static_cast<unsigned char>((newId.Data1 >> 16) & 0xFF),
-				static_cast<unsigned char>((newId.Data1 >> 8) & 0xFF),
-				static_cast<unsigned char>((newId.Data1) & 0xff),
-
-				static_cast<unsigned char>((newId.Data2 >> 8) & 0xFF),
-				static_cast<unsigned char>((newId.Data2) & 0xff),
-
-				static_cast<unsigned char>((newId.Data3 >> 8) & 0xFF),
-				static_cast<unsigned char>((newId.Data3) & 0xFF),
-
-				newId.Data4[0],
-				newId.Data4[1],
-				newId.Data4[2],
-				newId.Data4[3],
-				newId.Data4[4],
-				newId.Data4[5],
-				newId.Data4[6],
-				newId.Data4[7]
-			};
+		return MakeRandomGuid(ThreadRandom());
+	}
 
-		return EFGUID{bytes};
+	void NewGuids(const std::span<EFGUID> out){
+		GuidRandom& random = ThreadRandom();
+		for (EFGUID& guid : out){
+			guid = MakeRandomGuid(random);
+		}
 	}
-#endif
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "EFIdleMonitor.h"
+#include "Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+
+namespace EventfulEngine{
+    namespace{
+        struct IdleState{
+            std::atomic<int32> PendingWork{0};
+            std::atomic<int32> ActiveWindows{0};
+            std::atomic<bool> bIsWakeRequested{false};
+
+            Mutex WaitMutex;
+            std::condition_variable WakeCondition;
+
+            // Guarded by PlatformMutex, set by the application module while it owns the OS event queue
+            Mutex PlatformMutex;
+            EFIdleMonitor::PlatformWaitFunction PlatformWait;
+            EFIdleMonitor::PlatformWakeFunction PlatformWake;
+        };
+
+        IdleState& GetIdleState(){
+            static IdleState state;
+            return state;
+        }
+    }
+
+    bool EFIdleMonitor::ShouldIdle(){
+        const IdleState& state = GetIdleState();
+        return state.PendingWork.load(std::memory_order_relaxed) <= 0 &&
+            state.ActiveWindows.load(std::memory_order_relaxed) <= 0;
+    }
+
+    void EFIdleMonitor::WaitForActivity(const EFDuration timeout){
+        IdleState& state = GetIdleState();
+        if (state.bIsWakeRequested.exchange(false, std::memory_order_acq_rel)){
+            return;
+        }
+
+        PlatformWaitFunction platformWait;
+        {
+            ScopeLock lock(state.PlatformMutex);
+            platformWait = state.PlatformWait;
+        }
+        if (platformWait){
+            platformWait(timeout);
+            state.bIsWakeRequested.store(false, std::memory_order_release);
+            return;
+        }
+
+        UniqueLock lock(state.WaitMutex);
+        state.WakeCondition.wait_for(lock, timeout, [&state]{
+            return state.bIsWakeRequested.load(std::memory_order_acquire);
+        });
+        state.bIsWakeRequested.store(false, std::memory_order_release);
+    }
+
+    void EFIdleMonitor::RequestWake(){
+        IdleState& state = GetIdleState();
+        {
+            // Taking the wait mutex orders the flag against a waiter that just checked it
+            ScopeLock lock(state.WaitMutex);
+            state.bIsWakeRequested.store(true, std::memory_order_release);
+        }
+        state.WakeCondition.notify_one();
+
+        ScopeLock lock(state.PlatformMutex);
+        if (state.PlatformWake){
+            state.PlatformWake();
+        }
+    }
+
+    void EFIdleMonitor::AddPendingWork(){
+        GetIdleState().PendingWork.fetch_add(1, std::memory_order_relaxed);
+        RequestWake();
+    }
+
+    void EFIdleMonitor::RemovePendingWork(){
+        GetIdleState().PendingWork.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void EFIdleMonitor::AddActiveWindow(){
+        GetIdleState().ActiveWindows.fetch_add(1, std::memory_order_relaxed);
+        RequestWake();
+    }
+
+    void EFIdleMonitor::RemoveActiveWindow(){
+        GetIdleState().ActiveWindows.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void EFIdleMonitor::SetPlatformEvents(PlatformWaitFunction wait, PlatformWakeFunction wake){
+        IdleState& state = GetIdleState();
+        ScopeLock lock(state.PlatformMutex);
+        state.PlatformWait = std::move(wait);
+        state.PlatformWake = std::move(wake);
+    }
+} // EventfulEngine
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "EFPerfCapture.h"
+#include "EFText.h"
+#include "EfMemory.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <nlohmann/json.hpp>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr std::string_view FRAME_COUNT_ROW = "FrameCount";
+
+        /** Nearest rank percentile of the values, sorts them. */
+        double Percentile(std::vector<double>& values, const double percentile){
+            if (values.empty()){
+                return 0.0;
+            }
+            std::ranges::sort(values);
+            const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(values.size())));
+            return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+        }
+
+        double Mean(const std::vector<double>& values){
+            if (values.empty()){
+                return 0.0;
+            }
+            double sum = 0.0;
+            for (const double value : values){
+                sum += value;
+            }
+            return sum / static_cast<double>(values.size());
+        }
+
+        /** Per frame values of a zone or counter, frames without it count as 0. */
+        struct Series{
+            std::vector<double> Values;
+            double Calls{0.0};
+        };
+
+        Series& GetSeries(std::map<EFString, Series, std::less<>>& series, const std::string_view name,
+                          const size_t frameCount){
+            auto it = series.find(name);
+            if (it == series.end()){
+                it = series.emplace(EFString{name}, Series{std::vector<double>(frameCount, 0.0)}).first;
+            }
+            return it->second;
+        }
+
+        // Zone names may contain anything, quote them when they would break the row
+        void WriteCsvField(std::ofstream& out, const std::string_view field){
+            if (field.find_first_of(",\"\n") == std::string_view::npos){
+                out << field;
+                return;
+            }
+            out << '"';
+            for (const char character : field){
+                if (character == '"'){
+                    out << '"';
+                }
+                out << character;
+            }
+            out << '"';
+        }
+
+        std::optional<EFPerfReport> LoadCsv(std::ifstream& in){
+            EFPerfReport report;
+            EFString line;
+            if (!std::getline(in, line)){
+                return std::nullopt;
+            }
+            while (std::getline(in, line)){
+                if (line.empty()){
+                    continue;
+                }
+                EFString name;
+                size_t valueStart;
+                if (line.front() == '"'){
+                    size_t index = 1;
+                    for (; index < line.size(); ++index){
+                        if (line[index] == '"'){
+                            if (index + 1 < line.size() && line[index + 1] == '"'){
+                                name += '"';
+                                ++index;
+                                continue;
+                            }
+                            break;
+                        }
+                        name += line[index];
+                    }
+                    valueStart = index + 2;
+                }
+                else{
+                    const size_t comma = line.find(',');
+                    if (comma == EFString::npos){
+                        return std::nullopt;
+                    }
+                    name = line.substr(0, comma);
+                    valueStart = comma + 1;
+                }
+                if (valueStart > line.size()){
+                    return std::nullopt;
+                }
+
+                double value = 0.0;
+                const char* end = line.data() + line.size();
+                if (std::from_chars(line.data() + valueStart, end, value).ec != std::errc{}){
+                    return std::nullopt;
+                }
+                if (name == FRAME_COUNT_ROW){
+                    report.FrameCount = static_cast<uint32>(value);
+                }
+                else{
+                    report.Metrics.push_back({std::move(name), value});
+                }
+            }
+            return report;
+        }
+    }
+
+    const EFPerfReport::Metric* EFPerfReport::FindMetric(const std::string_view name) const{
+        const auto metric = std::ranges::find(Metrics, name, &Metric::Name);
+        return metric != Metrics.end() ? &*metric : nullptr;
+    }
+
+    bool EFPerfReport::Save(const std::filesystem::path& path) const{
+        std::ofstream out(path);
+        if (!out.is_open()){
+            return false;
+        }
+
+        if (path.extension() == ".json"){
+            nlohmann::ordered_json metrics = nlohmann::ordered_json::object();
+            for (const Metric& metric : Metrics){
+                metrics[metric.Name] = metric.Value;
+            }
+            out << nlohmann::ordered_json{
+                {"FrameCount", FrameCount}, {"Metrics", std::move(metrics)}, {"FrameTimeMs", FrameMilliseconds}
+            }.dump(2);
+        }
+        else{
+            out << "Metric,Value\n" << FRAME_COUNT_ROW << ',' << FrameCount << '\n';
+            for (const Metric& metric : Metrics){
+                WriteCsvField(out, metric.Name);
+                out << ',' << EFText::Format("{}", metric.Value) << '\n';
+            }
+        }
+        return out.good();
+    }
+
+    std::optional<EFPerfReport> EFPerfReport::Load(const std::filesystem::path& path){
+        std::ifstream in(path);
+        if (!in.is_open()){
+            return std::nullopt;
+        }
+        if (path.extension() != ".json"){
+            return LoadCsv(in);
+        }
+
+        const nlohmann::ordered_json json = nlohmann::ordered_json::parse(in, nullptr, false);
+        if (json.is_discarded() || !json.contains("Metrics") || !json["Metrics"].is_object()){
+            return std::nullopt;
+        }
+        EFPerfReport report;
+        report.FrameCount = json.value("FrameCount", 0u);
+        for (const auto& [name, value] : json["Metrics"].items()){
+            if (!value.is_number()){
+                return std::nullopt;
+            }
+            report.Metrics.push_back({name, value.get<double>()});
+        }
+        if (const auto frames = json.find("FrameTimeMs"); frames != json.end() && frames->is_array()){
+            report.FrameMilliseconds = frames->get<std::vector<double>>();
+        }
+        return report;
+    }
+
+    std::vector<EFPerfMetricDifference> ComparePerfReports(const EFPerfReport& baseline, const EFPerfReport& current,
+                                                           const double thresholdPercent,
+                                                           const double zeroBaselineThreshold){
+        std::vector<EFPerfMetricDifference> differences;
+        for (const EFPerfReport::Metric& metric : baseline.Metrics){
+            EFPerfMetricDifference& difference = differences.emplace_back();
+            difference.Name = metric.Name;
+            difference.Baseline = metric.Value;
+            if (const EFPerfReport::Metric* currentMetric = current.FindMetric(metric.Name)){
+                difference.Current = currentMetric->Value;
+                if (metric.Value != 0.0){
+                    difference.ChangePercent = (currentMetric->Value - metric.Value) / std::abs(metric.Value) * 100.0;
+                    difference.bIsRegression = difference.ChangePercent > thresholdPercent;
+                }
+                else{
+                    difference.bIsRegression = currentMetric->Value > zeroBaselineThreshold;
+                }
+            }
+        }
+        for (const EFPerfReport::Metric& metric : current.Metrics){
+            if (!baseline.FindMetric(metric.Name)){
+                differences.push_back({metric.Name, std::nullopt, metric.Value});
+            }
+        }
+        return differences;
+    }
+
+    EFPerfCapture::EFPerfCapture(const EFPerfCaptureSettings& settings) : _settings(settings),
+                                                                          _warmupFramesLeft(settings.WarmupFrames){
+        _frames.reserve(_settings.FrameCount);
+        const EFAllocationStats& allocationStats = EFMemory::GetAllocationStats();
+        _lastAllocationCount = allocationStats.AllocationCount;
+        _lastAllocatedBytes = allocationStats.TotalAllocated;
+    }
+
+    bool EFPerfCapture::AddFrame(){
+        if (IsComplete()){
+            return true;
+        }
+
+        const EFAllocationStats& allocationStats = EFMemory::GetAllocationStats();
+        const size_t allocations = allocationStats.AllocationCount - _lastAllocationCount;
+        const size_t allocatedBytes = allocationStats.TotalAllocated - _lastAllocatedBytes;
+
+        if (_warmupFramesLeft > 0){
+            --_warmupFramesLeft;
+        }
+        else{
+            _frames.push_back({EFProfiler::GetLastFrameStats(), allocations, allocatedBytes});
+
+            // GPU timings of the previous frames may have resolved since they were added
+            constexpr size_t GPU_RESOLVE_FRAMES = 8;
+            const size_t firstPending = _frames.size() > GPU_RESOLVE_FRAMES ? _frames.size() - GPU_RESOLVE_FRAMES : 0;
+            for (size_t frame = firstPending; frame < _frames.size(); ++frame){
+                EFProfilerFrameStats& stats = _frames[frame].Stats;
+                if (stats.bHasGpuTimings){
+                    continue;
+                }
+                if (const std::optional<EFProfilerFrameStats> resolved = EFProfiler::GetFrameStats(stats.FrameIndex)){
+                    stats.GpuSeconds = resolved->GpuSeconds;
+                    stats.GpuZones = resolved->GpuZones;
+                    stats.bHasGpuTimings = resolved->bHasGpuTimings;
+                }
+            }
+        }
+
+        _lastAllocationCount = EFMemory::GetAllocationStats().AllocationCount;
+        _lastAllocatedBytes = EFMemory::GetAllocationStats().TotalAllocated;
+        return IsComplete();
+    }
+
+    EFPerfReport EFPerfCapture::BuildReport() const{
+        EFPerfReport report;
+        report.FrameCount = static_cast<uint32>(_frames.size());
+        const size_t frameCount = _frames.size();
+
+        std::vector<double> frameMs;
+        std::vector<double> gpuMs;
+        std::vector<double> allocations;
+        std::vector<double> allocatedKb;
+        std::map<EFString, Series, std::less<>> cpuZones;
+        std::map<EFString, Series, std::less<>> gpuZones;
+        std::map<EFString, Series, std::less<>> counters;
+        uint64 droppedEvents = 0;
+        for (size_t frame = 0; frame < frameCount; ++frame){
+            const FrameSample& sample = _frames[frame];
+            frameMs.push_back(sample.Stats.FrameSeconds * 1000.0);
+            if (sample.Stats.bHasGpuTimings){
+                gpuMs.push_back(sample.Stats.GpuSeconds * 1000.0);
+            }
+            allocations.push_back(static_cast<double>(sample.Allocations));
+            allocatedKb.push_back(static_cast<double>(sample.AllocatedBytes) / 1024.0);
+            droppedEvents += sample.Stats.DroppedEvents;
+
+            for (const EFProfilerZoneStats& zone : sample.Stats.CpuZones){
+                Series& series = GetSeries(cpuZones, zone.Name, frameCount);
+                series.Values[frame] = zone.TotalSeconds * 1000.0;
+                series.Calls += zone.Count;
+            }
+            for (const EFProfilerZoneStats& zone : sample.Stats.GpuZones){
+                Series& series = GetSeries(gpuZones, zone.Name, frameCount);
+                series.Values[frame] = zone.TotalSeconds * 1000.0;
+                series.Calls += zone.Count;
+            }
+            for (const EFProfilerCounter& counter : sample.Stats.Counters){
+                GetSeries(counters, counter.Name, frameCount).Values[frame] = static_cast<double>(counter.Value);
+            }
+        }
+        report.FrameMilliseconds = frameMs;
+
+        const auto add = [&report](EFString name, const double value){
+            report.Metrics.push_back({std::move(name), value});
+        };
+        add("FrameTimeMs.Mean", Mean(frameMs));
+        add("FrameTimeMs.P50", Percentile(frameMs, 50.0));
+        add("FrameTimeMs.P90", Percentile(frameMs, 90.0));
+        add("FrameTimeMs.P95", Percentile(frameMs, 95.0));
+        add("FrameTimeMs.P99", Percentile(frameMs, 99.0));
+        add("FrameTimeMs.Max", frameMs.empty() ? 0.0 : std::ranges::max(frameMs));
+        if (!gpuMs.empty()){
+            add("GpuTimeMs.Mean", Mean(gpuMs));
+            add("GpuTimeMs.P95", Percentile(gpuMs, 95.0));
+        }
+        add("AllocationsPerFrame.Mean", Mean(allocations));
+        add("AllocationsPerFrame.P95", Percentile(allocations, 95.0));
+        add("AllocatedKBPerFrame.Mean", Mean(allocatedKb));
+        add("DroppedProfilerEvents", static_cast<double>(droppedEvents));
+
+        for (auto& [name, series] : counters){
+            add(EFText::Format("Counter.{}.Mean", name), Mean(series.Values));
+            add(EFText::Format("Counter.{}.Max", name), std::ranges::max(series.Values));
+        }
+
+        // Most expensive zones first
+        const auto addZones = [&add, frameCount](const std::string_view prefix,
+                                                 std::map<EFString, Series, std::less<>>& zones){
+            std::vector<std::pair<double, const EFString*>> order;
+            for (const auto& [name, series] : zones){
+                order.emplace_back(Mean(series.Values), &name);
+            }
+            std::ranges::sort(order, std::ranges::greater{}, [](const auto& entry){ return entry.first; });
+            for (const auto& [meanMs, name] : order){
+                Series& series = zones.find(*name)->second;
+                add(EFText::Format("{}.{}.MeanMs", prefix, *name), meanMs);
+                add(EFText::Format("{}.{}.P95Ms", prefix, *name), Percentile(series.Values, 95.0));
+                add(EFText::Format("{}.{}.CallsPerFrame", prefix, *name),
+                    series.Calls / static_cast<double>(frameCount));
+            }
+        };
+        addZones("Zone", cpuZones);
+        addZones("GpuZone", gpuZones);
+        return report;
+    }
+} // EventfulEngine
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "EFProfiler.h"
+#include "EFHashMap.h"
+#include "EFName.h"
+#include "Thread.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint32 RING_MASK = EFProfiler::EventsPerThread - 1;
+        static_assert((EFProfiler::EventsPerThread & RING_MASK) == 0, "The ring size has to be a power of two");
+
+        // Track of the GPU zones in the Chrome trace
+        constexpr uint32 GPU_TRACK_ID = 0xFFFF;
+
+        // Collected rings of exited threads kept for new threads, the rest is freed
+        constexpr size_t MAX_FREE_RINGS = 4;
+
+        struct ZoneEvent{
+            const char* Name{""};
+            uint64 StartCycles{0};
+            uint64 EndCycles{0};
+        };
+
+        /**
+         * Zones of one thread. Only the owning thread writes, EndFrame reads behind it. Once the writer laps the
+         * reader the oldest events are overwritten. Every slot carries the index of the event it holds, the writer
+         * clears it while the slot is rewritten, so the reader can tell a lapped or half written slot from a valid
+         * one and counts it as dropped. When the thread exits the ring is abandoned, EndFrame collects what is left
+         * and hands it to the next new thread.
+         */
+        class ThreadEventRing{
+        public:
+            explicit ThreadEventRing(const uint32 threadId) : ThreadId(threadId),
+                                                             _slots(std::make_unique<Slot[]>(
+                                                                 EFProfiler::EventsPerThread)){
+            }
+
+            void Push(const ZoneEvent& event){
+                const uint64 written = _written.load(std::memory_order_relaxed);
+                Slot& slot = _slots[written & RING_MASK];
+                slot.Sequence.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.Name.store(event.Name, std::memory_order_relaxed);
+                slot.StartCycles.store(event.StartCycles, std::memory_order_relaxed);
+                slot.EndCycles.store(event.EndCycles, std::memory_order_relaxed);
+                slot.Sequence.store(written + 1, std::memory_order_release);
+                _written.store(written + 1, std::memory_order_release);
+            }
+
+            [[nodiscard]] uint64 GetWritten() const{ return _written.load(std::memory_order_acquire); }
+
+            [[nodiscard]] uint64 GetOldestValid(const uint64 written) const{
+                return written > EFProfiler::EventsPerThread ? written - EFProfiler::EventsPerThread : 0;
+            }
+
+            /** Copies event index, false if the writer lapped it already or is rewriting its slot. */
+            [[nodiscard]] bool TryRead(const uint64 index, ZoneEvent& outEvent) const{
+                const Slot& slot = _slots[index & RING_MASK];
+                if (slot.Sequence.load(std::memory_order_acquire) != index + 1){
+                    return false;
+                }
+                outEvent.Name = slot.Name.load(std::memory_order_relaxed);
+                outEvent.StartCycles = slot.StartCycles.load(std::memory_order_relaxed);
+                outEvent.EndCycles = slot.EndCycles.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return slot.Sequence.load(std::memory_order_relaxed) == index + 1;
+            }
+
+            /** Only for abandoned rings, under the profiler lock. Stale slots stay behind the new written count. */
+            void Reuse(const uint32 threadId){
+                ThreadId = threadId;
+                Name.clear();
+                Collected = 0;
+                _written.store(0, std::memory_order_relaxed);
+                bIsAbandoned.store(false, std::memory_order_relaxed);
+            }
+
+            std::atomic<bool> bIsAbandoned{false};
+            // Guarded by the profiler lock
+            uint32 ThreadId;
+            EFString Name;
+            uint64 Collected{0};
+
+        private:
+            // Fields are atomics so the reader may copy a slot while it is rewritten, the sequence rejects the copy
+            struct Slot{
+                std::atomic<uint64> Sequence{0};
+                std::atomic<const char*> Name{""};
+                std::atomic<uint64> StartCycles{0};
+                std::atomic<uint64> EndCycles{0};
+            };
+
+            std::unique_ptr<Slot[]> _slots;
+            std::atomic<uint64> _written{0};
+        };
+
+        struct ProfilerState{
+            ProfilerState(){
+                History[0].FrameIndex = 0;
+            }
+
+            Mutex Lock;
+            // Rings outlive their threads until EndFrame collected them, so the trace still shows recent threads
+            std::vector<std::unique_ptr<ThreadEventRing>> Threads;
+            std::vector<std::unique_ptr<ThreadEventRing>> FreeRings;
+
+            // Slot FrameIndex % FrameHistorySize is the frame being recorded, GPU zones may already land in it
+            std::array<EFProfilerFrameStats, EFProfiler::FrameHistorySize> History;
+            uint64 FrameIndex{0};
+            uint64 FrameStartCycles{0};
+
+            std::vector<ZoneEvent> GpuEvents;
+            uint64 GpuEventsWritten{0};
+            uint64 GpuCursorFrame{0};
+            uint64 GpuCursorCycles{0};
+
+            // Scratch buffers of EndFrame, kept to avoid allocating every frame
+            std::vector<ZoneEvent> Collected;
+            std::vector<EFProfilerZoneStats> Zones;
+            EFHashMap<const char*, uint32> ZoneIndices;
+        };
+
+        // Function local static, zones may be recorded during static initialization
+        ProfilerState& GetProfilerState(){
+            static ProfilerState state;
+            return state;
+        }
+
+        thread_local ThreadEventRing* t_ring = nullptr;
+        thread_local bool t_bIsRingReleased = false;
+
+        /** Ring of the calling thread, null once the thread is shutting down. */
+        ThreadEventRing* GetThreadRing(){
+            if (t_ring || t_bIsRingReleased){
+                return t_ring;
+            }
+
+            // The ring stays with the profiler, the holder only marks it abandoned when the thread exits
+            struct ThreadRingHolder{
+                ThreadEventRing* Ring{nullptr};
+
+                ~ThreadRingHolder(){
+                    t_ring = nullptr;
+                    t_bIsRingReleased = true;
+                    if (Ring){
+                        Ring->bIsAbandoned.store(true, std::memory_order_release);
+                    }
+                }
+            };
+
+            thread_local ThreadRingHolder holder;
+            static std::atomic<uint32> nextThreadId{0};
+            ProfilerState& state = GetProfilerState();
+            ScopeLock lock(state.Lock);
+            if (!state.FreeRings.empty()){
+                state.FreeRings.back()->Reuse(nextThreadId.fetch_add(1));
+                state.Threads.push_back(std::move(state.FreeRings.back()));
+                state.FreeRings.pop_back();
+            }
+            else{
+                state.Threads.push_back(std::make_unique<ThreadEventRing>(nextThreadId.fetch_add(1)));
+            }
+            holder.Ring = state.Threads.back().get();
+            t_ring = holder.Ring;
+            return t_ring;
+        }
+
+        void AddToZone(EFProfilerZoneStats& zone, const double seconds){
+            zone.TotalSeconds += seconds;
+            zone.MaxSeconds = std::max(zone.MaxSeconds, seconds);
+            ++zone.Count;
+        }
+
+        // The same name may live at different addresses, e.g. the same literal in two modules
+        void MergeZonesByName(std::vector<EFProfilerZoneStats>& zones){
+            std::ranges::sort(zones, {}, [](const EFProfilerZoneStats& zone){ return std::string_view{zone.Name}; });
+            if (zones.empty()){
+                return;
+            }
+            auto merged = zones.begin();
+            for (auto zone = zones.begin() + 1; zone != zones.end(); ++zone){
+                if (std::string_view{merged->Name} == zone->Name){
+                    merged->TotalSeconds += zone->TotalSeconds;
+                    merged->MaxSeconds = std::max(merged->MaxSeconds, zone->MaxSeconds);
+                    merged->Count += zone->Count;
+                }
+                else{
+                    *++merged = *zone;
+                }
+            }
+            zones.erase(merged + 1, zones.end());
+            std::ranges::sort(zones, std::ranges::greater{}, &EFProfilerZoneStats::TotalSeconds);
+        }
+    }
+
+    void EFProfiler::SetEnabled(const bool bEnabled){
+        bIsEnabled.store(bEnabled, std::memory_order_relaxed);
+    }
+
+    void EFProfiler::SetThreadName(const char* name){
+        ThreadEventRing* const ring = GetThreadRing();
+        if (!ring){
+            return;
+        }
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        ring->Name = name;
+    }
+
+    void EFProfiler::RecordZone(const char* name, const uint64 startCycles, const uint64 endCycles){
+        if (ThreadEventRing* const ring = GetThreadRing()){
+            ring->Push({name, startCycles, endCycles});
+        }
+    }
+
+    void EFProfiler::RecordGpuZone(const uint64 frameIndex, const char* name, const uint64 recordCycles,
+                                   const double gpuSeconds){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+
+        EFProfilerFrameStats& frame = state.History[frameIndex % FrameHistorySize];
+        if (frame.FrameIndex == frameIndex && frameIndex <= state.FrameIndex){
+            frame.GpuSeconds += gpuSeconds;
+            frame.bHasGpuTimings = true;
+            const auto zone = std::ranges::find_if(frame.GpuZones, [name](const EFProfilerZoneStats& gpuZone){
+                return std::string_view{gpuZone.Name} == name;
+            });
+            AddToZone(zone != frame.GpuZones.end() ? *zone : frame.GpuZones.emplace_back(EFProfilerZoneStats{name}), gpuSeconds);
+        }
+
+        // GPU work of a frame runs in order, a zone cannot start before the previous one ended
+        if (state.GpuCursorFrame != frameIndex){
+            state.GpuCursorFrame = frameIndex;
+            state.GpuCursorCycles = 0;
+        }
+        const uint64 startCycles = std::max(recordCycles, state.GpuCursorCycles);
+        const uint64 endCycles = startCycles + EFPlatformTime::SecondsToCycles(gpuSeconds);
+        state.GpuCursorCycles = endCycles;
+
+        if (state.GpuEvents.size() < EventsPerThread){
+            state.GpuEvents.push_back({name, startCycles, endCycles});
+        }
+        else{
+            state.GpuEvents[state.GpuEventsWritten & RING_MASK] = {name, startCycles, endCycles};
+        }
+        ++state.GpuEventsWritten;
+    }
+
+    void EFProfiler::AddCounter(const char* name, const int64 value){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        std::vector<EFProfilerCounter>& counters = state.History[state.FrameIndex % FrameHistorySize].Counters;
+        const auto counter = std::ranges::find_if(counters, [name](const EFProfilerCounter& frameCounter){
+            return std::string_view{frameCounter.Name} == name;
+        });
+        if (counter != counters.end()){
+            counter->Value += value;
+        }
+        else{
+            counters.push_back({name, value});
+        }
+    }
+
+    uint64 EFProfiler::EndFrame(){
+        const uint64 now = EFPlatformTime::Cycles64();
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+
+        EFProfilerFrameStats& frame = state.History[state.FrameIndex % FrameHistorySize];
+        frame.FrameSeconds = state.FrameStartCycles != 0
+                                 ? EFPlatformTime::CyclesToSeconds(now - state.FrameStartCycles)
+                                 : 0.0;
+        frame.DroppedEvents = 0;
+
+        state.Zones.clear();
+        state.ZoneIndices.clear();
+        for (auto& ring : state.Threads){
+            // Read before the events, an abandoned ring gets no more of them
+            const bool bIsAbandoned = ring->bIsAbandoned.load(std::memory_order_acquire);
+            const uint64 written = ring->GetWritten();
+            state.Collected.clear();
+            ZoneEvent event;
+            for (uint64 index = std::max(ring->Collected, ring->GetOldestValid(written)); index < written; ++index){
+                if (ring->TryRead(index, event)){
+                    state.Collected.push_back(event);
+                }
+            }
+
+            // Events since the last collection that could not be read were lapped before or during the copy
+            frame.DroppedEvents += static_cast<uint32>(written - ring->Collected - state.Collected.size());
+            ring->Collected = written;
+
+            for (const ZoneEvent& collected : state.Collected){
+                auto [zoneIndex, bIsNew] = state.ZoneIndices.try_emplace(collected.Name,
+                                                                         static_cast<uint32>(state.Zones.size()));
+                if (bIsNew){
+                    state.Zones.push_back({collected.Name});
+                }
+                AddToZone(state.Zones[zoneIndex->second],
+                          EFPlatformTime::CyclesToSeconds(collected.EndCycles - collected.StartCycles));
+            }
+
+            if (bIsAbandoned){
+                if (state.FreeRings.size() < MAX_FREE_RINGS){
+                    state.FreeRings.push_back(std::move(ring));
+                }
+                ring = nullptr;
+            }
+        }
+        std::erase(state.Threads, nullptr);
+        MergeZonesByName(state.Zones);
+        frame.CpuZones.assign(state.Zones.begin(), state.Zones.end());
+
+        state.FrameStartCycles = now;
+        const uint64 nextFrame = ++state.FrameIndex;
+        EFProfilerFrameStats& next = state.History[nextFrame % FrameHistorySize];
+        next.FrameIndex = nextFrame;
+        next.FrameSeconds = 0.0;
+        next.GpuSeconds = 0.0;
+        next.bHasGpuTimings = false;
+        next.CpuZones.clear();
+        next.GpuZones.clear();
+        next.Counters.clear();
+        next.DroppedEvents = 0;
+        return nextFrame;
+    }
+
+    uint64 EFProfiler::GetFrameIndex(){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        return state.FrameIndex;
+    }
+
+    EFProfilerFrameStats EFProfiler::GetLastFrameStats(){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        if (state.FrameIndex == 0){
+            return {};
+        }
+        return state.History[(state.FrameIndex - 1) % FrameHistorySize];
+    }
+
+    std::optional<EFProfilerFrameStats> EFProfiler::GetFrameStats(const uint64 frameIndex){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        if (frameIndex >= state.FrameIndex || state.FrameIndex - frameIndex >= FrameHistorySize){
+            return std::nullopt;
+        }
+        return state.History[frameIndex % FrameHistorySize];
+    }
+
+    std::vector<EFProfilerFrameStats> EFProfiler::GetFrameHistory(){
+        ProfilerState& state = GetProfilerState();
+        ScopeLock lock(state.Lock);
+        // The slot of the frame being recorded is not part of the history
+        const uint64 count = std::min<uint64>(state.FrameIndex, FrameHistorySize - 1);
+        std::vector<EFProfilerFrameStats> history;
+        history.reserve(count);
+        for (uint64 frame = state.FrameIndex - count; frame < state.FrameIndex; ++frame){
+            history.push_back(state.History[frame % FrameHistorySize]);
+        }
+        return history;
+    }
+
+    bool EFProfiler::WriteChromeTrace(const std::filesystem::path& path){
+        struct TraceEvent{
+            ZoneEvent Zone;
+            uint32 ThreadId{0};
+        };
+        std::vector<TraceEvent> events;
+        nlohmann::json traceEvents = nlohmann::json::array();
+        {
+            ProfilerState& state = GetProfilerState();
+            ScopeLock lock(state.Lock);
+            for (const auto& ring : state.Threads){
+                const uint64 written = ring->GetWritten();
+                TraceEvent event{.ThreadId = ring->ThreadId};
+                for (uint64 index = ring->GetOldestValid(written); index < written; ++index){
+                    if (ring->TryRead(index, event.Zone)){
+                        events.push_back(event);
+                    }
+                }
+                if (!ring->Name.empty()){
+                    traceEvents.push_back({
+                        {"name", "thread_name"}, {"ph", "M"}, {"pid", 0}, {"tid", ring->ThreadId},
+                        {"args", {{"name", ring->Name}}}
+                    });
+                }
+            }
+            for (const ZoneEvent& gpuEvent : state.GpuEvents){
+                events.push_back({gpuEvent, GPU_TRACK_ID});
+            }
+        }
+        traceEvents.push_back({
+            {"name", "thread_name"}, {"ph", "M"}, {"pid", 0}, {"tid", GPU_TRACK_ID}, {"args", {{"name", "GPU"}}}
+        });
+
+        uint64 epoch = UINT64_MAX;
+        for (const TraceEvent& event : events){
+            epoch = std::min(epoch, event.Zone.StartCycles);
+        }
+        for (const TraceEvent& event : events){
+            // Chrome trace timestamps are in microseconds
+            traceEvents.push_back({
+                {"name", event.Zone.Name},
+                {"cat", event.ThreadId == GPU_TRACK_ID ? "GPU" : "CPU"},
+                {"ph", "X"},
+                {"ts", EFPlatformTime::CyclesToSeconds(event.Zone.StartCycles - epoch) * 1e6},
+                {"dur", EFPlatformTime::CyclesToSeconds(event.Zone.EndCycles - event.Zone.StartCycles) * 1e6},
+                {"pid", 0},
+                {"tid", event.ThreadId}
+            });
+        }
+
+        std::ofstream out(path);
+        if (!out.is_open()){
+            return false;
+        }
+        out << nlohmann::json{{"traceEvents", std::move(traceEvents)}, {"displayTimeUnit", "ms"}}.dump();
+        return true;
+    }
+
+    EFProfilerScope::EFProfilerScope(InternNameTag, const std::string_view name) : _name(""){
+        if (EFProfiler::IsEnabled()){
+            _name = EFName(name).GetData();
+            _start = EFPlatformTime::Cycles64();
+        }
+    }
+} // EventfulEngine
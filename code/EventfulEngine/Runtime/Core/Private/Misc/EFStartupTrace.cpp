@@ -0,0 +1,141 @@
+#pragma once
+
+#include "EFStartupTrace.h"
+#include "EFText.h"
+#include "Thread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <ranges>
+#include <nlohmann/json.hpp>
+
+namespace EventfulEngine{
+    namespace{
+        struct StartupTraceData{
+            Mutex Lock;
+            std::vector<EFStartupTrace::Event> Events;
+            EFTimePoint Epoch{EFClock::now()};
+            uint64 FinishNs{0};
+            bool bIsRecording{true};
+        };
+
+        // Function local static, static initializers of other translation units may record before main
+        StartupTraceData& TraceData(){
+            static StartupTraceData data;
+            return data;
+        }
+
+        uint32 CurrentThreadId(){
+            static std::atomic<uint32> nextId{0};
+            thread_local const uint32 threadId = nextId.fetch_add(1);
+            return threadId;
+        }
+
+        double ToMilliseconds(const uint64 ns){
+            return static_cast<double>(ns) / 1'000'000.0;
+        }
+    }
+
+    uint64 EFStartupTrace::Now(){
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            EFClock::now() - TraceData().Epoch).count());
+    }
+
+    void EFStartupTrace::Record(const char* category, EFString name, const uint64 startNs, const uint64 endNs){
+        StartupTraceData& data = TraceData();
+        ScopeLock lock(data.Lock);
+        if (!data.bIsRecording){
+            return;
+        }
+        data.Events.push_back({category, std::move(name), startNs, endNs - startNs, CurrentThreadId()});
+    }
+
+    void EFStartupTrace::Finish(){
+        StartupTraceData& data = TraceData();
+        const uint64 now = Now();
+        ScopeLock lock(data.Lock);
+        if (data.bIsRecording){
+            data.bIsRecording = false;
+            data.FinishNs = now;
+        }
+    }
+
+    bool EFStartupTrace::IsRecording(){
+        StartupTraceData& data = TraceData();
+        ScopeLock lock(data.Lock);
+        return data.bIsRecording;
+    }
+
+    std::vector<EFStartupTrace::Event> EFStartupTrace::GetEvents(){
+        std::vector<Event> events;
+        {
+            StartupTraceData& data = TraceData();
+            ScopeLock lock(data.Lock);
+            events = data.Events;
+        }
+        std::ranges::stable_sort(events, {}, &Event::StartNs);
+        return events;
+    }
+
+    uint64 EFStartupTrace::GetTotalNs(){
+        StartupTraceData& data = TraceData();
+        const uint64 now = Now();
+        ScopeLock lock(data.Lock);
+        return data.bIsRecording ? now : data.FinishNs;
+    }
+
+    bool EFStartupTrace::WriteChromeTrace(const std::filesystem::path& path){
+        nlohmann::json traceEvents = nlohmann::json::array();
+        for (const Event& event : GetEvents()){
+            // Chrome trace timestamps are in microseconds
+            traceEvents.push_back({
+                {"name", event.Name},
+                {"cat", event.Category},
+                {"ph", "X"},
+                {"ts", static_cast<double>(event.StartNs) / 1000.0},
+                {"dur", static_cast<double>(event.DurationNs) / 1000.0},
+                {"pid", 0},
+                {"tid", event.ThreadId}
+            });
+        }
+
+        std::ofstream out(path);
+        if (!out.is_open()){
+            return false;
+        }
+        out << nlohmann::json{{"traceEvents", std::move(traceEvents)}, {"displayTimeUnit", "ms"}}.dump();
+        return true;
+    }
+
+    EFString EFStartupTrace::BuildSummary(const uint32 maxEvents){
+        std::vector<Event> events = GetEvents();
+
+        struct CategoryTotal{
+            uint64 Ns{0};
+            uint32 Count{0};
+        };
+        std::map<EFString, CategoryTotal> categories;
+        for (const Event& event : events){
+            CategoryTotal& total = categories[event.Category];
+            total.Ns += event.DurationNs;
+            ++total.Count;
+        }
+
+        EFString summary = EFText::Format("Startup took {:.3f}ms ({} events)\n", ToMilliseconds(GetTotalNs()),
+                                          events.size());
+        summary += EFText::Format("{:<20} {:>8} {:>12}\n", "Category", "Count", "Total");
+        for (const auto& [category, total] : categories){
+            summary += EFText::Format("{:<20} {:>8} {:>10.3f}ms\n", category, total.Count, ToMilliseconds(total.Ns));
+        }
+
+        std::ranges::sort(events, std::ranges::greater{}, &Event::DurationNs);
+        summary += EFText::Format("{:<20} {:<40} {:>12} {:>12}\n", "Category", "Slowest", "Start", "Duration");
+        for (const Event& event : events | std::views::take(maxEvents)){
+            summary += EFText::Format("{:<20} {:<40} {:>10.3f}ms {:>10.3f}ms\n", event.Category, event.Name,
+                                      ToMilliseconds(event.StartNs), ToMilliseconds(event.DurationNs));
+        }
+        return summary;
+    }
+} // EventfulEngine
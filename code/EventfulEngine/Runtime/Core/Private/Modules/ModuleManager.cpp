@@ -4,9 +4,18 @@
 #include "IModule.h"
 #include "CoreGlobals.h"
 #include "EFText.h"
+#include "EFObject.h"
+#include "FileSystem.h"
+#include "JsonArchive.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <fstream>
+#include <future>
 #include <ranges>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
 
 namespace EventfulEngine{
     using enum E_ModuleLoadPhase;
@@ -20,45 +29,139 @@ namespace EventfulEngine{
             GameSession
         };
 
-    void ModuleManager::RegisterStaticModule(const EFString& name, const E_ModuleLoadPhase phase, IModule* instance){
-        ModuleEntry entry{};
+    static double ToMilliseconds(const EFDuration duration){
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    namespace{
+        // Levels of the recursive modules mutex this thread holds
+        thread_local uint32 t_modulesLockDepth = 0;
+
+        /**
+         * Lock of the modules mutex that counts the levels held by the calling thread. Module code that loads other
+         * modules from its startup runs with the outer levels held, releasing one level does not free the mutex then.
+         */
+        class ModulesLock{
+        public:
+            explicit ModulesLock(RecursiveMutex& mutex) : _lock(mutex){
+                ++t_modulesLockDepth;
+            }
+
+            ~ModulesLock(){
+                if (_lock.owns_lock()){
+                    --t_modulesLockDepth;
+                }
+            }
+
+            ModulesLock(const ModulesLock&) = delete;
+            ModulesLock& operator=(const ModulesLock&) = delete;
+
+            void lock(){
+                _lock.lock();
+                ++t_modulesLockDepth;
+            }
+
+            void unlock(){
+                _lock.unlock();
+                --t_modulesLockDepth;
+            }
+
+            /** Whether unlocking would hand the mutex to other threads, false inside a nested module load. */
+            [[nodiscard]] static bool IsOutermost(){ return t_modulesLockDepth == 1; }
+
+        private:
+            UniqueLock<RecursiveMutex> _lock;
+        };
+    }
+
+    void ModuleManager::RegisterStaticModule(const EFName name, const E_ModuleLoadPhase phase, IModule* instance){
+        ModulesLock lock(_modulesMutex);
+        ModuleEntry& entry = _modules[name];
         entry.Phase = phase;
         entry.bIsDynamic = false;
         entry.Instance = instance;
-        _modules.insert_or_assign(name, std::move(entry));
     }
 
-    void ModuleManager::RegisterDynamicModule(const EFString& name, const E_ModuleLoadPhase phase,
+    void ModuleManager::RegisterDynamicModule(const EFName name, const E_ModuleLoadPhase phase,
                                               const std::string_view& libraryPath){
-        ModuleEntry entry{};
+        ModulesLock lock(_modulesMutex);
+        ModuleEntry& entry = _modules[name];
         entry.Phase = phase;
         entry.bIsDynamic = true;
         entry.Library = libraryPath;
-        _modules.insert_or_assign(name, std::move(entry));
     }
 
-    bool ModuleManager::LoadModule(const EFString& name){
-        const auto efModule = _modules.find(name);
-        if (efModule == _modules.end()){
+    void ModuleManager::RegisterModuleDependencies(const EFName name, const std::vector<EFName>& dependencies){
+        // Kept apart from the entries, descriptors are usually read before the dynamic modules register
+        ModulesLock lock(_modulesMutex);
+        _dependencies[name] = dependencies;
+    }
+
+    bool ModuleManager::RegisterModuleDescriptor(const std::filesystem::path& descriptorPath){
+        std::ifstream file(descriptorPath);
+        if (!file){
+            EF_LOG(CoreLog, err, "Failed to open module descriptor '{}'", descriptorPath.string());
             return false;
         }
 
-        ModuleEntry& entry = efModule->second;
+        const nlohmann::json descriptor = nlohmann::json::parse(file, nullptr, false);
+        if (descriptor.is_discarded() || !descriptor.contains("Module Name")){
+            EF_LOG(CoreLog, err, "Malformed module descriptor '{}'", descriptorPath.string());
+            return false;
+        }
+
+        // Library dependencies (spdlog, glfw, ...) are kept as well, they are simply ignored when sorting
+        // since they never get registered as modules.
+        std::vector<EFName> dependencies;
+        if (const auto deps = descriptor.find("Dependencies"); deps != descriptor.end() && deps->is_array()){
+            for (const auto& dependency : *deps){
+                if (const auto library = dependency.find("Library Name"); library != dependency.end()){
+                    dependencies.emplace_back(library->get<EFString>());
+                }
+            }
+        }
+
+        RegisterModuleDependencies(EFName{descriptor["Module Name"].get<EFString>()}, dependencies);
+        return true;
+    }
+
+    uint32 ModuleManager::RegisterModuleDescriptors(const std::filesystem::path& directory){
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error)){
+            return 0;
+        }
+
+        uint32 count = 0;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(directory, error)){
+            if (file.is_regular_file() && file.path().extension() == ".efmoddef"){
+                count += RegisterModuleDescriptor(file.path()) ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    bool ModuleManager::LoadModuleEntry(const EFName name, ModuleEntry& entry){
         if (entry.bIsLoaded){
             return true;
         }
 
+        EF_STARTUP_TRACE_SCOPE("Module", name.ToString());
+        const EFTimePoint start = EFClock::now();
         if (entry.bIsDynamic){
-            entry.Handle = EFLibraryUtilities::LoadDynamicLibrary(entry.Library);
+            entry.LibraryWriteTime = FileSystem::GetLastWriteTime(entry.Library);
+            entry.LoadedLibrary = _bUseShadowCopies ? MakeShadowCopy(entry) : entry.Library;
+            entry.Handle = EFLibraryUtilities::LoadDynamicLibrary(entry.LoadedLibrary);
             if (!entry.Handle){
-                EF_LOG(CoreLog, err, "Failed to load module '{}'", entry.Library);
+                EF_LOG(CoreLog, err, "Failed to load module '{}'", entry.LoadedLibrary);
                 return false;
             }
 
-            const std::string symbol = "Create" + name;
+            const std::string symbol = "Create" + name.ToString();
             entry.Factory = std::bit_cast<ModuleFactory>(EFLibraryUtilities::GetLibrarySymbol(
                 entry.Handle, symbol.c_str()));
             if (!entry.Factory){
+                // Records logged by the static initializers of the library reference its code and literals
+                EFLogger::Flush();
                 EFLibraryUtilities::UnloadDynamicLibrary(entry.Handle);
                 entry.Handle = nullptr;
                 EF_LOG(CoreLog, err, "Failed to find module factory for '{}'!", entry.Library);
@@ -71,24 +174,152 @@ namespace EventfulEngine{
         if (entry.Instance){
             entry.Instance->StartupModule();
             entry.bIsLoaded = true;
-            EF_LOG(CoreLog, info, EFText::Format("Loaded Module '{}'", entry.Library));
+            entry.LoadTime = EFClock::now() - start;
+            EF_LOG(CoreLog, info, "Loaded Module '{}' in {:.3f}ms", name, ToMilliseconds(entry.LoadTime));
             return true;
         }
 
         return false;
     }
 
+    bool ModuleManager::LoadModule(const EFName name){
+        ModulesLock lock(_modulesMutex);
+        const auto efModule = _modules.find(name);
+        if (efModule == _modules.end() || !IsRegisteredEntry(efModule->second)){
+            return false;
+        }
+
+        ModuleEntry& entry = efModule->second;
+        if (entry.bIsLoaded){
+            return true;
+        }
+
+        // Dependencies go first, so a module is never started before the modules it links against
+        for (const EFName dependency : GetDependencies(name)){
+            if (IsModuleRegisteredLocked(dependency) && !LoadModule(dependency)){
+                EF_LOG(CoreLog, err, "Module '{}' is missing its dependency '{}'", name, dependency);
+                return false;
+            }
+        }
+
+        return LoadModuleEntry(name, entry);
+    }
+
+    std::vector<std::vector<EFName>> ModuleManager::SortIntoWaves(const std::vector<EFName>& names) const{
+        const std::unordered_set<EFName> pending{names.begin(), names.end()};
+        std::unordered_map<EFName, uint32> inDegree;
+        std::unordered_map<EFName, std::vector<EFName>> dependents;
+
+        for (const EFName name : names){
+            inDegree.try_emplace(name, 0);
+            for (const EFName dependency : GetDependencies(name)){
+                // Edges to modules outside of the set are either already loaded or external libraries
+                if (dependency != name && pending.contains(dependency)){
+                    ++inDegree[name];
+                    dependents[dependency].push_back(name);
+                }
+            }
+        }
+
+        std::vector<std::vector<EFName>> waves;
+        std::vector<EFName> current;
+        for (const auto& [name, degree] : inDegree){
+            if (degree == 0){
+                current.push_back(name);
+            }
+        }
+
+        size_t sorted = 0;
+        while (!current.empty()){
+            // Sorted by text, so the load order does not depend on the order names were interned in
+            std::ranges::sort(current, EFName::LexicalLess);
+            sorted += current.size();
+
+            std::vector<EFName> next;
+            for (const EFName name : current){
+                for (const EFName dependent : dependents[name]){
+                    if (--inDegree[dependent] == 0){
+                        next.push_back(dependent);
+                    }
+                }
+            }
+
+            waves.push_back(std::move(current));
+            current = std::move(next);
+        }
+
+        if (sorted != names.size()){
+            // Cyclic dependencies, load the remaining modules one by one in a stable order
+            std::vector<EFName> cyclic;
+            for (const auto& [name, degree] : inDegree){
+                if (degree > 0){
+                    cyclic.push_back(name);
+                }
+            }
+            std::ranges::sort(cyclic, EFName::LexicalLess);
+            EF_LOG(CoreLog, warn, "Cyclic module dependencies detected, loading {} modules serially", cyclic.size());
+            for (const EFName name : cyclic){
+                waves.push_back({name});
+            }
+        }
+
+        return waves;
+    }
+
     bool ModuleManager::LoadModules(const E_ModuleLoadPhase phase){
+        ModulesLock lock(_modulesMutex);
+
+        std::vector<EFName> names;
+        for (const auto& [name, entry] : _modules){
+            if (entry.Phase == phase && !entry.bIsLoaded && IsRegisteredEntry(entry)){
+                names.push_back(name);
+            }
+        }
+
+        if (names.empty()){
+            return true;
+        }
+
+        const EFTimePoint start = EFClock::now();
         bool success = true;
-        for (auto const& [name, entry] : _modules){
-            if (entry.Phase == phase){
-                success &= LoadModule(name);
+        for (const auto& wave : SortIntoWaves(names)){
+            // Workers need the mutex for static registration, a nested load can not release it and loads serially
+            if (wave.size() == 1 || !ModulesLock::IsOutermost()){
+                for (const EFName name : wave){
+                    success &= LoadModuleEntry(name, _modules.at(name));
+                }
+                continue;
             }
+
+            // The map itself is not modified while the wave runs, every task only touches its own entry.
+            // Modules that register statically while being loaded are protected by the recursive mutex.
+            std::vector<std::future<bool>> tasks;
+            tasks.reserve(wave.size());
+            for (const EFName name : wave){
+                ModuleEntry& entry = _modules.at(name);
+                tasks.push_back(Async([this, name, &entry]{ return LoadModuleEntry(name, entry); }));
+            }
+
+            // Release the lock while waiting, otherwise static registration inside the loaded libraries deadlocks
+            lock.unlock();
+            for (auto& task : tasks){
+                success &= task.get();
+            }
+            lock.lock();
+        }
+
+        EFDuration serialTime{};
+        for (const EFName name : names){
+            serialTime += _modules.at(name).LoadTime;
         }
+        EF_LOG(CoreLog, info, "Loaded {} modules of phase {} in {:.3f}ms (serial sum {:.3f}ms)", names.size(),
+               static_cast<int32>(phase), ToMilliseconds(EFClock::now() - start), ToMilliseconds(serialTime));
+
         return success;
     }
 
-    bool ModuleManager::UnloadModule(const std::string& name){
+    bool ModuleManager::UnloadModule(const EFName name){
+        ModulesLock lock(_modulesMutex);
         const auto efModule = _modules.find(name);
         if (efModule == _modules.end())
             return false;
@@ -104,74 +335,221 @@ namespace EventfulEngine{
         }
 
         if (entry.bIsDynamic){
+            // Queued log records point to the decode functions and format strings inside the library, they have to
+            // be written before its image is unmapped
+            EFLogger::Flush();
             EFLibraryUtilities::UnloadDynamicLibrary(entry.Handle);
             entry.Handle = nullptr;
             entry.Instance = nullptr;
             entry.Factory = nullptr;
+
+            if (entry.LoadedLibrary != entry.Library){
+                std::error_code error;
+                std::filesystem::remove(entry.LoadedLibrary, error);
+            }
+            entry.LoadedLibrary.clear();
         }
 
         entry.bIsLoaded = false;
-        EF_LOG(CoreLog, info, EFText::Format("Unloaded module '{}'", entry.Library));
+        EF_LOG(CoreLog, info, "Unloaded module '{}'", entry.Library);
         return true;
     }
 
     bool ModuleManager::UnloadModules(const E_ModuleLoadPhase phase){
-        bool success = true;
+        ModulesLock lock(_modulesMutex);
+        std::vector<EFName> names;
         for (const auto& [name, entry] : _modules){
             if (entry.Phase == phase){
+                names.push_back(name);
+            }
+        }
+
+        // Dependents have to go before the modules they depend on
+        bool success = true;
+        for (const auto& wave : std::ranges::reverse_view(SortIntoWaves(names))){
+            for (const EFName name : wave){
                 success &= UnloadModule(name);
             }
         }
         return success;
     }
 
-    bool ModuleManager::ReloadModule(const EFString& name){
+    std::vector<EFName> ModuleManager::CollectDependents(const EFName name) const{
+        std::vector<EFName> collected{name};
+        std::unordered_set<EFName> visited{name};
+
+        for (size_t index = 0; index < collected.size(); ++index){
+            const EFName current = collected[index];
+            for (const auto& [otherName, entry] : _modules){
+                if (entry.bIsLoaded && !visited.contains(otherName) &&
+                    std::ranges::find(GetDependencies(otherName), current) != GetDependencies(otherName).end()){
+                    visited.insert(otherName);
+                    collected.push_back(otherName);
+                }
+            }
+        }
+        return collected;
+    }
+
+    EFString ModuleManager::MakeShadowCopy(const ModuleEntry& entry){
+        const std::filesystem::path original{entry.Library};
+        const std::filesystem::path shadowDirectory = original.parent_path() / "Shadow";
+        const std::filesystem::path shadow = shadowDirectory / EFText::Format(
+            "{}-{}{}", original.stem().string(), _shadowCopyCounter.fetch_add(1), original.extension().string());
+
+        std::error_code error;
+        std::filesystem::create_directories(shadowDirectory, error);
+        if (!std::filesystem::copy_file(original, shadow, std::filesystem::copy_options::overwrite_existing, error)){
+            EF_LOG(CoreLog, warn, "Failed to shadow copy module '{}': {}", entry.Library, error.message());
+            return entry.Library;
+        }
+        return shadow.string();
+    }
+
+    bool ModuleManager::ReloadModule(const EFName name){
+        ModulesLock lock(_modulesMutex);
         const auto efModule = _modules.find(name);
         if (efModule == _modules.end()){
             return false;
         }
 
-        const E_ModuleLoadPhase phase = efModule->second.Phase;
+        if (efModule->second.Instance && !efModule->second.Instance->SupportsDynamicReloading()){
+            EF_LOG(CoreLog, warn, "Module '{}' does not support dynamic reloading", name);
+            return false;
+        }
+
+        const EFTimePoint start = EFClock::now();
+
+        // Only the module and its dependents are restarted, unrelated modules of later phases stay loaded
+        const std::vector<EFName> affected = CollectDependents(name);
+        const auto waves = SortIntoWaves(affected);
+
+        std::unordered_map<EFName, JsonArchive> reloadStates;
+        for (const auto& wave : std::ranges::reverse_view(waves)){
+            for (const EFName moduleName : wave){
+                const ModuleEntry& entry = _modules.at(moduleName);
+                if (entry.bIsLoaded && entry.Instance){
+                    if (const EFObject* const state = entry.Instance->GetReloadState()){
+                        state->Serialize(reloadStates[moduleName]);
+                    }
+                }
+                UnloadModule(moduleName);
+            }
+        }
+
+        bool success = true;
+        for (const auto& wave : waves){
+            if (wave.size() == 1 || !ModulesLock::IsOutermost()){
+                for (const EFName moduleName : wave){
+                    success &= LoadModuleEntry(moduleName, _modules.at(moduleName));
+                }
+            }
+            else{
+                std::vector<std::future<bool>> tasks;
+                tasks.reserve(wave.size());
+                for (const EFName moduleName : wave){
+                    ModuleEntry& entry = _modules.at(moduleName);
+                    tasks.push_back(Async([this, moduleName, &entry]{ return LoadModuleEntry(moduleName, entry); }));
+                }
 
-        // TODO: This should probably be async at some point
-        for (const auto unloadPhase : std::ranges::reverse_view(PHASE_ORDER)){
-            if (unloadPhase >= phase){
-                UnloadModules(unloadPhase);
+                lock.unlock();
+                for (auto& task : tasks){
+                    success &= task.get();
+                }
+                lock.lock();
+            }
+
+            // Hand the state over before the next wave starts, dependents may read it during their startup
+            for (const EFName moduleName : wave){
+                const ModuleEntry& entry = _modules.at(moduleName);
+                if (!entry.bIsLoaded || !entry.Instance){
+                    continue;
+                }
+                if (const auto state = reloadStates.find(moduleName); state != reloadStates.end()){
+                    if (EFObject* const newState = entry.Instance->GetReloadState()){
+                        newState->Deserialize(state->second);
+                    }
+                }
+                entry.Instance->PostLoadCallback();
             }
         }
 
-        for (const auto loadPhase : PHASE_ORDER){
-            if (loadPhase >= phase){
-                LoadModules(loadPhase);
+        EF_LOG(CoreLog, info, "Reloaded module '{}' and {} dependents in {:.3f}ms", name, affected.size() - 1,
+               ToMilliseconds(EFClock::now() - start));
+        return success;
+    }
+
+    uint32 ModuleManager::ReloadChangedModules(){
+        std::vector<std::pair<EFName, EFString>> libraries;
+        {
+            ModulesLock lock(_modulesMutex);
+            for (const auto& [name, entry] : _modules){
+                if (entry.bIsDynamic && entry.bIsLoaded){
+                    libraries.emplace_back(name, entry.Library);
+                }
             }
         }
+        std::ranges::sort(libraries, EFName::LexicalLess, &std::pair<EFName, EFString>::first);
 
-        return true;
+        // ReloadModule only loads in parallel when this thread holds no other lock level, the libraries register
+        // themselves from the workers
+        uint32 reloaded = 0;
+        for (const auto& [name, library] : libraries){
+            // A dependent that was restarted with an earlier module already picked up its new write time
+            const uint64 writeTime = FileSystem::GetLastWriteTime(library);
+            bool bIsChanged;
+            {
+                ModulesLock lock(_modulesMutex);
+                const auto efModule = _modules.find(name);
+                bIsChanged = efModule != _modules.end() && efModule->second.LibraryWriteTime != writeTime;
+            }
+            if (bIsChanged && ReloadModule(name)){
+                ++reloaded;
+            }
+        }
+        return reloaded;
     }
 
-    IModule* ModuleManager::GetModule(const EFString& name){
+    IModule* ModuleManager::GetModule(const EFName name){
+        ModulesLock lock(_modulesMutex);
         if (const auto efModule = _modules.find(name); efModule != _modules.end()){
             return efModule->second.Instance;
         }
         return nullptr;
     }
 
-    bool ModuleManager::IsModuleRegistered(const EFString& name) const{
-        return _modules.contains(name);
+    bool ModuleManager::IsModuleRegistered(const EFName name) const{
+        ModulesLock lock(_modulesMutex);
+        return IsModuleRegisteredLocked(name);
     }
 
-    void ModuleManager::Shutdown(){
-        for (auto& entry : _modules | std::views::values){
-            if (entry.bIsLoaded && entry.Instance){
-                entry.Instance->PreUnloadCallback();
-                entry.Instance->ShutdownModule();
+    bool ModuleManager::IsModuleRegisteredLocked(const EFName name) const{
+        const auto efModule = _modules.find(name);
+        return efModule != _modules.end() && IsRegisteredEntry(efModule->second);
+    }
 
-                if (entry.bIsDynamic){
-                    EFLibraryUtilities::UnloadDynamicLibrary(entry.Handle);
-                    entry.Handle = nullptr;
-                }
-                entry.bIsLoaded = false;
-            }
+    bool ModuleManager::IsRegisteredEntry(const ModuleEntry& entry){
+        return entry.Instance || !entry.Library.empty();
+    }
+
+    const std::vector<EFName>& ModuleManager::GetDependencies(const EFName name) const{
+        static const std::vector<EFName> NO_DEPENDENCIES;
+        const auto dependencies = _dependencies.find(name);
+        return dependencies != _dependencies.end() ? dependencies->second : NO_DEPENDENCIES;
+    }
+
+    EFDuration ModuleManager::GetModuleLoadTime(const EFName name) const{
+        ModulesLock lock(_modulesMutex);
+        if (const auto efModule = _modules.find(name); efModule != _modules.end()){
+            return efModule->second.LoadTime;
+        }
+        return EFDuration{};
+    }
+
+    void ModuleManager::Shutdown(){
+        ModulesLock lock(_modulesMutex);
+        for (const auto phase : std::ranges::reverse_view(PHASE_ORDER)){
+            UnloadModules(phase);
         }
     }
 } // EventfulEngine
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "EFName.h"
+#include "Thread.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace EventfulEngine{
+    namespace{
+        // Index layout: the low bits select the shard, the rest is the entry index inside the shard (starting at 1,
+        // so that no interned name ever gets index 0, which is None)
+        constexpr uint32 SHARD_BITS = 4;
+        constexpr uint32 SHARD_COUNT = 1u << SHARD_BITS;
+        constexpr uint32 CHUNK_BITS = 10;
+        constexpr uint32 CHUNK_SIZE = 1u << CHUNK_BITS;
+        constexpr uint32 MAX_CHUNKS = 4096;
+        constexpr size_t TEXT_BLOCK_SIZE = 16 * 1024;
+
+        struct NameEntry{
+            const char* Data{""};
+            uint32 Length{0};
+            uint32 Hash{0};
+        };
+
+        uint32 HashText(const std::string_view text){
+            // FNV-1a, folded to 32 bits
+            uint64 hash = 14695981039346656037ull;
+            for (const char character : text){
+                hash = (hash ^ static_cast<uint8>(character)) * 1099511628211ull;
+            }
+            return static_cast<uint32>(hash ^ (hash >> 32));
+        }
+
+        /**
+         * One shard of the name table. Writers take the shard mutex, entries are written into chunks that never
+         * move, so resolving an index to its text needs no lock.
+         */
+        class NameShard{
+        public:
+            NameShard(){
+                _slots.resize(64, 0);
+            }
+
+            ~NameShard(){
+                for (auto& chunk : _chunks){
+                    delete[] chunk.load(std::memory_order_relaxed);
+                }
+            }
+
+            NOMOVEORCOPY(NameShard)
+
+            uint32 FindOrAdd(const std::string_view text, const uint32 hash, const bool bAdd){
+                ScopeLock lock(_mutex);
+                const uint32 mask = static_cast<uint32>(_slots.size()) - 1;
+                for (uint32 slot = hash & mask;; slot = (slot + 1) & mask){
+                    const uint32 local = _slots[slot];
+                    if (local == 0){
+                        if (!bAdd){
+                            return 0;
+                        }
+                        const uint32 added = Add(text, hash);
+                        _slots[slot] = added;
+                        if (_count * 2 > _slots.size()){
+                            Grow();
+                        }
+                        return added;
+                    }
+
+                    const NameEntry& entry = GetEntry(local);
+                    if (entry.Hash == hash && std::string_view{entry.Data, entry.Length} == text){
+                        return local;
+                    }
+                }
+            }
+
+            const NameEntry& GetEntry(const uint32 local) const{
+                const NameEntry* chunk = _chunks[local >> CHUNK_BITS].load(std::memory_order_acquire);
+                return chunk[local & (CHUNK_SIZE - 1)];
+            }
+
+            void AddStats(EFName::Stats& stats){
+                ScopeLock lock(_mutex);
+                stats.NameCount += _count;
+                stats.TextBytes += _textBytes;
+                stats.TableBytes += _slots.size() * sizeof(uint32) +
+                    (_count / CHUNK_SIZE + 1) * CHUNK_SIZE * sizeof(NameEntry);
+            }
+
+        private:
+            uint32 Add(const std::string_view text, const uint32 hash){
+                // Local indices start at 1, index 0 of every shard stays unused
+                const uint32 local = ++_count;
+                const uint32 chunkIndex = local >> CHUNK_BITS;
+                if (chunkIndex >= MAX_CHUNKS){
+                    std::abort();
+                }
+
+                NameEntry* chunk = _chunks[chunkIndex].load(std::memory_order_relaxed);
+                if (!chunk){
+                    chunk = new NameEntry[CHUNK_SIZE];
+                    _chunks[chunkIndex].store(chunk, std::memory_order_release);
+                }
+
+                chunk[local & (CHUNK_SIZE - 1)] = {StoreText(text), static_cast<uint32>(text.size()), hash};
+                return local;
+            }
+
+            const char* StoreText(const std::string_view text){
+                const size_t size = text.size() + 1;
+                _textBytes += size;
+                if (size > TEXT_BLOCK_SIZE / 4){
+                    // Long names get their own block, so they do not waste the rest of the current one
+                    char* data = _textBlocks.emplace_back(std::make_unique<char[]>(size)).get();
+                    std::memcpy(data, text.data(), text.size());
+                    return data;
+                }
+
+                // Long names also land in _textBlocks, only the current block tells if short ones have room
+                if (_currentBlock == nullptr || _blockUsed + size > TEXT_BLOCK_SIZE){
+                    _currentBlock = _textBlocks.emplace_back(std::make_unique<char[]>(TEXT_BLOCK_SIZE)).get();
+                    _blockUsed = 0;
+                }
+                char* data = _currentBlock + _blockUsed;
+                std::memcpy(data, text.data(), text.size());
+                data[text.size()] = '\0';
+                _blockUsed += size;
+                return data;
+            }
+
+            void Grow(){
+                std::vector<uint32> slots(_slots.size() * 2, 0);
+                const uint32 mask = static_cast<uint32>(slots.size()) - 1;
+                for (const uint32 local : _slots){
+                    if (local == 0){
+                        continue;
+                    }
+                    uint32 slot = GetEntry(local).Hash & mask;
+                    while (slots[slot] != 0){
+                        slot = (slot + 1) & mask;
+                    }
+                    slots[slot] = local;
+                }
+                _slots = std::move(slots);
+            }
+
+            Mutex _mutex;
+            std::array<std::atomic<NameEntry*>, MAX_CHUNKS> _chunks{};
+            std::vector<uint32> _slots;
+            std::vector<std::unique_ptr<char[]>> _textBlocks;
+            char* _currentBlock{nullptr};
+            size_t _blockUsed{0};
+            size_t _textBytes{0};
+            uint32 _count{0};
+        };
+
+        // Function local static, names are interned by static initializers of every module
+        std::array<NameShard, SHARD_COUNT>& NameShards(){
+            static std::array<NameShard, SHARD_COUNT> shards;
+            return shards;
+        }
+
+        const NameEntry& ResolveEntry(const uint32 index){
+            static constexpr NameEntry none{};
+            if (index == 0){
+                return none;
+            }
+            return NameShards()[index & (SHARD_COUNT - 1)].GetEntry(index >> SHARD_BITS);
+        }
+
+        uint32 Intern(const std::string_view text, const bool bAdd){
+            if (text.empty()){
+                return 0;
+            }
+            const uint32 hash = HashText(text);
+            // The slot probing uses the low bits of the hash, the shard is picked from the high ones
+            const uint32 shard = hash >> (32 - SHARD_BITS);
+            const uint32 local = NameShards()[shard].FindOrAdd(text, hash, bAdd);
+            return local == 0 ? 0 : local << SHARD_BITS | shard;
+        }
+    }
+
+    EFName::EFName(const std::string_view text) : _index(Intern(text, true)){
+    }
+
+    EFName EFName::Find(const std::string_view text){
+        EFName name;
+        name._index = Intern(text, false);
+        return name;
+    }
+
+    uint32 EFName::GetHash() const{
+        return ResolveEntry(_index).Hash;
+    }
+
+    const char* EFName::GetData() const{
+        return ResolveEntry(_index).Data;
+    }
+
+    std::string_view EFName::ToStringView() const{
+        const NameEntry& entry = ResolveEntry(_index);
+        return {entry.Data, entry.Length};
+    }
+
+    EFName::Stats EFName::GetStats(){
+        Stats stats;
+        for (NameShard& shard : NameShards()){
+            shard.AddStats(stats);
+        }
+        return stats;
+    }
+} // EventfulEngine
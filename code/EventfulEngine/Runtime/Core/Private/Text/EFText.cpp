@@ -3,7 +3,7 @@
 #include "EFText.h"
 
 namespace EventfulEngine{
-    std::unordered_map<EFString, EFString> EFText::_macroTable{};
+    EFHashMap<EFString, EFString> EFText::_macroTable{};
 
     EFString EFText::ColorCode(const EFTextColor color){
         switch (color){
@@ -33,11 +33,11 @@ namespace EventfulEngine{
     }
 
     void EFText::RegisterMacro(const std::string_view name, const std::string_view value){
-        _macroTable[EFString(name)] = EFString(value);
+        _macroTable.insert_or_assign(name, EFString(value));
     }
 
     EFString EFText::GetMacro(const std::string_view name){
-        if (const auto macro = _macroTable.find(EFString(name)); macro != _macroTable.end()){
+        if (const auto macro = _macroTable.find(name); macro != _macroTable.end()){
             return macro->second;
         }
         return {};
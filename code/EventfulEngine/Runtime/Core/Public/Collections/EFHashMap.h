@@ -0,0 +1,84 @@
+#pragma once
+
+#include "EFHashTable.h"
+
+#include <tuple>
+
+namespace EventfulEngine{
+    /**
+     * Swiss table hash map, a faster drop in for std::unordered_map with an open addressing layout. Keys of
+     * EFString maps can be looked up with string_view or literals without allocating. Unlike std::unordered_map,
+     * references and iterators are invalidated when the map grows.
+     */
+    template <typename Key, typename Value, typename Hash = HashTableDetail::DefaultHash<Key>,
+              typename Equal = HashTableDetail::DefaultEqual<Key>,
+              typename Allocator = std::allocator<std::pair<const Key, Value>>>
+    class EFHashMap : public HashTableDetail::EFHashTable<HashTableDetail::MapPolicy<Key, Value>, Hash, Equal,
+                                                          Allocator>{
+        using Base = HashTableDetail::EFHashTable<HashTableDetail::MapPolicy<Key, Value>, Hash, Equal, Allocator>;
+
+    public:
+        using mapped_type = Value;
+        using typename Base::key_type;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        using Base::Base;
+
+        /** Constructs the value from args only if the key is missing. */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args){
+            return this->EmplaceWithKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args){
+            return this->EmplaceWithKey(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        /** Heterogeneous try_emplace, the key is only constructed when it gets inserted. */
+        template <typename LookupKey, typename... Args>
+            requires HashTableDetail::IsTransparent<Hash, Equal> && std::constructible_from<key_type, const LookupKey&>
+        std::pair<iterator, bool> try_emplace(const LookupKey& key, Args&&... args){
+            return this->EmplaceWithKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <typename KeyArg, typename ValueArg>
+        std::pair<iterator, bool> insert_or_assign(KeyArg&& key, ValueArg&& value){
+            auto result = try_emplace(std::forward<KeyArg>(key), std::forward<ValueArg>(value));
+            if (!result.second){
+                result.first->second = std::forward<ValueArg>(value);
+            }
+            return result;
+        }
+
+        Value& operator[](const key_type& key){ return try_emplace(key).first->second; }
+        Value& operator[](key_type&& key){ return try_emplace(std::move(key)).first->second; }
+
+        template <typename LookupKey>
+            requires HashTableDetail::IsTransparent<Hash, Equal> && std::constructible_from<key_type, const LookupKey&>
+        Value& operator[](const LookupKey& key){ return try_emplace(key).first->second; }
+
+        Value& at(const key_type& key){ return AtImpl(*this, key); }
+        const Value& at(const key_type& key) const{ return AtImpl(*this, key); }
+
+        template <typename LookupKey> requires HashTableDetail::IsTransparent<Hash, Equal>
+        Value& at(const LookupKey& key){ return AtImpl(*this, key); }
+
+        template <typename LookupKey> requires HashTableDetail::IsTransparent<Hash, Equal>
+        const Value& at(const LookupKey& key) const{ return AtImpl(*this, key); }
+
+    private:
+        template <typename Self, typename LookupKey>
+        static auto& AtImpl(Self& self, const LookupKey& key){
+            const auto found = self.find(key);
+            if (found == self.end()){
+                throw std::out_of_range("EFHashMap::at: key not found");
+            }
+            return found->second;
+        }
+    };
+} // EventfulEngine
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "EFHashTable.h"
+
+namespace EventfulEngine{
+    /**
+     * Swiss table hash set, a faster drop in for std::unordered_set. Shares the layout and the invalidation rules of
+     * EFHashMap.
+     */
+    template <typename Key, typename Hash = HashTableDetail::DefaultHash<Key>,
+              typename Equal = HashTableDetail::DefaultEqual<Key>, typename Allocator = std::allocator<Key>>
+    class EFHashSet : public HashTableDetail::EFHashTable<HashTableDetail::SetPolicy<Key>, Hash, Equal, Allocator>{
+        using Base = HashTableDetail::EFHashTable<HashTableDetail::SetPolicy<Key>, Hash, Equal, Allocator>;
+
+    public:
+        using Base::Base;
+        using Base::insert;
+
+        /** Heterogeneous insert, the key is only constructed when it is missing. */
+        template <typename LookupKey>
+            requires HashTableDetail::IsTransparent<Hash, Equal> && std::constructible_from<Key, const LookupKey&>
+        std::pair<typename Base::iterator, bool> insert(const LookupKey& key){
+            return this->EmplaceWithKey(key, key);
+        }
+    };
+} // EventfulEngine
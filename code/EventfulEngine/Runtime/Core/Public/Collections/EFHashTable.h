@@ -0,0 +1,622 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "Platform.h"
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#if EF_PLATFORM_SSE2
+#include <emmintrin.h>
+#elif EF_PLATFORM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace EventfulEngine{
+    /** Transparent string hash, lets string keyed containers be searched with string_view or literals. */
+    struct EFStringHash{
+        using is_transparent = void;
+
+        size_t operator()(const std::string_view text) const noexcept{ return std::hash<std::string_view>{}(text); }
+    };
+
+    namespace HashTableDetail{
+        template <typename Key>
+        struct DefaultHashSelector{
+            using Hash = std::hash<Key>;
+            using Equal = std::equal_to<Key>;
+        };
+
+        template <>
+        struct DefaultHashSelector<EFString>{
+            using Hash = EFStringHash;
+            using Equal = std::equal_to<>;
+        };
+
+        template <typename Key>
+        using DefaultHash = typename DefaultHashSelector<Key>::Hash;
+
+        template <typename Key>
+        using DefaultEqual = typename DefaultHashSelector<Key>::Equal;
+
+        template <typename Hash, typename Equal>
+        concept IsTransparent = requires{
+            typename Hash::is_transparent;
+            typename Equal::is_transparent;
+        };
+
+        /**
+         * Control byte of a slot. Full slots store the low 7 bits of their hash, so they are never negative,
+         * empty and deleted slots are distinct negative values.
+         */
+        enum E_Control : int8{
+            Empty = -128,
+            Deleted = -2
+        };
+
+        constexpr size_t GROUP_WIDTH = 16;
+
+        /** Set bits of a group match, Shift is the number of mask bits per slot. */
+        template <uint32 Shift>
+        struct BitMask{
+            uint64 Mask;
+
+            explicit operator bool() const{ return Mask != 0; }
+
+            [[nodiscard]] uint32 LowestIndex() const{ return static_cast<uint32>(std::countr_zero(Mask)) / Shift; }
+
+            void ClearLowest(){ Mask &= Mask - 1; }
+        };
+
+        /** Sixteen control bytes matched at once. */
+        struct Group{
+#if EF_PLATFORM_SSE2
+            using Mask = BitMask<1>;
+
+            explicit Group(const int8* control) :
+                _control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))){
+            }
+
+            [[nodiscard]] Mask Match(const int8 hash) const{
+                return {static_cast<uint64>(_mm_movemask_epi8(_mm_cmpeq_epi8(_control, _mm_set1_epi8(hash))))};
+            }
+
+            [[nodiscard]] Mask MatchEmpty() const{ return Match(Empty); }
+
+            [[nodiscard]] Mask MatchEmptyOrDeleted() const{
+                // Empty and deleted are the only negative values below the unused sentinel -1
+                return {static_cast<uint64>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), _control)))};
+            }
+
+        private:
+            __m128i _control;
+#elif EF_PLATFORM_NEON
+            using Mask = BitMask<4>;
+
+            explicit Group(const int8* control) : _control(vld1q_s8(control)){
+            }
+
+            [[nodiscard]] Mask Match(const int8 hash) const{ return ToMask(vceqq_s8(_control, vdupq_n_s8(hash))); }
+
+            [[nodiscard]] Mask MatchEmpty() const{ return Match(Empty); }
+
+            [[nodiscard]] Mask MatchEmptyOrDeleted() const{ return ToMask(vcltq_s8(_control, vdupq_n_s8(-1))); }
+
+        private:
+            // Narrows the byte mask to four bits per slot, NEON has no movemask. Only the top bit of every nibble is
+            // kept, so ClearLowest() steps over a matching slot once instead of once per set bit.
+            static Mask ToMask(const uint8x16_t matches){
+                const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+                return {vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull};
+            }
+
+            int8x16_t _control;
+#else
+            // Portable path, treats each half of the group as eight bytes packed into one word
+            using Mask = BitMask<1>;
+
+            explicit Group(const int8* control){
+                std::memcpy(_control, control, GROUP_WIDTH);
+            }
+
+            [[nodiscard]] Mask Match(const int8 hash) const{
+                // Zero bytes of control ^ hash, may report false positives above a real match, callers compare keys
+                return Combine([hash](const uint64 word){
+                    const uint64 difference = word ^ (LSBS * static_cast<uint8>(hash));
+                    return (difference - LSBS) & ~difference & MSBS;
+                });
+            }
+
+            [[nodiscard]] Mask MatchEmpty() const{
+                // Empty is the only value with the high bit set and bit 1 cleared
+                return Combine([](const uint64 word){ return word & ~(word << 6) & MSBS; });
+            }
+
+            [[nodiscard]] Mask MatchEmptyOrDeleted() const{
+                // Empty and deleted are the only values with the high bit set and bit 0 cleared
+                return Combine([](const uint64 word){ return word & ~(word << 7) & MSBS; });
+            }
+
+        private:
+            static constexpr uint64 LSBS = 0x0101010101010101ull;
+            static constexpr uint64 MSBS = 0x8080808080808080ull;
+
+            /** Packs the high bit of every byte of both halves into one bit per slot. */
+            template <typename Function>
+            Mask Combine(Function&& match) const{
+                const auto pack = [](const uint64 bits){ return ((bits >> 7) * 0x0102040810204080ull) >> 56; };
+                return {pack(match(_control[0])) | pack(match(_control[1])) << 8};
+            }
+
+            uint64 _control[2];
+#endif
+        };
+
+        /** Finalizer of MurmurHash3, spreads weak hashes (identity hashes of integers, indices) over all bits. */
+        constexpr uint64 MixHash(uint64 hash){
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ull;
+            return hash ^ (hash >> 33);
+        }
+
+        template <typename Key, typename Value>
+        struct MapPolicy{
+            using KeyType = Key;
+            using ValueType = std::pair<const Key, Value>;
+
+            static const Key& GetKey(const ValueType& value){ return value.first; }
+
+            /** Moves a value to new storage. The key is const only towards users, the source dies right after. */
+            static void Transfer(ValueType* destination, ValueType* source){
+                new(destination) ValueType(std::move(const_cast<Key&>(source->first)), std::move(source->second));
+                source->~ValueType();
+            }
+        };
+
+        template <typename Key>
+        struct SetPolicy{
+            using KeyType = Key;
+            using ValueType = Key;
+
+            static const Key& GetKey(const ValueType& value){ return value; }
+
+            static void Transfer(ValueType* destination, ValueType* source){
+                new(destination) ValueType(std::move(*source));
+                source->~ValueType();
+            }
+        };
+
+        /**
+         * Open addressing hash table in the style of Swiss tables. A separate array of control bytes holds 7 bits
+         * of every slot's hash, lookups compare a whole group of 16 control bytes with one SIMD instruction and only
+         * touch slots whose bits match. The first group of control bytes is mirrored after the end, so a group can
+         * be loaded at any position without wrapping. Elements move on rehash, references are not stable.
+         */
+        template <typename Policy, typename Hash, typename Equal, typename Allocator>
+        class EFHashTable{
+        public:
+            using key_type = typename Policy::KeyType;
+            using value_type = typename Policy::ValueType;
+            using size_type = size_t;
+            using hasher = Hash;
+            using key_equal = Equal;
+            using allocator_type = Allocator;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+
+            template <bool bIsConst>
+            class Iterator{
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename Policy::ValueType;
+                using difference_type = std::ptrdiff_t;
+                using reference = std::conditional_t<bIsConst, const value_type&, value_type&>;
+                using pointer = std::conditional_t<bIsConst, const value_type*, value_type*>;
+
+                Iterator() = default;
+
+                // Mutable iterators convert to const ones
+                template <bool bOtherIsConst> requires (bIsConst && !bOtherIsConst)
+                explicit(false) Iterator(const Iterator<bOtherIsConst>& other) :
+                    _control(other._control), _slot(other._slot), _end(other._end){
+                }
+
+                reference operator*() const{ return *_slot; }
+                pointer operator->() const{ return _slot; }
+
+                Iterator& operator++(){
+                    ++_control;
+                    ++_slot;
+                    SkipEmpty();
+                    return *this;
+                }
+
+                Iterator operator++(int){
+                    Iterator copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                friend bool operator==(const Iterator& left, const Iterator& right){ return left._slot == right._slot; }
+
+            private:
+                friend class EFHashTable;
+                template <bool>
+                friend class Iterator;
+
+                Iterator(const int8* control, pointer slot, const int8* end) : _control(control), _slot(slot),
+                                                                             _end(end){
+                    SkipEmpty();
+                }
+
+                void SkipEmpty(){
+                    while (_control != _end && *_control < 0){
+                        ++_control;
+                        ++_slot;
+                    }
+                }
+
+                const int8* _control{nullptr};
+                pointer _slot{nullptr};
+                const int8* _end{nullptr};
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            EFHashTable() = default;
+
+            explicit EFHashTable(const size_type capacity, const Hash& hash = Hash{}, const Equal& equal = Equal{},
+                                 const Allocator& allocator = Allocator{}) :
+                _hash(hash), _equal(equal), _allocator(allocator){
+                reserve(capacity);
+            }
+
+            explicit EFHashTable(const Allocator& allocator) : _allocator(allocator){
+            }
+
+            EFHashTable(const std::initializer_list<value_type> values){
+                reserve(values.size());
+                for (const value_type& value : values){
+                    insert(value);
+                }
+            }
+
+            EFHashTable(const EFHashTable& other) : _hash(other._hash), _equal(other._equal),
+                                                    _allocator(std::allocator_traits<Allocator>::
+                                                        select_on_container_copy_construction(other._allocator)){
+                reserve(other._size);
+                for (const value_type& value : other){
+                    EmplaceUnique(HashOf(Policy::GetKey(value)), value);
+                }
+            }
+
+            EFHashTable(EFHashTable&& other) noexcept : _hash(std::move(other._hash)), _equal(std::move(other._equal)),
+                                                        _allocator(std::move(other._allocator)){
+                StealFrom(other);
+            }
+
+            EFHashTable& operator=(const EFHashTable& other){
+                if (this != &other){
+                    EFHashTable copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            EFHashTable& operator=(EFHashTable&& other) noexcept{
+                if (this != &other){
+                    DestroyAll();
+                    _hash = std::move(other._hash);
+                    _equal = std::move(other._equal);
+                    _allocator = std::move(other._allocator);
+                    StealFrom(other);
+                }
+                return *this;
+            }
+
+            ~EFHashTable(){
+                DestroyAll();
+            }
+
+            void swap(EFHashTable& other) noexcept{
+                std::swap(_hash, other._hash);
+                std::swap(_equal, other._equal);
+                std::swap(_allocator, other._allocator);
+                std::swap(_control, other._control);
+                std::swap(_slots, other._slots);
+                std::swap(_capacity, other._capacity);
+                std::swap(_size, other._size);
+                std::swap(_growthLeft, other._growthLeft);
+            }
+
+            iterator begin(){ return {_control, _slots, _control + _capacity}; }
+            iterator end(){ return {_control + _capacity, _slots + _capacity, _control + _capacity}; }
+            const_iterator begin() const{ return {_control, _slots, _control + _capacity}; }
+            const_iterator end() const{ return {_control + _capacity, _slots + _capacity, _control + _capacity}; }
+            const_iterator cbegin() const{ return begin(); }
+            const_iterator cend() const{ return end(); }
+
+            [[nodiscard]] bool empty() const{ return _size == 0; }
+            [[nodiscard]] size_type size() const{ return _size; }
+            [[nodiscard]] size_type capacity() const{ return _capacity; }
+            [[nodiscard]] allocator_type get_allocator() const{ return _allocator; }
+            [[nodiscard]] hasher hash_function() const{ return _hash; }
+            [[nodiscard]] key_equal key_eq() const{ return _equal; }
+
+            /** Destroys all elements but keeps the memory. */
+            void clear(){
+                if (_capacity == 0){
+                    return;
+                }
+                for (size_type index = 0; index < _capacity; ++index){
+                    if (_control[index] >= 0){
+                        std::destroy_at(_slots + index);
+                    }
+                }
+                std::memset(_control, Empty, _capacity + GROUP_WIDTH);
+                _size = 0;
+                _growthLeft = MaxLoad(_capacity);
+            }
+
+            /** Makes room for count elements without rehashing. */
+            void reserve(const size_type count){
+                if (count > _size + _growthLeft){
+                    size_type capacity = GROUP_WIDTH;
+                    while (MaxLoad(capacity) < count){
+                        capacity *= 2;
+                    }
+                    Rehash(capacity);
+                }
+            }
+
+            [[nodiscard]] iterator find(const key_type& key){ return IteratorAt(FindIndex(key)); }
+            [[nodiscard]] const_iterator find(const key_type& key) const{ return IteratorAt(FindIndex(key)); }
+            [[nodiscard]] bool contains(const key_type& key) const{ return FindIndex(key) != _capacity; }
+            [[nodiscard]] size_type count(const key_type& key) const{ return contains(key) ? 1 : 0; }
+
+            /** Heterogeneous lookup, e.g. string_view against EFString keys, without constructing a key. */
+            template <typename LookupKey> requires IsTransparent<Hash, Equal>
+            [[nodiscard]] iterator find(const LookupKey& key){ return IteratorAt(FindIndex(key)); }
+
+            template <typename LookupKey> requires IsTransparent<Hash, Equal>
+            [[nodiscard]] const_iterator find(const LookupKey& key) const{ return IteratorAt(FindIndex(key)); }
+
+            template <typename LookupKey> requires IsTransparent<Hash, Equal>
+            [[nodiscard]] bool contains(const LookupKey& key) const{ return FindIndex(key) != _capacity; }
+
+            template <typename LookupKey> requires IsTransparent<Hash, Equal>
+            [[nodiscard]] size_type count(const LookupKey& key) const{ return contains(key) ? 1 : 0; }
+
+            std::pair<iterator, bool> insert(const value_type& value){
+                return EmplaceWithKey(Policy::GetKey(value), value);
+            }
+
+            std::pair<iterator, bool> insert(value_type&& value){
+                return EmplaceWithKey(Policy::GetKey(value), std::move(value));
+            }
+
+            template <typename InputIterator>
+            void insert(InputIterator first, const InputIterator last){
+                for (; first != last; ++first){
+                    insert(*first);
+                }
+            }
+
+            /** Constructs the value up front, prefer try_emplace for maps to skip that when the key exists. */
+            template <typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args){
+                value_type value(std::forward<Args>(args)...);
+                return EmplaceWithKey(Policy::GetKey(value), std::move(value));
+            }
+
+            size_type erase(const key_type& key){ return EraseKey(key); }
+
+            template <typename LookupKey> requires IsTransparent<Hash, Equal>
+            size_type erase(const LookupKey& key){ return EraseKey(key); }
+
+            iterator erase(const_iterator position){
+                const size_type index = static_cast<size_type>(position._slot - _slots);
+                EraseAt(index);
+                return IteratorAt(index);
+            }
+
+            iterator erase(const iterator position){ return erase(const_iterator{position}); }
+
+        protected:
+            /** Inserts a value constructed from args if no element with an equal key exists. */
+            template <typename LookupKey, typename... Args>
+            std::pair<iterator, bool> EmplaceWithKey(const LookupKey& key, Args&&... args){
+                const size_t hash = HashOf(key);
+                if (const size_type index = FindIndex(key, hash); index != _capacity){
+                    return {IteratorAt(index), false};
+                }
+                return {IteratorAt(EmplaceUnique(hash, std::forward<Args>(args)...)), true};
+            }
+
+        private:
+            template <typename LookupKey>
+            size_t HashOf(const LookupKey& key) const{
+                return static_cast<size_t>(MixHash(static_cast<uint64>(_hash(key))));
+            }
+
+            static int8 ControlHash(const size_t hash){ return static_cast<int8>(hash & 0x7F); }
+
+            // 7/8 of the slots may be used, the rest keeps probe sequences short
+            static size_type MaxLoad(const size_type capacity){ return capacity - capacity / 8; }
+
+            template <typename LookupKey>
+            size_type FindIndex(const LookupKey& key) const{
+                return FindIndex(key, HashOf(key));
+            }
+
+            /** Index of the slot holding key, capacity if there is none. */
+            template <typename LookupKey>
+            size_type FindIndex(const LookupKey& key, const size_t hash) const{
+                if (_size == 0){
+                    return _capacity;
+                }
+
+                const size_type mask = _capacity - 1;
+                const int8 controlHash = ControlHash(hash);
+                size_type position = (hash >> 7) & mask;
+                // Triangular probing over groups visits every group exactly once for power of two capacities
+                for (size_type probe = GROUP_WIDTH;; probe += GROUP_WIDTH){
+                    const Group group{_control + position};
+                    for (auto match = group.Match(controlHash); match; match.ClearLowest()){
+                        const size_type index = (position + match.LowestIndex()) & mask;
+                        if (_equal(Policy::GetKey(_slots[index]), key)){
+                            return index;
+                        }
+                    }
+                    if (group.MatchEmpty()){
+                        return _capacity;
+                    }
+                    position = (position + probe) & mask;
+                }
+            }
+
+            /** First empty or deleted slot of the probe sequence. */
+            size_type FindInsertIndex(const size_t hash) const{
+                const size_type mask = _capacity - 1;
+                size_type position = (hash >> 7) & mask;
+                for (size_type probe = GROUP_WIDTH;; probe += GROUP_WIDTH){
+                    if (const auto match = Group{_control + position}.MatchEmptyOrDeleted()){
+                        return (position + match.LowestIndex()) & mask;
+                    }
+                    position = (position + probe) & mask;
+                }
+            }
+
+            void SetControl(const size_type index, const int8 control){
+                _control[index] = control;
+                // Keep the mirrored first group in sync
+                if (index < GROUP_WIDTH){
+                    _control[_capacity + index] = control;
+                }
+            }
+
+            /** Inserts a value whose key is known to be missing. */
+            template <typename... Args>
+            size_type EmplaceUnique(const size_t hash, Args&&... args){
+                if (_growthLeft == 0){
+                    // Many tombstones are cleaned up in place, otherwise the table doubles
+                    Rehash(_capacity == 0 ? GROUP_WIDTH : (_size * 2 < MaxLoad(_capacity) ? _capacity : _capacity * 2));
+                }
+
+                const size_type index = FindInsertIndex(hash);
+                std::allocator_traits<SlotAllocator>::construct(_allocator, _slots + index, std::forward<Args>(args)...);
+                if (_control[index] == Empty){
+                    --_growthLeft;
+                }
+                SetControl(index, ControlHash(hash));
+                ++_size;
+                return index;
+            }
+
+            template <typename LookupKey>
+            size_type EraseKey(const LookupKey& key){
+                const size_type index = FindIndex(key);
+                if (index == _capacity){
+                    return 0;
+                }
+                EraseAt(index);
+                return 1;
+            }
+
+            void EraseAt(const size_type index){
+                std::destroy_at(_slots + index);
+                // Tombstones keep probe sequences that run through this slot intact until the next rehash
+                SetControl(index, Deleted);
+                --_size;
+            }
+
+            void Rehash(const size_type capacity){
+                int8* const oldControl = _control;
+                value_type* const oldSlots = _slots;
+                const size_type oldCapacity = _capacity;
+
+                ControlAllocator controlAllocator{_allocator};
+                _control = std::allocator_traits<ControlAllocator>::allocate(controlAllocator, capacity + GROUP_WIDTH);
+                _slots = std::allocator_traits<SlotAllocator>::allocate(_allocator, capacity);
+                _capacity = capacity;
+                _growthLeft = MaxLoad(capacity) - _size;
+                std::memset(_control, Empty, capacity + GROUP_WIDTH);
+
+                for (size_type index = 0; index < oldCapacity; ++index){
+                    if (oldControl[index] >= 0){
+                        const size_t hash = HashOf(Policy::GetKey(oldSlots[index]));
+                        const size_type newIndex = FindInsertIndex(hash);
+                        Policy::Transfer(_slots + newIndex, oldSlots + index);
+                        SetControl(newIndex, ControlHash(hash));
+                    }
+                }
+
+                if (oldCapacity != 0){
+                    std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, oldControl,
+                                                                        oldCapacity + GROUP_WIDTH);
+                    std::allocator_traits<SlotAllocator>::deallocate(_allocator, oldSlots, oldCapacity);
+                }
+            }
+
+            void DestroyAll(){
+                if (_capacity == 0){
+                    return;
+                }
+                clear();
+                ControlAllocator controlAllocator{_allocator};
+                std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, _control, _capacity + GROUP_WIDTH);
+                std::allocator_traits<SlotAllocator>::deallocate(_allocator, _slots, _capacity);
+                _control = EmptyGroup();
+                _slots = nullptr;
+                _capacity = 0;
+                _size = 0;
+                _growthLeft = 0;
+            }
+
+            void StealFrom(EFHashTable& other){
+                _control = std::exchange(other._control, EmptyGroup());
+                _slots = std::exchange(other._slots, nullptr);
+                _capacity = std::exchange(other._capacity, 0);
+                _size = std::exchange(other._size, 0);
+                _growthLeft = std::exchange(other._growthLeft, 0);
+            }
+
+            iterator IteratorAt(const size_type index){
+                return {_control + index, _slots + index, _control + _capacity};
+            }
+
+            const_iterator IteratorAt(const size_type index) const{
+                return {_control + index, _slots + index, _control + _capacity};
+            }
+
+            /** Shared control bytes of tables without storage, so begin() needs no special case. */
+            static int8* EmptyGroup(){
+                alignas(16) static int8 emptyGroup[GROUP_WIDTH] = {
+                    Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+                    Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty
+                };
+                return emptyGroup;
+            }
+
+            using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+            using ControlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<int8>;
+
+            Hash _hash{};
+            Equal _equal{};
+            SlotAllocator _allocator{};
+            int8* _control{EmptyGroup()};
+            value_type* _slots{nullptr};
+            size_type _capacity{0};
+            size_type _size{0};
+            size_type _growthLeft{0};
+        };
+    }
+} // EventfulEngine
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace EventfulEngine{
+    /**
+     * Types whose objects can be moved to another address with memcpy, leaving the source without running its
+     * destructor. True for trivially copyable types, specialize it for other types known to be safe.
+     */
+    template <typename T>
+    struct EFIsTriviallyRelocatable : std::is_trivially_copyable<T>{
+    };
+
+    template <typename T>
+    inline constexpr bool EFIsTriviallyRelocatableV = EFIsTriviallyRelocatable<T>::value;
+
+    /**
+     * Vector that stores up to InlineCapacity elements inside the object itself and only allocates when it grows
+     * beyond that. Unlike EFStaticArray, elements are constructed in place and destroyed when removed, storage past
+     * size() holds no objects. Iterators and references are invalidated by any operation that grows the vector,
+     * and by moving the vector while its elements are inline.
+     */
+    template <typename T, uint32 InlineCapacity, typename Allocator = std::allocator<T>>
+    class EFSmallVector{
+        static_assert(InlineCapacity > 0, "Use std::vector for vectors without inline storage");
+
+        using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_type inline_capacity = InlineCapacity;
+
+        EFSmallVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+        explicit EFSmallVector(const Allocator& allocator) noexcept : _allocator(allocator){
+        }
+
+        explicit EFSmallVector(const size_type count, const Allocator& allocator = Allocator{}) :
+            _allocator(allocator){
+            resize(count);
+        }
+
+        EFSmallVector(const size_type count, const T& value, const Allocator& allocator = Allocator{}) :
+            _allocator(allocator){
+            resize(count, value);
+        }
+
+        template <std::input_iterator InputIterator>
+        EFSmallVector(InputIterator first, const InputIterator last, const Allocator& allocator = Allocator{}) :
+            _allocator(allocator){
+            append(first, last);
+        }
+
+        EFSmallVector(const std::initializer_list<T> values, const Allocator& allocator = Allocator{}) :
+            _allocator(allocator){
+            append(values.begin(), values.end());
+        }
+
+        EFSmallVector(const EFSmallVector& other) :
+            _allocator(AllocatorTraits::select_on_container_copy_construction(other._allocator)){
+            append(other.begin(), other.end());
+        }
+
+        EFSmallVector(EFSmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+            _allocator(std::move(other._allocator)){
+            TakeFrom(other);
+        }
+
+        EFSmallVector& operator=(const EFSmallVector& other){
+            if (this != &other){
+                clear();
+                append(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        EFSmallVector& operator=(EFSmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>){
+            if (this != &other){
+                clear();
+                FreeHeap();
+                _allocator = std::move(other._allocator);
+                TakeFrom(other);
+            }
+            return *this;
+        }
+
+        EFSmallVector& operator=(const std::initializer_list<T> values){
+            clear();
+            append(values.begin(), values.end());
+            return *this;
+        }
+
+        ~EFSmallVector(){
+            DestroyRange(_data, _data + _size);
+            FreeHeap();
+        }
+
+        iterator begin() noexcept{ return _data; }
+        iterator end() noexcept{ return _data + _size; }
+        const_iterator begin() const noexcept{ return _data; }
+        const_iterator end() const noexcept{ return _data + _size; }
+        const_iterator cbegin() const noexcept{ return begin(); }
+        const_iterator cend() const noexcept{ return end(); }
+        reverse_iterator rbegin() noexcept{ return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept{ return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const noexcept{ return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept{ return const_reverse_iterator(begin()); }
+
+        [[nodiscard]] bool empty() const noexcept{ return _size == 0; }
+        [[nodiscard]] size_type size() const noexcept{ return _size; }
+        [[nodiscard]] size_type capacity() const noexcept{ return _capacity; }
+        [[nodiscard]] allocator_type get_allocator() const noexcept{ return _allocator; }
+
+        /** True while the elements live in the inline storage. */
+        [[nodiscard]] bool is_inline() const noexcept{ return _data == InlineData(); }
+
+        pointer data() noexcept{ return _data; }
+        const_pointer data() const noexcept{ return _data; }
+
+        reference operator[](const size_type index) noexcept{ return _data[index]; }
+        const_reference operator[](const size_type index) const noexcept{ return _data[index]; }
+
+        reference at(const size_type index){
+            if (index >= _size){
+                throw std::out_of_range("EFSmallVector::at: index out of range");
+            }
+            return _data[index];
+        }
+
+        const_reference at(const size_type index) const{
+            if (index >= _size){
+                throw std::out_of_range("EFSmallVector::at: index out of range");
+            }
+            return _data[index];
+        }
+
+        reference front() noexcept{ return _data[0]; }
+        const_reference front() const noexcept{ return _data[0]; }
+        reference back() noexcept{ return _data[_size - 1]; }
+        const_reference back() const noexcept{ return _data[_size - 1]; }
+
+        void reserve(const size_type capacity){
+            if (capacity > _capacity){
+                Reallocate(capacity);
+            }
+        }
+
+        /** Moves the elements back inline if they fit, otherwise into a heap block of exactly size() elements. */
+        void shrink_to_fit(){
+            if (!is_inline() && _size < _capacity){
+                Reallocate(_size);
+            }
+        }
+
+        void clear() noexcept{
+            DestroyRange(_data, _data + _size);
+            _size = 0;
+        }
+
+        void push_back(const T& value){ emplace_back(value); }
+        void push_back(T&& value){ emplace_back(std::move(value)); }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args){
+            if (_size == _capacity){
+                return GrowAndEmplaceBack(std::forward<Args>(args)...);
+            }
+            T* element = _data + _size;
+            AllocatorTraits::construct(_allocator, element, std::forward<Args>(args)...);
+            ++_size;
+            return *element;
+        }
+
+        void pop_back() noexcept{
+            --_size;
+            AllocatorTraits::destroy(_allocator, _data + _size);
+        }
+
+        template <std::input_iterator InputIterator>
+        void append(InputIterator first, const InputIterator last){
+            if constexpr (std::forward_iterator<InputIterator>){
+                Grow(_size + static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first){
+                emplace_back(*first);
+            }
+        }
+
+        // value may be an element of this vector, emplace copies it before growing or shifting the elements
+        iterator insert(const const_iterator position, const T& value){ return emplace(position, value); }
+        iterator insert(const const_iterator position, T&& value){ return emplace(position, std::move(value)); }
+
+        template <typename... Args>
+        iterator emplace(const const_iterator position, Args&&... args){
+            const size_type index = static_cast<size_type>(position - _data);
+            if (index == _size){
+                emplace_back(std::forward<Args>(args)...);
+                return _data + index;
+            }
+
+            // Built up front, args may refer to an element that is about to move
+            T value(std::forward<Args>(args)...);
+            Grow(_size + 1);
+            if constexpr (EFIsTriviallyRelocatableV<T>){
+                std::memmove(static_cast<void*>(_data + index + 1), _data + index, (_size - index) * sizeof(T));
+                AllocatorTraits::construct(_allocator, _data + index, std::move(value));
+            }
+            else{
+                AllocatorTraits::construct(_allocator, _data + _size, std::move(back()));
+                std::move_backward(_data + index, _data + _size - 1, _data + _size);
+                _data[index] = std::move(value);
+            }
+            ++_size;
+            return _data + index;
+        }
+
+        iterator erase(const const_iterator position){ return erase(position, position + 1); }
+
+        iterator erase(const const_iterator first, const const_iterator last){
+            T* const from = _data + (first - _data);
+            T* const to = _data + (last - _data);
+            const size_type count = static_cast<size_type>(to - from);
+            if (count == 0){
+                return from;
+            }
+
+            if constexpr (EFIsTriviallyRelocatableV<T>){
+                DestroyRange(from, to);
+                std::memmove(static_cast<void*>(from), to, static_cast<size_type>(_data + _size - to) * sizeof(T));
+            }
+            else{
+                std::move(to, _data + _size, from);
+                DestroyRange(_data + _size - count, _data + _size);
+            }
+            _size -= static_cast<uint32>(count);
+            return from;
+        }
+
+        /** Grows with value initialized elements, or destroys the ones past count. */
+        void resize(const size_type count){
+            ResizeWith(count, [this](T* element){ AllocatorTraits::construct(_allocator, element); });
+        }
+
+        void resize(const size_type count, const T& value){
+            if (count > _capacity){
+                // value may be an element of this vector, the copy survives the reallocation
+                const T copy(value);
+                ResizeWith(count, [this, &copy](T* element){ AllocatorTraits::construct(_allocator, element, copy); });
+                return;
+            }
+            ResizeWith(count, [this, &value](T* element){ AllocatorTraits::construct(_allocator, element, value); });
+        }
+
+        /** Grows with default initialized elements, trivial types are left uninitialized for the caller to fill. */
+        void resize_for_overwrite(const size_type count){
+            ResizeWith(count, [](T* element){ new(static_cast<void*>(element)) T; });
+        }
+
+        friend bool operator==(const EFSmallVector& left, const EFSmallVector& right){
+            return std::equal(left.begin(), left.end(), right.begin(), right.end());
+        }
+
+    private:
+        T* InlineData() noexcept{ return std::launder(reinterpret_cast<T*>(_inline)); }
+        const T* InlineData() const noexcept{ return std::launder(reinterpret_cast<const T*>(_inline)); }
+
+        template <typename Construct>
+        void ResizeWith(const size_type count, Construct&& construct){
+            if (count < _size){
+                DestroyRange(_data + count, _data + _size);
+            }
+            else{
+                reserve(count);
+                for (T* element = _data + _size; element != _data + count; ++element){
+                    construct(element);
+                }
+            }
+            _size = static_cast<uint32>(count);
+        }
+
+        void DestroyRange(T* first, T* const last) noexcept{
+            if constexpr (!std::is_trivially_destructible_v<T>){
+                for (; first != last; ++first){
+                    AllocatorTraits::destroy(_allocator, first);
+                }
+            }
+        }
+
+        /** Moves count elements to uninitialized storage and ends the lifetime of the sources. */
+        void Relocate(T* destination, T* source, const size_type count){
+            if constexpr (EFIsTriviallyRelocatableV<T>){
+                if (count != 0){
+                    std::memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+                }
+            }
+            else{
+                for (size_type index = 0; index < count; ++index){
+                    AllocatorTraits::construct(_allocator, destination + index, std::move_if_noexcept(source[index]));
+                    AllocatorTraits::destroy(_allocator, source + index);
+                }
+            }
+        }
+
+        size_type NextCapacity(const size_type minimum) const{
+            return std::max<size_type>(minimum, static_cast<size_type>(_capacity) * 2);
+        }
+
+        /** Makes room for minimum elements, growing geometrically so repeated inserts stay amortized constant. */
+        void Grow(const size_type minimum){
+            if (minimum > _capacity){
+                Reallocate(NextCapacity(minimum));
+            }
+        }
+
+        void Reallocate(const size_type capacity){
+            T* const newData = capacity <= InlineCapacity ? InlineData() : AllocatorTraits::allocate(_allocator, capacity);
+            if (newData == _data){
+                return;
+            }
+            Relocate(newData, _data, _size);
+            FreeHeap();
+            _data = newData;
+            _capacity = static_cast<uint32>(std::max<size_type>(capacity, InlineCapacity));
+        }
+
+        template <typename... Args>
+        reference GrowAndEmplaceBack(Args&&... args){
+            // The new element is built before the old ones move, args may refer to one of them
+            const size_type capacity = NextCapacity(_size + 1);
+            T* const newData = AllocatorTraits::allocate(_allocator, capacity);
+            try{
+                AllocatorTraits::construct(_allocator, newData + _size, std::forward<Args>(args)...);
+            }
+            catch (...){
+                AllocatorTraits::deallocate(_allocator, newData, capacity);
+                throw;
+            }
+            Relocate(newData, _data, _size);
+            FreeHeap();
+            _data = newData;
+            _capacity = static_cast<uint32>(capacity);
+            return _data[_size++];
+        }
+
+        void FreeHeap() noexcept{
+            if (!is_inline()){
+                AllocatorTraits::deallocate(_allocator, _data, _capacity);
+                _data = InlineData();
+                _capacity = InlineCapacity;
+            }
+        }
+
+        /** Takes the elements of other, stealing its heap block or relocating its inline elements. */
+        void TakeFrom(EFSmallVector& other){
+            if (other.is_inline()){
+                Relocate(InlineData(), other._data, other._size);
+                _size = std::exchange(other._size, 0);
+                return;
+            }
+            _data = std::exchange(other._data, other.InlineData());
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, InlineCapacity);
+        }
+
+        T* _data{InlineData()};
+        uint32 _size{0};
+        uint32 _capacity{InlineCapacity};
+        Allocator _allocator{};
+        alignas(T) std::byte _inline[InlineCapacity * sizeof(T)];
+    };
+} // EventfulEngine
@@ -119,10 +119,11 @@ namespace EventfulEngine{
             current_size = new_size;
         }
 
-        reference emplace_back() noexcept{
+        template <typename... Args>
+        reference emplace_back(Args&&... args){
             assert(current_size < max_elements);
+            *(data() + current_size) = T(std::forward<Args>(args)...);
             ++current_size;
-            back() = T{};
             return back();
         }
 
@@ -7,7 +7,7 @@
 
 namespace EventfulEngine{
 
-    EFCORE_API EF_DECLARE_LOG_CATEGORY_EXTERN(CoreLog)
+    EFCORE_API EF_DECLARE_LOG_CATEGORY_EXTERN(CoreLog, E_EFLogLevel::trace)
 
     struct GameEditorOverrides{
         /** Check if we are PIE or embedded in a window */
@@ -11,7 +11,7 @@
 using EFString = std::string;
 template <typename T>
 using Ref = std::shared_ptr<T>;
-using EFClock = std::chrono::high_resolution_clock;
+using EFClock = std::chrono::steady_clock;
 using SystemClock = std::chrono::system_clock;
 using EFTimePoint = EFClock::time_point;
 using EFDuration = EFClock::duration;
@@ -3,6 +3,9 @@
 #include "CoreTypes.h"
 #include <any>
 #include "EnumFlag.h"
+#include "EFName.h"
+#include "EFSmallVector.h"
+#include "EFStartupTrace.h"
 #include <typeindex>
 
 // TODO: Test this
@@ -102,7 +105,7 @@ namespace EventfulEngine{
     };
 
     struct EFProperty{
-        EFString Name;
+        EFName Name;
         std::shared_ptr<EFAutoProperty> AutoProperty;
         std::type_index Type{typeid(void)};
         E_PropertyFlags Flags{E_PropertyFlags::None};
@@ -204,19 +207,19 @@ namespace EventfulEngine{
     };
 
     struct EFMethod{
-        EFString Name;
+        EFName Name;
         std::unique_ptr<EFCallable> Callable;
         E_MethodFlags Flags{E_MethodFlags::None};
         EFMetaDataList MetaData;
     };
 
     struct EFClass{
-        EFString Name;
+        EFName Name;
         std::size_t Hash{0};
         std::size_t ParentHash{0};
         std::type_index ClassType{typeid(void)};
         E_ClassFlags Flags{E_ClassFlags::None};
-        std::vector<EFProperty> Properties;
+        EFSmallVector<EFProperty, 8> Properties;
         std::vector<EFMethod> Methods;
         EFMetaDataList MetaData;
     };
@@ -227,17 +230,18 @@ namespace EventfulEngine{
     using _superClass = ParentClassName;\
     static EFClassPtr _efClass;\
     static const EFClass& StaticClass(){ return _efClass; }\
-    inline static EFString _name{#ClassName};\
+    inline static EFName _name{#ClassName};\
     static constexpr auto _efClassFlags = Flags;\
     static inline EFMetaDataList _efClassMetadata = {__VA_ARGS__};\
-    virtual const EFString& GetClassName() const{ return _name; }\
-    virtual bool IsClass(const EFString& name) const{\
+    virtual EFName GetClassName() const{ return _name; }\
+    virtual bool IsClass(const EFName name) const{\
         if (EFReflectionManager::Get().GetClass(name) != nullptr){ return true; }\
         return IsClass(_superClass::_name);\
     }\
     private: \
     struct _Registrar{ \
     _Registrar(){ \
+    EF_STARTUP_TRACE_SCOPE("StaticInit", "Registrar " #ClassName);\
     auto& efClassPtr = std::make_shared<EFClass>()\
     efClassPtr->Name = _name;\
     efClassPtr->Hash =typeid(ClassName).hash_code();\
@@ -255,6 +259,7 @@ friend bool _ReflectedClass_##ClassName();
     bool _ReflectedClass_##ClassName();\
     EFClassPtr ClassName::_efClass = nullptr;\
     bool _ReflectedClass_##ClassName(){\
+    EF_STARTUP_TRACE_SCOPE("StaticInit", "Reflection " #ClassName);\
     using registeringClass = ClassName;\
     const auto clsHash = typeid(registeringClass).hash_code();\
     registeringClass::_efClass = EFReflectionManager::Get().GetClass(clsHash);\
@@ -7,10 +7,15 @@
 #include <cwchar>
 #include <vector>
 #include "EFClass.h"
+#include "EFSmallVector.h"
 #include <algorithm>
 
 namespace EventfulEngine{
     class JsonArchive;
+
+    /** Objects rarely carry more than a few tags, those stay inline in the object. */
+    using EFTagList = EFSmallVector<EFName, 4>;
+
     /*!
      * @brief A base object class for all managed objects in Eventful.
      */
@@ -22,13 +27,13 @@ namespace EventfulEngine{
         static EFClassPtr _efClass;
         static const EFClass& StaticClass(){ return *_efClass.get(); }
 
-        inline static EFString _name{"EFObject"};
+        inline static EFName _name{"EFObject"};
 
         static inline auto _efClassFlags = E_ClassFlags::None;
         static inline auto _efClassMetadata = EFMetaDataList{{"Category", {"Object"}}};
-        virtual const EFString& GetClassName() const{ return _name; }
+        virtual EFName GetClassName() const{ return _name; }
 
-        virtual bool IsClass(const EFString& name) const{
+        virtual bool IsClass(const EFName name) const{
             if (EFReflectionManager::Get().GetClass(name) != nullptr){ return true; }
             return false;
         }
@@ -72,21 +77,21 @@ namespace EventfulEngine{
         }
 
         // Tagging -----------------------------------------------------------
-        void AddTag(const EFString& tag){
+        void AddTag(const EFName tag){
             if (!HasTag(tag)) _tags.push_back(tag);
         }
 
-        [[nodiscard]] bool HasTag(const EFString& tag) const{
+        [[nodiscard]] bool HasTag(const EFName tag) const{
             return std::ranges::find(_tags, tag) != _tags.end();
         }
 
-        void RemoveTag(const EFString& tag){
+        void RemoveTag(const EFName tag){
             if (const auto it = std::ranges::remove(_tags, tag).begin(); it != _tags.end())
                 _tags.erase(
                     it, _tags.end());
         }
 
-        [[nodiscard]] const std::vector<EFString>& GetTags() const{ return _tags; }
+        [[nodiscard]] const EFTagList& GetTags() const{ return _tags; }
 
         // Duplication Hooks -------------------------------------------------
         virtual void PreDuplicate(const EFObject& source){
@@ -110,6 +115,6 @@ namespace EventfulEngine{
         EFString _objectName;
         // TODO: Make actual GUID
         EFGUID _guid{};
-        std::vector<EFString> _tags;
+        EFTagList _tags;
     };
 }
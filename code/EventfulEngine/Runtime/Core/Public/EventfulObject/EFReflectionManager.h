@@ -2,15 +2,16 @@
 #include "EfMemory.h"
 
 #include "EFClass.h"
+#include "EFHashMap.h"
 #include "IManager.h"
-#include <unordered_map>
+#include "EFCoreModuleAPI.h"
 
 namespace EventfulEngine{
     // Global Registry for Eventful Reflection, holds all Reflection data that was registered and provides methods to
     // get info on classes or invoke methods/get members
     using EFClassPtr = std::shared_ptr<EFClass>;
 
-    class EFReflectionManager : public IManager<EFReflectionManager>{
+    class EFCORE_API EFReflectionManager : public IManager<EFReflectionManager>{
     public:
         EFClassPtr RegisterClass(EFClassPtr& cls);
 
@@ -20,11 +21,12 @@ namespace EventfulEngine{
 
         EFClassPtr GetClass(std::size_t hash) const;
 
-        EFClassPtr GetClass(std::string_view name) const;
+        EFClassPtr GetClass(EFName name) const;
 
         EFClassPtr GetClass(std::type_index type) const;
 
     private:
-        std::unordered_map<std::size_t, EFClassPtr> _classes;
+        EFHashMap<std::size_t, EFClassPtr> _classes;
+        EFHashMap<EFName, EFClassPtr> _classesByName;
     };
 }
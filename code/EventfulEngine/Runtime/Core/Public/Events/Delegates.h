@@ -10,6 +10,8 @@
 	https://www.codeproject.com/Articles/1170503/The-Impossibly-Fast-Cplusplus-Delegates-Fixed
 */
 
+#include <functional>
+#include <list>
 #include <ranges>
 
 namespace EventfulEngine{
@@ -172,7 +174,7 @@ namespace EventfulEngine{
 
 		template <class TLambda>
 		void Bind(const TLambda& lambda){
-			Add((TDelegate::TInstancePtr)(&lambda), LambdaStub<TLambda>);
+			Add((TInstancePtr)(&lambda), LambdaStub<TLambda>);
 		}
 
 		/// Member function binding
@@ -201,13 +203,13 @@ namespace EventfulEngine{
 		/// Lambda unbinding
 		template <class TLambda>
 		void Unbind(const TLambda& lambda){
-			Remove((TDelegate::TInstancePtr)(&lambda), LambdaStub<TLambda>);
+			Remove((TInstancePtr)(&lambda), LambdaStub<TLambda>);
 		}
 
 		/// Member function unbinding
 		template <class TClass, TReturn(TClass::*TFunction)(TArgs...)>
 		void Unbind(TClass* object){
-			Remove((TDelegate::TInstancePtr)(object), MemberFunctionStub<TClass, TFunction>);
+			Remove((TInstancePtr)(object), MemberFunctionStub<TClass, TFunction>);
 		}
 
 		/// Const member function unbinding
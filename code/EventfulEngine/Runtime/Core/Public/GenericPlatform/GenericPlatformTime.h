@@ -3,6 +3,21 @@
 #include <CoreTypes.h>
 #include <EFCoreModuleAPI.h>
 
+#include <span>
+#include <string_view>
+
+// Hardware cycle counters, the x86 timestamp counter or the ARM virtual counter
+#if defined(_M_X64) || defined(__x86_64__)
+#define EF_CYCLE_COUNTER_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define EF_CYCLE_COUNTER_ARM64 1
+#endif
+
 namespace EventfulEngine{
     struct GenericPlatformTime{
         // inline static data (C++17+); initialized on first ODR-use
@@ -10,11 +25,72 @@ namespace EventfulEngine{
         inline static EFTimePoint lastTime;
         inline static EFTimePoint gameStartTime;
 
+        /** Outcome of the cycle counter calibration. Measured once and never changed afterwards. */
+        struct CycleCalibration{
+            double SecondsPerCycle{1e-9};
+            bool B_UseCycleCounter{false};
+        };
+
+        /** Buffer sizes of the allocation free formatters, large enough for any value. */
+        static constexpr size_t DurationBufferSize = 32;
+        static constexpr size_t DateTimeStringLength = 19;
+
         // must be called once at startup
         static EFCORE_API void Init();
 
         static EFCORE_API double InitTiming();
 
+        /**
+         * Measures the frequency of the CPU timestamp counter against the monotonic clock. Falls back to the
+         * monotonic clock when the CPU has no invariant counter. Only the first call measures, it takes about
+         * as long as the given window. Call it at startup to choose the window, otherwise the first cycle read
+         * measures with the default one.
+         */
+        static EFCORE_API void CalibrateCycles(EFDuration window = std::chrono::milliseconds(5));
+
+        /**
+         * The calibration every cycle read and conversion uses. The first call from any thread measures it, the
+         * others wait for that and then only read it, so a timestamp never changes units between two reads.
+         */
+        static EFCORE_API const CycleCalibration& GetCycleCalibration();
+
+        /**
+         * Raw timestamp in cycles, a few nanoseconds to read. Only differences are meaningful, convert them with
+         * CyclesToSeconds. Reports nanoseconds of the monotonic clock if the CPU has no usable counter.
+         */
+        static EF_FORCE_INLINE uint64 Cycles64(){
+#if defined(EF_CYCLE_COUNTER_X86)
+            if (Calibration().B_UseCycleCounter){
+                // rdtscp waits for earlier instructions, so the timed code cannot leak past the read
+                uint32 processor;
+                return __rdtscp(&processor);
+            }
+#elif defined(EF_CYCLE_COUNTER_ARM64)
+            if (Calibration().B_UseCycleCounter){
+                uint64 counter;
+                asm volatile("isb; mrs %0, cntvct_el0" : "=r"(counter));
+                return counter;
+            }
+#endif
+            return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static double CyclesToSeconds(const uint64 cycles){
+            return static_cast<double>(cycles) * Calibration().SecondsPerCycle;
+        }
+
+        static EFDuration CyclesToDuration(const uint64 cycles){
+            return std::chrono::duration_cast<EFDuration>(std::chrono::duration<double>(CyclesToSeconds(cycles)));
+        }
+
+        static uint64 SecondsToCycles(const double seconds){
+            return static_cast<uint64>(seconds / Calibration().SecondsPerCycle);
+        }
+
+        /** CPU time the process spent so far, summed over all of its threads. */
+        static EFCORE_API EFDuration GetProcessCpuTime();
+
         // mark a new frame/timestep; returns delta since last call
         // and advances lastTime to 'now'
         static EFCORE_API EFDuration StepTime();
@@ -38,8 +114,19 @@ namespace EventfulEngine{
 
         static double ToDays(const EFDuration d);
 
+        /** Writes "HH:MM:SS.mmm" into buffer without allocating, hours grow past two digits if needed. */
+        static EFCORE_API std::string_view FormatDuration(EFDuration d, std::span<char, DurationBufferSize> buffer);
+
+        /** Writes the duration in the largest fitting unit with two decimals, e.g. "16.67ms" or "850.00us". */
+        static EFCORE_API std::string_view FormatShortDuration(EFDuration d,
+                                                               std::span<char, DurationBufferSize> buffer);
+
         static EFString DurationToString(EFDuration d);
 
+        /** Writes "YYYY-MM-DD HH:MM:SS" in local time into buffer without allocating. */
+        static EFCORE_API std::string_view FormatDateTime(SystemClock::time_point timePoint,
+                                                          std::span<char, DateTimeStringLength> buffer);
+
         // "YYYY-MM-DD HH:MM:SS" from a system-clock time_point
         static EFString DateTimeToString(const SystemClock::time_point timePoint);
 
@@ -48,6 +135,13 @@ namespace EventfulEngine{
 
         // get the current game time as a formatted string
         static EFString NowGameTimeString();
+
+    private:
+        // Every module caches the reference once, the hot path then costs a guard check and a load
+        static EF_FORCE_INLINE const CycleCalibration& Calibration(){
+            static const CycleCalibration& calibration = GetCycleCalibration();
+            return calibration;
+        }
     };
 
     using EFPlatformTime = GenericPlatformTime;
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "CoreMacros.h"
+#include "EFCoreModuleAPI.h"
+
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <new>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Lowest level that is compiled in at all, calls below it compile to nothing. Distribution builds keep errors only.
+#ifndef EF_LOG_COMPILE_MIN_LEVEL
+#ifdef EF_DISTRIBUTED
+#define EF_LOG_COMPILE_MIN_LEVEL err
+#else
+#define EF_LOG_COMPILE_MIN_LEVEL trace
+#endif
+#endif
+
+namespace EventfulEngine{
+    enum class E_EFLogLevel : uint8{
+        trace = 0u,
+        debug,
+        info,
+        warn,
+        err,
+        critical,
+        off
+    };
+
+    /**
+     * A named log category writing into its own file. The level is stored atomically, so it can be changed at
+     * runtime from any thread.
+     */
+    class EFCORE_API EFLogCategory{
+    public:
+        EFLogCategory(const char* name, const char* fileName, E_EFLogLevel level);
+
+        ~EFLogCategory();
+
+        NOMOVEORCOPY(EFLogCategory)
+
+        [[nodiscard]] const char* GetName() const{ return _name; }
+        [[nodiscard]] const char* GetFileName() const{ return _fileName; }
+
+        [[nodiscard]] E_EFLogLevel GetLevel() const{ return _level.load(std::memory_order_relaxed); }
+        void SetLevel(const E_EFLogLevel level){ _level.store(level, std::memory_order_relaxed); }
+
+        [[nodiscard]] bool IsEnabled(const E_EFLogLevel level) const{ return level >= GetLevel(); }
+
+    private:
+        const char* _name;
+        const char* _fileName;
+        std::atomic<E_EFLogLevel> _level;
+    };
+
+    constexpr E_EFLogLevel g_logCompileMinLevel = E_EFLogLevel::EF_LOG_COMPILE_MIN_LEVEL;
+
+    /**
+     * Log category with a compile time minimum level on top of the runtime one. Log calls below the compile time
+     * level (or below EF_LOG_COMPILE_MIN_LEVEL) are discarded by EF_LOG without generating any code.
+     */
+    template <E_EFLogLevel CompileTimeLevel>
+    class TEFLogCategory : public EFLogCategory{
+    public:
+        static constexpr E_EFLogLevel CompileTimeMinLevel = CompileTimeLevel > g_logCompileMinLevel
+                                                                ? CompileTimeLevel
+                                                                : g_logCompileMinLevel;
+
+        using EFLogCategory::EFLogCategory;
+
+        static constexpr bool IsCompiledIn(const E_EFLogLevel level){
+            return level >= CompileTimeMinLevel && level != E_EFLogLevel::off;
+        }
+    };
+
+    namespace LogDetail{
+        using DecodeFunction = void(*)(const std::byte* payload, EFString& out);
+
+        /** Fixed part of every record in a log ring, followed by the encoded format string and arguments. */
+        struct alignas(8) RecordHeader{
+            DecodeFunction Decode{nullptr};
+            const EFLogCategory* Category{nullptr};
+            int64 Timestamp{0};
+            uint32 Size{0};
+            E_EFLogLevel Level{E_EFLogLevel::info};
+        };
+
+        template <typename T>
+        constexpr bool IsLogString = std::is_same_v<T, EFString> || std::is_same_v<T, std::string_view> ||
+            std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+        /**
+         * How an argument is stored in the ring. Trivially copyable values are copied as they are, strings are
+         * copied inline and read back as string_view, everything else is formatted on the calling thread.
+         * Prepare runs once per argument, Size and Encode both work on what it returns.
+         */
+        template <typename T>
+        struct LogArg{
+            using Checked = T;
+            using Decoded = EFString;
+            using Prepared = EFString;
+
+            static Prepared Prepare(const T& value){ return std::format("{}", value); }
+
+            static uint32 Size(const Prepared& text){
+                return static_cast<uint32>(sizeof(uint32) + text.size());
+            }
+
+            static void Encode(std::byte*& out, const Prepared& text){
+                const auto length = static_cast<uint32>(text.size());
+                std::memcpy(out, &length, sizeof(length));
+                std::memcpy(out + sizeof(length), text.data(), length);
+                out += sizeof(length) + length;
+            }
+
+            static Decoded Decode(const std::byte*& in){
+                uint32 length = 0;
+                std::memcpy(&length, in, sizeof(length));
+                EFString text{reinterpret_cast<const char*>(in + sizeof(length)), length};
+                in += sizeof(length) + length;
+                return text;
+            }
+        };
+
+        template <typename T> requires (std::is_trivially_copyable_v<T> && !IsLogString<T> && !std::is_pointer_v<T>)
+        struct LogArg<T>{
+            using Checked = T;
+            using Decoded = T;
+            using Prepared = const T&;
+
+            static constexpr const T& Prepare(const T& value){ return value; }
+
+            static constexpr uint32 Size(const T&){ return sizeof(T); }
+
+            static void Encode(std::byte*& out, const T& value){
+                std::memcpy(out, &value, sizeof(T));
+                out += sizeof(T);
+            }
+
+            static Decoded Decode(const std::byte*& in){
+                T value;
+                std::memcpy(&value, in, sizeof(T));
+                in += sizeof(T);
+                return value;
+            }
+        };
+
+        template <typename T> requires (std::is_pointer_v<T> && !IsLogString<T>)
+        struct LogArg<T>{
+            using Checked = const void*;
+            using Decoded = const void*;
+            using Prepared = const T&;
+
+            static constexpr const T& Prepare(const T& value){ return value; }
+
+            static constexpr uint32 Size(const T&){ return sizeof(const void*); }
+
+            static void Encode(std::byte*& out, const T& value){
+                const void* pointer = value;
+                std::memcpy(out, &pointer, sizeof(pointer));
+                out += sizeof(pointer);
+            }
+
+            static Decoded Decode(const std::byte*& in){
+                const void* pointer = nullptr;
+                std::memcpy(&pointer, in, sizeof(pointer));
+                in += sizeof(pointer);
+                return pointer;
+            }
+        };
+
+        template <typename T> requires IsLogString<T>
+        struct LogArg<T>{
+            using Checked = std::string_view;
+            using Decoded = std::string_view;
+            using Prepared = std::string_view;
+
+            static Prepared Prepare(const T& value){ return std::string_view{value}; }
+
+            static uint32 Size(const Prepared text){
+                return static_cast<uint32>(sizeof(uint32) + text.size());
+            }
+
+            static void Encode(std::byte*& out, const Prepared text){
+                const auto length = static_cast<uint32>(text.size());
+                std::memcpy(out, &length, sizeof(length));
+                std::memcpy(out + sizeof(length), text.data(), length);
+                out += sizeof(length) + length;
+            }
+
+            static Decoded Decode(const std::byte*& in){
+                uint32 length = 0;
+                std::memcpy(&length, in, sizeof(length));
+                const std::string_view text{reinterpret_cast<const char*>(in + sizeof(length)), length};
+                in += sizeof(length) + length;
+                return text;
+            }
+        };
+
+        // Arrays (string literals passed as arguments) decay, everything else is stored by value
+        template <typename T>
+        using LogArgType = std::decay_t<T>;
+
+        /**
+         * Format string of a log call. Only string literals are accepted, they are validated against the argument
+         * types at compile time and only their address is stored in the ring.
+         */
+        template <typename... Args>
+        struct LogFormatString{
+            template <size_t N>
+            consteval LogFormatString(const char (&format)[N]) : Format(format){
+                [[maybe_unused]] const std::format_string<typename LogArg<LogArgType<Args>>::Checked...> checked{format};
+            }
+
+            const char* Format;
+        };
+
+        inline std::string_view DecodeFormat(const std::byte*& in){
+            const char* format = nullptr;
+            std::memcpy(&format, in, sizeof(format));
+            in += sizeof(format);
+            return format;
+        }
+
+        EFCORE_API void FormatFailed(std::string_view format, const char* reason, EFString& out);
+
+        template <typename... Args>
+        void DecodeAndFormat(const std::byte* payload, EFString& out){
+            const std::string_view format = DecodeFormat(payload);
+            // Braced initialization guarantees left to right evaluation, matching the encoding order
+            std::tuple<typename LogArg<Args>::Decoded...> args{LogArg<Args>::Decode(payload)...};
+            try{
+                std::apply([&out, format](auto&... values){
+                    out = std::vformat(format, std::make_format_args(values...));
+                }, args);
+            }
+            catch (const std::format_error& error){
+                FormatFailed(format, error.what(), out);
+            }
+        }
+
+        constexpr uint32 AlignRecord(const uint32 size){
+            return (size + alignof(RecordHeader) - 1) & ~static_cast<uint32>(alignof(RecordHeader) - 1);
+        }
+
+        /** Reserve space for a record in the ring of the calling thread. Blocks while the ring is full. */
+        EFCORE_API std::byte* ReserveRecord(uint32 size);
+
+        /** Publish a record previously reserved with ReserveRecord. */
+        EFCORE_API void CommitRecord(std::byte* record);
+    }
+
+    /**
+     * Asynchronous logger. Call sites only copy the format string pointer and the arguments into a lock free ring
+     * owned by the calling thread, a background thread formats, colors and writes the records in batches.
+     */
+    class EFCORE_API EFLogger{
+    public:
+        template <typename... Args>
+        static void Log(const EFLogCategory& category, const E_EFLogLevel level,
+                        const LogDetail::LogFormatString<std::type_identity_t<Args>...> format, Args&&... args){
+            using namespace LogDetail;
+            // Formatted arguments live until the record is written, they are only formatted once
+            WriteRecord<LogArgType<Args>...>(category, level, format.Format,
+                                             LogArg<LogArgType<Args>>::Prepare(args)...);
+        }
+
+        /**
+         * Block until every record logged before this call has been written. Records point to the format strings
+         * and decode functions of the library that logged them, flush before unloading it.
+         */
+        static void Flush();
+
+        /** Write everything that is pending and stop the background thread. Later records are written synchronously. */
+        static void Shutdown();
+
+        /** Size in bytes of the ring created for each logging thread. Only affects threads that did not log yet. */
+        static void SetRingCapacity(uint32 capacityBytes);
+
+        /** Directory the category files are written to, defaults to "Logs". */
+        static void SetLogDirectory(const EFString& directory);
+
+        /** Enable or disable colored console output. */
+        static void SetConsoleOutput(bool bEnabled);
+
+    private:
+        template <typename... Types>
+        static void WriteRecord(const EFLogCategory& category, const E_EFLogLevel level, const char* format,
+                                const typename LogDetail::LogArg<Types>::Prepared&... values){
+            using namespace LogDetail;
+            const uint32 size = AlignRecord(sizeof(RecordHeader) + sizeof(const char*) +
+                (LogArg<Types>::Size(values) + ... + 0u));
+
+            std::byte* const record = ReserveRecord(size);
+            auto* const header = new(record) RecordHeader{};
+            header->Decode = &DecodeAndFormat<Types...>;
+            header->Category = &category;
+            header->Timestamp = EFClock::now().time_since_epoch().count();
+            header->Size = size;
+            header->Level = level;
+
+            std::byte* payload = record + sizeof(RecordHeader);
+            std::memcpy(payload, &format, sizeof(const char*));
+            payload += sizeof(const char*);
+            (LogArg<Types>::Encode(payload, values), ...);
+            CommitRecord(record);
+        }
+    };
+} // EventfulEngine
+
+// CompileTimeLevel is the lowest level that is compiled in for the category, e.g. E_EFLogLevel::info
+#define EF_DECLARE_LOG_CATEGORY_EXTERN(CategoryName, CompileTimeLevel) \
+    extern ::EventfulEngine::TEFLogCategory<::EventfulEngine::CompileTimeLevel> CategoryName;
+
+// Defines a category declared with EF_DECLARE_LOG_CATEGORY_EXTERN, DefaultLevel is the initial runtime level
+#define EF_DEFINE_LOG_CATEGORY(CategoryName, FileName, DefaultLevel) \
+    decltype(CategoryName) CategoryName{#CategoryName, FileName, ::EventfulEngine::DefaultLevel};
+
+// Category only visible in the current translation unit
+#define EF_DEFINE_LOG_CATEGORY_STATIC(CategoryName, FileName, DefaultLevel, CompileTimeLevel) \
+    static ::EventfulEngine::TEFLogCategory<::EventfulEngine::CompileTimeLevel> CategoryName{ \
+        #CategoryName, FileName, ::EventfulEngine::DefaultLevel};
+
+// Levels below the compile time level of the category are discarded entirely, the arguments are still type checked.
+// Otherwise a single relaxed load of the runtime level happens before any argument is evaluated.
+#define EF_LOG(CategoryName, Level, ...) \
+    do{ \
+        if constexpr (std::remove_cvref_t<decltype(CategoryName)>::IsCompiledIn( \
+            ::EventfulEngine::E_EFLogLevel::Level)){ \
+            if ((CategoryName).IsEnabled(::EventfulEngine::E_EFLogLevel::Level)){ \
+                ::EventfulEngine::EFLogger::Log(CategoryName, ::EventfulEngine::E_EFLogLevel::Level, __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#define EF_TRACE_CAT(CategoryName, ...) EF_LOG(CategoryName, trace, __VA_ARGS__)
+#define EF_DEBUG_CAT(CategoryName, ...) EF_LOG(CategoryName, debug, __VA_ARGS__)
+#define EF_INFO_CAT(CategoryName, ...) EF_LOG(CategoryName, info, __VA_ARGS__)
+#define EF_WARN_CAT(CategoryName, ...) EF_LOG(CategoryName, warn, __VA_ARGS__)
+#define EF_ERROR_CAT(CategoryName, ...) EF_LOG(CategoryName, err, __VA_ARGS__)
+#define EF_CRITICAL_CAT(CategoryName, ...) EF_LOG(CategoryName, critical, __VA_ARGS__)
@@ -3,6 +3,7 @@
 #include <mutex>
 #include <map>
 #include "CoreMacros.h"
+#include "EFCoreModuleAPI.h"
 // TODO: Wrap std smartpointers
 // TODO: Optional; Custom Memory Alignment and management, overwrite global standard new and delete keywords to use
 // threshold based Garbage Collection.
@@ -13,16 +14,20 @@ namespace EventfulEngine{
     struct EFAllocationStats{
         size_t TotalAllocated = 0;
         size_t TotalFreed = 0;
+        size_t AllocationCount = 0;
+        size_t FreeCount = 0;
     };
 
     struct EFAllocation{
         void* Memory = nullptr;
         size_t Size = 0;
         const char* Category = nullptr;
+        /** Whether the allocation was reported to the profiler, so the free is reported to it as well. */
+        bool bIsProfiled = false;
     };
 
     namespace EFMemory{
-        const EFAllocationStats& GetAllocationStats();
+        EFCORE_API const EFAllocationStats& GetAllocationStats();
     }
 
     template <class T>
@@ -65,7 +70,7 @@ namespace EventfulEngine{
     };
 
 
-    class EFAllocator{
+    class EFCORE_API EFAllocator{
     public:
         static void Init();
 
@@ -1,10 +1,16 @@
 #pragma once
 #include <CoreTypes.h>
 #include <functional>
+#include <string_view>
+
+#include "EFInlineString.h"
+#include "EFSmallVector.h"
 
 
 namespace EventfulEngine{
-    using EFCommandFunction = std::function<void(const std::vector<EFString>&)>;
+    /** Arguments of a console command, short argument lists and arguments do not allocate. */
+    using EFCommandArgs = EFSmallVector<EFInlineString<31>, 8>;
+    using EFCommandFunction = std::function<void(const EFCommandArgs&)>;
 
     class EFCORE_API EFCommandRegistry{
 
@@ -13,6 +19,6 @@ namespace EventfulEngine{
 
         static void Unregister(const EFString& name);
 
-        static bool Execute(const EFString& commandLine);
+        static bool Execute(std::string_view commandLine);
     };
 };
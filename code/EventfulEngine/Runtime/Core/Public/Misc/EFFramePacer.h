@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "EFCoreModuleAPI.h"
+
+#include <array>
+
+namespace EventfulEngine{
+    /** Timing of the current frame, handed out by EFFramePacer::BeginFrame. */
+    struct EFFrameTiming{
+        uint64 FrameIndex{0};
+        /** Real time since the previous frame began, clamped to the MaxDeltaTime of the settings. */
+        double DeltaSeconds{0.0};
+        /** Number of fixed steps to simulate this frame, each FixedStepSeconds long. */
+        uint32 FixedSteps{0};
+        double FixedStepSeconds{0.0};
+        /** How far the frame lies between the last and the next fixed step, for interpolating rendered state. */
+        double InterpolationAlpha{0.0};
+    };
+
+    struct EFFramePacerSettings{
+        /** Frames per second to pace to, 0 runs as fast as possible. */
+        double TargetFps{0.0};
+        /** Rate of fixed simulation steps, 0 disables fixed stepping. */
+        double FixedStepHz{0.0};
+        /** Caps the fixed steps per frame, so a slow frame cannot snowball into ever slower frames. */
+        uint32 MaxFixedSteps{8};
+        /** Longest delta a frame reports, e.g. after a breakpoint or a load. */
+        EFDuration MaxDeltaTime{std::chrono::milliseconds(250)};
+        /** The pacer sleeps until this long before the deadline and spins for the rest, covering sleep overshoot. */
+        EFDuration SpinWindow{std::chrono::microseconds(1500)};
+    };
+
+    /** Frame time statistics over the recent frame history. */
+    struct EFFramePacerStats{
+        uint64 FrameCount{0};
+        double AverageFrameSeconds{0.0};
+        double MinFrameSeconds{0.0};
+        double MaxFrameSeconds{0.0};
+        /** Standard deviation of the frame time. */
+        double JitterSeconds{0.0};
+        /** Largest overshoot of a frame past its deadline. */
+        double MaxLatenessSeconds{0.0};
+        /** Frames whose work alone already ran past the deadline. */
+        uint64 MissedDeadlines{0};
+    };
+
+    /**
+     * Paces the main loop to a target frame rate and splits real time into fixed simulation steps. EndFrame sleeps
+     * for most of the remaining frame budget and spins the last SpinWindow, which hits deadlines far tighter than
+     * sleeping alone without burning a core for the whole frame. Times are taken with
+     * EFPlatformTime::Cycles64, which calibrates on its first read unless CalibrateCycles ran before.
+     */
+    class EFCORE_API EFFramePacer{
+    public:
+        explicit EFFramePacer(const EFFramePacerSettings& settings = {});
+
+        /** Applies new settings, the next deadline is measured from the next frame. */
+        void SetSettings(const EFFramePacerSettings& settings);
+
+        [[nodiscard]] const EFFramePacerSettings& GetSettings() const{ return _settings; }
+
+        /** Starts a frame, measuring the time since the previous one and advancing the fixed step accumulator. */
+        const EFFrameTiming& BeginFrame();
+
+        /** Ends a frame, waiting until its deadline if a target frame rate is set. */
+        void EndFrame();
+
+        /**
+         * Ends a frame that idled instead of waiting for its deadline. The next frame is neither recorded in the
+         * statistics nor counted as late, pacing restarts from there.
+         */
+        void EndIdleFrame();
+
+        [[nodiscard]] const EFFrameTiming& GetFrameTiming() const{ return _timing; }
+
+        [[nodiscard]] EFFramePacerStats GetStats() const;
+
+        void ResetStats();
+
+    private:
+        static constexpr uint32 HistorySize = 128;
+
+        EFFramePacerSettings _settings;
+        EFFrameTiming _timing;
+        double _accumulator{0.0};
+        uint64 _frameStartCycles{0};
+        uint64 _deadlineCycles{0};
+        bool _bIsResumingFromIdle{false};
+
+        std::array<double, HistorySize> _frameHistory{};
+        uint64 _frameCount{0};
+        double _maxLatenessSeconds{0.0};
+        uint64 _missedDeadlines{0};
+    };
+} // EventfulEngine
@@ -3,17 +3,23 @@
 #include <array>
 #include <cassert>
 #include <functional>
+#include <span>
 #include <string_view>
 
 #include "CoreTypes.h"
+#include "EFCoreModuleAPI.h"
 
 namespace EventfulEngine{
-	class EFGUID{
+	class EFCORE_API EFGUID{
 	public:
+		/** Length of the canonical string form, 8-4-4-4-12 lower case hex digits. */
+		static constexpr size_t StringLength = 36;
+
 		explicit EFGUID(const std::array<unsigned char, 16>& bytes);
 
 		explicit EFGUID(std::array<unsigned char, 16>&& bytes);
 
+		/** Parses the canonical form or 32 hex digits with optional dashes. Invalid strings give the empty GUID. */
 		explicit EFGUID(std::string_view fromString);
 
 		EFGUID();
@@ -30,6 +36,9 @@ namespace EventfulEngine{
 
 		EFString String() const;
 
+		/** Writes the canonical string form without allocating. */
+		void ToChars(std::span<char, StringLength> out) const;
+
 		explicit(false) operator EFString() const;
 
 		const std::array<unsigned char, 16>& Bytes() const;
@@ -52,7 +61,11 @@ namespace EventfulEngine{
 		friend bool operator<(const EFGUID& lhs, const EFGUID& rhs);
 	};
 
-	EFGUID NewGuid();
+	/** Random version 4 GUID from a per thread generator, no system call or lock involved. */
+	EFCORE_API EFGUID NewGuid();
+
+	/** Fills the span with random version 4 GUIDs. */
+	EFCORE_API void NewGuids(std::span<EFGUID> out);
 
 	namespace Details{
 		template <typename...>
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "EFCoreModuleAPI.h"
+
+#include <functional>
+
+namespace EventfulEngine{
+    /**
+     * Decides whether the engine loop may idle and lets it block until something happens. The loop counts as busy
+     * while a window is focused and visible or work is pending, otherwise it sleeps in WaitForActivity until an OS
+     * event, a RequestWake from any thread or the timeout, instead of spinning through empty frames.
+     */
+    class EFCORE_API EFIdleMonitor{
+    public:
+        /** Blocks on OS events, e.g. glfwWaitEventsTimeout, for at most the given time. */
+        using PlatformWaitFunction = std::function<void(EFDuration timeout)>;
+        /** Makes a pending PlatformWaitFunction return, must be callable from any thread. */
+        using PlatformWakeFunction = std::function<void()>;
+
+        /** True if nothing needs the loop running at full rate. */
+        [[nodiscard]] static bool ShouldIdle();
+
+        /**
+         * Blocks until activity or the timeout, on the platform event queue if one is registered and on a condition
+         * variable otherwise. Returns right away if a wake was requested since the last wait.
+         */
+        static void WaitForActivity(EFDuration timeout);
+
+        /** Ends the current or next WaitForActivity early. Callable from any thread. */
+        static void RequestWake();
+
+        /** Work that needs the loop running, e.g. async loads that finish on the game thread. */
+        static void AddPendingWork();
+
+        static void RemovePendingWork();
+
+        /** A window gained or lost the state of being focused and not minimized. */
+        static void AddActiveWindow();
+
+        static void RemoveActiveWindow();
+
+        /** Routes waits to the OS event queue, so input and window events end an idle wait. Pass empty to reset. */
+        static void SetPlatformEvents(PlatformWaitFunction wait, PlatformWakeFunction wake);
+    };
+
+    /** Keeps the loop out of idle mode for its lifetime. */
+    struct EFScopedPendingWork{
+        NOMOVEORCOPY(EFScopedPendingWork)
+
+        EFScopedPendingWork(){
+            EFIdleMonitor::AddPendingWork();
+        }
+
+        ~EFScopedPendingWork(){
+            EFIdleMonitor::RemovePendingWork();
+        }
+    };
+} // EventfulEngine
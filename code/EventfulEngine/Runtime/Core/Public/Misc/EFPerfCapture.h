@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "EFCoreModuleAPI.h"
+#include "EFProfiler.h"
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace EventfulEngine{
+    /**
+     * Result of a perf capture. The summary is a flat list of named metrics, so two reports of different builds can
+     * be compared metric by metric. Every metric is a cost, lower is better.
+     */
+    struct EFCORE_API EFPerfReport{
+        struct Metric{
+            EFString Name;
+            double Value{0.0};
+        };
+
+        uint32 FrameCount{0};
+        std::vector<Metric> Metrics;
+        /** Time of every captured frame in milliseconds, only stored in JSON reports. */
+        std::vector<double> FrameMilliseconds;
+
+        [[nodiscard]] const Metric* FindMetric(std::string_view name) const;
+
+        /** Writes JSON for .json paths and one metric per line CSV for every other path. */
+        bool Save(const std::filesystem::path& path) const;
+
+        /** Reads a report written by Save, nullopt if the file is missing or malformed. */
+        [[nodiscard]] static std::optional<EFPerfReport> Load(const std::filesystem::path& path);
+    };
+
+    struct EFPerfMetricDifference{
+        EFString Name;
+        std::optional<double> Baseline;
+        std::optional<double> Current;
+        /** Relative change from the baseline in percent, 0 if either side is missing or the baseline is 0. */
+        double ChangePercent{0.0};
+        bool bIsRegression{false};
+
+        /** The baseline has the metric but the current report does not, e.g. a zone that no longer runs. */
+        [[nodiscard]] bool IsRemoved() const{ return Baseline && !Current; }
+    };
+
+    /**
+     * Compares the metrics of two reports, in the order of the baseline followed by metrics only the current report
+     * has. A metric regressed if it grew by more than thresholdPercent. A relative threshold can not apply to a
+     * baseline of 0, such a metric regressed if it grew by more than zeroBaselineThreshold instead.
+     */
+    EFCORE_API std::vector<EFPerfMetricDifference> ComparePerfReports(const EFPerfReport& baseline,
+                                                                       const EFPerfReport& current,
+                                                                       double thresholdPercent,
+                                                                       double zeroBaselineThreshold = 0.0);
+
+    struct EFPerfCaptureSettings{
+        /** Frames that go into the report. */
+        uint32 FrameCount{1000};
+        /** Frames skipped before capturing, so loading and warming caches does not skew the results. */
+        uint32 WarmupFrames{60};
+    };
+
+    /**
+     * Collects the profiler stats, allocations and counters of a fixed number of frames and summarizes them as an
+     * EFPerfReport: frame time percentiles, per zone times, allocations per frame and counters like draw calls.
+     */
+    class EFCORE_API EFPerfCapture{
+    public:
+        explicit EFPerfCapture(const EFPerfCaptureSettings& settings);
+
+        /** Adds the last frame closed by EFProfiler::EndFrame. Returns true once all frames were captured. */
+        bool AddFrame();
+
+        [[nodiscard]] bool IsComplete() const{ return _frames.size() >= _settings.FrameCount; }
+
+        [[nodiscard]] EFPerfReport BuildReport() const;
+
+    private:
+        struct FrameSample{
+            EFProfilerFrameStats Stats;
+            size_t Allocations{0};
+            size_t AllocatedBytes{0};
+        };
+
+        EFPerfCaptureSettings _settings;
+        std::vector<FrameSample> _frames;
+        uint32 _warmupFramesLeft;
+        // Allocation stats at the end of the previous AddFrame or at construction, the capture does not count its own
+        // allocations and the first frame not the ones since startup
+        size_t _lastAllocationCount;
+        size_t _lastAllocatedBytes;
+    };
+} // EventfulEngine
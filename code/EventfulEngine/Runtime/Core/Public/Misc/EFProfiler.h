@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "CoreMacros.h"
+#include "EFCoreModuleAPI.h"
+#include "GenericPlatformTime.h"
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace EventfulEngine{
+    struct EFProfilerZoneStats{
+        /** Zone name, string literals and interned names stay valid for the lifetime of the program. */
+        const char* Name{""};
+        double TotalSeconds{0.0};
+        double MaxSeconds{0.0};
+        uint32 Count{0};
+    };
+
+    struct EFProfilerCounter{
+        const char* Name{""};
+        int64 Value{0};
+    };
+
+    /** What happened in one frame, for the stats overlay of the UI module and the perf capture reports. */
+    struct EFProfilerFrameStats{
+        uint64 FrameIndex{0};
+        /** CPU time from the end of the previous frame to the end of this one. */
+        double FrameSeconds{0.0};
+        /** Sum of all GPU zones. GPU timings arrive a few frames late, bHasGpuTimings is set once they did. */
+        double GpuSeconds{0.0};
+        bool bHasGpuTimings{false};
+        /** Zones of all threads, merged by name and sorted by total time. Empty unless the builtin backend is used. */
+        std::vector<EFProfilerZoneStats> CpuZones;
+        std::vector<EFProfilerZoneStats> GpuZones;
+        /** Per frame counters like draw calls, see EFProfiler::AddCounter. */
+        std::vector<EFProfilerCounter> Counters;
+        /** Events overwritten in a thread ring buffer before the end of the frame collected them. */
+        uint32 DroppedEvents{0};
+    };
+
+    /**
+     * Built in profiler for builds without Tracy. Every thread records its zones into its own ring buffer without
+     * locks, EndFrame collects them into per frame stats that are kept for the last FrameHistorySize frames. The
+     * ring of an exited thread is collected by the next EndFrame and handed to the next thread that records a zone.
+     * GPU zones are reported by the RenderAPI once their timer queries resolved and share the CPU timeline.
+     * Record zones through the EF_PROFILE_* macros of EFProfiling.h, which compile out with the none backend.
+     */
+    class EFCORE_API EFProfiler{
+    public:
+        static constexpr uint32 EventsPerThread = 16 * 1024;
+        static constexpr uint32 FrameHistorySize = 256;
+
+        /** Run time switch, zones opened while profiling is disabled cost a single relaxed load. */
+        [[nodiscard]] static bool IsEnabled(){ return bIsEnabled.load(std::memory_order_relaxed); }
+
+        static void SetEnabled(bool bEnabled);
+
+        /** Name of the calling thread in the trace. */
+        static void SetThreadName(const char* name);
+
+        /** Record a finished CPU zone of the calling thread, timestamps are EFPlatformTime::Cycles64. */
+        static void RecordZone(const char* name, uint64 startCycles, uint64 endCycles);
+
+        /**
+         * Record a resolved GPU zone. Timer queries only measure durations, so the zone is placed on the GPU track
+         * at the time its commands were recorded, or right after the previous GPU zone of the frame.
+         */
+        static void RecordGpuZone(uint64 frameIndex, const char* name, uint64 recordCycles, double gpuSeconds);
+
+        /** Add to a counter of the current frame. The name has to stay valid, like zone names. */
+        static void AddCounter(const char* name, int64 value);
+
+        /** Close the current frame and collect the zones of all threads. Returns the index of the next frame. */
+        static uint64 EndFrame();
+
+        /** Index of the frame currently being recorded. */
+        [[nodiscard]] static uint64 GetFrameIndex();
+
+        /** Stats of the last finished frame. */
+        [[nodiscard]] static EFProfilerFrameStats GetLastFrameStats();
+
+        /** Stats of a finished frame that is still in the history. */
+        [[nodiscard]] static std::optional<EFProfilerFrameStats> GetFrameStats(uint64 frameIndex);
+
+        /** Stats of up to FrameHistorySize finished frames, oldest first. */
+        [[nodiscard]] static std::vector<EFProfilerFrameStats> GetFrameHistory();
+
+        /** Write the zones still held in the ring buffers, CPU and GPU, as Chrome trace JSON. */
+        static bool WriteChromeTrace(const std::filesystem::path& path);
+
+    private:
+        inline static std::atomic<bool> bIsEnabled{true};
+    };
+
+    /** Records the lifetime of the scope as a zone of the builtin profiler. */
+    class EFProfilerScope{
+    public:
+        /** Tag for zone names built at run time, which get interned so the ring buffer can keep the pointer. */
+        static constexpr struct InternNameTag{} InternName{};
+
+        explicit EFProfilerScope(const char* name) : _name(name){
+            if (EFProfiler::IsEnabled()){
+                _start = EFPlatformTime::Cycles64();
+            }
+        }
+
+        EFCORE_API EFProfilerScope(InternNameTag, std::string_view name);
+
+        ~EFProfilerScope(){
+            if (_start != 0){
+                EFProfiler::RecordZone(_name, _start, EFPlatformTime::Cycles64());
+            }
+        }
+
+        NOMOVEORCOPY(EFProfilerScope)
+
+    private:
+        const char* _name;
+        uint64 _start{0};
+    };
+} // EventfulEngine
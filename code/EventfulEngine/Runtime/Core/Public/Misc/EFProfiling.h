@@ -1,22 +1,60 @@
 #pragma once
 
-//TODO: Add define that disables profiling in distribution
-#define EF_ENABLE_PROFILING 1
+#include "EFProfiler.h"
 
-#if EF_ENABLE_PROFILING
+// Backends, picked with the EVENTFUL_PROFILER CMake option
+#define EF_PROFILER_NONE 0
+#define EF_PROFILER_BUILTIN 1
+#define EF_PROFILER_TRACY 2
+
+#ifndef EF_PROFILER
+#ifdef EF_DISTRIBUTED
+#define EF_PROFILER EF_PROFILER_NONE
+#else
+#define EF_PROFILER EF_PROFILER_TRACY
+#endif
+#endif
+
+#define EF_ENABLE_PROFILING (EF_PROFILER != EF_PROFILER_NONE)
+
+#if EF_PROFILER == EF_PROFILER_TRACY
 #include <tracy/Tracy.hpp>
 #endif
 
-#if EF_ENABLE_PROFILING
-#define EF_PROFILE_MARK_FRAME			FrameMark;
-#define EF_PROFILE_FUNC(...)			ZoneScoped##__VA_OPT__(N(__VA_ARGS__))
+#define EF_PROFILE_CONCAT_INNER(A, B) A##B
+#define EF_PROFILE_CONCAT(A, B) EF_PROFILE_CONCAT_INNER(A, B)
+// The zone name if one was given, the enclosing function otherwise
+#define EF_PROFILE_FIRST(First, ...) First
+#define EF_PROFILE_ZONE_NAME(...) EF_PROFILE_FIRST(__VA_ARGS__ __VA_OPT__(,) __func__)
+
+// Zones check EFProfiler::IsEnabled when they open, so profiling can also be switched off at run time
+#if EF_PROFILER == EF_PROFILER_TRACY
+#define EF_PROFILE_MARK_FRAME			FrameMark; ::EventfulEngine::EFProfiler::EndFrame()
+#define EF_PROFILE_FUNC(...)			ZoneNamed##__VA_OPT__(N)(___tracy_scoped_zone, __VA_OPT__(__VA_ARGS__,) \
+                                            ::EventfulEngine::EFProfiler::IsEnabled())
+#define EF_PROFILE_SCOPE(...)			EF_PROFILE_FUNC(__VA_ARGS__)
+#define EF_PROFILE_SCOPE_DYNAMIC(NAME)  ZoneNamed(___tracy_scoped_zone, ::EventfulEngine::EFProfiler::IsEnabled()); \
+                                        ZoneName(NAME, strlen(NAME))
+#define EF_PROFILE_THREAD(...)          tracy::SetThreadName(__VA_ARGS__); \
+                                        ::EventfulEngine::EFProfiler::SetThreadName(__VA_ARGS__)
+#define EF_PROFILE_ALLOC(Memory, Size)  TracyAlloc(Memory, Size)
+#define EF_PROFILE_FREE(Memory)         TracyFree(Memory)
+#elif EF_PROFILER == EF_PROFILER_BUILTIN
+#define EF_PROFILE_MARK_FRAME			::EventfulEngine::EFProfiler::EndFrame()
+#define EF_PROFILE_FUNC(...)			::EventfulEngine::EFProfilerScope \
+                                            EF_PROFILE_CONCAT(_profileScope, __LINE__){EF_PROFILE_ZONE_NAME(__VA_ARGS__)}
 #define EF_PROFILE_SCOPE(...)			EF_PROFILE_FUNC(__VA_ARGS__)
-#define EF_PROFILE_SCOPE_DYNAMIC(NAME)  ZoneScoped; ZoneName(NAME, strlen(NAME))
-#define EF_PROFILE_THREAD(...)          tracy::SetThreadName(__VA_ARGS__)
+#define EF_PROFILE_SCOPE_DYNAMIC(NAME)  ::EventfulEngine::EFProfilerScope EF_PROFILE_CONCAT(_profileScope, __LINE__){ \
+                                            ::EventfulEngine::EFProfilerScope::InternName, NAME}
+#define EF_PROFILE_THREAD(...)          ::EventfulEngine::EFProfiler::SetThreadName(__VA_ARGS__)
+#define EF_PROFILE_ALLOC(Memory, Size)
+#define EF_PROFILE_FREE(Memory)
 #else
 #define EF_PROFILE_MARK_FRAME
 #define EF_PROFILE_FUNC(...)
 #define EF_PROFILE_SCOPE(...)
 #define EF_PROFILE_SCOPE_DYNAMIC(NAME)
 #define EF_PROFILE_THREAD(...)
+#define EF_PROFILE_ALLOC(Memory, Size)
+#define EF_PROFILE_FREE(Memory)
 #endif
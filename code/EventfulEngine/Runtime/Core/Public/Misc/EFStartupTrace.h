@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "CoreMacros.h"
+#include "EFCoreModuleAPI.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace EventfulEngine{
+    /**
+     * Records timed startup events (static initializers, module loads, engine loop phases) from the very first
+     * static initializer until Finish() is called. The result can be written as Chrome trace JSON
+     * (chrome://tracing, Perfetto) or printed as a summary table.
+     * Storage is a function local static, so recording is safe during static initialization of any module.
+     */
+    class EFCORE_API EFStartupTrace{
+    public:
+        struct Event{
+            const char* Category{""};
+            EFString Name;
+            uint64 StartNs{0};
+            uint64 DurationNs{0};
+            uint32 ThreadId{0};
+        };
+
+        /** Nanoseconds since the first use of the tracer. */
+        static uint64 Now();
+
+        /** Record a finished event. Ignored once Finish() was called. */
+        static void Record(const char* category, EFString name, uint64 startNs, uint64 endNs);
+
+        /** Stop recording, startup is over. */
+        static void Finish();
+
+        [[nodiscard]] static bool IsRecording();
+
+        /** Copy of all recorded events, ordered by start time. */
+        [[nodiscard]] static std::vector<Event> GetEvents();
+
+        /** Time between the first recorded event and Finish() (or now, while still recording). */
+        [[nodiscard]] static uint64 GetTotalNs();
+
+        /** Write all events as Chrome trace JSON. */
+        static bool WriteChromeTrace(const std::filesystem::path& path);
+
+        /** Per-category totals followed by the slowest events. */
+        [[nodiscard]] static EFString BuildSummary(uint32 maxEvents = 20);
+    };
+
+    /** Records the lifetime of the scope as a startup event. */
+    class EFStartupTraceScope{
+    public:
+        EFStartupTraceScope(const char* category, EFString name) : _category(category), _name(std::move(name)),
+                                                                    _start(EFStartupTrace::Now()){
+        }
+
+        ~EFStartupTraceScope(){
+            EFStartupTrace::Record(_category, std::move(_name), _start, EFStartupTrace::Now());
+        }
+
+        NOMOVEORCOPY(EFStartupTraceScope)
+
+    private:
+        const char* _category;
+        EFString _name;
+        uint64 _start;
+    };
+} // EventfulEngine
+
+#define EF_STARTUP_TRACE_CONCAT_INNER(A, B) A##B
+#define EF_STARTUP_TRACE_CONCAT(A, B) EF_STARTUP_TRACE_CONCAT_INNER(A, B)
+#define EF_STARTUP_TRACE_SCOPE(Category, Name) \
+    ::EventfulEngine::EFStartupTraceScope EF_STARTUP_TRACE_CONCAT(_startupTraceScope, __LINE__){Category, Name}
@@ -3,6 +3,8 @@
 #include <ModuleLoadPhase.h>
 
 namespace EventfulEngine{
+    class EFObject;
+
     /*!
      * @brief Interface class to define an entry point for all modules. Initializes modules and provides important callbacks
      */
@@ -39,6 +41,13 @@ namespace EventfulEngine{
         }
 
 
+        virtual EFObject* GetReloadState(){
+            // Optional reflected object holding the module state. Its properties are serialized before a hot reload
+            // and restored into the state object of the new instance right after StartupModule.
+            return nullptr;
+        }
+
+
         virtual bool SupportsAutomaticShutdown(){
             return true;
         }
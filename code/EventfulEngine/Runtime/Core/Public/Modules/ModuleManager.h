@@ -4,10 +4,16 @@
 #include <CoreTypes.h>
 
 #include "IManager.h"
+#include "EFName.h"
+#include "EFStartupTrace.h"
 #include <string_view>
 #include "ModuleLoadPhase.h"
 #include "PlatformMisc.h"
+#include "Thread.h"
+#include <atomic>
+#include <filesystem>
 #include <unordered_map>
+#include <vector>
 
 
 //TODO: Move this to platform code
@@ -25,41 +31,65 @@ namespace EventfulEngine{
         using ModuleFactory = IModule*(*)();
 
         /** Register a statically linked module instance. */
-        void RegisterStaticModule(const EFString& name,
+        void RegisterStaticModule(const EFName name,
                                   E_ModuleLoadPhase phase,
                                   IModule* instance);
 
         /** Register a dynamically loaded module. */
-        void RegisterDynamicModule(const EFString& name,
+        void RegisterDynamicModule(const EFName name,
                                    E_ModuleLoadPhase phase,
                                    const std::string_view& libraryPath);
 
+        /** Declare the modules that must be loaded before the given module. */
+        void RegisterModuleDependencies(const EFName name, const std::vector<EFName>& dependencies);
+
+        /** Read the dependency edges of a single .efmoddef file. */
+        bool RegisterModuleDescriptor(const std::filesystem::path& descriptorPath);
+
+        /** Read the dependency edges of every .efmoddef file below a directory. */
+        uint32 RegisterModuleDescriptors(const std::filesystem::path& directory);
+
         /** Load a single module by name. */
-        bool LoadModule(const EFString& name);
+        bool LoadModule(const EFName name);
 
-        /** Load all modules registered for a given phase. */
+        /**
+         * Load all modules registered for a given phase. Modules are sorted by their dependencies and every
+         * wave of independent modules is loaded in parallel.
+         */
         bool LoadModules(E_ModuleLoadPhase phase);
 
         /** Unload a single module by name. */
-        bool UnloadModule(const EFString& name);
+        bool UnloadModule(const EFName name);
 
         /** Unload all modules for a given phase. */
         bool UnloadModules(E_ModuleLoadPhase phase);
 
-        /** Reload a single module including dependent phases. */
-        bool ReloadModule(const EFString& name);
+        /**
+         * Hot reload a single module. Only the module and the loaded modules that transitively depend on it are
+         * restarted, their reflected reload state is handed over to the new instances.
+         */
+        bool ReloadModule(const EFName name);
+
+        /** Hot reload every loaded dynamic module whose library changed on disk. Returns the number reloaded. */
+        uint32 ReloadChangedModules();
+
+        /** Load dynamic modules from a shadow copy, so the original library can be rebuilt while it is loaded. */
+        void SetUseShadowCopies(bool bUseShadowCopies){ _bUseShadowCopies = bUseShadowCopies; }
 
         /** Retrieve a module instance if loaded. */
-        IModule* GetModule(const EFString& name);
+        IModule* GetModule(const EFName name);
 
         /** Retrieve a module instance cast to a specific type. */
         template <typename T>
-        T* GetModuleAs(const EFString& name){
+        T* GetModuleAs(const EFName name){
             return dynamic_cast<T*>(GetModule(name));
         }
 
         /** Check if a module with the given name has been registered. */
-        [[nodiscard]] bool IsModuleRegistered(const EFString& name) const;
+        [[nodiscard]] bool IsModuleRegistered(const EFName name) const;
+
+        /** Time the last successful load of a module took, zero if it was never loaded. */
+        [[nodiscard]] EFDuration GetModuleLoadTime(const EFName name) const;
 
         /** Shutdown and unload all modules. */
         void Shutdown();
@@ -73,9 +103,38 @@ namespace EventfulEngine{
             ModuleFactory Factory{nullptr};
             IModule* Instance{nullptr};
             bool bIsLoaded{false};
+            EFDuration LoadTime{};
+            EFString LoadedLibrary;
+            uint64 LibraryWriteTime{0};
         };
 
-        std::unordered_map<EFString, ModuleEntry> _modules;
+        /** Loads a single entry without resolving its dependencies. Safe to call for distinct entries in parallel. */
+        bool LoadModuleEntry(const EFName name, ModuleEntry& entry);
+
+        /** Sorts the given modules into waves, each wave only depends on modules of earlier waves. */
+        std::vector<std::vector<EFName>> SortIntoWaves(const std::vector<EFName>& names) const;
+
+        /** Collects the given module and all registered modules that transitively depend on it. */
+        std::vector<EFName> CollectDependents(const EFName name) const;
+
+        /** Same as IsModuleRegistered, for callers that already hold the modules mutex. */
+        [[nodiscard]] bool IsModuleRegisteredLocked(const EFName name) const;
+
+        /** Whether the entry was registered with an instance or a library, not only referenced. */
+        static bool IsRegisteredEntry(const ModuleEntry& entry);
+
+        /** The declared dependencies of a module, empty if it has no descriptor. */
+        const std::vector<EFName>& GetDependencies(const EFName name) const;
+
+        /** Copies the module library next to the original and returns the path to load, or the original on failure. */
+        EFString MakeShadowCopy(const ModuleEntry& entry);
+
+        std::unordered_map<EFName, ModuleEntry> _modules;
+        // Descriptor dependencies by module name, they may be declared before the module itself registers
+        std::unordered_map<EFName, std::vector<EFName>> _dependencies;
+        mutable RecursiveMutex _modulesMutex;
+        std::atomic<uint32> _shadowCopyCounter{0};
+        bool _bUseShadowCopies{true};
     };
 
     /**
@@ -97,6 +156,7 @@ namespace EventfulEngine{
         { \
             ModuleName##AutoRegister() \
             { \
+                EF_STARTUP_TRACE_SCOPE("StaticInit", "AutoRegister " #ModuleName); \
                 EventfulEngine::ModuleManager& Manager = EventfulEngine::ModuleManager::Get(); \
                 if (!Manager.IsModuleRegistered(#ModuleName)) \
                 { \
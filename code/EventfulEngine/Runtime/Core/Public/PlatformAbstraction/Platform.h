@@ -25,6 +25,22 @@
         #define EF_EXPLICIT_STATIC
 #endif
 
+// SIMD instruction sets guaranteed by the target, code paths using them need a scalar fallback
+#if !defined(EF_PLATFORM_SSE2)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EF_PLATFORM_SSE2 1
+#else
+#define EF_PLATFORM_SSE2 0
+#endif
+#endif
+#if !defined(EF_PLATFORM_NEON)
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define EF_PLATFORM_NEON 1
+#else
+#define EF_PLATFORM_NEON 0
+#endif
+#endif
+
 // TODO: Currently only support windows and autodefines it, later CMake should set platform defines, this script makes sure to undefine other platforms, even though they are not supported yet
 #define EF_PLATFORM_WINDOWS 1
 
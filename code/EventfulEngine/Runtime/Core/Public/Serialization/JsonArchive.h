@@ -27,6 +27,19 @@ namespace EventfulEngine{
             return true;
         }
 
+        template <typename T>
+        void Set(const EFName key, const T& value){ _json[key.GetData()] = value; }
+
+        template <typename T>
+        bool Get(const EFName key, T& out) const{
+            const auto value = _json.find(key.GetData());
+            if (value == _json.end()){
+                return false;
+            }
+            out = value->template get<T>();
+            return true;
+        }
+
         nlohmann::json& Data(){ return _json; }
         [[nodiscard]] const nlohmann::json& Data() const{ return _json; }
 
@@ -34,6 +47,14 @@ namespace EventfulEngine{
         nlohmann::json _json;
     };
 
+    inline void to_json(nlohmann::json& json, const EFName name){
+        json = name.ToStringView();
+    }
+
+    inline void from_json(const nlohmann::json& json, EFName& name){
+        name = EFName{json.get_ref<const EFString&>()};
+    }
+
     using JsonWriteFunction = std::function<void(const EFObject*, JsonArchive&, const EFProperty&)>;
     using JsonReadFunction = std::function<void(EFObject*, const JsonArchive&, const EFProperty&)>;
 
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "EFSmallVector.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <string_view>
+
+namespace EventfulEngine{
+    /**
+     * String that keeps up to InlineCapacity characters inside the object, for short text like command arguments
+     * and identifiers that would otherwise allocate once they outgrow the small string buffer of EFString.
+     * Longer text spills to the heap. The text is always null terminated.
+     */
+    template <uint32 InlineCapacity>
+    class EFInlineString{
+    public:
+        using value_type = char;
+        using size_type = size_t;
+        using iterator = char*;
+        using const_iterator = const char*;
+
+        EFInlineString() = default;
+
+        EFInlineString(const std::string_view text){
+            append(text);
+        }
+
+        EFInlineString(const char* text) : EFInlineString(std::string_view{text}){
+        }
+
+        EFInlineString(const EFString& text) : EFInlineString(std::string_view{text}){
+        }
+
+        // The vector only copies size() characters, the terminator is restored after every copy or move
+        EFInlineString(const EFInlineString& other) : _chars(other._chars){
+            Terminate();
+        }
+
+        EFInlineString(EFInlineString&& other) noexcept : _chars(std::move(other._chars)){
+            Terminate();
+        }
+
+        EFInlineString& operator=(const EFInlineString& other){
+            _chars = other._chars;
+            Terminate();
+            return *this;
+        }
+
+        EFInlineString& operator=(EFInlineString&& other) noexcept{
+            _chars = std::move(other._chars);
+            Terminate();
+            return *this;
+        }
+
+        EFInlineString& operator=(const std::string_view text){
+            clear();
+            return append(text);
+        }
+
+        iterator begin() noexcept{ return _chars.begin(); }
+        iterator end() noexcept{ return _chars.end(); }
+        const_iterator begin() const noexcept{ return _chars.begin(); }
+        const_iterator end() const noexcept{ return _chars.end(); }
+
+        [[nodiscard]] bool empty() const noexcept{ return _chars.empty(); }
+        [[nodiscard]] size_type size() const noexcept{ return _chars.size(); }
+        [[nodiscard]] size_type length() const noexcept{ return _chars.size(); }
+        [[nodiscard]] size_type capacity() const noexcept{ return _chars.capacity() - 1; }
+        [[nodiscard]] bool is_inline() const noexcept{ return _chars.is_inline(); }
+
+        char* data() noexcept{ return _chars.data(); }
+        const char* data() const noexcept{ return _chars.data(); }
+
+        /** Null terminated text. */
+        [[nodiscard]] const char* c_str() const noexcept{ return empty() ? "" : _chars.data(); }
+
+        char& operator[](const size_type index) noexcept{ return _chars[index]; }
+        char operator[](const size_type index) const noexcept{ return _chars[index]; }
+
+        [[nodiscard]] std::string_view view() const noexcept{ return {_chars.data(), _chars.size()}; }
+        operator std::string_view() const noexcept{ return view(); }
+
+        [[nodiscard]] EFString ToString() const{ return EFString{view()}; }
+
+        void reserve(const size_type capacity){ _chars.reserve(capacity + 1); }
+
+        void clear() noexcept{ _chars.clear(); }
+
+        EFInlineString& append(const std::string_view text){
+            if (!text.empty()){
+                const size_type size = _chars.size();
+                Grow(size + text.size() + 1);
+                _chars.resize_for_overwrite(size + text.size());
+                std::memcpy(_chars.data() + size, text.data(), text.size());
+                Terminate();
+            }
+            return *this;
+        }
+
+        void push_back(const char character){
+            Grow(_chars.size() + 2);
+            _chars.push_back(character);
+            Terminate();
+        }
+
+        EFInlineString& operator+=(const std::string_view text){ return append(text); }
+
+        EFInlineString& operator+=(const char character){
+            push_back(character);
+            return *this;
+        }
+
+        friend bool operator==(const EFInlineString& left, const EFInlineString& right) noexcept{
+            return left.view() == right.view();
+        }
+
+        friend std::strong_ordering operator<=>(const EFInlineString& left, const EFInlineString& right) noexcept{
+            return left.view() <=> right.view();
+        }
+
+        friend bool operator==(const EFInlineString& left, const std::string_view right) noexcept{
+            return left.view() == right;
+        }
+
+        friend std::strong_ordering operator<=>(const EFInlineString& left, const std::string_view right) noexcept{
+            return left.view() <=> right;
+        }
+
+        // Literals convert to both string_view and EFInlineString, an exact overload keeps comparisons unambiguous
+        friend bool operator==(const EFInlineString& left, const char* right) noexcept{
+            return left.view() == std::string_view{right};
+        }
+
+        friend std::strong_ordering operator<=>(const EFInlineString& left, const char* right) noexcept{
+            return left.view() <=> std::string_view{right};
+        }
+
+    private:
+        // Doubles the storage like the vector itself does, exact reserves would reallocate on every append
+        void Grow(const size_type minimum){
+            if (minimum > _chars.capacity()){
+                _chars.reserve(std::max(minimum, _chars.capacity() * 2));
+            }
+        }
+
+        // Writes the terminator into spare storage past size(), the characters themselves never include it
+        void Terminate(){
+            _chars.reserve(_chars.size() + 1);
+            _chars.data()[_chars.size()] = '\0';
+        }
+
+        EFSmallVector<char, InlineCapacity + 1> _chars;
+    };
+} // EventfulEngine
+
+template <uint32 InlineCapacity>
+struct std::hash<EventfulEngine::EFInlineString<InlineCapacity>>{
+    size_t operator()(const EventfulEngine::EFInlineString<InlineCapacity>& text) const noexcept{
+        return std::hash<std::string_view>{}(text.view());
+    }
+};
+
+template <uint32 InlineCapacity>
+struct std::formatter<EventfulEngine::EFInlineString<InlineCapacity>> : std::formatter<std::string_view>{
+    auto format(const EventfulEngine::EFInlineString<InlineCapacity>& text, std::format_context& context) const{
+        return std::formatter<std::string_view>::format(text.view(), context);
+    }
+};
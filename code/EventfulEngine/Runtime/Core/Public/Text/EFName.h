@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "EFCoreModuleAPI.h"
+
+#include <format>
+#include <functional>
+#include <string_view>
+
+namespace EventfulEngine{
+    /**
+     * Interned identifier for class, property, module and tag names. Equal strings map to the same 32 bit index in
+     * a global, sharded name table, so names compare and hash in constant time and copying one never allocates.
+     * Interned text is never freed and stays valid for the lifetime of the program.
+     */
+    class EFCORE_API EFName{
+    public:
+        /** The None name, an empty string. */
+        constexpr EFName() = default;
+
+        /** Interns the text, adding it to the name table if it is not present yet. */
+        EFName(std::string_view text);
+
+        EFName(const char* text) : EFName(std::string_view{text}){
+        }
+
+        EFName(const EFString& text) : EFName(std::string_view{text}){
+        }
+
+        /** Looks up already interned text without adding it. Returns None if the text was never interned. */
+        [[nodiscard]] static EFName Find(std::string_view text);
+
+        [[nodiscard]] bool IsNone() const{ return _index == 0; }
+
+        /** Unique index of the name, also used as its std::hash. */
+        [[nodiscard]] uint32 GetIndex() const{ return _index; }
+
+        /** Hash of the text itself, computed once when it was interned. Stable between runs, unlike the index. */
+        [[nodiscard]] uint32 GetHash() const;
+
+        /** Null terminated text of the name. */
+        [[nodiscard]] const char* GetData() const;
+
+        [[nodiscard]] std::string_view ToStringView() const;
+
+        [[nodiscard]] EFString ToString() const{ return EFString{ToStringView()}; }
+
+        bool operator==(const EFName&) const = default;
+
+        /** Orders by text instead of index, for results that have to be deterministic between runs. */
+        [[nodiscard]] static bool LexicalLess(const EFName left, const EFName right){
+            return left.ToStringView() < right.ToStringView();
+        }
+
+        struct Stats{
+            uint32 NameCount{0};
+            /** Bytes of interned text including terminators. */
+            size_t TextBytes{0};
+            /** Bytes of entries and hash slots. */
+            size_t TableBytes{0};
+        };
+
+        /** Size of the name table, summed over all shards. */
+        [[nodiscard]] static Stats GetStats();
+
+    private:
+        uint32 _index{0};
+    };
+} // EventfulEngine
+
+template <>
+struct std::hash<EventfulEngine::EFName>{
+    size_t operator()(const EventfulEngine::EFName name) const noexcept{ return name.GetIndex(); }
+};
+
+template <>
+struct std::formatter<EventfulEngine::EFName> : std::formatter<std::string_view>{
+    auto format(const EventfulEngine::EFName name, std::format_context& context) const{
+        return std::formatter<std::string_view>::format(name.ToStringView(), context);
+    }
+};
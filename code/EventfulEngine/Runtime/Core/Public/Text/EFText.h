@@ -1,11 +1,13 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "EFHashMap.h"
 #include "EFCoreModuleAPI.h"
 
+#include <algorithm>
 #include <format>
+#include <span>
 #include <string_view>
-#include <unordered_map>
 
 namespace EventfulEngine{
 
@@ -32,9 +34,40 @@ namespace EventfulEngine{
             BrightWhite
         };
 
-        /** Format a string using std::format semantics. */
+        /** Format a string using std::format semantics. The format string is validated at compile time. */
         template <typename... Args>
-        static EFString Format(const std::string_view fmt, Args&&... args){
+        static EFString Format(std::format_string<Args...> fmt, Args&&... args){
+            return std::format(std::locale::classic(), fmt, std::forward<Args>(args)...);
+        }
+
+        /** Append the formatted text to out, reusing its capacity. */
+        template <typename... Args>
+        static void FormatTo(EFString& out, std::format_string<Args...> fmt, Args&&... args){
+            // Format straight into the spare capacity, only text that does not fit is formatted a second time
+            const size_t offset = out.size();
+            out.resize(std::max(out.capacity(), offset + 64));
+            const auto result = std::format_to_n(out.data() + offset, static_cast<std::ptrdiff_t>(out.size() - offset),
+                                                 std::locale::classic(), fmt, std::forward<Args>(args)...);
+            const auto size = static_cast<size_t>(result.size);
+            if (offset + size > out.size()){
+                out.resize(offset + size);
+                // Formatting only reads the arguments, forwarding them a second time is safe
+                std::format_to(out.data() + offset, std::locale::classic(), fmt, std::forward<Args>(args)...);
+            }
+            out.resize(offset + size);
+        }
+
+        /** Format into a caller provided buffer without allocating. Returns the written, possibly truncated, text. */
+        template <typename... Args>
+        static std::string_view FormatTo(std::span<char> buffer, std::format_string<Args...> fmt, Args&&... args){
+            const auto result = std::format_to_n(buffer.data(), static_cast<std::ptrdiff_t>(buffer.size()),
+                                                 std::locale::classic(), fmt, std::forward<Args>(args)...);
+            return {buffer.data(), static_cast<size_t>(result.out - buffer.data())};
+        }
+
+        /** Format with a format string only known at runtime. Throws std::format_error if it is malformed. */
+        template <typename... Args>
+        static EFString FormatRuntime(const std::string_view fmt, Args&&... args){
             return std::vformat(std::locale::classic(), fmt, std::make_format_args(args...));
         }
 
@@ -57,6 +90,6 @@ namespace EventfulEngine{
         static void ClearMacros();
 
     private:
-        static std::unordered_map<EFString, EFString> _macroTable;
+        static EFHashMap<EFString, EFString> _macroTable;
     };
 }
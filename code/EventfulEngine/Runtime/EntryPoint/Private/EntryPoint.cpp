@@ -4,6 +4,7 @@
 #include "../../Core/Public/CoreMinimal.h"
 #include "EventfulEngineLoop.h"
 #include "CoreGlobals.h"
+#include "EFStartupTrace.h"
 
 #include "GenericPlatform/GenericPlatformTime.h"
 
@@ -18,7 +19,8 @@ namespace EventfulEngine{
 	 * PreInits the engine loop
 	 */
 	int32 BeforeEngineInit(){
-		const int32 errorLevel = g_engineLoop.BeforeEngineInit();
+		EF_STARTUP_TRACE_SCOPE("EngineLoop", "BeforeEngineInit");
+		const int32 errorLevel = g_engineLoop.PreInitProcessCli();
 
 		return errorLevel;
 	}
@@ -27,6 +29,7 @@ namespace EventfulEngine{
 	 * Inits the engine loop
 	 */
 	int32 EngineInit(){
+		EF_STARTUP_TRACE_SCOPE("EngineLoop", "EngineInit");
 		const int32 errorLevel = g_engineLoop.Init();
 
 		return errorLevel;
@@ -46,6 +49,21 @@ namespace EventfulEngine{
 		g_engineLoop.Exit();
 	}
 
+	/**
+	 * Stops the startup trace, logs its summary and writes the Chrome trace if requested on the command line
+	 */
+	void ReportStartupTrace(){
+		EFStartupTrace::Finish();
+		EF_LOG(CoreLog, info, "{}", EFStartupTrace::BuildSummary());
+
+		if (const auto& options = g_commandLine.GetOptions(); options.count("startup-trace") > 0){
+			const EFString tracePath = options["startup-trace"].as<EFString>();
+			if (!EFStartupTrace::WriteChromeTrace(tracePath)){
+				EF_LOG(CoreLog, err, "Failed to write startup trace to '{}'", tracePath);
+			}
+		}
+	}
+
 	/*!
 	 * @brief Generic main entry point that is invoked by the platform-specific entry point after setting up platform boilerplate
 	 * @return The usual 0 for success and >0 for error int
@@ -84,6 +102,7 @@ namespace EventfulEngine{
 				errorLevel = EngineInit();
 			}
 		}
+		ReportStartupTrace();
 		EFPlatformTime::Init();
 		double engineInitializationTime = EFPlatformTime::ToSeconds(
 			EFPlatformTime::lastTime - EFPlatformTime::appStartTime);
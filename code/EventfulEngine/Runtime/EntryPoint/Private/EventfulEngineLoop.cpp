@@ -3,6 +3,11 @@
 #include "../Public/EventfulEngineLoop.h"
 
 #include <CoreGlobals.h>
+#include <EFIdleMonitor.h>
+#include <EFProfiling.h>
+#include <EFStartupTrace.h>
+#include <FileSystem.h>
+#include <ModuleManager.h>
 
 namespace EventfulEngine{
     int32 EventfulEngineLoop::PreInitProcessCli(
@@ -10,6 +15,27 @@ namespace EventfulEngine{
         // TODO: Encapsulate default CLI options in a free function somewhere else
         g_commandLine.AddOption<bool>("v,verbose", "Enable verbose logging",
                                       "Use -v or -verbose to enable verbose logging", "false");
+        g_commandLine.AddOption<EFString>("startup-trace", "Write a Chrome trace of the engine startup",
+                                          "Use --startup-trace=<file.json> to write the startup trace to a file");
+        g_commandLine.AddOption<double>("max-fps", "Frame rate the engine loop is paced to, 0 is unlimited",
+                                        "Use --max-fps=<fps> to change the frame rate limit", "120");
+        g_commandLine.AddOption<double>("fixed-step-hz", "Rate of fixed simulation steps, 0 disables them",
+                                        "Use --fixed-step-hz=<hz> to change the simulation rate", "60");
+        g_commandLine.AddOption<double>("idle-fps", "Highest tick rate while idle",
+                                        "Use --idle-fps=<fps> to change how often an idle engine wakes up", "10");
+        g_commandLine.AddOption<bool>("no-idle", "Keep ticking at the full frame rate while idle",
+                                      "Use --no-idle to disable idle mode, e.g. for profiling", "false");
+        g_commandLine.AddOption<bool>("no-profiling", "Disable profiling zones at run time",
+                                      "Use --no-profiling to stop recording profiler zones and allocations", "false");
+        g_commandLine.AddOption<EFString>("perf-capture", "Run a fixed number of frames and write a perf report",
+                                          "Use --perf-capture=<report.json|report.csv> to capture frame times, zones, "
+                                          "allocations and draw calls");
+        g_commandLine.AddOption<uint32>("perf-capture-frames", "Frames that go into the perf report",
+                                        "Use --perf-capture-frames=<count> to change the length of a perf capture",
+                                        "1000");
+        g_commandLine.AddOption<uint32>("perf-capture-warmup", "Frames skipped before a perf capture starts",
+                                        "Use --perf-capture-warmup=<count> to change the warmup of a perf capture",
+                                        "60");
         g_commandLine.Parse();
         return BeforeEngineInit();
     }
@@ -35,13 +61,16 @@ namespace EventfulEngine{
     }
 
     bool EventfulEngineLoop::LoadPreInitModules(){
-        // stub for loading pre-initialization modules
-        return true;
+        EF_STARTUP_TRACE_SCOPE("EngineLoop", "LoadPreInitModules");
+        // Installed modules ship their .efmoddef next to the library, which gives us the dependency edges
+        ModuleManager& moduleManager = ModuleManager::Get();
+        moduleManager.RegisterModuleDescriptors(FileSystem::GetWorkingDirectory() / "Modules");
+        return moduleManager.LoadModules(E_ModuleLoadPhase::PreInit);
     }
 
     bool EventfulEngineLoop::LoadCoreModules(){
-        // stub for loading core modules
-        return true;
+        EF_STARTUP_TRACE_SCOPE("EngineLoop", "LoadCoreModules");
+        return ModuleManager::Get().LoadModules(E_ModuleLoadPhase::Core);
     }
 
     void EventfulEngineLoop::OverrideProjectModule(const EFString& inOriginalProjectModuleName,
@@ -57,8 +86,8 @@ namespace EventfulEngine{
 
 #if WITH_ENGINE
     bool EventfulEngineLoop::LoadStartupCoreModules(){
-        // stub for loading startup core modules
-        return true;
+        EF_STARTUP_TRACE_SCOPE("EngineLoop", "LoadStartupCoreModules");
+        return ModuleManager::Get().LoadModules(E_ModuleLoadPhase::Startup);
     }
 
     bool EventfulEngineLoop::LoadStartupModules(){
@@ -76,19 +105,102 @@ namespace EventfulEngine{
 
     void EventfulEngineLoop::InitTime(){
         EFPlatformTime::Init();
+        // Calibrating up front keeps the measurement out of the first frame, which would otherwise pay for it
+        EFPlatformTime::CalibrateCycles();
+
+        // count() only sees options given on the command line, as<>() also returns the registered defaults
+        EFFramePacerSettings settings;
+        const auto& options = g_commandLine.GetOptions();
+        const bool bIsCapturing = options.count("perf-capture") > 0;
+        settings.TargetFps = options["max-fps"].as<double>();
+        if (bIsCapturing && options.count("max-fps") == 0){
+            // A perf capture measures the frames themselves, the default frame limit would hide their cost
+            settings.TargetFps = 0.0;
+        }
+        settings.FixedStepHz = options["fixed-step-hz"].as<double>();
+        _framePacer.SetSettings(settings);
+
+        _bIsIdleModeAllowed = !options["no-idle"].as<bool>();
+        EFProfiler::SetEnabled(!options["no-profiling"].as<bool>());
+        if (bIsCapturing){
+            EFPerfCaptureSettings captureSettings;
+            captureSettings.FrameCount = options["perf-capture-frames"].as<uint32>();
+            captureSettings.WarmupFrames = options["perf-capture-warmup"].as<uint32>();
+            _perfCapture.emplace(captureSettings);
+            _perfReportPath = options["perf-capture"].as<EFString>();
+            _bIsIdleModeAllowed = false;
+        }
+        if (const double idleFps = options["idle-fps"].as<double>(); idleFps > 0.0){
+            _idleTickInterval = std::chrono::duration_cast<EFDuration>(std::chrono::duration<double>(1.0 / idleFps));
+        }
     }
 
     void EventfulEngineLoop::Exit(){
+        if (const EFFramePacerStats stats = _framePacer.GetStats(); stats.FrameCount > 0){
+            char average[EFPlatformTime::DurationBufferSize];
+            char jitter[EFPlatformTime::DurationBufferSize];
+            char lateness[EFPlatformTime::DurationBufferSize];
+            const auto toDuration = [](const double seconds){
+                return std::chrono::duration_cast<EFDuration>(std::chrono::duration<double>(seconds));
+            };
+            EF_LOG(CoreLog, info, "Frame pacing over {} frames: average {}, jitter {}, max lateness {}, {} missed",
+                   stats.FrameCount,
+                   EFPlatformTime::FormatShortDuration(toDuration(stats.AverageFrameSeconds), average),
+                   EFPlatformTime::FormatShortDuration(toDuration(stats.JitterSeconds), jitter),
+                   EFPlatformTime::FormatShortDuration(toDuration(stats.MaxLatenessSeconds), lateness),
+                   stats.MissedDeadlines);
+        }
+        if (_perfCapture){
+            const EFPerfReport report = _perfCapture->BuildReport();
+            const auto metric = [&report](const std::string_view name){
+                const EFPerfReport::Metric* found = report.FindMetric(name);
+                return found ? found->Value : 0.0;
+            };
+            if (report.Save(_perfReportPath)){
+                EF_LOG(CoreLog, info, "Perf report of {} frames written to {}, frame time p50 {:.3f}ms, p99 {:.3f}ms",
+                       report.FrameCount, _perfReportPath.string(), metric("FrameTimeMs.P50"),
+                       metric("FrameTimeMs.P99"));
+            }
+            else{
+                EF_LOG(CoreLog, err, "Could not write the perf report to {}", _perfReportPath.string());
+            }
+        }
         AppPreExit();
         AppExit();
     }
 
     bool EventfulEngineLoop::ShouldUseIdleMode() const{
-        return true;
+        return _bIsIdleModeAllowed && EFIdleMonitor::ShouldIdle();
     }
 
     void EventfulEngineLoop::Tick(){
-        EFPlatformTime::StepTime();
+        _framePacer.BeginFrame();
+        // Subsystems read GetFrameTiming for their variable delta and the fixed steps of this frame
+
+        if (ShouldUseIdleMode()){
+            // Nothing needs frames, block until an OS event, a wake request or the next idle tick. Without a window
+            // the monitor waits on its condition variable, pending work or a wake request resumes full rate
+            EF_PROFILE_SCOPE("EngineLoop::Idle");
+            EFIdleMonitor::WaitForActivity(_idleTickInterval);
+            _framePacer.EndIdleFrame();
+        }
+        else{
+            EF_PROFILE_SCOPE("EngineLoop::WaitForFrame");
+            _framePacer.EndFrame();
+        }
+        EF_PROFILE_MARK_FRAME;
+
+        if (_perfCapture && !_perfCapture->IsComplete()){
+#if !EF_ENABLE_PROFILING
+            // Without a profiler backend nothing else closes the frame stats
+            EFProfiler::EndFrame();
+#endif
+            if (_perfCapture->AddFrame()){
+                RequestEngineExit();
+            }
+        }
+
+        BeginExitIfRequested();
     }
 
     void EventfulEngineLoop::ClearPendingCleanupObjects(){
@@ -109,7 +221,8 @@ namespace EventfulEngine{
     }
 
     void EventfulEngineLoop::AppExit(){
-        // stub for application exit tasks
+        // Write out everything still queued in the log rings
+        EFLogger::Shutdown();
     }
 
 } // namespace EventfulEngine
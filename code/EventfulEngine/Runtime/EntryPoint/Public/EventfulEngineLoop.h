@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../../Core/Public/CoreMinimal.h"
+#include "EFFramePacer.h"
+#include "EFPerfCapture.h"
+
+#include <optional>
 
 #ifndef WITH_ENGINE
 #define WITH_ENGINE 1
@@ -77,7 +81,11 @@ namespace EventfulEngine{
 		/** Performs shut down. */
 		void Exit();
 
-		/** Whether the engine should operate in an idle mode that uses no CPU or GPU time. */
+		/**
+		 * Whether the engine should operate in an idle mode that uses no CPU or GPU time. True while no window is
+		 * focused and visible and no work is pending, unless idling was disabled on the command line. Runs without a
+		 * window idle until work is added.
+		 */
 		[[nodiscard]] bool ShouldUseIdleMode() const;
 
 		/** Advances the main loop. */
@@ -86,6 +94,9 @@ namespace EventfulEngine{
 		/** Removes references to any objects pending cleanup by deleting them. */
 		void ClearPendingCleanupObjects() override;
 
+		/** Delta time, fixed steps and interpolation alpha of the current frame. */
+		[[nodiscard]] const EFFrameTiming& GetFrameTiming() const{ return _framePacer.GetFrameTiming(); }
+
 #endif // WITH_ENGINE
 
 		/** RHI post-init initialization */
@@ -107,6 +118,17 @@ namespace EventfulEngine{
 	 * This function called outside guarded exit code, during all exits (including error exits).
 	 */
 		static void AppExit();
+
+#if WITH_ENGINE
+	private:
+		EFFramePacer _framePacer;
+		bool _bIsIdleModeAllowed{true};
+		/** Longest time an idle tick blocks, the idle tick rate when nothing wakes the loop. */
+		EFDuration _idleTickInterval{std::chrono::milliseconds(100)};
+		/** Set by --perf-capture, runs a fixed number of frames and writes their report on exit. */
+		std::optional<EFPerfCapture> _perfCapture;
+		std::filesystem::path _perfReportPath;
+#endif // WITH_ENGINE
 	};
 
 	// Declare global engine loop
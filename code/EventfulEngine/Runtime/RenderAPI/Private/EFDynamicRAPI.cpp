@@ -4,6 +4,9 @@
 
 #include <RenderAPI.h>
 
+#include <algorithm>
+#include <bit>
+
 namespace EventfulEngine{
 
     BlendState::RenderTarget CreateAddBlendState(const E_BlendFactor srcBlend, const E_BlendFactor dstBlend){
@@ -37,31 +40,33 @@ namespace EventfulEngine{
         return constantBufferDesc;
     }
 
+    BindingLayoutDesc CreateBindingLayoutDesc(const F_ShaderType visibility, const uint32 registerSpace,
+                                              const BindingSetDesc& bindingSetDesc,
+                                              const bool registerSpaceIsDescriptorSet){
+        BindingLayoutDesc bindingLayoutDesc;
+        bindingLayoutDesc.visibility = visibility;
+        bindingLayoutDesc.registerSpace = registerSpace;
+        bindingLayoutDesc.registerSpaceIsDescriptorSet = registerSpaceIsDescriptorSet;
+        bindingLayoutDesc.bindings.reserve(bindingSetDesc.bindings.size());
+        for (auto& item : bindingSetDesc.bindings){
+            BindingLayoutItem layoutItem{};
+            layoutItem.slot = item.slot;
+            layoutItem.type = item.type;
+            layoutItem.size = 1;
+            if (item.type == E_ResourceType::PushConstants)
+                layoutItem.size = static_cast<uint16>(item.range.ByteSize);
+            bindingLayoutDesc.bindings.push_back(layoutItem);
+        }
+        return bindingLayoutDesc;
+    }
+
     bool CreateBindingSetAndLayout(const F_ShaderType visibility, const uint32 registerSpace,
                                    const BindingSetDesc& bindingSetDesc, BindingLayoutHandle& bindingLayout,
                                    BindingSetHandle& bindingSet,
                                    const bool registerSpaceIsDescriptorSet){
-        auto convertSetToLayout = [](const std::vector<BindingSetItem>& setDesc,
-                                     std::vector<BindingLayoutItem>& layoutDesc){
-            for (auto& item : setDesc){
-                BindingLayoutItem layoutItem{};
-                layoutItem.slot = item.slot;
-                layoutItem.type = item.type;
-                layoutItem.size = 1;
-                if (item.type == E_ResourceType::PushConstants)
-                    layoutItem.size = static_cast<uint16>(item.range.ByteSize);
-                layoutDesc.push_back(layoutItem);
-            }
-        };
-
         if (!bindingLayout){
-            BindingLayoutDesc bindingLayoutDesc;
-            bindingLayoutDesc.visibility = visibility;
-            bindingLayoutDesc.registerSpace = registerSpace;
-            bindingLayoutDesc.registerSpaceIsDescriptorSet = registerSpaceIsDescriptorSet;
-            convertSetToLayout(bindingSetDesc.bindings, bindingLayoutDesc.bindings);
-
-            bindingLayout = g_dynamicRAPI->CreateBindingLayout(bindingLayoutDesc);
+            bindingLayout = g_dynamicRAPI->CreateBindingLayout(
+                CreateBindingLayoutDesc(visibility, registerSpace, bindingSetDesc, registerSpaceIsDescriptorSet));
 
             if (!bindingLayout){
                 return false;
@@ -324,39 +329,100 @@ namespace EventfulEngine{
         assert(!"Invalid Enumeration Value");
     }
 
-    BitSetAllocator::BitSetAllocator(const size_t capacity,
-                                     const bool multithreaded) : b_isMultiThreaded(multithreaded){
-        _allocated.resize(capacity);
+    namespace{
+        constexpr uint64 FULL_WORD = ~0ull;
+        constexpr size_t WORD_BITS = 64;
+    }
+
+    BitSetAllocator::BitSetAllocator(const size_t capacity, bool) : _capacity(capacity){
+        // Bits past the last slot or the last word of the level below stay set, they never count as free
+        size_t count = capacity;
+        do{
+            Level level;
+            level.WordCount = std::max<size_t>((count + WORD_BITS - 1) / WORD_BITS, 1);
+            level.Words = std::make_unique<std::atomic<uint64>[]>(level.WordCount);
+            for (size_t word = 0; word < level.WordCount; ++word){
+                const size_t firstBit = word * WORD_BITS;
+                const size_t usedBits = count > firstBit ? std::min(count - firstBit, WORD_BITS) : 0;
+                level.Words[word].store(usedBits == WORD_BITS ? 0 : FULL_WORD << usedBits,
+                                        std::memory_order_relaxed);
+            }
+            count = level.WordCount;
+            _levels.push_back(std::move(level));
+        }
+        while (count > 1);
     }
 
     int BitSetAllocator::Allocate(){
-        std::unique_lock<std::mutex> lock = b_isMultiThreaded
-                                                ? std::unique_lock(_mutex)
-                                                : std::unique_lock<std::mutex>();
-
-        int result = -1;
-
-        const auto capacity = static_cast<int>(_allocated.size());
-        for (int i = 0; i < capacity; i++){
-            if (const int next = (_nextAvailable + i) % capacity; !_allocated[next]){
-                result = next;
-                _nextAvailable = (next + 1) % capacity;
-                _allocated[next] = true;
-                break;
+        const size_t topLevel = _levels.size() - 1;
+        while (true){
+            if (_levels[topLevel].Words[0].load() == FULL_WORD){
+                return -1;
             }
+
+            // The summaries are hints, a word they lead to may have filled up in the meantime
+            size_t level = topLevel;
+            size_t wordIndex = 0;
+            uint64 bits = _levels[level].Words[0].load();
+            while (level > 0 && bits != FULL_WORD){
+                wordIndex = wordIndex * WORD_BITS + std::countr_one(bits);
+                --level;
+                bits = _levels[level].Words[wordIndex].load(std::memory_order_acquire);
+            }
+            if (level > 0){
+                MarkFull(level, wordIndex);
+                continue;
+            }
+
+            std::atomic<uint64>& word = _levels[0].Words[wordIndex];
+            while (bits != FULL_WORD){
+                const int bit = std::countr_one(bits);
+                const uint64 allocated = bits | (1ull << bit);
+                if (word.compare_exchange_weak(bits, allocated, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)){
+                    if (allocated == FULL_WORD){
+                        MarkFull(0, wordIndex);
+                    }
+                    return static_cast<int>(wordIndex * WORD_BITS + bit);
+                }
+            }
+            MarkFull(0, wordIndex);
         }
+    }
 
-        return result;
+    void BitSetAllocator::MarkFull(size_t level, size_t wordIndex){
+        for (; level + 1 < _levels.size(); ++level){
+            const uint64 bit = 1ull << (wordIndex % WORD_BITS);
+            std::atomic<uint64>& summary = _levels[level + 1].Words[wordIndex / WORD_BITS];
+            const uint64 marked = summary.fetch_or(bit) | bit;
+            // A release may have cleared the word between filling it and marking it, pairs with Release()
+            if (_levels[level].Words[wordIndex].load() != FULL_WORD){
+                summary.fetch_and(~bit);
+                return;
+            }
+            if (marked != FULL_WORD){
+                return;
+            }
+            wordIndex /= WORD_BITS;
+        }
     }
 
     void BitSetAllocator::Release(const int index){
-        if (index >= 0 && index < static_cast<int>(_allocated.size())){
-            std::unique_lock<std::mutex> lock = b_isMultiThreaded
-                                                    ? std::unique_lock(_mutex)
-                                                    : std::unique_lock<std::mutex>();
+        if (index < 0 || static_cast<size_t>(index) >= _capacity){
+            return;
+        }
 
-            _allocated[index] = false;
-            _nextAvailable = std::min(_nextAvailable, index);
+        size_t wordIndex = static_cast<size_t>(index) / WORD_BITS;
+        _levels[0].Words[wordIndex].fetch_and(~(1ull << (static_cast<size_t>(index) % WORD_BITS)));
+        for (size_t level = 1; level < _levels.size(); ++level){
+            const uint64 bit = 1ull << (wordIndex % WORD_BITS);
+            wordIndex /= WORD_BITS;
+            std::atomic<uint64>& summary = _levels[level].Words[wordIndex];
+            // A summary that does not mark the word as full cannot have its own parent mark it either
+            if (!(summary.load() & bit)){
+                return;
+            }
+            summary.fetch_and(~bit);
         }
     }
 }
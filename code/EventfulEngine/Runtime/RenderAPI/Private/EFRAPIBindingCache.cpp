@@ -0,0 +1,145 @@
+#pragma once
+
+#include "EFRAPIBindingCache.h"
+
+namespace EventfulEngine{
+    EFRAPIBindingCache::EFRAPIBindingCache(EFDynamicRAPI* device, const uint32 retireAfterFrames)
+        : _device(device), _retireAfterFrames(retireAfterFrames){
+    }
+
+    BindingLayoutHandle EFRAPIBindingCache::GetBindingLayout(const BindingLayoutDesc& desc){
+        std::scoped_lock lock(_mutex);
+        if (const auto found = _layouts.find(desc); found != _layouts.end()){
+            ++_stats.LayoutHits;
+            return found->second;
+        }
+
+        BindingLayoutHandle layout = _device->CreateBindingLayout(desc);
+        if (layout){
+            _layouts.emplace(desc, layout);
+            ++_stats.LayoutCreations;
+        }
+        return layout;
+    }
+
+    BindingLayoutHandle EFRAPIBindingCache::GetBindingLayout(const F_ShaderType visibility, const uint32 registerSpace,
+                                                             const BindingSetDesc& bindingSetDesc,
+                                                             const bool registerSpaceIsDescriptorSet){
+        return GetBindingLayout(CreateBindingLayoutDesc(visibility, registerSpace, bindingSetDesc,
+                                                        registerSpaceIsDescriptorSet));
+    }
+
+    BindingSetHandle EFRAPIBindingCache::GetBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout){
+        size_t hash = std::hash<BindingSetDesc>()(desc);
+        hash_combine(hash, layout);
+
+        std::scoped_lock lock(_mutex);
+        std::vector<PooledBindingSet>& bucket = _sets[hash];
+        for (PooledBindingSet& pooled : bucket){
+            if (pooled.Set->getLayout() == layout && *pooled.Set->getDesc() == desc){
+                pooled.LastUsedFrame = _frame;
+                ++_stats.SetHits;
+                return pooled.Set;
+            }
+        }
+
+        BindingSetHandle set = _device->CreateBindingSet(desc, layout);
+        if (!set){
+            if (bucket.empty()){
+                _sets.erase(hash);
+            }
+            return nullptr;
+        }
+        bucket.push_back({set, _frame});
+        ++_setCount;
+        ++_stats.SetCreations;
+        return set;
+    }
+
+    bool EFRAPIBindingCache::GetBindingSetAndLayout(const F_ShaderType visibility, const uint32 registerSpace,
+                                                    const BindingSetDesc& bindingSetDesc,
+                                                    BindingLayoutHandle& bindingLayout, BindingSetHandle& bindingSet,
+                                                    const bool registerSpaceIsDescriptorSet){
+        if (!bindingLayout){
+            bindingLayout = GetBindingLayout(visibility, registerSpace, bindingSetDesc, registerSpaceIsDescriptorSet);
+
+            if (!bindingLayout){
+                return false;
+            }
+        }
+
+        if (!bindingSet){
+            bindingSet = GetBindingSet(bindingSetDesc, bindingLayout);
+
+            if (!bindingSet){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void EFRAPIBindingCache::EndFrame(const E_CommandQueue queue){
+        std::scoped_lock lock(_mutex);
+        EventQueryHandle query;
+        if (_freeQueries.empty()){
+            query = _device->CreateEventQuery();
+        }
+        else{
+            query = std::move(_freeQueries.back());
+            _freeQueries.pop_back();
+        }
+        _device->SetEventQuery(query, queue);
+        _pendingFrames.push_back({_frame, std::move(query)});
+        ++_frame;
+
+        while (!_pendingFrames.empty() && _device->PollEventQuery(_pendingFrames.front().Query)){
+            FrameFence& completed = _pendingFrames.front();
+            _firstIncompleteFrame = completed.Frame + 1;
+            _device->ResetEventQuery(completed.Query);
+            _freeQueries.push_back(std::move(completed.Query));
+            _pendingFrames.pop_front();
+        }
+
+        RetireBindingSets();
+    }
+
+    void EFRAPIBindingCache::RetireBindingSets(){
+        for (auto bucket = _sets.begin(); bucket != _sets.end();){
+            const size_t retired = std::erase_if(bucket->second, [this](const PooledBindingSet& pooled){
+                return pooled.LastUsedFrame < _firstIncompleteFrame &&
+                    pooled.LastUsedFrame + _retireAfterFrames < _frame;
+            });
+            _setCount -= retired;
+            _stats.SetsRetired += retired;
+            bucket = bucket->second.empty() ? _sets.erase(bucket) : std::next(bucket);
+        }
+    }
+
+    void EFRAPIBindingCache::Clear(){
+        std::scoped_lock lock(_mutex);
+        _layouts.clear();
+        _sets.clear();
+        _setCount = 0;
+    }
+
+    size_t EFRAPIBindingCache::GetBindingSetCount(){
+        std::scoped_lock lock(_mutex);
+        return _setCount;
+    }
+
+    uint64 EFRAPIBindingCache::GetFrameIndex(){
+        std::scoped_lock lock(_mutex);
+        return _frame;
+    }
+
+    BindingCacheStats EFRAPIBindingCache::GetStats(){
+        std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+
+    void EFRAPIBindingCache::ResetStats(){
+        std::scoped_lock lock(_mutex);
+        _stats = {};
+    }
+} // EventfulEngine
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "EFRAPICommandStream.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace EventfulEngine{
+    EFRAPICommandStream::EFRAPICommandStream(const size_t chunkSize) : _chunkSize(AlignCommandSize(chunkSize)){
+    }
+
+    uint8* EFRAPICommandStream::Reserve(const uint16 op, const size_t maxSize){
+        assert(!_reservedCommand);
+        const size_t required = AlignCommandSize(sizeof(CommandHeader) + maxSize);
+
+        // Move on to the next chunk with enough room, commands larger than a chunk get one of their own
+        while (_currentChunk < _chunks.size() &&
+            _chunks[_currentChunk].Capacity - _chunks[_currentChunk].Used < required){
+            ++_currentChunk;
+            if (_currentChunk < _chunks.size()){
+                _chunks[_currentChunk].Used = 0;
+            }
+        }
+        if (_currentChunk == _chunks.size()){
+            const size_t capacity = std::max(_chunkSize, required);
+            _chunks.push_back({std::make_unique_for_overwrite<uint8[]>(capacity), capacity, 0});
+            _capacity += capacity;
+        }
+
+        Chunk& chunk = _chunks[_currentChunk];
+        _reservedCommand = new(chunk.Memory.get() + chunk.Used) CommandHeader{op, 0, 0};
+        _reservedSize = maxSize;
+        return chunk.Memory.get() + chunk.Used + sizeof(CommandHeader);
+    }
+
+    void EFRAPICommandStream::Commit(const size_t size){
+        assert(_reservedCommand && size <= _reservedSize);
+        _reservedCommand->Size = static_cast<uint32>(size);
+        const size_t used = AlignCommandSize(sizeof(CommandHeader) + size);
+        _chunks[_currentChunk].Used += used;
+        _size += used;
+        ++_commandCount;
+        _reservedCommand = nullptr;
+    }
+
+    void EFRAPICommandStream::Cancel(){
+        assert(_reservedCommand);
+        _reservedCommand = nullptr;
+    }
+
+    void EFRAPICommandStream::Reset(){
+        assert(!_reservedCommand);
+        if (!_chunks.empty()){
+            _chunks.front().Used = 0;
+        }
+        _currentChunk = 0;
+        _commandCount = 0;
+        _size = 0;
+    }
+} // EventfulEngine
@@ -0,0 +1,973 @@
+#pragma once
+
+#include "EFRAPIDeferredCommandList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace EventfulEngine{
+    namespace{
+        enum class E_DeferredCommand : uint16{
+            ClearState,
+            ClearTextureFloat,
+            ClearDepthStencilTexture,
+            ClearTextureUInt,
+            CopyTexture,
+            CopyTextureToStaging,
+            CopyTextureFromStaging,
+            WriteTexture,
+            ResolveTexture,
+            WriteBuffer,
+            ClearBufferUInt,
+            CopyBuffer,
+            ClearSamplerFeedbackTexture,
+            DecodeSamplerFeedbackTexture,
+            SetSamplerFeedbackTextureState,
+            SetPushConstants,
+            SetGraphicsState,
+            Draw,
+            DrawIndexed,
+            DrawIndirect,
+            DrawIndexedIndirect,
+            SetComputeState,
+            Dispatch,
+            DispatchIndirect,
+            SetMeshletState,
+            DispatchMesh,
+            BeginTimerQuery,
+            EndTimerQuery,
+            BeginMarker,
+            EndMarker,
+            SetEnableAutomaticBarriers,
+            SetResourceStatesForBindingSet,
+            SetEnableUavBarriersForTexture,
+            SetEnableUavBarriersForBuffer,
+            BeginTrackingTextureState,
+            BeginTrackingBufferState,
+            SetTextureState,
+            SetBufferState,
+            SetPermanentTextureState,
+            SetPermanentBufferState,
+            PlaceAliasingBarrier,
+            CommitBarriers
+        };
+
+        constexpr uint16 ToOp(const E_DeferredCommand command){
+            return static_cast<uint16>(command);
+        }
+
+        // Fields of a state command that differ from the previous state, only those follow the mask in the stream
+        constexpr uint16 STATE_PIPELINE = 1 << 0;
+        constexpr uint16 STATE_FRAMEBUFFER = 1 << 1;
+        constexpr uint16 STATE_VIEWPORT = 1 << 2;
+        constexpr uint16 STATE_SHADING_RATE = 1 << 3;
+        constexpr uint16 STATE_BLEND_COLOR = 1 << 4;
+        constexpr uint16 STATE_STENCIL_REF = 1 << 5;
+        constexpr uint16 STATE_BINDINGS = 1 << 6;
+        constexpr uint16 STATE_VERTEX_BUFFERS = 1 << 7;
+        constexpr uint16 STATE_INDEX_BUFFER = 1 << 8;
+        constexpr uint16 STATE_INDIRECT_PARAMS = 1 << 9;
+
+        struct ClearTextureFloatCommand{
+            EFRAPITexture* Texture;
+            TextureSubresourceSet Subresources;
+            Color ClearColor;
+        };
+
+        struct ClearDepthStencilCommand{
+            EFRAPITexture* Texture;
+            TextureSubresourceSet Subresources;
+            float Depth;
+            bool B_ClearDepth;
+            bool B_ClearStencil;
+            uint8 Stencil;
+        };
+
+        struct ClearTextureUIntCommand{
+            EFRAPITexture* Texture;
+            TextureSubresourceSet Subresources;
+            uint32 ClearColor;
+        };
+
+        // Destination and source are textures or staging textures depending on the command
+        struct CopyTextureCommand{
+            EFRAPIResource* Dest;
+            EFRAPIResource* Src;
+            TextureSlice DestSlice;
+            TextureSlice SrcSlice;
+        };
+
+        struct WriteTextureCommand{
+            EFRAPITexture* Texture;
+            uint64 RowPitch;
+            uint64 DepthPitch;
+            uint32 ArraySlice;
+            uint32 MipLevel;
+        };
+
+        struct ResolveTextureCommand{
+            EFRAPITexture* Dest;
+            EFRAPITexture* Src;
+            TextureSubresourceSet DestSubresources;
+            TextureSubresourceSet SrcSubresources;
+        };
+
+        struct WriteBufferCommand{
+            EFRAPIBuffer* Buffer;
+            uint64 DestOffsetBytes;
+            uint64 DataSize;
+        };
+
+        struct ClearBufferUIntCommand{
+            EFRAPIBuffer* Buffer;
+            uint32 ClearValue;
+        };
+
+        struct CopyBufferCommand{
+            EFRAPIBuffer* Dest;
+            EFRAPIBuffer* Src;
+            uint64 DestOffsetBytes;
+            uint64 SrcOffsetBytes;
+            uint64 DataSizeBytes;
+        };
+
+        struct SamplerFeedbackCommand{
+            EFRAPISamplerFeedbackTexture* Texture;
+            EFRAPIBuffer* Buffer;
+            E_Format Format;
+            F_ResourceStates States;
+        };
+
+        struct PushConstantsCommand{
+            uint64 ByteSize;
+        };
+
+        struct IndirectCommand{
+            uint32 OffsetBytes;
+            uint32 DrawCount;
+        };
+
+        struct DispatchCommand{
+            uint32 GroupsX;
+            uint32 GroupsY;
+            uint32 GroupsZ;
+        };
+
+        struct ResourceCommand{
+            EFRAPIResource* Resource;
+        };
+
+        struct EnableCommand{
+            EFRAPIResource* Resource;
+            bool B_Enable;
+        };
+
+        struct TextureStateCommand{
+            EFRAPITexture* Texture;
+            TextureSubresourceSet Subresources;
+            F_ResourceStates States;
+        };
+
+        struct BufferStateCommand{
+            EFRAPIBuffer* Buffer;
+            F_ResourceStates States;
+        };
+
+        template <typename T, uint32 MaxLength>
+        bool ArraysEqual(const EFStaticArray<T, MaxLength>& a, const EFStaticArray<T, MaxLength>& b){
+            return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend());
+        }
+
+        bool ViewportsEqual(const ViewportState& a, const ViewportState& b){
+            return ArraysEqual(a.Viewports, b.Viewports) && ArraysEqual(a.ScissorRects, b.ScissorRects);
+        }
+
+        // Writes the changed fields of a state behind its mask, the records are unaligned and read with memcpy
+        class StateWriter{
+        public:
+            explicit StateWriter(uint8* memory) : _begin(memory), _cursor(memory + sizeof(uint16)){
+            }
+
+            template <typename T>
+            void Write(const uint16 field, const T& value){
+                _mask |= field;
+                std::memcpy(_cursor, &value, sizeof(T));
+                _cursor += sizeof(T);
+            }
+
+            template <typename T, uint32 MaxLength>
+            void WriteArray(const EFStaticArray<T, MaxLength>& array){
+                const auto count = static_cast<uint8>(array.size());
+                std::memcpy(_cursor, &count, sizeof(count));
+                std::memcpy(_cursor + sizeof(count), array.data(), count * sizeof(T));
+                _cursor += sizeof(count) + count * sizeof(T);
+            }
+
+            template <typename T, uint32 MaxLength>
+            void WriteArray(const uint16 field, const EFStaticArray<T, MaxLength>& array){
+                _mask |= field;
+                WriteArray(array);
+            }
+
+            void WriteViewport(const ViewportState& viewport){
+                _mask |= STATE_VIEWPORT;
+                WriteArray(viewport.Viewports);
+                WriteArray(viewport.ScissorRects);
+            }
+
+            [[nodiscard]] uint16 GetMask() const{ return _mask; }
+
+            // Stores the mask and returns the bytes written
+            size_t Finish(){
+                std::memcpy(_begin, &_mask, sizeof(_mask));
+                return static_cast<size_t>(_cursor - _begin);
+            }
+
+        private:
+            uint8* _begin;
+            uint8* _cursor;
+            uint16 _mask = 0;
+        };
+
+        class StateReader{
+        public:
+            explicit StateReader(const uint8* memory) : _cursor(memory + sizeof(uint16)){
+                std::memcpy(&_mask, memory, sizeof(_mask));
+            }
+
+            [[nodiscard]] bool Has(const uint16 field) const{ return (_mask & field) != 0; }
+
+            template <typename T>
+            void Read(const uint16 field, T& value){
+                if (Has(field)){
+                    std::memcpy(&value, _cursor, sizeof(T));
+                    _cursor += sizeof(T);
+                }
+            }
+
+            template <typename T, uint32 MaxLength>
+            void ReadArray(EFStaticArray<T, MaxLength>& array){
+                uint8 count = 0;
+                std::memcpy(&count, _cursor, sizeof(count));
+                array.resize(count);
+                std::memcpy(array.data(), _cursor + sizeof(count), count * sizeof(T));
+                _cursor += sizeof(count) + count * sizeof(T);
+            }
+
+            template <typename T, uint32 MaxLength>
+            void ReadArray(const uint16 field, EFStaticArray<T, MaxLength>& array){
+                if (Has(field)){
+                    ReadArray(array);
+                }
+            }
+
+            void ReadViewport(ViewportState& viewport){
+                if (Has(STATE_VIEWPORT)){
+                    ReadArray(viewport.Viewports);
+                    ReadArray(viewport.ScissorRects);
+                }
+            }
+
+        private:
+            const uint8* _cursor;
+            uint16 _mask = 0;
+        };
+
+        // Room for a mask and every field of the state, the arrays are never larger than their static storage
+        template <typename State>
+        constexpr size_t MAX_STATE_SIZE = sizeof(uint16) + sizeof(State);
+
+        // Bytes read by a texture upload of the given pitches, so the deferred list can copy exactly that much
+        size_t GetTextureUploadSize(const TextureDesc& desc, const uint32 mipLevel, const size_t rowPitch,
+                                    const size_t depthPitch){
+            const FormatInfo& formatInfo = GetFormatInfo(desc.Format);
+            const uint32 blockSize = std::max<uint32>(formatInfo.blockSize, 1);
+            const uint32 width = std::max(desc.Width >> mipLevel, 1u);
+            const uint32 height = std::max(desc.Height >> mipLevel, 1u);
+            const uint32 depth = desc.Dimension == E_TextureDimension::Texture3D
+                                     ? std::max(desc.Depth >> mipLevel, 1u)
+                                     : 1;
+
+            const size_t rowCount = (height + blockSize - 1) / blockSize;
+            const size_t rowBytes = static_cast<size_t>((width + blockSize - 1) / blockSize) * formatInfo.bytesPerBlock;
+            const size_t sliceSize = rowPitch * (rowCount - 1) + std::min(rowPitch, rowBytes);
+            const size_t slicePitch = depthPitch != 0 ? depthPitch : rowPitch * rowCount;
+            return slicePitch * (depth - 1) + sliceSize;
+        }
+
+        template <typename T>
+        const T& As(const uint8* data){
+            return *reinterpret_cast<const T*>(data);
+        }
+    }
+
+    EFRAPIDeferredCommandList::EFRAPIDeferredCommandList(EFDynamicRAPI* device, const CommandListParameters& params)
+        // Chunks much smaller than a state record would end up holding a single state each
+        : _device(device), _desc(params),
+          _stream(std::max(params.uploadChunkSize, EFRAPICommandStream::DEFAULT_CHUNK_SIZE)){
+        assert(!params.enableImmediateExecution);
+    }
+
+    EFRAPIDeferredCommandList* EFRAPIDeferredCommandList::FromCommandList(EFRAPICommandList* commandList){
+        if (!commandList || commandList->GetDesc().enableImmediateExecution){
+            return nullptr;
+        }
+        return static_cast<EFRAPIDeferredCommandList*>(commandList);
+    }
+
+    template <typename T>
+    T& EFRAPIDeferredCommandList::Record(const uint16 op){
+        assert(_bIsOpen);
+        _boundState = E_BoundState::None;
+        return _stream.Push<T>(op);
+    }
+
+    template <typename T>
+    T& EFRAPIDeferredCommandList::Record(const uint16 op, const size_t payloadSize, uint8*& payload){
+        assert(_bIsOpen);
+        _boundState = E_BoundState::None;
+        return _stream.Push<T>(op, payloadSize, payload);
+    }
+
+    void EFRAPIDeferredCommandList::Reference(EFRAPIResource* resource){
+        if (resource){
+            _referencedResources.emplace_back(resource);
+        }
+    }
+
+    void EFRAPIDeferredCommandList::Open(){
+        assert(!_bIsOpen);
+        _stream.Reset();
+        _referencedResources.clear();
+        _recordingStats = {};
+        _graphicsState = {};
+        _computeState = {};
+        _meshletState = {};
+        _boundState = E_BoundState::None;
+        _bIsOpen = true;
+    }
+
+    void EFRAPIDeferredCommandList::Close(){
+        assert(_bIsOpen);
+        _bIsOpen = false;
+    }
+
+    void EFRAPIDeferredCommandList::ClearState(){
+        _graphicsState = {};
+        _computeState = {};
+        _meshletState = {};
+        Record<uint8>(ToOp(E_DeferredCommand::ClearState));
+    }
+
+    void EFRAPIDeferredCommandList::ClearTextureFloat(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                                      const Color& clearColor){
+        Reference(t);
+        Record<ClearTextureFloatCommand>(ToOp(E_DeferredCommand::ClearTextureFloat)) = {t, subresources, clearColor};
+    }
+
+    void EFRAPIDeferredCommandList::ClearDepthStencilTexture(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                                             const bool clearDepth, const float depth,
+                                                             const bool clearStencil, const uint8_t stencil){
+        Reference(t);
+        Record<ClearDepthStencilCommand>(ToOp(E_DeferredCommand::ClearDepthStencilTexture)) = {
+            t, subresources, depth, clearDepth, clearStencil, stencil
+        };
+    }
+
+    void EFRAPIDeferredCommandList::ClearTextureUInt(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                                     const uint32_t clearColor){
+        Reference(t);
+        Record<ClearTextureUIntCommand>(ToOp(E_DeferredCommand::ClearTextureUInt)) = {t, subresources, clearColor};
+    }
+
+    void EFRAPIDeferredCommandList::CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                                                const TextureSlice& srcSlice){
+        Reference(dest);
+        Reference(src);
+        Record<CopyTextureCommand>(ToOp(E_DeferredCommand::CopyTexture)) = {dest, src, destSlice, srcSlice};
+    }
+
+    void EFRAPIDeferredCommandList::CopyTexture(EFRAPIStagingTexture* dest, const TextureSlice& destSlice,
+                                                EFRAPITexture* src, const TextureSlice& srcSlice){
+        Reference(dest);
+        Reference(src);
+        Record<CopyTextureCommand>(ToOp(E_DeferredCommand::CopyTextureToStaging)) = {dest, src, destSlice, srcSlice};
+    }
+
+    void EFRAPIDeferredCommandList::CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice,
+                                                EFRAPIStagingTexture* src, const TextureSlice& srcSlice){
+        Reference(dest);
+        Reference(src);
+        Record<CopyTextureCommand>(ToOp(E_DeferredCommand::CopyTextureFromStaging)) = {
+            dest, src, destSlice, srcSlice
+        };
+    }
+
+    void EFRAPIDeferredCommandList::WriteTexture(EFRAPITexture* dest, const uint32_t arraySlice,
+                                                 const uint32_t mipLevel, const void* data, const size_t rowPitch,
+                                                 const size_t depthPitch){
+        // The caller may free its data right away, it is copied into the stream
+        const size_t dataSize = GetTextureUploadSize(dest->GetDesc(), mipLevel, rowPitch, depthPitch);
+        Reference(dest);
+        uint8* payload = nullptr;
+        Record<WriteTextureCommand>(ToOp(E_DeferredCommand::WriteTexture), dataSize, payload) = {
+            dest, rowPitch, depthPitch, arraySlice, mipLevel
+        };
+        std::memcpy(payload, data, dataSize);
+    }
+
+    void EFRAPIDeferredCommandList::ResolveTexture(EFRAPITexture* dest, const TextureSubresourceSet& dstSubresources,
+                                                   EFRAPITexture* src, const TextureSubresourceSet& srcSubresources){
+        Reference(dest);
+        Reference(src);
+        Record<ResolveTextureCommand>(ToOp(E_DeferredCommand::ResolveTexture)) = {
+            dest, src, dstSubresources, srcSubresources
+        };
+    }
+
+    void EFRAPIDeferredCommandList::WriteBuffer(EFRAPIBuffer* b, const void* data, const size_t dataSize,
+                                                const uint64_t destOffsetBytes){
+        Reference(b);
+        uint8* payload = nullptr;
+        Record<WriteBufferCommand>(ToOp(E_DeferredCommand::WriteBuffer), dataSize, payload) = {
+            b, destOffsetBytes, dataSize
+        };
+        std::memcpy(payload, data, dataSize);
+    }
+
+    void EFRAPIDeferredCommandList::ClearBufferUInt(EFRAPIBuffer* b, const uint32_t clearValue){
+        Reference(b);
+        Record<ClearBufferUIntCommand>(ToOp(E_DeferredCommand::ClearBufferUInt)) = {b, clearValue};
+    }
+
+    void EFRAPIDeferredCommandList::CopyBuffer(EFRAPIBuffer* dest, const uint64_t destOffsetBytes, EFRAPIBuffer* src,
+                                               const uint64_t srcOffsetBytes, const uint64_t dataSizeBytes){
+        Reference(dest);
+        Reference(src);
+        Record<CopyBufferCommand>(ToOp(E_DeferredCommand::CopyBuffer)) = {
+            dest, src, destOffsetBytes, srcOffsetBytes, dataSizeBytes
+        };
+    }
+
+    void EFRAPIDeferredCommandList::ClearSamplerFeedbackTexture(EFRAPISamplerFeedbackTexture* texture){
+        Reference(texture);
+        Record<SamplerFeedbackCommand>(ToOp(E_DeferredCommand::ClearSamplerFeedbackTexture)).Texture = texture;
+    }
+
+    void EFRAPIDeferredCommandList::DecodeSamplerFeedbackTexture(EFRAPIBuffer* buffer,
+                                                                 EFRAPISamplerFeedbackTexture* texture,
+                                                                 const E_Format format){
+        Reference(buffer);
+        Reference(texture);
+        Record<SamplerFeedbackCommand>(ToOp(E_DeferredCommand::DecodeSamplerFeedbackTexture)) = {
+            texture, buffer, format, F_ResourceStates::Unknown
+        };
+    }
+
+    void EFRAPIDeferredCommandList::SetSamplerFeedbackTextureState(EFRAPISamplerFeedbackTexture* texture,
+                                                                   const F_ResourceStates stateBits){
+        Reference(texture);
+        Record<SamplerFeedbackCommand>(ToOp(E_DeferredCommand::SetSamplerFeedbackTextureState)) = {
+            texture, nullptr, E_Format::UNKNOWN, stateBits
+        };
+    }
+
+    void EFRAPIDeferredCommandList::SetPushConstants(const void* data, const size_t byteSize){
+        // Push constants do not change the bound state, they usually sit between the draws of one state
+        uint8* payload = nullptr;
+        _stream.Push<PushConstantsCommand>(ToOp(E_DeferredCommand::SetPushConstants), byteSize, payload).ByteSize =
+            byteSize;
+        std::memcpy(payload, data, byteSize);
+    }
+
+    void EFRAPIDeferredCommandList::SetGraphicsState(const GraphicsState& state){
+        assert(_bIsOpen);
+        uint8* memory = _stream.Reserve(ToOp(E_DeferredCommand::SetGraphicsState), MAX_STATE_SIZE<GraphicsState>);
+        StateWriter writer(memory);
+        if (state.Pipeline != _graphicsState.Pipeline){
+            writer.Write(STATE_PIPELINE, state.Pipeline);
+            Reference(state.Pipeline);
+        }
+        if (state.Framebuffer != _graphicsState.Framebuffer){
+            writer.Write(STATE_FRAMEBUFFER, state.Framebuffer);
+            Reference(state.Framebuffer);
+        }
+        if (!ViewportsEqual(state.Viewport, _graphicsState.Viewport)){
+            writer.WriteViewport(state.Viewport);
+        }
+        if (!(state.ShadingRateState == _graphicsState.ShadingRateState)){
+            writer.Write(STATE_SHADING_RATE, state.ShadingRateState);
+        }
+        if (!(state.BlendConstantColor == _graphicsState.BlendConstantColor)){
+            writer.Write(STATE_BLEND_COLOR, state.BlendConstantColor);
+        }
+        if (state.DynamicStencilRefValue != _graphicsState.DynamicStencilRefValue){
+            writer.Write(STATE_STENCIL_REF, state.DynamicStencilRefValue);
+        }
+        if (!ArraysEqual(state.Bindings, _graphicsState.Bindings)){
+            writer.WriteArray(STATE_BINDINGS, state.Bindings);
+            for (EFRAPIBindingSet* bindingSet : state.Bindings){
+                Reference(bindingSet);
+            }
+        }
+        if (!ArraysEqual(state.VertexBuffers, _graphicsState.VertexBuffers)){
+            writer.WriteArray(STATE_VERTEX_BUFFERS, state.VertexBuffers);
+            for (const VertexBufferBinding& binding : state.VertexBuffers){
+                Reference(binding.Buffer);
+            }
+        }
+        if (!(state.IndexBuffer == _graphicsState.IndexBuffer)){
+            writer.Write(STATE_INDEX_BUFFER, state.IndexBuffer);
+            Reference(state.IndexBuffer.Buffer);
+        }
+        if (state.IndirectParams != _graphicsState.IndirectParams){
+            writer.Write(STATE_INDIRECT_PARAMS, state.IndirectParams);
+            Reference(state.IndirectParams);
+        }
+
+        // An unchanged state right after draws of the same state is dropped, otherwise it is set again to commit
+        // the barriers recorded since
+        if (writer.GetMask() == 0 && _boundState == E_BoundState::Graphics){
+            _stream.Cancel();
+            return;
+        }
+        _stream.Commit(writer.Finish());
+        _graphicsState = state;
+        _boundState = E_BoundState::Graphics;
+    }
+
+    void EFRAPIDeferredCommandList::Draw(const DrawArguments& args){
+        assert(_bIsOpen);
+        _stream.Push<DrawArguments>(ToOp(E_DeferredCommand::Draw)) = args;
+        ++_recordingStats.DrawCalls;
+    }
+
+    void EFRAPIDeferredCommandList::DrawIndexed(const DrawArguments& args){
+        assert(_bIsOpen);
+        _stream.Push<DrawArguments>(ToOp(E_DeferredCommand::DrawIndexed)) = args;
+        ++_recordingStats.DrawCalls;
+    }
+
+    void EFRAPIDeferredCommandList::DrawIndirect(const uint32_t offsetBytes, const uint32_t drawCount){
+        assert(_bIsOpen);
+        _stream.Push<IndirectCommand>(ToOp(E_DeferredCommand::DrawIndirect)) = {offsetBytes, drawCount};
+        _recordingStats.DrawCalls += drawCount;
+    }
+
+    void EFRAPIDeferredCommandList::DrawIndexedIndirect(const uint32_t offsetBytes, const uint32_t drawCount){
+        assert(_bIsOpen);
+        _stream.Push<IndirectCommand>(ToOp(E_DeferredCommand::DrawIndexedIndirect)) = {offsetBytes, drawCount};
+        _recordingStats.DrawCalls += drawCount;
+    }
+
+    void EFRAPIDeferredCommandList::SetComputeState(const ComputeState& state){
+        assert(_bIsOpen);
+        uint8* memory = _stream.Reserve(ToOp(E_DeferredCommand::SetComputeState), MAX_STATE_SIZE<ComputeState>);
+        StateWriter writer(memory);
+        if (state.pipeline != _computeState.pipeline){
+            writer.Write(STATE_PIPELINE, state.pipeline);
+            Reference(state.pipeline);
+        }
+        if (!ArraysEqual(state.bindings, _computeState.bindings)){
+            writer.WriteArray(STATE_BINDINGS, state.bindings);
+            for (EFRAPIBindingSet* bindingSet : state.bindings){
+                Reference(bindingSet);
+            }
+        }
+        if (state.indirectParams != _computeState.indirectParams){
+            writer.Write(STATE_INDIRECT_PARAMS, state.indirectParams);
+            Reference(state.indirectParams);
+        }
+
+        if (writer.GetMask() == 0 && _boundState == E_BoundState::Compute){
+            _stream.Cancel();
+            return;
+        }
+        _stream.Commit(writer.Finish());
+        _computeState = state;
+        _boundState = E_BoundState::Compute;
+    }
+
+    void EFRAPIDeferredCommandList::Dispatch(const uint32_t groupsX, const uint32_t groupsY, const uint32_t groupsZ){
+        assert(_bIsOpen);
+        _stream.Push<DispatchCommand>(ToOp(E_DeferredCommand::Dispatch)) = {groupsX, groupsY, groupsZ};
+        ++_recordingStats.Dispatches;
+    }
+
+    void EFRAPIDeferredCommandList::DispatchIndirect(const uint32_t offsetBytes){
+        assert(_bIsOpen);
+        _stream.Push<IndirectCommand>(ToOp(E_DeferredCommand::DispatchIndirect)) = {offsetBytes, 1};
+        ++_recordingStats.Dispatches;
+    }
+
+    void EFRAPIDeferredCommandList::SetMeshletState(const MeshletState& state){
+        assert(_bIsOpen);
+        uint8* memory = _stream.Reserve(ToOp(E_DeferredCommand::SetMeshletState), MAX_STATE_SIZE<MeshletState>);
+        StateWriter writer(memory);
+        if (state.pipeline != _meshletState.pipeline){
+            writer.Write(STATE_PIPELINE, state.pipeline);
+            Reference(state.pipeline);
+        }
+        if (state.framebuffer != _meshletState.framebuffer){
+            writer.Write(STATE_FRAMEBUFFER, state.framebuffer);
+            Reference(state.framebuffer);
+        }
+        if (!ViewportsEqual(state.viewport, _meshletState.viewport)){
+            writer.WriteViewport(state.viewport);
+        }
+        if (!(state.blendConstantColor == _meshletState.blendConstantColor)){
+            writer.Write(STATE_BLEND_COLOR, state.blendConstantColor);
+        }
+        if (state.dynamicStencilRefValue != _meshletState.dynamicStencilRefValue){
+            writer.Write(STATE_STENCIL_REF, state.dynamicStencilRefValue);
+        }
+        if (!ArraysEqual(state.bindings, _meshletState.bindings)){
+            writer.WriteArray(STATE_BINDINGS, state.bindings);
+            for (EFRAPIBindingSet* bindingSet : state.bindings){
+                Reference(bindingSet);
+            }
+        }
+        if (state.indirectParams != _meshletState.indirectParams){
+            writer.Write(STATE_INDIRECT_PARAMS, state.indirectParams);
+            Reference(state.indirectParams);
+        }
+
+        if (writer.GetMask() == 0 && _boundState == E_BoundState::Meshlet){
+            _stream.Cancel();
+            return;
+        }
+        _stream.Commit(writer.Finish());
+        _meshletState = state;
+        _boundState = E_BoundState::Meshlet;
+    }
+
+    void EFRAPIDeferredCommandList::DispatchMesh(const uint32_t groupsX, const uint32_t groupsY,
+                                                 const uint32_t groupsZ){
+        assert(_bIsOpen);
+        _stream.Push<DispatchCommand>(ToOp(E_DeferredCommand::DispatchMesh)) = {groupsX, groupsY, groupsZ};
+        ++_recordingStats.DrawCalls;
+    }
+
+    void EFRAPIDeferredCommandList::BeginTimerQuery(EFRAPITimerQuery* query){
+        Reference(query);
+        Record<ResourceCommand>(ToOp(E_DeferredCommand::BeginTimerQuery)).Resource = query;
+    }
+
+    void EFRAPIDeferredCommandList::EndTimerQuery(EFRAPITimerQuery* query){
+        Reference(query);
+        Record<ResourceCommand>(ToOp(E_DeferredCommand::EndTimerQuery)).Resource = query;
+    }
+
+    void EFRAPIDeferredCommandList::BeginMarker(const char* name){
+        const size_t length = std::strlen(name) + 1;
+        uint8* payload = nullptr;
+        Record<uint8>(ToOp(E_DeferredCommand::BeginMarker), length, payload);
+        std::memcpy(payload, name, length);
+    }
+
+    void EFRAPIDeferredCommandList::EndMarker(){
+        Record<uint8>(ToOp(E_DeferredCommand::EndMarker));
+    }
+
+    void EFRAPIDeferredCommandList::SetEnableAutomaticBarriers(const bool enable){
+        Record<EnableCommand>(ToOp(E_DeferredCommand::SetEnableAutomaticBarriers)) = {nullptr, enable};
+    }
+
+    void EFRAPIDeferredCommandList::SetResourceStatesForBindingSet(EFRAPIBindingSet* bindingSet){
+        Reference(bindingSet);
+        Record<ResourceCommand>(ToOp(E_DeferredCommand::SetResourceStatesForBindingSet)).Resource = bindingSet;
+    }
+
+    void EFRAPIDeferredCommandList::SetEnableUavBarriersForTexture(EFRAPITexture* texture, const bool enableBarriers){
+        Reference(texture);
+        Record<EnableCommand>(ToOp(E_DeferredCommand::SetEnableUavBarriersForTexture)) = {texture, enableBarriers};
+    }
+
+    void EFRAPIDeferredCommandList::SetEnableUavBarriersForBuffer(EFRAPIBuffer* buffer, const bool enableBarriers){
+        Reference(buffer);
+        Record<EnableCommand>(ToOp(E_DeferredCommand::SetEnableUavBarriersForBuffer)) = {buffer, enableBarriers};
+    }
+
+    void EFRAPIDeferredCommandList::BeginTrackingTextureState(EFRAPITexture* texture,
+                                                              const TextureSubresourceSet subresources,
+                                                              const F_ResourceStates stateBits){
+        Reference(texture);
+        Record<TextureStateCommand>(ToOp(E_DeferredCommand::BeginTrackingTextureState)) = {
+            texture, subresources, stateBits
+        };
+    }
+
+    void EFRAPIDeferredCommandList::BeginTrackingBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        Record<BufferStateCommand>(ToOp(E_DeferredCommand::BeginTrackingBufferState)) = {buffer, stateBits};
+    }
+
+    void EFRAPIDeferredCommandList::SetTextureState(EFRAPITexture* texture, const TextureSubresourceSet subresources,
+                                                    const F_ResourceStates stateBits){
+        Reference(texture);
+        Record<TextureStateCommand>(ToOp(E_DeferredCommand::SetTextureState)) = {texture, subresources, stateBits};
+    }
+
+    void EFRAPIDeferredCommandList::SetBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        Record<BufferStateCommand>(ToOp(E_DeferredCommand::SetBufferState)) = {buffer, stateBits};
+    }
+
+    void EFRAPIDeferredCommandList::SetPermanentTextureState(EFRAPITexture* texture, const F_ResourceStates stateBits){
+        Reference(texture);
+        Record<TextureStateCommand>(ToOp(E_DeferredCommand::SetPermanentTextureState)) = {
+            texture, AllSubresources, stateBits
+        };
+    }
+
+    void EFRAPIDeferredCommandList::SetPermanentBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        Record<BufferStateCommand>(ToOp(E_DeferredCommand::SetPermanentBufferState)) = {buffer, stateBits};
+    }
+
+    void EFRAPIDeferredCommandList::PlaceAliasingBarrier(EFRAPIResource* resource){
+        Reference(resource);
+        Record<ResourceCommand>(ToOp(E_DeferredCommand::PlaceAliasingBarrier)).Resource = resource;
+    }
+
+    void EFRAPIDeferredCommandList::CommitBarriers(){
+        Record<uint8>(ToOp(E_DeferredCommand::CommitBarriers));
+    }
+
+    F_ResourceStates EFRAPIDeferredCommandList::GetTextureSubresourceState(EFRAPITexture*, ArraySlice, MipLevel){
+        return F_ResourceStates::Unknown;
+    }
+
+    F_ResourceStates EFRAPIDeferredCommandList::GetBufferState(EFRAPIBuffer*){
+        return F_ResourceStates::Unknown;
+    }
+
+    void EFRAPIDeferredCommandList::Replay(EFRAPICommandList* target) const{
+        assert(!_bIsOpen);
+        GraphicsState graphicsState;
+        ComputeState computeState;
+        MeshletState meshletState;
+
+        _stream.ForEach([&](const uint16 op, const uint8* data, size_t){
+            switch (static_cast<E_DeferredCommand>(op)){
+                using enum E_DeferredCommand;
+            case ClearState:
+                graphicsState = {};
+                computeState = {};
+                meshletState = {};
+                target->ClearState();
+                break;
+            case ClearTextureFloat:{
+                const auto& command = As<ClearTextureFloatCommand>(data);
+                target->ClearTextureFloat(command.Texture, command.Subresources, command.ClearColor);
+                break;
+            }
+            case ClearDepthStencilTexture:{
+                const auto& command = As<ClearDepthStencilCommand>(data);
+                target->ClearDepthStencilTexture(command.Texture, command.Subresources, command.B_ClearDepth,
+                                                 command.Depth, command.B_ClearStencil, command.Stencil);
+                break;
+            }
+            case ClearTextureUInt:{
+                const auto& command = As<ClearTextureUIntCommand>(data);
+                target->ClearTextureUInt(command.Texture, command.Subresources, command.ClearColor);
+                break;
+            }
+            case CopyTexture:{
+                const auto& command = As<CopyTextureCommand>(data);
+                target->CopyTexture(static_cast<EFRAPITexture*>(command.Dest), command.DestSlice,
+                                    static_cast<EFRAPITexture*>(command.Src), command.SrcSlice);
+                break;
+            }
+            case CopyTextureToStaging:{
+                const auto& command = As<CopyTextureCommand>(data);
+                target->CopyTexture(static_cast<EFRAPIStagingTexture*>(command.Dest), command.DestSlice,
+                                    static_cast<EFRAPITexture*>(command.Src), command.SrcSlice);
+                break;
+            }
+            case CopyTextureFromStaging:{
+                const auto& command = As<CopyTextureCommand>(data);
+                target->CopyTexture(static_cast<EFRAPITexture*>(command.Dest), command.DestSlice,
+                                    static_cast<EFRAPIStagingTexture*>(command.Src), command.SrcSlice);
+                break;
+            }
+            case WriteTexture:{
+                const auto& command = As<WriteTextureCommand>(data);
+                target->WriteTexture(command.Texture, command.ArraySlice, command.MipLevel,
+                                     data + sizeof(WriteTextureCommand), command.RowPitch, command.DepthPitch);
+                break;
+            }
+            case ResolveTexture:{
+                const auto& command = As<ResolveTextureCommand>(data);
+                target->ResolveTexture(command.Dest, command.DestSubresources, command.Src, command.SrcSubresources);
+                break;
+            }
+            case WriteBuffer:{
+                const auto& command = As<WriteBufferCommand>(data);
+                target->WriteBuffer(command.Buffer, data + sizeof(WriteBufferCommand), command.DataSize,
+                                    command.DestOffsetBytes);
+                break;
+            }
+            case ClearBufferUInt:{
+                const auto& command = As<ClearBufferUIntCommand>(data);
+                target->ClearBufferUInt(command.Buffer, command.ClearValue);
+                break;
+            }
+            case CopyBuffer:{
+                const auto& command = As<CopyBufferCommand>(data);
+                target->CopyBuffer(command.Dest, command.DestOffsetBytes, command.Src, command.SrcOffsetBytes,
+                                   command.DataSizeBytes);
+                break;
+            }
+            case ClearSamplerFeedbackTexture:
+                target->ClearSamplerFeedbackTexture(As<SamplerFeedbackCommand>(data).Texture);
+                break;
+            case DecodeSamplerFeedbackTexture:{
+                const auto& command = As<SamplerFeedbackCommand>(data);
+                target->DecodeSamplerFeedbackTexture(command.Buffer, command.Texture, command.Format);
+                break;
+            }
+            case SetSamplerFeedbackTextureState:{
+                const auto& command = As<SamplerFeedbackCommand>(data);
+                target->SetSamplerFeedbackTextureState(command.Texture, command.States);
+                break;
+            }
+            case SetPushConstants:
+                target->SetPushConstants(data + sizeof(PushConstantsCommand),
+                                         As<PushConstantsCommand>(data).ByteSize);
+                break;
+            case SetGraphicsState:{
+                StateReader reader(data);
+                reader.Read(STATE_PIPELINE, graphicsState.Pipeline);
+                reader.Read(STATE_FRAMEBUFFER, graphicsState.Framebuffer);
+                reader.ReadViewport(graphicsState.Viewport);
+                reader.Read(STATE_SHADING_RATE, graphicsState.ShadingRateState);
+                reader.Read(STATE_BLEND_COLOR, graphicsState.BlendConstantColor);
+                reader.Read(STATE_STENCIL_REF, graphicsState.DynamicStencilRefValue);
+                reader.ReadArray(STATE_BINDINGS, graphicsState.Bindings);
+                reader.ReadArray(STATE_VERTEX_BUFFERS, graphicsState.VertexBuffers);
+                reader.Read(STATE_INDEX_BUFFER, graphicsState.IndexBuffer);
+                reader.Read(STATE_INDIRECT_PARAMS, graphicsState.IndirectParams);
+                target->SetGraphicsState(graphicsState);
+                break;
+            }
+            case Draw:
+                target->Draw(As<DrawArguments>(data));
+                break;
+            case DrawIndexed:
+                target->DrawIndexed(As<DrawArguments>(data));
+                break;
+            case DrawIndirect:{
+                const auto& command = As<IndirectCommand>(data);
+                target->DrawIndirect(command.OffsetBytes, command.DrawCount);
+                break;
+            }
+            case DrawIndexedIndirect:{
+                const auto& command = As<IndirectCommand>(data);
+                target->DrawIndexedIndirect(command.OffsetBytes, command.DrawCount);
+                break;
+            }
+            case SetComputeState:{
+                StateReader reader(data);
+                reader.Read(STATE_PIPELINE, computeState.pipeline);
+                reader.ReadArray(STATE_BINDINGS, computeState.bindings);
+                reader.Read(STATE_INDIRECT_PARAMS, computeState.indirectParams);
+                target->SetComputeState(computeState);
+                break;
+            }
+            case Dispatch:{
+                const auto& command = As<DispatchCommand>(data);
+                target->Dispatch(command.GroupsX, command.GroupsY, command.GroupsZ);
+                break;
+            }
+            case DispatchIndirect:
+                target->DispatchIndirect(As<IndirectCommand>(data).OffsetBytes);
+                break;
+            case SetMeshletState:{
+                StateReader reader(data);
+                reader.Read(STATE_PIPELINE, meshletState.pipeline);
+                reader.Read(STATE_FRAMEBUFFER, meshletState.framebuffer);
+                reader.ReadViewport(meshletState.viewport);
+                reader.Read(STATE_BLEND_COLOR, meshletState.blendConstantColor);
+                reader.Read(STATE_STENCIL_REF, meshletState.dynamicStencilRefValue);
+                reader.ReadArray(STATE_BINDINGS, meshletState.bindings);
+                reader.Read(STATE_INDIRECT_PARAMS, meshletState.indirectParams);
+                target->SetMeshletState(meshletState);
+                break;
+            }
+            case DispatchMesh:{
+                const auto& command = As<DispatchCommand>(data);
+                target->DispatchMesh(command.GroupsX, command.GroupsY, command.GroupsZ);
+                break;
+            }
+            case BeginTimerQuery:
+                target->BeginTimerQuery(static_cast<EFRAPITimerQuery*>(As<ResourceCommand>(data).Resource));
+                break;
+            case EndTimerQuery:
+                target->EndTimerQuery(static_cast<EFRAPITimerQuery*>(As<ResourceCommand>(data).Resource));
+                break;
+            case BeginMarker:
+                target->BeginMarker(reinterpret_cast<const char*>(data + sizeof(uint8)));
+                break;
+            case EndMarker:
+                target->EndMarker();
+                break;
+            case SetEnableAutomaticBarriers:
+                target->SetEnableAutomaticBarriers(As<EnableCommand>(data).B_Enable);
+                break;
+            case SetResourceStatesForBindingSet:
+                target->SetResourceStatesForBindingSet(
+                    static_cast<EFRAPIBindingSet*>(As<ResourceCommand>(data).Resource));
+                break;
+            case SetEnableUavBarriersForTexture:{
+                const auto& command = As<EnableCommand>(data);
+                target->SetEnableUavBarriersForTexture(static_cast<EFRAPITexture*>(command.Resource),
+                                                       command.B_Enable);
+                break;
+            }
+            case SetEnableUavBarriersForBuffer:{
+                const auto& command = As<EnableCommand>(data);
+                target->SetEnableUavBarriersForBuffer(static_cast<EFRAPIBuffer*>(command.Resource), command.B_Enable);
+                break;
+            }
+            case BeginTrackingTextureState:{
+                const auto& command = As<TextureStateCommand>(data);
+                target->BeginTrackingTextureState(command.Texture, command.Subresources, command.States);
+                break;
+            }
+            case BeginTrackingBufferState:{
+                const auto& command = As<BufferStateCommand>(data);
+                target->BeginTrackingBufferState(command.Buffer, command.States);
+                break;
+            }
+            case SetTextureState:{
+                const auto& command = As<TextureStateCommand>(data);
+                target->SetTextureState(command.Texture, command.Subresources, command.States);
+                break;
+            }
+            case SetBufferState:{
+                const auto& command = As<BufferStateCommand>(data);
+                target->SetBufferState(command.Buffer, command.States);
+                break;
+            }
+            case SetPermanentTextureState:{
+                const auto& command = As<TextureStateCommand>(data);
+                target->SetPermanentTextureState(command.Texture, command.States);
+                break;
+            }
+            case SetPermanentBufferState:{
+                const auto& command = As<BufferStateCommand>(data);
+                target->SetPermanentBufferState(command.Buffer, command.States);
+                break;
+            }
+            case PlaceAliasingBarrier:
+                target->PlaceAliasingBarrier(As<ResourceCommand>(data).Resource);
+                break;
+            case CommitBarriers:
+                target->CommitBarriers();
+                break;
+            }
+        });
+    }
+} // EventfulEngine
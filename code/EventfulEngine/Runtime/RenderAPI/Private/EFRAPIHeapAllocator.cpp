@@ -0,0 +1,442 @@
+#pragma once
+
+#include "EFRAPIHeapAllocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint64 AlignUp(const uint64 value, const uint64 alignment){
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    EFRAPIHeapAllocator::EFRAPIHeapAllocator(EFDynamicRAPI* device, const HeapType type, const uint64 blockSize)
+        : _device(device), _type(type), _blockSize(AlignUp(std::max<uint64>(blockSize, 1), 1ull << GRANULARITY_SHIFT)){
+        std::fill_n(&_freeHeads[0][0], FL_COUNT * SL_COUNT, INVALID_NODE);
+    }
+
+    HeapAllocation EFRAPIHeapAllocator::Allocate(const MemoryRequirements& requirements, void* userData){
+        assert(requirements.alignment == 0 || std::has_single_bit(requirements.alignment));
+        const uint64 size = AlignUp(std::max<uint64>(requirements.size, 1), 1ull << GRANULARITY_SHIFT);
+        const uint64 alignment = std::max<uint64>(requirements.alignment, 1ull << GRANULARITY_SHIFT);
+
+        std::scoped_lock lock(_mutex);
+        HeapAllocation allocation = AllocateNode(size, alignment, userData, true);
+        if (allocation.IsValid()){
+            ++_stats.Allocations;
+        }
+        return allocation;
+    }
+
+    void EFRAPIHeapAllocator::Free(const HeapAllocation& allocation){
+        if (!allocation.IsValid()){
+            return;
+        }
+
+        std::scoped_lock lock(_mutex);
+        assert(!_nodes[allocation.Node].B_IsFree);
+        FreeNode(allocation.Node);
+        ++_stats.Frees;
+    }
+
+    BufferHandle EFRAPIHeapAllocator::CreateBuffer(BufferDesc desc, HeapAllocation& outAllocation){
+        outAllocation = {};
+        desc.SetIsVirtual(true);
+        BufferHandle buffer = _device->CreateBuffer(desc);
+        if (!buffer){
+            return nullptr;
+        }
+
+        outAllocation = Allocate(_device->GetBufferMemoryRequirements(buffer), buffer.Get());
+        if (!outAllocation.IsValid()){
+            return nullptr;
+        }
+        if (!_device->BindBufferMemory(buffer, outAllocation.Heap, outAllocation.Offset)){
+            Free(outAllocation);
+            outAllocation = {};
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    TextureHandle EFRAPIHeapAllocator::CreateTexture(TextureDesc desc, HeapAllocation& outAllocation){
+        outAllocation = {};
+        desc.SetIsVirtual(true);
+        TextureHandle texture = _device->CreateTexture(desc);
+        if (!texture){
+            return nullptr;
+        }
+
+        outAllocation = Allocate(_device->GetTextureMemoryRequirements(texture), texture.Get());
+        if (!outAllocation.IsValid()){
+            return nullptr;
+        }
+        if (!_device->BindTextureMemory(texture, outAllocation.Heap, outAllocation.Offset)){
+            Free(outAllocation);
+            outAllocation = {};
+            return nullptr;
+        }
+        return texture;
+    }
+
+    uint32 EFRAPIHeapAllocator::Defragment(const DefragmentCallback& callback, const uint32 maxMoves){
+        std::scoped_lock lock(_mutex);
+        std::vector<uint32> blocks;
+        for (uint32 block = 0; block < _blocks.size(); ++block){
+            if (_blocks[block].Heap && _blocks[block].AllocationCount > 0){
+                blocks.push_back(block);
+            }
+        }
+        std::ranges::sort(blocks, {}, [this](const uint32 block){ return _blocks[block].UsedBytes; });
+
+        // Empties the least used heaps as long as their allocations fit into the free memory of the others. They all
+        // leave the free lists before the first move, so nothing moves into a heap that is emptied later.
+        uint64 freeBytes = 0;
+        for (const uint32 block : blocks){
+            freeBytes += _blocks[block].Capacity - _blocks[block].UsedBytes;
+        }
+        std::vector<uint32> evacuated;
+        uint64 evacuatedBytes = 0;
+        for (size_t index = 0; index + 1 < blocks.size(); ++index){
+            const HeapBlock& block = _blocks[blocks[index]];
+            freeBytes -= block.Capacity - block.UsedBytes;
+            if (evacuatedBytes + block.UsedBytes > freeBytes){
+                break;
+            }
+            evacuatedBytes += block.UsedBytes;
+            evacuated.push_back(blocks[index]);
+        }
+
+        std::vector<uint32> allocated;
+        for (const uint32 block : evacuated){
+            for (uint32 node = _blocks[block].FirstNode; node != INVALID_NODE; node = _nodes[node].NextPhysical){
+                if (_nodes[node].B_IsFree){
+                    RemoveFreeNode(node);
+                }
+                else{
+                    allocated.push_back(node);
+                }
+            }
+            _blocks[block].B_IsEvacuating = true;
+        }
+
+        uint32 moves = 0;
+        for (const uint32 node : allocated){
+            if (moves == maxMoves){
+                break;
+            }
+            const Node source = _nodes[node];
+            const HeapAllocation to = AllocateNode(source.Size, source.Alignment, source.UserData, false);
+            // Alignment padding and fragmentation of the receiving heaps can leave no room after all
+            if (!to.IsValid()){
+                break;
+            }
+            if (callback(GetAllocation(node), to)){
+                FreeNode(node);
+                ++moves;
+            }
+            else{
+                FreeNode(to.Node);
+            }
+        }
+
+        for (const uint32 block : evacuated){
+            _blocks[block].B_IsEvacuating = false;
+            for (uint32 node = _blocks[block].FirstNode; node != INVALID_NODE; node = _nodes[node].NextPhysical){
+                if (_nodes[node].B_IsFree){
+                    InsertFreeNode(node);
+                }
+            }
+            if (_blocks[block].AllocationCount == 0){
+                ReleaseBlock(block);
+            }
+        }
+        _stats.Moves += moves;
+        return moves;
+    }
+
+    void EFRAPIHeapAllocator::ReleaseEmptyHeaps(){
+        std::scoped_lock lock(_mutex);
+        for (uint32 block = 0; block < _blocks.size(); ++block){
+            if (_blocks[block].Heap && _blocks[block].AllocationCount == 0){
+                ReleaseBlock(block);
+            }
+        }
+    }
+
+    std::vector<HeapBlockStats> EFRAPIHeapAllocator::GetHeapStats(){
+        std::scoped_lock lock(_mutex);
+        std::vector<HeapBlockStats> heapStats;
+        for (const HeapBlock& block : _blocks){
+            if (!block.Heap){
+                continue;
+            }
+
+            HeapBlockStats& stats = heapStats.emplace_back();
+            stats.Heap = block.Heap;
+            stats.Capacity = block.Capacity;
+            stats.UsedBytes = block.UsedBytes;
+            stats.AllocationCount = block.AllocationCount;
+            for (uint32 node = block.FirstNode; node != INVALID_NODE; node = _nodes[node].NextPhysical){
+                if (_nodes[node].B_IsFree){
+                    ++stats.FreeRanges;
+                    stats.LargestFreeRange = std::max(stats.LargestFreeRange, _nodes[node].Size);
+                }
+            }
+            const uint64 freeBytes = block.Capacity - block.UsedBytes;
+            if (freeBytes > 0){
+                stats.Fragmentation = 1.0f - static_cast<float>(static_cast<double>(stats.LargestFreeRange) /
+                    static_cast<double>(freeBytes));
+            }
+        }
+        return heapStats;
+    }
+
+    HeapAllocatorStats EFRAPIHeapAllocator::GetStats(){
+        std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+
+    void EFRAPIHeapAllocator::ResetStats(){
+        std::scoped_lock lock(_mutex);
+        const uint64 usedBytes = _stats.UsedBytes;
+        const uint64 reservedBytes = _stats.ReservedBytes;
+        _stats = {};
+        _stats.UsedBytes = usedBytes;
+        _stats.ReservedBytes = reservedBytes;
+    }
+
+    void EFRAPIHeapAllocator::MapSize(const uint64 size, uint32& outFl, uint32& outSl){
+        // Sizes are at least the granularity, so the most significant bit is always above the second level bits
+        const uint32 msb = static_cast<uint32>(std::bit_width(size)) - 1;
+        outFl = msb - GRANULARITY_SHIFT;
+        outSl = static_cast<uint32>(size >> (msb - SL_SHIFT)) - SL_COUNT;
+    }
+
+    uint32 EFRAPIHeapAllocator::FindFreeNode(const uint64 size) const{
+        // Rounded up to the next size class, every range in it or above fits without searching the list
+        const uint32 msb = static_cast<uint32>(std::bit_width(size)) - 1;
+        uint32 fl;
+        uint32 sl;
+        MapSize(size + (1ull << (msb - SL_SHIFT)) - 1, fl, sl);
+        if (fl >= FL_COUNT){
+            return INVALID_NODE;
+        }
+
+        uint32 slMap = _slBitmaps[fl] & (~0u << sl);
+        if (slMap == 0){
+            const uint64 flMap = fl + 1 < FL_COUNT ? _flBitmap & (~0ull << (fl + 1)) : 0;
+            if (flMap == 0){
+                return INVALID_NODE;
+            }
+            fl = static_cast<uint32>(std::countr_zero(flMap));
+            slMap = _slBitmaps[fl];
+        }
+        return _freeHeads[fl][std::countr_zero(slMap)];
+    }
+
+    void EFRAPIHeapAllocator::InsertFreeNode(const uint32 node){
+        if (_blocks[_nodes[node].Block].B_IsEvacuating){
+            return;
+        }
+
+        uint32 fl;
+        uint32 sl;
+        MapSize(_nodes[node].Size, fl, sl);
+        const uint32 head = _freeHeads[fl][sl];
+        _nodes[node].PrevFree = INVALID_NODE;
+        _nodes[node].NextFree = head;
+        if (head != INVALID_NODE){
+            _nodes[head].PrevFree = node;
+        }
+        _freeHeads[fl][sl] = node;
+        _slBitmaps[fl] |= 1u << sl;
+        _flBitmap |= 1ull << fl;
+    }
+
+    void EFRAPIHeapAllocator::RemoveFreeNode(const uint32 node){
+        if (_blocks[_nodes[node].Block].B_IsEvacuating){
+            return;
+        }
+
+        const Node& removed = _nodes[node];
+        if (removed.PrevFree != INVALID_NODE){
+            _nodes[removed.PrevFree].NextFree = removed.NextFree;
+        }
+        if (removed.NextFree != INVALID_NODE){
+            _nodes[removed.NextFree].PrevFree = removed.PrevFree;
+        }
+
+        uint32 fl;
+        uint32 sl;
+        MapSize(removed.Size, fl, sl);
+        if (_freeHeads[fl][sl] == node){
+            _freeHeads[fl][sl] = removed.NextFree;
+            if (removed.NextFree == INVALID_NODE){
+                _slBitmaps[fl] &= ~(1u << sl);
+                if (_slBitmaps[fl] == 0){
+                    _flBitmap &= ~(1ull << fl);
+                }
+            }
+        }
+    }
+
+    uint32 EFRAPIHeapAllocator::CreateNode(){
+        if (_freeNodes.empty()){
+            _nodes.emplace_back();
+            return static_cast<uint32>(_nodes.size() - 1);
+        }
+        const uint32 node = _freeNodes.back();
+        _freeNodes.pop_back();
+        _nodes[node] = {};
+        return node;
+    }
+
+    void EFRAPIHeapAllocator::ReleaseNode(const uint32 node){
+        _freeNodes.push_back(node);
+    }
+
+    void EFRAPIHeapAllocator::SplitNode(const uint32 node, const uint64 size){
+        const uint32 remainder = CreateNode();
+        Node& split = _nodes[node];
+        Node& rest = _nodes[remainder];
+        rest.Offset = split.Offset + size;
+        rest.Size = split.Size - size;
+        rest.Block = split.Block;
+        rest.PrevPhysical = node;
+        rest.NextPhysical = split.NextPhysical;
+        if (split.NextPhysical != INVALID_NODE){
+            _nodes[split.NextPhysical].PrevPhysical = remainder;
+        }
+        split.NextPhysical = remainder;
+        split.Size = size;
+        InsertFreeNode(remainder);
+    }
+
+    void EFRAPIHeapAllocator::MergeWithNext(const uint32 node){
+        const uint32 next = _nodes[node].NextPhysical;
+        _nodes[node].Size += _nodes[next].Size;
+        _nodes[node].NextPhysical = _nodes[next].NextPhysical;
+        if (_nodes[next].NextPhysical != INVALID_NODE){
+            _nodes[_nodes[next].NextPhysical].PrevPhysical = node;
+        }
+        ReleaseNode(next);
+    }
+
+    uint32 EFRAPIHeapAllocator::CreateBlock(const uint64 capacity){
+        HeapHandle heap = _device->CreateHeap(HeapDesc().setCapacity(capacity).setType(_type).
+                                                         setDebugName("HeapAllocatorBlock"));
+        if (!heap){
+            return INVALID_BLOCK;
+        }
+
+        uint32 block;
+        if (_freeBlocks.empty()){
+            block = static_cast<uint32>(_blocks.size());
+            _blocks.emplace_back();
+        }
+        else{
+            block = _freeBlocks.back();
+            _freeBlocks.pop_back();
+        }
+
+        const uint32 node = CreateNode();
+        _nodes[node].Size = capacity;
+        _nodes[node].Block = block;
+        _blocks[block].Heap = std::move(heap);
+        _blocks[block].Capacity = capacity;
+        _blocks[block].FirstNode = node;
+        InsertFreeNode(node);
+
+        ++_stats.HeapsCreated;
+        _stats.ReservedBytes += capacity;
+        return block;
+    }
+
+    void EFRAPIHeapAllocator::ReleaseBlock(const uint32 block){
+        assert(_blocks[block].AllocationCount == 0);
+        RemoveFreeNode(_blocks[block].FirstNode);
+        ReleaseNode(_blocks[block].FirstNode);
+        ++_stats.HeapsReleased;
+        _stats.ReservedBytes -= _blocks[block].Capacity;
+        _blocks[block] = {};
+        _freeBlocks.push_back(block);
+    }
+
+    HeapAllocation EFRAPIHeapAllocator::AllocateNode(const uint64 size, const uint64 alignment, void* userData,
+                                                     const bool allowNewHeap){
+        // Ranges start at multiples of the granularity, the worst case padding is below the alignment
+        const uint64 searchSize = size + alignment - (1ull << GRANULARITY_SHIFT);
+        uint32 node = FindFreeNode(searchSize);
+        if (node == INVALID_NODE){
+            if (!allowNewHeap){
+                return {};
+            }
+            // Larger requests get a heap of their own, its only range fits them even where the size class does not
+            const uint32 block = CreateBlock(std::max(_blockSize, searchSize));
+            if (block == INVALID_BLOCK){
+                return {};
+            }
+            node = _blocks[block].FirstNode;
+        }
+        RemoveFreeNode(node);
+
+        const uint64 padding = AlignUp(_nodes[node].Offset, alignment) - _nodes[node].Offset;
+        if (padding > 0){
+            // The padding stays free in front of the allocation
+            SplitNode(node, padding);
+            const uint32 front = node;
+            node = _nodes[front].NextPhysical;
+            RemoveFreeNode(node);
+            InsertFreeNode(front);
+        }
+        if (_nodes[node].Size > size){
+            SplitNode(node, size);
+        }
+
+        Node& allocated = _nodes[node];
+        allocated.B_IsFree = false;
+        allocated.Alignment = alignment;
+        allocated.UserData = userData;
+        HeapBlock& block = _blocks[allocated.Block];
+        block.UsedBytes += size;
+        ++block.AllocationCount;
+        _stats.UsedBytes += size;
+        return GetAllocation(node);
+    }
+
+    void EFRAPIHeapAllocator::FreeNode(uint32 node){
+        Node& freed = _nodes[node];
+        freed.B_IsFree = true;
+        freed.UserData = nullptr;
+        HeapBlock& block = _blocks[freed.Block];
+        block.UsedBytes -= freed.Size;
+        --block.AllocationCount;
+        _stats.UsedBytes -= freed.Size;
+
+        if (const uint32 next = _nodes[node].NextPhysical; next != INVALID_NODE && _nodes[next].B_IsFree){
+            RemoveFreeNode(next);
+            MergeWithNext(node);
+        }
+        if (const uint32 prev = _nodes[node].PrevPhysical; prev != INVALID_NODE && _nodes[prev].B_IsFree){
+            RemoveFreeNode(prev);
+            MergeWithNext(prev);
+            node = prev;
+        }
+        InsertFreeNode(node);
+    }
+
+    HeapAllocation EFRAPIHeapAllocator::GetAllocation(const uint32 node) const{
+        const Node& allocated = _nodes[node];
+        HeapAllocation allocation;
+        allocation.Heap = _blocks[allocated.Block].Heap;
+        allocation.Offset = allocated.Offset;
+        allocation.Size = allocated.Size;
+        allocation.UserData = allocated.UserData;
+        allocation.Node = node;
+        return allocation;
+    }
+} // EventfulEngine
@@ -0,0 +1,504 @@
+#pragma once
+
+#include "EFRAPIPipelineCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint32 PIPELINE_CACHE_MAGIC = 0x43504645; // "EFPC"
+        constexpr uint32 PIPELINE_CACHE_VERSION = 1;
+
+        // Keeps graphics and compute hashes of otherwise equal bytes apart
+        constexpr uint8 GRAPHICS_PIPELINE_TAG = 1;
+        constexpr uint8 COMPUTE_PIPELINE_TAG = 2;
+
+        // FNV-1a over the fields of a description, fed one by one so padding never takes part
+        class ContentHasher{
+        public:
+            void Bytes(const void* data, const size_t size){
+                const auto* bytes = static_cast<const uint8*>(data);
+                for (size_t index = 0; index < size; ++index){
+                    _hash = (_hash ^ bytes[index]) * FNV_PRIME;
+                }
+            }
+
+            template <typename T>
+                requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+            void Value(const T value){
+                Bytes(&value, sizeof(T));
+            }
+
+            void Size(const size_t size){
+                Value(static_cast<uint64>(size));
+            }
+
+            void String(const std::string_view string){
+                Size(string.size());
+                Bytes(string.data(), string.size());
+            }
+
+            [[nodiscard]] uint64 Get() const{ return _hash; }
+
+        private:
+            static constexpr uint64 FNV_OFFSET = 0xcbf29ce484222325ull;
+            static constexpr uint64 FNV_PRIME = 0x100000001b3ull;
+
+            uint64 _hash = FNV_OFFSET;
+        };
+
+        void HashShader(ContentHasher& hasher, const EFRAPIShader* shader){
+            hasher.Value(shader != nullptr);
+            if (!shader){
+                return;
+            }
+
+            const ShaderDesc& desc = shader->GetDesc();
+            hasher.Value(desc.ShaderType);
+            hasher.String(desc.EntryName);
+            hasher.Value(desc.HlslExtensionsUAV);
+            hasher.Value(desc.B_UseSpecificShaderExt);
+            hasher.Value(desc.FastGSFlags);
+
+            const void* bytecode = nullptr;
+            size_t bytecodeSize = 0;
+            shader->GetBytecode(&bytecode, &bytecodeSize);
+            hasher.Size(bytecodeSize);
+            hasher.Bytes(bytecode, bytecodeSize);
+
+            const std::span<const ShaderSpecialization> specializations = shader->GetSpecializations();
+            hasher.Size(specializations.size());
+            for (const ShaderSpecialization& specialization : specializations){
+                hasher.Value(specialization.constantID);
+                hasher.Value(specialization.value.u);
+            }
+        }
+
+        void HashInputLayout(ContentHasher& hasher, const EFRAPIInputLayout* inputLayout){
+            const uint32 attributeCount = inputLayout ? inputLayout->GetNumAttributes() : 0;
+            hasher.Value(attributeCount);
+            for (uint32 index = 0; index < attributeCount; ++index){
+                const VertexAttributeDesc* attribute = inputLayout->GetAttributeDesc(index);
+                hasher.String(attribute->Name);
+                hasher.Value(attribute->Format);
+                hasher.Value(attribute->ArraySize);
+                hasher.Value(attribute->BufferIndex);
+                hasher.Value(attribute->Offset);
+                hasher.Value(attribute->ElementStride);
+                hasher.Value(attribute->B_IsInstanced);
+            }
+        }
+
+        void HashBindingLayoutItem(ContentHasher& hasher, const BindingLayoutItem& item){
+            hasher.Value(item.slot);
+            hasher.Value(static_cast<E_ResourceType>(item.type));
+            hasher.Value(static_cast<uint16>(item.size));
+        }
+
+        void HashBindingLayouts(ContentHasher& hasher, const BindingLayoutVector& bindingLayouts){
+            hasher.Size(bindingLayouts.size());
+            for (const BindingLayoutHandle& layout : bindingLayouts){
+                if (const BindingLayoutDesc* desc = layout ? layout->getDesc() : nullptr){
+                    hasher.Value(static_cast<uint8>(1));
+                    hasher.Value(desc->visibility);
+                    hasher.Value(desc->registerSpace);
+                    hasher.Value(desc->registerSpaceIsDescriptorSet);
+                    hasher.Size(desc->bindings.size());
+                    for (const BindingLayoutItem& item : desc->bindings){
+                        HashBindingLayoutItem(hasher, item);
+                    }
+                    hasher.Value(desc->bindingOffsets.shaderResource);
+                    hasher.Value(desc->bindingOffsets.sampler);
+                    hasher.Value(desc->bindingOffsets.constantBuffer);
+                    hasher.Value(desc->bindingOffsets.unorderedAccess);
+                }
+                else if (const BindlessLayoutDesc* bindlessDesc = layout ? layout->getBindlessDesc() : nullptr){
+                    hasher.Value(static_cast<uint8>(2));
+                    hasher.Value(bindlessDesc->visibility);
+                    hasher.Value(bindlessDesc->firstSlot);
+                    hasher.Value(bindlessDesc->maxCapacity);
+                    hasher.Size(bindlessDesc->registerSpaces.size());
+                    for (const BindingLayoutItem& item : bindlessDesc->registerSpaces){
+                        HashBindingLayoutItem(hasher, item);
+                    }
+                    hasher.Value(bindlessDesc->layoutType);
+                }
+                else{
+                    hasher.Value(static_cast<uint8>(0));
+                }
+            }
+        }
+
+        void HashRenderState(ContentHasher& hasher, const RenderState& state){
+            const BlendState& blend = state.RenderBlendState;
+            for (const BlendState::RenderTarget& target : blend.targets){
+                hasher.Value(target.blendEnable);
+                hasher.Value(target.srcBlend);
+                hasher.Value(target.destBlend);
+                hasher.Value(target.blendOp);
+                hasher.Value(target.srcBlendAlpha);
+                hasher.Value(target.destBlendAlpha);
+                hasher.Value(target.blendOpAlpha);
+                hasher.Value(target.colorWriteMask);
+            }
+            hasher.Value(blend.alphaToCoverageEnable);
+
+            const DepthStencilState& depthStencil = state.RenderDepthStencilState;
+            hasher.Value(depthStencil.B_IsDepthTestEnabled);
+            hasher.Value(depthStencil.B_IsDepthWriteEnabled);
+            hasher.Value(depthStencil.DepthFunc);
+            hasher.Value(depthStencil.B_IsStencilEnabled);
+            hasher.Value(depthStencil.StencilReadMask);
+            hasher.Value(depthStencil.StencilWriteMask);
+            hasher.Value(depthStencil.StencilRefValue);
+            hasher.Value(depthStencil.B_IsDynamicStencilRef);
+            for (const DepthStencilState::StencilOpDesc& face : {depthStencil.FrontFaceStencil,
+                                                                  depthStencil.BackFaceStencil}){
+                hasher.Value(face.FailOp);
+                hasher.Value(face.DepthFailOp);
+                hasher.Value(face.PassOp);
+                hasher.Value(face.StencilFunc);
+            }
+
+            const RasterState& raster = state.RenderRasterState;
+            hasher.Value(raster.fillMode);
+            hasher.Value(raster.cullMode);
+            hasher.Value(raster.frontCounterClockwise);
+            hasher.Value(raster.depthClipEnable);
+            hasher.Value(raster.scissorEnable);
+            hasher.Value(raster.multisampleEnable);
+            hasher.Value(raster.antialiasedLineEnable);
+            hasher.Value(raster.depthBias);
+            hasher.Value(raster.depthBiasClamp);
+            hasher.Value(raster.SlopeScaledDepthBias);
+            hasher.Value(raster.ForcedSampleCount);
+            hasher.Value(raster.ProgrammableSamplePositionsEnable);
+            hasher.Value(raster.ConservativeRasterEnable);
+            hasher.Value(raster.QuadFillEnable);
+            hasher.Bytes(raster.SamplePositionsX, sizeof(raster.SamplePositionsX));
+            hasher.Bytes(raster.SamplePositionsY, sizeof(raster.SamplePositionsY));
+
+            hasher.Value(state.SinglePassStereo.B_IsEnabled);
+            hasher.Value(state.SinglePassStereo.B_IsIndependentViewportMask);
+            hasher.Value(state.SinglePassStereo.RenderTargetIndexOffset);
+        }
+    }
+
+    uint64 HashGraphicsPipeline(const GraphicsPipelineDesc& desc, const FramebufferInfo& framebufferInfo){
+        ContentHasher hasher;
+        hasher.Value(GRAPHICS_PIPELINE_TAG);
+        hasher.Value(desc.PrimType);
+        hasher.Value(desc.PatchControlPoints);
+        HashInputLayout(hasher, desc.InputLayout);
+        for (const EFRAPIShader* shader : {desc.VS.Get(), desc.HS.Get(), desc.DS.Get(), desc.GS.Get(), desc.PS.Get()}){
+            HashShader(hasher, shader);
+        }
+        HashRenderState(hasher, desc.GraphicsRenderState);
+        hasher.Value(desc.ShadingRateState.B_IsEnabled);
+        hasher.Value(desc.ShadingRateState.ShadingRate);
+        hasher.Value(desc.ShadingRateState.PipelinePrimitiveCombiner);
+        hasher.Value(desc.ShadingRateState.ImageCombiner);
+        HashBindingLayouts(hasher, desc.BindingLayouts);
+
+        hasher.Size(framebufferInfo.colorFormats.size());
+        for (const E_Format format : framebufferInfo.colorFormats){
+            hasher.Value(format);
+        }
+        hasher.Value(framebufferInfo.depthFormat);
+        hasher.Value(framebufferInfo.sampleCount);
+        hasher.Value(framebufferInfo.sampleQuality);
+        return hasher.Get();
+    }
+
+    uint64 HashComputePipeline(const ComputePipelineDesc& desc){
+        ContentHasher hasher;
+        hasher.Value(COMPUTE_PIPELINE_TAG);
+        HashShader(hasher, desc.CS);
+        HashBindingLayouts(hasher, desc.BindingLayouts);
+        return hasher.Get();
+    }
+
+    EFRAPIPipelineCache::EFRAPIPipelineCache(EFDynamicRAPI* device, const uint32 compileThreads)
+        : _device(device), _maxCompileThreads(compileThreads != 0
+                                                  ? compileThreads
+                                                  : std::max(std::thread::hardware_concurrency() / 2, 1u)){
+    }
+
+    EFRAPIPipelineCache::~EFRAPIPipelineCache(){
+        WaitForPendingCompilations();
+        {
+            std::scoped_lock lock(_mutex);
+            _bIsStopping = true;
+        }
+        _compileReady.notify_all();
+        for (Thread& thread : _compileThreads){
+            thread.Join();
+        }
+    }
+
+    template <typename Handle, typename Create>
+    Handle EFRAPIPipelineCache::GetPipeline(PipelineMap<Handle>& pipelines, const uint64 hash, Create&& create){
+        std::promise<Handle> promise;
+        std::unique_lock lock(_mutex);
+        if (const auto found = pipelines.find(hash); found != pipelines.end()){
+            const std::shared_future<Handle> pipeline = found->second;
+            ++_stats.Hits;
+            if (pipeline.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+                // Another thread or a background compilation is creating it, waiting stalls this thread as well
+                ++_stats.Hitches;
+            }
+            lock.unlock();
+            return pipeline.get();
+        }
+        pipelines.emplace(hash, promise.get_future().share());
+        ++_stats.Misses;
+        ++_stats.Hitches;
+        lock.unlock();
+
+        Handle pipeline = create();
+        if (!pipeline){
+            ForgetPipeline(pipelines, hash);
+        }
+        promise.set_value(pipeline);
+        return pipeline;
+    }
+
+    template <typename Handle, typename Create>
+    Handle EFRAPIPipelineCache::RequestPipeline(PipelineMap<Handle>& pipelines, const uint64 hash,
+                                                typename Handle::InterfaceType* placeholder, Create&& create){
+        std::scoped_lock lock(_mutex);
+        if (const auto found = pipelines.find(hash); found != pipelines.end()){
+            if (found->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready){
+                ++_stats.Hits;
+                return found->second.get();
+            }
+            ++_stats.Placeholders;
+            return placeholder;
+        }
+
+        auto promise = std::make_shared<std::promise<Handle>>();
+        pipelines.emplace(hash, promise->get_future().share());
+        _compileQueue.emplace_back([this, &pipelines, hash, promise, create = std::forward<Create>(create)]{
+            Handle pipeline = create();
+            if (!pipeline){
+                ForgetPipeline(pipelines, hash);
+            }
+            promise->set_value(pipeline);
+        });
+        // Another thread only starts while every started one has work
+        const size_t idleThreads = _compileThreads.size() - _busyCompileThreads;
+        if (_compileThreads.size() < _maxCompileThreads && _compileQueue.size() > idleThreads){
+            _compileThreads.emplace_back([this]{ RunCompileThread(); });
+        }
+        _compileReady.notify_one();
+        ++_stats.Misses;
+        ++_stats.AsyncCompilations;
+        ++_stats.Placeholders;
+        return placeholder;
+    }
+
+    template <typename Handle>
+    void EFRAPIPipelineCache::ForgetPipeline(PipelineMap<Handle>& pipelines, const uint64 hash){
+        std::scoped_lock lock(_mutex);
+        pipelines.erase(hash);
+        ++_stats.Failures;
+    }
+
+    void EFRAPIPipelineCache::RunCompileThread(){
+        std::unique_lock lock(_mutex);
+        while (true){
+            _compileReady.wait(lock, [this]{ return _bIsStopping || !_compileQueue.empty(); });
+            if (_compileQueue.empty()){
+                return;
+            }
+            const std::function<void()> compile = std::move(_compileQueue.front());
+            _compileQueue.pop_front();
+            ++_busyCompileThreads;
+            lock.unlock();
+
+            compile();
+
+            lock.lock();
+            if (--_busyCompileThreads == 0 && _compileQueue.empty()){
+                _compilationsDone.notify_all();
+            }
+        }
+    }
+
+    GraphicsPipelineHandle EFRAPIPipelineCache::GetGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                    EFRAPIFramebuffer* fb){
+        const uint64 hash = HashGraphicsPipeline(desc, fb->GetFramebufferInfo());
+        return GetPipeline(_graphicsPipelines, hash, [&]{
+            return CreateGraphicsPipeline(desc, fb, hash);
+        });
+    }
+
+    ComputePipelineHandle EFRAPIPipelineCache::GetComputePipeline(const ComputePipelineDesc& desc){
+        const uint64 hash = HashComputePipeline(desc);
+        return GetPipeline(_computePipelines, hash, [&]{
+            return CreateComputePipeline(desc, hash);
+        });
+    }
+
+    GraphicsPipelineHandle EFRAPIPipelineCache::RequestGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                        EFRAPIFramebuffer* fb,
+                                                                        EFRAPIGraphicsPipeline* placeholder){
+        const uint64 hash = HashGraphicsPipeline(desc, fb->GetFramebufferInfo());
+        // The compilation outlives the call, it holds its own references to the description and framebuffer
+        return RequestPipeline(_graphicsPipelines, hash, placeholder,
+                               [this, desc, framebuffer = FramebufferHandle(fb), hash]{
+                                   return CreateGraphicsPipeline(desc, framebuffer, hash);
+                               });
+    }
+
+    ComputePipelineHandle EFRAPIPipelineCache::RequestComputePipeline(const ComputePipelineDesc& desc,
+                                                                      EFRAPIComputePipeline* placeholder){
+        const uint64 hash = HashComputePipeline(desc);
+        return RequestPipeline(_computePipelines, hash, placeholder, [this, desc, hash]{
+            return CreateComputePipeline(desc, hash);
+        });
+    }
+
+    GraphicsPipelineHandle EFRAPIPipelineCache::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                       EFRAPIFramebuffer* fb, const uint64 hash){
+        if (const std::vector<uint8> binary = FindBinary(hash); !binary.empty()){
+            return _device->CreateGraphicsPipelineFromBinary(desc, fb, binary.data(), binary.size());
+        }
+        GraphicsPipelineHandle pipeline = _device->CreateGraphicsPipeline(desc, fb);
+        StoreBinary(hash, pipeline);
+        return pipeline;
+    }
+
+    ComputePipelineHandle EFRAPIPipelineCache::CreateComputePipeline(const ComputePipelineDesc& desc,
+                                                                     const uint64 hash){
+        if (const std::vector<uint8> binary = FindBinary(hash); !binary.empty()){
+            return _device->CreateComputePipelineFromBinary(desc, binary.data(), binary.size());
+        }
+        ComputePipelineHandle pipeline = _device->CreateComputePipeline(desc);
+        StoreBinary(hash, pipeline);
+        return pipeline;
+    }
+
+    std::vector<uint8> EFRAPIPipelineCache::FindBinary(const uint64 hash){
+        std::scoped_lock lock(_mutex);
+        const auto found = _binaries.find(hash);
+        if (found == _binaries.end()){
+            return {};
+        }
+        ++_stats.BinariesLoaded;
+        return found->second;
+    }
+
+    void EFRAPIPipelineCache::StoreBinary(const uint64 hash, EFRAPIResource* pipeline){
+        std::vector<uint8> binary;
+        if (!pipeline || !_device->GetPipelineBinary(pipeline, binary) || binary.empty()){
+            return;
+        }
+        std::scoped_lock lock(_mutex);
+        _binaries.insert_or_assign(hash, std::move(binary));
+    }
+
+    void EFRAPIPipelineCache::WaitForPendingCompilations(){
+        std::unique_lock lock(_mutex);
+        _compilationsDone.wait(lock, [this]{ return _compileQueue.empty() && _busyCompileThreads == 0; });
+    }
+
+    bool EFRAPIPipelineCache::Load(const EFPath& path){
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file){
+            return false;
+        }
+        // Sizes in the file are checked against what is left of it before anything is allocated for them
+        const auto fileSize = static_cast<uint64>(file.tellg());
+        file.seekg(0);
+
+        uint32 magic = 0;
+        uint32 version = 0;
+        uint32 api = 0;
+        uint64 count = 0;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&api), sizeof(api));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        // Binaries of another backend are useless, the same backend rejects stale ones on creation
+        if (!file || magic != PIPELINE_CACHE_MAGIC || version != PIPELINE_CACHE_VERSION ||
+            api != static_cast<uint32>(_device->GetGraphicsAPI())){
+            return false;
+        }
+
+        constexpr uint64 ENTRY_HEADER_SIZE = 2 * sizeof(uint64);
+        if (count > (fileSize - static_cast<uint64>(file.tellg())) / ENTRY_HEADER_SIZE){
+            return false;
+        }
+
+        std::unordered_map<uint64, std::vector<uint8>> binaries;
+        for (uint64 index = 0; index < count; ++index){
+            uint64 hash = 0;
+            uint64 size = 0;
+            file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+            file.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!file || size > fileSize - static_cast<uint64>(file.tellg())){
+                return false;
+            }
+            std::vector<uint8> binary(size);
+            file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(size));
+            if (!file){
+                return false;
+            }
+            binaries.insert_or_assign(hash, std::move(binary));
+        }
+
+        std::scoped_lock lock(_mutex);
+        binaries.merge(_binaries);
+        _binaries = std::move(binaries);
+        return true;
+    }
+
+    bool EFRAPIPipelineCache::Save(const EFPath& path){
+        WaitForPendingCompilations();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file){
+            return false;
+        }
+
+        std::scoped_lock lock(_mutex);
+        const uint32 api = static_cast<uint32>(_device->GetGraphicsAPI());
+        const uint64 count = _binaries.size();
+        file.write(reinterpret_cast<const char*>(&PIPELINE_CACHE_MAGIC), sizeof(PIPELINE_CACHE_MAGIC));
+        file.write(reinterpret_cast<const char*>(&PIPELINE_CACHE_VERSION), sizeof(PIPELINE_CACHE_VERSION));
+        file.write(reinterpret_cast<const char*>(&api), sizeof(api));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& [hash, binary] : _binaries){
+            const uint64 size = binary.size();
+            file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+            file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(size));
+        }
+        return static_cast<bool>(file);
+    }
+
+    void EFRAPIPipelineCache::Clear(){
+        WaitForPendingCompilations();
+        std::scoped_lock lock(_mutex);
+        _graphicsPipelines.clear();
+        _computePipelines.clear();
+    }
+
+    size_t EFRAPIPipelineCache::GetPipelineCount(){
+        std::scoped_lock lock(_mutex);
+        return _graphicsPipelines.size() + _computePipelines.size();
+    }
+
+    PipelineCacheStats EFRAPIPipelineCache::GetStats(){
+        std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+
+    void EFRAPIPipelineCache::ResetStats(){
+        std::scoped_lock lock(_mutex);
+        _stats = {};
+    }
+} // EventfulEngine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "EFRAPIProfiler.h"
+#include "EFName.h"
+
+#include <algorithm>
+
+namespace EventfulEngine{
+    EFGpuProfiler::EFGpuProfiler(EFDynamicRAPI* device) : _device(device){
+    }
+
+    void EFGpuProfiler::BeginZone(EFRAPICommandList* commandList, const char* name){
+        commandList->BeginMarker(name);
+
+        GpuZone zone{commandList, nullptr, name, 0, 0};
+        if (EFProfiler::IsEnabled()){
+            // Marker names may be built at run time, the profiler keeps the pointer until the trace is written
+            zone.Name = EFName(name).GetData();
+            zone.FrameIndex = EFProfiler::GetFrameIndex();
+            zone.RecordCycles = EFPlatformTime::Cycles64();
+        }
+
+        std::scoped_lock lock(_mutex);
+        if (zone.RecordCycles != 0){
+            if (_freeQueries.empty()){
+                zone.Query = _device->CreateTimerQuery();
+            }
+            else{
+                zone.Query = std::move(_freeQueries.back());
+                _freeQueries.pop_back();
+            }
+            commandList->BeginTimerQuery(zone.Query);
+        }
+        _openZones.push_back(std::move(zone));
+    }
+
+    void EFGpuProfiler::EndZone(EFRAPICommandList* commandList){
+        {
+            std::scoped_lock lock(_mutex);
+            const auto open = std::ranges::find(_openZones.rbegin(), _openZones.rend(), commandList,
+                                                &GpuZone::CommandList);
+            if (open != _openZones.rend()){
+                if (open->Query){
+                    commandList->EndTimerQuery(open->Query);
+                    _pendingZones.push_back(std::move(*open));
+                }
+                _openZones.erase(std::next(open).base());
+            }
+        }
+        commandList->EndMarker();
+    }
+
+    void EFGpuProfiler::ResolveZones(){
+        std::scoped_lock lock(_mutex);
+        // Lists may execute in a different order than their zones ended, every zone is polled
+        for (GpuZone& zone : _pendingZones){
+            if (_device->PollTimerQuery(zone.Query)){
+                EFProfiler::RecordGpuZone(zone.FrameIndex, zone.Name, zone.RecordCycles,
+                                          _device->GetTimerQueryTime(zone.Query));
+                _device->ResetTimerQuery(zone.Query);
+                _freeQueries.push_back(std::move(zone.Query));
+            }
+        }
+        std::erase_if(_pendingZones, [](const GpuZone& zone){ return !zone.Query; });
+    }
+
+    size_t EFGpuProfiler::GetPendingZoneCount(){
+        std::scoped_lock lock(_mutex);
+        return _pendingZones.size();
+    }
+
+    void ReportExecutedCommandLists(EFRAPICommandList* const* commandLists, const size_t count){
+        int64 drawCalls = 0;
+        int64 dispatches = 0;
+        for (size_t index = 0; index < count; ++index){
+            const EFRAPICommandList::RecordingStats& stats = commandLists[index]->GetRecordingStats();
+            drawCalls += stats.DrawCalls;
+            dispatches += stats.Dispatches;
+        }
+        EFProfiler::AddCounter("DrawCalls", drawCalls);
+        EFProfiler::AddCounter("Dispatches", dispatches);
+    }
+} // EventfulEngine
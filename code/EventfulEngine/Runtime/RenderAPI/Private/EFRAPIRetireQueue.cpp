@@ -0,0 +1,133 @@
+#pragma once
+
+#include "EFRAPIRetireQueue.h"
+
+#include <algorithm>
+
+namespace EventfulEngine{
+    EFRAPIRetireQueue::~EFRAPIRetireQueue(){
+        DestroyAll();
+    }
+
+    bool EFRAPIRetireQueue::Retire(EFRAPIResource* resource){
+        std::scoped_lock lock(_mutex);
+        if (_bIsClosed){
+            return false;
+        }
+        _openFrame.push_back(resource);
+        ++_stats.ResourcesRetired;
+        ++_stats.PendingResources;
+        return true;
+    }
+
+    void EFRAPIRetireQueue::CloseFrame(const QueueInstances& submittedInstances){
+        std::scoped_lock lock(_mutex);
+        if (_openFrame.empty()){
+            return;
+        }
+
+        _pendingFrames.push_back({submittedInstances, std::move(_openFrame)});
+        _openFrame.clear();
+        if (!_freeLists.empty()){
+            _openFrame = std::move(_freeLists.back());
+            _freeLists.pop_back();
+        }
+        _stats.PendingFrames = _pendingFrames.size();
+    }
+
+    size_t EFRAPIRetireQueue::Collect(const QueueInstances& completedInstances){
+        std::vector<std::vector<EFRAPIResource*>> batch;
+        {
+            std::scoped_lock lock(_mutex);
+            // Instances only grow from frame to frame, the first incomplete frame ends the batch
+            while (!_pendingFrames.empty() && std::ranges::equal(_pendingFrames.front().Instances, completedInstances,
+                                                                 std::less_equal{})){
+                batch.push_back(std::move(_pendingFrames.front().Resources));
+                _pendingFrames.pop_front();
+            }
+            _stats.PendingFrames = _pendingFrames.size();
+        }
+
+        size_t destroyed = 0;
+        for (const std::vector<EFRAPIResource*>& resources : batch){
+            Destroy(resources);
+            destroyed += resources.size();
+        }
+
+        std::scoped_lock lock(_mutex);
+        Recycle(batch);
+        _stats.ResourcesDestroyed += destroyed;
+        _stats.PendingResources -= destroyed;
+        _stats.LargestBatch = std::max<uint64>(_stats.LargestBatch, destroyed);
+        return destroyed;
+    }
+
+    size_t EFRAPIRetireQueue::DestroyAll(){
+        size_t destroyed = 0;
+        std::vector<std::vector<EFRAPIResource*>> batch;
+        while (true){
+            {
+                std::scoped_lock lock(_mutex);
+                Recycle(batch);
+                for (RetiredFrame& frame : _pendingFrames){
+                    batch.push_back(std::move(frame.Resources));
+                }
+                _pendingFrames.clear();
+                _stats.PendingFrames = 0;
+                if (!_openFrame.empty()){
+                    batch.push_back(std::move(_openFrame));
+                    _openFrame.clear();
+                }
+                if (batch.empty()){
+                    break;
+                }
+            }
+
+            // Destructors retire the resources they referenced, the loop collects them too
+            for (const std::vector<EFRAPIResource*>& resources : batch){
+                Destroy(resources);
+                std::scoped_lock lock(_mutex);
+                destroyed += resources.size();
+                _stats.ResourcesDestroyed += resources.size();
+                _stats.PendingResources -= resources.size();
+            }
+        }
+        return destroyed;
+    }
+
+    size_t EFRAPIRetireQueue::Close(){
+        {
+            // Closed first, what the pending resources release while being destroyed is deleted right away
+            std::scoped_lock lock(_mutex);
+            _bIsClosed = true;
+        }
+        return DestroyAll();
+    }
+
+    RetireQueueStats EFRAPIRetireQueue::GetStats(){
+        std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+
+    void EFRAPIRetireQueue::ResetStats(){
+        std::scoped_lock lock(_mutex);
+        const RetireQueueStats pending = _stats;
+        _stats = {};
+        _stats.PendingResources = pending.PendingResources;
+        _stats.PendingFrames = pending.PendingFrames;
+    }
+
+    void EFRAPIRetireQueue::Destroy(const std::vector<EFRAPIResource*>& resources){
+        for (const EFRAPIResource* resource : resources){
+            delete resource;
+        }
+    }
+
+    void EFRAPIRetireQueue::Recycle(std::vector<std::vector<EFRAPIResource*>>& lists){
+        for (std::vector<EFRAPIResource*>& list : lists){
+            list.clear();
+            _freeLists.push_back(std::move(list));
+        }
+        lists.clear();
+    }
+} // EventfulEngine
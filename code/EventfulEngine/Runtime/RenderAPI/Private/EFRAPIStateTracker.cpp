@@ -0,0 +1,326 @@
+#pragma once
+
+#include "EFRAPIStateTracker.h"
+
+#include <algorithm>
+
+namespace EventfulEngine{
+    namespace{
+        // State a resource enters its first command list in
+        TextureSubresourceStates GetExecutedStates(const TextureStateExtension* texture){
+            if (texture->States.IsUniform() && texture->States.State == F_ResourceStates::Unknown &&
+                texture->DescRef.B_KeepInitialState){
+                return {texture->DescRef.InitialState, {}};
+            }
+            return texture->States;
+        }
+
+        F_ResourceStates GetExecutedState(const BufferStateExtension* buffer){
+            if (buffer->State == F_ResourceStates::Unknown && buffer->DescRef.B_KeepInitialState){
+                return buffer->DescRef.InitialState;
+            }
+            return buffer->State;
+        }
+
+        bool IsUavBarrier(const F_ResourceStates before, const F_ResourceStates after, const bool enableUavBarriers){
+            return enableUavBarriers && before == F_ResourceStates::UnorderedAccess &&
+                after == F_ResourceStates::UnorderedAccess;
+        }
+    }
+
+    uint32 TextureStateExtension::GetSubresourceCount() const{
+        const uint32 arraySize = DescRef.Dimension == E_TextureDimension::Texture3D
+                                     ? 1
+                                     : std::max(DescRef.ArraySize, 1u);
+        return std::max(DescRef.MipLevels, 1u) * arraySize;
+    }
+
+    void EFRAPIStateTracker::SetEnableUavBarriersForTexture(TextureStateExtension* texture, const bool enableBarriers){
+        GetTextureTracking(texture).B_EnableUavBarriers = enableBarriers;
+    }
+
+    void EFRAPIStateTracker::SetEnableUavBarriersForBuffer(BufferStateExtension* buffer, const bool enableBarriers){
+        GetBufferTracking(buffer).B_EnableUavBarriers = enableBarriers;
+    }
+
+    void EFRAPIStateTracker::BeginTrackingTextureState(TextureStateExtension* texture,
+                                                       const TextureSubresourceSet subresources,
+                                                       const F_ResourceStates state){
+        TextureTracking& tracking = GetTextureTracking(texture);
+        const TextureSubresourceSet resolved = subresources.Resolve(texture->DescRef, false);
+        if (resolved.IsEntireTexture(texture->DescRef)){
+            tracking.States = {state, {}};
+            return;
+        }
+
+        if (tracking.States.IsUniform()){
+            tracking.States.Subresources.assign(texture->GetSubresourceCount(), tracking.States.State);
+        }
+        for (ArraySlice arraySlice = resolved.BaseArraySlice;
+             arraySlice < resolved.BaseArraySlice + resolved.NumArraySlices; ++arraySlice){
+            for (MipLevel mipLevel = resolved.BaseMipLevel; mipLevel < resolved.BaseMipLevel + resolved.NumMipLevels;
+                 ++mipLevel){
+                tracking.States.Subresources[texture->GetSubresourceIndex(mipLevel, arraySlice)] = state;
+            }
+        }
+    }
+
+    void EFRAPIStateTracker::BeginTrackingBufferState(BufferStateExtension* buffer, const F_ResourceStates state){
+        GetBufferTracking(buffer).State = state;
+    }
+
+    void EFRAPIStateTracker::RequireTextureState(TextureStateExtension* texture,
+                                                 const TextureSubresourceSet subresources,
+                                                 const F_ResourceStates state){
+        if (texture->PermanentState != F_ResourceStates::Unknown){
+            return;
+        }
+        TextureTracking& tracking = GetTextureTracking(texture);
+        if (tracking.B_IsPermanent){
+            return;
+        }
+
+        const TextureSubresourceSet resolved = subresources.Resolve(texture->DescRef, false);
+        const bool bIsEntireTexture = resolved.IsEntireTexture(texture->DescRef);
+        TextureSubresourceStates& states = tracking.States;
+        // Subresources that converged on one state are tracked as one again before a whole texture transition
+        if (bIsEntireTexture && !states.IsUniform() && std::ranges::adjacent_find(
+            states.Subresources, std::ranges::not_equal_to{}) == states.Subresources.end()){
+            states.State = states.Subresources.front();
+            states.Subresources.clear();
+        }
+        if (bIsEntireTexture && states.IsUniform()){
+            TransitionTexture(texture, tracking, NO_SUBRESOURCE, states.State, state);
+            states.State = state;
+            return;
+        }
+
+        if (states.IsUniform()){
+            states.Subresources.assign(texture->GetSubresourceCount(), states.State);
+        }
+        for (ArraySlice arraySlice = resolved.BaseArraySlice;
+             arraySlice < resolved.BaseArraySlice + resolved.NumArraySlices; ++arraySlice){
+            for (MipLevel mipLevel = resolved.BaseMipLevel; mipLevel < resolved.BaseMipLevel + resolved.NumMipLevels;
+                 ++mipLevel){
+                const uint32 subresource = texture->GetSubresourceIndex(mipLevel, arraySlice);
+                TransitionTexture(texture, tracking, subresource, states.Subresources[subresource], state);
+                states.Subresources[subresource] = state;
+            }
+        }
+        if (bIsEntireTexture){
+            states.State = state;
+            states.Subresources.clear();
+        }
+    }
+
+    void EFRAPIStateTracker::RequireBufferState(BufferStateExtension* buffer, const F_ResourceStates state){
+        if (buffer->PermanentState != F_ResourceStates::Unknown){
+            return;
+        }
+        BufferTracking& tracking = GetBufferTracking(buffer);
+        if (tracking.B_IsPermanent){
+            return;
+        }
+
+        TransitionBuffer(buffer, tracking, tracking.State, state);
+        tracking.State = state;
+    }
+
+    void EFRAPIStateTracker::SetPermanentTextureState(TextureStateExtension* texture, const F_ResourceStates state){
+        RequireTextureState(texture, AllSubresources, state);
+        GetTextureTracking(texture).B_IsPermanent = true;
+    }
+
+    void EFRAPIStateTracker::SetPermanentBufferState(BufferStateExtension* buffer, const F_ResourceStates state){
+        RequireBufferState(buffer, state);
+        GetBufferTracking(buffer).B_IsPermanent = true;
+    }
+
+    void EFRAPIStateTracker::KeepInitialStates(){
+        for (TextureStateExtension* texture : _textures){
+            if (texture->DescRef.B_KeepInitialState){
+                RequireTextureState(texture, AllSubresources, texture->DescRef.InitialState);
+            }
+        }
+        for (BufferStateExtension* buffer : _buffers){
+            if (buffer->DescRef.B_KeepInitialState){
+                RequireBufferState(buffer, buffer->DescRef.InitialState);
+            }
+        }
+    }
+
+    BarrierBatch EFRAPIStateTracker::CommitBarriers(){
+        _textureBarriers.clear();
+        _bufferBarriers.clear();
+        std::ranges::copy_if(_pendingTextureBarriers, std::back_inserter(_textureBarriers),
+                             [](const TextureBarrier& barrier){ return barrier.Texture != nullptr; });
+        std::ranges::copy_if(_pendingBufferBarriers, std::back_inserter(_bufferBarriers),
+                             [](const BufferBarrier& barrier){ return barrier.Buffer != nullptr; });
+        _pendingTextureBarriers.clear();
+        _pendingBufferBarriers.clear();
+        ++_pendingBatch;
+
+        const size_t barriers = _textureBarriers.size() + _bufferBarriers.size();
+        _stats.BarriersIssued += barriers;
+        if (barriers > 0){
+            ++_stats.Batches;
+        }
+        return {_textureBarriers, _bufferBarriers};
+    }
+
+    F_ResourceStates EFRAPIStateTracker::GetTextureSubresourceState(TextureStateExtension* texture,
+                                                                    const ArraySlice arraySlice,
+                                                                    const MipLevel mipLevel) const{
+        const uint32 subresource = texture->GetSubresourceIndex(mipLevel, arraySlice);
+        if (const auto tracking = _textureStates.find(texture); tracking != _textureStates.end()){
+            return tracking->second.States.Get(subresource);
+        }
+        return GetExecutedStates(texture).Get(subresource);
+    }
+
+    F_ResourceStates EFRAPIStateTracker::GetBufferState(BufferStateExtension* buffer) const{
+        if (const auto tracking = _bufferStates.find(buffer); tracking != _bufferStates.end()){
+            return tracking->second.State;
+        }
+        return GetExecutedState(buffer);
+    }
+
+    void EFRAPIStateTracker::CommandListExecuted(){
+        for (TextureStateExtension* texture : _textures){
+            const TextureTracking& tracking = _textureStates.find(texture)->second;
+            texture->States = tracking.States;
+            if (tracking.B_IsPermanent){
+                texture->PermanentState = tracking.States.State;
+            }
+        }
+        for (BufferStateExtension* buffer : _buffers){
+            const BufferTracking& tracking = _bufferStates.find(buffer)->second;
+            buffer->State = tracking.State;
+            if (tracking.B_IsPermanent){
+                buffer->PermanentState = tracking.State;
+            }
+        }
+    }
+
+    void EFRAPIStateTracker::Reset(){
+        _textureStates.clear();
+        _bufferStates.clear();
+        _textures.clear();
+        _buffers.clear();
+        _pendingTextureBarriers.clear();
+        _pendingBufferBarriers.clear();
+        _textureBarriers.clear();
+        _bufferBarriers.clear();
+        ++_pendingBatch;
+    }
+
+    EFRAPIStateTracker::TextureTracking& EFRAPIStateTracker::GetTextureTracking(TextureStateExtension* texture){
+        auto [tracking, bInserted] = _textureStates.try_emplace(texture);
+        if (bInserted){
+            tracking->second.States = GetExecutedStates(texture);
+            _textures.push_back(texture);
+        }
+        return tracking->second;
+    }
+
+    EFRAPIStateTracker::BufferTracking& EFRAPIStateTracker::GetBufferTracking(BufferStateExtension* buffer){
+        auto [tracking, bInserted] = _bufferStates.try_emplace(buffer);
+        if (bInserted){
+            tracking->second.State = GetExecutedState(buffer);
+            _buffers.push_back(buffer);
+        }
+        return tracking->second;
+    }
+
+    void EFRAPIStateTracker::TransitionTexture(TextureStateExtension* texture, TextureTracking& tracking,
+                                               const uint32 subresource, const F_ResourceStates before,
+                                               const F_ResourceStates after){
+        const bool bIsUavBarrier = IsUavBarrier(before, after, tracking.B_EnableUavBarriers);
+        if (before == after && !bIsUavBarrier){
+            ++_stats.BarriersElided;
+            return;
+        }
+
+        if (tracking.PendingBatch != _pendingBatch){
+            tracking.PendingBatch = _pendingBatch;
+            tracking.EntireBarrier = NO_PENDING_BARRIER;
+            tracking.FirstSubresourceBarrier = NO_PENDING_BARRIER;
+        }
+
+        TextureBarrier* pending = nullptr;
+        if (subresource == NO_SUBRESOURCE){
+            if (tracking.EntireBarrier != NO_PENDING_BARRIER){
+                pending = &_pendingTextureBarriers[tracking.EntireBarrier];
+            }
+        }
+        else if (tracking.FirstSubresourceBarrier != NO_PENDING_BARRIER){
+            const MipLevel mipLevel = subresource % texture->DescRef.MipLevels;
+            const ArraySlice arraySlice = subresource / texture->DescRef.MipLevels;
+            const auto found = std::find_if(_pendingTextureBarriers.begin() + tracking.FirstSubresourceBarrier,
+                                            _pendingTextureBarriers.end(), [&](const TextureBarrier& barrier){
+                                                return barrier.Texture == texture && !barrier.B_IsEntireTexture &&
+                                                    barrier.TexMipLevel == mipLevel &&
+                                                    barrier.TexArraySlice == arraySlice;
+                                            });
+            if (found != _pendingTextureBarriers.end()){
+                pending = &*found;
+            }
+        }
+
+        if (pending){
+            // The resource is not used between the barriers of a batch, one barrier to the last state does
+            ++_stats.BarriersElided;
+            pending->StateAfter = after;
+            if (pending->StateBefore == after && !IsUavBarrier(pending->StateBefore, after,
+                                                                tracking.B_EnableUavBarriers)){
+                ++_stats.BarriersElided;
+                pending->Texture = nullptr;
+                if (subresource == NO_SUBRESOURCE){
+                    tracking.EntireBarrier = NO_PENDING_BARRIER;
+                }
+            }
+            return;
+        }
+
+        TextureBarrier& barrier = _pendingTextureBarriers.emplace_back();
+        const uint32 index = static_cast<uint32>(_pendingTextureBarriers.size() - 1);
+        barrier.Texture = texture;
+        barrier.StateBefore = before;
+        barrier.StateAfter = after;
+        if (subresource == NO_SUBRESOURCE){
+            barrier.B_IsEntireTexture = true;
+            tracking.EntireBarrier = index;
+        }
+        else{
+            barrier.TexMipLevel = subresource % texture->DescRef.MipLevels;
+            barrier.TexArraySlice = subresource / texture->DescRef.MipLevels;
+            tracking.FirstSubresourceBarrier = std::min(tracking.FirstSubresourceBarrier, index);
+        }
+    }
+
+    void EFRAPIStateTracker::TransitionBuffer(BufferStateExtension* buffer, BufferTracking& tracking,
+                                              const F_ResourceStates before, const F_ResourceStates after){
+        const bool bIsUavBarrier = IsUavBarrier(before, after, tracking.B_EnableUavBarriers);
+        if (before == after && !bIsUavBarrier){
+            ++_stats.BarriersElided;
+            return;
+        }
+
+        if (tracking.PendingBatch == _pendingBatch && tracking.Barrier != NO_PENDING_BARRIER){
+            ++_stats.BarriersElided;
+            BufferBarrier& pending = _pendingBufferBarriers[tracking.Barrier];
+            pending.StateAfter = after;
+            if (pending.StateBefore == after && !IsUavBarrier(pending.StateBefore, after,
+                                                               tracking.B_EnableUavBarriers)){
+                ++_stats.BarriersElided;
+                pending.Buffer = nullptr;
+                tracking.Barrier = NO_PENDING_BARRIER;
+            }
+            return;
+        }
+
+        tracking.PendingBatch = _pendingBatch;
+        tracking.Barrier = static_cast<uint32>(_pendingBufferBarriers.size());
+        _pendingBufferBarriers.push_back({buffer, before, after});
+    }
+} // EventfulEngine
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "EFRAPIUploadManager.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace EventfulEngine{
+    namespace{
+        // Every chunk starts at an offset a constant buffer version can be bound at
+        constexpr uint64 CHUNK_ALIGNMENT = c_ConstantBufferOffsetSizeAlignment;
+
+        constexpr uint64 AlignUp(const uint64 value, const uint64 alignment){
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        BufferDesc UploadBufferDesc(const uint64 size, const char* debugName){
+            return BufferDesc().SetByteSize(size).SetCpuAccess(E_CpuAccessMode::Write).SetDebugName(debugName).
+                                SetInitialState(F_ResourceStates::CopySource).SetKeepInitialState(true);
+        }
+    }
+
+    EFRAPIUploadManager::EFRAPIUploadManager(EFDynamicRAPI* device, const uint64 ringSize)
+        : _device(device), _ringSize(AlignUp(ringSize, CHUNK_ALIGNMENT)){
+        _ringBuffer = _device->CreateBuffer(UploadBufferDesc(_ringSize, "UploadRing"));
+        if (_ringBuffer){
+            _ringMemory = static_cast<uint8*>(_device->MapBuffer(_ringBuffer, E_CpuAccessMode::Write));
+        }
+        assert(_ringMemory);
+    }
+
+    EFRAPIUploadManager::~EFRAPIUploadManager(){
+        for (const DedicatedChunk& chunk : _dedicatedChunks){
+            _device->UnmapBuffer(chunk.Buffer);
+        }
+        if (_ringMemory){
+            _device->UnmapBuffer(_ringBuffer);
+        }
+    }
+
+    UploadChunk EFRAPIUploadManager::AllocateChunk(uint64 size){
+        size = AlignUp(std::max<uint64>(size, 1), CHUNK_ALIGNMENT);
+
+        std::scoped_lock lock(_mutex);
+        ++_stats.ChunksAllocated;
+        if (size > _ringSize || !_ringMemory){
+            return AllocateDedicatedChunk(size);
+        }
+
+        Reclaim();
+        uint64 offset = 0;
+        while (!TryAllocateRange(size, offset)){
+            if (!WaitForOldestChunk()){
+                return AllocateDedicatedChunk(size);
+            }
+            Reclaim();
+        }
+
+        UploadChunk chunk;
+        chunk.Buffer = _ringBuffer;
+        chunk.CpuAddress = _ringMemory + offset;
+        chunk.Offset = offset;
+        chunk.Size = size;
+        chunk.Sequence = _firstSequence + _chunks.size();
+        _chunks.push_back({offset, offset + size});
+        return chunk;
+    }
+
+    bool EFRAPIUploadManager::TryAllocateRange(const uint64 size, uint64& outOffset){
+        if (_chunks.empty()){
+            _head = 0;
+        }
+
+        const uint64 tail = _chunks.empty() ? 0 : _chunks.front().Begin;
+        if (_chunks.empty() || _head > tail){
+            // Free space at the end of the ring, then from its start up to the tail
+            if (size <= _ringSize - _head){
+                outOffset = _head;
+            }
+            else if (size <= tail){
+                outOffset = 0;
+            }
+            else{
+                return false;
+            }
+        }
+        else if (_head < tail && size <= tail - _head){
+            outOffset = _head;
+        }
+        else{
+            // The head caught up with the tail, the ring is full
+            return false;
+        }
+
+        _head = outOffset + size;
+        return true;
+    }
+
+    void EFRAPIUploadManager::RetireChunks(const std::span<UploadChunk> chunks, const E_CommandQueue queue){
+        if (chunks.empty()){
+            return;
+        }
+
+        std::scoped_lock lock(_mutex);
+        const uint64 fence = GetQueue(queue).Next;
+        for (UploadChunk& chunk : chunks){
+            if (!chunk.Buffer){
+                continue;
+            }
+            if (chunk.Dedicated){
+                _dedicatedChunks.push_back({std::move(chunk.Dedicated), queue, fence});
+                continue;
+            }
+            RingChunk& ringChunk = _chunks[chunk.Sequence - _firstSequence];
+            ringChunk.Queue = queue;
+            ringChunk.Fence = fence;
+        }
+    }
+
+    void EFRAPIUploadManager::SignalSubmission(const E_CommandQueue queue){
+        std::scoped_lock lock(_mutex);
+        EventQueryHandle query;
+        if (_freeQueries.empty()){
+            query = _device->CreateEventQuery();
+        }
+        else{
+            query = std::move(_freeQueries.back());
+            _freeQueries.pop_back();
+        }
+        _device->SetEventQuery(query, queue);
+
+        QueueFences& fences = GetQueue(queue);
+        fences.Pending.push_back({fences.Next, std::move(query)});
+        ++fences.Next;
+    }
+
+    void EFRAPIUploadManager::Reclaim(){
+        for (QueueFences& fences : _queues){
+            while (!fences.Pending.empty() && _device->PollEventQuery(fences.Pending.front().Query)){
+                PendingFence& completed = fences.Pending.front();
+                fences.Completed = completed.Value;
+                _device->ResetEventQuery(completed.Query);
+                _freeQueries.push_back(std::move(completed.Query));
+                fences.Pending.pop_front();
+            }
+        }
+
+        // Only the tail can be freed, chunks retired out of order wait for the ones allocated before them
+        while (!_chunks.empty() && _chunks.front().Fence != 0 &&
+            _chunks.front().Fence <= GetQueue(_chunks.front().Queue).Completed){
+            _chunks.pop_front();
+            ++_firstSequence;
+        }
+
+        std::erase_if(_dedicatedChunks, [this](const DedicatedChunk& chunk){
+            if (chunk.Fence > GetQueue(chunk.Queue).Completed){
+                return false;
+            }
+            _device->UnmapBuffer(chunk.Buffer);
+            return true;
+        });
+    }
+
+    bool EFRAPIUploadManager::WaitForOldestChunk(){
+        if (_chunks.empty()){
+            return false;
+        }
+
+        const RingChunk& oldest = _chunks.front();
+        QueueFences& fences = GetQueue(oldest.Queue);
+        // Still recording, or retired after the last submission of its queue
+        if (oldest.Fence == 0 || oldest.Fence >= fences.Next){
+            return false;
+        }
+
+        ++_stats.RingStalls;
+        if (!fences.Pending.empty() && oldest.Fence >= fences.Pending.front().Value){
+            _device->WaitEventQuery(fences.Pending[oldest.Fence - fences.Pending.front().Value].Query);
+        }
+        return true;
+    }
+
+    UploadChunk EFRAPIUploadManager::AllocateDedicatedChunk(const uint64 size){
+        UploadChunk chunk;
+        chunk.Dedicated = _device->CreateBuffer(UploadBufferDesc(size, "UploadChunk"));
+        if (!chunk.Dedicated){
+            return chunk;
+        }
+        chunk.Buffer = chunk.Dedicated;
+        chunk.CpuAddress = static_cast<uint8*>(_device->MapBuffer(chunk.Dedicated, E_CpuAccessMode::Write));
+        chunk.Size = size;
+        ++_stats.DedicatedChunks;
+        return chunk;
+    }
+
+    void EFRAPIUploadManager::EndFrame(){
+        std::scoped_lock lock(_mutex);
+        _stats.BytesUploadedLastFrame = _bytesThisFrame.exchange(0, std::memory_order_relaxed);
+        _stats.BytesUploaded += _stats.BytesUploadedLastFrame;
+    }
+
+    UploadManagerStats EFRAPIUploadManager::GetStats(){
+        std::scoped_lock lock(_mutex);
+        UploadManagerStats stats = _stats;
+        stats.BytesUploaded += _bytesThisFrame.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void EFRAPIUploadManager::ResetStats(){
+        std::scoped_lock lock(_mutex);
+        _stats = {};
+        _bytesThisFrame.store(0, std::memory_order_relaxed);
+    }
+
+    EFRAPIUploadWriter::EFRAPIUploadWriter(EFRAPIUploadManager* manager, const uint64 chunkSize,
+                                           const E_CommandQueue queue)
+        : _manager(manager), _chunkSize(chunkSize), _queue(queue){
+    }
+
+    EFRAPIUploadWriter::~EFRAPIUploadWriter(){
+        Retire();
+    }
+
+    UploadAllocation EFRAPIUploadWriter::Allocate(const uint64 size, const uint64 alignment){
+        assert(std::has_single_bit(alignment));
+        if (!_chunks.empty()){
+            const UploadChunk& chunk = _chunks.back();
+            const uint64 offset = AlignUp(chunk.Offset + _currentOffset, alignment) - chunk.Offset;
+            if (chunk.CpuAddress && offset + size <= chunk.Size){
+                _currentOffset = offset + size;
+                _manager->AddUploadedBytes(size);
+                return {chunk.Buffer, chunk.CpuAddress + offset, chunk.Offset + offset};
+            }
+        }
+
+        const UploadChunk& chunk = _chunks.emplace_back(_manager->AllocateChunk(std::max(_chunkSize, size + alignment)));
+        if (!chunk.CpuAddress){
+            return {};
+        }
+        const uint64 offset = AlignUp(chunk.Offset, alignment) - chunk.Offset;
+        _currentOffset = offset + size;
+        _manager->AddUploadedBytes(size);
+        return {chunk.Buffer, chunk.CpuAddress + offset, chunk.Offset + offset};
+    }
+
+    void EFRAPIUploadWriter::Retire(){
+        _manager->RetireChunks(_chunks, _queue);
+        _chunks.clear();
+        _currentOffset = 0;
+    }
+} // EventfulEngine
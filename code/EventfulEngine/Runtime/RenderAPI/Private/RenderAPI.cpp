@@ -20,11 +20,12 @@ namespace EventfulEngine{
     }
 
     void RenderAPIModule::InitializeDynamicRAPI(E_RenderAPI api){
+        // Backends are loaded by the module names of their efmoddef
         switch (api){
             using enum E_RenderAPI;
-        case Headless: _currentRAPIName = "Headless";
+        case Headless: _currentRAPIName = "EFRenderAPIHeadless";
             break;
-        case OpenGL: _currentRAPIName = "OpenGL";
+        case OpenGL: _currentRAPIName = "EFRenderAPIOpenGL";
             break;
         default: break;
         }
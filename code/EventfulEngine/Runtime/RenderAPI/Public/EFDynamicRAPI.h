@@ -1,6 +1,8 @@
 #pragma once
 
 #include <IModule.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "EFRAPICommandList.h"
@@ -102,6 +104,25 @@ namespace EventfulEngine{
 
         virtual MeshletPipelineHandle CreateMeshletPipeline(const MeshletPipelineDesc& desc, EFRAPIFramebuffer* fb) = 0;
 
+        // Program binary of a graphics or compute pipeline, for the disk cache of EFRAPIPipelineCache.
+        // Backends without program binaries return false.
+        virtual bool GetPipelineBinary(EFRAPIResource* /*pipeline*/, std::vector<uint8>& /*outBinary*/){
+            return false;
+        }
+
+        // Creates a pipeline from a binary returned by GetPipelineBinary for the same description. Backends that
+        // reject the binary, e.g. after a driver update, compile the description instead.
+        virtual GraphicsPipelineHandle CreateGraphicsPipelineFromBinary(const GraphicsPipelineDesc& desc,
+                                                                        EFRAPIFramebuffer* fb, const void* /*binary*/,
+                                                                        size_t /*binarySize*/){
+            return CreateGraphicsPipeline(desc, fb);
+        }
+
+        virtual ComputePipelineHandle CreateComputePipelineFromBinary(const ComputePipelineDesc& desc,
+                                                                      const void* /*binary*/, size_t /*binarySize*/){
+            return CreateComputePipeline(desc);
+        }
+
         virtual BindingLayoutHandle CreateBindingLayout(const BindingLayoutDesc& desc) = 0;
 
         virtual BindingLayoutHandle CreateBindlessLayout(const BindlessLayoutDesc& desc) = 0;
@@ -170,6 +191,13 @@ namespace EventfulEngine{
         const EFChar* debugName,
         uint32 maxVersions);
 
+    // Layout matching the items of a binding set, one slot per item
+    EFRENDERAPI_API BindingLayoutDesc CreateBindingLayoutDesc(
+        F_ShaderType visibility,
+        uint32 registerSpace,
+        const BindingSetDesc& bindingSetDesc,
+        bool registerSpaceIsDescriptorSet = false);
+
     EFRENDERAPI_API bool CreateBindingSetAndLayout(
         F_ShaderType visibility,
         uint32 registerSpace,
@@ -239,21 +267,33 @@ namespace EventfulEngine{
 
     void InvalidEnum();
 
+    // Slot allocator over 64 bit words, a set bit is an allocated slot. Summary levels above the words hold one bit
+    // per word of the level below that is set while that word is full, so Allocate() descends to a free slot in
+    // O(log64 n) word reads instead of scanning every slot. Allocate() and Release() are lock-free, a slot is taken
+    // by a CAS on its word. Allocate() returns the lowest free slot it finds, or -1 when the allocator is full.
     class BitSetAllocator{
     public:
-        explicit BitSetAllocator(size_t capacity, bool multithreaded);
+        // Allocation is always thread safe now, multithreaded is kept for source compatibility
+        EFRENDERAPI_API explicit BitSetAllocator(size_t capacity, bool multithreaded);
 
-        int Allocate();
+        EFRENDERAPI_API int Allocate();
 
-        void Release(int index);
+        EFRENDERAPI_API void Release(int index);
 
-        [[nodiscard]] size_t GetCapacity() const{ return _allocated.size(); }
+        [[nodiscard]] size_t GetCapacity() const{ return _capacity; }
 
     private:
-        int _nextAvailable = 0;
-        std::vector<bool> _allocated;
-        bool b_isMultiThreaded;
-        std::mutex _mutex;
+        struct Level{
+            std::unique_ptr<std::atomic<uint64>[]> Words;
+            size_t WordCount = 0;
+        };
+
+        // Sets the summary bits of a word that became full, up to the first summary that is not full
+        void MarkFull(size_t level, size_t wordIndex);
+
+        size_t _capacity;
+        // _levels[0] holds the slots, the last level is a single word
+        std::vector<Level> _levels;
     };
 
     // Automatic begin/end marker for command list
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace EventfulEngine{
+    struct BindingCacheStats{
+        uint64 LayoutHits = 0;
+        uint64 LayoutCreations = 0;
+        uint64 SetHits = 0;
+        uint64 SetCreations = 0;
+        // Sets released after going unused, once the fence of the last frame that used them signaled
+        uint64 SetsRetired = 0;
+    };
+
+    // Deduplicates binding layouts by their description and pools binding sets by the content of their description
+    // and their layout, so per-draw material bindings reuse the set of an earlier draw or frame instead of creating
+    // one. Layouts live as long as the cache. A set unused for the given number of frames is retired when the event
+    // query of the last frame that used it has signaled, so it is never released while the GPU may still read it,
+    // even with trackLiveness disabled.
+    // The pooled sets keep their resources alive until they are retired.
+    class EFRAPIBindingCache{
+    public:
+        EFRENDERAPI_API explicit EFRAPIBindingCache(EFDynamicRAPI* device, uint32 retireAfterFrames = 3);
+
+        NOMOVEORCOPY(EFRAPIBindingCache)
+
+        EFRENDERAPI_API BindingLayoutHandle GetBindingLayout(const BindingLayoutDesc& desc);
+
+        // Layout matching the items of the binding set, see CreateBindingLayoutDesc
+        EFRENDERAPI_API BindingLayoutHandle GetBindingLayout(F_ShaderType visibility, uint32 registerSpace,
+                                                             const BindingSetDesc& bindingSetDesc,
+                                                             bool registerSpaceIsDescriptorSet = false);
+
+        EFRENDERAPI_API BindingSetHandle GetBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout);
+
+        // Cached counterpart of CreateBindingSetAndLayout, fills the handles that are null
+        EFRENDERAPI_API bool GetBindingSetAndLayout(F_ShaderType visibility, uint32 registerSpace,
+                                                    const BindingSetDesc& bindingSetDesc,
+                                                    BindingLayoutHandle& bindingLayout, BindingSetHandle& bindingSet,
+                                                    bool registerSpaceIsDescriptorSet = false);
+
+        // Call after the frame's command lists were executed on the queue. Signals the frame fence and retires the
+        // sets whose last frame has completed and lies far enough back.
+        EFRENDERAPI_API void EndFrame(E_CommandQueue queue = E_CommandQueue::Graphics);
+
+        // Releases all layouts and sets, the caller makes sure the GPU is done with them
+        EFRENDERAPI_API void Clear();
+
+        [[nodiscard]] EFRENDERAPI_API size_t GetBindingSetCount();
+
+        [[nodiscard]] EFRENDERAPI_API uint64 GetFrameIndex();
+
+        [[nodiscard]] EFRENDERAPI_API BindingCacheStats GetStats();
+
+        EFRENDERAPI_API void ResetStats();
+
+    private:
+        struct PooledBindingSet{
+            BindingSetHandle Set;
+            uint64 LastUsedFrame = 0;
+        };
+
+        struct FrameFence{
+            uint64 Frame = 0;
+            EventQueryHandle Query;
+        };
+
+        // Releases the sets unused since a completed frame at least _retireAfterFrames back
+        void RetireBindingSets();
+
+        EFDynamicRAPI* _device;
+        uint32 _retireAfterFrames;
+
+        std::mutex _mutex;
+        std::unordered_map<BindingLayoutDesc, BindingLayoutHandle> _layouts;
+        // Sets by the hash of their description and layout, colliding sets share a bucket
+        std::unordered_map<size_t, std::vector<PooledBindingSet>> _sets;
+        size_t _setCount = 0;
+        std::deque<FrameFence> _pendingFrames;
+        std::vector<EventQueryHandle> _freeQueries;
+        uint64 _frame = 0;
+        // Every frame before this one has completed on the GPU
+        uint64 _firstIncompleteFrame = 0;
+        BindingCacheStats _stats;
+    };
+} // EventfulEngine
@@ -95,6 +95,8 @@ namespace EventfulEngine{
         uint32_t constantBuffer = 256;
         uint32_t unorderedAccess = 384;
 
+        bool operator ==(const VulkanBindingOffsets& b) const = default;
+
         constexpr VulkanBindingOffsets& setShaderResourceOffset(uint32_t value){
             shaderResource = value;
             return *this;
@@ -140,6 +142,16 @@ namespace EventfulEngine{
         std::vector<BindingLayoutItem> bindings;
         VulkanBindingOffsets bindingOffsets;
 
+        bool operator ==(const BindingLayoutDesc& b) const{
+            return visibility == b.visibility
+                && registerSpace == b.registerSpace
+                && registerSpaceIsDescriptorSet == b.registerSpaceIsDescriptorSet
+                && bindings == b.bindings
+                && bindingOffsets == b.bindingOffsets;
+        }
+
+        bool operator !=(const BindingLayoutDesc& b) const{ return !(*this == b); }
+
         BindingLayoutDesc& setVisibility(F_ShaderType value){
             visibility = value;
             return *this;
@@ -278,6 +290,7 @@ namespace EventfulEngine{
         bool operator ==(const BindingSetItem& b) const{
             return resourceHandle == b.resourceHandle
                 && slot == b.slot
+                && arrayElement == b.arrayElement
                 && type == b.type
                 && dimension == b.dimension
                 && format == b.format
@@ -582,3 +595,60 @@ namespace EventfulEngine{
     typedef RefCountPtr<IDescriptorTable> DescriptorTableHandle;
 
 } // EventfulEngine
+
+template <>
+struct std::hash<EventfulEngine::BindingLayoutItem>{
+    std::size_t operator()(EventfulEngine::BindingLayoutItem const& s) const noexcept{
+        size_t hash = 0;
+        EventfulEngine::hash_combine(hash, s.slot);
+        EventfulEngine::hash_combine(hash, static_cast<EventfulEngine::E_ResourceType>(s.type));
+        EventfulEngine::hash_combine(hash, static_cast<uint16_t>(s.size));
+        return hash;
+    }
+};
+
+template <>
+struct std::hash<EventfulEngine::BindingLayoutDesc>{
+    std::size_t operator()(EventfulEngine::BindingLayoutDesc const& s) const noexcept{
+        size_t hash = 0;
+        EventfulEngine::hash_combine(hash, s.visibility);
+        EventfulEngine::hash_combine(hash, s.registerSpace);
+        EventfulEngine::hash_combine(hash, s.registerSpaceIsDescriptorSet);
+        for (const auto& item : s.bindings){
+            EventfulEngine::hash_combine(hash, item);
+        }
+        EventfulEngine::hash_combine(hash, s.bindingOffsets.shaderResource);
+        EventfulEngine::hash_combine(hash, s.bindingOffsets.sampler);
+        EventfulEngine::hash_combine(hash, s.bindingOffsets.constantBuffer);
+        EventfulEngine::hash_combine(hash, s.bindingOffsets.unorderedAccess);
+        return hash;
+    }
+};
+
+template <>
+struct std::hash<EventfulEngine::BindingSetItem>{
+    std::size_t operator()(EventfulEngine::BindingSetItem const& s) const noexcept{
+        size_t hash = 0;
+        EventfulEngine::hash_combine(hash, s.resourceHandle);
+        EventfulEngine::hash_combine(hash, s.slot);
+        EventfulEngine::hash_combine(hash, s.arrayElement);
+        EventfulEngine::hash_combine(hash, static_cast<EventfulEngine::E_ResourceType>(s.type));
+        EventfulEngine::hash_combine(hash, static_cast<EventfulEngine::E_TextureDimension>(s.dimension));
+        EventfulEngine::hash_combine(hash, static_cast<EventfulEngine::E_Format>(s.format));
+        EventfulEngine::hash_combine(hash, s.rawData[0]);
+        EventfulEngine::hash_combine(hash, s.rawData[1]);
+        return hash;
+    }
+};
+
+// Matches BindingSetDesc::operator==, trackLiveness does not take part
+template <>
+struct std::hash<EventfulEngine::BindingSetDesc>{
+    std::size_t operator()(EventfulEngine::BindingSetDesc const& s) const noexcept{
+        size_t hash = 0;
+        for (const auto& item : s.bindings){
+            EventfulEngine::hash_combine(hash, item);
+        }
+        return hash;
+    }
+};
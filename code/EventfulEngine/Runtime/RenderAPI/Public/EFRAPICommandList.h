@@ -350,6 +350,12 @@ namespace EventfulEngine{
         // Has no effect on DX11.
         virtual void SetPermanentBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) = 0;
 
+        // Places an aliasing barrier that hands heap memory to a placed texture or buffer, after other placed
+        // resources overlapping it were used. Must come before the first use of the resource and before its state
+        // transitions, its contents are undefined afterwards until they are written.
+        // Has no effect on DX11.
+        virtual void PlaceAliasingBarrier(EFRAPIResource* resource) = 0;
+
         // Flushes the barriers from the pending list into the graphics API command list.
         // Has no effect on DX11.
         virtual void CommitBarriers() = 0;
@@ -370,6 +376,18 @@ namespace EventfulEngine{
 
         // Returns the CommandListParameters structure that was used to create the command list.
         virtual const CommandListParameters& GetDesc() = 0;
+
+        // Number of draws and dispatches recorded since the last Open(), including the indirect and meshlet variants.
+        // Backends count them in their Draw* and Dispatch* implementations and reset them in Open().
+        struct RecordingStats{
+            uint32 DrawCalls = 0;
+            uint32 Dispatches = 0;
+        };
+
+        [[nodiscard]] const RecordingStats& GetRecordingStats() const{ return _recordingStats; }
+
+    protected:
+        RecordingStats _recordingStats;
     };
 
     typedef RefCountPtr<EFRAPICommandList> CommandListHandle;
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "EFRAPIBasicTypes.h"
+#include "CoreMacros.h"
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace EventfulEngine{
+    // Linear stream of recorded commands in arena memory.
+    // Every command is a trivially copyable record behind a CommandHeader, optionally followed by a payload, placed back
+    // to back in large chunks. A command never spans two chunks. Reset() keeps the chunks, so a stream that is recorded
+    // every frame stops allocating once it has seen its largest frame.
+    // The stream only stores bytes, it does not know what the commands mean. See EFRAPIDeferredCommandList.
+    class EFRAPICommandStream{
+    public:
+        struct CommandHeader{
+            uint16 Op = 0;
+            uint16 Reserved = 0;
+            // Size of the command behind the header, without the header and alignment padding
+            uint32 Size = 0;
+        };
+
+        static constexpr size_t COMMAND_ALIGNMENT = 8;
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        EFRENDERAPI_API explicit EFRAPICommandStream(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+        NOMOVEORCOPY(EFRAPICommandStream)
+
+        // Returns room for a command of up to maxSize bytes, which ends with Commit(). Only one command can be
+        // reserved at a time.
+        [[nodiscard]] EFRENDERAPI_API uint8* Reserve(uint16 op, size_t maxSize);
+
+        // Ends the reserved command, size is the part of the reserved room it actually used.
+        EFRENDERAPI_API void Commit(size_t size);
+
+        // Drops the reserved command.
+        EFRENDERAPI_API void Cancel();
+
+        // Appends a value initialized command of type T and returns it.
+        template <typename T>
+        T& Push(const uint16 op){
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                          "Command stream records must be trivially copyable");
+            static_assert(alignof(T) <= COMMAND_ALIGNMENT);
+            T* command = new(Reserve(op, sizeof(T))) T();
+            Commit(sizeof(T));
+            return *command;
+        }
+
+        // Appends a command of type T followed by payloadSize bytes, payload points to them.
+        template <typename T>
+        T& Push(const uint16 op, const size_t payloadSize, uint8*& payload){
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                          "Command stream records must be trivially copyable");
+            static_assert(alignof(T) <= COMMAND_ALIGNMENT);
+            uint8* memory = Reserve(op, sizeof(T) + payloadSize);
+            T* command = new(memory) T();
+            payload = memory + sizeof(T);
+            Commit(sizeof(T) + payloadSize);
+            return *command;
+        }
+
+        // Drops all commands and keeps the chunks for the next recording.
+        EFRENDERAPI_API void Reset();
+
+        // Calls function(op, data, size) for every command in recording order.
+        template <typename Function>
+        void ForEach(Function&& function) const{
+            for (size_t index = 0; index < _chunks.size() && index <= _currentChunk; ++index){
+                const Chunk& chunk = _chunks[index];
+                size_t offset = 0;
+                while (offset < chunk.Used){
+                    const auto* header = reinterpret_cast<const CommandHeader*>(chunk.Memory.get() + offset);
+                    const uint8* data = chunk.Memory.get() + offset + sizeof(CommandHeader);
+                    function(header->Op, data, static_cast<size_t>(header->Size));
+                    offset += AlignCommandSize(sizeof(CommandHeader) + header->Size);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t GetCommandCount() const{ return _commandCount; }
+
+        // Bytes used by commands, headers and padding
+        [[nodiscard]] size_t GetSize() const{ return _size; }
+
+        // Bytes held by the chunks, used or not
+        [[nodiscard]] size_t GetCapacity() const{ return _capacity; }
+
+        static constexpr size_t AlignCommandSize(const size_t size){
+            return (size + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+        }
+
+    private:
+        struct Chunk{
+            std::unique_ptr<uint8[]> Memory;
+            size_t Capacity = 0;
+            size_t Used = 0;
+        };
+
+        std::vector<Chunk> _chunks;
+        size_t _currentChunk = 0;
+        size_t _chunkSize;
+        CommandHeader* _reservedCommand = nullptr;
+        size_t _reservedSize = 0;
+        size_t _commandCount = 0;
+        size_t _size = 0;
+        size_t _capacity = 0;
+    };
+} // EventfulEngine
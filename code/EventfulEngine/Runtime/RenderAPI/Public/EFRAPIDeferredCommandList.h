@@ -0,0 +1,168 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "EFRAPICommandStream.h"
+
+#include <vector>
+
+namespace EventfulEngine{
+    // Command list that records into a compact EFRAPICommandStream instead of a backend command list.
+    // Recording only touches the list itself, so any number of deferred lists can be recorded on worker threads at
+    // the same time. Graphics, compute and meshlet states are delta encoded against the previous state of the list,
+    // a state that did not change between two draws costs nothing.
+    // Backends return a deferred list from CreateCommandList for CommandListParameters::enableImmediateExecution =
+    // false, and translate it with Replay() into one of their own lists on the thread calling ExecuteCommandLists.
+    // Resource states are only known to the list it is replayed into, GetTextureSubresourceState and GetBufferState
+    // return ResourceStates::Unknown.
+    class EFRENDERAPI_API EFRAPIDeferredCommandList final : public RefCounter<EFRAPICommandList>{
+    public:
+        EFRAPIDeferredCommandList(EFDynamicRAPI* device, const CommandListParameters& params);
+
+        // Returns the deferred list behind a list created with enableImmediateExecution = false, null otherwise.
+        static EFRAPIDeferredCommandList* FromCommandList(EFRAPICommandList* commandList);
+
+        // Records the stream into target, which must be open. Commands are replayed in recording order.
+        void Replay(EFRAPICommandList* target) const;
+
+        [[nodiscard]] const EFRAPICommandStream& GetStream() const{ return _stream; }
+
+        void Open() override;
+
+        void Close() override;
+
+        void ClearState() override;
+
+        void ClearTextureFloat(EFRAPITexture* t, TextureSubresourceSet subresources, const Color& clearColor) override;
+
+        void ClearDepthStencilTexture(EFRAPITexture* t, TextureSubresourceSet subresources, bool clearDepth,
+                                      float depth, bool clearStencil, uint8_t stencil) override;
+
+        void ClearTextureUInt(EFRAPITexture* t, TextureSubresourceSet subresources, uint32_t clearColor) override;
+
+        void CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void CopyTexture(EFRAPIStagingTexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPIStagingTexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void WriteTexture(EFRAPITexture* dest, uint32_t arraySlice, uint32_t mipLevel, const void* data,
+                          size_t rowPitch, size_t depthPitch) override;
+
+        void ResolveTexture(EFRAPITexture* dest, const TextureSubresourceSet& dstSubresources, EFRAPITexture* src,
+                            const TextureSubresourceSet& srcSubresources) override;
+
+        void WriteBuffer(EFRAPIBuffer* b, const void* data, size_t dataSize, uint64_t destOffsetBytes) override;
+
+        void ClearBufferUInt(EFRAPIBuffer* b, uint32_t clearValue) override;
+
+        void CopyBuffer(EFRAPIBuffer* dest, uint64_t destOffsetBytes, EFRAPIBuffer* src, uint64_t srcOffsetBytes,
+                        uint64_t dataSizeBytes) override;
+
+        void ClearSamplerFeedbackTexture(EFRAPISamplerFeedbackTexture* texture) override;
+
+        void DecodeSamplerFeedbackTexture(EFRAPIBuffer* buffer, EFRAPISamplerFeedbackTexture* texture,
+                                          E_Format format) override;
+
+        void SetSamplerFeedbackTextureState(EFRAPISamplerFeedbackTexture* texture,
+                                            F_ResourceStates stateBits) override;
+
+        void SetPushConstants(const void* data, size_t byteSize) override;
+
+        void SetGraphicsState(const GraphicsState& state) override;
+
+        void Draw(const DrawArguments& args) override;
+
+        void DrawIndexed(const DrawArguments& args) override;
+
+        void DrawIndirect(uint32_t offsetBytes, uint32_t drawCount) override;
+
+        void DrawIndexedIndirect(uint32_t offsetBytes, uint32_t drawCount) override;
+
+        void SetComputeState(const ComputeState& state) override;
+
+        void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+        void DispatchIndirect(uint32_t offsetBytes) override;
+
+        void SetMeshletState(const MeshletState& state) override;
+
+        void DispatchMesh(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+        void BeginTimerQuery(EFRAPITimerQuery* query) override;
+
+        void EndTimerQuery(EFRAPITimerQuery* query) override;
+
+        void BeginMarker(const char* name) override;
+
+        void EndMarker() override;
+
+        void SetEnableAutomaticBarriers(bool enable) override;
+
+        void SetResourceStatesForBindingSet(EFRAPIBindingSet* bindingSet) override;
+
+        void SetEnableUavBarriersForTexture(EFRAPITexture* texture, bool enableBarriers) override;
+
+        void SetEnableUavBarriersForBuffer(EFRAPIBuffer* buffer, bool enableBarriers) override;
+
+        void BeginTrackingTextureState(EFRAPITexture* texture, TextureSubresourceSet subresources,
+                                       F_ResourceStates stateBits) override;
+
+        void BeginTrackingBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void SetTextureState(EFRAPITexture* texture, TextureSubresourceSet subresources,
+                             F_ResourceStates stateBits) override;
+
+        void SetBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void SetPermanentTextureState(EFRAPITexture* texture, F_ResourceStates stateBits) override;
+
+        void SetPermanentBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void PlaceAliasingBarrier(EFRAPIResource* resource) override;
+
+        void CommitBarriers() override;
+
+        F_ResourceStates GetTextureSubresourceState(EFRAPITexture* texture, ArraySlice arraySlice,
+                                                    MipLevel mipLevel) override;
+
+        F_ResourceStates GetBufferState(EFRAPIBuffer* buffer) override;
+
+        EFDynamicRAPI* GetDevice() override{ return _device; }
+
+        const CommandListParameters& GetDesc() override{ return _desc; }
+
+    private:
+        // The state last written to the stream, draws and dispatches following it do not write it again
+        enum class E_BoundState : uint8{
+            None,
+            Graphics,
+            Compute,
+            Meshlet
+        };
+
+        // Appends a command that invalidates the bound state, draws and dispatches are pushed to the stream directly
+        template <typename T>
+        T& Record(uint16 op);
+
+        template <typename T>
+        T& Record(uint16 op, size_t payloadSize, uint8*& payload);
+
+        // Keeps the resource alive until the list is opened again
+        void Reference(EFRAPIResource* resource);
+
+        EFDynamicRAPI* _device;
+        CommandListParameters _desc;
+        bool _bIsOpen = false;
+
+        EFRAPICommandStream _stream;
+        std::vector<ResourceHandle> _referencedResources;
+
+        GraphicsState _graphicsState;
+        ComputeState _computeState;
+        MeshletState _meshletState;
+        E_BoundState _boundState = E_BoundState::None;
+    };
+} // EventfulEngine
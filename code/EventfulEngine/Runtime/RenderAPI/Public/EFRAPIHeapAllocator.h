@@ -0,0 +1,163 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+
+#include <functional>
+#include <vector>
+
+namespace EventfulEngine{
+    // Range of a heap handed out by EFRAPIHeapAllocator, pass it back to Free()
+    struct HeapAllocation{
+        IHeap* Heap = nullptr;
+        uint64 Offset = 0;
+        uint64 Size = 0;
+        // Given to Allocate(), the resource placed in the range for the allocator's own helpers
+        void* UserData = nullptr;
+        uint32 Node = ~0u;
+
+        [[nodiscard]] bool IsValid() const{ return Heap != nullptr; }
+    };
+
+    struct HeapBlockStats{
+        IHeap* Heap = nullptr;
+        uint64 Capacity = 0;
+        uint64 UsedBytes = 0;
+        uint32 AllocationCount = 0;
+        uint32 FreeRanges = 0;
+        uint64 LargestFreeRange = 0;
+        // 1 - largest free range / free bytes, 0 when all free memory is one range
+        float Fragmentation = 0.0f;
+    };
+
+    struct HeapAllocatorStats{
+        uint64 Allocations = 0;
+        uint64 Frees = 0;
+        uint64 HeapsCreated = 0;
+        uint64 HeapsReleased = 0;
+        // Allocations relocated by Defragment()
+        uint64 Moves = 0;
+        uint64 UsedBytes = 0;
+        uint64 ReservedBytes = 0;
+    };
+
+    // Two level segregated fit sub-allocator for placed resources. Manages heaps of a fixed block size, requests
+    // larger than a block get a heap of their own. Free ranges of all heaps are kept in size class lists indexed by
+    // the most significant bit of their size and the next SL bits, allocating and freeing is constant time and
+    // merges neighbouring free ranges right away.
+    // Freeing does not wait for the GPU, the caller frees an allocation once no submitted work uses it anymore.
+    class EFRAPIHeapAllocator{
+    public:
+        // Called by Defragment() for every allocation it relocates, from is still valid. Create the resource again at
+        // to, copy its contents over and return true, or return false to keep it at from. Must not call back into
+        // the allocator.
+        using DefragmentCallback = std::function<bool(const HeapAllocation& from, const HeapAllocation& to)>;
+
+        EFRENDERAPI_API EFRAPIHeapAllocator(EFDynamicRAPI* device, HeapType type, uint64 blockSize = 64 * 1024 * 1024);
+
+        NOMOVEORCOPY(EFRAPIHeapAllocator)
+
+        // Thread safe, an invalid allocation if the device failed to create a heap
+        [[nodiscard]] EFRENDERAPI_API HeapAllocation Allocate(const MemoryRequirements& requirements,
+                                                              void* userData = nullptr);
+
+        // Thread safe
+        EFRENDERAPI_API void Free(const HeapAllocation& allocation);
+
+        // Creates a virtual buffer and binds it to an allocation of its memory requirements, UserData is the buffer
+        EFRENDERAPI_API BufferHandle CreateBuffer(BufferDesc desc, HeapAllocation& outAllocation);
+
+        // Creates a virtual texture and binds it to an allocation of its memory requirements, UserData is the texture
+        EFRENDERAPI_API TextureHandle CreateTexture(TextureDesc desc, HeapAllocation& outAllocation);
+
+        // Moves the allocations out of the least used heaps into free ranges of the fuller ones, at most maxMoves of
+        // them, and releases the heaps that end up empty. Returns the number of allocations moved.
+        EFRENDERAPI_API uint32 Defragment(const DefragmentCallback& callback, uint32 maxMoves = ~0u);
+
+        // Releases the heaps without allocations
+        EFRENDERAPI_API void ReleaseEmptyHeaps();
+
+        [[nodiscard]] EFRENDERAPI_API std::vector<HeapBlockStats> GetHeapStats();
+
+        [[nodiscard]] EFRENDERAPI_API HeapAllocatorStats GetStats();
+
+        EFRENDERAPI_API void ResetStats();
+
+    private:
+        static constexpr uint32 GRANULARITY_SHIFT = 8;
+        static constexpr uint32 SL_SHIFT = 4;
+        static constexpr uint32 SL_COUNT = 1 << SL_SHIFT;
+        static constexpr uint32 FL_COUNT = 64 - GRANULARITY_SHIFT;
+        static constexpr uint32 INVALID_NODE = ~0u;
+        static constexpr uint32 INVALID_BLOCK = ~0u;
+
+        // A range of a heap, free or allocated, linked to its physical neighbours in the same heap
+        struct Node{
+            uint64 Offset = 0;
+            uint64 Size = 0;
+            uint64 Alignment = 0;
+            void* UserData = nullptr;
+            uint32 Block = 0;
+            uint32 PrevPhysical = INVALID_NODE;
+            uint32 NextPhysical = INVALID_NODE;
+            uint32 PrevFree = INVALID_NODE;
+            uint32 NextFree = INVALID_NODE;
+            bool B_IsFree = true;
+        };
+
+        struct HeapBlock{
+            HeapHandle Heap;
+            uint64 Capacity = 0;
+            uint64 UsedBytes = 0;
+            uint32 AllocationCount = 0;
+            uint32 FirstNode = INVALID_NODE;
+            // Free ranges are kept out of the free lists while Defragment() empties the heap
+            bool B_IsEvacuating = false;
+        };
+
+        static void MapSize(uint64 size, uint32& outFl, uint32& outSl);
+
+        // Free node of at least size bytes, INVALID_NODE if there is none
+        uint32 FindFreeNode(uint64 size) const;
+
+        void InsertFreeNode(uint32 node);
+
+        void RemoveFreeNode(uint32 node);
+
+        uint32 CreateNode();
+
+        void ReleaseNode(uint32 node);
+
+        // Splits the range after the first size bytes of the node off into a free node
+        void SplitNode(uint32 node, uint64 size);
+
+        // Absorbs the free physical successor of the node
+        void MergeWithNext(uint32 node);
+
+        // Index of the new heap, INVALID_BLOCK if the device failed to create it
+        uint32 CreateBlock(uint64 capacity);
+
+        void ReleaseBlock(uint32 block);
+
+        HeapAllocation AllocateNode(uint64 size, uint64 alignment, void* userData, bool allowNewHeap);
+
+        void FreeNode(uint32 node);
+
+        HeapAllocation GetAllocation(uint32 node) const;
+
+        EFDynamicRAPI* _device;
+        HeapType _type;
+        uint64 _blockSize;
+
+        std::mutex _mutex;
+        std::vector<Node> _nodes;
+        std::vector<uint32> _freeNodes;
+        std::vector<HeapBlock> _blocks;
+        std::vector<uint32> _freeBlocks;
+
+        uint64 _flBitmap = 0;
+        uint32 _slBitmaps[FL_COUNT] = {};
+        uint32 _freeHeads[FL_COUNT][SL_COUNT];
+
+        HeapAllocatorStats _stats;
+    };
+} // EventfulEngine
@@ -77,6 +77,8 @@ namespace EventfulEngine{
     struct CommandListParameters{
         // A command list with enableImmediateExecution = true maps to the immediate context on DX11.
         // Two immediate command lists cannot be open at the same time, which is checked by the validation layer.
+        // With enableImmediateExecution = false the list is an EFRAPIDeferredCommandList, which can be recorded on
+        // any thread and is translated by the backend when it is executed.
         bool enableImmediateExecution = true;
 
         // Minimum size of memory chunks created to upload data to the device on DX12.
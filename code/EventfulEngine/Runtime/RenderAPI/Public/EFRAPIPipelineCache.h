@@ -0,0 +1,130 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "FileSystem.h"
+#include "Thread.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+namespace EventfulEngine{
+    // Stable content hashes of pipeline descriptions. Shaders are hashed by their bytecode, entry point and
+    // specialization constants, layouts by their items, so the same description hashes the same in every run and
+    // every process. Object identity never takes part.
+    EFRENDERAPI_API uint64 HashGraphicsPipeline(const GraphicsPipelineDesc& desc, const FramebufferInfo& framebufferInfo);
+
+    EFRENDERAPI_API uint64 HashComputePipeline(const ComputePipelineDesc& desc);
+
+    struct PipelineCacheStats{
+        // Requests served by a pipeline that was already created
+        uint64 Hits = 0;
+        // Requests that created a pipeline
+        uint64 Misses = 0;
+        // Pipelines created or waited for on the requesting thread, the frame stalls for their compilation
+        uint64 Hitches = 0;
+        // Pipelines compiled in the background for RequestGraphicsPipeline and RequestComputePipeline
+        uint64 AsyncCompilations = 0;
+        // Requests answered with the placeholder because their pipeline was still compiling
+        uint64 Placeholders = 0;
+        // Pipelines created from a binary of the disk cache
+        uint64 BinariesLoaded = 0;
+        // Pipelines the device failed to create, they are not cached and the next request tries again
+        uint64 Failures = 0;
+    };
+
+    // Deduplicates pipelines by the content hash of their description.
+    // Get* returns the cached pipeline or creates it on the calling thread. Concurrent requests for the same
+    // description create it once, the others wait for it. Request* never compiles on the calling thread, it queues a
+    // compilation for the cache's compile threads and returns the given placeholder until the pipeline is ready.
+    // A failed creation answers its waiters with null and is forgotten, so a later request tries again.
+    // With a backend that supports GetPipelineBinary, Save() writes the program binaries of all pipelines, and a cache
+    // that loaded them creates pipelines from the binaries instead of compiling the descriptions.
+    class EFRAPIPipelineCache{
+    public:
+        // At most compileThreads pipelines compile in the background at once, 0 uses half the hardware threads.
+        // The threads start with the first Request* call.
+        EFRENDERAPI_API explicit EFRAPIPipelineCache(EFDynamicRAPI* device, uint32 compileThreads = 0);
+
+        // Waits for the background compilations and stops the compile threads
+        EFRENDERAPI_API ~EFRAPIPipelineCache();
+
+        NOMOVEORCOPY(EFRAPIPipelineCache)
+
+        EFRENDERAPI_API GraphicsPipelineHandle GetGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                   EFRAPIFramebuffer* fb);
+
+        EFRENDERAPI_API ComputePipelineHandle GetComputePipeline(const ComputePipelineDesc& desc);
+
+        EFRENDERAPI_API GraphicsPipelineHandle RequestGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                       EFRAPIFramebuffer* fb,
+                                                                       EFRAPIGraphicsPipeline* placeholder = nullptr);
+
+        EFRENDERAPI_API ComputePipelineHandle RequestComputePipeline(const ComputePipelineDesc& desc,
+                                                                     EFRAPIComputePipeline* placeholder = nullptr);
+
+        EFRENDERAPI_API void WaitForPendingCompilations();
+
+        // Reads program binaries written by Save(). Returns false if the file is missing or was written by another
+        // cache version, the cache then starts cold.
+        EFRENDERAPI_API bool Load(const EFPath& path);
+
+        EFRENDERAPI_API bool Save(const EFPath& path);
+
+        // Drops all pipelines, keeps the loaded binaries
+        EFRENDERAPI_API void Clear();
+
+        [[nodiscard]] EFRENDERAPI_API size_t GetPipelineCount();
+
+        [[nodiscard]] EFRENDERAPI_API PipelineCacheStats GetStats();
+
+        EFRENDERAPI_API void ResetStats();
+
+    private:
+        // Pipelines by content hash, the future is ready once the pipeline is created
+        template <typename Handle>
+        using PipelineMap = std::unordered_map<uint64, std::shared_future<Handle>>;
+
+        template <typename Handle, typename Create>
+        Handle GetPipeline(PipelineMap<Handle>& pipelines, uint64 hash, Create&& create);
+
+        template <typename Handle, typename Create>
+        Handle RequestPipeline(PipelineMap<Handle>& pipelines, uint64 hash, typename Handle::InterfaceType* placeholder,
+                               Create&& create);
+
+        // Drops the entry of a pipeline the device failed to create
+        template <typename Handle>
+        void ForgetPipeline(PipelineMap<Handle>& pipelines, uint64 hash);
+
+        void RunCompileThread();
+
+        GraphicsPipelineHandle CreateGraphicsPipeline(const GraphicsPipelineDesc& desc, EFRAPIFramebuffer* fb,
+                                                      uint64 hash);
+
+        ComputePipelineHandle CreateComputePipeline(const ComputePipelineDesc& desc, uint64 hash);
+
+        // Returns the loaded binary of the hash, empty if there is none
+        std::vector<uint8> FindBinary(uint64 hash);
+
+        void StoreBinary(uint64 hash, EFRAPIResource* pipeline);
+
+        EFDynamicRAPI* _device;
+        uint32 _maxCompileThreads;
+
+        std::mutex _mutex;
+        PipelineMap<GraphicsPipelineHandle> _graphicsPipelines;
+        PipelineMap<ComputePipelineHandle> _computePipelines;
+        // Queued background compilations, the compile threads take them in request order
+        std::vector<Thread> _compileThreads;
+        std::deque<std::function<void()>> _compileQueue;
+        std::condition_variable _compileReady;
+        std::condition_variable _compilationsDone;
+        uint32 _busyCompileThreads = 0;
+        bool _bIsStopping = false;
+        std::unordered_map<uint64, std::vector<uint8>> _binaries;
+        PipelineCacheStats _stats;
+    };
+} // EventfulEngine
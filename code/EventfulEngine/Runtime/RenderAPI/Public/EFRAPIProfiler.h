@@ -0,0 +1,81 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "EFProfiling.h"
+
+#include <vector>
+
+namespace EventfulEngine{
+    /**
+     * Times ranges of command lists with timer queries and reports them to EFProfiler, next to the CPU zones of the
+     * same frame. Every zone also places a debug marker, so it shows up in graphics debuggers as well.
+     * While profiling is disabled at run time zones only place the marker. Queries are pooled and reused.
+     */
+    class EFGpuProfiler{
+    public:
+        EFRENDERAPI_API explicit EFGpuProfiler(EFDynamicRAPI* device);
+
+        NOMOVEORCOPY(EFGpuProfiler)
+
+        EFRENDERAPI_API void BeginZone(EFRAPICommandList* commandList, const char* name);
+
+        EFRENDERAPI_API void EndZone(EFRAPICommandList* commandList);
+
+        /** Reports every zone whose query finished to EFProfiler. Call once per frame, after executing the lists. */
+        EFRENDERAPI_API void ResolveZones();
+
+        /** Zones recorded but not resolved yet. */
+        [[nodiscard]] EFRENDERAPI_API size_t GetPendingZoneCount();
+
+    private:
+        struct GpuZone{
+            EFRAPICommandList* CommandList{nullptr};
+            // Null while profiling is disabled, the zone is only a marker then
+            TimerQueryHandle Query;
+            const char* Name{""};
+            uint64 FrameIndex{0};
+            uint64 RecordCycles{0};
+        };
+
+        EFDynamicRAPI* _device;
+        std::mutex _mutex;
+        std::vector<TimerQueryHandle> _freeQueries;
+        // Zones still open on some command list, closed innermost first
+        std::vector<GpuZone> _openZones;
+        std::vector<GpuZone> _pendingZones;
+    };
+
+    /**
+     * Adds the draws and dispatches of the executed lists to the frame counters of EFProfiler.
+     * Backends call it from ExecuteCommandLists.
+     */
+    EFRENDERAPI_API void ReportExecutedCommandLists(EFRAPICommandList* const* commandLists, size_t count);
+
+    /** Times the scope on the GPU, see EF_PROFILE_GPU_SCOPE. */
+    class EFGpuZoneScope{
+    public:
+        EFGpuZoneScope(EFGpuProfiler& profiler, EFRAPICommandList* commandList, const char* name) :
+            _profiler(profiler), _commandList(commandList){
+            _profiler.BeginZone(_commandList, name);
+        }
+
+        ~EFGpuZoneScope(){
+            _profiler.EndZone(_commandList);
+        }
+
+        NOMOVEORCOPY(EFGpuZoneScope)
+
+    private:
+        EFGpuProfiler& _profiler;
+        EFRAPICommandList* _commandList;
+    };
+} // EventfulEngine
+
+// Without a profiler backend GPU zones are plain debug markers
+#if EF_ENABLE_PROFILING
+#define EF_PROFILE_GPU_SCOPE(Profiler, CommandList, Name) \
+    ::EventfulEngine::EFGpuZoneScope EF_PROFILE_CONCAT(_gpuProfileScope, __LINE__){Profiler, CommandList, Name}
+#else
+#define EF_PROFILE_GPU_SCOPE(Profiler, CommandList, Name) \
+    ::EventfulEngine::ScopedMarker EF_PROFILE_CONCAT(_gpuProfileScope, __LINE__){CommandList, Name}
+#endif
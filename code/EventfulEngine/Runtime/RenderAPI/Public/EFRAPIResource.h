@@ -21,6 +21,23 @@ namespace EventfulEngine{
         explicit operator T*() const{ return std::get<T*>(data); }
     };
 
+    class EFRAPIResource;
+
+    // Takes resources whose last reference was released, to destroy them once the GPU is done with them. Every
+    // resource routed to a queue holds a reference to it, so a queue outlives the device that owns it.
+    class IRetireQueue{
+    public:
+        virtual unsigned long AddRef() = 0;
+
+        virtual unsigned long Release() = 0;
+
+        // Returns false if the queue no longer defers destruction, the caller deletes the resource itself
+        virtual bool Retire(EFRAPIResource* resource) = 0;
+
+    protected:
+        virtual ~IRetireQueue() = default;
+    };
+
     class EFRAPIResource{
 
     public:
@@ -47,6 +64,9 @@ namespace EventfulEngine{
         EFRAPIResource() = default;
 
         virtual ~EFRAPIResource() = default;
+
+        // Destroys retired resources
+        friend class EFRAPIRetireQueue;
     };
 
 
@@ -252,13 +272,22 @@ namespace EventfulEngine{
         unsigned long Release() override{
             const unsigned long result = --_refCount;
             if (result == 0){
-                delete this;
+                if (!_retireQueue || !_retireQueue->Retire(this)){
+                    delete this;
+                }
             }
             return result;
         }
 
+        // Hands the object to the queue instead of deleting it when the last reference is released, set by the
+        // device that created it. The object keeps the queue alive, so it may be released after the device.
+        void SetRetireQueue(IRetireQueue* retireQueue){
+            _retireQueue = retireQueue;
+        }
+
     private:
         std::atomic<unsigned long> _refCount = 1;
+        RefCountPtr<IRetireQueue> _retireQueue;
 
     };
 
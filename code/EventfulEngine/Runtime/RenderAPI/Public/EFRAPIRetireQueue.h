@@ -0,0 +1,89 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace EventfulEngine{
+    struct RetireQueueStats{
+        // Released resources waiting for their frame's submissions to complete
+        uint64 PendingResources = 0;
+        // Closed frames with resources still waiting
+        uint64 PendingFrames = 0;
+        uint64 ResourcesRetired = 0;
+        uint64 ResourcesDestroyed = 0;
+        // Most resources destroyed by one Collect()
+        uint64 LargestBatch = 0;
+    };
+
+    // Deferred destruction for the objects of a device. Objects the device routed here with SetRetireQueue() are not
+    // deleted when their last reference is released but collected in the list of the current frame. Closing the frame
+    // tags the list with the instance ExecuteCommandLists last returned on every queue, the list is destroyed in one
+    // batch once all of them have completed. Destroying a resource can release others, they join the open frame.
+    // The queue is reference counted by its device and the resources routed to it. The device closes it when it is
+    // destroyed, resources that are released afterwards are deleted right away.
+    class EFRAPIRetireQueue final : public IRetireQueue{
+    public:
+        using QueueInstances = std::array<uint64, static_cast<size_t>(E_CommandQueue::Count)>;
+
+        EFRAPIRetireQueue() = default;
+
+        // Destroys everything still pending, the GPU must be idle
+        EFRENDERAPI_API ~EFRAPIRetireQueue();
+
+        NOMOVEORCOPY(EFRAPIRetireQueue)
+
+        unsigned long AddRef() override{
+            return ++_refCount;
+        }
+
+        unsigned long Release() override{
+            const unsigned long result = --_refCount;
+            if (result == 0){
+                delete this;
+            }
+            return result;
+        }
+
+        // Thread safe, returns false once the queue is closed
+        EFRENDERAPI_API bool Retire(EFRAPIResource* resource) override;
+
+        // Ends the current frame, its resources wait for the submitted instances
+        EFRENDERAPI_API void CloseFrame(const QueueInstances& submittedInstances);
+
+        // Destroys the closed frames whose instances have completed, returns the number of resources destroyed
+        EFRENDERAPI_API size_t Collect(const QueueInstances& completedInstances);
+
+        // Destroys all pending resources including the open frame, for device shutdown and idle devices
+        EFRENDERAPI_API size_t DestroyAll();
+
+        // Destroys all pending resources and stops deferring, for the destructor of the device. The GPU must be idle.
+        EFRENDERAPI_API size_t Close();
+
+        [[nodiscard]] EFRENDERAPI_API RetireQueueStats GetStats();
+
+        EFRENDERAPI_API void ResetStats();
+
+    private:
+        struct RetiredFrame{
+            QueueInstances Instances{};
+            std::vector<EFRAPIResource*> Resources;
+        };
+
+        // Outside the lock, destructors may retire more resources
+        static void Destroy(const std::vector<EFRAPIResource*>& resources);
+
+        // Hands the emptied lists back for the next frames
+        void Recycle(std::vector<std::vector<EFRAPIResource*>>& lists);
+
+        std::mutex _mutex;
+        std::vector<EFRAPIResource*> _openFrame;
+        std::deque<RetiredFrame> _pendingFrames;
+        std::vector<std::vector<EFRAPIResource*>> _freeLists;
+        RetireQueueStats _stats;
+        bool _bIsClosed = false;
+        std::atomic<unsigned long> _refCount = 1;
+    };
+} // EventfulEngine
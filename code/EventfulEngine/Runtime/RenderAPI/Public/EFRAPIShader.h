@@ -2,6 +2,8 @@
 
 #include "EFRAPIResource.h"
 
+#include <span>
+
 namespace EventfulEngine{
 
     enum class F_ShaderType : uint16{
@@ -153,6 +155,9 @@ namespace EventfulEngine{
         [[nodiscard]] virtual const ShaderDesc& GetDesc() const = 0;
 
         virtual void GetBytecode(const void** ppBytecode, size_t* pSize) const = 0;
+
+        // Constants of a shader created with CreateShaderSpecialization, they are not part of its bytecode.
+        [[nodiscard]] virtual std::span<const ShaderSpecialization> GetSpecializations() const{ return {}; }
     };
 
     using ShaderHandle = RefCountPtr<EFRAPIShader>;
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "EFRAPIBuffer.h"
+#include "EFRAPITexture.h"
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace EventfulEngine{
+    // State of the subresources of a texture, stored as one state while all subresources share it and as one entry
+    // per subresource, array slice major, once a transition splits them
+    struct TextureSubresourceStates{
+        F_ResourceStates State = F_ResourceStates::Unknown;
+        std::vector<F_ResourceStates> Subresources;
+
+        [[nodiscard]] F_ResourceStates Get(const uint32 subresource) const{
+            return Subresources.empty() ? State : Subresources[subresource];
+        }
+
+        [[nodiscard]] bool IsUniform() const{ return Subresources.empty(); }
+    };
+
+    // Backend textures derive from this so that the state trackers of all command lists share their state
+    class TextureStateExtension{
+    public:
+        // The desc only has to be constructed when the texture is first tracked
+        explicit TextureStateExtension(const TextureDesc& desc) : DescRef(desc){}
+
+        [[nodiscard]] EFRENDERAPI_API uint32 GetSubresourceCount() const;
+
+        [[nodiscard]] uint32 GetSubresourceIndex(const MipLevel mipLevel, const ArraySlice arraySlice) const{
+            return arraySlice * DescRef.MipLevels + mipLevel;
+        }
+
+        const TextureDesc& DescRef;
+        // States at the end of the last executed command list that used the texture, Unknown until then
+        TextureSubresourceStates States;
+        // Set when a command list that made the state permanent is executed, never tracked again after
+        F_ResourceStates PermanentState = F_ResourceStates::Unknown;
+    };
+
+    // Buffer counterpart of TextureStateExtension
+    class BufferStateExtension{
+    public:
+        explicit BufferStateExtension(const BufferDesc& desc) : DescRef(desc){}
+
+        const BufferDesc& DescRef;
+        F_ResourceStates State = F_ResourceStates::Unknown;
+        F_ResourceStates PermanentState = F_ResourceStates::Unknown;
+    };
+
+    // Transition of a texture, of all its subresources when B_IsEntireTexture is set. StateBefore equals StateAfter
+    // for UAV barriers.
+    struct TextureBarrier{
+        TextureStateExtension* Texture = nullptr;
+        MipLevel TexMipLevel = 0;
+        ArraySlice TexArraySlice = 0;
+        bool B_IsEntireTexture = false;
+        F_ResourceStates StateBefore = F_ResourceStates::Unknown;
+        F_ResourceStates StateAfter = F_ResourceStates::Unknown;
+    };
+
+    struct BufferBarrier{
+        BufferStateExtension* Buffer = nullptr;
+        F_ResourceStates StateBefore = F_ResourceStates::Unknown;
+        F_ResourceStates StateAfter = F_ResourceStates::Unknown;
+    };
+
+    // The barriers the backend records with one API call, valid until the tracker is used again
+    struct BarrierBatch{
+        std::span<const TextureBarrier> Textures;
+        std::span<const BufferBarrier> Buffers;
+
+        [[nodiscard]] bool IsEmpty() const{ return Textures.empty() && Buffers.empty(); }
+    };
+
+    struct StateTrackerStats{
+        // Barriers in committed batches
+        uint64 BarriersIssued = 0;
+        // Requested transitions that were already in effect, or merged into or cancelled a barrier of the same batch
+        uint64 BarriersElided = 0;
+        // Commits that produced at least one barrier
+        uint64 Batches = 0;
+    };
+
+    // Backend independent resource state tracking of one command list, implementing the automatic barriers of
+    // EFRAPICommandList. A resource is tracked from the first time the list uses it, starting in the state the last
+    // executed list left it in. Required states collect into a batch of barriers: a transition back to the state the
+    // batch started from cancels the pending barrier, a further transition changes its target state, and repeated
+    // UAV barriers of a resource collapse into one. Resources in a permanent state are never tracked again.
+    // Not thread safe, a command list records on one thread.
+    class EFRAPIStateTracker{
+    public:
+        EFRAPIStateTracker() = default;
+
+        NOMOVEORCOPY(EFRAPIStateTracker)
+
+        EFRENDERAPI_API void SetEnableUavBarriersForTexture(TextureStateExtension* texture, bool enableBarriers);
+
+        EFRENDERAPI_API void SetEnableUavBarriersForBuffer(BufferStateExtension* buffer, bool enableBarriers);
+
+        // Overrides the tracked state without a barrier
+        EFRENDERAPI_API void BeginTrackingTextureState(TextureStateExtension* texture,
+                                                       TextureSubresourceSet subresources, F_ResourceStates state);
+
+        EFRENDERAPI_API void BeginTrackingBufferState(BufferStateExtension* buffer, F_ResourceStates state);
+
+        // Adds the barriers that move the subresources to the state to the current batch
+        EFRENDERAPI_API void RequireTextureState(TextureStateExtension* texture, TextureSubresourceSet subresources,
+                                                 F_ResourceStates state);
+
+        EFRENDERAPI_API void RequireBufferState(BufferStateExtension* buffer, F_ResourceStates state);
+
+        // Transitions to the state, which becomes the resource's permanent state when the list is executed
+        EFRENDERAPI_API void SetPermanentTextureState(TextureStateExtension* texture, F_ResourceStates state);
+
+        EFRENDERAPI_API void SetPermanentBufferState(BufferStateExtension* buffer, F_ResourceStates state);
+
+        // Transitions the resources with B_KeepInitialState back to their initial state, call before closing the list
+        EFRENDERAPI_API void KeepInitialStates();
+
+        // Ends the current batch and returns its barriers without the cancelled ones
+        EFRENDERAPI_API BarrierBatch CommitBarriers();
+
+        // State the list leaves the subresource in, Unknown if neither the list nor an executed list set it
+        [[nodiscard]] EFRENDERAPI_API F_ResourceStates GetTextureSubresourceState(TextureStateExtension* texture,
+                                                                                  ArraySlice arraySlice,
+                                                                                  MipLevel mipLevel) const;
+
+        [[nodiscard]] EFRENDERAPI_API F_ResourceStates GetBufferState(BufferStateExtension* buffer) const;
+
+        // Hands the tracked states to the resources, call when the list is executed in submission order
+        EFRENDERAPI_API void CommandListExecuted();
+
+        // Forgets all tracked resources and pending barriers, call when the list is opened
+        EFRENDERAPI_API void Reset();
+
+        [[nodiscard]] const StateTrackerStats& GetStats() const{ return _stats; }
+
+        void ResetStats(){ _stats = {}; }
+
+    private:
+        static constexpr uint32 NO_PENDING_BARRIER = ~0u;
+        static constexpr uint32 NO_SUBRESOURCE = ~0u;
+
+        struct TextureTracking{
+            TextureSubresourceStates States;
+            // The barrier indices are only valid while PendingBatch is the open batch
+            uint64 PendingBatch = 0;
+            uint32 EntireBarrier = NO_PENDING_BARRIER;
+            // Barriers of single subresources are searched from here on
+            uint32 FirstSubresourceBarrier = NO_PENDING_BARRIER;
+            bool B_EnableUavBarriers = true;
+            bool B_IsPermanent = false;
+        };
+
+        struct BufferTracking{
+            F_ResourceStates State = F_ResourceStates::Unknown;
+            uint64 PendingBatch = 0;
+            uint32 Barrier = NO_PENDING_BARRIER;
+            bool B_EnableUavBarriers = true;
+            bool B_IsPermanent = false;
+        };
+
+        TextureTracking& GetTextureTracking(TextureStateExtension* texture);
+
+        BufferTracking& GetBufferTracking(BufferStateExtension* buffer);
+
+        // Records the transition of one subresource, or of the entire texture for NO_SUBRESOURCE
+        void TransitionTexture(TextureStateExtension* texture, TextureTracking& tracking, uint32 subresource,
+                               F_ResourceStates before, F_ResourceStates after);
+
+        void TransitionBuffer(BufferStateExtension* buffer, BufferTracking& tracking, F_ResourceStates before,
+                              F_ResourceStates after);
+
+        std::unordered_map<TextureStateExtension*, TextureTracking> _textureStates;
+        std::unordered_map<BufferStateExtension*, BufferTracking> _bufferStates;
+        // Tracked resources in the order they were first used, for a deterministic hand back
+        std::vector<TextureStateExtension*> _textures;
+        std::vector<BufferStateExtension*> _buffers;
+
+        // Barriers of the open batch, cancelled ones have no resource
+        std::vector<TextureBarrier> _pendingTextureBarriers;
+        std::vector<BufferBarrier> _pendingBufferBarriers;
+        // Last committed batch, handed to the backend
+        std::vector<TextureBarrier> _textureBarriers;
+        std::vector<BufferBarrier> _bufferBarriers;
+        // Starts at one so that zero initialized trackings have no pending barrier
+        uint64 _pendingBatch = 1;
+
+        StateTrackerStats _stats;
+    };
+} // EventfulEngine
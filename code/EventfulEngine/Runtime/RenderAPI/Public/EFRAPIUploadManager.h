@@ -0,0 +1,159 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+
+#include <deque>
+#include <span>
+#include <vector>
+
+namespace EventfulEngine{
+    // Upload memory handed to a command list, a range of the ring buffer or a dedicated buffer for uploads that
+    // do not fit the ring
+    struct UploadChunk{
+        EFRAPIBuffer* Buffer = nullptr;
+        uint8* CpuAddress = nullptr;
+        uint64 Offset = 0;
+        uint64 Size = 0;
+        // Position of the chunk in the ring, unused for dedicated chunks
+        uint64 Sequence = 0;
+        BufferHandle Dedicated;
+    };
+
+    // Suballocated upload memory, CpuAddress is Offset bytes into Buffer
+    struct UploadAllocation{
+        EFRAPIBuffer* Buffer = nullptr;
+        uint8* CpuAddress = nullptr;
+        uint64 Offset = 0;
+    };
+
+    struct UploadManagerStats{
+        uint64 BytesUploaded = 0;
+        // Bytes uploaded in the last frame ended with EndFrame()
+        uint64 BytesUploadedLastFrame = 0;
+        uint64 ChunksAllocated = 0;
+        // Allocations that waited for the GPU to release ring memory
+        uint64 RingStalls = 0;
+        // Chunks that got a buffer of their own, because they were larger than the ring or the ring was held by
+        // command lists that were not executed yet
+        uint64 DedicatedChunks = 0;
+    };
+
+    // Ring buffer in a persistently mapped upload buffer, shared by all command lists of a device. Command lists take
+    // chunks of it through an EFRAPIUploadWriter and suballocate their uploads from them without locking.
+    // A list hands its chunks back when it is executed, or when it is opened again or destroyed without being executed.
+    // They become free once the submission fence signaled after that on the list's queue completed. The backend
+    // retires the chunks of the executed lists and then calls SignalSubmission() in every ExecuteCommandLists.
+    // When the ring is full an allocation waits for the oldest fence, or falls back to a dedicated buffer if no
+    // fence covers the oldest chunk yet.
+    class EFRAPIUploadManager{
+    public:
+        EFRENDERAPI_API EFRAPIUploadManager(EFDynamicRAPI* device, uint64 ringSize);
+
+        EFRENDERAPI_API ~EFRAPIUploadManager();
+
+        NOMOVEORCOPY(EFRAPIUploadManager)
+
+        // Thread safe, size is rounded up to the chunk alignment
+        EFRENDERAPI_API UploadChunk AllocateChunk(uint64 size);
+
+        // Thread safe. The chunks stay in use until the next submission on the queue has completed.
+        EFRENDERAPI_API void RetireChunks(std::span<UploadChunk> chunks, E_CommandQueue queue);
+
+        // Sets the fence for everything retired on the queue so far, call after executing command lists on it
+        EFRENDERAPI_API void SignalSubmission(E_CommandQueue queue);
+
+        // Closes the per frame stats
+        EFRENDERAPI_API void EndFrame();
+
+        // Counts bytes written into upload memory, for BytesUploaded
+        void AddUploadedBytes(const uint64 bytes){ _bytesThisFrame.fetch_add(bytes, std::memory_order_relaxed); }
+
+        [[nodiscard]] uint64 GetRingSize() const{ return _ringSize; }
+
+        [[nodiscard]] EFRENDERAPI_API UploadManagerStats GetStats();
+
+        EFRENDERAPI_API void ResetStats();
+
+    private:
+        struct RingChunk{
+            uint64 Begin = 0;
+            uint64 End = 0;
+            E_CommandQueue Queue = E_CommandQueue::Graphics;
+            // Submission fence of the queue that releases the chunk, 0 while the chunk is in use
+            uint64 Fence = 0;
+        };
+
+        struct DedicatedChunk{
+            BufferHandle Buffer;
+            E_CommandQueue Queue = E_CommandQueue::Graphics;
+            uint64 Fence = 0;
+        };
+
+        struct PendingFence{
+            uint64 Value = 0;
+            EventQueryHandle Query;
+        };
+
+        struct QueueFences{
+            // Fence of the next SignalSubmission
+            uint64 Next = 1;
+            uint64 Completed = 0;
+            std::deque<PendingFence> Pending;
+        };
+
+        // Returns the ring offset of a free range, or false when the ring has no contiguous room for it
+        bool TryAllocateRange(uint64 size, uint64& outOffset);
+
+        // Polls the fences and frees the completed chunks at the tail of the ring
+        void Reclaim();
+
+        // Waits for the fence of the oldest ring chunk, false if the chunk is not covered by a fence yet
+        bool WaitForOldestChunk();
+
+        QueueFences& GetQueue(E_CommandQueue queue){ return _queues[static_cast<size_t>(queue)]; }
+
+        UploadChunk AllocateDedicatedChunk(uint64 size);
+
+        EFDynamicRAPI* _device;
+        uint64 _ringSize;
+        BufferHandle _ringBuffer;
+        uint8* _ringMemory = nullptr;
+
+        std::mutex _mutex;
+        // Chunks in allocation order, the front is the tail of the ring
+        std::deque<RingChunk> _chunks;
+        uint64 _firstSequence = 0;
+        uint64 _head = 0;
+        std::vector<DedicatedChunk> _dedicatedChunks;
+        QueueFences _queues[static_cast<size_t>(E_CommandQueue::Count)];
+        std::vector<EventQueryHandle> _freeQueries;
+
+        std::atomic<uint64> _bytesThisFrame = 0;
+        UploadManagerStats _stats;
+    };
+
+    // Suballocates the uploads of one command list from chunks of the upload manager, not thread safe.
+    class EFRAPIUploadWriter{
+    public:
+        EFRENDERAPI_API EFRAPIUploadWriter(EFRAPIUploadManager* manager, uint64 chunkSize, E_CommandQueue queue);
+
+        // Retires the chunks
+        EFRENDERAPI_API ~EFRAPIUploadWriter();
+
+        NOMOVEORCOPY(EFRAPIUploadWriter)
+
+        // Alignment must be a power of two
+        EFRENDERAPI_API UploadAllocation Allocate(uint64 size, uint64 alignment);
+
+        // Hands all chunks back to the manager, call when the list is executed and when it is opened for recording
+        // again
+        EFRENDERAPI_API void Retire();
+
+    private:
+        EFRAPIUploadManager* _manager;
+        uint64 _chunkSize;
+        E_CommandQueue _queue;
+        std::vector<UploadChunk> _chunks;
+        uint64 _currentOffset = 0;
+    };
+} // EventfulEngine
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+namespace EventfulEngine{
+    HeadlessBindingSet::HeadlessBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout) : Desc(desc),
+        Layout(layout){
+        for (const BindingSetItem& item : desc.bindings){
+            if (item.resourceHandle){
+                Resources.emplace_back(item.resourceHandle);
+            }
+        }
+    }
+
+    BindingLayoutHandle EFHeadlessRAPI::CreateBindingLayout(const BindingLayoutDesc& desc){
+        return BindingLayoutHandle::Create(Track(new HeadlessBindingLayout(desc)));
+    }
+
+    BindingLayoutHandle EFHeadlessRAPI::CreateBindlessLayout(const BindlessLayoutDesc& desc){
+        return BindingLayoutHandle::Create(Track(new HeadlessBindingLayout(desc)));
+    }
+
+    BindingSetHandle EFHeadlessRAPI::CreateBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout){
+        if (!layout){
+            return nullptr;
+        }
+        return BindingSetHandle::Create(Track(new HeadlessBindingSet(desc, layout)));
+    }
+
+    DescriptorTableHandle EFHeadlessRAPI::CreateDescriptorTable(EFRAPIBindingLayout* layout){
+        if (!layout || !layout->getBindlessDesc()){
+            return nullptr;
+        }
+        return DescriptorTableHandle::Create(Track(new HeadlessDescriptorTable(layout)));
+    }
+
+    void EFHeadlessRAPI::ResizeDescriptorTable(IDescriptorTable* descriptorTable, const uint32_t newSize,
+                                               const bool keepContents){
+        auto* table = static_cast<HeadlessDescriptorTable*>(descriptorTable);
+        if (!keepContents){
+            table->Descriptors.clear();
+        }
+        table->Descriptors.resize(newSize, BindingSetItem::None());
+        table->Resources.resize(newSize);
+    }
+
+    bool EFHeadlessRAPI::WriteDescriptorTable(IDescriptorTable* descriptorTable, const BindingSetItem& item){
+        auto* table = static_cast<HeadlessDescriptorTable*>(descriptorTable);
+        if (item.slot >= table->Descriptors.size()){
+            return false;
+        }
+        table->Descriptors[item.slot] = item;
+        table->Resources[item.slot] = item.resourceHandle;
+        return true;
+    }
+} // EventfulEngine
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+namespace EventfulEngine{
+    namespace{
+        // Matches the constant buffer offset alignment, so placed buffers can be bound at any offset they got
+        constexpr uint64 BUFFER_PLACEMENT_ALIGNMENT = c_ConstantBufferOffsetSizeAlignment;
+    }
+
+    HeadlessBuffer::HeadlessBuffer(const BufferDesc& desc) : BufferStateExtension(Desc), Desc(desc){
+        if (!Desc.B_IsVirtual){
+            OwnedMemory.resize(Desc.ByteSize);
+            Data = OwnedMemory.data();
+        }
+    }
+
+    HeapHandle EFHeadlessRAPI::CreateHeap(const HeapDesc& d){
+        return HeapHandle::Create(Track(new HeadlessHeap(d)));
+    }
+
+    BufferHandle EFHeadlessRAPI::CreateBuffer(const BufferDesc& d){
+        return BufferHandle::Create(Track(new HeadlessBuffer(d)));
+    }
+
+    void* EFHeadlessRAPI::MapBuffer(EFRAPIBuffer* buffer, const E_CpuAccessMode cpuAccess){
+        auto* headlessBuffer = static_cast<HeadlessBuffer*>(buffer);
+        if (cpuAccess == E_CpuAccessMode::None || headlessBuffer->B_IsMapped){
+            return nullptr;
+        }
+        headlessBuffer->B_IsMapped = true;
+        return headlessBuffer->Data;
+    }
+
+    void EFHeadlessRAPI::UnmapBuffer(EFRAPIBuffer* buffer){
+        static_cast<HeadlessBuffer*>(buffer)->B_IsMapped = false;
+    }
+
+    MemoryRequirements EFHeadlessRAPI::GetBufferMemoryRequirements(EFRAPIBuffer* buffer){
+        const uint64 size = buffer->GetDesc().ByteSize;
+        return {(size + BUFFER_PLACEMENT_ALIGNMENT - 1) & ~(BUFFER_PLACEMENT_ALIGNMENT - 1), BUFFER_PLACEMENT_ALIGNMENT};
+    }
+
+    bool EFHeadlessRAPI::BindBufferMemory(EFRAPIBuffer* buffer, IHeap* heap, const uint64_t offset){
+        auto* headlessBuffer = static_cast<HeadlessBuffer*>(buffer);
+        auto* headlessHeap = static_cast<HeadlessHeap*>(heap);
+        if (!headlessBuffer->Desc.B_IsVirtual || headlessBuffer->Heap || !headlessHeap){
+            return false;
+        }
+        if (offset % BUFFER_PLACEMENT_ALIGNMENT != 0 ||
+            offset + headlessBuffer->Desc.ByteSize > headlessHeap->Memory.size()){
+            return false;
+        }
+
+        headlessBuffer->Heap = heap;
+        headlessBuffer->Data = headlessHeap->Memory.data() + offset;
+        return true;
+    }
+
+    BufferHandle EFHeadlessRAPI::CreateHandleForNativeBuffer(ObjectType, EFRAPIObject, const BufferDesc&){
+        // There are no native objects without a graphics API
+        return nullptr;
+    }
+} // EventfulEngine
@@ -0,0 +1,840 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+#include "GenericPlatformTime.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint32 MAX_TEXEL_SIZE = 16;
+        constexpr uint64 UPLOAD_ALIGNMENT = 16;
+        constexpr uint64 TEXTURE_UPLOAD_ALIGNMENT = 512;
+
+        // Stored in upload memory behind the written data, the copy command only captures a pointer to it and
+        // fits the small buffer of std::function
+        struct BufferUpload{
+            HeadlessBuffer* Buffer;
+            uint64 DestOffset;
+            uint64 Size;
+        };
+
+        struct TextureUpload{
+            HeadlessTexture* Texture;
+            uint64 DestOffset;
+            uint64 Size;
+        };
+
+        constexpr uint64 AlignUp(const uint64 value, const uint64 alignment){
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint16 FloatToHalf(const float value){
+            uint32 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const uint32 sign = bits >> 16 & 0x8000;
+            const uint32 biasedExponent = bits >> 23 & 0xFF;
+            const uint32 mantissa = bits & 0x7FFFFF;
+            if (biasedExponent == 0xFF){
+                return static_cast<uint16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+            }
+
+            const int32 exponent = static_cast<int32>(biasedExponent) - 127 + 15;
+            if (exponent >= 31){
+                return static_cast<uint16>(sign | 0x7C00);
+            }
+            // Values too small for a normal half are flushed to zero
+            if (exponent <= 0){
+                return static_cast<uint16>(sign);
+            }
+            return static_cast<uint16>(sign | static_cast<uint32>(exponent) << 10 | mantissa >> 13);
+        }
+
+        float LinearToSrgb(const float value){
+            if (value <= 0.0031308f){
+                return value * 12.92f;
+            }
+            return 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+        }
+
+        uint32 ToUnorm(const float value, const uint32 bits){
+            const auto maxValue = static_cast<float>((1ull << bits) - 1);
+            return static_cast<uint32>(std::lround(std::clamp(value, 0.f, 1.f) * maxValue));
+        }
+
+        int32 ToSnorm(const float value, const uint32 bits){
+            const auto maxValue = static_cast<float>((1ull << (bits - 1)) - 1);
+            return static_cast<int32>(std::lround(std::clamp(value, -1.f, 1.f) * maxValue));
+        }
+
+        // Little endian, writing the low bytes of the value truncates it to the component size
+        void WriteComponent(uint8* destination, const uint32 value, const uint32 byteSize){
+            std::memcpy(destination, &value, byteSize);
+        }
+
+        // Encodes a clear color into a single texel, false for formats that cannot be cleared with a color
+        bool EncodeColor(const FormatInfo& info, Color color, uint8* texel){
+            if (info.blockSize != 1 || info.kind == FormatKind::DepthStencil){
+                return false;
+            }
+            if (info.isSRGB){
+                color = Color(LinearToSrgb(color.r), LinearToSrgb(color.g), LinearToSrgb(color.b), color.a);
+            }
+
+            switch (info.format){
+                using enum E_Format;
+            case BGRA4_UNORM:
+                WriteComponent(texel, ToUnorm(color.b, 4) | ToUnorm(color.g, 4) << 4 | ToUnorm(color.r, 4) << 8 |
+                               ToUnorm(color.a, 4) << 12, 2);
+                return true;
+            case B5G6R5_UNORM:
+                WriteComponent(texel, ToUnorm(color.b, 5) | ToUnorm(color.g, 6) << 5 | ToUnorm(color.r, 5) << 11, 2);
+                return true;
+            case B5G5R5A1_UNORM:
+                WriteComponent(texel, ToUnorm(color.b, 5) | ToUnorm(color.g, 5) << 5 | ToUnorm(color.r, 5) << 10 |
+                               ToUnorm(color.a, 1) << 15, 2);
+                return true;
+            case R10G10B10A2_UNORM:
+                WriteComponent(texel, ToUnorm(color.r, 10) | ToUnorm(color.g, 10) << 10 | ToUnorm(color.b, 10) << 20 |
+                               ToUnorm(color.a, 2) << 30, 4);
+                return true;
+            case R11G11B10_FLOAT: {
+                // The small floats share the half exponent and drop mantissa bits, without a sign bit
+                const auto toSmallFloat = [](const float value, const uint32 droppedBits){
+                    return static_cast<uint32>(FloatToHalf(std::max(value, 0.f)) & 0x7FFF) >> droppedBits;
+                };
+                WriteComponent(texel, toSmallFloat(color.r, 4) | toSmallFloat(color.g, 4) << 11 |
+                               toSmallFloat(color.b, 5) << 22, 4);
+                return true;
+            }
+            default: break;
+            }
+
+            float values[4] = {color.r, color.g, color.b, color.a};
+            if (info.format == E_Format::BGRA8_UNORM || info.format == E_Format::SBGRA8_UNORM){
+                std::swap(values[0], values[2]);
+            }
+
+            const uint32 channelCount = info.hasRed + info.hasGreen + info.hasBlue + info.hasAlpha;
+            if (channelCount == 0){
+                return false;
+            }
+            const uint32 componentSize = info.bytesPerBlock / channelCount;
+            for (uint32 channel = 0; channel < channelCount; ++channel){
+                uint8* component = texel + channel * componentSize;
+                const float value = values[channel];
+                switch (info.kind){
+                case FormatKind::Float:
+                    if (componentSize == 4){
+                        std::memcpy(component, &value, sizeof(value));
+                    }
+                    else{
+                        WriteComponent(component, FloatToHalf(value), 2);
+                    }
+                    break;
+                case FormatKind::Normalized:
+                    WriteComponent(component, info.isSigned
+                                                  ? static_cast<uint32>(ToSnorm(value, componentSize * 8))
+                                                  : ToUnorm(value, componentSize * 8), componentSize);
+                    break;
+                case FormatKind::Integer:
+                    WriteComponent(component, info.isSigned
+                                                  ? static_cast<uint32>(static_cast<int32>(value))
+                                                  : static_cast<uint32>(std::max(value, 0.f)), componentSize);
+                    break;
+                default: return false;
+                }
+            }
+            return true;
+        }
+
+        bool EncodeUInt(const FormatInfo& info, const uint32 value, uint8* texel){
+            if (info.kind != FormatKind::Integer || info.blockSize != 1){
+                return EncodeColor(info, Color(static_cast<float>(value)), texel);
+            }
+            const uint32 channelCount = info.hasRed + info.hasGreen + info.hasBlue + info.hasAlpha;
+            const uint32 componentSize = info.bytesPerBlock / std::max(channelCount, 1u);
+            for (uint32 channel = 0; channel < channelCount; ++channel){
+                WriteComponent(texel + channel * componentSize, value, componentSize);
+            }
+            return true;
+        }
+
+        // Depth and stencil share a texel, each is only written when cleared
+        void EncodeDepthStencil(const E_Format format, const bool bClearDepth, const float depth,
+                                const bool bClearStencil, const uint8 stencil, uint8* texel){
+            switch (format){
+                using enum E_Format;
+            case D16:
+                if (bClearDepth){
+                    WriteComponent(texel, ToUnorm(depth, 16), 2);
+                }
+                break;
+            case D24S8:
+            case X24G8_UINT: {
+                uint32 value;
+                std::memcpy(&value, texel, sizeof(value));
+                if (bClearDepth){
+                    value = (value & 0xFF000000) | ToUnorm(depth, 24);
+                }
+                if (bClearStencil){
+                    value = (value & 0x00FFFFFF) | static_cast<uint32>(stencil) << 24;
+                }
+                std::memcpy(texel, &value, sizeof(value));
+                break;
+            }
+            case D32:
+                if (bClearDepth){
+                    std::memcpy(texel, &depth, sizeof(depth));
+                }
+                break;
+            case D32S8:
+            case X32G8_UINT:
+                if (bClearDepth){
+                    std::memcpy(texel, &depth, sizeof(depth));
+                }
+                if (bClearStencil){
+                    texel[4] = stencil;
+                }
+                break;
+            default: break;
+            }
+        }
+
+        // Calls the function with every texel of the subresources that has memory
+        template <typename TFunction>
+        void ForEachTexel(const HeadlessTexture* texture, const TextureSubresourceSet& subresources,
+                          const TFunction& function){
+            if (!texture->Data){
+                return;
+            }
+            const HeadlessTextureLayout& layout = texture->Layout;
+            for (ArraySlice arraySlice = subresources.BaseArraySlice;
+                 arraySlice < subresources.BaseArraySlice + subresources.NumArraySlices; ++arraySlice){
+                for (MipLevel mipLevel = subresources.BaseMipLevel;
+                     mipLevel < subresources.BaseMipLevel + subresources.NumMipLevels; ++mipLevel){
+                    const HeadlessTextureLayout::Subresource& subresource = layout.Get(mipLevel, arraySlice);
+                    uint8* begin = texture->Data + subresource.Offset;
+                    uint8* end = begin + subresource.DepthPitch * subresource.Depth;
+                    for (uint8* texel = begin; texel < end; texel += layout.BytesPerBlock){
+                        function(texel);
+                    }
+                }
+            }
+        }
+
+        // Part of the extent starting at origin that lies inside a subresource dimension of the given size
+        uint32 ClampExtent(const uint32 extent, const uint32 origin, const uint32 size){
+            return origin < size ? std::min(extent, size - origin) : 0;
+        }
+
+        // Copies the overlap of both slices clipped to both subresources, returns the copied bytes
+        uint64 CopyTextureRegion(uint8* destData, const HeadlessTextureLayout& destLayout, const TextureSlice& destSlice,
+                                 const uint8* srcData, const HeadlessTextureLayout& srcLayout,
+                                 const TextureSlice& srcSlice){
+            if (!destData || !srcData || destLayout.BytesPerBlock != srcLayout.BytesPerBlock ||
+                !destLayout.Contains(destSlice.TexMipLevel, destSlice.TexArraySlice) ||
+                !srcLayout.Contains(srcSlice.TexMipLevel, srcSlice.TexArraySlice)){
+                return 0;
+            }
+
+            const HeadlessTextureLayout::Subresource& destSubresource =
+                destLayout.Get(destSlice.TexMipLevel, destSlice.TexArraySlice);
+            const HeadlessTextureLayout::Subresource& srcSubresource =
+                srcLayout.Get(srcSlice.TexMipLevel, srcSlice.TexArraySlice);
+            const uint32 width = std::min(ClampExtent(srcSlice.Width, srcSlice.X, srcSubresource.Width),
+                                          ClampExtent(destSlice.Width, destSlice.X, destSubresource.Width));
+            const uint32 height = std::min(ClampExtent(srcSlice.Height, srcSlice.Y, srcSubresource.Height),
+                                           ClampExtent(destSlice.Height, destSlice.Y, destSubresource.Height));
+            const uint32 depth = std::min(ClampExtent(srcSlice.Depth, srcSlice.Z, srcSubresource.Depth),
+                                          ClampExtent(destSlice.Depth, destSlice.Z, destSubresource.Depth));
+            if (width == 0 || height == 0 || depth == 0){
+                return 0;
+            }
+
+            const uint32 blockSize = srcLayout.BlockSize;
+            const uint64 rowBytes = static_cast<uint64>((width + blockSize - 1) / blockSize) * srcLayout.BytesPerBlock;
+            const uint32 rowCount = (height + blockSize - 1) / blockSize;
+            uint8* destBase = destData + destLayout.GetTexelOffset(destSlice);
+            const uint8* srcBase = srcData + srcLayout.GetTexelOffset(srcSlice);
+            for (uint32 z = 0; z < depth; ++z){
+                for (uint32 row = 0; row < rowCount; ++row){
+                    std::memcpy(destBase + z * destSubresource.DepthPitch + row * destSubresource.RowPitch,
+                                srcBase + z * srcSubresource.DepthPitch + row * srcSubresource.RowPitch, rowBytes);
+                }
+            }
+            return rowBytes * rowCount * depth;
+        }
+    }
+
+    HeadlessCommandList::HeadlessCommandList(EFHeadlessRAPI* device, const CommandListParameters& params)
+        : _device(device), _desc(params), _uploads(device->GetUploadManager(), params.uploadChunkSize,
+                                                  params.queueType){
+    }
+
+    void HeadlessCommandList::Open(){
+        assert(!_bIsOpen);
+        _commands.clear();
+        _uploads.Retire();
+        _referencedResources.clear();
+        _stateTracker.Reset();
+        _stateTracker.ResetStats();
+        _recordingStats = {};
+        _markers.clear();
+        ClearState();
+        _bIsOpen = true;
+    }
+
+    void HeadlessCommandList::Close(){
+        assert(_bIsOpen);
+        _stateTracker.KeepInitialStates();
+        CommitBarriers();
+        _bIsOpen = false;
+    }
+
+    void HeadlessCommandList::ClearState(){
+        _graphicsState = {};
+        _computeState = {};
+        _meshletState = {};
+        _pushConstants.clear();
+    }
+
+    void HeadlessCommandList::ClearTextureFloat(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                                const Color& clearColor){
+        auto* texture = static_cast<HeadlessTexture*>(t);
+        const FormatInfo& info = GetFormatInfo(texture->Desc.Format);
+        uint8 texel[MAX_TEXEL_SIZE]{};
+        if (info.bytesPerBlock > MAX_TEXEL_SIZE || !EncodeColor(info, clearColor, texel)){
+            return;
+        }
+
+        const TextureSubresourceSet resolved = subresources.Resolve(texture->Desc, false);
+        RequireTextureState(t, resolved, texture->Desc.B_IsUAV && !texture->Desc.B_IsRenderTarget
+                                             ? F_ResourceStates::UnorderedAccess
+                                             : F_ResourceStates::RenderTarget);
+        CommitBarriers();
+        Reference(t);
+        _commands.emplace_back([texture, resolved, texel = std::to_array(texel), size = info.bytesPerBlock](
+            ExecutionStats&){
+                ForEachTexel(texture, resolved, [&texel, size](uint8* destination){
+                    std::memcpy(destination, texel.data(), size);
+                });
+            });
+    }
+
+    void HeadlessCommandList::ClearDepthStencilTexture(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                                       const bool clearDepth, const float depth,
+                                                       const bool clearStencil, const uint8_t stencil){
+        auto* texture = static_cast<HeadlessTexture*>(t);
+        if (GetFormatInfo(texture->Desc.Format).kind != FormatKind::DepthStencil || (!clearDepth && !clearStencil)){
+            return;
+        }
+
+        const TextureSubresourceSet resolved = subresources.Resolve(texture->Desc, false);
+        RequireTextureState(t, resolved, F_ResourceStates::DepthWrite);
+        CommitBarriers();
+        Reference(t);
+        _commands.emplace_back([=](ExecutionStats&){
+            ForEachTexel(texture, resolved, [&](uint8* texel){
+                EncodeDepthStencil(texture->Desc.Format, clearDepth, depth, clearStencil, stencil, texel);
+            });
+        });
+    }
+
+    void HeadlessCommandList::ClearTextureUInt(EFRAPITexture* t, const TextureSubresourceSet subresources,
+                                               const uint32_t clearColor){
+        auto* texture = static_cast<HeadlessTexture*>(t);
+        const FormatInfo& info = GetFormatInfo(texture->Desc.Format);
+        uint8 texel[MAX_TEXEL_SIZE]{};
+        if (info.bytesPerBlock > MAX_TEXEL_SIZE || !EncodeUInt(info, clearColor, texel)){
+            return;
+        }
+
+        const TextureSubresourceSet resolved = subresources.Resolve(texture->Desc, false);
+        RequireTextureState(t, resolved, texture->Desc.B_IsUAV && !texture->Desc.B_IsRenderTarget
+                                             ? F_ResourceStates::UnorderedAccess
+                                             : F_ResourceStates::RenderTarget);
+        CommitBarriers();
+        Reference(t);
+        _commands.emplace_back([texture, resolved, texel = std::to_array(texel), size = info.bytesPerBlock](
+            ExecutionStats&){
+                ForEachTexel(texture, resolved, [&texel, size](uint8* destination){
+                    std::memcpy(destination, texel.data(), size);
+                });
+            });
+    }
+
+    void HeadlessCommandList::CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                                          const TextureSlice& srcSlice){
+        auto* destTexture = static_cast<HeadlessTexture*>(dest);
+        auto* srcTexture = static_cast<HeadlessTexture*>(src);
+        const TextureSlice resolvedDest = destSlice.Resolve(destTexture->Desc);
+        const TextureSlice resolvedSrc = srcSlice.Resolve(srcTexture->Desc);
+
+        RequireTextureState(dest, TextureSubresourceSet(resolvedDest.TexMipLevel, 1, resolvedDest.TexArraySlice, 1),
+                            F_ResourceStates::CopyDest);
+        RequireTextureState(src, TextureSubresourceSet(resolvedSrc.TexMipLevel, 1, resolvedSrc.TexArraySlice, 1),
+                            F_ResourceStates::CopySource);
+        CommitBarriers();
+        Reference(dest);
+        Reference(src);
+        _commands.emplace_back([=](ExecutionStats& stats){
+            stats.BytesCopied += CopyTextureRegion(destTexture->Data, destTexture->Layout, resolvedDest,
+                                                   srcTexture->Data, srcTexture->Layout, resolvedSrc);
+        });
+    }
+
+    void HeadlessCommandList::CopyTexture(EFRAPIStagingTexture* dest, const TextureSlice& destSlice,
+                                          EFRAPITexture* src, const TextureSlice& srcSlice){
+        auto* destTexture = static_cast<HeadlessStagingTexture*>(dest);
+        auto* srcTexture = static_cast<HeadlessTexture*>(src);
+        const TextureSlice resolvedDest = destSlice.Resolve(destTexture->Desc);
+        const TextureSlice resolvedSrc = srcSlice.Resolve(srcTexture->Desc);
+
+        RequireTextureState(src, TextureSubresourceSet(resolvedSrc.TexMipLevel, 1, resolvedSrc.TexArraySlice, 1),
+                            F_ResourceStates::CopySource);
+        CommitBarriers();
+        Reference(dest);
+        Reference(src);
+        _commands.emplace_back([=](ExecutionStats& stats){
+            stats.BytesCopied += CopyTextureRegion(destTexture->Memory.data(), destTexture->Layout, resolvedDest,
+                                                   srcTexture->Data, srcTexture->Layout, resolvedSrc);
+        });
+    }
+
+    void HeadlessCommandList::CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice,
+                                          EFRAPIStagingTexture* src, const TextureSlice& srcSlice){
+        auto* destTexture = static_cast<HeadlessTexture*>(dest);
+        auto* srcTexture = static_cast<HeadlessStagingTexture*>(src);
+        const TextureSlice resolvedDest = destSlice.Resolve(destTexture->Desc);
+        const TextureSlice resolvedSrc = srcSlice.Resolve(srcTexture->Desc);
+
+        RequireTextureState(dest, TextureSubresourceSet(resolvedDest.TexMipLevel, 1, resolvedDest.TexArraySlice, 1),
+                            F_ResourceStates::CopyDest);
+        CommitBarriers();
+        Reference(dest);
+        Reference(src);
+        _commands.emplace_back([=](ExecutionStats& stats){
+            stats.BytesCopied += CopyTextureRegion(destTexture->Data, destTexture->Layout, resolvedDest,
+                                                   srcTexture->Memory.data(), srcTexture->Layout, resolvedSrc);
+        });
+    }
+
+    void HeadlessCommandList::WriteTexture(EFRAPITexture* dest, const uint32_t arraySlice, const uint32_t mipLevel,
+                                           const void* data, const size_t rowPitch, const size_t depthPitch){
+        auto* texture = static_cast<HeadlessTexture*>(dest);
+        const HeadlessTextureLayout& layout = texture->Layout;
+        if (!layout.Contains(mipLevel, arraySlice)){
+            return;
+        }
+        const HeadlessTextureLayout::Subresource& subresource = layout.Get(mipLevel, arraySlice);
+        const uint32 rowCount = (subresource.Height + layout.BlockSize - 1) / layout.BlockSize;
+        const size_t sourceDepthPitch = depthPitch != 0 ? depthPitch : rowPitch * rowCount;
+
+        // The caller may free its data right away, the rows are packed into upload memory while recording
+        const uint64 uploadSize = subresource.DepthPitch * subresource.Depth;
+        const UploadAllocation upload = _uploads.Allocate(AlignUp(uploadSize, alignof(TextureUpload)) +
+                                                          sizeof(TextureUpload), TEXTURE_UPLOAD_ALIGNMENT);
+        if (!upload.CpuAddress){
+            return;
+        }
+        const auto* source = static_cast<const uint8*>(data);
+        const size_t rowBytes = std::min<size_t>(rowPitch, subresource.RowPitch);
+        for (uint32 z = 0; z < subresource.Depth; ++z){
+            for (uint32 row = 0; row < rowCount; ++row){
+                std::memcpy(upload.CpuAddress + z * subresource.DepthPitch + row * subresource.RowPitch,
+                            source + z * sourceDepthPitch + row * rowPitch, rowBytes);
+            }
+        }
+        auto* header = new(upload.CpuAddress + AlignUp(uploadSize, alignof(TextureUpload)))
+            TextureUpload{texture, subresource.Offset, uploadSize};
+
+        RequireTextureState(dest, TextureSubresourceSet(mipLevel, 1, arraySlice, 1), F_ResourceStates::CopyDest);
+        CommitBarriers();
+        Reference(dest);
+        _commands.emplace_back([header](ExecutionStats& stats){
+            if (header->Texture->Data){
+                std::memcpy(header->Texture->Data + header->DestOffset,
+                            reinterpret_cast<const uint8*>(header) - AlignUp(header->Size, alignof(TextureUpload)),
+                            header->Size);
+                stats.BytesUploaded += header->Size;
+            }
+        });
+    }
+
+    void HeadlessCommandList::ResolveTexture(EFRAPITexture* dest, const TextureSubresourceSet& dstSubresources,
+                                             EFRAPITexture* src, const TextureSubresourceSet& srcSubresources){
+        auto* destTexture = static_cast<HeadlessTexture*>(dest);
+        auto* srcTexture = static_cast<HeadlessTexture*>(src);
+        const TextureSubresourceSet resolvedDest = dstSubresources.Resolve(destTexture->Desc, false);
+        const TextureSubresourceSet resolvedSrc = srcSubresources.Resolve(srcTexture->Desc, false);
+
+        RequireTextureState(dest, resolvedDest, F_ResourceStates::ResolveDest);
+        RequireTextureState(src, resolvedSrc, F_ResourceStates::ResolveSource);
+        CommitBarriers();
+        Reference(dest);
+        Reference(src);
+        // Only a single sample is stored, resolving copies the subresources
+        _commands.emplace_back([=](ExecutionStats& stats){
+            const uint32 arraySlices = std::min(resolvedDest.NumArraySlices, resolvedSrc.NumArraySlices);
+            const uint32 mipLevels = std::min(resolvedDest.NumMipLevels, resolvedSrc.NumMipLevels);
+            for (uint32 arraySlice = 0; arraySlice < arraySlices; ++arraySlice){
+                for (uint32 mipLevel = 0; mipLevel < mipLevels; ++mipLevel){
+                    TextureSlice destSlice;
+                    destSlice.SetArraySlice(resolvedDest.BaseArraySlice + arraySlice)
+                             .SetMipLevel(resolvedDest.BaseMipLevel + mipLevel);
+                    TextureSlice srcSlice;
+                    srcSlice.SetArraySlice(resolvedSrc.BaseArraySlice + arraySlice)
+                            .SetMipLevel(resolvedSrc.BaseMipLevel + mipLevel);
+                    stats.BytesCopied += CopyTextureRegion(destTexture->Data, destTexture->Layout,
+                                                           destSlice.Resolve(destTexture->Desc), srcTexture->Data,
+                                                           srcTexture->Layout, srcSlice.Resolve(srcTexture->Desc));
+                }
+            }
+        });
+    }
+
+    void HeadlessCommandList::WriteBuffer(EFRAPIBuffer* b, const void* data, const size_t dataSize,
+                                          const uint64_t destOffsetBytes){
+        auto* buffer = static_cast<HeadlessBuffer*>(b);
+        if (destOffsetBytes + dataSize > buffer->Desc.ByteSize){
+            return;
+        }
+
+        // Every write to a volatile constant buffer is a new version, placed where a constant buffer can be bound
+        const uint64 alignment = buffer->Desc.B_IsVolatile ? c_ConstantBufferOffsetSizeAlignment : UPLOAD_ALIGNMENT;
+        const UploadAllocation upload = _uploads.Allocate(AlignUp(dataSize, alignof(BufferUpload)) +
+                                                          sizeof(BufferUpload), alignment);
+        if (!upload.CpuAddress){
+            return;
+        }
+        std::memcpy(upload.CpuAddress, data, dataSize);
+        auto* header = new(upload.CpuAddress + AlignUp(dataSize, alignof(BufferUpload)))
+            BufferUpload{buffer, destOffsetBytes, dataSize};
+
+        RequireBufferState(b, F_ResourceStates::CopyDest);
+        CommitBarriers();
+        Reference(b);
+        _commands.emplace_back([header](ExecutionStats& stats){
+            if (header->Buffer->Data){
+                std::memcpy(header->Buffer->Data + header->DestOffset,
+                            reinterpret_cast<const uint8*>(header) - AlignUp(header->Size, alignof(BufferUpload)),
+                            header->Size);
+                stats.BytesUploaded += header->Size;
+            }
+        });
+    }
+
+    void HeadlessCommandList::ClearBufferUInt(EFRAPIBuffer* b, const uint32_t clearValue){
+        auto* buffer = static_cast<HeadlessBuffer*>(b);
+        RequireBufferState(b, F_ResourceStates::UnorderedAccess);
+        CommitBarriers();
+        Reference(b);
+        _commands.emplace_back([buffer, clearValue](ExecutionStats&){
+            if (!buffer->Data){
+                return;
+            }
+            const uint64 size = buffer->Desc.ByteSize;
+            for (uint64 offset = 0; offset < size; offset += sizeof(clearValue)){
+                std::memcpy(buffer->Data + offset, &clearValue, std::min<uint64>(sizeof(clearValue), size - offset));
+            }
+        });
+    }
+
+    void HeadlessCommandList::CopyBuffer(EFRAPIBuffer* dest, const uint64_t destOffsetBytes, EFRAPIBuffer* src,
+                                         const uint64_t srcOffsetBytes, const uint64_t dataSizeBytes){
+        auto* destBuffer = static_cast<HeadlessBuffer*>(dest);
+        auto* srcBuffer = static_cast<HeadlessBuffer*>(src);
+        if (destOffsetBytes + dataSizeBytes > destBuffer->Desc.ByteSize ||
+            srcOffsetBytes + dataSizeBytes > srcBuffer->Desc.ByteSize){
+            return;
+        }
+
+        RequireBufferState(dest, F_ResourceStates::CopyDest);
+        RequireBufferState(src, F_ResourceStates::CopySource);
+        CommitBarriers();
+        Reference(dest);
+        Reference(src);
+        _commands.emplace_back([=](ExecutionStats& stats){
+            if (destBuffer->Data && srcBuffer->Data){
+                // Copies within one buffer may overlap
+                std::memmove(destBuffer->Data + destOffsetBytes, srcBuffer->Data + srcOffsetBytes, dataSizeBytes);
+                stats.BytesCopied += dataSizeBytes;
+            }
+        });
+    }
+
+    void HeadlessCommandList::ClearSamplerFeedbackTexture(EFRAPISamplerFeedbackTexture*){
+    }
+
+    void HeadlessCommandList::DecodeSamplerFeedbackTexture(EFRAPIBuffer*, EFRAPISamplerFeedbackTexture*, E_Format){
+    }
+
+    void HeadlessCommandList::SetSamplerFeedbackTextureState(EFRAPISamplerFeedbackTexture*, F_ResourceStates){
+    }
+
+    void HeadlessCommandList::SetPushConstants(const void* data, const size_t byteSize){
+        const auto* bytes = static_cast<const uint8*>(data);
+        _pushConstants.assign(bytes, bytes + std::min<size_t>(byteSize, c_MaxPushConstantSize));
+    }
+
+    void HeadlessCommandList::SetGraphicsState(const GraphicsState& state){
+        _graphicsState = state;
+        Reference(state.Pipeline);
+        Reference(state.Framebuffer);
+        if (_bEnableAutomaticBarriers){
+            SetBindingStates(state.Bindings);
+            if (state.Framebuffer){
+                SetResourceStatesForFramebuffer(state.Framebuffer);
+            }
+            for (const VertexBufferBinding& binding : state.VertexBuffers){
+                RequireBufferState(binding.Buffer, F_ResourceStates::VertexBuffer);
+            }
+            RequireBufferState(state.IndexBuffer.Buffer, F_ResourceStates::IndexBuffer);
+            RequireBufferState(state.IndirectParams, F_ResourceStates::IndirectArgument);
+        }
+        CommitBarriers();
+    }
+
+    void HeadlessCommandList::Draw(const DrawArguments&){
+        ++_recordingStats.DrawCalls;
+    }
+
+    void HeadlessCommandList::DrawIndexed(const DrawArguments&){
+        ++_recordingStats.DrawCalls;
+    }
+
+    void HeadlessCommandList::DrawIndirect(uint32_t, const uint32_t drawCount){
+        _recordingStats.DrawCalls += drawCount;
+    }
+
+    void HeadlessCommandList::DrawIndexedIndirect(uint32_t, const uint32_t drawCount){
+        _recordingStats.DrawCalls += drawCount;
+    }
+
+    void HeadlessCommandList::SetComputeState(const ComputeState& state){
+        _computeState = state;
+        Reference(state.pipeline);
+        if (_bEnableAutomaticBarriers){
+            SetBindingStates(state.bindings);
+            RequireBufferState(state.indirectParams, F_ResourceStates::IndirectArgument);
+        }
+        CommitBarriers();
+    }
+
+    void HeadlessCommandList::Dispatch(uint32_t, uint32_t, uint32_t){
+        ++_recordingStats.Dispatches;
+    }
+
+    void HeadlessCommandList::DispatchIndirect(uint32_t){
+        ++_recordingStats.Dispatches;
+    }
+
+    void HeadlessCommandList::SetMeshletState(const MeshletState& state){
+        _meshletState = state;
+        Reference(state.pipeline);
+        Reference(state.framebuffer);
+        if (_bEnableAutomaticBarriers){
+            SetBindingStates(state.bindings);
+            if (state.framebuffer){
+                SetResourceStatesForFramebuffer(state.framebuffer);
+            }
+            RequireBufferState(state.indirectParams, F_ResourceStates::IndirectArgument);
+        }
+        CommitBarriers();
+    }
+
+    void HeadlessCommandList::DispatchMesh(uint32_t, uint32_t, uint32_t){
+        // Mesh shader dispatches replace draws in the graphics pipeline
+        ++_recordingStats.DrawCalls;
+    }
+
+    void HeadlessCommandList::BeginTimerQuery(EFRAPITimerQuery* query){
+        auto* timerQuery = static_cast<HeadlessTimerQuery*>(query);
+        Reference(query);
+        _commands.emplace_back([timerQuery](ExecutionStats&){
+            timerQuery->B_IsResolved.store(false, std::memory_order_relaxed);
+            timerQuery->BeginCycles.store(EFPlatformTime::Cycles64(), std::memory_order_relaxed);
+        });
+    }
+
+    void HeadlessCommandList::EndTimerQuery(EFRAPITimerQuery* query){
+        auto* timerQuery = static_cast<HeadlessTimerQuery*>(query);
+        Reference(query);
+        _commands.emplace_back([timerQuery](ExecutionStats&){
+            timerQuery->EndCycles.store(EFPlatformTime::Cycles64(), std::memory_order_relaxed);
+            timerQuery->B_IsResolved.store(true, std::memory_order_release);
+        });
+    }
+
+    void HeadlessCommandList::BeginMarker(const char* name){
+        _markers.push_back(name);
+    }
+
+    void HeadlessCommandList::EndMarker(){
+        if (!_markers.empty()){
+            _markers.pop_back();
+        }
+    }
+
+    void HeadlessCommandList::SetEnableAutomaticBarriers(const bool enable){
+        _bEnableAutomaticBarriers = enable;
+    }
+
+    void HeadlessCommandList::SetResourceStatesForBindingSet(EFRAPIBindingSet* bindingSet){
+        // Descriptor tables have no desc and are not tracked
+        const BindingSetDesc* desc = bindingSet ? bindingSet->getDesc() : nullptr;
+        if (!desc){
+            return;
+        }
+
+        // The set keeps its resources alive, they are tracked without a reference of their own
+        Reference(bindingSet);
+        for (const BindingSetItem& item : desc->bindings){
+            if (!item.resourceHandle){
+                continue;
+            }
+            switch (item.type){
+                using enum E_ResourceType;
+            case Texture_SRV:
+                _stateTracker.RequireTextureState(static_cast<HeadlessTexture*>(item.resourceHandle),
+                                                  item.subresources, F_ResourceStates::ShaderResource);
+                break;
+            case Texture_UAV:
+                _stateTracker.RequireTextureState(static_cast<HeadlessTexture*>(item.resourceHandle),
+                                                  item.subresources, F_ResourceStates::UnorderedAccess);
+                break;
+            case TypedBuffer_SRV:
+            case StructuredBuffer_SRV:
+            case RawBuffer_SRV:
+                _stateTracker.RequireBufferState(static_cast<HeadlessBuffer*>(item.resourceHandle),
+                                                 F_ResourceStates::ShaderResource);
+                break;
+            case TypedBuffer_UAV:
+            case StructuredBuffer_UAV:
+            case RawBuffer_UAV:
+                _stateTracker.RequireBufferState(static_cast<HeadlessBuffer*>(item.resourceHandle),
+                                                 F_ResourceStates::UnorderedAccess);
+                break;
+            case ConstantBuffer:
+            case VolatileConstantBuffer:
+                _stateTracker.RequireBufferState(static_cast<HeadlessBuffer*>(item.resourceHandle),
+                                                 F_ResourceStates::ConstantBuffer);
+                break;
+            default: break;
+            }
+        }
+    }
+
+    void HeadlessCommandList::SetEnableUavBarriersForTexture(EFRAPITexture* texture, const bool enableBarriers){
+        Reference(texture);
+        _stateTracker.SetEnableUavBarriersForTexture(static_cast<HeadlessTexture*>(texture), enableBarriers);
+    }
+
+    void HeadlessCommandList::SetEnableUavBarriersForBuffer(EFRAPIBuffer* buffer, const bool enableBarriers){
+        Reference(buffer);
+        _stateTracker.SetEnableUavBarriersForBuffer(static_cast<HeadlessBuffer*>(buffer), enableBarriers);
+    }
+
+    void HeadlessCommandList::BeginTrackingTextureState(EFRAPITexture* texture,
+                                                        const TextureSubresourceSet subresources,
+                                                        const F_ResourceStates stateBits){
+        Reference(texture);
+        _stateTracker.BeginTrackingTextureState(static_cast<HeadlessTexture*>(texture), subresources, stateBits);
+    }
+
+    void HeadlessCommandList::BeginTrackingBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        _stateTracker.BeginTrackingBufferState(static_cast<HeadlessBuffer*>(buffer), stateBits);
+    }
+
+    void HeadlessCommandList::SetTextureState(EFRAPITexture* texture, const TextureSubresourceSet subresources,
+                                              const F_ResourceStates stateBits){
+        Reference(texture);
+        _stateTracker.RequireTextureState(static_cast<HeadlessTexture*>(texture), subresources, stateBits);
+    }
+
+    void HeadlessCommandList::SetBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        _stateTracker.RequireBufferState(static_cast<HeadlessBuffer*>(buffer), stateBits);
+    }
+
+    void HeadlessCommandList::SetPermanentTextureState(EFRAPITexture* texture, const F_ResourceStates stateBits){
+        Reference(texture);
+        _stateTracker.SetPermanentTextureState(static_cast<HeadlessTexture*>(texture), stateBits);
+        CommitBarriers();
+    }
+
+    void HeadlessCommandList::SetPermanentBufferState(EFRAPIBuffer* buffer, const F_ResourceStates stateBits){
+        Reference(buffer);
+        _stateTracker.SetPermanentBufferState(static_cast<HeadlessBuffer*>(buffer), stateBits);
+        CommitBarriers();
+    }
+
+    void HeadlessCommandList::PlaceAliasingBarrier(EFRAPIResource* resource){
+        // Placed resources share the heap memory on the CPU as well, the barrier only has to be counted
+        Reference(resource);
+        _commands.emplace_back([](ExecutionStats& stats){ ++stats.AliasingBarriers; });
+    }
+
+    void HeadlessCommandList::CommitBarriers(){
+        // There is no API to record the batch on, committing it only counts its barriers
+        _stateTracker.CommitBarriers();
+    }
+
+    F_ResourceStates HeadlessCommandList::GetTextureSubresourceState(EFRAPITexture* texture,
+                                                                     const ArraySlice arraySlice,
+                                                                     const MipLevel mipLevel){
+        return _stateTracker.GetTextureSubresourceState(static_cast<HeadlessTexture*>(texture), arraySlice,
+                                                        mipLevel);
+    }
+
+    F_ResourceStates HeadlessCommandList::GetBufferState(EFRAPIBuffer* buffer){
+        return _stateTracker.GetBufferState(static_cast<HeadlessBuffer*>(buffer));
+    }
+
+    EFDynamicRAPI* HeadlessCommandList::GetDevice(){
+        return _device;
+    }
+
+    HeadlessCommandList::ExecutionStats HeadlessCommandList::Execute(){
+        ExecutionStats stats;
+        for (const auto& command : _commands){
+            command(stats);
+        }
+        _stateTracker.CommandListExecuted();
+        // Fenced by the submission the device signals next, a list that is never opened again does not pin the ring
+        _uploads.Retire();
+        return stats;
+    }
+
+    void HeadlessCommandList::RequireTextureState(EFRAPITexture* texture, const TextureSubresourceSet& subresources,
+                                                  const F_ResourceStates state){
+        if (_bEnableAutomaticBarriers && texture){
+            SetTextureState(texture, subresources, state);
+        }
+    }
+
+    void HeadlessCommandList::RequireBufferState(EFRAPIBuffer* buffer, const F_ResourceStates state){
+        if (_bEnableAutomaticBarriers && buffer){
+            SetBufferState(buffer, state);
+        }
+    }
+
+    void HeadlessCommandList::SetBindingStates(const BindingSetVector& bindings){
+        for (EFRAPIBindingSet* bindingSet : bindings){
+            SetResourceStatesForBindingSet(bindingSet);
+        }
+    }
+
+    void HeadlessCommandList::Reference(EFRAPIResource* resource){
+        if (resource){
+            _referencedResources.emplace_back(resource);
+        }
+    }
+} // EventfulEngine
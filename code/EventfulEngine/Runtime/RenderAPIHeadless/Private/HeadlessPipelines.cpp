@@ -0,0 +1,183 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+#include "EFRAPIPipelineCache.h"
+
+#include <cstring>
+#include <thread>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint32 HEADLESS_PIPELINE_BINARY_MAGIC = 0x42484645; // "EFHB"
+
+        struct HeadlessPipelineBinary{
+            uint32 Magic;
+            uint32 Reserved;
+            uint64 ContentHash;
+        };
+
+        bool IsBinaryOf(const void* binary, const size_t binarySize, const uint64 contentHash){
+            if (!binary || binarySize != sizeof(HeadlessPipelineBinary)){
+                return false;
+            }
+            HeadlessPipelineBinary header{};
+            std::memcpy(&header, binary, sizeof(header));
+            return header.Magic == HEADLESS_PIPELINE_BINARY_MAGIC && header.ContentHash == contentHash;
+        }
+    }
+
+    HeadlessShader::HeadlessShader(const ShaderDesc& desc, const void* binary, const size_t binarySize) : Desc(desc){
+        const auto* bytes = static_cast<const uint8*>(binary);
+        if (bytes){
+            Bytecode.assign(bytes, bytes + binarySize);
+        }
+    }
+
+    void HeadlessShader::GetBytecode(const void** ppBytecode, size_t* pSize) const{
+        if (ppBytecode){
+            *ppBytecode = Bytecode.data();
+        }
+        if (pSize){
+            *pSize = Bytecode.size();
+        }
+    }
+
+    HeadlessShaderLibrary::HeadlessShaderLibrary(const void* binary, const size_t binarySize){
+        const auto* bytes = static_cast<const uint8*>(binary);
+        if (bytes){
+            Bytecode.assign(bytes, bytes + binarySize);
+        }
+    }
+
+    void HeadlessShaderLibrary::GetBytecode(const void** ppBytecode, size_t* pSize) const{
+        if (ppBytecode){
+            *ppBytecode = Bytecode.data();
+        }
+        if (pSize){
+            *pSize = Bytecode.size();
+        }
+    }
+
+    ShaderHandle HeadlessShaderLibrary::GetShader(const char* entryName, const F_ShaderType shaderType){
+        ShaderDesc desc;
+        desc.SetShaderType(shaderType).SetEntryName(entryName);
+        return ShaderHandle::Create(new HeadlessShader(desc, Bytecode.data(), Bytecode.size()));
+    }
+
+    HeadlessFramebuffer::HeadlessFramebuffer(const FramebufferDesc& desc) : Desc(desc), Info(desc){
+        for (const FramebufferAttachment& attachment : desc.ColorAttachments){
+            Resources.emplace_back(attachment.Texture);
+        }
+        if (desc.DepthAttachment.IsValid()){
+            Resources.emplace_back(desc.DepthAttachment.Texture);
+        }
+        if (desc.ShadingRateAttachment.IsValid()){
+            Resources.emplace_back(desc.ShadingRateAttachment.Texture);
+        }
+    }
+
+    ShaderHandle EFHeadlessRAPI::CreateShader(const ShaderDesc& d, const void* binary, const size_t binarySize){
+        return ShaderHandle::Create(Track(new HeadlessShader(d, binary, binarySize)));
+    }
+
+    ShaderHandle EFHeadlessRAPI::CreateShaderSpecialization(EFRAPIShader* baseShader,
+                                                            const ShaderSpecialization* constants,
+                                                            const uint32_t numConstants){
+        const auto* base = static_cast<HeadlessShader*>(baseShader);
+        auto* shader = new HeadlessShader(base->Desc, base->Bytecode.data(), base->Bytecode.size());
+        shader->Specializations.assign(constants, constants + numConstants);
+        return ShaderHandle::Create(Track(shader));
+    }
+
+    ShaderLibraryHandle EFHeadlessRAPI::CreateShaderLibrary(const void* binary, const size_t binarySize){
+        return ShaderLibraryHandle::Create(Track(new HeadlessShaderLibrary(binary, binarySize)));
+    }
+
+    InputLayoutHandle EFHeadlessRAPI::CreateInputLayout(const VertexAttributeDesc* d, const uint32_t attributeCount,
+                                                        EFRAPIShader*){
+        return InputLayoutHandle::Create(Track(new HeadlessInputLayout(d, attributeCount)));
+    }
+
+    FramebufferHandle EFHeadlessRAPI::CreateFramebuffer(const FramebufferDesc& desc){
+        return FramebufferHandle::Create(Track(new HeadlessFramebuffer(desc)));
+    }
+
+    GraphicsPipelineHandle EFHeadlessRAPI::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc,
+                                                                  EFRAPIFramebuffer* fb){
+        if (!fb){
+            return nullptr;
+        }
+        SimulatePipelineCompilation();
+        return GraphicsPipelineHandle::Create(Track(new HeadlessGraphicsPipeline(desc, fb->GetFramebufferInfo())));
+    }
+
+    ComputePipelineHandle EFHeadlessRAPI::CreateComputePipeline(const ComputePipelineDesc& desc){
+        if (!desc.CS){
+            return nullptr;
+        }
+        SimulatePipelineCompilation();
+        return ComputePipelineHandle::Create(Track(new HeadlessComputePipeline(desc)));
+    }
+
+    MeshletPipelineHandle EFHeadlessRAPI::CreateMeshletPipeline(const MeshletPipelineDesc& desc,
+                                                                EFRAPIFramebuffer* fb){
+        if (!fb){
+            return nullptr;
+        }
+        return MeshletPipelineHandle::Create(Track(new HeadlessMeshletPipeline(desc, fb->GetFramebufferInfo())));
+    }
+
+    bool EFHeadlessRAPI::GetPipelineBinary(EFRAPIResource* pipeline, std::vector<uint8>& outBinary){
+        HeadlessPipelineBinary header{HEADLESS_PIPELINE_BINARY_MAGIC, 0, 0};
+        if (const auto* graphicsPipeline = dynamic_cast<HeadlessGraphicsPipeline*>(pipeline)){
+            header.ContentHash = HashGraphicsPipeline(graphicsPipeline->Desc, graphicsPipeline->Info);
+        }
+        else if (const auto* computePipeline = dynamic_cast<HeadlessComputePipeline*>(pipeline)){
+            header.ContentHash = HashComputePipeline(computePipeline->Desc);
+        }
+        else{
+            return false;
+        }
+        const auto* bytes = reinterpret_cast<const uint8*>(&header);
+        outBinary.assign(bytes, bytes + sizeof(header));
+        return true;
+    }
+
+    GraphicsPipelineHandle EFHeadlessRAPI::CreateGraphicsPipelineFromBinary(const GraphicsPipelineDesc& desc,
+                                                                            EFRAPIFramebuffer* fb, const void* binary,
+                                                                            const size_t binarySize){
+        if (!fb || !IsBinaryOf(binary, binarySize, HashGraphicsPipeline(desc, fb->GetFramebufferInfo()))){
+            return CreateGraphicsPipeline(desc, fb);
+        }
+        {
+            std::scoped_lock lock(_queueMutex);
+            ++_stats.PipelinesFromBinary;
+        }
+        return GraphicsPipelineHandle::Create(Track(new HeadlessGraphicsPipeline(desc, fb->GetFramebufferInfo())));
+    }
+
+    ComputePipelineHandle EFHeadlessRAPI::CreateComputePipelineFromBinary(const ComputePipelineDesc& desc,
+                                                                          const void* binary,
+                                                                          const size_t binarySize){
+        if (!desc.CS || !IsBinaryOf(binary, binarySize, HashComputePipeline(desc))){
+            return CreateComputePipeline(desc);
+        }
+        {
+            std::scoped_lock lock(_queueMutex);
+            ++_stats.PipelinesFromBinary;
+        }
+        return ComputePipelineHandle::Create(Track(new HeadlessComputePipeline(desc)));
+    }
+
+    void EFHeadlessRAPI::SimulatePipelineCompilation(){
+        EFDuration compileTime;
+        {
+            std::scoped_lock lock(_queueMutex);
+            ++_stats.PipelinesCompiled;
+            compileTime = _pipelineCompileTime;
+        }
+        if (compileTime > EFDuration::zero()){
+            std::this_thread::sleep_for(compileTime);
+        }
+    }
+} // EventfulEngine
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+#include "GenericPlatformTime.h"
+
+namespace EventfulEngine{
+    EventQueryHandle EFHeadlessRAPI::CreateEventQuery(){
+        return EventQueryHandle::Create(Track(new HeadlessEventQuery()));
+    }
+
+    void EFHeadlessRAPI::SetEventQuery(EFRAPIEventQuery* query, const E_CommandQueue queue){
+        auto* eventQuery = static_cast<HeadlessEventQuery*>(query);
+        eventQuery->B_IsStarted = true;
+        eventQuery->Queue = queue;
+        eventQuery->Instance = GetLastSubmittedInstance(queue);
+    }
+
+    bool EFHeadlessRAPI::PollEventQuery(EFRAPIEventQuery* query){
+        // Lists finished executing before ExecuteCommandLists returned, a set query is signaled unless held back
+        std::scoped_lock lock(_queueMutex);
+        return static_cast<HeadlessEventQuery*>(query)->B_IsStarted && _bAreEventQueriesSignaled;
+    }
+
+    void EFHeadlessRAPI::WaitEventQuery(EFRAPIEventQuery*){
+    }
+
+    void EFHeadlessRAPI::ResetEventQuery(EFRAPIEventQuery* query){
+        auto* eventQuery = static_cast<HeadlessEventQuery*>(query);
+        eventQuery->B_IsStarted = false;
+        eventQuery->Instance = 0;
+    }
+
+    TimerQueryHandle EFHeadlessRAPI::CreateTimerQuery(){
+        return TimerQueryHandle::Create(Track(new HeadlessTimerQuery()));
+    }
+
+    bool EFHeadlessRAPI::PollTimerQuery(EFRAPITimerQuery* query){
+        return static_cast<HeadlessTimerQuery*>(query)->B_IsResolved.load(std::memory_order_acquire);
+    }
+
+    float EFHeadlessRAPI::GetTimerQueryTime(EFRAPITimerQuery* query){
+        const auto* timerQuery = static_cast<HeadlessTimerQuery*>(query);
+        if (!timerQuery->B_IsResolved.load(std::memory_order_acquire)){
+            return 0.f;
+        }
+        const uint64 begin = timerQuery->BeginCycles.load(std::memory_order_relaxed);
+        const uint64 end = timerQuery->EndCycles.load(std::memory_order_relaxed);
+        return static_cast<float>(EFPlatformTime::CyclesToSeconds(end > begin ? end - begin : 0));
+    }
+
+    void EFHeadlessRAPI::ResetTimerQuery(EFRAPITimerQuery* query){
+        auto* timerQuery = static_cast<HeadlessTimerQuery*>(query);
+        timerQuery->B_IsResolved.store(false, std::memory_order_relaxed);
+        timerQuery->BeginCycles.store(0, std::memory_order_relaxed);
+        timerQuery->EndCycles.store(0, std::memory_order_relaxed);
+    }
+} // EventfulEngine
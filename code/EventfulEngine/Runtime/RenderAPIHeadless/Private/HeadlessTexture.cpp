@@ -0,0 +1,157 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+
+namespace EventfulEngine{
+    namespace{
+        // Default placement alignment of textures on D3D12, so placed textures sub allocate like they would there
+        constexpr uint64 TEXTURE_PLACEMENT_ALIGNMENT = 64 * 1024;
+    }
+
+    HeadlessTextureLayout::HeadlessTextureLayout(const TextureDesc& desc) : MipLevels(std::max(desc.MipLevels, 1u)){
+        const FormatInfo& formatInfo = GetFormatInfo(desc.Format);
+        BytesPerBlock = formatInfo.bytesPerBlock;
+        BlockSize = std::max<uint32>(formatInfo.blockSize, 1);
+
+        const bool bIsVolume = desc.Dimension == E_TextureDimension::Texture3D;
+        const uint32 arraySize = bIsVolume ? 1 : std::max(desc.ArraySize, 1u);
+        Subresources.reserve(static_cast<size_t>(arraySize) * MipLevels);
+        for (ArraySlice arraySlice = 0; arraySlice < arraySize; ++arraySlice){
+            for (MipLevel mipLevel = 0; mipLevel < MipLevels; ++mipLevel){
+                Subresource& subresource = Subresources.emplace_back();
+                subresource.Width = std::max(desc.Width >> mipLevel, 1u);
+                subresource.Height = std::max(desc.Height >> mipLevel, 1u);
+                subresource.Depth = bIsVolume ? std::max(desc.Depth >> mipLevel, 1u) : 1;
+
+                const uint64 widthInBlocks = (subresource.Width + BlockSize - 1) / BlockSize;
+                const uint64 heightInBlocks = (subresource.Height + BlockSize - 1) / BlockSize;
+                subresource.RowPitch = widthInBlocks * BytesPerBlock;
+                subresource.DepthPitch = subresource.RowPitch * heightInBlocks;
+                subresource.Offset = Size;
+                Size += subresource.DepthPitch * subresource.Depth;
+            }
+        }
+    }
+
+    uint64 HeadlessTextureLayout::GetTexelOffset(const TextureSlice& slice) const{
+        const Subresource& subresource = Get(slice.TexMipLevel, slice.TexArraySlice);
+        return subresource.Offset
+            + slice.Z * subresource.DepthPitch
+            + slice.Y / BlockSize * subresource.RowPitch
+            + static_cast<uint64>(slice.X / BlockSize) * BytesPerBlock;
+    }
+
+    HeadlessTexture::HeadlessTexture(const TextureDesc& desc) : TextureStateExtension(Desc), Desc(desc), Layout(desc){
+        if (!Desc.B_IsVirtual){
+            OwnedMemory.resize(Layout.Size);
+            Data = OwnedMemory.data();
+        }
+    }
+
+    EFRAPIObject HeadlessTexture::GetNativeView(ObjectType, E_Format, TextureSubresourceSet, E_TextureDimension,
+                                                bool){
+        return static_cast<EFRAPIObject>(nullptr);
+    }
+
+    HeadlessStagingTexture::HeadlessStagingTexture(const TextureDesc& desc, const E_CpuAccessMode cpuAccess)
+        : Desc(desc), Layout(desc), Memory(Layout.Size), CpuAccess(cpuAccess){
+    }
+
+    TextureHandle EFHeadlessRAPI::CreateTexture(const TextureDesc& d){
+        if (d.Format == E_Format::UNKNOWN || d.Width == 0 || d.Height == 0){
+            return nullptr;
+        }
+        return TextureHandle::Create(Track(new HeadlessTexture(d)));
+    }
+
+    MemoryRequirements EFHeadlessRAPI::GetTextureMemoryRequirements(EFRAPITexture* texture){
+        const uint64 size = static_cast<HeadlessTexture*>(texture)->Layout.Size;
+        return {
+            (size + TEXTURE_PLACEMENT_ALIGNMENT - 1) & ~(TEXTURE_PLACEMENT_ALIGNMENT - 1), TEXTURE_PLACEMENT_ALIGNMENT
+        };
+    }
+
+    bool EFHeadlessRAPI::BindTextureMemory(EFRAPITexture* texture, IHeap* heap, const uint64_t offset){
+        auto* headlessTexture = static_cast<HeadlessTexture*>(texture);
+        auto* headlessHeap = static_cast<HeadlessHeap*>(heap);
+        if (!headlessTexture->Desc.B_IsVirtual || headlessTexture->Heap || !headlessHeap){
+            return false;
+        }
+        if (offset % TEXTURE_PLACEMENT_ALIGNMENT != 0 ||
+            offset + headlessTexture->Layout.Size > headlessHeap->Memory.size()){
+            return false;
+        }
+
+        headlessTexture->Heap = heap;
+        headlessTexture->Data = headlessHeap->Memory.data() + offset;
+        return true;
+    }
+
+    TextureHandle EFHeadlessRAPI::CreateHandleForNativeTexture(ObjectType, EFRAPIObject, const TextureDesc&){
+        return nullptr;
+    }
+
+    StagingTextureHandle EFHeadlessRAPI::CreateStagingTexture(const TextureDesc& d, const E_CpuAccessMode cpuAccess){
+        if (d.Format == E_Format::UNKNOWN || cpuAccess == E_CpuAccessMode::None){
+            return nullptr;
+        }
+        return StagingTextureHandle::Create(Track(new HeadlessStagingTexture(d, cpuAccess)));
+    }
+
+    void* EFHeadlessRAPI::MapStagingTexture(EFRAPIStagingTexture* tex, const TextureSlice& slice,
+                                            const E_CpuAccessMode cpuAccess, size_t* outRowPitch){
+        auto* stagingTexture = static_cast<HeadlessStagingTexture*>(tex);
+        if (cpuAccess == E_CpuAccessMode::None || stagingTexture->B_IsMapped){
+            return nullptr;
+        }
+
+        const TextureSlice resolvedSlice = slice.Resolve(stagingTexture->Desc);
+        if (outRowPitch){
+            *outRowPitch = stagingTexture->Layout.Get(resolvedSlice.TexMipLevel, resolvedSlice.TexArraySlice).RowPitch;
+        }
+        stagingTexture->B_IsMapped = true;
+        return stagingTexture->Memory.data() + stagingTexture->Layout.GetTexelOffset(resolvedSlice);
+    }
+
+    void EFHeadlessRAPI::UnmapStagingTexture(EFRAPIStagingTexture* tex){
+        static_cast<HeadlessStagingTexture*>(tex)->B_IsMapped = false;
+    }
+
+    void EFHeadlessRAPI::GetTextureTiling(EFRAPITexture*, uint32_t* numTiles, PackedMipDesc* desc,
+                                          TileShape* tileShape, uint32_t* subresourceTilingsNum,
+                                          SubresourceTiling*){
+        // Tiled textures are not supported, report them as having no tiles
+        if (numTiles){
+            *numTiles = 0;
+        }
+        if (desc){
+            *desc = {};
+        }
+        if (tileShape){
+            *tileShape = {};
+        }
+        if (subresourceTilingsNum){
+            *subresourceTilingsNum = 0;
+        }
+    }
+
+    void EFHeadlessRAPI::UpdateTextureTileMappings(EFRAPITexture*, const TextureTilesMapping*, uint32_t,
+                                                   E_CommandQueue){
+    }
+
+    SamplerFeedbackTextureHandle EFHeadlessRAPI::CreateSamplerFeedbackTexture(EFRAPITexture*,
+                                                                              const SamplerFeedbackTextureDesc&){
+        return nullptr;
+    }
+
+    SamplerFeedbackTextureHandle EFHeadlessRAPI::CreateSamplerFeedbackForNativeTexture(ObjectType, EFRAPIObject,
+                                                                                       EFRAPITexture*){
+        return nullptr;
+    }
+
+    SamplerHandle EFHeadlessRAPI::CreateSampler(const SamplerDesc& d){
+        return SamplerHandle::Create(Track(new HeadlessSampler(d)));
+    }
+} // EventfulEngine
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+#include "EFRAPIDeferredCommandList.h"
+#include "EFRAPIProfiler.h"
+#include "ModuleManager.h"
+
+#include <algorithm>
+
+namespace EventfulEngine{
+    namespace{
+        constexpr uint64 UPLOAD_RING_SIZE = 16 * 1024 * 1024;
+    }
+
+    EFHeadlessRAPI::~EFHeadlessRAPI(){
+        // Command lists retire their uploads when they are destroyed, so they go before the upload manager and its
+        // ring buffer goes after it
+        for (CommandListHandle& translationList : _translationLists){
+            translationList = nullptr;
+        }
+        _retireQueue->DestroyAll();
+        _uploadManager.reset();
+        // Objects the application still holds keep the queue alive and are deleted as soon as they are released
+        _retireQueue->Close();
+    }
+
+    E_RenderAPI EFHeadlessRAPI::GetGraphicsAPI(){
+        return E_RenderAPI::Headless;
+    }
+
+    CommandListHandle EFHeadlessRAPI::CreateCommandList(const CommandListParameters& params){
+        if (!params.enableImmediateExecution){
+            return CommandListHandle::Create(Track(new EFRAPIDeferredCommandList(this, params)));
+        }
+        return CommandListHandle::Create(Track(new HeadlessCommandList(this, params)));
+    }
+
+    uint64 EFHeadlessRAPI::ExecuteCommandLists(EFRAPICommandList* const* pCommandLists, const size_t numCommandLists,
+                                               const E_CommandQueue executionQueue){
+        uint64 instance = 0;
+        {
+            std::scoped_lock lock(_queueMutex);
+            uint64 bytesUploaded = 0;
+            uint64 barriersIssued = 0;
+            uint64 barriersElided = 0;
+            for (size_t index = 0; index < numCommandLists; ++index){
+                EFRAPICommandList* executedList = pCommandLists[index];
+                if (const EFRAPIDeferredCommandList* deferredList = EFRAPIDeferredCommandList::FromCommandList(
+                    executedList)){
+                    CommandListHandle& translationList = _translationLists[static_cast<size_t>(executionQueue)];
+                    if (!translationList){
+                        translationList = CommandListHandle::Create(Track(new HeadlessCommandList(
+                            this, CommandListParameters().setQueueType(executionQueue))));
+                    }
+                    translationList->Open();
+                    deferredList->Replay(translationList);
+                    translationList->Close();
+                    executedList = translationList;
+                }
+                auto* commandList = static_cast<HeadlessCommandList*>(executedList);
+                const HeadlessCommandList::ExecutionStats executionStats = commandList->Execute();
+                const EFRAPICommandList::RecordingStats& recordingStats = commandList->GetRecordingStats();
+
+                ++_stats.ExecutedCommandLists;
+                _stats.DrawCalls += recordingStats.DrawCalls;
+                _stats.Dispatches += recordingStats.Dispatches;
+                _stats.BytesUploaded += executionStats.BytesUploaded;
+                _stats.BytesCopied += executionStats.BytesCopied;
+                _stats.AliasingBarriers += executionStats.AliasingBarriers;
+                bytesUploaded += executionStats.BytesUploaded;
+                barriersIssued += commandList->GetBarrierStats().BarriersIssued;
+                barriersElided += commandList->GetBarrierStats().BarriersElided;
+            }
+            _stats.Barriers += barriersIssued;
+            _stats.BarriersElided += barriersElided;
+
+            ReportExecutedCommandLists(pCommandLists, numCommandLists);
+            EFProfiler::AddCounter("BytesUploaded", static_cast<int64>(bytesUploaded));
+            // Deferred lists are tracked by their translation list, the counters come from the executed lists
+            EFProfiler::AddCounter("BarriersIssued", static_cast<int64>(barriersIssued));
+            EFProfiler::AddCounter("BarriersElided", static_cast<int64>(barriersElided));
+            instance = ++_lastSubmittedInstances[static_cast<size_t>(executionQueue)];
+        }
+
+        // Outside the queue lock, setting the fence reads the submitted instance
+        GetUploadManager()->SignalSubmission(executionQueue);
+        return instance;
+    }
+
+    void EFHeadlessRAPI::QueueWaitForCommandList(E_CommandQueue, E_CommandQueue, uint64_t){
+        // Queues execute in submission order on the calling thread, there is nothing to wait for
+    }
+
+    bool EFHeadlessRAPI::WaitForIdle(){
+        return true;
+    }
+
+    void EFHeadlessRAPI::RunGarbageCollection(){
+        // Queues execute on the submitting thread, every submitted instance has completed
+        const EFRAPIRetireQueue::QueueInstances submitted = GetLastSubmittedInstances();
+        _retireQueue->CloseFrame(submitted);
+        _retireQueue->Collect(submitted);
+        GetUploadManager()->EndFrame();
+    }
+
+    bool EFHeadlessRAPI::QueryFeatureSupport(const E_Feature feature, void* pInfo, const size_t infoSize){
+        switch (feature){
+            using enum E_Feature;
+        case WaveLaneCountMinMax:
+            if (pInfo && infoSize == sizeof(WaveLaneCountMinMaxFeatureInfo)){
+                auto* info = static_cast<WaveLaneCountMinMaxFeatureInfo*>(pInfo);
+                info->minWaveLaneCount = 32;
+                info->maxWaveLaneCount = 32;
+            }
+            return true;
+        case ComputeQueue:
+        case CopyQueue:
+        case ConstantBufferRanges:
+        case DeferredCommandLists:
+        case Meshlets:
+        case ShaderSpecializations:
+        case VirtualResources:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    F_FormatSupport EFHeadlessRAPI::QueryFormatSupport(const E_Format format){
+        if (format == E_Format::UNKNOWN || format >= E_Format::COUNT){
+            return F_FormatSupport::None;
+        }
+
+        const FormatInfo& info = GetFormatInfo(format);
+        if (info.kind == FormatKind::DepthStencil){
+            return F_FormatSupport::Texture | F_FormatSupport::DepthStencil | F_FormatSupport::ShaderLoad;
+        }
+        if (info.blockSize != 1){
+            return F_FormatSupport::Texture | F_FormatSupport::ShaderLoad | F_FormatSupport::ShaderSample;
+        }
+
+        F_FormatSupport support = F_FormatSupport::Buffer | F_FormatSupport::VertexBuffer | F_FormatSupport::Texture |
+            F_FormatSupport::RenderTarget | F_FormatSupport::ShaderLoad | F_FormatSupport::ShaderSample |
+            F_FormatSupport::ShaderUavLoad | F_FormatSupport::ShaderUavStore;
+        if (info.kind != FormatKind::Integer){
+            support |= F_FormatSupport::Blendable;
+        }
+        if (format == E_Format::R16_UINT || format == E_Format::R32_UINT){
+            support |= F_FormatSupport::IndexBuffer;
+        }
+        if (format == E_Format::R32_UINT || format == E_Format::R32_SINT){
+            support |= F_FormatSupport::ShaderAtomic;
+        }
+        return support;
+    }
+
+    EFRAPIObject EFHeadlessRAPI::GetNativeQueue(ObjectType, E_CommandQueue){
+        return static_cast<EFRAPIObject>(nullptr);
+    }
+
+    EFRAPIMessageCallback* EFHeadlessRAPI::GetMessageCallback(){
+        return nullptr;
+    }
+
+    bool EFHeadlessRAPI::IsAftermathEnabled(){
+        return false;
+    }
+
+    HeadlessDeviceStats EFHeadlessRAPI::GetStats(){
+        std::scoped_lock lock(_queueMutex);
+        return _stats;
+    }
+
+    void EFHeadlessRAPI::ResetStats(){
+        std::scoped_lock lock(_queueMutex);
+        _stats = {};
+        _retireQueue->ResetStats();
+    }
+
+    RetireQueueStats EFHeadlessRAPI::GetRetireQueueStats(){
+        return _retireQueue->GetStats();
+    }
+
+    EFRAPIUploadManager* EFHeadlessRAPI::GetUploadManager(){
+        std::call_once(_uploadManagerCreated, [this]{
+            _uploadManager = std::make_unique<EFRAPIUploadManager>(this, UPLOAD_RING_SIZE);
+        });
+        return _uploadManager.get();
+    }
+
+    void EFHeadlessRAPI::SetPipelineCompileTime(const EFDuration compileTime){
+        std::scoped_lock lock(_queueMutex);
+        _pipelineCompileTime = compileTime;
+    }
+
+    void EFHeadlessRAPI::SetEventQueriesSignaled(const bool bIsSignaled){
+        std::scoped_lock lock(_queueMutex);
+        _bAreEventQueriesSignaled = bIsSignaled;
+    }
+
+    uint64 EFHeadlessRAPI::GetLastSubmittedInstance(const E_CommandQueue queue){
+        std::scoped_lock lock(_queueMutex);
+        return _lastSubmittedInstances[static_cast<size_t>(queue)];
+    }
+
+    EFRAPIRetireQueue::QueueInstances EFHeadlessRAPI::GetLastSubmittedInstances(){
+        std::scoped_lock lock(_queueMutex);
+        EFRAPIRetireQueue::QueueInstances instances;
+        std::ranges::copy(_lastSubmittedInstances, instances.begin());
+        return instances;
+    }
+
+    DynamicRAPIHandle CreateHeadlessRAPI(){
+        return DynamicRAPIHandle::Create(new EFHeadlessRAPI());
+    }
+
+    DynamicRAPIHandle RenderAPIHeadlessModule::CreateDynamicRAPI(E_Feature){
+        return CreateHeadlessRAPI();
+    }
+} // EventfulEngine
+
+IMPLEMENT_MODULE(EventfulEngine::RenderAPIHeadlessModule, EFRenderAPIHeadless)
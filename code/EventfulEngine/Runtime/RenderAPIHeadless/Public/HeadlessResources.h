@@ -0,0 +1,434 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "EFRAPIStateTracker.h"
+#include "EFRAPIUploadManager.h"
+#include "EFRenderAPIHeadlessModuleAPI.h"
+
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace EventfulEngine{
+    class EFHeadlessRAPI;
+
+    // Heaps are plain CPU memory, placed resources point into it
+    class HeadlessHeap final : public RefCounter<IHeap>{
+    public:
+        explicit HeadlessHeap(const HeapDesc& desc) : Desc(desc), Memory(desc.capacity){
+        }
+
+        const HeapDesc& getDesc() override{ return Desc; }
+
+        HeapDesc Desc;
+        std::vector<uint8> Memory;
+    };
+
+    class HeadlessBuffer final : public RefCounter<EFRAPIBuffer>, public BufferStateExtension{
+    public:
+        // Virtual buffers get their memory from BindBufferMemory, every other buffer owns its memory
+        explicit HeadlessBuffer(const BufferDesc& desc);
+
+        [[nodiscard]] const BufferDesc& GetDesc() const override{ return Desc; }
+
+        BufferDesc Desc;
+        uint8* Data = nullptr;
+        std::vector<uint8> OwnedMemory;
+        HeapHandle Heap;
+        bool B_IsMapped = false;
+    };
+
+    // Linear layout of all subresources, array slice major with the mips of a slice tightly packed.
+    // Multisampled textures only store a single sample.
+    struct HeadlessTextureLayout{
+        struct Subresource{
+            uint64 Offset = 0;
+            uint64 RowPitch = 0;
+            uint64 DepthPitch = 0;
+            uint32 Width = 1;
+            uint32 Height = 1;
+            uint32 Depth = 1;
+        };
+
+        HeadlessTextureLayout() = default;
+
+        explicit HeadlessTextureLayout(const TextureDesc& desc);
+
+        [[nodiscard]] const Subresource& Get(MipLevel mipLevel, ArraySlice arraySlice) const{
+            return Subresources[arraySlice * MipLevels + mipLevel];
+        }
+
+        [[nodiscard]] bool Contains(const MipLevel mipLevel, const ArraySlice arraySlice) const{
+            return mipLevel < MipLevels && static_cast<size_t>(arraySlice) * MipLevels + mipLevel < Subresources.size();
+        }
+
+        // Byte offset of a texel in a subresource, the coordinates have to be block aligned
+        [[nodiscard]] uint64 GetTexelOffset(const TextureSlice& slice) const;
+
+        std::vector<Subresource> Subresources;
+        uint64 Size = 0;
+        uint32 MipLevels = 1;
+        uint32 BytesPerBlock = 0;
+        uint32 BlockSize = 1;
+    };
+
+    class HeadlessTexture final : public RefCounter<EFRAPITexture>, public TextureStateExtension{
+    public:
+        explicit HeadlessTexture(const TextureDesc& desc);
+
+        [[nodiscard]] const TextureDesc& GetDesc() const override{ return Desc; }
+
+        EFRAPIObject GetNativeView(ObjectType objectType, E_Format format, TextureSubresourceSet subresources,
+                                   E_TextureDimension dimension, bool isReadOnlyDSV) override;
+
+        TextureDesc Desc;
+        HeadlessTextureLayout Layout;
+        uint8* Data = nullptr;
+        std::vector<uint8> OwnedMemory;
+        HeapHandle Heap;
+    };
+
+    class HeadlessStagingTexture final : public RefCounter<EFRAPIStagingTexture>{
+    public:
+        HeadlessStagingTexture(const TextureDesc& desc, E_CpuAccessMode cpuAccess);
+
+        [[nodiscard]] const TextureDesc& GetDesc() const override{ return Desc; }
+
+        TextureDesc Desc;
+        HeadlessTextureLayout Layout;
+        std::vector<uint8> Memory;
+        E_CpuAccessMode CpuAccess;
+        bool B_IsMapped = false;
+    };
+
+    class HeadlessShader final : public RefCounter<EFRAPIShader>{
+    public:
+        HeadlessShader(const ShaderDesc& desc, const void* binary, size_t binarySize);
+
+        [[nodiscard]] const ShaderDesc& GetDesc() const override{ return Desc; }
+
+        void GetBytecode(const void** ppBytecode, size_t* pSize) const override;
+
+        [[nodiscard]] std::span<const ShaderSpecialization> GetSpecializations() const override{
+            return Specializations;
+        }
+
+        ShaderDesc Desc;
+        std::vector<uint8> Bytecode;
+        std::vector<ShaderSpecialization> Specializations;
+    };
+
+    class HeadlessShaderLibrary final : public RefCounter<EFRAPIShaderLibrary>{
+    public:
+        HeadlessShaderLibrary(const void* binary, size_t binarySize);
+
+        void GetBytecode(const void** ppBytecode, size_t* pSize) const override;
+
+        ShaderHandle GetShader(const char* entryName, F_ShaderType shaderType) override;
+
+        std::vector<uint8> Bytecode;
+    };
+
+    class HeadlessSampler final : public RefCounter<EFRAPISampler>{
+    public:
+        explicit HeadlessSampler(const SamplerDesc& desc) : Desc(desc){
+        }
+
+        [[nodiscard]] const SamplerDesc& GetDesc() const override{ return Desc; }
+
+        SamplerDesc Desc;
+    };
+
+    class HeadlessInputLayout final : public RefCounter<EFRAPIInputLayout>{
+    public:
+        HeadlessInputLayout(const VertexAttributeDesc* attributes, const uint32 attributeCount)
+            : Attributes(attributes, attributes + attributeCount){
+        }
+
+        [[nodiscard]] uint32 GetNumAttributes() const override{ return static_cast<uint32>(Attributes.size()); }
+
+        [[nodiscard]] const VertexAttributeDesc* GetAttributeDesc(const uint32 index) const override{
+            return index < Attributes.size() ? &Attributes[index] : nullptr;
+        }
+
+        std::vector<VertexAttributeDesc> Attributes;
+    };
+
+    // Command lists execute synchronously in ExecuteCommandLists, so a query is done once its list was executed
+    class HeadlessEventQuery final : public RefCounter<EFRAPIEventQuery>{
+    public:
+        bool B_IsStarted = false;
+        uint64 Instance = 0;
+        E_CommandQueue Queue = E_CommandQueue::Graphics;
+    };
+
+    // Measures the CPU time the commands between begin and end took to execute
+    class HeadlessTimerQuery final : public RefCounter<EFRAPITimerQuery>{
+    public:
+        std::atomic<uint64> BeginCycles{0};
+        std::atomic<uint64> EndCycles{0};
+        std::atomic<bool> B_IsResolved{false};
+    };
+
+    class HeadlessFramebuffer final : public RefCounter<EFRAPIFramebuffer>{
+    public:
+        explicit HeadlessFramebuffer(const FramebufferDesc& desc);
+
+        [[nodiscard]] const FramebufferDesc& GetDesc() const override{ return Desc; }
+
+        [[nodiscard]] const FramebufferInfoEx& GetFramebufferInfo() const override{ return Info; }
+
+        FramebufferDesc Desc;
+        FramebufferInfoEx Info;
+        // The desc only holds raw pointers, the framebuffer keeps its attachments alive
+        std::vector<TextureHandle> Resources;
+    };
+
+    class HeadlessGraphicsPipeline final : public RefCounter<EFRAPIGraphicsPipeline>{
+    public:
+        HeadlessGraphicsPipeline(const GraphicsPipelineDesc& desc, const FramebufferInfo& framebufferInfo)
+            : Desc(desc), Info(framebufferInfo){
+        }
+
+        [[nodiscard]] const GraphicsPipelineDesc& GetDesc() const override{ return Desc; }
+
+        [[nodiscard]] const FramebufferInfo& GetFramebufferInfo() const override{ return Info; }
+
+        GraphicsPipelineDesc Desc;
+        FramebufferInfo Info;
+    };
+
+    class HeadlessComputePipeline final : public RefCounter<EFRAPIComputePipeline>{
+    public:
+        explicit HeadlessComputePipeline(const ComputePipelineDesc& desc) : Desc(desc){
+        }
+
+        [[nodiscard]] const ComputePipelineDesc& GetDesc() const override{ return Desc; }
+
+        ComputePipelineDesc Desc;
+    };
+
+    class HeadlessMeshletPipeline final : public RefCounter<IMeshletPipeline>{
+    public:
+        HeadlessMeshletPipeline(const MeshletPipelineDesc& desc, const FramebufferInfo& framebufferInfo)
+            : Desc(desc), Info(framebufferInfo){
+        }
+
+        [[nodiscard]] const MeshletPipelineDesc& GetDesc() const override{ return Desc; }
+
+        [[nodiscard]] const FramebufferInfo& GetFramebufferInfo() const override{ return Info; }
+
+        MeshletPipelineDesc Desc;
+        FramebufferInfo Info;
+    };
+
+    class HeadlessBindingLayout final : public RefCounter<EFRAPIBindingLayout>{
+    public:
+        explicit HeadlessBindingLayout(const BindingLayoutDesc& desc) : Desc(desc){
+        }
+
+        explicit HeadlessBindingLayout(const BindlessLayoutDesc& desc) : BindlessDesc(desc), B_IsBindless(true){
+        }
+
+        [[nodiscard]] const BindingLayoutDesc* getDesc() const override{ return B_IsBindless ? nullptr : &Desc; }
+
+        [[nodiscard]] const BindlessLayoutDesc* getBindlessDesc() const override{
+            return B_IsBindless ? &BindlessDesc : nullptr;
+        }
+
+        BindingLayoutDesc Desc;
+        BindlessLayoutDesc BindlessDesc;
+        bool B_IsBindless = false;
+    };
+
+    class HeadlessBindingSet final : public RefCounter<EFRAPIBindingSet>{
+    public:
+        HeadlessBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout);
+
+        [[nodiscard]] const BindingSetDesc* getDesc() const override{ return &Desc; }
+
+        [[nodiscard]] EFRAPIBindingLayout* getLayout() const override{ return Layout; }
+
+        BindingSetDesc Desc;
+        BindingLayoutHandle Layout;
+        std::vector<ResourceHandle> Resources;
+    };
+
+    class HeadlessDescriptorTable final : public RefCounter<IDescriptorTable>{
+    public:
+        explicit HeadlessDescriptorTable(EFRAPIBindingLayout* layout) : Layout(layout){
+        }
+
+        [[nodiscard]] const BindingSetDesc* getDesc() const override{ return nullptr; }
+
+        [[nodiscard]] EFRAPIBindingLayout* getLayout() const override{ return Layout; }
+
+        [[nodiscard]] uint32_t getCapacity() const override{ return static_cast<uint32_t>(Descriptors.size()); }
+
+        [[nodiscard]] uint32_t getFirstDescriptorIndexInHeap() const override{ return 0; }
+
+        BindingLayoutHandle Layout;
+        std::vector<BindingSetItem> Descriptors;
+        std::vector<ResourceHandle> Resources;
+    };
+
+    // Records commands as closures that run on CPU memory when the list is executed. Resource states are tracked
+    // while recording, starting from the state a resource was left in by the last executed list, and written back
+    // to the resources on execution.
+    class HeadlessCommandList final : public RefCounter<EFRAPICommandList>{
+    public:
+        HeadlessCommandList(EFHeadlessRAPI* device, const CommandListParameters& params);
+
+        void Open() override;
+
+        void Close() override;
+
+        void ClearState() override;
+
+        void ClearTextureFloat(EFRAPITexture* t, TextureSubresourceSet subresources, const Color& clearColor) override;
+
+        void ClearDepthStencilTexture(EFRAPITexture* t, TextureSubresourceSet subresources, bool clearDepth,
+                                      float depth, bool clearStencil, uint8_t stencil) override;
+
+        void ClearTextureUInt(EFRAPITexture* t, TextureSubresourceSet subresources, uint32_t clearColor) override;
+
+        void CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void CopyTexture(EFRAPIStagingTexture* dest, const TextureSlice& destSlice, EFRAPITexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void CopyTexture(EFRAPITexture* dest, const TextureSlice& destSlice, EFRAPIStagingTexture* src,
+                         const TextureSlice& srcSlice) override;
+
+        void WriteTexture(EFRAPITexture* dest, uint32_t arraySlice, uint32_t mipLevel, const void* data,
+                          size_t rowPitch, size_t depthPitch) override;
+
+        void ResolveTexture(EFRAPITexture* dest, const TextureSubresourceSet& dstSubresources, EFRAPITexture* src,
+                            const TextureSubresourceSet& srcSubresources) override;
+
+        void WriteBuffer(EFRAPIBuffer* b, const void* data, size_t dataSize, uint64_t destOffsetBytes) override;
+
+        void ClearBufferUInt(EFRAPIBuffer* b, uint32_t clearValue) override;
+
+        void CopyBuffer(EFRAPIBuffer* dest, uint64_t destOffsetBytes, EFRAPIBuffer* src, uint64_t srcOffsetBytes,
+                        uint64_t dataSizeBytes) override;
+
+        void ClearSamplerFeedbackTexture(EFRAPISamplerFeedbackTexture* texture) override;
+
+        void DecodeSamplerFeedbackTexture(EFRAPIBuffer* buffer, EFRAPISamplerFeedbackTexture* texture,
+                                          E_Format format) override;
+
+        void SetSamplerFeedbackTextureState(EFRAPISamplerFeedbackTexture* texture,
+                                            F_ResourceStates stateBits) override;
+
+        void SetPushConstants(const void* data, size_t byteSize) override;
+
+        void SetGraphicsState(const GraphicsState& state) override;
+
+        void Draw(const DrawArguments& args) override;
+
+        void DrawIndexed(const DrawArguments& args) override;
+
+        void DrawIndirect(uint32_t offsetBytes, uint32_t drawCount) override;
+
+        void DrawIndexedIndirect(uint32_t offsetBytes, uint32_t drawCount) override;
+
+        void SetComputeState(const ComputeState& state) override;
+
+        void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+        void DispatchIndirect(uint32_t offsetBytes) override;
+
+        void SetMeshletState(const MeshletState& state) override;
+
+        void DispatchMesh(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+        void BeginTimerQuery(EFRAPITimerQuery* query) override;
+
+        void EndTimerQuery(EFRAPITimerQuery* query) override;
+
+        void BeginMarker(const char* name) override;
+
+        void EndMarker() override;
+
+        void SetEnableAutomaticBarriers(bool enable) override;
+
+        void SetResourceStatesForBindingSet(EFRAPIBindingSet* bindingSet) override;
+
+        void SetEnableUavBarriersForTexture(EFRAPITexture* texture, bool enableBarriers) override;
+
+        void SetEnableUavBarriersForBuffer(EFRAPIBuffer* buffer, bool enableBarriers) override;
+
+        void BeginTrackingTextureState(EFRAPITexture* texture, TextureSubresourceSet subresources,
+                                       F_ResourceStates stateBits) override;
+
+        void BeginTrackingBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void SetTextureState(EFRAPITexture* texture, TextureSubresourceSet subresources,
+                             F_ResourceStates stateBits) override;
+
+        void SetBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void SetPermanentTextureState(EFRAPITexture* texture, F_ResourceStates stateBits) override;
+
+        void SetPermanentBufferState(EFRAPIBuffer* buffer, F_ResourceStates stateBits) override;
+
+        void PlaceAliasingBarrier(EFRAPIResource* resource) override;
+
+        void CommitBarriers() override;
+
+        F_ResourceStates GetTextureSubresourceState(EFRAPITexture* texture, ArraySlice arraySlice,
+                                                    MipLevel mipLevel) override;
+
+        F_ResourceStates GetBufferState(EFRAPIBuffer* buffer) override;
+
+        EFDynamicRAPI* GetDevice() override;
+
+        const CommandListParameters& GetDesc() override{ return _desc; }
+
+        // What an execution of the list did, added to the device stats
+        struct ExecutionStats{
+            uint64 BytesUploaded = 0;
+            uint64 BytesCopied = 0;
+            uint64 AliasingBarriers = 0;
+        };
+
+        // Runs the recorded commands, hands the tracked states to the resources and retires the upload memory, called
+        // by the device. The list has to be opened again before it is executed again.
+        ExecutionStats Execute();
+
+        // Barriers issued and elided while recording
+        [[nodiscard]] const StateTrackerStats& GetBarrierStats() const{ return _stateTracker.GetStats(); }
+
+    private:
+        void RequireTextureState(EFRAPITexture* texture, const TextureSubresourceSet& subresources,
+                                 F_ResourceStates state);
+
+        void RequireBufferState(EFRAPIBuffer* buffer, F_ResourceStates state);
+
+        void SetBindingStates(const BindingSetVector& bindings);
+
+        // Keeps the resource alive until the list is opened again
+        void Reference(EFRAPIResource* resource);
+
+        EFHeadlessRAPI* _device;
+        CommandListParameters _desc;
+        bool _bIsOpen = false;
+        bool _bEnableAutomaticBarriers = true;
+
+        std::vector<std::function<void(ExecutionStats&)>> _commands;
+        std::vector<ResourceHandle> _referencedResources;
+        // Written data is staged in the device upload ring, the commands copy it from there on execution
+        EFRAPIUploadWriter _uploads;
+
+        EFRAPIStateTracker _stateTracker;
+
+        GraphicsState _graphicsState;
+        ComputeState _computeState;
+        MeshletState _meshletState;
+        std::vector<uint8> _pushConstants;
+        std::vector<const char*> _markers;
+    };
+} // EventfulEngine
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "HeadlessResources.h"
+#include "EFRAPIRetireQueue.h"
+
+#include <mutex>
+
+namespace EventfulEngine{
+    /* Backend without a GPU for dedicated servers, CI perf runs and renderer tests. Resources live in CPU memory,
+     * copies, clears and uploads run on that memory when a command list is executed and draws or dispatches are only
+     * counted. Everything executes synchronously, so queries and waits complete right away. Deferred command lists
+     * are replayed into a headless list of the queue when they are executed.
+     */
+
+    struct HeadlessDeviceStats{
+        uint64 ExecutedCommandLists = 0;
+        uint64 DrawCalls = 0;
+        uint64 Dispatches = 0;
+        uint64 BytesUploaded = 0;
+        uint64 BytesCopied = 0;
+        // Barriers issued in committed batches, and requested transitions the state tracker found redundant
+        uint64 Barriers = 0;
+        uint64 BarriersElided = 0;
+        // Placed resources that took over heap memory from other placed resources
+        uint64 AliasingBarriers = 0;
+        // Graphics and compute pipelines created from their description, and from a pipeline binary
+        uint64 PipelinesCompiled = 0;
+        uint64 PipelinesFromBinary = 0;
+    };
+
+    class EFRENDERAPIHEADLESS_API EFHeadlessRAPI final : public RefCounter<EFDynamicRAPI>{
+    public:
+        EFHeadlessRAPI() = default;
+
+        ~EFHeadlessRAPI() override;
+
+        HeapHandle CreateHeap(const HeapDesc& d) override;
+
+        TextureHandle CreateTexture(const TextureDesc& d) override;
+
+        MemoryRequirements GetTextureMemoryRequirements(EFRAPITexture* texture) override;
+
+        bool BindTextureMemory(EFRAPITexture* texture, IHeap* heap, uint64_t offset) override;
+
+        TextureHandle
+        CreateHandleForNativeTexture(ObjectType objectType, EFRAPIObject texture, const TextureDesc& desc) override;
+
+        StagingTextureHandle CreateStagingTexture(const TextureDesc& d, E_CpuAccessMode cpuAccess) override;
+
+        void* MapStagingTexture(EFRAPIStagingTexture* tex, const TextureSlice& slice, E_CpuAccessMode cpuAccess,
+                                size_t* outRowPitch) override;
+
+        void UnmapStagingTexture(EFRAPIStagingTexture* tex) override;
+
+        void GetTextureTiling(EFRAPITexture* texture, uint32_t* numTiles, PackedMipDesc* desc, TileShape* tileShape,
+                              uint32_t* subresourceTilingsNum, SubresourceTiling* subresourceTilings) override;
+
+        void UpdateTextureTileMappings(EFRAPITexture* texture, const TextureTilesMapping* tileMappings,
+                                       uint32_t numTileMappings, E_CommandQueue executionQueue) override;
+
+        SamplerFeedbackTextureHandle CreateSamplerFeedbackTexture(EFRAPITexture* pairedTexture,
+                                                                  const SamplerFeedbackTextureDesc& desc) override;
+
+        SamplerFeedbackTextureHandle CreateSamplerFeedbackForNativeTexture(ObjectType objectType, EFRAPIObject texture,
+                                                                           EFRAPITexture* pairedTexture) override;
+
+        BufferHandle CreateBuffer(const BufferDesc& d) override;
+
+        void* MapBuffer(EFRAPIBuffer* buffer, E_CpuAccessMode cpuAccess) override;
+
+        void UnmapBuffer(EFRAPIBuffer* buffer) override;
+
+        MemoryRequirements GetBufferMemoryRequirements(EFRAPIBuffer* buffer) override;
+
+        bool BindBufferMemory(EFRAPIBuffer* buffer, IHeap* heap, uint64_t offset) override;
+
+        BufferHandle
+        CreateHandleForNativeBuffer(ObjectType objectType, EFRAPIObject buffer, const BufferDesc& desc) override;
+
+        ShaderHandle CreateShader(const ShaderDesc& d, const void* binary, size_t binarySize) override;
+
+        ShaderHandle CreateShaderSpecialization(EFRAPIShader* baseShader, const ShaderSpecialization* constants,
+                                                uint32_t numConstants) override;
+
+        ShaderLibraryHandle CreateShaderLibrary(const void* binary, size_t binarySize) override;
+
+        SamplerHandle CreateSampler(const SamplerDesc& d) override;
+
+        InputLayoutHandle CreateInputLayout(const VertexAttributeDesc* d, uint32_t attributeCount,
+                                            EFRAPIShader* vertexShader) override;
+
+        EventQueryHandle CreateEventQuery() override;
+
+        void SetEventQuery(EFRAPIEventQuery* query, E_CommandQueue queue) override;
+
+        bool PollEventQuery(EFRAPIEventQuery* query) override;
+
+        void WaitEventQuery(EFRAPIEventQuery* query) override;
+
+        void ResetEventQuery(EFRAPIEventQuery* query) override;
+
+        TimerQueryHandle CreateTimerQuery() override;
+
+        bool PollTimerQuery(EFRAPITimerQuery* query) override;
+
+        float GetTimerQueryTime(EFRAPITimerQuery* query) override;
+
+        void ResetTimerQuery(EFRAPITimerQuery* query) override;
+
+        E_RenderAPI GetGraphicsAPI() override;
+
+        FramebufferHandle CreateFramebuffer(const FramebufferDesc& desc) override;
+
+        GraphicsPipelineHandle CreateGraphicsPipeline(const GraphicsPipelineDesc& desc, EFRAPIFramebuffer* fb) override;
+
+        ComputePipelineHandle CreateComputePipeline(const ComputePipelineDesc& desc) override;
+
+        MeshletPipelineHandle CreateMeshletPipeline(const MeshletPipelineDesc& desc, EFRAPIFramebuffer* fb) override;
+
+        // The binary only carries the content hash of the description, a binary of another description is rejected
+        bool GetPipelineBinary(EFRAPIResource* pipeline, std::vector<uint8>& outBinary) override;
+
+        GraphicsPipelineHandle CreateGraphicsPipelineFromBinary(const GraphicsPipelineDesc& desc, EFRAPIFramebuffer* fb,
+                                                                const void* binary, size_t binarySize) override;
+
+        ComputePipelineHandle CreateComputePipelineFromBinary(const ComputePipelineDesc& desc, const void* binary,
+                                                              size_t binarySize) override;
+
+        BindingLayoutHandle CreateBindingLayout(const BindingLayoutDesc& desc) override;
+
+        BindingLayoutHandle CreateBindlessLayout(const BindlessLayoutDesc& desc) override;
+
+        BindingSetHandle CreateBindingSet(const BindingSetDesc& desc, EFRAPIBindingLayout* layout) override;
+
+        DescriptorTableHandle CreateDescriptorTable(EFRAPIBindingLayout* layout) override;
+
+        void ResizeDescriptorTable(IDescriptorTable* descriptorTable, uint32_t newSize, bool keepContents) override;
+
+        bool WriteDescriptorTable(IDescriptorTable* descriptorTable, const BindingSetItem& item) override;
+
+        CommandListHandle CreateCommandList(const CommandListParameters& params) override;
+
+        uint64 ExecuteCommandLists(EFRAPICommandList* const* pCommandLists, size_t numCommandLists,
+                                   E_CommandQueue executionQueue) override;
+
+        void QueueWaitForCommandList(E_CommandQueue waitQueue, E_CommandQueue executionQueue,
+                                     uint64_t instance) override;
+
+        bool WaitForIdle() override;
+
+        void RunGarbageCollection() override;
+
+        bool QueryFeatureSupport(E_Feature feature, void* pInfo, size_t infoSize) override;
+
+        F_FormatSupport QueryFormatSupport(E_Format format) override;
+
+        EFRAPIObject GetNativeQueue(ObjectType objectType, E_CommandQueue queue) override;
+
+        EFRAPIMessageCallback* GetMessageCallback() override;
+
+        bool IsAftermathEnabled() override;
+
+        // Totals since the device was created or the stats were reset
+        [[nodiscard]] HeadlessDeviceStats GetStats();
+
+        void ResetStats();
+
+        // Headless pipelines are ready at once. Compiling a description sleeps for this long, so tools can measure
+        // what pipeline compilation on a real backend costs a frame. Creating from a binary never sleeps.
+        void SetPipelineCompileTime(EFDuration compileTime);
+
+        // Lists finish executing before ExecuteCommandLists returns, so a set event query signals at once. Turning this
+        // off keeps set queries unsignaled until it is turned on again, the way a real GPU running frames behind does.
+        void SetEventQueriesSignaled(bool bIsSignaled);
+
+        // Objects released since the device was created or the stats were reset, RunGarbageCollection() destroys them
+        [[nodiscard]] RetireQueueStats GetRetireQueueStats();
+
+        // Ring buffer all command lists of the device upload through, EndFrame() is called by RunGarbageCollection()
+        [[nodiscard]] EFRAPIUploadManager* GetUploadManager();
+
+        // Instance returned by the last ExecuteCommandLists on the queue
+        [[nodiscard]] uint64 GetLastSubmittedInstance(E_CommandQueue queue);
+
+    private:
+        // Counts a compiled pipeline and sleeps for the configured compile time
+        void SimulatePipelineCompilation();
+
+        // Defers the destruction of a created object to RunGarbageCollection(). Objects may be released after the
+        // device, except for command lists that still hold upload memory of the device's ring.
+        template <typename T>
+        T* Track(T* object){
+            object->SetRetireQueue(_retireQueue);
+            return object;
+        }
+
+        [[nodiscard]] EFRAPIRetireQueue::QueueInstances GetLastSubmittedInstances();
+
+        // Declared first, the members below release tracked objects when they are destroyed
+        RefCountPtr<EFRAPIRetireQueue> _retireQueue = RefCountPtr<EFRAPIRetireQueue>::Create(new EFRAPIRetireQueue);
+        std::once_flag _uploadManagerCreated;
+        // Declared before the translation lists, they retire their uploads when they are destroyed
+        std::unique_ptr<EFRAPIUploadManager> _uploadManager;
+        std::mutex _queueMutex;
+        HeadlessDeviceStats _stats;
+        EFDuration _pipelineCompileTime{};
+        bool _bAreEventQueriesSignaled = true;
+        uint64 _lastSubmittedInstances[static_cast<size_t>(E_CommandQueue::Count)]{};
+        // Deferred lists are replayed into these on the submitting thread, one per queue
+        CommandListHandle _translationLists[static_cast<size_t>(E_CommandQueue::Count)];
+    };
+
+    // Creates a headless device without going through the module manager, for tests and tools
+    EFRENDERAPIHEADLESS_API DynamicRAPIHandle CreateHeadlessRAPI();
+
+    class RenderAPIHeadlessModule : public IDynamicRAPIModule{
+    public:
+        DynamicRAPIHandle CreateDynamicRAPI(E_Feature requestedFeatureLevel) override;
+    };
+} // EventfulEngine
@@ -0,0 +1,693 @@
+#pragma once
+
+#include "EFRenderGraph.h"
+#include "Thread.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace EventfulEngine{
+    namespace{
+        // Heaps grow in steps of this so that small changes of the graph do not create a heap every frame
+        constexpr uint64 HEAP_GRANULARITY = 64 * 1024;
+
+        constexpr uint64 AlignUp(const uint64 value, const uint64 alignment){
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Whether a resource created for one desc can be placed for the other, the debug name and states do not matter
+        bool IsSameTexture(const TextureDesc& a, const TextureDesc& b){
+            return a.Width == b.Width && a.Height == b.Height && a.Depth == b.Depth && a.ArraySize == b.ArraySize &&
+                a.MipLevels == b.MipLevels && a.SampleCount == b.SampleCount && a.SampleQuality == b.SampleQuality &&
+                a.Format == b.Format && a.Dimension == b.Dimension && a.B_IsShaderResource == b.B_IsShaderResource &&
+                a.B_IsRenderTarget == b.B_IsRenderTarget && a.B_IsUAV == b.B_IsUAV && a.B_IsTypeless == b.B_IsTypeless &&
+                a.B_IsShadingRateSurface == b.B_IsShadingRateSurface && a.B_UseClearValue == b.B_UseClearValue &&
+                (!a.B_UseClearValue || a.ClearValue == b.ClearValue);
+        }
+
+        bool IsSameBuffer(const BufferDesc& a, const BufferDesc& b){
+            return a.ByteSize == b.ByteSize && a.StructStride == b.StructStride && a.Format == b.Format &&
+                a.B_CanHaveUAVs == b.B_CanHaveUAVs && a.B_CanHaveTypedViews == b.B_CanHaveTypedViews &&
+                a.B_CanHaveRawViews == b.B_CanHaveRawViews && a.B_IsVertexBuffer == b.B_IsVertexBuffer &&
+                a.B_IsIndexBuffer == b.B_IsIndexBuffer && a.B_IsConstantBuffer == b.B_IsConstantBuffer &&
+                a.B_IsDrawIndirectArgs == b.B_IsDrawIndirectArgs &&
+                a.B_IsAccelStructBuildInput == b.B_IsAccelStructBuildInput &&
+                a.B_IsAccelStructStorage == b.B_IsAccelStructStorage &&
+                a.B_IsShaderBindingTable == b.B_IsShaderBindingTable;
+        }
+
+        // Consecutive UAV accesses need a barrier between them even though the state does not change
+        bool NeedsBarrier(const F_ResourceStates before, const F_ResourceStates after){
+            return before != after || !!(after & F_ResourceStates::UnorderedAccess);
+        }
+    }
+
+    RenderGraphTexture RenderGraphBuilder::CreateTexture(const TextureDesc& desc){
+        EFRenderGraph::Resource resource;
+        resource.Texture = desc;
+        resource.Texture.B_IsVirtual = true;
+        resource.Texture.B_KeepInitialState = false;
+        resource.InitialState = desc.InitialState != F_ResourceStates::Unknown
+                                    ? desc.InitialState
+                                    : F_ResourceStates::Common;
+        return {_graph.AddResource(std::move(resource))};
+    }
+
+    RenderGraphBuffer RenderGraphBuilder::CreateBuffer(const BufferDesc& desc){
+        EFRenderGraph::Resource resource;
+        resource.Buffer = desc;
+        resource.Buffer.B_IsVirtual = true;
+        resource.Buffer.B_KeepInitialState = false;
+        resource.B_IsTexture = false;
+        resource.InitialState = desc.InitialState != F_ResourceStates::Unknown
+                                    ? desc.InitialState
+                                    : F_ResourceStates::Common;
+        return {_graph.AddResource(std::move(resource))};
+    }
+
+    RenderGraphTexture RenderGraphBuilder::Read(const RenderGraphTexture texture, const F_ResourceStates state){
+        assert(texture.IsValid() && _graph._resources[texture.Index].B_IsTexture);
+        _graph.AddAccess(_pass, texture.Index, state, false);
+        return texture;
+    }
+
+    RenderGraphBuffer RenderGraphBuilder::Read(const RenderGraphBuffer buffer, const F_ResourceStates state){
+        assert(buffer.IsValid() && !_graph._resources[buffer.Index].B_IsTexture);
+        _graph.AddAccess(_pass, buffer.Index, state, false);
+        return buffer;
+    }
+
+    RenderGraphTexture RenderGraphBuilder::Write(const RenderGraphTexture texture, const F_ResourceStates state){
+        assert(texture.IsValid() && _graph._resources[texture.Index].B_IsTexture);
+        _graph.AddAccess(_pass, texture.Index, state, true);
+        return texture;
+    }
+
+    RenderGraphBuffer RenderGraphBuilder::Write(const RenderGraphBuffer buffer, const F_ResourceStates state){
+        assert(buffer.IsValid() && !_graph._resources[buffer.Index].B_IsTexture);
+        _graph.AddAccess(_pass, buffer.Index, state, true);
+        return buffer;
+    }
+
+    void RenderGraphBuilder::SetHasSideEffects(){
+        _graph._passes[_pass].B_HasSideEffects = true;
+    }
+
+    EFRAPITexture* RenderGraphResources::GetTexture(const RenderGraphTexture texture) const{
+        return _graph._resources[texture.Index].TextureResource;
+    }
+
+    EFRAPIBuffer* RenderGraphResources::GetBuffer(const RenderGraphBuffer buffer) const{
+        return _graph._resources[buffer.Index].BufferResource;
+    }
+
+    EFRenderGraph::EFRenderGraph(EFDynamicRAPI* device)
+        : _device(device), _recordingThreads(std::max(std::thread::hardware_concurrency(), 1u)){
+    }
+
+    EFRenderGraph::~EFRenderGraph(){
+        {
+            ScopeLock lock(_workMutex);
+            _bIsStopping = true;
+        }
+        _workReady.notify_all();
+        for (Thread& worker : _workers){
+            worker.Join();
+        }
+    }
+
+    RenderGraphTexture EFRenderGraph::ImportTexture(EFRAPITexture* texture, const F_ResourceStates state,
+                                                    const F_ResourceStates finalState){
+        assert(texture && !texture->GetDesc().B_KeepInitialState);
+        Resource resource;
+        resource.Texture = texture->GetDesc();
+        resource.TextureResource = texture;
+        resource.InitialState = state;
+        resource.FinalState = finalState;
+        resource.B_IsImported = true;
+        return {AddResource(std::move(resource))};
+    }
+
+    RenderGraphBuffer EFRenderGraph::ImportBuffer(EFRAPIBuffer* buffer, const F_ResourceStates state,
+                                                  const F_ResourceStates finalState){
+        assert(buffer && !buffer->GetDesc().B_KeepInitialState);
+        Resource resource;
+        resource.Buffer = buffer->GetDesc();
+        resource.BufferResource = buffer;
+        resource.InitialState = state;
+        resource.FinalState = finalState;
+        resource.B_IsTexture = false;
+        resource.B_IsImported = true;
+        return {AddResource(std::move(resource))};
+    }
+
+    uint32 EFRenderGraph::AddPass(const std::string_view name, const RenderGraphSetup& setup,
+                                  RenderGraphExecute execute){
+        assert(!_bIsCompiled);
+        const auto pass = static_cast<uint32>(_passes.size());
+        _passes.emplace_back();
+        _passes.back().Name = name;
+        _passes.back().Execute = std::move(execute);
+        RenderGraphBuilder builder(*this, pass);
+        setup(builder);
+        return pass;
+    }
+
+    void EFRenderGraph::Compile(){
+        if (_bIsCompiled){
+            return;
+        }
+        const EFTimePoint start = EFClock::now();
+        _stats = {};
+        _stats.Passes = static_cast<uint32>(_passes.size());
+
+        BuildDependencies();
+        CullPasses();
+        AssignLevels();
+        GatherRequirements();
+        BindTransientResources(true, PlaceResources(true));
+        BindTransientResources(false, PlaceResources(false));
+        AliasTransientResources(true);
+        AliasTransientResources(false);
+        DeriveTransitions();
+        BuildRecordings();
+
+        _bIsCompiled = true;
+        _stats.CompileTime = EFClock::now() - start;
+    }
+
+    uint64 EFRenderGraph::Execute(const E_CommandQueue queue){
+        Compile();
+        _commandLists.resize(std::max(_commandLists.size(), _recordings.size()));
+        for (uint32 index = 0; index < _recordings.size(); ++index){
+            if (!_commandLists[index] || _commandLists[index]->GetDesc().queueType != queue){
+                _commandLists[index] = _device->CreateCommandList(CommandListParameters().setQueueType(queue));
+            }
+        }
+
+        // The barriers are known up front, the lists of all levels record at the same time
+        const EFTimePoint start = EFClock::now();
+        const auto recordings = static_cast<uint32>(_recordings.size());
+        const uint32 workers = std::min(_recordingThreads, recordings);
+        if (workers > 1){
+            StartWorkers(workers - 1);
+            _nextRecording.store(0, std::memory_order_relaxed);
+            {
+                ScopeLock lock(_workMutex);
+                _activeWorkers = workers - 1;
+                _busyWorkers = workers - 1;
+                ++_workGeneration;
+            }
+            _workReady.notify_all();
+            RecordPending();
+
+            UniqueLock lock(_workMutex);
+            _workDone.wait(lock, [this]{ return _busyWorkers == 0; });
+        }
+        else{
+            for (uint32 index = 0; index < recordings; ++index){
+                Record(_recordings[index], _commandLists[index]);
+            }
+        }
+        _stats.RecordTime = EFClock::now() - start;
+
+        std::vector<EFRAPICommandList*> submitted(recordings);
+        for (uint32 index = 0; index < recordings; ++index){
+            submitted[index] = _commandLists[index];
+        }
+        return _device->ExecuteCommandLists(submitted.data(), submitted.size(), queue);
+    }
+
+    void EFRenderGraph::RecordPending(){
+        const auto recordings = static_cast<uint32>(_recordings.size());
+        for (uint32 index = _nextRecording++; index < recordings; index = _nextRecording++){
+            Record(_recordings[index], _commandLists[index]);
+        }
+    }
+
+    void EFRenderGraph::StartWorkers(const uint32 workers){
+        while (_workers.size() < workers){
+            const auto worker = static_cast<uint32>(_workers.size());
+            _workers.emplace_back([this, worker]{ RunWorker(worker); });
+        }
+    }
+
+    void EFRenderGraph::RunWorker(const uint32 worker){
+        uint64 generation = 0;
+        while (true){
+            {
+                UniqueLock lock(_workMutex);
+                _workReady.wait(lock, [this, generation]{ return _bIsStopping || _workGeneration != generation; });
+                if (_bIsStopping){
+                    return;
+                }
+                generation = _workGeneration;
+                // Fewer recordings than threads, the spare ones sleep through this Execute()
+                if (worker >= _activeWorkers){
+                    continue;
+                }
+            }
+
+            RecordPending();
+
+            ScopeLock lock(_workMutex);
+            if (--_busyWorkers == 0){
+                _workDone.notify_one();
+            }
+        }
+    }
+
+    void EFRenderGraph::Reset(){
+        _resources.clear();
+        _passes.clear();
+        _levels.clear();
+        _levelStates.clear();
+        _finalTransitions.clear();
+        _recordings.clear();
+        _bIsCompiled = false;
+    }
+
+    void EFRenderGraph::SetRecordingThreads(const uint32 threads){
+        _recordingThreads = std::max(threads, 1u);
+    }
+
+    bool EFRenderGraph::IsPassCulled(const uint32 pass) const{
+        return _passes[pass].B_IsCulled;
+    }
+
+    uint32 EFRenderGraph::GetPassLevel(const uint32 pass) const{
+        return _passes[pass].Level;
+    }
+
+    uint32 EFRenderGraph::AddResource(Resource resource){
+        assert(!_bIsCompiled);
+        _resources.push_back(std::move(resource));
+        return static_cast<uint32>(_resources.size() - 1);
+    }
+
+    void EFRenderGraph::AddAccess(const uint32 pass, const uint32 resource, const F_ResourceStates state,
+                                  const bool bIsWrite){
+        std::vector<Access>& accesses = _passes[pass].Accesses;
+        const auto existing = std::ranges::find(accesses, resource, &Access::Resource);
+        if (existing == accesses.end()){
+            accesses.push_back({resource, state, bIsWrite});
+        }
+        else if (bIsWrite){
+            existing->State = state;
+            existing->B_IsWrite = true;
+        }
+        else if (!existing->B_IsWrite){
+            existing->State = existing->State | state;
+        }
+    }
+
+    void EFRenderGraph::BuildDependencies(){
+        std::vector<uint32> lastWriters(_resources.size(), NO_PASS);
+        std::vector<std::vector<uint32>> readers(_resources.size());
+        for (uint32 pass = 0; pass < _passes.size(); ++pass){
+            Pass& current = _passes[pass];
+            for (const Access& access : current.Accesses){
+                const uint32 lastWriter = lastWriters[access.Resource];
+                // A write depends on the previous one as well, the pass may only overwrite part of the resource
+                if (lastWriter != NO_PASS){
+                    current.Producers.push_back(lastWriter);
+                }
+                if (!access.B_IsWrite){
+                    readers[access.Resource].push_back(pass);
+                    continue;
+                }
+                current.Predecessors.insert(current.Predecessors.end(), readers[access.Resource].begin(),
+                                            readers[access.Resource].end());
+                readers[access.Resource].clear();
+                lastWriters[access.Resource] = pass;
+            }
+        }
+    }
+
+    void EFRenderGraph::CullPasses(){
+        // Producers always come first, one backwards sweep reaches every pass a kept pass depends on
+        std::vector<bool> isNeeded(_passes.size(), false);
+        for (uint32 pass = static_cast<uint32>(_passes.size()); pass-- > 0;){
+            Pass& current = _passes[pass];
+            bool bIsNeeded = isNeeded[pass] || current.B_HasSideEffects;
+            for (const Access& access : current.Accesses){
+                bIsNeeded |= access.B_IsWrite && _resources[access.Resource].B_IsImported;
+            }
+            current.B_IsCulled = !bIsNeeded;
+            if (!bIsNeeded){
+                ++_stats.PassesCulled;
+                continue;
+            }
+            for (const uint32 producer : current.Producers){
+                isNeeded[producer] = true;
+            }
+        }
+    }
+
+    void EFRenderGraph::AssignLevels(){
+        for (uint32 pass = 0; pass < _passes.size(); ++pass){
+            Pass& current = _passes[pass];
+            if (current.B_IsCulled){
+                continue;
+            }
+            uint32 level = 0;
+            for (const uint32 producer : current.Producers){
+                level = std::max(level, _passes[producer].Level + 1);
+            }
+            for (const uint32 predecessor : current.Predecessors){
+                if (!_passes[predecessor].B_IsCulled){
+                    level = std::max(level, _passes[predecessor].Level + 1);
+                }
+            }
+            current.Level = level;
+            if (_levels.size() <= level){
+                _levels.resize(level + 1);
+            }
+            _levels[level].push_back(pass);
+
+            for (const Access& access : current.Accesses){
+                Resource& resource = _resources[access.Resource];
+                resource.FirstLevel = resource.FirstLevel == NO_LEVEL ? level : std::min(resource.FirstLevel, level);
+                resource.LastLevel = std::max(resource.LastLevel, level);
+            }
+        }
+        _stats.Levels = static_cast<uint32>(_levels.size());
+    }
+
+    void EFRenderGraph::GatherRequirements(){
+        uint32 transient = 0;
+        for (Resource& resource : _resources){
+            if (resource.B_IsImported){
+                continue;
+            }
+            const uint32 placed = transient++;
+            resource.Placed = placed;
+            if (resource.FirstLevel == NO_LEVEL){
+                continue;
+            }
+
+            if (resource.B_IsTexture){
+                ++_stats.TransientTextures;
+                if (placed < _placedResources.size() && _placedResources[placed].B_IsTexture &&
+                    IsSameTexture(_placedResources[placed].Texture, resource.Texture)){
+                    resource.Requirements = _placedResources[placed].Requirements;
+                }
+                else{
+                    // The virtual texture is bound once it is placed
+                    resource.TextureResource = _device->CreateTexture(resource.Texture);
+                    resource.Requirements = _device->GetTextureMemoryRequirements(resource.TextureResource);
+                }
+            }
+            else{
+                ++_stats.TransientBuffers;
+                if (placed < _placedResources.size() && !_placedResources[placed].B_IsTexture &&
+                    IsSameBuffer(_placedResources[placed].Buffer, resource.Buffer)){
+                    resource.Requirements = _placedResources[placed].Requirements;
+                }
+                else{
+                    resource.BufferResource = _device->CreateBuffer(resource.Buffer);
+                    resource.Requirements = _device->GetBufferMemoryRequirements(resource.BufferResource);
+                }
+            }
+            _stats.TransientBytes += resource.Requirements.size;
+        }
+        _placedResources.resize(std::max<size_t>(_placedResources.size(), transient));
+    }
+
+    uint64 EFRenderGraph::PlaceResources(const bool bIsTexture){
+        std::vector<uint32> order;
+        for (uint32 index = 0; index < _resources.size(); ++index){
+            const Resource& resource = _resources[index];
+            if (!resource.B_IsImported && resource.FirstLevel != NO_LEVEL && resource.B_IsTexture == bIsTexture){
+                order.push_back(index);
+            }
+        }
+        // Largest first leaves the smaller resources to fill the gaps
+        std::ranges::stable_sort(order, [this](const uint32 a, const uint32 b){
+            return _resources[a].Requirements.size > _resources[b].Requirements.size;
+        });
+
+        struct Range{
+            uint64 Begin;
+            uint64 End;
+        };
+        uint64 heapSize = 0;
+        std::vector<Range> occupied;
+        for (uint32 placed = 0; placed < order.size(); ++placed){
+            Resource& resource = _resources[order[placed]];
+            // Only resources alive in one of the same levels are in the way
+            occupied.clear();
+            for (uint32 other = 0; other < placed; ++other){
+                const Resource& otherResource = _resources[order[other]];
+                if (otherResource.FirstLevel <= resource.LastLevel && resource.FirstLevel <= otherResource.LastLevel){
+                    occupied.push_back({
+                        otherResource.HeapOffset, otherResource.HeapOffset + otherResource.Requirements.size
+                    });
+                }
+            }
+            std::ranges::sort(occupied, {}, &Range::Begin);
+
+            const uint64 alignment = std::max<uint64>(resource.Requirements.alignment, 1);
+            uint64 offset = 0;
+            for (const Range& range : occupied){
+                if (AlignUp(offset, alignment) + resource.Requirements.size <= range.Begin){
+                    break;
+                }
+                offset = std::max(offset, range.End);
+            }
+            resource.HeapOffset = AlignUp(offset, alignment);
+            heapSize = std::max(heapSize, resource.HeapOffset + resource.Requirements.size);
+        }
+        _stats.AliasedBytes += heapSize;
+        return heapSize;
+    }
+
+    void EFRenderGraph::BindTransientResources(const bool bIsTexture, const uint64 heapSize){
+        if (heapSize == 0){
+            return;
+        }
+        HeapHandle& heap = bIsTexture ? _textureHeap : _bufferHeap;
+        if (!heap || heap->getDesc().capacity < heapSize){
+            // The old heap is released with the last placed resource in it
+            heap = _device->CreateHeap(HeapDesc().setCapacity(AlignUp(heapSize, HEAP_GRANULARITY)).
+                                                  setType(HeapType::DeviceLocal).
+                                                  setDebugName(bIsTexture
+                                                                   ? "RenderGraphTextures"
+                                                                   : "RenderGraphBuffers"));
+        }
+
+        for (Resource& resource : _resources){
+            if (resource.B_IsImported || resource.FirstLevel == NO_LEVEL || resource.B_IsTexture != bIsTexture){
+                continue;
+            }
+            PlacedResource& placed = _placedResources[resource.Placed];
+
+            const bool bHasNewResource = bIsTexture ? resource.TextureResource != nullptr
+                                                    : resource.BufferResource != nullptr;
+            if (!bHasNewResource && placed.Heap == heap.Get() && placed.HeapOffset == resource.HeapOffset){
+                resource.TextureResource = placed.TextureResource;
+                resource.BufferResource = placed.BufferResource;
+                // The declared initial state only applies to a new resource, this one is where the last frame left it
+                resource.InitialState = placed.State;
+                continue;
+            }
+
+            // A placed resource cannot move, a different offset needs a new one
+            ++_stats.TransientResourcesCreated;
+            bool bIsBound;
+            if (bIsTexture){
+                if (!bHasNewResource){
+                    resource.TextureResource = _device->CreateTexture(resource.Texture);
+                }
+                bIsBound = _device->BindTextureMemory(resource.TextureResource, heap, resource.HeapOffset);
+            }
+            else{
+                if (!bHasNewResource){
+                    resource.BufferResource = _device->CreateBuffer(resource.Buffer);
+                }
+                bIsBound = _device->BindBufferMemory(resource.BufferResource, heap, resource.HeapOffset);
+            }
+            assert(bIsBound);
+            (void)bIsBound;
+
+            placed.Texture = resource.Texture;
+            placed.Buffer = resource.Buffer;
+            placed.TextureResource = resource.TextureResource;
+            placed.BufferResource = resource.BufferResource;
+            placed.Requirements = resource.Requirements;
+            placed.Heap = heap;
+            placed.HeapOffset = resource.HeapOffset;
+            placed.State = resource.InitialState;
+            placed.B_IsTexture = bIsTexture;
+            // Whatever used the memory before, the new resource has to take it over
+            placed.B_OwnsMemory = false;
+        }
+    }
+
+    void EFRenderGraph::AliasTransientResources(const bool bIsTexture){
+        const IHeap* heap = bIsTexture ? _textureHeap.Get() : _bufferHeap.Get();
+        std::vector<uint32> used;
+        std::vector<uint32> users(_placedResources.size(), ~0u);
+        for (uint32 index = 0; index < _resources.size(); ++index){
+            const Resource& resource = _resources[index];
+            if (!resource.B_IsImported && resource.FirstLevel != NO_LEVEL && resource.B_IsTexture == bIsTexture){
+                used.push_back(index);
+                users[resource.Placed] = index;
+            }
+        }
+        const auto overlaps = [](const uint64 offset, const uint64 size, const Resource& other){
+            return offset < other.HeapOffset + other.Requirements.size && other.HeapOffset < offset + size;
+        };
+
+        // Resources sharing memory do not share levels, the memory changes hands between them within the frame
+        for (const uint32 index : used){
+            Resource& resource = _resources[index];
+            resource.B_IsAliased = !_placedResources[resource.Placed].B_OwnsMemory;
+            for (const uint32 other : used){
+                const Resource& otherResource = _resources[other];
+                resource.B_IsAliased |= otherResource.LastLevel < resource.FirstLevel &&
+                    overlaps(resource.HeapOffset, resource.Requirements.size, otherResource);
+            }
+            _stats.AliasingBarriers += resource.B_IsAliased;
+        }
+
+        // The next frame finds the memory of a placed resource as its last user this frame left it
+        for (uint32 index = 0; index < _placedResources.size(); ++index){
+            PlacedResource& placed = _placedResources[index];
+            if (placed.Heap != heap || placed.B_IsTexture != bIsTexture){
+                continue;
+            }
+            const uint32 user = users[index];
+            bool bOwnsMemory = user != ~0u || placed.B_OwnsMemory;
+            for (const uint32 other : used){
+                const Resource& otherResource = _resources[other];
+                if (other != user && (user == ~0u || _resources[user].LastLevel < otherResource.FirstLevel) &&
+                    overlaps(placed.HeapOffset, placed.Requirements.size, otherResource)){
+                    bOwnsMemory = false;
+                }
+            }
+            placed.B_OwnsMemory = bOwnsMemory;
+        }
+    }
+
+    void EFRenderGraph::DeriveTransitions(){
+        std::vector<F_ResourceStates> states(_resources.size());
+        for (uint32 index = 0; index < _resources.size(); ++index){
+            states[index] = _resources[index].InitialState;
+        }
+
+        // Passes of one level either share reads of a resource or one of them writes it alone, the reads combine
+        std::vector<uint32> slots(_resources.size(), ~0u);
+        _levelStates.resize(_levels.size());
+        for (uint32 level = 0; level < _levels.size(); ++level){
+            std::vector<Transition>& levelStates = _levelStates[level];
+            for (const uint32 pass : _levels[level]){
+                for (const Access& access : _passes[pass].Accesses){
+                    uint32& slot = slots[access.Resource];
+                    if (slot == ~0u){
+                        slot = static_cast<uint32>(levelStates.size());
+                        levelStates.push_back({access.Resource, states[access.Resource], access.State});
+                    }
+                    else{
+                        assert(!access.B_IsWrite);
+                        levelStates[slot].StateAfter = levelStates[slot].StateAfter | access.State;
+                    }
+                }
+            }
+            for (const Transition& transition : levelStates){
+                slots[transition.Resource] = ~0u;
+                states[transition.Resource] = transition.StateAfter;
+                if (NeedsBarrier(transition.StateBefore, transition.StateAfter)){
+                    ++_stats.Barriers;
+                }
+            }
+        }
+
+        for (uint32 index = 0; index < _resources.size(); ++index){
+            const Resource& resource = _resources[index];
+            if (!resource.B_IsImported){
+                // The next frame starts transient resources in the state this one leaves them in
+                if (resource.FirstLevel != NO_LEVEL){
+                    _placedResources[resource.Placed].State = states[index];
+                }
+            }
+            else if (resource.FinalState != F_ResourceStates::Unknown && resource.FinalState != states[index]){
+                _finalTransitions.push_back({index, states[index], resource.FinalState});
+                ++_stats.Barriers;
+            }
+        }
+    }
+
+    void EFRenderGraph::BuildRecordings(){
+        for (uint32 level = 0; level < _levels.size(); ++level){
+            const std::vector<uint32>& passes = _levels[level];
+            const auto lists = static_cast<uint32>(std::min<size_t>(passes.size(), _recordingThreads));
+            for (uint32 list = 0; list < lists; ++list){
+                Recording recording;
+                recording.Level = level;
+                recording.B_IsFirstOfLevel = list == 0;
+                recording.Passes.assign(passes.begin() + passes.size() * list / lists,
+                                        passes.begin() + passes.size() * (list + 1) / lists);
+                _recordings.push_back(std::move(recording));
+            }
+        }
+        _stats.CommandLists = static_cast<uint32>(_recordings.size());
+    }
+
+    void EFRenderGraph::Record(const Recording& recording, EFRAPICommandList* commandList) const{
+        commandList->Open();
+
+        // The first list moves the level's resources into their states, the lists after it find them there
+        for (const Transition& transition : _levelStates[recording.Level]){
+            const Resource& resource = _resources[transition.Resource];
+            if (recording.B_IsFirstOfLevel){
+                if (resource.B_IsAliased && resource.FirstLevel == recording.Level){
+                    if (resource.B_IsTexture){
+                        commandList->PlaceAliasingBarrier(resource.TextureResource);
+                    }
+                    else{
+                        commandList->PlaceAliasingBarrier(resource.BufferResource);
+                    }
+                }
+                TransitionResource(commandList, resource, transition.StateBefore, transition.StateAfter);
+            }
+            else if (resource.B_IsTexture){
+                commandList->BeginTrackingTextureState(resource.TextureResource, AllSubresources,
+                                                       transition.StateAfter);
+            }
+            else{
+                commandList->BeginTrackingBufferState(resource.BufferResource, transition.StateAfter);
+            }
+        }
+        commandList->CommitBarriers();
+
+        const RenderGraphResources resources(*this);
+        for (const uint32 pass : recording.Passes){
+            const Pass& current = _passes[pass];
+            commandList->BeginMarker(current.Name.c_str());
+            current.Execute(commandList, resources);
+            commandList->EndMarker();
+        }
+
+        if (&recording == &_recordings.back()){
+            for (const Transition& transition : _finalTransitions){
+                TransitionResource(commandList, _resources[transition.Resource], transition.StateBefore,
+                                   transition.StateAfter);
+            }
+        }
+        commandList->Close();
+    }
+
+    void EFRenderGraph::TransitionResource(EFRAPICommandList* commandList, const Resource& resource,
+                                           const F_ResourceStates before, const F_ResourceStates after){
+        if (resource.B_IsTexture){
+            commandList->BeginTrackingTextureState(resource.TextureResource, AllSubresources, before);
+            commandList->SetTextureState(resource.TextureResource, AllSubresources, after);
+        }
+        else{
+            commandList->BeginTrackingBufferState(resource.BufferResource, before);
+            commandList->SetBufferState(resource.BufferResource, after);
+        }
+    }
+} // EventfulEngine
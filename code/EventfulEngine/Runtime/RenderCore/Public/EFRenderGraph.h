@@ -0,0 +1,315 @@
+#pragma once
+
+#include "EFRenderCoreModuleAPI.h"
+#include "EFDynamicRAPI.h"
+#include "Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace EventfulEngine{
+    // A texture declared in an EFRenderGraph, valid until the graph is reset
+    struct RenderGraphTexture{
+        static constexpr uint32 INVALID_INDEX = ~0u;
+
+        uint32 Index = INVALID_INDEX;
+
+        [[nodiscard]] bool IsValid() const{ return Index != INVALID_INDEX; }
+    };
+
+    // A buffer declared in an EFRenderGraph, valid until the graph is reset
+    struct RenderGraphBuffer{
+        static constexpr uint32 INVALID_INDEX = ~0u;
+
+        uint32 Index = INVALID_INDEX;
+
+        [[nodiscard]] bool IsValid() const{ return Index != INVALID_INDEX; }
+    };
+
+    class EFRenderGraph;
+
+    // Handed to the setup callback of a pass to declare the resources the pass creates, reads and writes. The
+    // declared state is the state the pass needs the resource in, declaring a resource twice in one pass combines
+    // the reads and lets a write replace them.
+    class RenderGraphBuilder{
+    public:
+        // Transient texture that lives from the first to the last pass using it, its memory is aliased with the
+        // transient resources of passes that do not overlap it
+        EFRENDERCORE_API RenderGraphTexture CreateTexture(const TextureDesc& desc);
+
+        EFRENDERCORE_API RenderGraphBuffer CreateBuffer(const BufferDesc& desc);
+
+        EFRENDERCORE_API RenderGraphTexture Read(RenderGraphTexture texture,
+                                                 F_ResourceStates state = F_ResourceStates::ShaderResource);
+
+        EFRENDERCORE_API RenderGraphBuffer Read(RenderGraphBuffer buffer,
+                                                F_ResourceStates state = F_ResourceStates::ShaderResource);
+
+        EFRENDERCORE_API RenderGraphTexture Write(RenderGraphTexture texture,
+                                                  F_ResourceStates state = F_ResourceStates::RenderTarget);
+
+        EFRENDERCORE_API RenderGraphBuffer Write(RenderGraphBuffer buffer,
+                                                 F_ResourceStates state = F_ResourceStates::UnorderedAccess);
+
+        // Keeps the pass even if nothing uses what it writes, for readbacks and queries
+        EFRENDERCORE_API void SetHasSideEffects();
+
+    private:
+        friend class EFRenderGraph;
+
+        RenderGraphBuilder(EFRenderGraph& graph, const uint32 pass) : _graph(graph), _pass(pass){}
+
+        EFRenderGraph& _graph;
+        uint32 _pass;
+    };
+
+    // Resolves the declared resources while a pass records
+    class RenderGraphResources{
+    public:
+        [[nodiscard]] EFRENDERCORE_API EFRAPITexture* GetTexture(RenderGraphTexture texture) const;
+
+        [[nodiscard]] EFRENDERCORE_API EFRAPIBuffer* GetBuffer(RenderGraphBuffer buffer) const;
+
+    private:
+        friend class EFRenderGraph;
+
+        explicit RenderGraphResources(const EFRenderGraph& graph) : _graph(graph){}
+
+        const EFRenderGraph& _graph;
+    };
+
+    using RenderGraphSetup = std::function<void(RenderGraphBuilder& builder)>;
+    // Records the pass, on any thread. The pass finds its resources in the declared states and leaves them in these.
+    using RenderGraphExecute = std::function<void(EFRAPICommandList* commandList,
+                                                  const RenderGraphResources& resources)>;
+
+    struct RenderGraphStats{
+        uint32 Passes = 0;
+        uint32 PassesCulled = 0;
+        // Passes of one level do not depend on each other
+        uint32 Levels = 0;
+        uint32 CommandLists = 0;
+        // Transitions derived from the declared states
+        uint32 Barriers = 0;
+        uint32 TransientTextures = 0;
+        uint32 TransientBuffers = 0;
+        // Transient resources that could not reuse the placed resource of the last frame
+        uint32 TransientResourcesCreated = 0;
+        // Transient resources that take over heap memory other placed resources used since they did
+        uint32 AliasingBarriers = 0;
+        // Memory the transient resources would need without aliasing, and what their heaps hold instead
+        uint64 TransientBytes = 0;
+        uint64 AliasedBytes = 0;
+        EFDuration CompileTime{};
+        EFDuration RecordTime{};
+    };
+
+    // Frame render graph on top of EFDynamicRAPI. Passes are added in submission order and declare what they read and
+    // write, Compile() derives the dependencies from that, culls the passes whose results nothing uses and groups the
+    // rest into levels of passes that do not depend on each other. The barriers between levels come from the declared
+    // states, so the passes of all levels record in parallel into separate command lists which are submitted in level
+    // order. Transient resources are placed in one texture and one buffer heap owned by the graph, resources whose
+    // level ranges do not overlap share memory. The placed resources are kept and reused while the graph keeps
+    // declaring the same ones at the same offsets, as are the command lists and the recording threads. A reused
+    // resource starts in the state the last frame left it in, and takes its memory back with an aliasing barrier if
+    // another resource used it in between.
+    // Declaring and compiling is not thread safe, call Reset() at the start of every frame. The graph keeps one set of
+    // command lists and transient heaps, use one graph per frame in flight or wait for the instance the last Execute()
+    // returned before executing again.
+    class EFRenderGraph{
+    public:
+        EFRENDERCORE_API explicit EFRenderGraph(EFDynamicRAPI* device);
+
+        // Stops the recording threads
+        EFRENDERCORE_API ~EFRenderGraph();
+
+        NOMOVEORCOPY(EFRenderGraph)
+
+        // A texture that outlives the frame, in the given state when the graph executes. Passes that write it are
+        // never culled, it is left in finalState if that is known and in the state of its last pass otherwise.
+        // The texture must not keep its initial state, the command lists would transition it back between passes.
+        EFRENDERCORE_API RenderGraphTexture ImportTexture(EFRAPITexture* texture, F_ResourceStates state,
+                                                          F_ResourceStates finalState = F_ResourceStates::Unknown);
+
+        EFRENDERCORE_API RenderGraphBuffer ImportBuffer(EFRAPIBuffer* buffer, F_ResourceStates state,
+                                                        F_ResourceStates finalState = F_ResourceStates::Unknown);
+
+        // Calls setup right away, execute once the graph executes unless the pass is culled. Returns the pass index.
+        EFRENDERCORE_API uint32 AddPass(std::string_view name, const RenderGraphSetup& setup,
+                                        RenderGraphExecute execute);
+
+        // Culls, levels and places the declared passes and resources, done by Execute() if not called before
+        EFRENDERCORE_API void Compile();
+
+        // Records the passes and submits their command lists, returns the instance ExecuteCommandLists returned. The
+        // submission of the previous Execute() has to be complete, its command lists and heap memory are reused.
+        EFRENDERCORE_API uint64 Execute(E_CommandQueue queue = E_CommandQueue::Graphics);
+
+        // Forgets the declared passes and resources, the transient heaps and placed resources are kept for reuse
+        EFRENDERCORE_API void Reset();
+
+        // Most threads recording at once, including the calling thread. Each level records into at most this many
+        // command lists, 1 records all of them on the calling thread. The graph starts the other threads on demand
+        // and keeps them until it is destroyed.
+        EFRENDERCORE_API void SetRecordingThreads(uint32 threads);
+
+        [[nodiscard]] EFRENDERCORE_API bool IsPassCulled(uint32 pass) const;
+
+        // Level of a pass after compiling, passes of one level are recorded in parallel
+        [[nodiscard]] EFRENDERCORE_API uint32 GetPassLevel(uint32 pass) const;
+
+        [[nodiscard]] const RenderGraphStats& GetStats() const{ return _stats; }
+
+    private:
+        friend class RenderGraphBuilder;
+        friend class RenderGraphResources;
+
+        static constexpr uint32 NO_PASS = ~0u;
+        static constexpr uint32 NO_LEVEL = ~0u;
+        static constexpr uint32 NO_PLACED = ~0u;
+
+        // Textures and buffers share one index space so that passes can track them uniformly
+        struct Resource{
+            TextureDesc Texture;
+            BufferDesc Buffer;
+            TextureHandle TextureResource;
+            BufferHandle BufferResource;
+            F_ResourceStates InitialState = F_ResourceStates::Common;
+            F_ResourceStates FinalState = F_ResourceStates::Unknown;
+            MemoryRequirements Requirements;
+            uint64 HeapOffset = 0;
+            // Index into _placedResources, transient resources only
+            uint32 Placed = NO_PLACED;
+            uint32 FirstLevel = NO_LEVEL;
+            uint32 LastLevel = 0;
+            bool B_IsTexture = true;
+            bool B_IsImported = false;
+            // Needs an aliasing barrier before its first level
+            bool B_IsAliased = false;
+        };
+
+        struct Access{
+            uint32 Resource = 0;
+            F_ResourceStates State = F_ResourceStates::Unknown;
+            bool B_IsWrite = false;
+        };
+
+        struct Pass{
+            std::string Name;
+            RenderGraphExecute Execute;
+            std::vector<Access> Accesses;
+            // Passes whose results this pass uses, they are kept if this pass is
+            std::vector<uint32> Producers;
+            // Passes that have to come before this one but whose results it does not use
+            std::vector<uint32> Predecessors;
+            uint32 Level = NO_LEVEL;
+            bool B_HasSideEffects = false;
+            bool B_IsCulled = false;
+        };
+
+        struct Transition{
+            uint32 Resource = 0;
+            F_ResourceStates StateBefore = F_ResourceStates::Unknown;
+            F_ResourceStates StateAfter = F_ResourceStates::Unknown;
+        };
+
+        // The passes one command list records, the first list of a level also records the barriers into the level
+        struct Recording{
+            uint32 Level = 0;
+            std::vector<uint32> Passes;
+            bool B_IsFirstOfLevel = false;
+        };
+
+        // Placed resource of an earlier frame, reused by the transient resource with the same index if that is
+        // identical and placed at the same offset
+        struct PlacedResource{
+            TextureDesc Texture;
+            BufferDesc Buffer;
+            TextureHandle TextureResource;
+            BufferHandle BufferResource;
+            MemoryRequirements Requirements;
+            IHeap* Heap = nullptr;
+            uint64 HeapOffset = 0;
+            // The state the last executed frame left the resource in
+            F_ResourceStates State = F_ResourceStates::Unknown;
+            bool B_IsTexture = true;
+            // No other placed resource used the memory since this one did
+            bool B_OwnsMemory = false;
+        };
+
+        uint32 AddResource(Resource resource);
+
+        void AddAccess(uint32 pass, uint32 resource, F_ResourceStates state, bool bIsWrite);
+
+        void BuildDependencies();
+
+        void CullPasses();
+
+        void AssignLevels();
+
+        // Requirements of the transient resources, from the placed resources of the last frame where possible
+        void GatherRequirements();
+
+        // Offsets of the transient resources of one heap, returns the heap size they need
+        uint64 PlaceResources(bool bIsTexture);
+
+        void BindTransientResources(bool bIsTexture, uint64 heapSize);
+
+        // Finds the transient resources of one heap that take over memory, and who owns it after the frame
+        void AliasTransientResources(bool bIsTexture);
+
+        void DeriveTransitions();
+
+        void BuildRecordings();
+
+        void Record(const Recording& recording, EFRAPICommandList* commandList) const;
+
+        // Records the recordings nobody took yet, on the calling thread and the workers
+        void RecordPending();
+
+        // Starts recording threads until there are this many
+        void StartWorkers(uint32 workers);
+
+        void RunWorker(uint32 worker);
+
+        // Begins tracking the resource in the state and requires the other one
+        static void TransitionResource(EFRAPICommandList* commandList, const Resource& resource,
+                                       F_ResourceStates before, F_ResourceStates after);
+
+        EFDynamicRAPI* _device;
+        uint32 _recordingThreads;
+
+        std::vector<Resource> _resources;
+        std::vector<Pass> _passes;
+        bool _bIsCompiled = false;
+
+        // Per level, in level order
+        std::vector<std::vector<uint32>> _levels;
+        // The resources every level uses, in the state before the level and the state the level needs them in
+        std::vector<std::vector<Transition>> _levelStates;
+        std::vector<Transition> _finalTransitions;
+        std::vector<Recording> _recordings;
+
+        HeapHandle _textureHeap;
+        HeapHandle _bufferHeap;
+        std::vector<PlacedResource> _placedResources;
+        std::vector<CommandListHandle> _commandLists;
+
+        // Recording threads, each generation is one Execute() that the first _activeWorkers of them help with
+        std::vector<Thread> _workers;
+        Mutex _workMutex;
+        std::condition_variable _workReady;
+        std::condition_variable _workDone;
+        uint64 _workGeneration = 0;
+        uint32 _activeWorkers = 0;
+        uint32 _busyWorkers = 0;
+        bool _bIsStopping = false;
+        std::atomic<uint32> _nextRecording{0};
+
+        RenderGraphStats _stats;
+    };
+} // EventfulEngine
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    constexpr uint32 BLOOM_MIP_LEVELS = 6;
+
+    struct Scene{
+        std::vector<TextureHandle> GBuffer;
+        TextureHandle Depth;
+        TextureHandle Lighting;
+        TextureHandle Bloom;
+        BufferHandle Histogram;
+        FramebufferHandle GBufferFramebuffer;
+        GraphicsPipelineHandle GBufferPipeline;
+        ComputePipelineHandle ComputePipeline;
+        std::vector<BindingSetHandle> Materials;
+        BindingSetHandle LightingBindings;
+        BindingSetHandle HistogramBindings;
+    };
+
+    BindingSetHandle CreateBindingSet(EFDynamicRAPI* device, const F_ShaderType visibility,
+                                      const BindingSetDesc& desc){
+        const BindingLayoutHandle layout = device->CreateBindingLayout(CreateBindingLayoutDesc(visibility, 0, desc));
+        return device->CreateBindingSet(desc, layout);
+    }
+
+    Scene CreateScene(EFDynamicRAPI* device, const int32 materials){
+        Scene scene;
+        const TextureDesc targetDesc = TextureDesc().SetWidth(256).SetHeight(256).SetFormat(E_Format::RGBA8_UNORM).
+                                                     SetIsRenderTarget(true).
+                                                     SetInitialState(F_ResourceStates::RenderTarget).
+                                                     SetKeepInitialState(true);
+        FramebufferDesc framebufferDesc;
+        for (int32 target = 0; target < 3; ++target){
+            scene.GBuffer.push_back(device->CreateTexture(targetDesc));
+            framebufferDesc.AddColorAttachment(scene.GBuffer.back());
+        }
+        scene.Depth = device->CreateTexture(TextureDesc().SetWidth(256).SetHeight(256).SetFormat(E_Format::D32).
+                                                          SetIsRenderTarget(true));
+        framebufferDesc.SetDepthAttachment(scene.Depth);
+        scene.GBufferFramebuffer = device->CreateFramebuffer(framebufferDesc);
+        scene.GBufferPipeline = device->CreateGraphicsPipeline(GraphicsPipelineDesc(), scene.GBufferFramebuffer);
+        const ShaderHandle computeShader = device->CreateShader(ShaderDesc().SetShaderType(F_ShaderType::Compute),
+                                                                nullptr, 0);
+        scene.ComputePipeline = device->CreateComputePipeline(ComputePipelineDesc().SetComputeShader(computeShader));
+
+        scene.Lighting = device->CreateTexture(TextureDesc().SetWidth(256).SetHeight(256).
+                                                             SetFormat(E_Format::RGBA16_FLOAT).SetIsUAV(true));
+        scene.Bloom = device->CreateTexture(TextureDesc().SetWidth(128).SetHeight(128).
+                                                          SetMipLevels(BLOOM_MIP_LEVELS).
+                                                          SetFormat(E_Format::RGBA16_FLOAT).SetIsUAV(true));
+        scene.Histogram = device->CreateBuffer(BufferDesc().SetByteSize(1024).SetCanHaveUAVs(true).
+                                                            SetStructStride(4));
+
+        for (int32 index = 0; index < materials; ++index){
+            const TextureHandle albedo = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4).
+                                                                             SetFormat(E_Format::RGBA8_UNORM));
+            const BindingSetDesc materialDesc = BindingSetDesc().addItem(BindingSetItem::Texture_SRV(0, albedo));
+            scene.Materials.push_back(CreateBindingSet(device, F_ShaderType::Pixel, materialDesc));
+        }
+
+        BindingSetDesc lightingDesc;
+        for (uint32 slot = 0; slot < scene.GBuffer.size(); ++slot){
+            lightingDesc.addItem(BindingSetItem::Texture_SRV(slot, scene.GBuffer[slot]));
+        }
+        lightingDesc.addItem(BindingSetItem::Texture_SRV(3, scene.Depth));
+        lightingDesc.addItem(BindingSetItem::Texture_UAV(0, scene.Lighting));
+        scene.LightingBindings = CreateBindingSet(device, F_ShaderType::Compute, lightingDesc);
+        scene.HistogramBindings = CreateBindingSet(device, F_ShaderType::Compute,
+                                                   BindingSetDesc().
+                                                   addItem(BindingSetItem::Texture_SRV(0, scene.Lighting)).
+                                                   addItem(BindingSetItem::StructuredBuffer_UAV(0, scene.Histogram)));
+        return scene;
+    }
+
+    // A deferred frame: G-buffer draws that share materials, tiled lighting in several dispatches, a bloom chain
+    // that reads each mip to write the next one, and a histogram accumulated over the lighting result
+    void RecordFrame(EFRAPICommandList* commandList, const Scene& scene, const int32 draws){
+        GraphicsState graphicsState;
+        graphicsState.SetFramebuffer(scene.GBufferFramebuffer).
+                      SetViewport(ViewportState().AddViewportAndScissorRect(Viewport(256, 256)));
+        graphicsState.Pipeline = scene.GBufferPipeline;
+        graphicsState.Bindings.resize(1);
+        for (int32 draw = 0; draw < draws; ++draw){
+            graphicsState.Bindings[0] = scene.Materials[draw % scene.Materials.size()];
+            commandList->SetGraphicsState(graphicsState);
+            commandList->Draw(DrawArguments().setVertexCount(3));
+        }
+
+        ComputeState computeState;
+        computeState.pipeline = scene.ComputePipeline;
+        computeState.bindings.resize(1);
+        computeState.bindings[0] = scene.LightingBindings;
+        for (int32 tile = 0; tile < 8; ++tile){
+            commandList->SetComputeState(computeState);
+            commandList->Dispatch(8, 8, 1);
+        }
+
+        // Each mip is written from the one above, the texture is split into per mip states and merged again
+        commandList->SetTextureState(scene.Bloom, AllSubresources, F_ResourceStates::UnorderedAccess);
+        for (MipLevel mipLevel = 1; mipLevel < BLOOM_MIP_LEVELS; ++mipLevel){
+            commandList->SetTextureState(scene.Bloom, TextureSubresourceSet(mipLevel - 1, 1, 0, 1),
+                                         F_ResourceStates::ShaderResource);
+            commandList->SetTextureState(scene.Bloom, TextureSubresourceSet(mipLevel, 1, 0, 1),
+                                         F_ResourceStates::UnorderedAccess);
+            commandList->CommitBarriers();
+            commandList->Dispatch(4, 4, 1);
+        }
+        commandList->SetTextureState(scene.Bloom, AllSubresources, F_ResourceStates::ShaderResource);
+
+        computeState.bindings[0] = scene.HistogramBindings;
+        for (int32 pass = 0; pass < 4; ++pass){
+            commandList->SetComputeState(computeState);
+            commandList->Dispatch(16, 16, 1);
+        }
+    }
+}
+
+// Records deferred frames on the headless backend with automatic barriers and reports the barriers the state
+// tracker issued and elided per frame, and the recording cost per state request. Fails if tracking a requested
+// state, issued or elided, takes longer on average than the budget.
+// Usage: barrier_benchmark [--budget-ns=<ns>] [--draws=<n>] [--materials=<n>] [--frames=<n>]
+int main(const int argc, char** argv){
+    double budgetNs = -1.0;
+    int32 draws = 10'000;
+    int32 materials = 200;
+    int32 frames = 60;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetNs);
+        }
+        else if (argument.starts_with("--draws=")){
+            const std::string_view value = argument.substr(std::string_view{"--draws="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), draws);
+        }
+        else if (argument.starts_with("--materials=")){
+            const std::string_view value = argument.substr(std::string_view{"--materials="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), materials);
+        }
+        else if (argument.starts_with("--frames=")){
+            const std::string_view value = argument.substr(std::string_view{"--frames="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), frames);
+        }
+    }
+    materials = std::max(materials, 1);
+    frames = std::max(frames, 1);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    const Scene scene = CreateScene(device, materials);
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+
+    EFDuration recordTime{};
+    uint64 lastIssued = 0;
+    uint64 lastElided = 0;
+    for (int32 frame = 0; frame < frames; ++frame){
+        const EFTimePoint start = EFClock::now();
+        commandList->Open();
+        RecordFrame(commandList, scene, draws);
+        commandList->Close();
+        recordTime += EFClock::now() - start;
+
+        EFRAPICommandList* submitted = commandList;
+        const HeadlessDeviceStats before = headless->GetStats();
+        device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+        device->RunGarbageCollection();
+        lastIssued = headless->GetStats().Barriers - before.Barriers;
+        lastElided = headless->GetStats().BarriersElided - before.BarriersElided;
+    }
+
+    const HeadlessDeviceStats stats = headless->GetStats();
+    const uint64 requests = stats.Barriers + stats.BarriersElided;
+    const double requestNs = requests > 0
+                                 ? std::chrono::duration<double, std::nano>(recordTime).count() /
+                                 static_cast<double>(requests)
+                                 : 0.0;
+    std::cout << "Barriers of " << frames << " deferred frames with " << draws << " draws and " << materials
+        << " materials\n";
+    std::cout << "  per frame: " << lastIssued << " barriers issued, " << lastElided << " elided\n";
+    std::cout << "  " << requestNs << " ns recording per state request, "
+        << std::chrono::duration<double, std::milli>(recordTime).count() / frames << " ms per frame\n";
+
+    if (budgetNs >= 0.0 && requestNs > budgetNs){
+        std::cerr << "Tracking a state request takes " << requestNs << " ns, budget is " << budgetNs << " ns\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "EFRAPIBindingCache.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    struct Material{
+        TextureHandle Albedo;
+        BufferHandle Constants;
+    };
+
+    struct Scene{
+        FramebufferHandle Framebuffer;
+        GraphicsPipelineHandle Pipeline;
+        SamplerHandle Sampler;
+        std::vector<Material> Materials;
+    };
+
+    Material CreateMaterial(EFDynamicRAPI* device){
+        Material material;
+        material.Albedo = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4).SetFormat(E_Format::RGBA8_UNORM));
+        material.Constants = device->CreateBuffer(BufferDesc().SetByteSize(256).SetIsConstantBuffer(true));
+        return material;
+    }
+
+    BindingSetDesc MaterialBindings(const Scene& scene, const Material& material){
+        return BindingSetDesc().addItem(BindingSetItem::Texture_SRV(0, material.Albedo)).
+                                addItem(BindingSetItem::ConstantBuffer(0, material.Constants)).
+                                addItem(BindingSetItem::Sampler(0, scene.Sampler));
+    }
+
+    struct FrameResult{
+        uint64 SetCreations = 0;
+        double Milliseconds = 0.0;
+    };
+
+    // Draws every object with the bindings of its material, building the binding set desc per draw the way a
+    // renderer without retained material state does. Without a cache every draw creates its set.
+    FrameResult RenderFrame(EFDynamicRAPI* device, EFRAPICommandList* commandList, const Scene& scene,
+                            EFRAPIBindingCache* cache, const int32 draws){
+        const uint64 creationsBefore = cache ? cache->GetStats().SetCreations : 0;
+        const EFTimePoint start = EFClock::now();
+
+        GraphicsState state;
+        state.SetFramebuffer(scene.Framebuffer).SetViewport(ViewportState().AddViewportAndScissorRect(Viewport(64, 64)));
+        state.Pipeline = scene.Pipeline;
+        state.Bindings.resize(1);
+
+        BindingLayoutHandle layout;
+        uint64 uncachedCreations = 0;
+        commandList->Open();
+        for (int32 draw = 0; draw < draws; ++draw){
+            const BindingSetDesc bindings = MaterialBindings(scene, scene.Materials[draw % scene.Materials.size()]);
+            BindingSetHandle set;
+            if (cache){
+                cache->GetBindingSetAndLayout(F_ShaderType::Pixel, 0, bindings, layout, set);
+            }
+            else{
+                if (!layout){
+                    layout = device->CreateBindingLayout(CreateBindingLayoutDesc(F_ShaderType::Pixel, 0, bindings));
+                }
+                set = device->CreateBindingSet(bindings, layout);
+                ++uncachedCreations;
+            }
+            state.Bindings[0] = set;
+            commandList->SetGraphicsState(state);
+            commandList->Draw(DrawArguments().setVertexCount(3));
+        }
+        commandList->Close();
+        EFRAPICommandList* submitted = commandList;
+        device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+        if (cache){
+            cache->EndFrame();
+        }
+        device->RunGarbageCollection();
+
+        FrameResult result;
+        result.Milliseconds = std::chrono::duration<double, std::milli>(EFClock::now() - start).count();
+        result.SetCreations = cache ? cache->GetStats().SetCreations - creationsBefore : uncachedCreations;
+        return result;
+    }
+}
+
+// Renders a scene of many draws sharing few materials on the headless backend and counts binding set creations per
+// frame, with a new binding set per draw and with EFRAPIBindingCache. A few materials are replaced every frame, the
+// cache retires their old sets through its frame fences. Fails if the cache creates more sets per frame on average
+// after the first frame than given.
+// Usage: binding_cache_benchmark [--max-creations-per-frame=<n>] [--draws=<n>] [--materials=<n>] [--frames=<n>]
+//        [--material-churn=<n>]
+int main(const int argc, char** argv){
+    double maxCreationsPerFrame = -1.0;
+    int32 draws = 10'000;
+    int32 materials = 500;
+    int32 frames = 60;
+    int32 materialChurn = 4;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--max-creations-per-frame=")){
+            const std::string_view value = argument.substr(std::string_view{"--max-creations-per-frame="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), maxCreationsPerFrame);
+        }
+        else if (argument.starts_with("--draws=")){
+            const std::string_view value = argument.substr(std::string_view{"--draws="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), draws);
+        }
+        else if (argument.starts_with("--materials=")){
+            const std::string_view value = argument.substr(std::string_view{"--materials="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), materials);
+        }
+        else if (argument.starts_with("--frames=")){
+            const std::string_view value = argument.substr(std::string_view{"--frames="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), frames);
+        }
+        else if (argument.starts_with("--material-churn=")){
+            const std::string_view value = argument.substr(std::string_view{"--material-churn="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), materialChurn);
+        }
+    }
+    materials = std::max(materials, 1);
+    frames = std::max(frames, 2);
+    materialChurn = std::clamp(materialChurn, 0, materials);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    Scene scene;
+    const TextureHandle target = device->CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).
+                                                                     SetFormat(E_Format::RGBA8_UNORM).
+                                                                     SetIsRenderTarget(true));
+    scene.Framebuffer = device->CreateFramebuffer(FramebufferDesc().AddColorAttachment(target));
+    scene.Pipeline = device->CreateGraphicsPipeline(GraphicsPipelineDesc(), scene.Framebuffer);
+    scene.Sampler = device->CreateSampler(SamplerDesc());
+    for (int32 index = 0; index < materials; ++index){
+        scene.Materials.push_back(CreateMaterial(device));
+    }
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+
+    // Materials are replaced round robin, the same sequence for both runs
+    auto runFrames = [&](EFRAPIBindingCache* cache){
+        std::vector<Material> sceneMaterials = scene.Materials;
+        std::vector<FrameResult> results;
+        int32 nextReplaced = 0;
+        for (int32 frame = 0; frame < frames; ++frame){
+            results.push_back(RenderFrame(device, commandList, scene, cache, draws));
+            for (int32 replaced = 0; replaced < materialChurn; ++replaced){
+                scene.Materials[nextReplaced] = CreateMaterial(device);
+                nextReplaced = (nextReplaced + 1) % materials;
+            }
+        }
+        scene.Materials = std::move(sceneMaterials);
+        return results;
+    };
+
+    auto steadyAverage = [](const std::vector<FrameResult>& results, auto member){
+        double total = 0.0;
+        for (size_t frame = 1; frame < results.size(); ++frame){
+            total += static_cast<double>(results[frame].*member);
+        }
+        return total / static_cast<double>(results.size() - 1);
+    };
+
+    const std::vector<FrameResult> uncached = runFrames(nullptr);
+
+    EFRAPIBindingCache cache(device);
+    const std::vector<FrameResult> cached = runFrames(&cache);
+    const BindingCacheStats stats = cache.GetStats();
+
+    const double cachedCreations = steadyAverage(cached, &FrameResult::SetCreations);
+    std::cout << "Binding sets with " << draws << " draws, " << materials << " materials, " << materialChurn
+        << " replaced per frame, " << frames << " frames\n";
+    std::cout << "  new set per draw: " << uncached.front().SetCreations << " creations in the first frame, "
+        << steadyAverage(uncached, &FrameResult::SetCreations) << " per frame after, "
+        << steadyAverage(uncached, &FrameResult::Milliseconds) << " ms per frame\n";
+    std::cout << "  binding cache: " << cached.front().SetCreations << " creations in the first frame, "
+        << cachedCreations << " per frame after, " << steadyAverage(cached, &FrameResult::Milliseconds)
+        << " ms per frame\n";
+    std::cout << "  binding cache: " << stats.SetHits << " hits, " << stats.LayoutCreations << " layouts, "
+        << stats.SetsRetired << " sets retired, " << cache.GetBindingSetCount() << " sets pooled\n";
+
+    if (maxCreationsPerFrame >= 0.0 && cachedCreations > maxCreationsPerFrame){
+        std::cerr << "Binding cache creates " << cachedCreations << " sets per frame, expected at most "
+            << maxCreationsPerFrame << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "EFRAPIDeferredCommandList.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    // Commands recorded per object: state, push constants and the draw
+    constexpr int32 COMMANDS_PER_OBJECT = 3;
+
+    struct Scene{
+        FramebufferHandle Framebuffer;
+        std::vector<GraphicsPipelineHandle> Pipelines;
+        std::vector<BindingSetHandle> BindingSets;
+    };
+
+    Scene CreateScene(EFDynamicRAPI* device){
+        Scene scene;
+        const TextureHandle target = device->CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).
+                                                                         SetFormat(E_Format::RGBA8_UNORM).
+                                                                         SetIsRenderTarget(true));
+        scene.Framebuffer = device->CreateFramebuffer(FramebufferDesc().AddColorAttachment(target));
+        for (int32 index = 0; index < 4; ++index){
+            scene.Pipelines.push_back(device->CreateGraphicsPipeline(GraphicsPipelineDesc(), scene.Framebuffer));
+        }
+        const BindingLayoutHandle layout = device->CreateBindingLayout(BindingLayoutDesc());
+        for (int32 index = 0; index < 16; ++index){
+            scene.BindingSets.push_back(device->CreateBindingSet(BindingSetDesc(), layout));
+        }
+        return scene;
+    }
+
+    // Records objects the way a scene traversal does, the material changes every 8 and the pipeline every 64 draws
+    void RecordObjects(EFRAPICommandList* commandList, const Scene& scene, const int32 objects){
+        GraphicsState state;
+        state.SetFramebuffer(scene.Framebuffer).SetViewport(ViewportState().AddViewportAndScissorRect(Viewport(64, 64)));
+        state.Bindings.resize(1);
+
+        commandList->Open();
+        for (int32 object = 0; object < objects; ++object){
+            state.Pipeline = scene.Pipelines[(object / 64) % scene.Pipelines.size()];
+            state.Bindings[0] = scene.BindingSets[(object / 8) % scene.BindingSets.size()];
+            commandList->SetGraphicsState(state);
+
+            const uint32 pushConstants[4] = {static_cast<uint32>(object), 1, 2, 3};
+            commandList->SetPushConstants(pushConstants, sizeof(pushConstants));
+            commandList->DrawIndexed(DrawArguments().setVertexCount(36).setStartIndexLocation(object));
+        }
+        commandList->Close();
+    }
+
+    double Seconds(const EFTimePoint start){
+        return std::chrono::duration<double>(EFClock::now() - start).count();
+    }
+}
+
+// Measures commands recorded per second per thread into deferred command lists on several threads, against one
+// immediate list, and how fast the submitting thread translates the deferred lists. Runs on the headless backend.
+// Fails if a recording thread falls below the given rate.
+// Usage: command_list_benchmark [--min-commands-per-second=<n>] [--objects=<n>] [--threads=<n>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    double minCommandsPerSecond = 0.0;
+    int32 objects = 20'000;
+    int32 threads = static_cast<int32>(std::clamp(std::thread::hardware_concurrency(), 1u, 8u));
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--min-commands-per-second=")){
+            const std::string_view value = argument.substr(std::string_view{"--min-commands-per-second="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), minCommandsPerSecond);
+        }
+        else if (argument.starts_with("--objects=")){
+            const std::string_view value = argument.substr(std::string_view{"--objects="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), objects);
+        }
+        else if (argument.starts_with("--threads=")){
+            const std::string_view value = argument.substr(std::string_view{"--threads="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), threads);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+    threads = std::max(threads, 1);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const Scene scene = CreateScene(device);
+    const double commandsPerList = static_cast<double>(objects) * COMMANDS_PER_OBJECT;
+
+    const CommandListHandle immediateList = device->CreateCommandList(CommandListParameters());
+    double immediateSeconds = std::numeric_limits<double>::max();
+    for (int32 round = 0; round < rounds; ++round){
+        const EFTimePoint start = EFClock::now();
+        RecordObjects(immediateList, scene, objects);
+        immediateSeconds = std::min(immediateSeconds, Seconds(start));
+    }
+
+    std::vector<CommandListHandle> deferredLists;
+    std::vector<EFRAPICommandList*> submittedLists;
+    for (int32 thread = 0; thread < threads; ++thread){
+        deferredLists.push_back(device->CreateCommandList(CommandListParameters().setEnableImmediateExecution(false)));
+        submittedLists.push_back(deferredLists.back());
+    }
+
+    // Slowest thread of the best round, the rate every thread reaches at least
+    double deferredSeconds = std::numeric_limits<double>::max();
+    double translateSeconds = std::numeric_limits<double>::max();
+    for (int32 round = 0; round < rounds; ++round){
+        std::vector<double> threadSeconds(threads);
+        std::vector<std::thread> workers;
+        for (int32 thread = 0; thread < threads; ++thread){
+            workers.emplace_back([&, thread]{
+                const EFTimePoint start = EFClock::now();
+                RecordObjects(deferredLists[thread], scene, objects);
+                threadSeconds[thread] = Seconds(start);
+            });
+        }
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+        deferredSeconds = std::min(deferredSeconds, *std::ranges::max_element(threadSeconds));
+
+        const EFTimePoint start = EFClock::now();
+        device->ExecuteCommandLists(submittedLists.data(), submittedLists.size(), E_CommandQueue::Graphics);
+        translateSeconds = std::min(translateSeconds, Seconds(start));
+        device->RunGarbageCollection();
+    }
+
+    const auto* deferredList = EFRAPIDeferredCommandList::FromCommandList(deferredLists.front());
+    const HeadlessDeviceStats stats = static_cast<EFHeadlessRAPI*>(device.Get())->GetStats();
+    if (stats.DrawCalls != static_cast<uint64>(objects) * threads * rounds){
+        std::cerr << "Executed " << stats.DrawCalls << " draws, expected " << static_cast<uint64>(objects) * threads *
+            rounds << "\n";
+        return 1;
+    }
+
+    const double immediateRate = commandsPerList / immediateSeconds;
+    const double deferredRate = commandsPerList / deferredSeconds;
+    const double translateRate = commandsPerList * threads / translateSeconds;
+    std::cout << "Command lists with " << objects << " objects, " << COMMANDS_PER_OBJECT << " commands each\n";
+    std::cout << "  immediate, 1 thread: " << immediateRate << " commands/s\n";
+    std::cout << "  deferred, " << threads << " threads: " << deferredRate << " commands/s per thread, "
+        << deferredRate * threads << " commands/s total\n";
+    std::cout << "  deferred stream: " << deferredList->GetStream().GetSize() << " bytes, "
+        << static_cast<double>(deferredList->GetStream().GetSize()) / commandsPerList << " bytes per command\n";
+    std::cout << "  translation on submit: " << translateRate << " commands/s\n";
+
+    if (minCommandsPerSecond > 0.0 && deferredRate < minCommandsPerSecond){
+        std::cerr << "Deferred recording reaches " << deferredRate << " commands/s per thread, expected "
+            << minCommandsPerSecond << "\n";
+        return 1;
+    }
+    return 0;
+}
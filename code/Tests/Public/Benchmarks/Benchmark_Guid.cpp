@@ -0,0 +1,111 @@
+#pragma once
+
+#include "EFGUID.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace{
+    // Keeps the optimizer from dropping the results
+    size_t g_checksum = 0;
+
+    template <typename Function>
+    double MeasureBestNs(const int32 rounds, const size_t operations, Function&& function){
+        using namespace EventfulEngine;
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            function();
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              static_cast<double>(operations));
+        }
+        return bestNs;
+    }
+}
+
+// Measures GUID generation, formatting and parsing and checks that they round trip. Fails if formatting plus
+// parsing a GUID exceeds the budget.
+// Usage: guid_benchmark [--budget-ns=<ns>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double budgetNs = 0.0;
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetNs);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    constexpr size_t guidCount = 100'000;
+    std::vector<EFGUID> guids(guidCount);
+    std::vector<char> text(guidCount * EFGUID::StringLength);
+
+    const double newGuidNs = MeasureBestNs(rounds, guidCount, [&guids]{
+        for (EFGUID& guid : guids){
+            guid = NewGuid();
+        }
+    });
+    const double batchNs = MeasureBestNs(rounds, guidCount, [&guids]{ NewGuids(guids); });
+
+    const double formatNs = MeasureBestNs(rounds, guidCount, [&guids, &text]{
+        for (size_t index = 0; index < guidCount; ++index){
+            guids[index].ToChars(std::span<char, EFGUID::StringLength>{&text[index * EFGUID::StringLength],
+                                                                       EFGUID::StringLength});
+        }
+    });
+    const double stringNs = MeasureBestNs(rounds, guidCount, [&guids]{
+        for (const EFGUID& guid : guids){
+            g_checksum += guid.String().size();
+        }
+    });
+
+    std::vector<EFGUID> parsed(guidCount);
+    const double parseNs = MeasureBestNs(rounds, guidCount, [&parsed, &text]{
+        for (size_t index = 0; index < guidCount; ++index){
+            parsed[index] = EFGUID{std::string_view{&text[index * EFGUID::StringLength], EFGUID::StringLength}};
+        }
+    });
+
+    bool success = true;
+    const std::unordered_set<EFGUID> unique{guids.begin(), guids.end()};
+    if (unique.size() != guids.size()){
+        std::cerr << "Generated " << guids.size() - unique.size() << " duplicate GUIDs\n";
+        success = false;
+    }
+    for (size_t index = 0; index < guidCount && success; ++index){
+        const EFGUID& guid = guids[index];
+        if (parsed[index] != guid || EFGUID{guid.String()} != guid || (guid.Bytes()[6] >> 4) != 4 ||
+            (guid.Bytes()[8] >> 6) != 2){
+            std::cerr << "GUID " << guid << " does not round trip or is not version 4\n";
+            success = false;
+        }
+    }
+    if (EFGUID{"00112233-4455-6677-8899-AaBbCcDdEeFf"}.String() != "00112233-4455-6677-8899-aabbccddeeff" ||
+        EFGUID{"00112233445566778899aabbccddeeff"}.String() != "00112233-4455-6677-8899-aabbccddeeff" ||
+        EFGUID{"00112233-4455-6677-8899-aabbccddeefg"}.IsValid() || EFGUID{"0011"}.IsValid()){
+        std::cerr << "GUID parsing of reference strings failed\n";
+        success = false;
+    }
+
+    std::cout << "GUID: NewGuid " << newGuidNs << "ns, NewGuids " << batchNs << "ns, ToChars " << formatNs
+        << "ns, String " << stringNs << "ns, parse " << parseNs << "ns (" << g_checksum << ")\n";
+
+    if (budgetNs > 0.0 && formatNs + parseNs > budgetNs){
+        std::cerr << "Formatting and parsing a GUID took " << formatNs + parseNs << "ns, budget is " << budgetNs
+            << "ns\n";
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "EFHashMap.h"
+#include "EFHashSet.h"
+#include "EFText.h"
+#include "EfMemory.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace{
+    // Keeps the optimizer from dropping the lookups
+    size_t g_found = 0;
+
+    template <typename Function>
+    double MeasureBestNs(const int32 rounds, const size_t operations, Function&& function){
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            function();
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              static_cast<double>(operations));
+        }
+        return bestNs;
+    }
+
+    struct Results{
+        double InsertNs{0.0};
+        double HitNs{0.0};
+        double MissNs{0.0};
+        double IterateNs{0.0};
+    };
+
+    /** Runs the same workload against any map with the std interface. */
+    template <typename Map, typename Key>
+    Results MeasureMap(const int32 rounds, const std::vector<Key>& keys, const std::vector<Key>& missingKeys){
+        Results results;
+        results.InsertNs = MeasureBestNs(rounds, keys.size(), [&]{
+            Map map;
+            for (size_t index = 0; index < keys.size(); ++index){
+                map.emplace(keys[index], index);
+            }
+            g_found += map.size();
+        });
+
+        Map map;
+        for (size_t index = 0; index < keys.size(); ++index){
+            map.emplace(keys[index], index);
+        }
+        results.HitNs = MeasureBestNs(rounds, keys.size(), [&]{
+            for (const Key& key : keys){
+                g_found += map.find(key)->second;
+            }
+        });
+        results.MissNs = MeasureBestNs(rounds, missingKeys.size(), [&]{
+            for (const Key& key : missingKeys){
+                g_found += map.contains(key);
+            }
+        });
+        results.IterateNs = MeasureBestNs(rounds, map.size(), [&]{
+            for (const auto& [key, value] : map){
+                g_found += value;
+            }
+        });
+        return results;
+    }
+
+    void Print(const std::string_view name, const Results& results){
+        std::cout << "  " << name << ": insert " << results.InsertNs << "ns, hit " << results.HitNs << "ns, miss "
+            << results.MissNs << "ns, iterate " << results.IterateNs << "ns\n";
+    }
+
+    /** Cross checks EFHashMap against std::unordered_map under mixed inserts and erases. */
+    bool Validate(){
+        using namespace EventfulEngine;
+        std::mt19937_64 random{42};
+        EFHashMap<uint64, uint64> map;
+        std::unordered_map<uint64, uint64> reference;
+        for (int32 step = 0; step < 200'000; ++step){
+            const uint64 key = random() % 5'000;
+            if (random() % 3 == 0){
+                if (map.erase(key) != reference.erase(key)){
+                    return false;
+                }
+            }
+            else{
+                map[key] = step;
+                reference[key] = step;
+            }
+        }
+        if (map.size() != reference.size()){
+            return false;
+        }
+        for (const auto& [key, value] : reference){
+            if (const auto found = map.find(key); found == map.end() || found->second != value){
+                return false;
+            }
+        }
+
+        EFHashSet<EFString> set;
+        set.insert(std::string_view{"Heterogeneous"});
+        return set.contains(std::string_view{"Heterogeneous"}) && !set.contains("Missing");
+    }
+}
+
+// Compares EFHashMap against std::unordered_map for inserts, lookups of present and missing keys and iteration,
+// with integer and string keys. Fails if EFHashMap lookups are not faster by the given factor.
+// Usage: hash_map_benchmark [--min-speedup=<factor>] [--count=<n>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double minSpeedup = 0.0;
+    size_t count = 100'000;
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--min-speedup=")){
+            const std::string_view value = argument.substr(std::string_view{"--min-speedup="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), minSpeedup);
+        }
+        else if (argument.starts_with("--count=")){
+            const std::string_view value = argument.substr(std::string_view{"--count="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), count);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    if (!Validate()){
+        std::cerr << "EFHashMap does not match std::unordered_map\n";
+        return 1;
+    }
+
+    std::mt19937_64 random{1234};
+    std::vector<uint64> integers(count);
+    std::vector<uint64> missingIntegers(count);
+    for (size_t index = 0; index < count; ++index){
+        // Odd keys are present, even ones missing
+        integers[index] = random() | 1;
+        missingIntegers[index] = random() & ~1ull;
+    }
+
+    std::vector<EFString> strings;
+    std::vector<EFString> missingStrings;
+    for (size_t index = 0; index < count; ++index){
+        strings.push_back(EFText::Format("Config.Section{}.Key{}", index % 97, index));
+        missingStrings.push_back(EFText::Format("Config.Section{}.Missing{}", index % 97, index));
+    }
+
+    const Results stdIntegers = MeasureMap<std::unordered_map<uint64, size_t>>(rounds, integers, missingIntegers);
+    const Results efIntegers = MeasureMap<EFHashMap<uint64, size_t>>(rounds, integers, missingIntegers);
+    const Results efPooledIntegers = MeasureMap<EFHashMap<uint64, size_t, std::hash<uint64>, std::equal_to<uint64>,
+                                                          EFMallocator<std::pair<const uint64, size_t>>>>(
+        rounds, integers, missingIntegers);
+    const Results stdStrings = MeasureMap<std::unordered_map<EFString, size_t>>(rounds, strings, missingStrings);
+    const Results efStrings = MeasureMap<EFHashMap<EFString, size_t>>(rounds, strings, missingStrings);
+
+    std::cout << "Hash maps with " << count << " elements (" << g_found << ")\n";
+    std::cout << "uint64 keys\n";
+    Print("std::unordered_map", stdIntegers);
+    Print("EFHashMap", efIntegers);
+    Print("EFHashMap, EFMallocator", efPooledIntegers);
+    std::cout << "EFString keys\n";
+    Print("std::unordered_map", stdStrings);
+    Print("EFHashMap", efStrings);
+
+    const double integerSpeedup = stdIntegers.HitNs / efIntegers.HitNs;
+    const double stringSpeedup = stdStrings.HitNs / efStrings.HitNs;
+    std::cout << "Lookup speedup: uint64 " << integerSpeedup << "x, EFString " << stringSpeedup << "x\n";
+
+    if (minSpeedup > 0.0 && std::min(integerSpeedup, stringSpeedup) < minSpeedup){
+        std::cerr << "EFHashMap lookups are only " << std::min(integerSpeedup, stringSpeedup) << "x faster, expected "
+            << minSpeedup << "x\n";
+        return 1;
+    }
+    return 0;
+}
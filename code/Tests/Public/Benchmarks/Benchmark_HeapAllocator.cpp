@@ -0,0 +1,189 @@
+#pragma once
+
+#include "EFRAPIHeapAllocator.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    // Texture mip chains and buffers of a streamed level, sizes spread over four orders of magnitude
+    MemoryRequirements RandomRequirements(std::mt19937& random){
+        if (std::uniform_int_distribution(0, 2)(random) == 0){
+            const uint64 width = 64ull << std::uniform_int_distribution(0, 5)(random);
+            return {width * width * 4 * 4 / 3, 65536};
+        }
+        return {std::uniform_int_distribution<uint64>(1024, 1024 * 1024)(random), 256};
+    }
+
+    struct HeapSummary{
+        size_t Heaps = 0;
+        uint64 UsedBytes = 0;
+        uint64 ReservedBytes = 0;
+        float WorstFragmentation = 0.0f;
+    };
+
+    HeapSummary Summarize(EFRAPIHeapAllocator& allocator){
+        HeapSummary summary;
+        for (const HeapBlockStats& heap : allocator.GetHeapStats()){
+            ++summary.Heaps;
+            summary.UsedBytes += heap.UsedBytes;
+            summary.ReservedBytes += heap.Capacity;
+            summary.WorstFragmentation = std::max(summary.WorstFragmentation, heap.Fragmentation);
+        }
+        return summary;
+    }
+}
+
+// Streams resources in and out of placed memory on the headless backend: every frame allocates a batch of textures
+// and buffers of random sizes and frees random older ones once the resident budget is reached. Reports the allocation
+// and free latency of EFRAPIHeapAllocator, without the allocations that had to create a heap, and the fragmentation of
+// its heaps before and after defragmenting. Fails if an allocation plus a free takes longer on average than the budget.
+// Usage: heap_allocator_benchmark [--budget-ns=<ns>] [--frames=<n>] [--per-frame=<n>] [--resident-mb=<n>]
+int main(const int argc, char** argv){
+    double budgetNs = -1.0;
+    int32 frames = 2000;
+    int32 perFrame = 32;
+    int32 residentMb = 512;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetNs);
+        }
+        else if (argument.starts_with("--frames=")){
+            const std::string_view value = argument.substr(std::string_view{"--frames="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), frames);
+        }
+        else if (argument.starts_with("--per-frame=")){
+            const std::string_view value = argument.substr(std::string_view{"--per-frame="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), perFrame);
+        }
+        else if (argument.starts_with("--resident-mb=")){
+            const std::string_view value = argument.substr(std::string_view{"--resident-mb="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), residentMb);
+        }
+    }
+    const uint64 residentBytes = static_cast<uint64>(std::max(residentMb, 1)) * 1024 * 1024;
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIHeapAllocator allocator(device, HeapType::DeviceLocal);
+    std::mt19937 random(42);
+
+    std::vector<HeapAllocation> resident;
+    std::vector<MemoryRequirements> requested(perFrame);
+    std::vector<HeapAllocation> evicted;
+    uint64 residentSize = 0;
+    uint64 allocations = 0;
+    uint64 frees = 0;
+    EFDuration allocateTime{};
+    EFDuration heapCreationTime{};
+    EFDuration freeTime{};
+    // Timed per batch, reading the clock costs about as much as an allocation
+    for (int32 frame = 0; frame < frames; ++frame){
+        for (MemoryRequirements& requirements : requested){
+            requirements = RandomRequirements(random);
+        }
+        const uint64 heapsBefore = allocator.GetStats().HeapsCreated;
+        const size_t firstAllocated = resident.size();
+        EFTimePoint start = EFClock::now();
+        for (const MemoryRequirements& requirements : requested){
+            resident.push_back(allocator.Allocate(requirements));
+        }
+        const EFDuration elapsed = EFClock::now() - start;
+        // Creating a heap is the driver allocation the sub-allocator avoids, those batches are reported on their own
+        if (allocator.GetStats().HeapsCreated != heapsBefore){
+            heapCreationTime += elapsed;
+        }
+        else{
+            allocateTime += elapsed;
+            allocations += requested.size();
+        }
+        for (size_t index = firstAllocated; index < resident.size(); ++index){
+            if (!resident[index].IsValid()){
+                std::cerr << "Allocating " << requested[index - firstAllocated].size << " bytes failed\n";
+                return 1;
+            }
+            residentSize += resident[index].Size;
+        }
+
+        // Evicts random resources, not the oldest, so the holes are spread over all heaps
+        evicted.clear();
+        while (residentSize > residentBytes){
+            const size_t index = std::uniform_int_distribution<size_t>(0, resident.size() - 1)(random);
+            evicted.push_back(resident[index]);
+            residentSize -= resident[index].Size;
+            resident[index] = resident.back();
+            resident.pop_back();
+        }
+        start = EFClock::now();
+        for (const HeapAllocation& allocation : evicted){
+            allocator.Free(allocation);
+        }
+        freeTime += EFClock::now() - start;
+        frees += evicted.size();
+    }
+
+    const HeapSummary streamed = Summarize(allocator);
+    std::vector<HeapAllocation*> byNode;
+    for (HeapAllocation& allocation : resident){
+        if (byNode.size() <= allocation.Node){
+            byNode.resize(allocation.Node + 1);
+        }
+        byNode[allocation.Node] = &allocation;
+    }
+    // The moves only update the bookkeeping, a renderer creates the resource again and copies it here
+    const uint32 moves = allocator.Defragment([&](const HeapAllocation& from, const HeapAllocation& to){
+        HeapAllocation* allocation = byNode[from.Node];
+        *allocation = to;
+        if (byNode.size() <= to.Node){
+            byNode.resize(to.Node + 1);
+        }
+        byNode[to.Node] = allocation;
+        return true;
+    });
+    const HeapSummary defragmented = Summarize(allocator);
+
+    const double allocateNs = allocations > 0
+                                  ? std::chrono::duration<double, std::nano>(allocateTime).count() /
+                                  static_cast<double>(allocations)
+                                  : 0.0;
+    const double freeNs = frees > 0
+                              ? std::chrono::duration<double, std::nano>(freeTime).count() / static_cast<double>(frees)
+                              : 0.0;
+    const HeapAllocatorStats stats = allocator.GetStats();
+    auto printHeaps = [](const char* label, const HeapSummary& summary){
+        std::cout << "  " << label << ": " << summary.Heaps << " heaps, " << summary.UsedBytes / (1024 * 1024)
+            << " of " << summary.ReservedBytes / (1024 * 1024) << " MiB used, worst heap fragmentation "
+            << summary.WorstFragmentation << "\n";
+    };
+    std::cout << "Heap allocator streaming " << perFrame << " resources per frame for " << frames << " frames, "
+        << residentMb << " MiB resident\n";
+    std::cout << "  " << allocateNs << " ns per allocation, " << freeNs << " ns per free, " << stats.HeapsCreated
+        << " heaps created in " << std::chrono::duration<double, std::milli>(heapCreationTime).count() << " ms\n";
+    printHeaps("streamed", streamed);
+    printHeaps("defragmented", defragmented);
+    std::cout << "  " << moves << " allocations moved, " << stats.HeapsReleased << " heaps released\n";
+
+    // The relocated allocations free like the others
+    for (const HeapAllocation& allocation : resident){
+        allocator.Free(allocation);
+    }
+    if (allocator.GetStats().UsedBytes != 0){
+        std::cerr << allocator.GetStats().UsedBytes << " bytes are still allocated after freeing everything\n";
+        return 1;
+    }
+
+    if (budgetNs >= 0.0 && allocateNs + freeNs > budgetNs){
+        std::cerr << "Allocating and freeing takes " << allocateNs + freeNs << " ns, budget is " << budgetNs
+            << " ns\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "EFFramePacer.h"
+#include "EFIdleMonitor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+namespace{
+    // Keeps the optimizer from dropping the spinning loop
+    double g_sink = 0.0;
+
+    /** Runs loop until the window has passed, returns the CPU time used as a percentage of one core. */
+    template <typename Function>
+    double MeasureCpuPercent(const EFDuration window, Function&& loop){
+        using namespace EventfulEngine;
+        const EFDuration cpuStart = EFPlatformTime::GetProcessCpuTime();
+        const EFTimePoint start = EFClock::now();
+        while (EFClock::now() - start < window){
+            loop();
+        }
+        const EFDuration cpu = EFPlatformTime::GetProcessCpuTime() - cpuStart;
+        return 100.0 * EFPlatformTime::ToSeconds(cpu) / EFPlatformTime::ToSeconds(EFClock::now() - start);
+    }
+
+    /** One tick of EventfulEngineLoop::Tick with nothing to do but pacing. */
+    void Tick(EventfulEngine::EFFramePacer& pacer, const EFDuration idleInterval){
+        using namespace EventfulEngine;
+        pacer.BeginFrame();
+        if (EFIdleMonitor::ShouldIdle()){
+            EFIdleMonitor::WaitForActivity(idleInterval);
+            pacer.EndIdleFrame();
+        }
+        else{
+            pacer.EndFrame();
+        }
+    }
+}
+
+// Measures the CPU usage of the engine loop: the old loop that spun on StepTime, the paced loop with work pending and
+// the idle loop, plus how quickly RequestWake gets an idle loop going again. Fails if the idle loop uses more than
+// the given share of a core.
+// Usage: idle_benchmark [--max-idle-cpu-percent=<percent>] [--seconds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double maxIdleCpuPercent = 0.0;
+    double seconds = 1.0;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--max-idle-cpu-percent=")){
+            const std::string_view value = argument.substr(std::string_view{"--max-idle-cpu-percent="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), maxIdleCpuPercent);
+        }
+        else if (argument.starts_with("--seconds=")){
+            const std::string_view value = argument.substr(std::string_view{"--seconds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), seconds);
+        }
+    }
+
+    EFPlatformTime::Init();
+    EFPlatformTime::CalibrateCycles();
+    const auto window = std::chrono::duration_cast<EFDuration>(std::chrono::duration<double>(seconds));
+    constexpr EFDuration idleInterval = std::chrono::milliseconds(100);
+
+    const double spinningPercent = MeasureCpuPercent(window, []{
+        g_sink += EFPlatformTime::ToSeconds(EFPlatformTime::StepTime());
+    });
+
+    EFFramePacerSettings settings;
+    settings.TargetFps = 60.0;
+    settings.FixedStepHz = 60.0;
+    EFFramePacer pacer(settings);
+
+    double pacedPercent = 0.0;
+    {
+        EFScopedPendingWork pendingWork;
+        pacedPercent = MeasureCpuPercent(window, [&]{ Tick(pacer, idleInterval); });
+    }
+    const double idlePercent = MeasureCpuPercent(window, [&]{ Tick(pacer, idleInterval); });
+
+    // Wake latency, another thread requests a wake while the loop blocks with a long timeout
+    constexpr int32 wakeCount = 20;
+    std::atomic<int64> wakeRequestTicks{0};
+    double totalLatencyUs = 0.0;
+    double maxLatencyUs = 0.0;
+    std::thread waker([&]{
+        for (int32 wake = 0; wake < wakeCount; ++wake){
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            wakeRequestTicks.store(EFClock::now().time_since_epoch().count(), std::memory_order_release);
+            EFIdleMonitor::RequestWake();
+        }
+    });
+    for (int32 wake = 0; wake < wakeCount; ++wake){
+        EFIdleMonitor::WaitForActivity(std::chrono::seconds(1));
+        const EFTimePoint requested{EFDuration{wakeRequestTicks.load(std::memory_order_acquire)}};
+        const double latencyUs = std::chrono::duration<double, std::micro>(EFClock::now() - requested).count();
+        totalLatencyUs += latencyUs;
+        maxLatencyUs = std::max(maxLatencyUs, latencyUs);
+    }
+    waker.join();
+
+    const EFFramePacerStats stats = pacer.GetStats();
+    std::cout << "Engine loop CPU usage over " << seconds << "s: spinning " << spinningPercent << "%, paced at "
+        << settings.TargetFps << " fps " << pacedPercent << "%, idle " << idlePercent << "%\n"
+        << "Paced frames: average " << stats.AverageFrameSeconds * 1e3 << "ms, jitter " << stats.JitterSeconds * 1e6
+        << "us, max lateness " << stats.MaxLatenessSeconds * 1e6 << "us\n"
+        << "Wake latency: average " << totalLatencyUs / wakeCount << "us, max " << maxLatencyUs << "us ("
+        << (g_sink > 0.0) << ")\n";
+
+    if (maxIdleCpuPercent > 0.0 && idlePercent > maxIdleCpuPercent){
+        std::cerr << "Idle engine loop uses " << idlePercent << "% of a core, expected at most " << maxIdleCpuPercent
+            << "%\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "EFLogger.h"
+
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string_view>
+
+EF_DEFINE_LOG_CATEGORY_STATIC(BenchmarkLog, "BenchmarkLog.txt", E_EFLogLevel::trace, E_EFLogLevel::trace)
+EF_DEFINE_LOG_CATEGORY_STATIC(CompiledOutLog, "CompiledOutLog.txt", E_EFLogLevel::trace, E_EFLogLevel::off)
+
+namespace{
+    int32 g_evaluatedArguments = 0;
+
+    // Side effect visible to the benchmark, disabled log calls must never evaluate their arguments
+    int32 CountedArgument(const int32 value){
+        ++g_evaluatedArguments;
+        return value;
+    }
+
+    // Best average time of a single call over several bursts, runs between bursts are not measured
+    double MeasureBestNs(const int32 rounds, const int32 burstSize, const std::function<void(int32)>& burst,
+                         const std::function<void()>& betweenBursts){
+        using namespace EventfulEngine;
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            burst(burstSize);
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              burstSize);
+            betweenBursts();
+        }
+        return bestNs;
+    }
+}
+
+// Measures the cost of a log call on the calling thread (encoding into the per thread ring, without formatting or
+// IO) and of calls disabled at runtime or at compile time. Fails if a budget is exceeded or a disabled call
+// evaluated its arguments.
+// Usage: logger_benchmark [--budget-ns=<ns>] [--disabled-budget-ns=<ns>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double budgetNs = 0.0;
+    double disabledBudgetNs = 0.0;
+    int32 rounds = 20;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetNs);
+        }
+        else if (argument.starts_with("--disabled-budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--disabled-budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), disabledBudgetNs);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    EFLogger::SetConsoleOutput(false);
+    // Large enough for a whole burst, so the measurement never waits for the backend
+    EFLogger::SetRingCapacity(4u << 20);
+
+    const double enabledNs = MeasureBestNs(rounds, 20'000, [](const int32 count){
+        for (int32 index = 0; index < count; ++index){
+            EF_LOG(BenchmarkLog, trace, "Benchmark value {} of {} ({})", index, 3.5f, "burst");
+        }
+    }, []{ EFLogger::Flush(); });
+
+    BenchmarkLog.SetLevel(E_EFLogLevel::err);
+    const double runtimeDisabledNs = MeasureBestNs(rounds, 1'000'000, [](const int32 count){
+        for (int32 index = 0; index < count; ++index){
+            EF_LOG(BenchmarkLog, trace, "Benchmark value {} of {}", CountedArgument(index), 3.5f);
+        }
+    }, []{});
+
+    const double compiledOutNs = MeasureBestNs(rounds, 1'000'000, [](const int32 count){
+        for (int32 index = 0; index < count; ++index){
+            EF_LOG(CompiledOutLog, critical, "Benchmark value {} of {}", CountedArgument(index), 3.5f);
+        }
+    }, []{});
+    EFLogger::Shutdown();
+
+    std::cout << "Logger: enabled " << enabledNs << "ns/log, disabled at runtime " << runtimeDisabledNs
+        << "ns/log, compiled out " << compiledOutNs << "ns/log\n";
+
+    bool success = true;
+    if (g_evaluatedArguments != 0){
+        std::cerr << "Disabled log calls evaluated " << g_evaluatedArguments << " arguments\n";
+        success = false;
+    }
+    if (budgetNs > 0.0 && enabledNs > budgetNs){
+        std::cerr << "Logging took " << enabledNs << "ns per call, budget is " << budgetNs << "ns\n";
+        success = false;
+    }
+    if (disabledBudgetNs > 0.0 && runtimeDisabledNs > disabledBudgetNs){
+        std::cerr << "Disabled logging took " << runtimeDisabledNs << "ns per call, budget is " << disabledBudgetNs
+            << "ns\n";
+        success = false;
+    }
+    return success ? 0 : 1;
+}
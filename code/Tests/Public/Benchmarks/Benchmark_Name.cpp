@@ -0,0 +1,137 @@
+#pragma once
+
+#include "EFName.h"
+#include "EFText.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace{
+    // Keeps the optimizer from dropping the lookups
+    size_t g_found = 0;
+
+    template <typename Function>
+    double MeasureBestNs(const int32 rounds, const size_t operations, Function&& function){
+        using namespace EventfulEngine;
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            function();
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              static_cast<double>(operations));
+        }
+        return bestNs;
+    }
+
+    // Heap bytes owned by a string, zero while it fits into the small string buffer
+    size_t HeapBytes(const EFString& text){
+        return text.capacity() > EFString{}.capacity() ? text.capacity() + 1 : 0;
+    }
+}
+
+// Compares identifiers stored as EFString against interned EFNames: map lookups, equality checks and the memory of
+// many objects sharing the same tags. Fails if EFName lookups are not faster by the given factor.
+// Usage: name_benchmark [--min-speedup=<factor>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double minSpeedup = 0.0;
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--min-speedup=")){
+            const std::string_view value = argument.substr(std::string_view{"--min-speedup="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), minSpeedup);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    // Identifiers shaped like class, property and module names
+    constexpr size_t identifierCount = 2'000;
+    std::vector<EFString> strings;
+    std::vector<EFName> names;
+    for (size_t index = 0; index < identifierCount; ++index){
+        strings.push_back(EFText::Format("EventfulEngine_Reflected_Property_{}", index));
+        names.emplace_back(strings.back());
+    }
+
+    std::unordered_map<EFString, size_t> stringMap;
+    std::unordered_map<EFName, size_t> nameMap;
+    for (size_t index = 0; index < identifierCount; ++index){
+        stringMap.emplace(strings[index], index);
+        nameMap.emplace(names[index], index);
+    }
+
+    constexpr size_t lookupPasses = 50;
+    const double stringLookupNs = MeasureBestNs(rounds, identifierCount * lookupPasses, [&]{
+        for (size_t pass = 0; pass < lookupPasses; ++pass){
+            for (const EFString& key : strings){
+                g_found += stringMap.find(key)->second;
+            }
+        }
+    });
+    const double nameLookupNs = MeasureBestNs(rounds, identifierCount * lookupPasses, [&]{
+        for (size_t pass = 0; pass < lookupPasses; ++pass){
+            for (const EFName key : names){
+                g_found += nameMap.find(key)->second;
+            }
+        }
+    });
+
+    // Worst case for strings, equal length and a shared prefix
+    const double stringCompareNs = MeasureBestNs(rounds, identifierCount * identifierCount, [&]{
+        for (const EFString& left : strings){
+            g_found += std::ranges::count(strings, left);
+        }
+    });
+    const double nameCompareNs = MeasureBestNs(rounds, identifierCount * identifierCount, [&]{
+        for (const EFName left : names){
+            g_found += std::ranges::count(names, left);
+        }
+    });
+
+    // Many objects carrying tags out of a small set, like EFObject::_tags
+    constexpr size_t objectCount = 10'000;
+    constexpr size_t tagsPerObject = 4;
+    size_t stringBytes = 0;
+    size_t nameBytes = 0;
+    {
+        const EFName::Stats before = EFName::GetStats();
+        std::vector<std::vector<EFString>> stringTags(objectCount);
+        std::vector<std::vector<EFName>> nameTags(objectCount);
+        for (size_t object = 0; object < objectCount; ++object){
+            for (size_t tag = 0; tag < tagsPerObject; ++tag){
+                const EFString text = EFText::Format("Gameplay.Tag.Category{}", (object + tag) % 64);
+                stringTags[object].push_back(text);
+                nameTags[object].emplace_back(text);
+            }
+            stringBytes += stringTags[object].capacity() * sizeof(EFString);
+            for (const EFString& tag : stringTags[object]){
+                stringBytes += HeapBytes(tag);
+            }
+            nameBytes += nameTags[object].capacity() * sizeof(EFName);
+        }
+        const EFName::Stats after = EFName::GetStats();
+        nameBytes += after.TextBytes - before.TextBytes + after.TableBytes - before.TableBytes;
+    }
+
+    const double speedup = stringLookupNs / nameLookupNs;
+    std::cout << "Names: lookup EFString " << stringLookupNs << "ns, EFName " << nameLookupNs << "ns (" << speedup
+        << "x), compare EFString " << stringCompareNs << "ns, EFName " << nameCompareNs << "ns\n"
+        << "Tags of " << objectCount << " objects: EFString " << stringBytes << " bytes, EFName " << nameBytes
+        << " bytes, name table " << EFName::GetStats().NameCount << " names (" << g_found << ")\n";
+
+    if (minSpeedup > 0.0 && speedup < minSpeedup){
+        std::cerr << "EFName lookups are only " << speedup << "x faster, expected " << minSpeedup << "x\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "EFRAPIPipelineCache.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    struct Scene{
+        FramebufferHandle Framebuffer;
+        EFRAPIGraphicsPipeline* Placeholder = nullptr;
+        GraphicsPipelineHandle PlaceholderPipeline;
+        std::vector<GraphicsPipelineDesc> Pipelines;
+    };
+
+    // Every material is its own specialization of the same shaders, the way an uber shader gets permuted
+    std::vector<GraphicsPipelineDesc> CreatePipelineDescs(EFDynamicRAPI* device, const int32 count){
+        constexpr uint8 bytecode[] = {0x44, 0x58, 0x42, 0x43, 0x01, 0x02, 0x03, 0x04};
+        const ShaderHandle vertexShader = device->CreateShader(ShaderDesc().SetShaderType(F_ShaderType::Vertex).
+                                                                            SetEntryName("main"),
+                                                               bytecode, sizeof(bytecode));
+        const ShaderHandle pixelShader = device->CreateShader(ShaderDesc().SetShaderType(F_ShaderType::Pixel).
+                                                                           SetEntryName("main"),
+                                                              bytecode, sizeof(bytecode));
+        const BindingLayoutHandle layout = device->CreateBindingLayout(BindingLayoutDesc());
+
+        std::vector<GraphicsPipelineDesc> descs;
+        for (int32 index = 0; index < count; ++index){
+            const ShaderSpecialization material = ShaderSpecialization::UInt32(0, static_cast<uint32>(index));
+            GraphicsPipelineDesc desc;
+            desc.SetVertexShader(vertexShader).
+                 SetPixelShader(device->CreateShaderSpecialization(pixelShader, &material, 1)).
+                 AddBindingLayout(layout);
+            descs.push_back(desc);
+        }
+        return descs;
+    }
+
+    struct RunResult{
+        int32 HitchedFrames = 0;
+        double WorstFrameMs = 0.0;
+        PipelineCacheStats Stats;
+    };
+
+    // Materials stream in while the camera moves, every frame binds all materials seen so far plus a few new ones
+    RunResult RunFrames(EFRAPIPipelineCache& cache, const Scene& scene, const bool async, const int32 newPerFrame,
+                        const double hitchMs){
+        RunResult result;
+        const int32 pipelineCount = static_cast<int32>(scene.Pipelines.size());
+        const int32 frames = (pipelineCount + newPerFrame - 1) / newPerFrame + 1;
+        for (int32 frame = 0; frame < frames; ++frame){
+            const int32 visible = std::min(pipelineCount, (frame + 1) * newPerFrame);
+            const EFTimePoint start = EFClock::now();
+            for (int32 index = 0; index < visible; ++index){
+                const GraphicsPipelineHandle pipeline = async
+                                                            ? cache.RequestGraphicsPipeline(
+                                                                scene.Pipelines[index], scene.Framebuffer,
+                                                                scene.Placeholder)
+                                                            : cache.GetGraphicsPipeline(
+                                                                scene.Pipelines[index], scene.Framebuffer);
+                if (!pipeline){
+                    std::cerr << "Pipeline " << index << " was not created\n";
+                    std::exit(1);
+                }
+            }
+            const double frameMs = std::chrono::duration<double, std::milli>(EFClock::now() - start).count();
+            result.WorstFrameMs = std::max(result.WorstFrameMs, frameMs);
+            if (frameMs > hitchMs){
+                ++result.HitchedFrames;
+            }
+        }
+        cache.WaitForPendingCompilations();
+        result.Stats = cache.GetStats();
+        return result;
+    }
+
+    void Print(const std::string_view name, const RunResult& result){
+        std::cout << "  " << name << ": " << result.HitchedFrames << " hitched frames, worst frame "
+            << result.WorstFrameMs << " ms, " << result.Stats.Hits << " hits, " << result.Stats.Misses << " misses, "
+            << result.Stats.Hitches << " created on the frame, " << result.Stats.AsyncCompilations
+            << " async compiles, " << result.Stats.Placeholders << " placeholders, " << result.Stats.BinariesLoaded
+            << " binaries loaded\n";
+    }
+}
+
+// Streams pipelines into frames on the headless backend with a simulated compile time and counts the frames over
+// the hitch threshold: compiling on first use, compiling in the background behind a placeholder, and creating from
+// the binaries a previous run saved to disk. Fails if the background or warm start runs hitch more often than given.
+// Usage: pipeline_cache_benchmark [--max-hitches=<n>] [--pipelines=<n>] [--new-per-frame=<n>] [--compile-ms=<n>]
+//        [--hitch-ms=<n>]
+int main(const int argc, char** argv){
+    int32 maxHitches = 0;
+    int32 pipelines = 64;
+    int32 newPerFrame = 4;
+    int32 compileMs = 5;
+    double hitchMs = 2.0;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--max-hitches=")){
+            const std::string_view value = argument.substr(std::string_view{"--max-hitches="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), maxHitches);
+        }
+        else if (argument.starts_with("--pipelines=")){
+            const std::string_view value = argument.substr(std::string_view{"--pipelines="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), pipelines);
+        }
+        else if (argument.starts_with("--new-per-frame=")){
+            const std::string_view value = argument.substr(std::string_view{"--new-per-frame="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), newPerFrame);
+        }
+        else if (argument.starts_with("--compile-ms=")){
+            const std::string_view value = argument.substr(std::string_view{"--compile-ms="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), compileMs);
+        }
+        else if (argument.starts_with("--hitch-ms=")){
+            const std::string_view value = argument.substr(std::string_view{"--hitch-ms="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), hitchMs);
+        }
+    }
+    pipelines = std::max(pipelines, 1);
+    newPerFrame = std::max(newPerFrame, 1);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+
+    Scene scene;
+    const TextureHandle target = device->CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).
+                                                                     SetFormat(E_Format::RGBA8_UNORM).
+                                                                     SetIsRenderTarget(true));
+    scene.Framebuffer = device->CreateFramebuffer(FramebufferDesc().AddColorAttachment(target));
+    scene.PlaceholderPipeline = device->CreateGraphicsPipeline(GraphicsPipelineDesc(), scene.Framebuffer);
+    scene.Placeholder = scene.PlaceholderPipeline;
+    scene.Pipelines = CreatePipelineDescs(device, pipelines);
+
+    // The same description built from other shader objects has to land on the same hash
+    const std::vector<GraphicsPipelineDesc> rebuilt = CreatePipelineDescs(device, 2);
+    const FramebufferInfo& framebufferInfo = scene.Framebuffer->GetFramebufferInfo();
+    if (HashGraphicsPipeline(rebuilt[0], framebufferInfo) != HashGraphicsPipeline(scene.Pipelines[0], framebufferInfo) ||
+        HashGraphicsPipeline(rebuilt[0], framebufferInfo) == HashGraphicsPipeline(rebuilt[1], framebufferInfo)){
+        std::cerr << "Pipeline hashes depend on object identity or miss the specialization constants\n";
+        return 1;
+    }
+
+    headless->SetPipelineCompileTime(std::chrono::milliseconds(compileMs));
+    const EFPath cachePath = std::filesystem::temp_directory_path() / "pipeline_cache_benchmark.bin";
+
+    RunResult compileOnUse;
+    {
+        EFRAPIPipelineCache cache(device);
+        compileOnUse = RunFrames(cache, scene, false, newPerFrame, hitchMs);
+        if (!cache.Save(cachePath)){
+            std::cerr << "Could not save the pipeline cache to " << cachePath.string() << "\n";
+            return 1;
+        }
+    }
+
+    RunResult background;
+    {
+        EFRAPIPipelineCache cache(device);
+        background = RunFrames(cache, scene, true, newPerFrame, hitchMs);
+    }
+
+    headless->ResetStats();
+    RunResult warmStart;
+    {
+        EFRAPIPipelineCache cache(device);
+        if (!cache.Load(cachePath)){
+            std::cerr << "Could not load the pipeline cache from " << cachePath.string() << "\n";
+            return 1;
+        }
+        warmStart = RunFrames(cache, scene, false, newPerFrame, hitchMs);
+    }
+    std::filesystem::remove(cachePath);
+    const HeadlessDeviceStats deviceStats = headless->GetStats();
+
+    std::cout << "Pipeline cache with " << pipelines << " pipelines, " << newPerFrame << " new per frame, "
+        << compileMs << " ms compile time, " << hitchMs << " ms hitch threshold\n";
+    Print("compile on first use", compileOnUse);
+    Print("background compile", background);
+    Print("warm start from disk", warmStart);
+
+    if (deviceStats.PipelinesCompiled != 0){
+        std::cerr << "Warm start compiled " << deviceStats.PipelinesCompiled << " pipelines, expected all from binaries\n";
+        return 1;
+    }
+    if (background.HitchedFrames > maxHitches || warmStart.HitchedFrames > maxHitches){
+        std::cerr << "Background compile hitched " << background.HitchedFrames << " frames and warm start "
+            << warmStart.HitchedFrames << " frames, expected at most " << maxHitches << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "EFProfiler.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+namespace{
+    template <typename Function>
+    double MeasureBestNs(const int32 rounds, const int32 operations, Function&& function){
+        using namespace EventfulEngine;
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            function(operations);
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              operations);
+            // Collect every round, so the rings never overflow
+            EFProfiler::EndFrame();
+        }
+        return bestNs;
+    }
+
+    /** Zones of two threads and a GPU zone have to show up, merged by name, in the stats of their frame. */
+    bool Validate(){
+        using namespace EventfulEngine;
+        EFProfiler::EndFrame();
+        const uint64 frameIndex = EFProfiler::GetFrameIndex();
+        const auto recordZones = []{
+            for (int32 zone = 0; zone < 3; ++zone){
+                EFProfilerScope scope("Validate::Zone");
+            }
+            EFProfilerScope scope(EFProfilerScope::InternName, EFString{"Validate::"} + "Dynamic");
+        };
+        recordZones();
+        std::thread(recordZones).join();
+        EFProfiler::RecordGpuZone(frameIndex, "Validate::Gpu", EFPlatformTime::Cycles64(), 0.002);
+        EFProfiler::EndFrame();
+
+        const EFProfilerFrameStats stats = EFProfiler::GetLastFrameStats();
+        const auto findZone = [](const std::vector<EFProfilerZoneStats>& zones, const std::string_view name){
+            const auto zone = std::ranges::find(zones, name, [](const EFProfilerZoneStats& stats){
+                return std::string_view{stats.Name};
+            });
+            return zone != zones.end() ? zone->Count : 0u;
+        };
+        return stats.FrameIndex == frameIndex && findZone(stats.CpuZones, "Validate::Zone") == 6 &&
+            findZone(stats.CpuZones, "Validate::Dynamic") == 2 && findZone(stats.GpuZones, "Validate::Gpu") == 1 &&
+            stats.bHasGpuTimings && stats.GpuSeconds > 0.001 && stats.DroppedEvents == 0;
+    }
+}
+
+// Measures the cost of a builtin profiler zone while profiling is enabled and disabled at run time, checks that
+// zones of several threads and the GPU end up in the frame stats and optionally writes the trace.
+// Usage: profiler_benchmark [--budget-ns=<ns>] [--disabled-budget-ns=<ns>] [--rounds=<n>] [--trace=<file.json>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double budgetNs = 0.0;
+    double disabledBudgetNs = 0.0;
+    int32 rounds = 20;
+    std::string_view tracePath;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetNs);
+        }
+        else if (argument.starts_with("--disabled-budget-ns=")){
+            const std::string_view value = argument.substr(std::string_view{"--disabled-budget-ns="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), disabledBudgetNs);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+        else if (argument.starts_with("--trace=")){
+            tracePath = argument.substr(std::string_view{"--trace="}.size());
+        }
+    }
+
+    EFPlatformTime::Init();
+    EFPlatformTime::CalibrateCycles();
+    EFProfiler::SetThreadName("Main");
+
+    bool success = Validate();
+    if (!success){
+        std::cerr << "Recorded zones are missing from the frame stats\n";
+    }
+
+    // Fills most of the ring, the collection in EndFrame runs outside of the measurement
+    constexpr int32 zonesPerRound = EFProfiler::EventsPerThread / 2;
+    const double enabledNs = MeasureBestNs(rounds, zonesPerRound, [](const int32 count){
+        for (int32 zone = 0; zone < count; ++zone){
+            EFProfilerScope scope("Benchmark::Zone");
+        }
+    });
+    const uint32 droppedEvents = EFProfiler::GetLastFrameStats().DroppedEvents;
+
+    EFProfiler::SetEnabled(false);
+    const double disabledNs = MeasureBestNs(rounds, 1'000'000, [](const int32 count){
+        for (int32 zone = 0; zone < count; ++zone){
+            EFProfilerScope scope("Benchmark::Zone");
+        }
+    });
+    EFProfiler::SetEnabled(true);
+
+    std::cout << "Profiler zones: enabled " << enabledNs << "ns/zone, disabled at runtime " << disabledNs
+        << "ns/zone\n";
+
+    if (!tracePath.empty() && !EFProfiler::WriteChromeTrace(EFString{tracePath})){
+        std::cerr << "Could not write the trace to " << tracePath << "\n";
+        success = false;
+    }
+    if (droppedEvents != 0){
+        std::cerr << droppedEvents << " zones were dropped although the ring had room for them\n";
+        success = false;
+    }
+    if (budgetNs > 0.0 && enabledNs > budgetNs){
+        std::cerr << "A profiler zone took " << enabledNs << "ns, budget is " << budgetNs << "ns\n";
+        success = false;
+    }
+    if (disabledBudgetNs > 0.0 && disabledNs > disabledBudgetNs){
+        std::cerr << "A disabled profiler zone took " << disabledNs << "ns, budget is " << disabledBudgetNs << "ns\n";
+        success = false;
+    }
+    return success ? 0 : 1;
+}
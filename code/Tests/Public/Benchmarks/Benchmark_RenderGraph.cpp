@@ -0,0 +1,306 @@
+#pragma once
+
+#include "EFRenderGraph.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace{
+    using namespace EventfulEngine;
+
+    constexpr int32 SHADOW_CASCADES = 4;
+    constexpr int32 BLOOM_LEVELS = 5;
+
+    struct Scene{
+        uint32 Width = 0;
+        uint32 Height = 0;
+        int32 Draws = 0;
+        TextureHandle BackBuffer;
+        BufferHandle Exposure;
+        GraphicsPipelineHandle GeometryPipeline;
+        ComputePipelineHandle ComputePipeline;
+        std::vector<BindingSetHandle> Materials;
+    };
+
+    Scene CreateScene(EFDynamicRAPI* device, const uint32 width, const uint32 height, const int32 draws,
+                      const int32 materials){
+        Scene scene;
+        scene.Width = width;
+        scene.Height = height;
+        scene.Draws = draws;
+        scene.BackBuffer = device->CreateTexture(TextureDesc().SetWidth(width).SetHeight(height).
+                                                               SetFormat(E_Format::RGBA8_UNORM).
+                                                               SetIsRenderTarget(true));
+        scene.Exposure = device->CreateBuffer(BufferDesc().SetByteSize(16).SetStructStride(4).SetCanHaveUAVs(true));
+        scene.GeometryPipeline = device->CreateGraphicsPipeline(GraphicsPipelineDesc(), nullptr);
+        const ShaderHandle computeShader = device->CreateShader(ShaderDesc().SetShaderType(F_ShaderType::Compute),
+                                                                nullptr, 0);
+        scene.ComputePipeline = device->CreateComputePipeline(ComputePipelineDesc().SetComputeShader(computeShader));
+
+        for (int32 index = 0; index < materials; ++index){
+            const TextureHandle albedo = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4).
+                                                                             SetFormat(E_Format::RGBA8_UNORM));
+            const BindingSetDesc materialDesc = BindingSetDesc().addItem(BindingSetItem::Texture_SRV(0, albedo));
+            const BindingLayoutHandle layout = device->CreateBindingLayout(
+                CreateBindingLayoutDesc(F_ShaderType::Pixel, 0, materialDesc));
+            scene.Materials.push_back(device->CreateBindingSet(materialDesc, layout));
+        }
+        return scene;
+    }
+
+    TextureDesc Target(const uint32 width, const uint32 height, const E_Format format){
+        return TextureDesc().SetWidth(std::max(width, 1u)).SetHeight(std::max(height, 1u)).SetFormat(format).
+                             SetIsRenderTarget(true);
+    }
+
+    TextureDesc Storage(const uint32 width, const uint32 height, const E_Format format){
+        return Target(width, height, format).SetIsRenderTarget(false).SetIsUAV(true);
+    }
+
+    // Geometry passes draw the scene with its materials, every draw binds its material
+    RenderGraphExecute DrawScene(const Scene& scene, const int32 draws){
+        return [&scene, draws](EFRAPICommandList* commandList, const RenderGraphResources&){
+            GraphicsState graphicsState;
+            graphicsState.Pipeline = scene.GeometryPipeline;
+            graphicsState.Bindings.resize(1);
+            for (int32 draw = 0; draw < draws; ++draw){
+                graphicsState.Bindings[0] = scene.Materials[draw % scene.Materials.size()];
+                commandList->SetGraphicsState(graphicsState);
+                commandList->SetPushConstants(&draw, sizeof(draw));
+                commandList->Draw(DrawArguments().setVertexCount(3));
+            }
+        };
+    }
+
+    RenderGraphExecute DispatchFullScreen(const Scene& scene){
+        return [&scene](EFRAPICommandList* commandList, const RenderGraphResources&){
+            ComputeState computeState;
+            computeState.pipeline = scene.ComputePipeline;
+            commandList->SetComputeState(computeState);
+            commandList->Dispatch((scene.Width + 7) / 8, (scene.Height + 7) / 8, 1);
+        };
+    }
+
+    // A deferred frame: depth prepass and shadow cascades resolved into a screen space shadow mask, G-buffer, ambient
+    // occlusion, tiled lighting, transparent geometry, a bloom chain, exposure from a luminance histogram and
+    // tonemapping, plus a debug view that nothing presents and that is culled
+    void AddDeferredFrame(EFRenderGraph& graph, const Scene& scene){
+        const uint32 width = scene.Width;
+        const uint32 height = scene.Height;
+        const RenderGraphTexture backBuffer = graph.ImportTexture(scene.BackBuffer, F_ResourceStates::Present,
+                                                                  F_ResourceStates::Present);
+        const RenderGraphBuffer exposure = graph.ImportBuffer(scene.Exposure, F_ResourceStates::ShaderResource);
+
+        RenderGraphTexture depth;
+        graph.AddPass("DepthPrepass", [&](RenderGraphBuilder& builder){
+            depth = builder.Write(builder.CreateTexture(Target(width, height, E_Format::D32)),
+                                  F_ResourceStates::DepthWrite);
+        }, DrawScene(scene, scene.Draws));
+
+        RenderGraphTexture cascades[SHADOW_CASCADES];
+        for (RenderGraphTexture& cascade : cascades){
+            graph.AddPass("ShadowCascade", [&](RenderGraphBuilder& builder){
+                cascade = builder.Write(builder.CreateTexture(Target(1024, 1024, E_Format::D32)),
+                                        F_ResourceStates::DepthWrite);
+            }, DrawScene(scene, scene.Draws / SHADOW_CASCADES));
+        }
+
+        RenderGraphTexture albedo, normals, material;
+        graph.AddPass("GBuffer", [&](RenderGraphBuilder& builder){
+            builder.Read(depth, F_ResourceStates::DepthRead);
+            albedo = builder.Write(builder.CreateTexture(Target(width, height, E_Format::RGBA8_UNORM)));
+            normals = builder.Write(builder.CreateTexture(Target(width, height, E_Format::RGBA16_FLOAT)));
+            material = builder.Write(builder.CreateTexture(Target(width, height, E_Format::RGBA8_UNORM)));
+        }, DrawScene(scene, scene.Draws));
+
+        graph.AddPass("DebugNormals", [&](RenderGraphBuilder& builder){
+            builder.Read(normals);
+            builder.Write(builder.CreateTexture(Storage(width, height, E_Format::RGBA8_UNORM)),
+                          F_ResourceStates::UnorderedAccess);
+        }, DispatchFullScreen(scene));
+
+        // Cascades are resolved into a screen space mask, their memory is free again for the passes after it
+        RenderGraphTexture shadowMask;
+        graph.AddPass("ShadowMask", [&](RenderGraphBuilder& builder){
+            builder.Read(depth);
+            for (const RenderGraphTexture cascade : cascades){
+                builder.Read(cascade);
+            }
+            shadowMask = builder.Write(builder.CreateTexture(Storage(width, height, E_Format::R8_UNORM)),
+                                       F_ResourceStates::UnorderedAccess);
+        }, DispatchFullScreen(scene));
+
+        RenderGraphTexture occlusion, blurredOcclusion;
+        graph.AddPass("Occlusion", [&](RenderGraphBuilder& builder){
+            builder.Read(depth);
+            builder.Read(normals);
+            occlusion = builder.Write(builder.CreateTexture(Storage(width / 2, height / 2, E_Format::R8_UNORM)),
+                                      F_ResourceStates::UnorderedAccess);
+        }, DispatchFullScreen(scene));
+        graph.AddPass("OcclusionBlur", [&](RenderGraphBuilder& builder){
+            builder.Read(occlusion);
+            blurredOcclusion = builder.Write(
+                builder.CreateTexture(Storage(width / 2, height / 2, E_Format::R8_UNORM)),
+                F_ResourceStates::UnorderedAccess);
+        }, DispatchFullScreen(scene));
+
+        RenderGraphTexture lighting;
+        graph.AddPass("Lighting", [&](RenderGraphBuilder& builder){
+            builder.Read(albedo);
+            builder.Read(normals);
+            builder.Read(material);
+            builder.Read(depth);
+            builder.Read(blurredOcclusion);
+            builder.Read(shadowMask);
+            lighting = builder.Write(builder.CreateTexture(Storage(width, height, E_Format::RGBA16_FLOAT).
+                                                           SetIsRenderTarget(true)),
+                                     F_ResourceStates::UnorderedAccess);
+        }, DispatchFullScreen(scene));
+
+        graph.AddPass("Transparent", [&](RenderGraphBuilder& builder){
+            builder.Read(depth, F_ResourceStates::DepthRead);
+            builder.Write(lighting);
+        }, DrawScene(scene, scene.Draws / 4));
+
+        RenderGraphTexture bloom[BLOOM_LEVELS];
+        for (int32 level = 0; level < BLOOM_LEVELS; ++level){
+            graph.AddPass("BloomDownsample", [&](RenderGraphBuilder& builder){
+                builder.Read(level == 0 ? lighting : bloom[level - 1]);
+                bloom[level] = builder.Write(builder.CreateTexture(
+                                                 Storage(width >> (level + 1), height >> (level + 1),
+                                                         E_Format::RGBA16_FLOAT)),
+                                             F_ResourceStates::UnorderedAccess);
+            }, DispatchFullScreen(scene));
+        }
+        RenderGraphTexture upsampled = bloom[BLOOM_LEVELS - 1];
+        for (int32 level = BLOOM_LEVELS - 2; level >= 0; --level){
+            graph.AddPass("BloomUpsample", [&](RenderGraphBuilder& builder){
+                builder.Read(upsampled);
+                builder.Read(bloom[level]);
+                upsampled = builder.Write(builder.CreateTexture(
+                                              Storage(width >> (level + 1), height >> (level + 1),
+                                                      E_Format::RGBA16_FLOAT)),
+                                          F_ResourceStates::UnorderedAccess);
+            }, DispatchFullScreen(scene));
+        }
+
+        RenderGraphBuffer histogram;
+        graph.AddPass("LuminanceHistogram", [&](RenderGraphBuilder& builder){
+            builder.Read(lighting);
+            histogram = builder.Write(builder.CreateBuffer(BufferDesc().SetByteSize(256 * 4).SetStructStride(4).
+                                                                        SetCanHaveUAVs(true)));
+        }, DispatchFullScreen(scene));
+        graph.AddPass("Exposure", [&](RenderGraphBuilder& builder){
+            builder.Read(histogram);
+            builder.Write(exposure);
+        }, DispatchFullScreen(scene));
+
+        graph.AddPass("Tonemap", [&](RenderGraphBuilder& builder){
+            builder.Read(lighting);
+            builder.Read(upsampled);
+            builder.Read(exposure);
+            builder.Write(backBuffer);
+        }, DrawScene(scene, 1));
+    }
+
+    struct FrameResult{
+        RenderGraphStats Stats;
+        EFDuration CompileTime{};
+        EFDuration RecordTime{};
+    };
+
+    FrameResult RunFrames(EFRenderGraph& graph, EFDynamicRAPI* device, const Scene& scene, const uint32 threads,
+                          const int32 frames){
+        FrameResult result;
+        graph.SetRecordingThreads(threads);
+        for (int32 frame = 0; frame < frames; ++frame){
+            graph.Reset();
+            AddDeferredFrame(graph, scene);
+            graph.Execute();
+            device->RunGarbageCollection();
+            result.CompileTime += graph.GetStats().CompileTime;
+            result.RecordTime += graph.GetStats().RecordTime;
+        }
+        result.Stats = graph.GetStats();
+        return result;
+    }
+}
+
+// Builds and executes a deferred frame render graph on the headless backend and reports the memory the transient
+// resources save by aliasing, the passes culled and barriers derived, and the CPU time of compiling the graph and of
+// recording it on one thread and in parallel. Fails if compiling and recording a frame in parallel takes longer on
+// average than the budget.
+// Usage: render_graph_benchmark [--budget-us=<us>] [--draws=<n>] [--materials=<n>] [--frames=<n>] [--threads=<n>]
+int main(const int argc, char** argv){
+    double budgetUs = -1.0;
+    int32 draws = 4'000;
+    int32 materials = 200;
+    int32 frames = 60;
+    uint32 threads = std::max(std::thread::hardware_concurrency(), 2u);
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-us=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-us="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetUs);
+        }
+        else if (argument.starts_with("--draws=")){
+            const std::string_view value = argument.substr(std::string_view{"--draws="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), draws);
+        }
+        else if (argument.starts_with("--materials=")){
+            const std::string_view value = argument.substr(std::string_view{"--materials="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), materials);
+        }
+        else if (argument.starts_with("--frames=")){
+            const std::string_view value = argument.substr(std::string_view{"--frames="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), frames);
+        }
+        else if (argument.starts_with("--threads=")){
+            const std::string_view value = argument.substr(std::string_view{"--threads="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), threads);
+        }
+    }
+    materials = std::max(materials, 1);
+    frames = std::max(frames, 1);
+    threads = std::max(threads, 1u);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const Scene scene = CreateScene(device, 1280, 720, draws, materials);
+    EFRenderGraph graph(device);
+
+    const FrameResult serial = RunFrames(graph, device, scene, 1, frames);
+    const FrameResult parallel = RunFrames(graph, device, scene, threads, frames);
+
+    const RenderGraphStats& stats = parallel.Stats;
+    const auto toUs = [frames](const EFDuration duration){
+        return std::chrono::duration<double, std::micro>(duration).count() / frames;
+    };
+    const double saved = stats.TransientBytes > 0
+                             ? 100.0 * static_cast<double>(stats.TransientBytes - stats.AliasedBytes) /
+                             static_cast<double>(stats.TransientBytes)
+                             : 0.0;
+    std::cout << "Render graph of " << frames << " deferred frames with " << draws << " draws and " << materials
+        << " materials\n";
+    std::cout << "  " << stats.Passes << " passes, " << stats.PassesCulled << " culled, " << stats.Levels
+        << " levels, " << stats.Barriers << " barriers\n";
+    std::cout << "  " << stats.TransientTextures << " transient textures and " << stats.TransientBuffers
+        << " buffers: " << stats.TransientBytes / (1024 * 1024) << " MiB, aliased into "
+        << stats.AliasedBytes / (1024 * 1024) << " MiB (" << saved << "% saved)\n";
+    std::cout << "  " << toUs(parallel.CompileTime) << " us compiling per frame\n";
+    std::cout << "  " << toUs(serial.RecordTime) << " us recording per frame on 1 thread into "
+        << serial.Stats.CommandLists << " command lists\n";
+    std::cout << "  " << toUs(parallel.RecordTime) << " us recording per frame on " << threads << " threads into "
+        << stats.CommandLists << " command lists\n";
+
+    const double frameUs = toUs(parallel.CompileTime + parallel.RecordTime);
+    if (budgetUs >= 0.0 && frameUs > budgetUs){
+        std::cerr << "Compiling and recording a frame takes " << frameUs << " us, budget is " << budgetUs << " us\n";
+        return 1;
+    }
+    return 0;
+}
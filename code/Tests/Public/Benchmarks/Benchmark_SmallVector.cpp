@@ -0,0 +1,133 @@
+#pragma once
+
+#include "EFInlineString.h"
+#include "EFSmallVector.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace{
+    // Keeps the optimizer from dropping the containers
+    size_t g_sink = 0;
+
+    template <typename Function>
+    double MeasureBestNs(const int32 rounds, const size_t operations, Function&& function){
+        double bestNs = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            function();
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(EFClock::now() - start).count() /
+                              static_cast<double>(operations));
+        }
+        return bestNs;
+    }
+
+    /** Builds, reads and destroys a short lived vector of count elements, like a tag or argument list. */
+    template <typename Vector, typename Make>
+    double MeasureBuild(const int32 rounds, const size_t iterations, const size_t count, Make&& make){
+        return MeasureBestNs(rounds, iterations, [&]{
+            for (size_t iteration = 0; iteration < iterations; ++iteration){
+                Vector vector;
+                for (size_t index = 0; index < count; ++index){
+                    vector.emplace_back(make(iteration + index));
+                }
+                g_sink += vector.size() + static_cast<size_t>(vector.back().size());
+            }
+        });
+    }
+
+    /** Cross checks EFSmallVector against std::vector with a type that is not trivially relocatable. */
+    bool Validate(){
+        using namespace EventfulEngine;
+        EFSmallVector<EFString, 4> small;
+        std::vector<EFString> reference;
+        for (size_t step = 0; step < 64; ++step){
+            const EFString value = "Value_That_Does_Not_Fit_Into_SSO_" + std::to_string(step);
+            if (step % 5 == 3){
+                small.insert(small.begin() + step % small.size(), value);
+                reference.insert(reference.begin() + step % reference.size(), value);
+            }
+            else if (step % 7 == 6){
+                small.erase(small.begin() + 1, small.begin() + 3);
+                reference.erase(reference.begin() + 1, reference.begin() + 3);
+            }
+            else{
+                small.push_back(small.empty() ? value : small.front());
+                reference.push_back(reference.empty() ? value : reference.front());
+            }
+        }
+        EFSmallVector<EFString, 4> moved = std::move(small);
+        moved.resize(3);
+        moved.shrink_to_fit();
+        reference.resize(3);
+
+        EFInlineString<15> text = "short";
+        text += std::string_view{" and long enough to spill"};
+        const EFInlineString<15> copy = text;
+        return std::ranges::equal(moved, reference) && moved.is_inline() && small.empty() &&
+            copy == std::string_view{"short and long enough to spill"} && copy.c_str()[copy.size()] == '\0';
+    }
+}
+
+// Compares EFSmallVector and EFInlineString against std::vector and EFString for the short lived, small containers
+// they replace: tag lists, argument lists and short identifiers. Fails if small vectors are not faster by the
+// given factor.
+// Usage: small_vector_benchmark [--min-speedup=<factor>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double minSpeedup = 0.0;
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--min-speedup=")){
+            const std::string_view value = argument.substr(std::string_view{"--min-speedup="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), minSpeedup);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    if (!Validate()){
+        std::cerr << "EFSmallVector does not match std::vector\n";
+        return 1;
+    }
+
+    constexpr size_t iterations = 200'000;
+    const std::vector<EFString> words = {
+        "Gameplay.Damage.Fire", "Gameplay.Status.Burning", "r.ShadowQuality", "Engine.Render.Debug"
+    };
+    const auto makeWord = [&](const size_t index) -> std::string_view{ return words[index % words.size()]; };
+
+    double worstSpeedup = std::numeric_limits<double>::max();
+    std::cout << "Build and destroy, ns per container\n";
+    for (const size_t count : {1, 2, 4, 8}){
+        const double stdNs = MeasureBuild<std::vector<std::string_view>>(rounds, iterations, count, makeWord);
+        const double smallNs = MeasureBuild<EFSmallVector<std::string_view, 8>>(rounds, iterations, count, makeWord);
+        const double stdStringNs = MeasureBuild<std::vector<EFString>>(rounds, iterations, count, makeWord);
+        const double inlineNs = MeasureBuild<EFSmallVector<EFInlineString<31>, 8>>(rounds, iterations, count,
+                                                                                   makeWord);
+        worstSpeedup = std::min(worstSpeedup, stdNs / smallNs);
+        std::cout << "  " << count << " elements: std::vector " << stdNs << "ns, EFSmallVector " << smallNs
+            << "ns (" << stdNs / smallNs << "x), std::vector<EFString> " << stdStringNs
+            << "ns, EFSmallVector<EFInlineString> " << inlineNs << "ns (" << stdStringNs / inlineNs << "x)\n";
+    }
+
+    // Past the inline capacity both allocate, the small vector should not be slower than a plain vector
+    const double spillStdNs = MeasureBuild<std::vector<std::string_view>>(rounds, iterations, 32, makeWord);
+    const double spillSmallNs = MeasureBuild<EFSmallVector<std::string_view, 8>>(rounds, iterations, 32, makeWord);
+    std::cout << "  32 elements, spilled: std::vector " << spillStdNs << "ns, EFSmallVector " << spillSmallNs
+        << "ns (" << g_sink << ")\n";
+
+    if (minSpeedup > 0.0 && worstSpeedup < minSpeedup){
+        std::cerr << "EFSmallVector is only " << worstSpeedup << "x faster, expected " << minSpeedup << "x\n";
+        return 1;
+    }
+    return 0;
+}
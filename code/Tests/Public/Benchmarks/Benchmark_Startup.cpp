@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreGlobals.h"
+#include "EFStartupTrace.h"
+#include "FileSystem.h"
+#include "ModuleManager.h"
+
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+// Measures engine startup (static initializers plus module loading up to the Startup phase) and fails if it
+// exceeds the given budget. Usage: startup_benchmark [--budget-ms=<ms>] [--trace=<file.json>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double budgetMs = 0.0;
+    EFString tracePath;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--budget-ms=")){
+            const std::string_view value = argument.substr(std::string_view{"--budget-ms="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), budgetMs);
+        }
+        else if (argument.starts_with("--trace=")){
+            tracePath = argument.substr(std::string_view{"--trace="}.size());
+        }
+    }
+
+    ModuleManager& moduleManager = ModuleManager::Get();
+    bool success = true;
+    {
+        EF_STARTUP_TRACE_SCOPE("EngineLoop", "LoadModules");
+        moduleManager.RegisterModuleDescriptors(FileSystem::GetWorkingDirectory() / "Modules");
+        for (const auto phase : {E_ModuleLoadPhase::PreInit, E_ModuleLoadPhase::Core, E_ModuleLoadPhase::Startup}){
+            success &= moduleManager.LoadModules(phase);
+        }
+    }
+    EFStartupTrace::Finish();
+
+    std::cout << EFStartupTrace::BuildSummary();
+    if (!tracePath.empty() && !EFStartupTrace::WriteChromeTrace(tracePath)){
+        std::cerr << "Failed to write startup trace to " << tracePath << '\n';
+        success = false;
+    }
+
+    moduleManager.Shutdown();
+
+    const double totalMs = static_cast<double>(EFStartupTrace::GetTotalNs()) / 1'000'000.0;
+    if (budgetMs > 0.0 && totalMs > budgetMs){
+        std::cerr << "Startup took " << totalMs << "ms, budget is " << budgetMs << "ms\n";
+        return 1;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "EFText.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <limits>
+#include <string_view>
+
+namespace{
+    // Keeps the optimizer from dropping the formatted results
+    size_t g_formattedBytes = 0;
+
+    // Best calls per second over several rounds
+    template <typename Function>
+    double MeasureCallsPerSecond(const int32 rounds, const int32 callsPerRound,
+                                 Function&& function){
+        using namespace EventfulEngine;
+        double bestSeconds = std::numeric_limits<double>::max();
+        for (int32 round = 0; round < rounds; ++round){
+            const EFTimePoint start = EFClock::now();
+            for (int32 call = 0; call < callsPerRound; ++call){
+                function(call);
+            }
+            bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(EFClock::now() - start).count());
+        }
+        return callsPerRound / bestSeconds;
+    }
+}
+
+// Measures formatted calls per second of the EFText formatting paths and fails if the compile time checked
+// EFText::Format falls below the given rate.
+// Usage: text_benchmark [--min-calls-per-second=<n>] [--rounds=<n>]
+int main(const int argc, char** argv){
+    using namespace EventfulEngine;
+
+    double minCallsPerSecond = 0.0;
+    int32 rounds = 10;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--min-calls-per-second=")){
+            const std::string_view value = argument.substr(std::string_view{"--min-calls-per-second="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), minCallsPerSecond);
+        }
+        else if (argument.starts_with("--rounds=")){
+            const std::string_view value = argument.substr(std::string_view{"--rounds="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), rounds);
+        }
+    }
+
+    constexpr int32 callsPerRound = 200'000;
+    const EFString name = "EFCore";
+
+    const double runtimeRate = MeasureCallsPerSecond(rounds, callsPerRound, [&name](const int32 call){
+        g_formattedBytes += EFText::FormatRuntime("Loaded module '{}' in {:.3f}ms ({})", name, call * 0.25, call).
+            size();
+    });
+
+    const double formatRate = MeasureCallsPerSecond(rounds, callsPerRound, [&name](const int32 call){
+        g_formattedBytes += EFText::Format("Loaded module '{}' in {:.3f}ms ({})", name, call * 0.25, call).size();
+    });
+
+    EFString reused;
+    const double formatToStringRate = MeasureCallsPerSecond(rounds, callsPerRound, [&name, &reused](const int32 call){
+        reused.clear();
+        EFText::FormatTo(reused, "Loaded module '{}' in {:.3f}ms ({})", name, call * 0.25, call);
+        g_formattedBytes += reused.size();
+    });
+
+    std::array<char, 128> buffer{};
+    const double formatToBufferRate = MeasureCallsPerSecond(rounds, callsPerRound, [&name, &buffer](const int32 call){
+        g_formattedBytes += EFText::FormatTo(buffer, "Loaded module '{}' in {:.3f}ms ({})", name, call * 0.25, call).
+            size();
+    });
+
+    std::cout << "Text formatting (calls per second): FormatRuntime " << runtimeRate << ", Format " << formatRate
+        << ", FormatTo string " << formatToStringRate << ", FormatTo buffer " << formatToBufferRate << " ("
+        << g_formattedBytes << " bytes)\n";
+
+    if (minCallsPerSecond > 0.0 && formatRate < minCallsPerSecond){
+        std::cerr << "EFText::Format reached " << formatRate << " calls per second, minimum is " << minCallsPerSecond
+            << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace{
+    std::atomic<uint64_t> g_allocations = 0;
+}
+
+// Counts every heap allocation of the process, the benchmark reads the count around the recorded writes
+void* operator new(const std::size_t size){
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)){
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+namespace{
+    using namespace EventfulEngine;
+
+    struct Scene{
+        BufferHandle DrawConstants;
+        std::vector<BufferHandle> Buffers;
+        std::vector<TextureHandle> Textures;
+        std::vector<uint8> TextureData;
+    };
+
+    struct FrameResult{
+        uint64 Allocations = 0;
+        uint64 Writes = 0;
+        double Milliseconds = 0.0;
+    };
+
+    // Writes the constants of every draw to one volatile constant buffer, the way per draw constants are versioned,
+    // updates a few persistent buffers and streams in texture updates
+    FrameResult RenderFrame(EFDynamicRAPI* device, EFRAPICommandList* commandList, const Scene& scene,
+                            const int32 draws, const int32 frame){
+        float constants[64] = {};
+        const uint64 allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        const EFTimePoint start = EFClock::now();
+
+        FrameResult result;
+        commandList->Open();
+        for (int32 draw = 0; draw < draws; ++draw){
+            constants[0] = static_cast<float>(draw);
+            commandList->WriteBuffer(scene.DrawConstants, constants, sizeof(constants));
+            ++result.Writes;
+        }
+        for (const BufferHandle& buffer : scene.Buffers){
+            constants[1] = static_cast<float>(frame);
+            commandList->WriteBuffer(buffer, constants, sizeof(constants));
+            ++result.Writes;
+        }
+        for (const TextureHandle& texture : scene.Textures){
+            commandList->WriteTexture(texture, 0, 0, scene.TextureData.data(), texture->GetDesc().Width * 4);
+            ++result.Writes;
+        }
+        commandList->Close();
+        EFRAPICommandList* submitted = commandList;
+        device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+        device->RunGarbageCollection();
+
+        result.Milliseconds = std::chrono::duration<double, std::milli>(EFClock::now() - start).count();
+        result.Allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+        return result;
+    }
+}
+
+// Records per draw constant buffer writes, buffer updates and texture updates on the headless backend, which stages
+// all of them in the upload ring of the device. Reports the heap allocations per write, the bytes uploaded per frame
+// and the ring stalls. Fails if the frames after the first one allocate more per write on average than given.
+// Usage: upload_benchmark [--max-allocations-per-write=<n>] [--draws=<n>] [--textures=<n>] [--frames=<n>]
+int main(const int argc, char** argv){
+    double maxAllocationsPerWrite = -1.0;
+    int32 draws = 10'000;
+    int32 textures = 16;
+    int32 frames = 60;
+    for (int arg = 1; arg < argc; ++arg){
+        const std::string_view argument{argv[arg]};
+        if (argument.starts_with("--max-allocations-per-write=")){
+            const std::string_view value = argument.substr(std::string_view{"--max-allocations-per-write="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), maxAllocationsPerWrite);
+        }
+        else if (argument.starts_with("--draws=")){
+            const std::string_view value = argument.substr(std::string_view{"--draws="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), draws);
+        }
+        else if (argument.starts_with("--textures=")){
+            const std::string_view value = argument.substr(std::string_view{"--textures="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), textures);
+        }
+        else if (argument.starts_with("--frames=")){
+            const std::string_view value = argument.substr(std::string_view{"--frames="}.size());
+            std::from_chars(value.data(), value.data() + value.size(), frames);
+        }
+    }
+    frames = std::max(frames, 2);
+
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    Scene scene;
+    scene.DrawConstants = device->CreateBuffer(BufferDesc().SetByteSize(256).SetIsConstantBuffer(true).
+                                                            SetIsVolatile(true));
+    for (int32 index = 0; index < 32; ++index){
+        scene.Buffers.push_back(device->CreateBuffer(BufferDesc().SetByteSize(256)));
+    }
+    for (int32 index = 0; index < textures; ++index){
+        scene.Textures.push_back(device->CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).
+                                                                     SetFormat(E_Format::RGBA8_UNORM)));
+    }
+    scene.TextureData.resize(64 * 64 * 4);
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    std::vector<FrameResult> results;
+    for (int32 frame = 0; frame < frames; ++frame){
+        results.push_back(RenderFrame(device, commandList, scene, draws, frame));
+    }
+    const UploadManagerStats stats = headless->GetUploadManager()->GetStats();
+
+    uint64 allocations = 0;
+    uint64 writes = 0;
+    double milliseconds = 0.0;
+    for (size_t frame = 1; frame < results.size(); ++frame){
+        allocations += results[frame].Allocations;
+        writes += results[frame].Writes;
+        milliseconds += results[frame].Milliseconds;
+    }
+    const double allocationsPerWrite = static_cast<double>(allocations) / static_cast<double>(writes);
+    const double frameCount = static_cast<double>(results.size() - 1);
+
+    std::cout << "Uploads with " << draws << " constant buffer versions, " << scene.Buffers.size()
+        << " buffer and " << textures << " texture writes per frame, " << frames << " frames\n";
+    std::cout << "  first frame: " << results.front().Allocations << " allocations for "
+        << results.front().Writes << " writes\n";
+    std::cout << "  after: " << allocationsPerWrite << " allocations per write, " << milliseconds / frameCount
+        << " ms per frame\n";
+    std::cout << "  upload ring: " << stats.BytesUploadedLastFrame << " bytes in the last frame, "
+        << stats.BytesUploaded << " bytes total, " << stats.ChunksAllocated << " chunks, " << stats.RingStalls
+        << " ring stalls, " << stats.DedicatedChunks << " dedicated chunks\n";
+
+    if (maxAllocationsPerWrite >= 0.0 && allocationsPerWrite > maxAllocationsPerWrite){
+        std::cerr << "Writes allocate " << allocationsPerWrite << " times on average, expected at most "
+            << maxAllocationsPerWrite << "\n";
+        return 1;
+    }
+    return 0;
+}
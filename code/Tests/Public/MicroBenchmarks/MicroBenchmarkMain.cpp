@@ -0,0 +1,94 @@
+#pragma once
+
+#include "EFPerfCapture.h"
+#include "EFText.h"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include <iostream>
+
+namespace{
+    using namespace EventfulEngine;
+
+    // Mean time of every benchmark that ran, named "<test case>/<benchmark>.MeanNs"
+    EFPerfReport g_report;
+
+    /** Collects the benchmark results into an EFPerfReport, so they can be tracked like perf captures. */
+    class PerfReportListener final : public Catch::EventListenerBase{
+    public:
+        using EventListenerBase::EventListenerBase;
+
+        void testCaseStarting(const Catch::TestCaseInfo& testInfo) override{
+            _testCase = testInfo.name;
+        }
+
+        void benchmarkEnded(const Catch::BenchmarkStats& benchmarkStats) override{
+            const EFString name = EFText::Format("{}/{}", _testCase, benchmarkStats.info.name);
+            g_report.Metrics.push_back({name + ".MeanNs", benchmarkStats.mean.point.count()});
+            g_report.Metrics.push_back({name + ".StdDevNs", benchmarkStats.standardDeviation.point.count()});
+            g_report.FrameCount = std::max(g_report.FrameCount, static_cast<uint32>(benchmarkStats.samples.size()));
+        }
+
+    private:
+        EFString _testCase;
+    };
+
+    CATCH_REGISTER_LISTENER(PerfReportListener)
+}
+
+// Runs the Catch2 microbenchmarks of the engine. Besides the usual Catch2 options it writes the mean times as a perf
+// report and fails if any mean regressed against a baseline report by more than the threshold. The standard
+// deviations are stored for reference but never fail the run.
+// Usage: benchmarks [catch2 options] [--perf-report=<path>] [--perf-baseline=<path>] [--perf-threshold=<percent>]
+int main(const int argc, char** argv){
+    Catch::Session session;
+    std::string reportPath;
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+
+    using namespace Catch::Clara;
+    session.cli(session.cli()
+        | Opt(reportPath, "path")["--perf-report"]("write the benchmark means to a JSON or CSV perf report")
+        | Opt(baselinePath, "path")["--perf-baseline"]("perf report to compare the benchmark means against")
+        | Opt(thresholdPercent, "percent")["--perf-threshold"]("allowed regression against the baseline"));
+    if (const int result = session.applyCommandLine(argc, argv); result != 0){
+        return result;
+    }
+
+    if (const int result = session.run(); result != 0){
+        return result;
+    }
+
+    if (!reportPath.empty() && !g_report.Save(reportPath)){
+        std::cerr << "Could not write the benchmark report to " << reportPath << "\n";
+        return 1;
+    }
+
+    if (baselinePath.empty()){
+        return 0;
+    }
+    const std::optional<EFPerfReport> baseline = EFPerfReport::Load(baselinePath);
+    if (!baseline){
+        std::cerr << "Could not read the benchmark baseline " << baselinePath << "\n";
+        return 1;
+    }
+    bool success = true;
+    for (const EFPerfMetricDifference& difference : ComparePerfReports(*baseline, g_report, thresholdPercent)){
+        if (!difference.Name.ends_with(".MeanNs")){
+            continue;
+        }
+        if (difference.bIsRegression){
+            std::cerr << difference.Name << " regressed by " << difference.ChangePercent << "%, "
+                << *difference.Baseline << "ns -> " << *difference.Current << "ns\n";
+            success = false;
+        }
+        // Not a failure, a test spec may have filtered the benchmark out
+        else if (difference.IsRemoved()){
+            std::cerr << difference.Name << " is in the baseline but did not run\n";
+        }
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "EfMemory.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+using namespace EventfulEngine;
+
+TEST_CASE("EFAllocator", "[benchmark][memory]"){
+    BENCHMARK("Allocate and free 64 bytes"){
+        const EFMemoryHandle memory = EFAllocator::Allocate(64);
+        EFAllocator::Free(memory);
+        return memory.ptr;
+    };
+
+    BENCHMARK("Allocate and free 64 bytes with category"){
+        const EFMemoryHandle memory = EFAllocator::Allocate(64, "Benchmark");
+        EFAllocator::Free(memory);
+        return memory.ptr;
+    };
+
+    // Many live allocations, as in a running game, make the bookkeeping maps deeper
+    std::array<EFMemoryHandle, 256> live{};
+    BENCHMARK("Allocate and free 256 live allocations"){
+        for (size_t index = 0; index < live.size(); ++index){
+            live[index] = EFAllocator::Allocate(16 + index);
+        }
+        for (const EFMemoryHandle memory : live){
+            EFAllocator::Free(memory);
+        }
+        return live[0].ptr;
+    };
+
+    BENCHMARK("Allocate raw 64 bytes"){
+        const EFMemoryHandle memory = EFAllocator::AllocateRaw(64);
+        std::free(memory.ptr);
+        return memory.ptr;
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "EFText.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace EventfulEngine;
+
+TEST_CASE("BitSetAllocator", "[benchmark][renderapi]"){
+    // Descriptor heap, bindless table and query pool sized
+    for (const int capacity : {1 << 10, 1 << 16, 1 << 20}){
+        BitSetAllocator allocator{static_cast<size_t>(capacity), true};
+
+        BENCHMARK(EFText::Format("Fill and release {} slots", capacity)){
+            int last = -1;
+            for (int slot = 0; slot < capacity; ++slot){
+                last = allocator.Allocate();
+            }
+            for (int slot = 0; slot < capacity; ++slot){
+                allocator.Release(slot);
+            }
+            return last;
+        };
+
+        // Full, the search for the one released slot at the end has to skip every full word before it
+        for (int slot = 0; slot < capacity; ++slot){
+            allocator.Allocate();
+        }
+        BENCHMARK(EFText::Format("Release and allocate the last of {} slots when full", capacity)){
+            allocator.Release(capacity - 1);
+            return allocator.Allocate();
+        };
+        REQUIRE(allocator.Allocate() == -1);
+
+        // Half full, every thread keeps allocating and releasing a small batch of its own
+        for (int slot = 0; slot < capacity; slot += 2){
+            allocator.Release(slot);
+        }
+        const int threads = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 2u, 8u));
+        constexpr int batch = 64;
+        constexpr int rounds = 64;
+        BENCHMARK(EFText::Format("{} threads allocate and release {} slots each of {} slots", threads,
+                                 batch * rounds, capacity)){
+            std::vector<std::thread> workers;
+            for (int thread = 0; thread < threads; ++thread){
+                workers.emplace_back([&allocator]{
+                    int slots[batch];
+                    for (int round = 0; round < rounds; ++round){
+                        for (int& slot : slots){
+                            slot = allocator.Allocate();
+                        }
+                        for (const int slot : slots){
+                            allocator.Release(slot);
+                        }
+                    }
+                });
+            }
+            for (std::thread& worker : workers){
+                worker.join();
+            }
+            return threads;
+        };
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <functional>
+
+using namespace EventfulEngine;
+
+namespace{
+    struct Receiver{
+        int64 Value{0};
+
+        void Add(const int64 amount){ Value += amount; }
+    };
+}
+
+TEST_CASE("Delegates", "[benchmark][events]"){
+    Receiver receiver;
+
+    Delegate<void(int64)> delegate;
+    delegate.Bind<&Receiver::Add>(&receiver);
+    BENCHMARK("Delegate invoke"){
+        delegate.Invoke(1);
+        return receiver.Value;
+    };
+
+    // Reference for the delegate
+    const std::function<void(int64)> function = [&receiver](const int64 amount){ receiver.Add(amount); };
+    BENCHMARK("std::function invoke"){
+        function(1);
+        return receiver.Value;
+    };
+
+    std::array<Receiver, 8> receivers{};
+    MulticastDelegate<void(int64)> multicast;
+    for (Receiver& listener : receivers){
+        multicast.Bind<&Receiver::Add>(&listener);
+    }
+    BENCHMARK("MulticastDelegate invoke 8 listeners"){
+        multicast.Invoke(1);
+        return receivers[0].Value;
+    };
+
+    BENCHMARK("MulticastDelegate bind and unbind"){
+        multicast.Bind<&Receiver::Add>(&receiver);
+        multicast.Unbind<Receiver, &Receiver::Add>(&receiver);
+        return multicast.IsBound();
+    };
+}
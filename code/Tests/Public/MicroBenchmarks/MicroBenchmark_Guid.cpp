@@ -0,0 +1,32 @@
+#pragma once
+
+#include "EFGUID.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EventfulEngine;
+
+TEST_CASE("EFGUID", "[benchmark][guid]"){
+    BENCHMARK("NewGuid"){
+        return NewGuid();
+    };
+
+    const EFGUID guid = NewGuid();
+    BENCHMARK("Format ToChars"){
+        std::array<char, EFGUID::StringLength> text{};
+        guid.ToChars(text);
+        return text;
+    };
+
+    BENCHMARK("Format String"){
+        return guid.String();
+    };
+
+    const EFString text = guid.String();
+    BENCHMARK("Parse"){
+        return EFGUID{text};
+    };
+
+    REQUIRE(EFGUID{text} == guid);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "IniConfigFile.h"
+#include "EFText.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+
+using namespace EventfulEngine;
+
+TEST_CASE("IniConfigFile", "[benchmark][config]"){
+    // About the size of the engine and game configs together
+    IniFile source;
+    for (int32 section = 0; section < 16; ++section){
+        IniSection& entries = source[EFText::Format("Section{}", section)];
+        for (int32 key = 0; key < 16; ++key){
+            entries.insert_or_assign(EFText::Format("Key{}", key), EFText::Format("Value {} of {}", key, section));
+        }
+    }
+    const EFPath path = std::filesystem::temp_directory_path() / "EventfulBenchmark.ini";
+    REQUIRE(IniConfigFile::Save(path, source));
+
+    BENCHMARK("Load 16 sections of 16 keys"){
+        IniFile loaded;
+        IniConfigFile::Load(path, loaded);
+        return loaded.size();
+    };
+
+    IniFile loaded;
+    REQUIRE(IniConfigFile::Load(path, loaded));
+    REQUIRE(loaded == source);
+    std::filesystem::remove(path);
+}
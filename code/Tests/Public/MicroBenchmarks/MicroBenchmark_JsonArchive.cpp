@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EFText.h"
+#include "JsonArchive.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+
+using namespace EventfulEngine;
+
+TEST_CASE("JsonArchive", "[benchmark][serialization]"){
+    const EFName health{"Health"};
+    const EFName speed{"Speed"};
+    const EFName displayName{"DisplayName"};
+    const EFName bIsVisible{"bIsVisible"};
+
+    BENCHMARK("Round trip four fields"){
+        JsonArchive out;
+        out.Set(health, 100);
+        out.Set(speed, 4.5);
+        out.Set(displayName, EFString{"Block"});
+        out.Set(bIsVisible, true);
+
+        JsonArchive in;
+        in.Data() = nlohmann::json::parse(out.Data().dump());
+        int32 healthValue = 0;
+        double speedValue = 0.0;
+        EFString nameValue;
+        bool bIsVisibleValue = false;
+        return in.Get(health, healthValue) && in.Get(speed, speedValue) && in.Get(displayName, nameValue) &&
+               in.Get(bIsVisible, bIsVisibleValue);
+    };
+
+    // A saved level, a few hundred objects of a few fields each
+    JsonArchive level;
+    for (int32 index = 0; index < 256; ++index){
+        level.Data()["Objects"].push_back({
+            {"Name", EFText::Format("Block{}", index)}, {"Position", {index, 0.5 * index, -index}}, {"bIsStatic", true}
+        });
+    }
+    const EFPath path = std::filesystem::temp_directory_path() / "EventfulBenchmark.json";
+    BENCHMARK("Save and load 256 objects"){
+        level.Save(path);
+        JsonArchive loaded;
+        loaded.Load(path);
+        return loaded.Data().size();
+    };
+
+    JsonArchive loaded;
+    REQUIRE(loaded.Load(path));
+    REQUIRE(loaded.Data() == level.Data());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EFReflectionManager.h"
+#include "EFText.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EventfulEngine;
+
+namespace{
+    template <size_t Index>
+    struct ReflectedType{
+    };
+
+    template <size_t Index>
+    void RegisterType(){
+        EFClassPtr efClass = std::make_shared<EFClass>();
+        efClass->Name = EFName{EFText::Format("BenchmarkClass{}", Index)};
+        efClass->Hash = typeid(ReflectedType<Index>).hash_code();
+        efClass->ClassType = typeid(ReflectedType<Index>);
+        EFReflectionManager::Get().RegisterClass(efClass);
+    }
+
+    template <size_t... Indices>
+    void RegisterTypes(std::index_sequence<Indices...>){
+        (RegisterType<Indices>(), ...);
+    }
+}
+
+TEST_CASE("EFReflectionManager", "[benchmark][reflection]"){
+    // A game registers a few hundred classes, lookups should not depend on that
+    static const bool bIsRegistered = (RegisterTypes(std::make_index_sequence<256>{}), true);
+    REQUIRE(bIsRegistered);
+
+    EFReflectionManager& manager = EFReflectionManager::Get();
+    REQUIRE(manager.GetClass(EFName{"BenchmarkClass128"}));
+
+    BENCHMARK("GetClass by hash"){
+        return manager.GetClass(typeid(ReflectedType<128>).hash_code());
+    };
+
+    const EFName name{"BenchmarkClass128"};
+    BENCHMARK("GetClass by name"){
+        return manager.GetClass(name);
+    };
+
+    BENCHMARK("GetClass by type"){
+        return manager.GetClass(std::type_index{typeid(ReflectedType<128>)});
+    };
+
+    BENCHMARK("GetClass of missing name"){
+        return manager.GetClass(EFName{"NotAClass"});
+    };
+}
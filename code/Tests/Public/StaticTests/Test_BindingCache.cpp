@@ -0,0 +1,117 @@
+#pragma once
+
+#include "EFRAPIBindingCache.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EventfulEngine;
+
+namespace{
+    BufferHandle CreateConstantBuffer(EFDynamicRAPI* device){
+        return device->CreateBuffer(BufferDesc().SetByteSize(256).SetIsConstantBuffer(true));
+    }
+
+    BindingSetDesc CreateSetDesc(EFRAPIBuffer* buffer, const uint32 arrayElement = 0){
+        return BindingSetDesc().addItem(BindingSetItem::ConstantBuffer(0, buffer).setArrayElement(arrayElement));
+    }
+
+    void EndFrames(EFRAPIBindingCache& cache, const int32 frames){
+        for (int32 frame = 0; frame < frames; ++frame){
+            cache.EndFrame();
+        }
+    }
+}
+
+TEST_CASE("Binding cache reuses layouts and sets of equal descriptions", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIBindingCache cache(device);
+    const BufferHandle buffer = CreateConstantBuffer(device);
+    const BufferHandle otherBuffer = CreateConstantBuffer(device);
+
+    BindingLayoutHandle layout;
+    BindingSetHandle set;
+    REQUIRE(cache.GetBindingSetAndLayout(F_ShaderType::All, 0, CreateSetDesc(buffer), layout, set));
+    REQUIRE(cache.GetBindingLayout(F_ShaderType::All, 0, CreateSetDesc(otherBuffer)) == layout);
+
+    // Sets of earlier frames are reused as well
+    cache.EndFrame();
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer), layout) == set);
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(otherBuffer), layout) != set);
+
+    // The layout takes part in the key
+    const BindingLayoutHandle otherLayout = cache.GetBindingLayout(F_ShaderType::Pixel, 0, CreateSetDesc(buffer));
+    REQUIRE(otherLayout != layout);
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer), otherLayout) != set);
+
+    const BindingCacheStats stats = cache.GetStats();
+    REQUIRE(stats.LayoutCreations == 2);
+    REQUIRE(stats.LayoutHits == 1);
+    REQUIRE(stats.SetCreations == 3);
+    REQUIRE(stats.SetHits == 1);
+    REQUIRE(cache.GetBindingSetCount() == 3);
+}
+
+TEST_CASE("Binding cache keeps sets that differ only in their array element apart", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIBindingCache cache(device);
+    const BufferHandle buffer = CreateConstantBuffer(device);
+    const BindingLayoutHandle layout = cache.GetBindingLayout(F_ShaderType::All, 0, CreateSetDesc(buffer));
+
+    const BindingSetHandle first = cache.GetBindingSet(CreateSetDesc(buffer, 0), layout);
+    const BindingSetHandle second = cache.GetBindingSet(CreateSetDesc(buffer, 1), layout);
+    REQUIRE(first != second);
+    REQUIRE(first->getDesc()->bindings[0].arrayElement == 0);
+    REQUIRE(second->getDesc()->bindings[0].arrayElement == 1);
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer, 1), layout) == second);
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer, 0), layout) == first);
+    REQUIRE(cache.GetBindingSetCount() == 2);
+}
+
+TEST_CASE("Binding cache retires unused sets once their frame completed", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    constexpr uint32 RETIRE_AFTER_FRAMES = 2;
+    EFRAPIBindingCache cache(device, RETIRE_AFTER_FRAMES);
+    const BufferHandle buffer = CreateConstantBuffer(device);
+    const BufferHandle otherBuffer = CreateConstantBuffer(device);
+    const BindingLayoutHandle layout = cache.GetBindingLayout(F_ShaderType::All, 0, CreateSetDesc(buffer));
+
+    // Used in frame 0 only, the set survives until RETIRE_AFTER_FRAMES frames passed after it
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer), layout));
+    EndFrames(cache, RETIRE_AFTER_FRAMES);
+    REQUIRE(cache.GetBindingSetCount() == 1);
+    cache.EndFrame();
+    REQUIRE(cache.GetBindingSetCount() == 0);
+    REQUIRE(cache.GetStats().SetsRetired == 1);
+
+    // Sets used every frame are never retired
+    const BindingSetHandle kept = cache.GetBindingSet(CreateSetDesc(otherBuffer), layout);
+    for (int32 frame = 0; frame < 5; ++frame){
+        REQUIRE(cache.GetBindingSet(CreateSetDesc(otherBuffer), layout) == kept);
+        cache.EndFrame();
+    }
+    REQUIRE(cache.GetBindingSetCount() == 1);
+}
+
+TEST_CASE("Binding cache keeps sets while the GPU has not completed their frame", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    EFRAPIBindingCache cache(device, 1);
+    const BufferHandle buffer = CreateConstantBuffer(device);
+    const BindingLayoutHandle layout = cache.GetBindingLayout(F_ShaderType::All, 0, CreateSetDesc(buffer));
+    const BindingSetHandle set = cache.GetBindingSet(CreateSetDesc(buffer), layout);
+
+    // Far more frames than retireAfterFrames, but none of their fences signaled
+    headless->SetEventQueriesSignaled(false);
+    EndFrames(cache, 8);
+    REQUIRE(cache.GetBindingSetCount() == 1);
+    REQUIRE(cache.GetBindingSet(CreateSetDesc(buffer), layout) == set);
+
+    // Used again in the last frame, that frame has to complete and age as well
+    headless->SetEventQueriesSignaled(true);
+    cache.EndFrame();
+    REQUIRE(cache.GetBindingSetCount() == 1);
+    cache.EndFrame();
+    REQUIRE(cache.GetBindingSetCount() == 0);
+    REQUIRE(cache.GetStats().SetsRetired == 1);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "EFDynamicRAPI.h"
+#include "Thread.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    // Allocates until the allocator is full, every slot below the capacity has to come out exactly once
+    void RequireAllocatesEverySlot(BitSetAllocator& allocator){
+        std::vector<bool> isAllocated(allocator.GetCapacity());
+        for (size_t count = 0; count < allocator.GetCapacity(); ++count){
+            const int slot = allocator.Allocate();
+            REQUIRE(slot >= 0);
+            REQUIRE(static_cast<size_t>(slot) < allocator.GetCapacity());
+            REQUIRE_FALSE(isAllocated[slot]);
+            isAllocated[slot] = true;
+        }
+        REQUIRE(allocator.Allocate() == -1);
+    }
+}
+
+TEST_CASE("Bit set allocator hands out every slot of odd capacities", "[renderapi]"){
+    for (const size_t capacity : {0, 1, 2, 63, 64, 65, 127, 4095, 4096, 4097, 70000}){
+        BitSetAllocator allocator(capacity, false);
+        REQUIRE(allocator.GetCapacity() == capacity);
+        RequireAllocatesEverySlot(allocator);
+    }
+}
+
+TEST_CASE("Bit set allocator recovers from full after a release", "[renderapi]"){
+    for (const size_t capacity : {1, 65, 4097}){
+        BitSetAllocator allocator(capacity, false);
+        RequireAllocatesEverySlot(allocator);
+
+        // Each released slot is the only free one and comes back on the next allocation
+        for (const size_t slot : {capacity - 1, size_t{0}, capacity / 2}){
+            allocator.Release(static_cast<int>(slot));
+            REQUIRE(allocator.Allocate() == static_cast<int>(slot));
+            REQUIRE(allocator.Allocate() == -1);
+        }
+
+        // Slots outside the allocator are ignored
+        allocator.Release(-1);
+        allocator.Release(static_cast<int>(capacity));
+        REQUIRE(allocator.Allocate() == -1);
+
+        if (capacity == 1){
+            continue;
+        }
+        // The lowest free slot is found again once several words have room
+        allocator.Release(static_cast<int>(capacity - 1));
+        allocator.Release(0);
+        REQUIRE(allocator.Allocate() == 0);
+        REQUIRE(allocator.Allocate() == static_cast<int>(capacity - 1));
+    }
+}
+
+TEST_CASE("Bit set allocator never hands out a slot twice across threads", "[renderapi]"){
+    constexpr size_t CAPACITY = 64 * 64 + 17;
+    constexpr int32 THREADS = 4;
+    constexpr int32 ROUNDS = 500;
+    constexpr int32 HELD_SLOTS = 400;
+
+    BitSetAllocator allocator(CAPACITY, true);
+    const auto owners = std::make_unique<std::atomic<int32>[]>(CAPACITY);
+    std::atomic<int32> doubleAllocations = 0;
+    std::atomic<int32> failedAllocations = 0;
+
+    // Together the threads hold fewer slots than the capacity, so an allocation only fails if a slot was lost
+    std::vector<Thread> threads;
+    for (int32 thread = 0; thread < THREADS; ++thread){
+        threads.emplace_back([&, thread]{
+            std::vector<int> held;
+            for (int32 round = 0; round < ROUNDS; ++round){
+                while (held.size() < HELD_SLOTS){
+                    const int slot = allocator.Allocate();
+                    if (slot < 0){
+                        ++failedAllocations;
+                        break;
+                    }
+                    int32 expected = 0;
+                    if (!owners[slot].compare_exchange_strong(expected, thread + 1)){
+                        ++doubleAllocations;
+                    }
+                    held.push_back(slot);
+                }
+                // Release every other slot so the words keep filling up and draining
+                for (size_t index = round % 2; index < held.size(); index += 2){
+                    owners[held[index]].store(0);
+                    allocator.Release(held[index]);
+                    held[index] = -1;
+                }
+                std::erase(held, -1);
+            }
+            for (const int slot : held){
+                owners[slot].store(0);
+                allocator.Release(slot);
+            }
+        });
+    }
+    for (Thread& thread : threads){
+        thread.Join();
+    }
+
+    REQUIRE(doubleAllocations == 0);
+    REQUIRE(failedAllocations == 0);
+    RequireAllocatesEverySlot(allocator);
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    constexpr uint32 TEXTURE_SIZE = 8;
+
+    TextureHandle CreateColorTexture(EFDynamicRAPI* device, const uint32 size = TEXTURE_SIZE){
+        return device->CreateTexture(TextureDesc().SetWidth(size).SetHeight(size).SetFormat(E_Format::R32_UINT).
+                                                   SetIsRenderTarget(true));
+    }
+
+    // Records the commands into a fresh list and runs it
+    void Submit(EFDynamicRAPI* device, const std::function<void(EFRAPICommandList*)>& record){
+        const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+        commandList->Open();
+        record(commandList);
+        commandList->Close();
+        EFRAPICommandList* submitted = commandList;
+        device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    }
+
+    uint64 GetBytesCopied(EFDynamicRAPI* device){
+        return static_cast<EFHeadlessRAPI*>(device)->GetStats().BytesCopied;
+    }
+
+    uint32 ReadTexel(const TextureHandle& texture, const uint32 x, const uint32 y){
+        const auto* headless = static_cast<HeadlessTexture*>(texture.Get());
+        const HeadlessTextureLayout::Subresource& subresource = headless->Layout.Get(0, 0);
+        uint32 value;
+        std::memcpy(&value, headless->Data + subresource.Offset + y * subresource.RowPitch + x * sizeof(uint32),
+                    sizeof(value));
+        return value;
+    }
+
+    // Every texel holds its own index
+    std::vector<uint32> MakeTexels(const uint32 size = TEXTURE_SIZE){
+        std::vector<uint32> texels(size * size);
+        for (uint32 index = 0; index < texels.size(); ++index){
+            texels[index] = index + 1;
+        }
+        return texels;
+    }
+}
+
+TEST_CASE("Buffers written by a command list read back through a map", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(64).
+                                                                 SetCpuAccess(E_CpuAccessMode::Read));
+    const BufferHandle copy = device->CreateBuffer(BufferDesc().SetByteSize(64).
+                                                               SetCpuAccess(E_CpuAccessMode::Read));
+    const std::vector<uint32> data{1, 2, 3, 4};
+
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->ClearBufferUInt(buffer, 0xABABABAB);
+        commandList->WriteBuffer(buffer, data.data(), data.size() * sizeof(uint32), 16);
+        commandList->CopyBuffer(copy, 0, buffer, 12, 24);
+    });
+
+    const auto* mapped = static_cast<const uint32*>(device->MapBuffer(buffer, E_CpuAccessMode::Read));
+    REQUIRE(mapped);
+    REQUIRE(mapped[0] == 0xABABABAB);
+    REQUIRE(mapped[3] == 0xABABABAB);
+    REQUIRE(std::memcmp(mapped + 4, data.data(), data.size() * sizeof(uint32)) == 0);
+    REQUIRE(mapped[8] == 0xABABABAB);
+    device->UnmapBuffer(buffer);
+
+    const auto* copied = static_cast<const uint32*>(device->MapBuffer(copy, E_CpuAccessMode::Read));
+    REQUIRE(copied[0] == 0xABABABAB);
+    REQUIRE(copied[1] == 1);
+    REQUIRE(copied[4] == 4);
+    REQUIRE(copied[5] == 0xABABABAB);
+    device->UnmapBuffer(copy);
+}
+
+TEST_CASE("Textures written by a command list read back through a staging texture", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle texture = CreateColorTexture(device);
+    const StagingTextureHandle staging = device->CreateStagingTexture(texture->GetDesc(), E_CpuAccessMode::Read);
+    const std::vector<uint32> texels = MakeTexels();
+
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->WriteTexture(texture, 0, 0, texels.data(), TEXTURE_SIZE * sizeof(uint32));
+        commandList->CopyTexture(staging, TextureSlice(), texture, TextureSlice());
+    });
+
+    size_t rowPitch = 0;
+    const auto* mapped = static_cast<const uint8*>(device->MapStagingTexture(staging, TextureSlice(),
+                                                                             E_CpuAccessMode::Read, &rowPitch));
+    REQUIRE(mapped);
+    for (uint32 y = 0; y < TEXTURE_SIZE; ++y){
+        REQUIRE(std::memcmp(mapped + y * rowPitch, texels.data() + y * TEXTURE_SIZE,
+                            TEXTURE_SIZE * sizeof(uint32)) == 0);
+    }
+    device->UnmapStagingTexture(staging);
+    REQUIRE(GetBytesCopied(device) == texels.size() * sizeof(uint32));
+}
+
+TEST_CASE("Partial texture copies only touch their region", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle source = CreateColorTexture(device);
+    const TextureHandle dest = CreateColorTexture(device);
+    const std::vector<uint32> texels = MakeTexels();
+
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->WriteTexture(source, 0, 0, texels.data(), TEXTURE_SIZE * sizeof(uint32));
+        commandList->ClearTextureUInt(dest, AllSubresources, 0);
+        commandList->CopyTexture(dest, TextureSlice().SetOrigin(4, 5).SetWidth(2).SetHeight(2), source,
+                                 TextureSlice().SetOrigin(1, 2).SetWidth(2).SetHeight(2));
+    });
+
+    for (uint32 y = 0; y < TEXTURE_SIZE; ++y){
+        for (uint32 x = 0; x < TEXTURE_SIZE; ++x){
+            const bool bIsInRegion = x >= 4 && x < 6 && y >= 5 && y < 7;
+            const uint32 expected = bIsInRegion ? texels[(y - 3) * TEXTURE_SIZE + x - 3] : 0;
+            REQUIRE(ReadTexel(dest, x, y) == expected);
+        }
+    }
+    REQUIRE(GetBytesCopied(device) == 4 * sizeof(uint32));
+}
+
+TEST_CASE("Texture copies are clipped to both textures", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle source = CreateColorTexture(device, TEXTURE_SIZE / 2);
+    const TextureHandle dest = CreateColorTexture(device);
+    const std::vector<uint32> texels = MakeTexels(TEXTURE_SIZE / 2);
+
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->WriteTexture(source, 0, 0, texels.data(), TEXTURE_SIZE / 2 * sizeof(uint32));
+        commandList->ClearTextureUInt(dest, AllSubresources, 0);
+        // The region runs past the smaller source and past the destination
+        commandList->CopyTexture(dest, TextureSlice().SetOrigin(6, 0).SetWidth(8).SetHeight(8), source,
+                                 TextureSlice().SetOrigin(1, 1).SetWidth(8).SetHeight(8));
+    });
+    // Source columns 1-2 land in destination columns 6-7, source rows 1-3 in destination rows 0-2
+    for (uint32 y = 0; y < TEXTURE_SIZE; ++y){
+        for (uint32 x = 0; x < TEXTURE_SIZE; ++x){
+            const bool bIsInRegion = x >= 6 && y < 3;
+            const uint32 expected = bIsInRegion ? texels[(y + 1) * (TEXTURE_SIZE / 2) + x - 5] : 0;
+            REQUIRE(ReadTexel(dest, x, y) == expected);
+        }
+    }
+    REQUIRE(GetBytesCopied(device) == 6 * sizeof(uint32));
+
+    // Origins outside either texture and missing subresources copy nothing
+    static_cast<EFHeadlessRAPI*>(device.Get())->ResetStats();
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->CopyTexture(dest, TextureSlice().SetOrigin(TEXTURE_SIZE, 0), source, TextureSlice());
+        commandList->CopyTexture(dest, TextureSlice(), source, TextureSlice().SetOrigin(0, TEXTURE_SIZE));
+        commandList->CopyTexture(dest, TextureSlice().SetArraySlice(3), source, TextureSlice());
+        commandList->WriteTexture(dest, 3, 0, texels.data(), TEXTURE_SIZE / 2 * sizeof(uint32));
+    });
+    REQUIRE(GetBytesCopied(device) == 0);
+    REQUIRE(ReadTexel(dest, 0, 0) == 0);
+}
+
+TEST_CASE("Texture clears fill the selected subresources", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle color = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4).SetMipLevels(2).
+                                                                    SetFormat(E_Format::RGBA8_UNORM).
+                                                                    SetIsRenderTarget(true));
+    const TextureHandle depth = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4).
+                                                                    SetFormat(E_Format::D32).SetIsRenderTarget(true));
+
+    Submit(device, [&](EFRAPICommandList* commandList){
+        commandList->ClearTextureFloat(color, AllSubresources, Color(0.f));
+        commandList->ClearTextureFloat(color, TextureSubresourceSet(1, 1, 0, 1), Color(1.f, 0.f, 0.f, 1.f));
+        commandList->ClearDepthStencilTexture(depth, AllSubresources, true, 0.5f, false, 0);
+    });
+
+    const auto* colorTexture = static_cast<HeadlessTexture*>(color.Get());
+    const uint8* topMip = colorTexture->Data + colorTexture->Layout.Get(0, 0).Offset;
+    const uint8* lowerMip = colorTexture->Data + colorTexture->Layout.Get(1, 0).Offset;
+    REQUIRE(topMip[0] == 0);
+    REQUIRE(topMip[3] == 0);
+    REQUIRE(lowerMip[0] == 255);
+    REQUIRE(lowerMip[1] == 0);
+    REQUIRE(lowerMip[3] == 255);
+
+    const auto* depthTexture = static_cast<HeadlessTexture*>(depth.Get());
+    float depthValue;
+    std::memcpy(&depthValue, depthTexture->Data + depthTexture->Layout.Get(0, 0).RowPitch, sizeof(depthValue));
+    REQUIRE(depthValue == 0.5f);
+}
+
+TEST_CASE("Timer queries resolve when their command list executes", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TimerQueryHandle query = device->CreateTimerQuery();
+    REQUIRE_FALSE(device->PollTimerQuery(query));
+    REQUIRE(device->GetTimerQueryTime(query) == 0.f);
+
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+    commandList->Open();
+    commandList->BeginTimerQuery(query);
+    commandList->EndTimerQuery(query);
+    commandList->Close();
+    // Recording alone resolves nothing
+    REQUIRE_FALSE(device->PollTimerQuery(query));
+
+    EFRAPICommandList* submitted = commandList;
+    device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    REQUIRE(device->PollTimerQuery(query));
+    REQUIRE(device->GetTimerQueryTime(query) >= 0.f);
+
+    device->ResetTimerQuery(query);
+    REQUIRE_FALSE(device->PollTimerQuery(query));
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "EFGUID.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <format>
+#include <unordered_set>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    constexpr std::string_view CANONICAL = "0123abcd-4567-89ef-fedc-ba9876543210";
+
+    constexpr std::array<unsigned char, 16> CANONICAL_BYTES{
+        0x01, 0x23, 0xab, 0xcd, 0x45, 0x67, 0x89, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10
+    };
+}
+
+TEST_CASE("GUID converts to and from its canonical string", "[core]"){
+    const EFGUID guid{CANONICAL};
+    REQUIRE(guid.IsValid());
+    REQUIRE(guid.Bytes() == CANONICAL_BYTES);
+    REQUIRE(guid.String() == CANONICAL);
+    REQUIRE(EFGUID{CANONICAL_BYTES}.String() == CANONICAL);
+
+    std::array<char, EFGUID::StringLength> chars{};
+    guid.ToChars(chars);
+    REQUIRE(std::string_view{chars.data(), chars.size()} == CANONICAL);
+
+    // Every byte value encodes to its two lower case digits
+    for (uint32 value = 0; value < 256; value += 15){
+        std::array<unsigned char, 16> bytes{};
+        bytes.fill(static_cast<unsigned char>(value));
+        const EFString text = EFGUID{bytes}.String();
+        REQUIRE(EFGUID{text}.Bytes() == bytes);
+        REQUIRE(text.substr(0, 2) == std::format("{:02x}", value));
+    }
+}
+
+TEST_CASE("GUID parses upper case digits and dashes in any place", "[core]"){
+    REQUIRE(EFGUID{"0123ABCD-4567-89EF-FEDC-BA9876543210"}.Bytes() == CANONICAL_BYTES);
+    REQUIRE(EFGUID{"0123abcd456789effedcba9876543210"}.Bytes() == CANONICAL_BYTES);
+    REQUIRE(EFGUID{"01-23abcd4567-89effedcba98765432-10"}.Bytes() == CANONICAL_BYTES);
+    REQUIRE(EFGUID{"-0123abcd456789effedcba9876543210-"}.Bytes() == CANONICAL_BYTES);
+}
+
+TEST_CASE("GUID parsing rejects malformed strings", "[core]"){
+    REQUIRE_FALSE(EFGUID{""}.IsValid());
+    REQUIRE_FALSE(EFGUID{"0123abcd-4567-89ef-fedc-ba987654321"}.IsValid());
+    REQUIRE_FALSE(EFGUID{"0123abcd-4567-89ef-fedc-ba98765432100"}.IsValid());
+    REQUIRE_FALSE(EFGUID{"0123abcd456789effedcba987654321"}.IsValid());
+
+    // Characters next to the digit and letter ranges, in every position of both fast paths and the slow one
+    for (const char invalid : {'/', ':', '@', 'G', '`', 'g', ' ', '\x80'}){
+        for (size_t digit = 0; digit < 32; ++digit){
+            EFString plain{"0123abcd456789effedcba9876543210"};
+            plain[digit] = invalid;
+            REQUIRE_FALSE(EFGUID{plain}.IsValid());
+
+            EFString canonical{CANONICAL};
+            const size_t position = digit + (digit >= 8) + (digit >= 12) + (digit >= 16) + (digit >= 20);
+            canonical[position] = invalid;
+            REQUIRE_FALSE(EFGUID{canonical}.IsValid());
+
+            REQUIRE_FALSE(EFGUID{"-" + plain}.IsValid());
+        }
+    }
+}
+
+TEST_CASE("New GUIDs are unique random version 4 GUIDs", "[core]"){
+    std::vector<EFGUID> guids(5000);
+    NewGuids(guids);
+    for (int32 index = 0; index < 5000; ++index){
+        guids.push_back(NewGuid());
+    }
+
+    std::unordered_set<EFGUID> unique;
+    for (const EFGUID& guid : guids){
+        REQUIRE(guid.IsValid());
+        REQUIRE((guid.Bytes()[6] & 0xF0) == 0x40);
+        REQUIRE((guid.Bytes()[8] & 0xC0) == 0x80);
+        REQUIRE(EFGUID{guid.String()} == guid);
+        unique.insert(guid);
+    }
+    REQUIRE(unique.size() == guids.size());
+}
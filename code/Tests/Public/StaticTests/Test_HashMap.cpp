@@ -0,0 +1,167 @@
+#pragma once
+
+#include "EFHashMap.h"
+#include "EFHashSet.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <iterator>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    // Every key lands in the same group with the same control byte, lookups have to compare every candidate
+    struct CollidingHash{
+        size_t operator()(int32) const{ return 42; }
+    };
+
+    // Matches the contents of the map against the reference, in both directions
+    template <typename Map, typename Reference>
+    void RequireSameContents(const Map& map, const Reference& reference){
+        REQUIRE(map.size() == reference.size());
+        size_t visited = 0;
+        for (const auto& [key, value] : map){
+            const auto found = reference.find(key);
+            REQUIRE(found != reference.end());
+            REQUIRE(found->second == value);
+            ++visited;
+        }
+        REQUIRE(visited == reference.size());
+        for (const auto& [key, value] : reference){
+            const auto found = map.find(key);
+            REQUIRE(found != map.end());
+            REQUIRE(found->second == value);
+        }
+    }
+
+    template <typename Map>
+    void RunRandomOperations(Map& map, const int32 keyRange, const int32 operations){
+        std::unordered_map<int32, int32> reference;
+        std::mt19937 random(1234);
+        std::uniform_int_distribution<int32> keys(0, keyRange - 1);
+        for (int32 operation = 0; operation < operations; ++operation){
+            const int32 key = keys(random);
+            switch (random() % 4){
+            case 0:
+                REQUIRE(map.erase(key) == reference.erase(key));
+                break;
+            case 1:
+                REQUIRE(map.try_emplace(key, operation).second == reference.try_emplace(key, operation).second);
+                break;
+            case 2:
+                map[key] = operation;
+                reference[key] = operation;
+                break;
+            default:
+                REQUIRE(map.contains(key) == reference.contains(key));
+                break;
+            }
+        }
+        RequireSameContents(map, reference);
+    }
+}
+
+TEST_CASE("Hash map matches std::unordered_map under random operations", "[core]"){
+    // Few keys keep the table busy with deleted slots, many keys make it grow
+    for (const int32 keyRange : {8, 100, 5000}){
+        EFHashMap<int32, int32> map;
+        RunRandomOperations(map, keyRange, 20000);
+    }
+}
+
+TEST_CASE("Hash map finds keys whose hashes all collide", "[core]"){
+    EFHashMap<int32, int32, CollidingHash> map;
+    RunRandomOperations(map, 40, 2000);
+
+    // More equal control bytes than a group holds
+    map.clear();
+    for (int32 key = 0; key < 50; ++key){
+        map[key] = key * 2;
+    }
+    for (int32 key = 0; key < 50; ++key){
+        REQUIRE(map.at(key) == key * 2);
+    }
+    REQUIRE_FALSE(map.contains(50));
+}
+
+TEST_CASE("Hash map looks up string keys without constructing them", "[core]"){
+    EFHashMap<EFString, int32> map{{"alpha", 1}, {"beta", 2}};
+    const std::string_view beta = "beta";
+    REQUIRE(map.contains(beta));
+    REQUIRE(map.at("alpha") == 1);
+    REQUIRE(map.find(std::string_view{"gamma"}) == map.end());
+    REQUIRE_THROWS_AS(map.at("gamma"), std::out_of_range);
+
+    map["gamma"] = 3;
+    REQUIRE(map.erase(beta) == 1);
+    REQUIRE(map.size() == 2);
+    REQUIRE_FALSE(map.contains("beta"));
+
+    // try_emplace only constructs the value when the key is missing
+    REQUIRE_FALSE(map.try_emplace("alpha", 10).second);
+    REQUIRE(map.at("alpha") == 1);
+    REQUIRE(map.insert_or_assign(EFString{"alpha"}, 10).second == false);
+    REQUIRE(map.at("alpha") == 10);
+}
+
+TEST_CASE("Hash map erases while iterating and keeps move only values", "[core]"){
+    EFHashMap<int32, std::unique_ptr<int32>> map;
+    for (int32 key = 0; key < 1000; ++key){
+        map.try_emplace(key, std::make_unique<int32>(key));
+    }
+    for (auto iterator = map.begin(); iterator != map.end();){
+        iterator = *iterator->second % 2 == 0 ? map.erase(iterator) : std::next(iterator);
+    }
+    REQUIRE(map.size() == 500);
+    for (const auto& [key, value] : map){
+        REQUIRE(key % 2 == 1);
+        REQUIRE(*value == key);
+    }
+
+    EFHashMap<int32, std::unique_ptr<int32>> moved = std::move(map);
+    REQUIRE(moved.size() == 500);
+    REQUIRE(map.empty());
+    REQUIRE(*moved.at(999) == 999);
+}
+
+TEST_CASE("Hash set copies, reserves and clears", "[core]"){
+    EFHashSet<int32> set;
+    set.reserve(100);
+    const size_t capacity = set.capacity();
+    for (int32 key = 0; key < 100; ++key){
+        REQUIRE(set.insert(key).second);
+    }
+    REQUIRE(set.capacity() == capacity);
+    REQUIRE_FALSE(set.insert(5).second);
+
+    EFHashSet<int32> copy = set;
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.capacity() == capacity);
+    REQUIRE_FALSE(set.contains(5));
+    REQUIRE(copy.size() == 100);
+    for (int32 key = 0; key < 100; ++key){
+        REQUIRE(copy.contains(key));
+    }
+}
+
+TEST_CASE("Hash table match masks visit every matching slot once", "[core]"){
+    // NEON masks use four bits per slot, only the top one of a matching slot is set
+    HashTableDetail::BitMask<4> mask{0x8000'0808ull};
+    std::vector<uint32> slots;
+    for (; mask; mask.ClearLowest()){
+        slots.push_back(mask.LowestIndex());
+    }
+    REQUIRE(slots == std::vector<uint32>{0, 2, 7});
+
+    HashTableDetail::BitMask<1> bits{0b1001'0001ull};
+    slots.clear();
+    for (; bits; bits.ClearLowest()){
+        slots.push_back(bits.LowestIndex());
+    }
+    REQUIRE(slots == std::vector<uint32>{0, 4, 7});
+}
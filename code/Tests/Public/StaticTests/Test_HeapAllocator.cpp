@@ -0,0 +1,155 @@
+#pragma once
+
+#include "EFRAPIHeapAllocator.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    constexpr uint64 BLOCK_SIZE = 1024 * 1024;
+
+    bool Overlaps(const HeapAllocation& a, const HeapAllocation& b){
+        return a.Heap == b.Heap && a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+    }
+}
+
+TEST_CASE("Heap allocator places aligned, disjoint ranges", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIHeapAllocator allocator(device, HeapType::DeviceLocal, BLOCK_SIZE);
+
+    std::vector<HeapAllocation> allocations;
+    for (uint64 index = 0; index < 64; ++index){
+        const uint64 alignment = 256ull << (index % 9);
+        const HeapAllocation allocation = allocator.Allocate({1000 + index * 300, alignment});
+        REQUIRE(allocation.IsValid());
+        REQUIRE(allocation.Offset % alignment == 0);
+        REQUIRE(allocation.Size >= 1000 + index * 300);
+        for (const HeapAllocation& other : allocations){
+            REQUIRE_FALSE(Overlaps(allocation, other));
+        }
+        allocations.push_back(allocation);
+    }
+
+    // Every range merges back, each heap is one free range again
+    for (size_t index = 0; index < allocations.size(); index += 2){
+        allocator.Free(allocations[index]);
+    }
+    for (size_t index = 1; index < allocations.size(); index += 2){
+        allocator.Free(allocations[index]);
+    }
+    for (const HeapBlockStats& heap : allocator.GetHeapStats()){
+        REQUIRE(heap.AllocationCount == 0);
+        REQUIRE(heap.FreeRanges == 1);
+        REQUIRE(heap.LargestFreeRange == heap.Capacity);
+        REQUIRE(heap.Fragmentation == 0.0f);
+    }
+    REQUIRE(allocator.GetStats().UsedBytes == 0);
+}
+
+TEST_CASE("Heap allocator gives large requests a heap of their own", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIHeapAllocator allocator(device, HeapType::DeviceLocal, BLOCK_SIZE);
+
+    const HeapAllocation small = allocator.Allocate({4096, 256});
+    const HeapAllocation large = allocator.Allocate({3 * BLOCK_SIZE, 65536});
+    REQUIRE(small.IsValid());
+    REQUIRE(large.IsValid());
+    REQUIRE(small.Heap != large.Heap);
+    REQUIRE(large.Heap->getDesc().capacity >= 3 * BLOCK_SIZE);
+    REQUIRE(allocator.GetStats().HeapsCreated == 2);
+
+    allocator.Free(large);
+    allocator.ReleaseEmptyHeaps();
+    REQUIRE(allocator.GetStats().HeapsReleased == 1);
+    REQUIRE(allocator.GetHeapStats().size() == 1);
+
+    // The released heap is created again on demand
+    const HeapAllocation again = allocator.Allocate({2 * BLOCK_SIZE, 256});
+    REQUIRE(again.IsValid());
+    REQUIRE(allocator.GetStats().HeapsCreated == 3);
+}
+
+TEST_CASE("Heap allocator binds placed buffers and textures", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIHeapAllocator allocator(device, HeapType::DeviceLocal, BLOCK_SIZE);
+
+    HeapAllocation bufferAllocation;
+    const BufferHandle buffer = allocator.CreateBuffer(BufferDesc().SetByteSize(1000), bufferAllocation);
+    REQUIRE(buffer);
+    REQUIRE(buffer->GetDesc().B_IsVirtual);
+    REQUIRE(bufferAllocation.UserData == buffer.Get());
+
+    HeapAllocation textureAllocation;
+    const TextureHandle texture = allocator.CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).
+                                                                        SetFormat(E_Format::RGBA8_UNORM),
+                                                          textureAllocation);
+    REQUIRE(texture);
+    REQUIRE(textureAllocation.UserData == texture.Get());
+    REQUIRE(textureAllocation.Offset % device->GetTextureMemoryRequirements(texture).alignment == 0);
+    REQUIRE_FALSE(Overlaps(bufferAllocation, textureAllocation));
+
+    // Data written to the placed buffer lands in its range of the heap
+    const uint32 value = 0xC0FFEE;
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+    commandList->Open();
+    commandList->WriteBuffer(buffer, &value, sizeof(value));
+    commandList->Close();
+    EFRAPICommandList* submitted = commandList;
+    device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    const auto* heap = static_cast<HeadlessHeap*>(bufferAllocation.Heap);
+    uint32 placed = 0;
+    std::memcpy(&placed, heap->Memory.data() + bufferAllocation.Offset, sizeof(placed));
+    REQUIRE(placed == value);
+}
+
+TEST_CASE("Heap allocator defragments into the fuller heaps", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIHeapAllocator allocator(device, HeapType::DeviceLocal, BLOCK_SIZE);
+
+    // Fill two heaps, then free most of both so the second one fits into the holes of the first
+    std::vector<HeapAllocation> allocations;
+    while (allocator.GetStats().HeapsCreated < 3){
+        allocations.push_back(allocator.Allocate({64 * 1024, 256}));
+    }
+    allocator.Free(allocations.back());
+    allocations.pop_back();
+    std::vector<HeapAllocation> live;
+    for (size_t index = 0; index < allocations.size(); ++index){
+        if (index % 4 == 0){
+            live.push_back(allocations[index]);
+        }
+        else{
+            allocator.Free(allocations[index]);
+        }
+    }
+    allocator.ReleaseEmptyHeaps();
+    REQUIRE(allocator.GetHeapStats().size() == 2);
+
+    std::unordered_map<uint32, HeapAllocation> moved;
+    const uint32 moves = allocator.Defragment([&](const HeapAllocation& from, const HeapAllocation& to){
+        REQUIRE(from.Heap != to.Heap);
+        REQUIRE(from.Size == to.Size);
+        moved[from.Node] = to;
+        return true;
+    });
+
+    REQUIRE(moves > 0);
+    REQUIRE(moves == moved.size());
+    REQUIRE(allocator.GetStats().Moves == moves);
+    const std::vector<HeapBlockStats> heaps = allocator.GetHeapStats();
+    REQUIRE(heaps.size() == 1);
+    REQUIRE(heaps.front().AllocationCount == live.size());
+
+    // The moved ranges are allocated in their new place and free like any other
+    for (const HeapAllocation& allocation : live){
+        const auto found = moved.find(allocation.Node);
+        allocator.Free(found != moved.end() ? found->second : allocation);
+    }
+    REQUIRE(allocator.GetStats().UsedBytes == 0);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "EFFramePacer.h"
+#include "EFIdleMonitor.h"
+#include "Thread.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+
+using namespace EventfulEngine;
+
+namespace{
+    using namespace std::chrono_literals;
+
+    double SecondsSince(const std::chrono::steady_clock::time_point start){
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double CpuSecondsSince(const std::clock_t start){
+        return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    }
+
+    // Same decision as the engine loop, tests never register platform events, like a headless or server run
+    void TickWithoutWindow(EFFramePacer& pacer, const EFDuration idleTickInterval){
+        pacer.BeginFrame();
+        if (EFIdleMonitor::ShouldIdle()){
+            EFIdleMonitor::WaitForActivity(idleTickInterval);
+            pacer.EndIdleFrame();
+        }
+        else{
+            pacer.EndFrame();
+        }
+    }
+}
+
+TEST_CASE("Loop without a window sleeps on the idle monitor while nothing is pending", "[core]"){
+    EFFramePacer pacer(EFFramePacerSettings{});
+    REQUIRE(EFIdleMonitor::ShouldIdle());
+
+    constexpr int32 TICKS = 5;
+    const auto startTime = std::chrono::steady_clock::now();
+    const std::clock_t startCpu = std::clock();
+    for (int32 tick = 0; tick < TICKS; ++tick){
+        TickWithoutWindow(pacer, 20ms);
+    }
+    const double seconds = SecondsSince(startTime);
+
+    // Every idle tick blocks for its interval without burning the core
+    REQUIRE(seconds >= 0.0995);
+    REQUIRE(CpuSecondsSince(startCpu) < seconds * 0.5);
+    REQUIRE(pacer.GetStats().FrameCount == 0);
+}
+
+TEST_CASE("Loop without a window is paced while work is pending", "[core]"){
+    EFFramePacerSettings settings;
+    settings.TargetFps = 100.0;
+    EFFramePacer pacer(settings);
+    EFScopedPendingWork work;
+    REQUIRE_FALSE(EFIdleMonitor::ShouldIdle());
+
+    constexpr int32 FRAMES = 10;
+    TickWithoutWindow(pacer, 1s);
+    const auto startTime = std::chrono::steady_clock::now();
+    const std::clock_t startCpu = std::clock();
+    for (int32 frame = 0; frame < FRAMES; ++frame){
+        TickWithoutWindow(pacer, 1s);
+    }
+    const double seconds = SecondsSince(startTime);
+
+    // The frame limit holds the loop to its rate, it does not spin through empty frames
+    REQUIRE(seconds >= 0.09);
+    REQUIRE(seconds < 1.0);
+    REQUIRE(CpuSecondsSince(startCpu) < seconds * 0.5);
+    REQUIRE(pacer.GetStats().FrameCount >= FRAMES);
+}
+
+TEST_CASE("Idle waits end early on pending work and wake requests", "[core]"){
+    // A wake requested before the wait makes it return right away
+    EFIdleMonitor::RequestWake();
+    auto startTime = std::chrono::steady_clock::now();
+    EFIdleMonitor::WaitForActivity(5s);
+    REQUIRE(SecondsSince(startTime) < 1.0);
+
+    // Work added from another thread wakes the loop without a platform event source
+    startTime = std::chrono::steady_clock::now();
+    Thread worker([]{
+        std::this_thread::sleep_for(20ms);
+        EFIdleMonitor::AddPendingWork();
+    });
+    EFIdleMonitor::WaitForActivity(5s);
+    worker.Join();
+    REQUIRE(SecondsSince(startTime) < 1.0);
+    REQUIRE_FALSE(EFIdleMonitor::ShouldIdle());
+
+    EFIdleMonitor::RemovePendingWork();
+    REQUIRE(EFIdleMonitor::ShouldIdle());
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "EFLogger.h"
+#include "Thread.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    EF_DEFINE_LOG_CATEGORY_STATIC(LogTestThreads, "Test_Logger_Threads.log", E_EFLogLevel::trace, E_EFLogLevel::trace)
+    EF_DEFINE_LOG_CATEGORY_STATIC(LogTestLevels, "Test_Logger_Levels.log", E_EFLogLevel::trace, E_EFLogLevel::trace)
+    EF_DEFINE_LOG_CATEGORY_STATIC(LogTestCompiled, "Test_Logger_Compiled.log", E_EFLogLevel::trace, E_EFLogLevel::warn)
+
+    std::filesystem::path GetLogDirectory(){
+        return std::filesystem::temp_directory_path() / "Test_Logger";
+    }
+
+    void SetUpLogger(){
+        EFLogger::SetConsoleOutput(false);
+        EFLogger::SetLogDirectory(GetLogDirectory().string());
+    }
+
+    // Lines written to the file of the category so far, without the time, category and level prefix
+    std::vector<EFString> ReadMessages(const EFLogCategory& category){
+        std::vector<EFString> messages;
+        std::ifstream file(GetLogDirectory() / category.GetFileName());
+        EFString line;
+        while (std::getline(file, line)){
+            size_t start = 0;
+            for (int32 bracket = 0; bracket < 3 && start != EFString::npos; ++bracket){
+                start = line.find("] ", start);
+                start = start == EFString::npos ? start : start + 2;
+            }
+            messages.push_back(start == EFString::npos ? line : line.substr(start));
+        }
+        return messages;
+    }
+
+    int32 CountEvaluation(int32& evaluations){
+        return ++evaluations;
+    }
+
+    // Not trivially copyable, the logger formats it on the calling thread
+    struct CountedFormat{
+        EFString Text;
+        int32* Formats;
+    };
+}
+
+template <>
+struct std::formatter<CountedFormat> : std::formatter<std::string_view>{
+    auto format(const CountedFormat& value, std::format_context& context) const{
+        ++*value.Formats;
+        return std::formatter<std::string_view>::format(value.Text, context);
+    }
+};
+
+TEST_CASE("Logger writes the records of every thread in their order", "[core]"){
+    SetUpLogger();
+    constexpr int32 THREADS = 4;
+    constexpr int32 RECORDS = 2000;
+
+    // Small rings make the producers wait for the backend to catch up
+    EFLogger::SetRingCapacity(4096);
+    std::vector<Thread> threads;
+    for (int32 thread = 0; thread < THREADS; ++thread){
+        threads.emplace_back([thread]{
+            for (int32 record = 0; record < RECORDS; ++record){
+                EF_INFO_CAT(LogTestThreads, "{} {} {}", thread, record, "payload");
+            }
+        });
+    }
+    for (Thread& thread : threads){
+        thread.Join();
+    }
+    EFLogger::Flush();
+
+    std::vector<int32> nextRecord(THREADS, 0);
+    const std::vector<EFString> messages = ReadMessages(LogTestThreads);
+    REQUIRE(messages.size() == THREADS * RECORDS);
+    for (const EFString& message : messages){
+        int32 thread = -1;
+        int32 record = -1;
+        char payload[16]{};
+        REQUIRE(std::sscanf(message.c_str(), "%d %d %15s", &thread, &record, payload) == 3);
+        REQUIRE(thread >= 0);
+        REQUIRE(thread < THREADS);
+        REQUIRE(record == nextRecord[thread]++);
+        REQUIRE(EFString{payload} == "payload");
+    }
+}
+
+TEST_CASE("Logger copies strings and formats other arguments on the calling thread", "[core]"){
+    SetUpLogger();
+    int32 formats = 0;
+    {
+        EFString text = "owned";
+        const CountedFormat counted{"counted", &formats};
+        EF_WARN_CAT(LogTestLevels, "{} {} {:.2f} {} {}", text, std::string_view{"view"}, 1.5, true, counted);
+        // The record holds its own copy, changing the string afterwards does not affect it
+        text = "changed";
+        // Sizing and copying the record share one formatting of the argument
+        REQUIRE(formats == 1);
+    }
+    EFLogger::Flush();
+
+    const std::vector<EFString> messages = ReadMessages(LogTestLevels);
+    REQUIRE(!messages.empty());
+    REQUIRE(messages.back() == "owned view 1.50 true counted");
+}
+
+TEST_CASE("Logger skips records below the runtime level without evaluating them", "[core]"){
+    SetUpLogger();
+    int32 evaluations = 0;
+
+    LogTestLevels.SetLevel(E_EFLogLevel::warn);
+    EF_INFO_CAT(LogTestLevels, "skipped {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 0);
+    EF_ERROR_CAT(LogTestLevels, "written {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 1);
+
+    LogTestLevels.SetLevel(E_EFLogLevel::off);
+    EF_CRITICAL_CAT(LogTestLevels, "skipped {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 1);
+
+    LogTestLevels.SetLevel(E_EFLogLevel::trace);
+    EF_TRACE_CAT(LogTestLevels, "written {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 2);
+    EFLogger::Flush();
+
+    const std::vector<EFString> messages = ReadMessages(LogTestLevels);
+    REQUIRE(messages.size() >= 2);
+    REQUIRE(messages[messages.size() - 2] == "written 1");
+    REQUIRE(messages.back() == "written 2");
+}
+
+TEST_CASE("Logger discards records below the compile time level of the category", "[core]"){
+    using CompiledCategory = std::remove_cvref_t<decltype(LogTestCompiled)>;
+    static_assert(!CompiledCategory::IsCompiledIn(E_EFLogLevel::info));
+    static_assert(CompiledCategory::IsCompiledIn(E_EFLogLevel::warn));
+    static_assert(!CompiledCategory::IsCompiledIn(E_EFLogLevel::off));
+    // The global minimum wins over a lower category level
+    static_assert(TEFLogCategory<E_EFLogLevel::trace>::CompileTimeMinLevel == g_logCompileMinLevel);
+
+    SetUpLogger();
+    int32 evaluations = 0;
+
+    // The runtime level lets everything through, the compile time level still removes the call
+    REQUIRE(LogTestCompiled.GetLevel() == E_EFLogLevel::trace);
+    EF_DEBUG_CAT(LogTestCompiled, "skipped {}", CountEvaluation(evaluations));
+    EF_INFO_CAT(LogTestCompiled, "skipped {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 0);
+    EF_WARN_CAT(LogTestCompiled, "written {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 1);
+
+    // Raising the runtime level above the compile time one filters as usual
+    LogTestCompiled.SetLevel(E_EFLogLevel::err);
+    EF_WARN_CAT(LogTestCompiled, "skipped {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 1);
+    EF_ERROR_CAT(LogTestCompiled, "written {}", CountEvaluation(evaluations));
+    REQUIRE(evaluations == 2);
+    EFLogger::Flush();
+
+    const std::vector<EFString> messages = ReadMessages(LogTestCompiled);
+    REQUIRE(messages.size() == 2);
+    REQUIRE(messages[0] == "written 1");
+    REQUIRE(messages[1] == "written 2");
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IModule.h"
+#include "ModuleManager.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+
+using namespace EventfulEngine;
+
+namespace{
+    // Takes the modules mutex from its startup, like a library registering itself while it loads
+    class RegisteringModule final : public IModule{
+    public:
+        void StartupModule() override{
+            B_IsRegistered = ModuleManager::Get().IsModuleRegistered("TestNestedOuter");
+            ++Startups;
+        }
+
+        E_ModuleLoadPhase GetLoadPhase() override{
+            return E_ModuleLoadPhase::GameSession;
+        }
+
+        std::atomic<int32> Startups = 0;
+        bool B_IsRegistered{false};
+    };
+
+    // Loads the modules of a later phase from its own startup, with the modules mutex held by the outer load
+    class LoadingModule final : public IModule{
+    public:
+        void StartupModule() override{
+            B_IsLoaded = ModuleManager::Get().LoadModules(E_ModuleLoadPhase::GameSession);
+        }
+
+        E_ModuleLoadPhase GetLoadPhase() override{
+            return E_ModuleLoadPhase::GameSessionInit;
+        }
+
+        bool B_IsLoaded{false};
+    };
+}
+
+TEST_CASE("Module manager loads modules from the startup of another module", "[core]"){
+    ModuleManager& manager = ModuleManager::Get();
+    static LoadingModule outer;
+    static RegisteringModule first;
+    static RegisteringModule second;
+    manager.RegisterStaticModule("TestNestedOuter", outer.GetLoadPhase(), &outer);
+    manager.RegisterStaticModule("TestNestedFirst", first.GetLoadPhase(), &first);
+    manager.RegisterStaticModule("TestNestedSecond", second.GetLoadPhase(), &second);
+
+    // Both inner modules form one wave, the nested load can not hand the mutex to workers and loads them serially
+    REQUIRE(manager.LoadModules(E_ModuleLoadPhase::GameSessionInit));
+    REQUIRE(outer.B_IsLoaded);
+    REQUIRE(first.Startups == 1);
+    REQUIRE(second.Startups == 1);
+    REQUIRE(first.B_IsRegistered);
+    REQUIRE(second.B_IsRegistered);
+
+    // Loaded from the outermost level the same wave runs on workers
+    REQUIRE(manager.UnloadModules(E_ModuleLoadPhase::GameSession));
+    REQUIRE(manager.LoadModules(E_ModuleLoadPhase::GameSession));
+    REQUIRE(first.Startups == 2);
+    REQUIRE(second.Startups == 2);
+
+    REQUIRE(manager.UnloadModules(E_ModuleLoadPhase::GameSession));
+    REQUIRE(manager.UnloadModules(E_ModuleLoadPhase::GameSessionInit));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "EFName.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace EventfulEngine;
+
+TEST_CASE("Equal text interns to the same name", "[core]"){
+    const EFName name{"Test_Name_Equal"};
+    REQUIRE(name == EFName{std::string{"Test_Name_Equal"}});
+    REQUIRE(name != EFName{"Test_Name_Other"});
+    REQUIRE(name.ToStringView() == "Test_Name_Equal");
+    REQUIRE(EFName::Find("Test_Name_Equal") == name);
+    REQUIRE(EFName::Find("Test_Name_Never_Interned").IsNone());
+    REQUIRE(EFName{}.IsNone());
+    REQUIRE(EFName{""}.IsNone());
+}
+
+TEST_CASE("Short names interned after a long one keep their text", "[core]"){
+    // Enough long names that every shard most likely interns one before any short name of this test
+    std::vector<std::string> texts;
+    for (int32 index = 0; index < 64; ++index){
+        texts.push_back("Test_Name_Long_" + std::to_string(index) + std::string(8 * 1024, 'x'));
+    }
+    for (int32 index = 0; index < 256; ++index){
+        texts.push_back("Test_Name_Short_" + std::to_string(index));
+    }
+
+    std::vector<EFName> names;
+    for (const std::string& text : texts){
+        names.emplace_back(text);
+    }
+    for (size_t index = 0; index < texts.size(); ++index){
+        REQUIRE(names[index].ToStringView() == texts[index]);
+        REQUIRE(std::string_view{names[index].GetData()} == texts[index]);
+    }
+}
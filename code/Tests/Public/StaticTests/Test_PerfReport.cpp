@@ -0,0 +1,127 @@
+#pragma once
+
+#include "EFPerfCapture.h"
+#include "FileSystem.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace EventfulEngine;
+
+namespace{
+    EFPath GetReportPath(const char* name){
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    EFPerfReport CreateReport(){
+        EFPerfReport report;
+        report.FrameCount = 120;
+        report.Metrics = {{"FrameTimeMs.P50", 16.5}, {"Zone \"Update, Physics\".Ms", 0.25}, {"Allocations", 0.0}};
+        report.FrameMilliseconds = {16.0, 17.0};
+        return report;
+    }
+
+    void RequireSameMetrics(const EFPerfReport& loaded, const EFPerfReport& saved){
+        REQUIRE(loaded.FrameCount == saved.FrameCount);
+        REQUIRE(loaded.Metrics.size() == saved.Metrics.size());
+        for (const EFPerfReport::Metric& metric : saved.Metrics){
+            const EFPerfReport::Metric* loadedMetric = loaded.FindMetric(metric.Name);
+            REQUIRE(loadedMetric);
+            REQUIRE(loadedMetric->Value == metric.Value);
+        }
+    }
+
+    const EFPerfMetricDifference& FindDifference(const std::vector<EFPerfMetricDifference>& differences,
+                                                 const std::string_view name){
+        const auto difference = std::ranges::find(differences, name, &EFPerfMetricDifference::Name);
+        REQUIRE(difference != differences.end());
+        return *difference;
+    }
+}
+
+TEST_CASE("Perf reports load what they saved", "[core]"){
+    const EFPerfReport report = CreateReport();
+
+    // JSON keeps the frame times, CSV only the metrics and quotes names that would break the row
+    const EFPath jsonPath = GetReportPath("Test_PerfReport.json");
+    REQUIRE(report.Save(jsonPath));
+    const std::optional<EFPerfReport> json = EFPerfReport::Load(jsonPath);
+    REQUIRE(json);
+    RequireSameMetrics(*json, report);
+    REQUIRE(json->FrameMilliseconds == report.FrameMilliseconds);
+
+    const EFPath csvPath = GetReportPath("Test_PerfReport.csv");
+    REQUIRE(report.Save(csvPath));
+    const std::optional<EFPerfReport> csv = EFPerfReport::Load(csvPath);
+    REQUIRE(csv);
+    RequireSameMetrics(*csv, report);
+    REQUIRE(csv->FrameMilliseconds.empty());
+
+    // Missing and malformed files are rejected instead of read as empty reports
+    REQUIRE_FALSE(EFPerfReport::Load(GetReportPath("Test_PerfReport_Missing.json")));
+    std::ofstream(jsonPath) << R"({"FrameCount": 1, "Metrics": {"FrameTimeMs.P50": "fast"}})";
+    REQUIRE_FALSE(EFPerfReport::Load(jsonPath));
+    std::ofstream(csvPath) << "Metric,Value\nFrameTimeMs.P50,fast\n";
+    REQUIRE_FALSE(EFPerfReport::Load(csvPath));
+
+    std::filesystem::remove(jsonPath);
+    std::filesystem::remove(csvPath);
+}
+
+TEST_CASE("Perf report comparison flags metrics above the threshold", "[core]"){
+    EFPerfReport baseline;
+    baseline.Metrics = {{"Equal", 4.0}, {"AtThreshold", 4.0}, {"AboveThreshold", 4.0}, {"Faster", 4.0}};
+    EFPerfReport current;
+    current.Metrics = {{"Faster", 2.0}, {"AboveThreshold", 4.5}, {"AtThreshold", 4.25}, {"Equal", 4.0}};
+
+    // Values exact in binary, so growing by exactly the threshold is not rounded into a regression
+    const std::vector<EFPerfMetricDifference> differences = ComparePerfReports(baseline, current, 6.25);
+    REQUIRE(differences.size() == 4);
+    // Baseline order, whatever the order of the current report
+    REQUIRE(differences[0].Name == "Equal");
+    REQUIRE(differences[3].Name == "Faster");
+
+    REQUIRE_FALSE(FindDifference(differences, "Equal").bIsRegression);
+    REQUIRE(FindDifference(differences, "AtThreshold").ChangePercent == 6.25);
+    REQUIRE_FALSE(FindDifference(differences, "AtThreshold").bIsRegression);
+    REQUIRE(FindDifference(differences, "AboveThreshold").bIsRegression);
+    REQUIRE(FindDifference(differences, "Faster").ChangePercent == -50.0);
+    REQUIRE_FALSE(FindDifference(differences, "Faster").bIsRegression);
+}
+
+TEST_CASE("Perf report comparison handles zero baselines and metrics on one side", "[core]"){
+    EFPerfReport baseline;
+    baseline.Metrics = {{"StillZero", 0.0}, {"SmallGrowth", 0.0}, {"LargeGrowth", 0.0}, {"Removed", 3.0}};
+    EFPerfReport current;
+    current.Metrics = {{"StillZero", 0.0}, {"SmallGrowth", 1.0}, {"LargeGrowth", 4.0}, {"Added", 2.0}};
+
+    // Growing from 0 is a regression once it exceeds the absolute threshold, the relative change stays 0
+    std::vector<EFPerfMetricDifference> differences = ComparePerfReports(baseline, current, 5.0, 2.0);
+    REQUIRE_FALSE(FindDifference(differences, "StillZero").bIsRegression);
+    REQUIRE_FALSE(FindDifference(differences, "SmallGrowth").bIsRegression);
+    REQUIRE(FindDifference(differences, "LargeGrowth").bIsRegression);
+    REQUIRE(FindDifference(differences, "LargeGrowth").ChangePercent == 0.0);
+
+    // Without an absolute threshold any growth from 0 regresses
+    differences = ComparePerfReports(baseline, current, 5.0);
+    REQUIRE_FALSE(FindDifference(differences, "StillZero").bIsRegression);
+    REQUIRE(FindDifference(differences, "SmallGrowth").bIsRegression);
+
+    // Removed metrics are reported, metrics only the current report has come last
+    const EFPerfMetricDifference& removed = FindDifference(differences, "Removed");
+    REQUIRE(removed.IsRemoved());
+    REQUIRE(removed.Baseline == 3.0);
+    REQUIRE_FALSE(removed.Current);
+    REQUIRE_FALSE(removed.bIsRegression);
+
+    REQUIRE(differences.size() == 5);
+    const EFPerfMetricDifference& added = differences.back();
+    REQUIRE(added.Name == "Added");
+    REQUIRE_FALSE(added.Baseline);
+    REQUIRE(added.Current == 2.0);
+    REQUIRE_FALSE(added.IsRemoved());
+    REQUIRE_FALSE(added.bIsRegression);
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "EFRAPIPipelineCache.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    constexpr uint8 BYTECODE[] = {0x44, 0x58, 0x42, 0x43, 0x01, 0x02, 0x03, 0x04};
+
+    ShaderHandle CreateComputeShader(EFDynamicRAPI* device, const uint32 material = 0){
+        const ShaderHandle shader = device->CreateShader(ShaderDesc().SetShaderType(F_ShaderType::Compute),
+                                                         BYTECODE, sizeof(BYTECODE));
+        const ShaderSpecialization specialization = ShaderSpecialization::UInt32(0, material);
+        return device->CreateShaderSpecialization(shader, &specialization, 1);
+    }
+
+    ComputePipelineDesc CreateComputeDesc(EFDynamicRAPI* device, const uint32 material = 0){
+        return ComputePipelineDesc().SetComputeShader(CreateComputeShader(device, material));
+    }
+
+    EFHeadlessRAPI* Headless(const DynamicRAPIHandle& device){
+        return static_cast<EFHeadlessRAPI*>(device.Get());
+    }
+
+    EFPath GetCachePath(const char* name){
+        return std::filesystem::temp_directory_path() / name;
+    }
+}
+
+TEST_CASE("Pipeline hashes depend on content, not on objects", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const ComputePipelineDesc desc = CreateComputeDesc(device);
+
+    // Equal shaders created twice hash the same, another specialization does not
+    REQUIRE(HashComputePipeline(desc) == HashComputePipeline(CreateComputeDesc(device)));
+    REQUIRE(HashComputePipeline(desc) != HashComputePipeline(CreateComputeDesc(device, 1)));
+
+    GraphicsPipelineDesc graphicsDesc;
+    graphicsDesc.SetVertexShader(desc.CS);
+    FramebufferInfo framebufferInfo;
+    framebufferInfo.colorFormats.push_back(E_Format::RGBA8_UNORM);
+    FramebufferInfo otherFramebufferInfo = framebufferInfo;
+    otherFramebufferInfo.depthFormat = E_Format::D32;
+    const uint64 graphicsHash = HashGraphicsPipeline(graphicsDesc, framebufferInfo);
+    REQUIRE(graphicsHash == HashGraphicsPipeline(graphicsDesc, framebufferInfo));
+    REQUIRE(graphicsHash != HashGraphicsPipeline(graphicsDesc, otherFramebufferInfo));
+    REQUIRE(graphicsHash != HashComputePipeline(desc));
+}
+
+TEST_CASE("Pipeline cache creates equal descriptions once", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIPipelineCache cache(device);
+
+    const ComputePipelineHandle pipeline = cache.GetComputePipeline(CreateComputeDesc(device));
+    REQUIRE(pipeline);
+    REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device)) == pipeline);
+    REQUIRE(cache.RequestComputePipeline(CreateComputeDesc(device)) == pipeline);
+    REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device, 1)) != pipeline);
+
+    const PipelineCacheStats stats = cache.GetStats();
+    REQUIRE(stats.Misses == 2);
+    REQUIRE(stats.Hits == 2);
+    REQUIRE(cache.GetPipelineCount() == 2);
+    REQUIRE(Headless(device)->GetStats().PipelinesCompiled == 2);
+}
+
+TEST_CASE("Pipeline cache answers requests with the placeholder while compiling", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    Headless(device)->SetPipelineCompileTime(std::chrono::milliseconds(20));
+    const ComputePipelineHandle placeholder = device->CreateComputePipeline(CreateComputeDesc(device, 100));
+    // A single compile thread works through all requests in turn
+    EFRAPIPipelineCache cache(device, 1);
+
+    std::vector<ComputePipelineDesc> descs;
+    for (uint32 material = 0; material < 4; ++material){
+        descs.push_back(CreateComputeDesc(device, material));
+        REQUIRE(cache.RequestComputePipeline(descs.back(), placeholder) == placeholder);
+    }
+    REQUIRE(cache.RequestComputePipeline(descs.back(), placeholder) == placeholder);
+
+    cache.WaitForPendingCompilations();
+    for (const ComputePipelineDesc& desc : descs){
+        const ComputePipelineHandle pipeline = cache.RequestComputePipeline(desc, placeholder);
+        REQUIRE(pipeline);
+        REQUIRE(pipeline != placeholder);
+    }
+    const PipelineCacheStats stats = cache.GetStats();
+    REQUIRE(stats.AsyncCompilations == 4);
+    REQUIRE(stats.Placeholders == 5);
+    REQUIRE(stats.Hits == 4);
+}
+
+TEST_CASE("Pipeline cache does not keep failed pipelines", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIPipelineCache cache(device);
+
+    // The headless device fails compute pipelines without a shader
+    const ComputePipelineDesc invalid;
+    REQUIRE_FALSE(cache.GetComputePipeline(invalid));
+    REQUIRE_FALSE(cache.RequestComputePipeline(invalid));
+    cache.WaitForPendingCompilations();
+    REQUIRE_FALSE(cache.GetComputePipeline(invalid));
+
+    const PipelineCacheStats stats = cache.GetStats();
+    REQUIRE(stats.Failures == 3);
+    REQUIRE(stats.Misses == 3);
+    REQUIRE(stats.Hits == 0);
+    REQUIRE(cache.GetPipelineCount() == 0);
+}
+
+TEST_CASE("Pipeline cache creates pipelines from saved binaries", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const EFPath path = GetCachePath("Test_PipelineCache_RoundTrip.bin");
+    {
+        EFRAPIPipelineCache cache(device);
+        REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device)));
+        REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device, 1)));
+        REQUIRE(cache.Save(path));
+    }
+
+    Headless(device)->ResetStats();
+    EFRAPIPipelineCache cache(device);
+    REQUIRE(cache.Load(path));
+    REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device)));
+    REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device, 2)));
+    REQUIRE(cache.GetStats().BinariesLoaded == 1);
+    REQUIRE(Headless(device)->GetStats().PipelinesFromBinary == 1);
+    REQUIRE(Headless(device)->GetStats().PipelinesCompiled == 1);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Pipeline cache rejects files with sizes past their end", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const EFPath path = GetCachePath("Test_PipelineCache_Corrupt.bin");
+    {
+        EFRAPIPipelineCache cache(device);
+        REQUIRE(cache.GetComputePipeline(CreateComputeDesc(device)));
+        REQUIRE(cache.Save(path));
+    }
+    EFRAPIPipelineCache cache(device);
+    REQUIRE(cache.Load(path));
+
+    // Magic, version and API take 12 bytes, the entry count 8 and the hash of the first entry 8 more
+    constexpr std::streamoff SIZE_OFFSET = 28;
+    constexpr uint64 HUGE_SIZE = 1ull << 60;
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(SIZE_OFFSET);
+        file.write(reinterpret_cast<const char*>(&HUGE_SIZE), sizeof(HUGE_SIZE));
+    }
+    REQUIRE_FALSE(cache.Load(path));
+
+    // An entry count the file cannot hold
+    constexpr std::streamoff COUNT_OFFSET = 12;
+    constexpr uint64 HUGE_COUNT = 1ull << 40;
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(COUNT_OFFSET);
+        file.write(reinterpret_cast<const char*>(&HUGE_COUNT), sizeof(HUGE_COUNT));
+    }
+    REQUIRE_FALSE(cache.Load(path));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "EFFramePacer.h"
+#include "GenericPlatformTime.h"
+#include "Thread.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    using namespace std::chrono_literals;
+
+    using DurationBuffer = std::array<char, EFPlatformTime::DurationBufferSize>;
+}
+
+TEST_CASE("Cycle counter is calibrated once for every thread", "[core]"){
+    constexpr int32 THREADS = 4;
+    std::atomic<int32> ready = 0;
+    std::atomic<int32> backwardReads = 0;
+    std::vector<const EFPlatformTime::CycleCalibration*> calibrations(THREADS);
+    std::vector<Thread> threads;
+    for (int32 thread = 0; thread < THREADS; ++thread){
+        threads.emplace_back([&, thread]{
+            // Start together, so the first reads race for the calibration
+            ++ready;
+            while (ready < THREADS){
+                std::this_thread::yield();
+            }
+            const uint64 first = EFPlatformTime::Cycles64();
+            calibrations[thread] = &EFPlatformTime::GetCycleCalibration();
+            if (EFPlatformTime::Cycles64() < first){
+                ++backwardReads;
+            }
+        });
+    }
+    for (Thread& thread : threads){
+        thread.Join();
+    }
+    REQUIRE(backwardReads == 0);
+    for (const EFPlatformTime::CycleCalibration* calibration : calibrations){
+        REQUIRE(calibration == calibrations[0]);
+    }
+    REQUIRE(calibrations[0]->SecondsPerCycle > 0.0);
+
+    // Later calibration requests keep the measured result
+    EFPlatformTime::CalibrateCycles(1ms);
+    REQUIRE(&EFPlatformTime::GetCycleCalibration() == calibrations[0]);
+}
+
+TEST_CASE("Cycle differences convert to real time", "[core]"){
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64 startCycles = EFPlatformTime::Cycles64();
+    std::this_thread::sleep_for(20ms);
+    const uint64 endCycles = EFPlatformTime::Cycles64();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    const double measured = EFPlatformTime::CyclesToSeconds(endCycles - startCycles);
+    REQUIRE(measured >= 0.019);
+    REQUIRE(measured <= seconds * 1.05);
+    REQUIRE(EFPlatformTime::CyclesToSeconds(EFPlatformTime::SecondsToCycles(0.5)) > 0.499);
+    REQUIRE(EFPlatformTime::CyclesToSeconds(EFPlatformTime::SecondsToCycles(0.5)) < 0.501);
+}
+
+TEST_CASE("Durations format into fixed buffers", "[core]"){
+    DurationBuffer buffer{};
+    REQUIRE(EFPlatformTime::FormatDuration(1h + 2min + 3s + 456ms, buffer) == "01:02:03.456");
+    REQUIRE(EFPlatformTime::FormatDuration(EFDuration::zero(), buffer) == "00:00:00.000");
+    REQUIRE(EFPlatformTime::FormatDuration(-5s, buffer) == "00:00:00.000");
+    REQUIRE(EFPlatformTime::FormatDuration(123h + 999ms, buffer) == "123:00:00.999");
+    REQUIRE(EFPlatformTime::FormatDuration(EFDuration::max(), buffer).size() < buffer.size());
+    REQUIRE(EFPlatformTime::DurationToString(59s + 1ms) == "00:00:59.001");
+
+    REQUIRE(EFPlatformTime::FormatShortDuration(500ns, buffer) == "500.00ns");
+    REQUIRE(EFPlatformTime::FormatShortDuration(850us, buffer) == "850.00us");
+    REQUIRE(EFPlatformTime::FormatShortDuration(16667us, buffer) == "16.67ms");
+    REQUIRE(EFPlatformTime::FormatShortDuration(2500ms, buffer) == "2.50s");
+    REQUIRE(EFPlatformTime::FormatShortDuration(-1500us, buffer) == "-1.50ms");
+    REQUIRE(EFPlatformTime::FormatShortDuration(EFDuration::max(), buffer).ends_with("s"));
+}
+
+TEST_CASE("Date and time format in local time", "[core]"){
+    std::tm local{};
+    local.tm_year = 2024 - 1900;
+    local.tm_mon = 2;
+    local.tm_mday = 5;
+    local.tm_hour = 7;
+    local.tm_min = 8;
+    local.tm_sec = 9;
+    local.tm_isdst = -1;
+    const SystemClock::time_point timePoint = SystemClock::from_time_t(std::mktime(&local));
+
+    std::array<char, EFPlatformTime::DateTimeStringLength> buffer{};
+    REQUIRE(EFPlatformTime::FormatDateTime(timePoint, buffer) == "2024-03-05 07:08:09");
+    REQUIRE(EFPlatformTime::DateTimeToString(timePoint) == "2024-03-05 07:08:09");
+}
+
+TEST_CASE("Frame pacer splits real time into capped fixed steps", "[core]"){
+    EFFramePacerSettings settings;
+    settings.FixedStepHz = 1000.0;
+    settings.MaxFixedSteps = 4;
+    settings.MaxDeltaTime = 10ms;
+    EFFramePacer pacer(settings);
+
+    const EFFrameTiming& first = pacer.BeginFrame();
+    REQUIRE(first.FrameIndex == 1);
+    REQUIRE(first.DeltaSeconds == 0.0);
+    REQUIRE(first.FixedSteps == 0);
+
+    std::this_thread::sleep_for(30ms);
+    const EFFrameTiming& timing = pacer.BeginFrame();
+    REQUIRE(timing.FrameIndex == 2);
+    // The delta is clamped, the steps are capped and the time they could not catch up on is dropped
+    REQUIRE(timing.DeltaSeconds == EFPlatformTime::ToSeconds(settings.MaxDeltaTime));
+    REQUIRE(timing.FixedSteps == settings.MaxFixedSteps);
+    REQUIRE(timing.FixedStepSeconds == 0.001);
+    REQUIRE(timing.InterpolationAlpha >= 0.0);
+    REQUIRE(timing.InterpolationAlpha < 1.0);
+}
+
+TEST_CASE("Frame pacer waits for the deadline of every frame", "[core]"){
+    EFFramePacerSettings settings;
+    settings.TargetFps = 100.0;
+    EFFramePacer pacer(settings);
+
+    constexpr int32 FRAMES = 10;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (int32 frame = 0; frame <= FRAMES; ++frame){
+        pacer.BeginFrame();
+        pacer.EndFrame();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // Frames never end early, the first BeginFrame only starts measuring
+    REQUIRE(seconds >= 0.0995);
+    const EFFramePacerStats stats = pacer.GetStats();
+    REQUIRE(stats.FrameCount == FRAMES);
+    // A late frame shortens the next one, only the average is bound to the period
+    REQUIRE(stats.AverageFrameSeconds >= 0.009);
+    REQUIRE(stats.MaxFrameSeconds >= stats.AverageFrameSeconds);
+    REQUIRE(stats.JitterSeconds >= 0.0);
+}
+
+TEST_CASE("Frame pacer restarts pacing after late and idle frames", "[core]"){
+    EFFramePacerSettings settings;
+    settings.TargetFps = 100.0;
+    EFFramePacer pacer(settings);
+
+    // The work of the frame alone runs past its deadline
+    pacer.BeginFrame();
+    std::this_thread::sleep_for(35ms);
+    pacer.EndFrame();
+    REQUIRE(pacer.GetStats().MissedDeadlines == 1);
+    REQUIRE(pacer.GetStats().MaxLatenessSeconds >= 0.02);
+
+    // More than a frame behind, the next frame gets a full period instead of rushing to catch up
+    const auto startTime = std::chrono::steady_clock::now();
+    pacer.BeginFrame();
+    pacer.EndFrame();
+    REQUIRE(std::chrono::steady_clock::now() - startTime >= 9ms);
+
+    // Idle frames are neither recorded nor late
+    pacer.BeginFrame();
+    pacer.EndIdleFrame();
+    pacer.ResetStats();
+    std::this_thread::sleep_for(30ms);
+    pacer.BeginFrame();
+    pacer.EndFrame();
+    REQUIRE(pacer.GetStats().FrameCount == 0);
+    REQUIRE(pacer.GetStats().MissedDeadlines == 0);
+}
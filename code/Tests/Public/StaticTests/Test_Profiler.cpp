@@ -0,0 +1,93 @@
+#pragma once
+
+#include "EFProfiler.h"
+#include "Thread.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
+using namespace EventfulEngine;
+
+namespace{
+    uint32 GetZoneCount(const EFProfilerFrameStats& stats, const std::string_view name){
+        const auto zone = std::ranges::find_if(stats.CpuZones, [name](const EFProfilerZoneStats& cpuZone){
+            return std::string_view{cpuZone.Name} == name;
+        });
+        return zone != stats.CpuZones.end() ? zone->Count : 0;
+    }
+
+    double GetZoneMaxSeconds(const EFProfilerFrameStats& stats, const std::string_view name){
+        const auto zone = std::ranges::find_if(stats.CpuZones, [name](const EFProfilerZoneStats& cpuZone){
+            return std::string_view{cpuZone.Name} == name;
+        });
+        return zone != stats.CpuZones.end() ? zone->MaxSeconds : 0.0;
+    }
+
+    // Every zone lasts one cycle, a torn copy would mix the timestamps of two zones
+    void RecordOneCycleZones(const char* name, const uint64 firstCycle, const uint64 count){
+        for (uint64 cycle = firstCycle; cycle < firstCycle + count; ++cycle){
+            EFProfiler::RecordZone(name, cycle, cycle + 1);
+        }
+    }
+}
+
+TEST_CASE("Profiler ring keeps the newest events and counts the lapped ones once", "[core]"){
+    EFProfiler::EndFrame();
+
+    // Fits the ring, nothing is lost
+    RecordOneCycleZones("Test.Ring", 1, 100);
+    EFProfiler::EndFrame();
+    EFProfilerFrameStats stats = EFProfiler::GetLastFrameStats();
+    REQUIRE(stats.DroppedEvents == 0);
+    REQUIRE(GetZoneCount(stats, "Test.Ring") == 100);
+
+    // Wraps the ring more than once, only the newest EventsPerThread events survive
+    constexpr uint64 LAPPED = 2 * EFProfiler::EventsPerThread + 37;
+    RecordOneCycleZones("Test.Ring", 1, EFProfiler::EventsPerThread + LAPPED);
+    EFProfiler::EndFrame();
+    stats = EFProfiler::GetLastFrameStats();
+    REQUIRE(stats.DroppedEvents == LAPPED);
+    REQUIRE(GetZoneCount(stats, "Test.Ring") == EFProfiler::EventsPerThread);
+
+    // The events dropped before are not counted again by the next frame
+    RecordOneCycleZones("Test.Ring", 1, 10);
+    EFProfiler::EndFrame();
+    stats = EFProfiler::GetLastFrameStats();
+    REQUIRE(stats.DroppedEvents == 0);
+    REQUIRE(GetZoneCount(stats, "Test.Ring") == 10);
+}
+
+TEST_CASE("Profiler collects a ring while its thread overwrites it", "[core]"){
+    EFProfiler::EndFrame();
+
+    constexpr uint64 EVENTS = 40 * EFProfiler::EventsPerThread;
+    std::atomic<bool> bIsDone{false};
+    Thread writer([&bIsDone]{
+        RecordOneCycleZones("Test.Concurrent", 1, EVENTS);
+        bIsDone.store(true, std::memory_order_release);
+    });
+
+    uint64 collected = 0;
+    uint64 dropped = 0;
+    double maxSeconds = 0.0;
+    const auto endFrame = [&]{
+        EFProfiler::EndFrame();
+        const EFProfilerFrameStats stats = EFProfiler::GetLastFrameStats();
+        collected += GetZoneCount(stats, "Test.Concurrent");
+        dropped += stats.DroppedEvents;
+        maxSeconds = std::max(maxSeconds, GetZoneMaxSeconds(stats, "Test.Concurrent"));
+    };
+    while (!bIsDone.load(std::memory_order_acquire)){
+        endFrame();
+    }
+    writer.Join();
+    endFrame();
+
+    // Every event is either collected or dropped, none twice, and no collected event is torn
+    REQUIRE(collected + dropped == EVENTS);
+    REQUIRE(collected > 0);
+    REQUIRE(maxSeconds <= EFPlatformTime::CyclesToSeconds(1) * 1.5);
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "EFRenderGraph.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+
+using namespace EventfulEngine;
+
+namespace{
+    const TextureDesc TARGET_DESC = TextureDesc().SetWidth(128).SetHeight(128).SetFormat(E_Format::RGBA8_UNORM).
+                                                  SetIsRenderTarget(true);
+
+    // A G-buffer and a shadow map that do not depend on each other, ambient occlusion from the depth, a debug view
+    // nothing reads, and lighting into the back buffer
+    void AddDeferredPasses(EFRenderGraph& graph, EFRAPITexture* backBuffer, std::atomic<int32>& executed){
+        const auto count = [&executed](EFRAPICommandList*, const RenderGraphResources&){ ++executed; };
+        const RenderGraphTexture output = graph.ImportTexture(backBuffer, F_ResourceStates::Common,
+                                                              F_ResourceStates::Present);
+        RenderGraphTexture albedo, depth, shadowMap, occlusion;
+        graph.AddPass("GBuffer", [&](RenderGraphBuilder& builder){
+            albedo = builder.Write(builder.CreateTexture(TARGET_DESC));
+            depth = builder.Write(builder.CreateTexture(TextureDesc(TARGET_DESC).SetFormat(E_Format::D32)),
+                                  F_ResourceStates::DepthWrite);
+        }, count);
+        graph.AddPass("Shadows", [&](RenderGraphBuilder& builder){
+            shadowMap = builder.Write(builder.CreateTexture(TextureDesc(TARGET_DESC).SetFormat(E_Format::D32)),
+                                      F_ResourceStates::DepthWrite);
+        }, count);
+        graph.AddPass("Debug", [&](RenderGraphBuilder& builder){
+            builder.Read(depth);
+            builder.Write(builder.CreateTexture(TARGET_DESC));
+        }, count);
+        graph.AddPass("Occlusion", [&](RenderGraphBuilder& builder){
+            builder.Read(depth);
+            occlusion = builder.Write(builder.CreateTexture(TextureDesc(TARGET_DESC).SetIsUAV(true)),
+                                      F_ResourceStates::UnorderedAccess);
+        }, count);
+        graph.AddPass("Lighting", [&](RenderGraphBuilder& builder){
+            builder.Read(albedo);
+            builder.Read(shadowMap);
+            builder.Read(occlusion);
+            builder.Write(output);
+        }, count);
+    }
+
+    // Full screen passes that each only need the result of the previous one, the last writes the back buffer
+    void AddChainPasses(EFRenderGraph& graph, EFRAPITexture* backBuffer, const int32 transientTextures){
+        const RenderGraphTexture output = graph.ImportTexture(backBuffer, F_ResourceStates::Common);
+        RenderGraphTexture previous;
+        for (int32 pass = 0; pass <= transientTextures; ++pass){
+            graph.AddPass("Chain", [&](RenderGraphBuilder& builder){
+                if (previous.IsValid()){
+                    builder.Read(previous);
+                }
+                previous = pass < transientTextures
+                               ? builder.Write(builder.CreateTexture(TARGET_DESC))
+                               : builder.Write(output);
+            }, [](EFRAPICommandList*, const RenderGraphResources&){});
+        }
+    }
+}
+
+TEST_CASE("Render graph culls unused passes and levels independent ones", "[rendercore]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle backBuffer = device->CreateTexture(TARGET_DESC);
+    std::atomic<int32> executed = 0;
+    EFRenderGraph graph(device);
+    AddDeferredPasses(graph, backBuffer, executed);
+    graph.Execute();
+
+    REQUIRE(graph.IsPassCulled(2));
+    REQUIRE(graph.GetPassLevel(0) == 0);
+    REQUIRE(graph.GetPassLevel(1) == 0);
+    REQUIRE(graph.GetPassLevel(3) == 1);
+    REQUIRE(graph.GetPassLevel(4) == 2);
+    REQUIRE(executed == 4);
+
+    // 3 transitions into level 0, 2 into level 1, 4 into level 2 and the back buffer to present
+    const RenderGraphStats& stats = graph.GetStats();
+    REQUIRE(stats.PassesCulled == 1);
+    REQUIRE(stats.Levels == 3);
+    REQUIRE(stats.Barriers == 10);
+    REQUIRE(static_cast<EFHeadlessRAPI*>(device.Get())->GetStats().Barriers == 10);
+    REQUIRE(static_cast<HeadlessTexture*>(backBuffer.Get())->States.State == F_ResourceStates::Present);
+}
+
+TEST_CASE("Render graph aliases transient resources that do not overlap", "[rendercore]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle backBuffer = device->CreateTexture(TARGET_DESC);
+    EFRenderGraph graph(device);
+
+    // A chain of full screen passes, each only needs the previous result
+    for (int32 frame = 0; frame < 2; ++frame){
+        graph.Reset();
+        const RenderGraphTexture output = graph.ImportTexture(backBuffer, F_ResourceStates::Common);
+        RenderGraphTexture previous;
+        for (int32 pass = 0; pass < 4; ++pass){
+            graph.AddPass("Chain", [&](RenderGraphBuilder& builder){
+                if (previous.IsValid()){
+                    builder.Read(previous);
+                }
+                previous = pass < 3 ? builder.Write(builder.CreateTexture(TARGET_DESC)) : builder.Write(output);
+            }, [](EFRAPICommandList*, const RenderGraphResources&){});
+        }
+        graph.Execute();
+
+        const RenderGraphStats& stats = graph.GetStats();
+        REQUIRE(stats.TransientTextures == 3);
+        // The first and the last texture share their memory
+        REQUIRE(stats.AliasedBytes * 3 == stats.TransientBytes * 2);
+        REQUIRE(stats.TransientResourcesCreated == (frame == 0 ? 3 : 0));
+    }
+}
+
+TEST_CASE("Render graph records independent passes into separate command lists", "[rendercore]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    const TextureHandle backBuffer = device->CreateTexture(TARGET_DESC);
+    std::atomic<int32> executed = 0;
+    EFRenderGraph graph(device);
+
+    graph.SetRecordingThreads(1);
+    AddDeferredPasses(graph, backBuffer, executed);
+    graph.Execute();
+    REQUIRE(graph.GetStats().CommandLists == 3);
+    const uint64 serialBarriers = headless->GetStats().Barriers;
+
+    graph.Reset();
+    graph.SetRecordingThreads(4);
+    AddDeferredPasses(graph, backBuffer, executed);
+    graph.Execute();
+    REQUIRE(graph.GetStats().CommandLists == 4);
+    REQUIRE(executed == 8);
+    // The passes of level 0 share the barriers the first list issues
+    REQUIRE(headless->GetStats().Barriers == serialBarriers * 2);
+    REQUIRE(headless->GetStats().ExecutedCommandLists == 7);
+}
+
+TEST_CASE("Render graph starts reused transient resources in the state the last frame left them in", "[rendercore]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    EFRenderGraph graph(device);
+
+    for (int32 frame = 0; frame < 2; ++frame){
+        graph.Reset();
+        graph.AddPass("Target", [](RenderGraphBuilder& builder){
+            builder.Write(builder.CreateTexture(TARGET_DESC));
+            builder.SetHasSideEffects();
+        }, [](EFRAPICommandList*, const RenderGraphResources&){});
+        graph.Execute();
+
+        // Created in the common state, the second frame finds the texture still a render target
+        REQUIRE(graph.GetStats().TransientResourcesCreated == (frame == 0 ? 1 : 0));
+        REQUIRE(graph.GetStats().Barriers == (frame == 0 ? 1 : 0));
+        REQUIRE(headless->GetStats().Barriers == 1);
+    }
+}
+
+TEST_CASE("Render graph places aliasing barriers where transient resources take over memory", "[rendercore]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    const TextureHandle backBuffer = device->CreateTexture(TARGET_DESC);
+    EFRenderGraph graph(device);
+
+    // The first and the last of three textures share memory, the middle one has its own
+    const auto executeFrame = [&](const int32 transientTextures){
+        graph.Reset();
+        AddChainPasses(graph, backBuffer, transientTextures);
+        graph.Execute();
+        return graph.GetStats().AliasingBarriers;
+    };
+
+    // New placed resources take over the memory, then the first and the last texture hand it over every frame
+    REQUIRE(executeFrame(3) == 3);
+    REQUIRE(executeFrame(3) == 2);
+    REQUIRE(graph.GetStats().TransientResourcesCreated == 0);
+    REQUIRE(headless->GetStats().AliasingBarriers == 5);
+
+    // The first texture alone takes its memory back once from the last one, then keeps it
+    REQUIRE(executeFrame(1) == 1);
+    REQUIRE(executeFrame(1) == 0);
+    REQUIRE(graph.GetStats().TransientResourcesCreated == 0);
+    REQUIRE(headless->GetStats().AliasingBarriers == 6);
+}
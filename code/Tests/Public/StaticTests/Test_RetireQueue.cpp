@@ -0,0 +1,120 @@
+#pragma once
+
+#include "EFRAPIRetireQueue.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EventfulEngine;
+
+namespace{
+    class CountedResource final : public RefCounter<EFRAPIResource>{
+    public:
+        explicit CountedResource(int32& destroyed) : _destroyed(destroyed){}
+
+        ~CountedResource() override{
+            ++_destroyed;
+        }
+
+    private:
+        int32& _destroyed;
+    };
+
+    using CountedHandle = RefCountPtr<CountedResource>;
+
+    CountedHandle CreateCounted(EFRAPIRetireQueue& queue, int32& destroyed){
+        CountedHandle resource = CountedHandle::Create(new CountedResource(destroyed));
+        resource->SetRetireQueue(&queue);
+        return resource;
+    }
+
+    EFRAPIRetireQueue::QueueInstances Instances(const uint64 graphics, const uint64 compute = 0){
+        EFRAPIRetireQueue::QueueInstances instances{};
+        instances[static_cast<size_t>(E_CommandQueue::Graphics)] = graphics;
+        instances[static_cast<size_t>(E_CommandQueue::Compute)] = compute;
+        return instances;
+    }
+}
+
+TEST_CASE("Retire queue destroys a frame once all its submissions completed", "[renderapi]"){
+    int32 destroyed = 0;
+    EFRAPIRetireQueue queue;
+
+    CountedHandle first = CreateCounted(queue, destroyed);
+    CountedHandle second = CreateCounted(queue, destroyed);
+    first = nullptr;
+    REQUIRE(destroyed == 0);
+    queue.CloseFrame(Instances(1, 4));
+    second = nullptr;
+    queue.CloseFrame(Instances(2, 4));
+    REQUIRE(queue.GetStats().PendingResources == 2);
+    REQUIRE(queue.GetStats().PendingFrames == 2);
+
+    // The compute queue of the first frame is still running
+    REQUIRE(queue.Collect(Instances(2, 3)) == 0);
+    REQUIRE(destroyed == 0);
+
+    REQUIRE(queue.Collect(Instances(1, 4)) == 1);
+    REQUIRE(destroyed == 1);
+    REQUIRE(queue.Collect(Instances(2, 4)) == 1);
+    REQUIRE(destroyed == 2);
+
+    const RetireQueueStats stats = queue.GetStats();
+    REQUIRE(stats.PendingResources == 0);
+    REQUIRE(stats.PendingFrames == 0);
+    REQUIRE(stats.ResourcesRetired == 2);
+    REQUIRE(stats.ResourcesDestroyed == 2);
+    REQUIRE(stats.LargestBatch == 1);
+}
+
+TEST_CASE("Headless device destroys released objects in garbage collection", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+
+    BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(256));
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+    commandList->Open();
+    const uint32 value = 7;
+    commandList->WriteBuffer(buffer, &value, sizeof(value));
+    commandList->Close();
+    EFRAPICommandList* submitted = commandList;
+    device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+
+    // Opening the list again drops its reference, the last one is released here
+    commandList->Open();
+    commandList->Close();
+    buffer = nullptr;
+    REQUIRE(headless->GetRetireQueueStats().PendingResources == 1);
+
+    device->RunGarbageCollection();
+    const RetireQueueStats stats = headless->GetRetireQueueStats();
+    REQUIRE(stats.PendingResources == 0);
+    REQUIRE(stats.ResourcesDestroyed == 1);
+}
+
+TEST_CASE("Objects released after their device are deleted right away", "[renderapi]"){
+    DynamicRAPIHandle device = CreateHeadlessRAPI();
+    BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(256));
+    TextureHandle texture = device->CreateTexture(TextureDesc().SetWidth(4).SetHeight(4));
+    device = nullptr;
+
+    // The queue is kept alive by the objects and closed, nothing waits for a garbage collection that never comes
+    REQUIRE(buffer->GetDesc().ByteSize == 256);
+    buffer = nullptr;
+    texture = nullptr;
+}
+
+TEST_CASE("Closed retire queue no longer defers destruction", "[renderapi]"){
+    int32 destroyed = 0;
+    EFRAPIRetireQueue queue;
+
+    CountedHandle pending = CreateCounted(queue, destroyed);
+    CountedHandle late = CreateCounted(queue, destroyed);
+    pending = nullptr;
+    REQUIRE(queue.Close() == 1);
+    REQUIRE(destroyed == 1);
+
+    late = nullptr;
+    REQUIRE(destroyed == 2);
+    REQUIRE(queue.GetStats().ResourcesRetired == 1);
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "EFInlineString.h"
+#include "EFSmallVector.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    int32 g_allocations = 0;
+
+    // Counts heap blocks handed out, shared by every element type
+    template <typename T>
+    struct CountingAllocator : std::allocator<T>{
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template <typename Other>
+        explicit(false) CountingAllocator(const CountingAllocator<Other>&){
+        }
+
+        template <typename Other>
+        struct rebind{
+            using other = CountingAllocator<Other>;
+        };
+
+        T* allocate(const size_t count){
+            ++g_allocations;
+            return std::allocator<T>::allocate(count);
+        }
+    };
+
+    // Not trivially relocatable, counts live objects so leaks and double destructions show up
+    struct Tracked{
+        static inline int32 Alive = 0;
+
+        explicit Tracked(const int32 value) : Value(std::make_unique<int32>(value)){ ++Alive; }
+        Tracked(const Tracked& other) : Value(std::make_unique<int32>(*other.Value)){ ++Alive; }
+        Tracked(Tracked&& other) noexcept : Value(std::move(other.Value)){ ++Alive; }
+        Tracked& operator=(const Tracked& other){
+            Value = std::make_unique<int32>(*other.Value);
+            return *this;
+        }
+        Tracked& operator=(Tracked&& other) noexcept = default;
+        ~Tracked(){ --Alive; }
+
+        bool operator==(const int32 value) const{ return Value && *Value == value; }
+
+        std::unique_ptr<int32> Value;
+    };
+
+    template <typename Vector>
+    void RequireValues(const Vector& vector, const std::vector<int32>& values){
+        REQUIRE(vector.size() == values.size());
+        for (size_t index = 0; index < values.size(); ++index){
+            REQUIRE(vector[index] == values[index]);
+        }
+    }
+}
+
+TEST_CASE("Small vector stays inline until it outgrows its capacity", "[core]"){
+    EFSmallVector<int32, 4> vector{1, 2, 3};
+    REQUIRE(vector.is_inline());
+    vector.push_back(4);
+    REQUIRE(vector.is_inline());
+    vector.push_back(5);
+    REQUIRE_FALSE(vector.is_inline());
+    RequireValues(vector, {1, 2, 3, 4, 5});
+
+    vector.erase(vector.begin() + 1, vector.begin() + 3);
+    RequireValues(vector, {1, 4, 5});
+    vector.shrink_to_fit();
+    REQUIRE(vector.is_inline());
+    RequireValues(vector, {1, 4, 5});
+    REQUIRE_THROWS_AS(vector.at(3), std::out_of_range);
+}
+
+TEST_CASE("Small vector inserts anywhere with amortized growth", "[core]"){
+    g_allocations = 0;
+    EFSmallVector<int32, 2, CountingAllocator<int32>> vector;
+    std::vector<int32> reference;
+    constexpr int32 COUNT = 4096;
+    for (int32 value = 0; value < COUNT; ++value){
+        const size_t index = static_cast<size_t>(value) * 7 % (reference.size() + 1);
+        vector.insert(vector.begin() + index, value);
+        reference.insert(reference.begin() + static_cast<std::ptrdiff_t>(index), value);
+    }
+    RequireValues(vector, reference);
+    // One allocation per doubling, not one per insert
+    REQUIRE(g_allocations <= 12);
+
+    g_allocations = 0;
+    EFSmallVector<int32, 2, CountingAllocator<int32>> appended;
+    const int32 values[] = {1, 2, 3};
+    for (int32 round = 0; round < 1000; ++round){
+        appended.append(std::begin(values), std::end(values));
+    }
+    REQUIRE(appended.size() == 3000);
+    REQUIRE(g_allocations <= 12);
+}
+
+TEST_CASE("Small vector inserts elements of itself", "[core]"){
+    EFSmallVector<std::string, 2> vector{"first", "second"};
+    // The argument refers to an element that moves while the vector grows
+    vector.insert(vector.begin(), vector.back());
+    vector.emplace_back(vector.front());
+    REQUIRE(vector.size() == 4);
+    REQUIRE(vector[0] == "second");
+    REQUIRE(vector[1] == "first");
+    REQUIRE(vector[2] == "second");
+    REQUIRE(vector[3] == "second");
+
+    // Full again, so every one of these reallocates while the argument is still read
+    vector.shrink_to_fit();
+    vector.insert(vector.begin() + 1, vector[1]);
+    vector.shrink_to_fit();
+    vector.insert(vector.end(), vector[1]);
+    vector.shrink_to_fit();
+    vector.resize(40, vector[1]);
+    REQUIRE(vector.size() == 40);
+    REQUIRE(vector[0] == "second");
+    for (size_t index = 1; index < vector.size(); ++index){
+        REQUIRE(vector[index] == (index == 3 || index == 4 ? "second" : "first"));
+    }
+}
+
+TEST_CASE("Small vector constructs and destroys every element once", "[core]"){
+    Tracked::Alive = 0;
+    {
+        EFSmallVector<Tracked, 3> vector;
+        for (int32 value = 0; value < 6; ++value){
+            vector.emplace(vector.begin(), value);
+        }
+        RequireValues(vector, {5, 4, 3, 2, 1, 0});
+        REQUIRE(Tracked::Alive == 6);
+
+        vector.erase(vector.begin() + 1);
+        vector.pop_back();
+        RequireValues(vector, {5, 3, 2, 1});
+        REQUIRE(Tracked::Alive == 4);
+
+        // Moving a heap vector steals the block, moving an inline one relocates its elements
+        EFSmallVector<Tracked, 3> moved = std::move(vector);
+        REQUIRE(vector.empty());
+        RequireValues(moved, {5, 3, 2, 1});
+        moved.resize(2, Tracked{9});
+        EFSmallVector<Tracked, 3> inlineMoved = std::move(moved);
+        RequireValues(inlineMoved, {5, 3});
+
+        EFSmallVector<Tracked, 3> copy;
+        copy = inlineMoved;
+        RequireValues(copy, {5, 3});
+        REQUIRE(Tracked::Alive == 4);
+    }
+    REQUIRE(Tracked::Alive == 0);
+}
+
+TEST_CASE("Inline string stays terminated and grows geometrically", "[core]"){
+    EFInlineString<8> text{"short"};
+    REQUIRE(text.is_inline());
+    REQUIRE(std::string_view{text.c_str()} == "short");
+    text += " and longer";
+    REQUIRE_FALSE(text.is_inline());
+    REQUIRE(text == "short and longer");
+    REQUIRE(std::string_view{text.c_str()} == "short and longer");
+
+    EFInlineString<8> built;
+    const char* data = nullptr;
+    int32 reallocations = 0;
+    for (int32 index = 0; index < 2000; ++index){
+        built += static_cast<char>('a' + index % 26);
+        if (built.data() != data){
+            data = built.data();
+            ++reallocations;
+        }
+    }
+    REQUIRE(built.size() == 2000);
+    REQUIRE(built.c_str()[2000] == '\0');
+    REQUIRE(reallocations <= 12);
+
+    const EFInlineString<8> copy = built;
+    REQUIRE(copy == built);
+    EFInlineString<8> moved = std::move(built);
+    REQUIRE(moved == copy);
+    REQUIRE(std::format("{}", EFInlineString<8>{"fmt"}) == "fmt");
+    REQUIRE(EFInlineString<8>{"abc"} < EFInlineString<8>{"abd"});
+}
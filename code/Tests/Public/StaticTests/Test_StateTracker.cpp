@@ -0,0 +1,131 @@
+#pragma once
+
+#include "EFRAPIStateTracker.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EventfulEngine;
+
+namespace{
+    TextureHandle CreateMippedTexture(EFDynamicRAPI* device){
+        return device->CreateTexture(TextureDesc().SetWidth(64).SetHeight(64).SetMipLevels(4).
+                                                   SetFormat(E_Format::RGBA8_UNORM).SetIsRenderTarget(true));
+    }
+
+    HeadlessTexture* Extension(const TextureHandle& texture){
+        return static_cast<HeadlessTexture*>(texture.Get());
+    }
+
+    HeadlessBuffer* Extension(const BufferHandle& buffer){
+        return static_cast<HeadlessBuffer*>(buffer.Get());
+    }
+}
+
+TEST_CASE("State tracker coalesces transitions within a batch", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle texture = CreateMippedTexture(device);
+    EFRAPIStateTracker tracker;
+
+    tracker.BeginTrackingTextureState(Extension(texture), AllSubresources, F_ResourceStates::ShaderResource);
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::RenderTarget);
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::CopySource);
+    BarrierBatch batch = tracker.CommitBarriers();
+    REQUIRE(batch.Textures.size() == 1);
+    REQUIRE(batch.Textures[0].B_IsEntireTexture);
+    REQUIRE(batch.Textures[0].StateBefore == F_ResourceStates::ShaderResource);
+    REQUIRE(batch.Textures[0].StateAfter == F_ResourceStates::CopySource);
+
+    // Going there and back before anything uses the texture needs no barrier at all
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::RenderTarget);
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::CopySource);
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::CopySource);
+    batch = tracker.CommitBarriers();
+    REQUIRE(batch.IsEmpty());
+
+    const StateTrackerStats& stats = tracker.GetStats();
+    REQUIRE(stats.BarriersIssued == 1);
+    REQUIRE(stats.BarriersElided == 4);
+    REQUIRE(stats.Batches == 1);
+}
+
+TEST_CASE("State tracker splits and merges subresource states", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle texture = CreateMippedTexture(device);
+    EFRAPIStateTracker tracker;
+    tracker.BeginTrackingTextureState(Extension(texture), AllSubresources, F_ResourceStates::RenderTarget);
+
+    // Mip generation reads each mip after rendering it
+    for (MipLevel mipLevel = 0; mipLevel < 3; ++mipLevel){
+        tracker.RequireTextureState(Extension(texture), TextureSubresourceSet(mipLevel, 1, 0, 1),
+                                    F_ResourceStates::ShaderResource);
+        const BarrierBatch batch = tracker.CommitBarriers();
+        REQUIRE(batch.Textures.size() == 1);
+        REQUIRE_FALSE(batch.Textures[0].B_IsEntireTexture);
+        REQUIRE(batch.Textures[0].TexMipLevel == mipLevel);
+    }
+    REQUIRE(tracker.GetTextureSubresourceState(Extension(texture), 0, 2) == F_ResourceStates::ShaderResource);
+    REQUIRE(tracker.GetTextureSubresourceState(Extension(texture), 0, 3) == F_ResourceStates::RenderTarget);
+
+    // The last mip joins the others, after that the texture transitions as a whole again
+    tracker.RequireTextureState(Extension(texture), TextureSubresourceSet(3, 1, 0, 1),
+                                F_ResourceStates::ShaderResource);
+    REQUIRE(tracker.CommitBarriers().Textures.size() == 1);
+    tracker.RequireTextureState(Extension(texture), AllSubresources, F_ResourceStates::CopySource);
+    const BarrierBatch batch = tracker.CommitBarriers();
+    REQUIRE(batch.Textures.size() == 1);
+    REQUIRE(batch.Textures[0].B_IsEntireTexture);
+    REQUIRE(batch.Textures[0].StateBefore == F_ResourceStates::ShaderResource);
+}
+
+TEST_CASE("State tracker places one UAV barrier per batch unless disabled", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(256).SetCanHaveUAVs(true));
+    EFRAPIStateTracker tracker;
+
+    tracker.RequireBufferState(Extension(buffer), F_ResourceStates::UnorderedAccess);
+    tracker.RequireBufferState(Extension(buffer), F_ResourceStates::UnorderedAccess);
+    REQUIRE(tracker.CommitBarriers().Buffers.size() == 1);
+    tracker.RequireBufferState(Extension(buffer), F_ResourceStates::UnorderedAccess);
+    tracker.RequireBufferState(Extension(buffer), F_ResourceStates::UnorderedAccess);
+    const BarrierBatch batch = tracker.CommitBarriers();
+    REQUIRE(batch.Buffers.size() == 1);
+    REQUIRE(batch.Buffers[0].StateBefore == F_ResourceStates::UnorderedAccess);
+
+    tracker.SetEnableUavBarriersForBuffer(Extension(buffer), false);
+    tracker.RequireBufferState(Extension(buffer), F_ResourceStates::UnorderedAccess);
+    REQUIRE(tracker.CommitBarriers().IsEmpty());
+}
+
+TEST_CASE("Executed command lists hand their states to the resources", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    const TextureHandle texture = CreateMippedTexture(device);
+    const BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(256).
+                                                                  SetInitialState(F_ResourceStates::CopyDest).
+                                                                  SetKeepInitialState(true));
+    const CommandListHandle commandList = device->CreateCommandList(CommandListParameters());
+    EFRAPICommandList* submitted = commandList;
+
+    commandList->Open();
+    commandList->BeginTrackingTextureState(texture, AllSubresources, F_ResourceStates::Common);
+    commandList->SetTextureState(texture, AllSubresources, F_ResourceStates::ShaderResource);
+    commandList->SetBufferState(buffer, F_ResourceStates::ShaderResource);
+    commandList->SetPermanentTextureState(texture, F_ResourceStates::ShaderResource);
+    commandList->Close();
+    device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    REQUIRE(Extension(texture)->PermanentState == F_ResourceStates::ShaderResource);
+    // The buffer went back to its initial state on close
+    REQUIRE(Extension(buffer)->State == F_ResourceStates::CopyDest);
+
+    // Permanent states need no tracking, the second list issues no barrier
+    commandList->Open();
+    commandList->SetTextureState(texture, AllSubresources, F_ResourceStates::RenderTarget);
+    commandList->SetBufferState(buffer, F_ResourceStates::CopyDest);
+    commandList->Close();
+    device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    REQUIRE(commandList->GetTextureSubresourceState(texture, 0, 0) == F_ResourceStates::ShaderResource);
+
+    const HeadlessDeviceStats stats = static_cast<EFHeadlessRAPI*>(device.Get())->GetStats();
+    REQUIRE(stats.Barriers == 3);
+    REQUIRE(stats.BarriersElided == 3);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "EFText.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <format>
+
+using namespace EventfulEngine;
+
+TEST_CASE("Text formats independent of the global locale", "[core]"){
+    REQUIRE(EFText::Format("{} {:.3f} {:>4}|{:#x}", "text", 1234.5, 7, 255) == "text 1234.500    7|0xff");
+    REQUIRE(EFText::Format("{{}}") == "{}");
+    REQUIRE(EFText::FormatRuntime("{1} {0}", 1, "two") == "two 1");
+    REQUIRE_THROWS_AS(EFText::FormatRuntime("{", 1), std::format_error);
+}
+
+TEST_CASE("Text appends formatted text to a string", "[core]"){
+    EFString out = "prefix ";
+    EFText::FormatTo(out, "{} {}", 1, "two");
+    REQUIRE(out == "prefix 1 two");
+
+    // Text longer than the spare capacity is formatted again into the grown string
+    const EFString longText(300, 'x');
+    EFText::FormatTo(out, "|{}|{}", longText, 3);
+    REQUIRE(out == "prefix 1 two|" + longText + "|3");
+
+    // Appending into enough capacity does not reallocate
+    EFString reused;
+    reused.reserve(256);
+    const char* data = reused.data();
+    for (int32 index = 0; index < 10; ++index){
+        EFText::FormatTo(reused, "{},", index);
+    }
+    REQUIRE(reused == "0,1,2,3,4,5,6,7,8,9,");
+    REQUIRE(reused.data() == data);
+
+    // Empty output leaves the string as it was
+    EFText::FormatTo(reused, "{}", "");
+    REQUIRE(reused == "0,1,2,3,4,5,6,7,8,9,");
+}
+
+TEST_CASE("Text formats into a fixed buffer and truncates", "[core]"){
+    std::array<char, 8> buffer{};
+    REQUIRE(EFText::FormatTo(buffer, "{}-{}", 12, 34) == "12-34");
+    REQUIRE(EFText::FormatTo(buffer, "{}", "longer than eight") == "longer t");
+    REQUIRE(EFText::FormatTo(std::span<char>{}, "{}", 42).empty());
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "EFRAPIUploadManager.h"
+#include "RenderAPIHeadlessModule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+using namespace EventfulEngine;
+
+namespace{
+    constexpr uint64 CHUNK_SIZE = c_ConstantBufferOffsetSizeAlignment;
+
+    void Retire(EFRAPIUploadManager& manager, UploadChunk& chunk){
+        manager.RetireChunks({&chunk, 1}, E_CommandQueue::Graphics);
+    }
+}
+
+TEST_CASE("Upload ring wraps around behind the oldest chunk", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIUploadManager manager(device, 4 * CHUNK_SIZE);
+
+    UploadChunk first = manager.AllocateChunk(CHUNK_SIZE);
+    UploadChunk second = manager.AllocateChunk(CHUNK_SIZE);
+    UploadChunk third = manager.AllocateChunk(CHUNK_SIZE);
+    REQUIRE(third.Offset == 2 * CHUNK_SIZE);
+
+    // Only the first chunk is released, the next two chunks take the end of the ring and then its start
+    Retire(manager, first);
+    manager.SignalSubmission(E_CommandQueue::Graphics);
+    const UploadChunk fourth = manager.AllocateChunk(CHUNK_SIZE);
+    const UploadChunk fifth = manager.AllocateChunk(CHUNK_SIZE);
+    REQUIRE(fourth.Offset == 3 * CHUNK_SIZE);
+    REQUIRE(fifth.Offset == 0);
+    REQUIRE(fifth.Buffer == fourth.Buffer);
+    REQUIRE_FALSE(fifth.Dedicated);
+    REQUIRE(manager.GetStats().DedicatedChunks == 0);
+}
+
+TEST_CASE("Upload ring reuses chunks once their submission completed", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIUploadManager manager(device, 4 * CHUNK_SIZE);
+
+    std::vector<UploadChunk> chunks;
+    for (int32 index = 0; index < 4; ++index){
+        chunks.push_back(manager.AllocateChunk(CHUNK_SIZE));
+    }
+    manager.RetireChunks(chunks, E_CommandQueue::Graphics);
+    manager.SignalSubmission(E_CommandQueue::Graphics);
+
+    const UploadChunk reused = manager.AllocateChunk(2 * CHUNK_SIZE);
+    REQUIRE(reused.Offset == 0);
+    REQUIRE_FALSE(reused.Dedicated);
+    REQUIRE(manager.GetStats().DedicatedChunks == 0);
+    REQUIRE(manager.GetStats().ChunksAllocated == 5);
+}
+
+TEST_CASE("Upload ring falls back to dedicated chunks", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIUploadManager manager(device, 4 * CHUNK_SIZE);
+
+    // Larger than the ring
+    UploadChunk large = manager.AllocateChunk(8 * CHUNK_SIZE);
+    REQUIRE(large.Dedicated);
+    REQUIRE(large.CpuAddress);
+    REQUIRE(large.Size == 8 * CHUNK_SIZE);
+
+    // The ring is held by chunks no submission covers yet, waiting would never return
+    std::vector<UploadChunk> chunks;
+    for (int32 index = 0; index < 4; ++index){
+        chunks.push_back(manager.AllocateChunk(CHUNK_SIZE));
+    }
+    UploadChunk blocked = manager.AllocateChunk(CHUNK_SIZE);
+    REQUIRE(blocked.Dedicated);
+    REQUIRE(manager.GetStats().DedicatedChunks == 2);
+
+    // Retired but not yet submitted is not enough either
+    manager.RetireChunks(chunks, E_CommandQueue::Graphics);
+    UploadChunk unsubmitted = manager.AllocateChunk(CHUNK_SIZE);
+    REQUIRE(unsubmitted.Dedicated);
+
+    Retire(manager, large);
+    Retire(manager, blocked);
+    Retire(manager, unsubmitted);
+    manager.SignalSubmission(E_CommandQueue::Graphics);
+    REQUIRE_FALSE(manager.AllocateChunk(CHUNK_SIZE).Dedicated);
+    REQUIRE(manager.GetStats().DedicatedChunks == 3);
+}
+
+TEST_CASE("Upload writer aligns volatile constant buffer versions", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    EFRAPIUploadManager manager(device, 16 * CHUNK_SIZE);
+    EFRAPIUploadWriter writer(&manager, 4 * CHUNK_SIZE, E_CommandQueue::Graphics);
+
+    const UploadAllocation odd = writer.Allocate(3, 4);
+    const UploadAllocation version = writer.Allocate(64, c_ConstantBufferOffsetSizeAlignment);
+    const UploadAllocation next = writer.Allocate(64, c_ConstantBufferOffsetSizeAlignment);
+    REQUIRE(odd.CpuAddress);
+    REQUIRE(version.Offset % c_ConstantBufferOffsetSizeAlignment == 0);
+    REQUIRE(next.Offset % c_ConstantBufferOffsetSizeAlignment == 0);
+    REQUIRE(next.Offset > version.Offset);
+    REQUIRE(next.CpuAddress - version.CpuAddress == static_cast<ptrdiff_t>(next.Offset - version.Offset));
+}
+
+TEST_CASE("Executed command lists release their upload memory without being opened again", "[renderapi]"){
+    const DynamicRAPIHandle device = CreateHeadlessRAPI();
+    auto* headless = static_cast<EFHeadlessRAPI*>(device.Get());
+    const uint64 ringSize = headless->GetUploadManager()->GetRingSize();
+    constexpr uint64 WRITE_SIZE = 1024 * 1024;
+
+    const BufferHandle buffer = device->CreateBuffer(BufferDesc().SetByteSize(WRITE_SIZE));
+    const std::vector<uint8> data(WRITE_SIZE, 7);
+    std::vector<CommandListHandle> commandLists;
+    // More than the ring holds, all lists stay alive and closed
+    for (uint64 uploaded = 0; uploaded < 2 * ringSize; uploaded += WRITE_SIZE){
+        const CommandListHandle& commandList = commandLists.emplace_back(
+            device->CreateCommandList(CommandListParameters()));
+        commandList->Open();
+        commandList->WriteBuffer(buffer, data.data(), data.size());
+        commandList->Close();
+        EFRAPICommandList* submitted = commandList;
+        device->ExecuteCommandLists(&submitted, 1, E_CommandQueue::Graphics);
+    }
+
+    REQUIRE(headless->GetUploadManager()->GetStats().DedicatedChunks == 0);
+    REQUIRE(headless->GetStats().BytesUploaded == commandLists.size() * WRITE_SIZE);
+}